@@ -0,0 +1,60 @@
+#ifndef BENCHMARKS_BENCHMARK_HPP
+#define BENCHMARKS_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Helpers to time the framework functions. Build with optimizations, the debug build numbers don't mean much.
+namespace benchmark
+{
+
+// Results are written here, so the compiler can't throw away the measured work.
+inline volatile std::size_t sink = 0;
+
+inline void keep(std::size_t value)
+{
+    sink = value;
+}
+
+// The best time of the runs in milliseconds, it is the least disturbed by the rest of the system.
+template <typename Function>
+double measure(Function&& function, int runs = 5)
+{
+    double best = 0.0;
+    for (int i = 0; i < runs; ++i) {
+        const auto start = std::chrono::steady_clock::now();
+        function();
+        const std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+
+        best = (i == 0 || time.count() < best) ? time.count() : best;
+    }
+
+    return best;
+}
+
+inline void print_header(const std::string& title)
+{
+    std::cout << "\n" << title << "\n";
+}
+
+inline void print(const std::string& name, double milliseconds)
+{
+    std::cout << "    " << std::left << std::setw(56) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(3) << milliseconds << " ms\n";
+}
+
+// Prints the time and the number of operations per second in millions.
+inline void print(const std::string& name, double milliseconds, std::size_t operations)
+{
+    const double rate = static_cast<double>(operations) / milliseconds / 1000.0;
+
+    std::cout << "    " << std::left << std::setw(56) << name << std::right << std::setw(12) << std::fixed
+              << std::setprecision(3) << milliseconds << " ms" << std::setw(12) << rate << " M/s\n";
+}
+
+} // namespace benchmark
+
+#endif
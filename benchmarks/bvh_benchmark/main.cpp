@@ -0,0 +1,197 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <benchmark.hpp>
+#include <common/thread_pool.hpp>
+#include <math/math.hpp>
+
+namespace
+{
+
+using namespace framework;
+using namespace framework::math;
+
+constexpr std::size_t boxes_count   = 1000000;
+constexpr std::size_t terrain_size  = 300;
+constexpr std::size_t queries_count = 100000;
+
+// Small boxes scattered in the space in front of the camera.
+std::vector<Aabbf> make_boxes()
+{
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> x(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> y(-300.0f, 300.0f);
+    std::uniform_real_distribution<float> z(-1100.0f, 100.0f);
+
+    std::vector<Aabbf> boxes;
+    boxes.reserve(boxes_count);
+    for (std::size_t i = 0; i < boxes_count; ++i) {
+        const Vector3f center(x(generator), y(generator), z(generator));
+        boxes.emplace_back(center - Vector3f(1.0f), center + Vector3f(1.0f));
+    }
+
+    return boxes;
+}
+
+// Height map grid, two triangles per cell.
+struct Terrain
+{
+    std::vector<Vector3f> vertices;
+    std::vector<std::uint32_t> indices;
+};
+
+Terrain make_terrain()
+{
+    Terrain terrain;
+    for (std::size_t z = 0; z <= terrain_size; ++z) {
+        for (std::size_t x = 0; x <= terrain_size; ++x) {
+            const float height = std::sin(static_cast<float>(x) * 0.3f) * std::cos(static_cast<float>(z) * 0.2f) * 3.0f;
+            terrain.vertices.emplace_back(static_cast<float>(x), height, static_cast<float>(z));
+        }
+    }
+
+    const auto row = static_cast<std::uint32_t>(terrain_size + 1);
+    for (std::uint32_t z = 0; z < terrain_size; ++z) {
+        for (std::uint32_t x = 0; x < terrain_size; ++x) {
+            const std::uint32_t i = z * row + x;
+            terrain.indices.insert(terrain.indices.end(), {i, i + 1, i + row, i + 1, i + row + 1, i + row});
+        }
+    }
+
+    return terrain;
+}
+
+// Rays going down to the terrain from random points above it.
+std::vector<Rayf> make_rays()
+{
+    std::mt19937 generator(2);
+    std::uniform_real_distribution<float> position(0.0f, static_cast<float>(terrain_size));
+    std::uniform_real_distribution<float> slope(-0.5f, 0.5f);
+
+    std::vector<Rayf> rays;
+    rays.reserve(queries_count);
+    for (std::size_t i = 0; i < queries_count; ++i) {
+        rays.emplace_back(Vector3f(position(generator), 10.0f, position(generator)),
+                          Vector3f(slope(generator), -1.0f, slope(generator)));
+    }
+
+    return rays;
+}
+
+// Query boxes of a few primitives size.
+std::vector<Aabbf> make_query_boxes()
+{
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> x(-500.0f, 500.0f);
+    std::uniform_real_distribution<float> y(-300.0f, 300.0f);
+    std::uniform_real_distribution<float> z(-1100.0f, 100.0f);
+
+    std::vector<Aabbf> boxes;
+    boxes.reserve(queries_count);
+    for (std::size_t i = 0; i < queries_count; ++i) {
+        const Vector3f center(x(generator), y(generator), z(generator));
+        boxes.emplace_back(center - Vector3f(10.0f), center + Vector3f(10.0f));
+    }
+
+    return boxes;
+}
+
+void run_build(const std::vector<Aabbf>& boxes, const Terrain& terrain, ThreadPool& pool)
+{
+    const std::string threads = "pool of " + std::to_string(pool.threads_count());
+
+    benchmark::print_header("SAH build");
+
+    Bvh bvh;
+    benchmark::print("1M boxes, serial", benchmark::measure([&]() { bvh.build(boxes); }));
+    benchmark::print("1M boxes, " + threads, benchmark::measure([&]() { bvh.build(boxes, &pool); }));
+    benchmark::print("1M boxes, refit", benchmark::measure([&]() { bvh.refit(boxes); }));
+
+    const std::size_t triangles_count = terrain.indices.size() / 3;
+    const std::string triangles       = std::to_string(triangles_count / 1000) + "k triangles";
+
+    benchmark::print(triangles + ", serial",
+                     benchmark::measure([&]() { bvh.build(terrain.vertices, terrain.indices); }));
+    benchmark::print(triangles + ", " + threads,
+                     benchmark::measure([&]() { bvh.build(terrain.vertices, terrain.indices, &pool); }));
+}
+
+void run_rays(const Terrain& terrain)
+{
+    Bvh bvh;
+    bvh.build(terrain.vertices, terrain.indices);
+
+    const std::vector<Rayf> rays = make_rays();
+
+    benchmark::print_header("Ray queries, " + std::to_string(terrain.indices.size() / 3 / 1000) + "k triangles");
+
+    std::size_t hits     = 0;
+    const double rays_ms = benchmark::measure([&]() {
+        hits = 0;
+        for (const auto& ray : rays) {
+            Bvh::Hit hit;
+            hits += bvh.intersect(ray, hit) ? 1 : 0;
+        }
+    });
+    benchmark::keep(hits);
+
+    benchmark::print(std::to_string(rays.size() / 1000) + "k rays, " + std::to_string(hits) + " hits",
+                     rays_ms,
+                     rays.size());
+}
+
+void run_boxes(const std::vector<Aabbf>& boxes)
+{
+    Bvh bvh;
+    bvh.build(boxes);
+
+    const std::vector<Aabbf> query_boxes = make_query_boxes();
+
+    benchmark::print_header("Box queries, 1M boxes");
+
+    std::vector<std::uint32_t> result;
+    std::size_t found   = 0;
+    const double box_ms = benchmark::measure([&]() {
+        found = 0;
+        for (const auto& box : query_boxes) {
+            result.clear();
+            bvh.query(box, result);
+            found += result.size();
+        }
+    });
+    benchmark::keep(found);
+
+    benchmark::print(std::to_string(query_boxes.size() / 1000) + "k boxes, " + std::to_string(found) + " found",
+                     box_ms,
+                     query_boxes.size());
+
+    const Frustumf frustum(perspective(0.5f, 1.5f, 1.0f, 400.0f));
+
+    const double frustum_ms = benchmark::measure([&]() {
+        result.clear();
+        bvh.query(frustum, result);
+    });
+    benchmark::keep(result.size());
+
+    benchmark::print("frustum, " + std::to_string(result.size()) + " found", frustum_ms);
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<Aabbf> boxes = make_boxes();
+    const Terrain terrain          = make_terrain();
+
+    ThreadPool pool;
+
+    run_build(boxes, terrain, pool);
+    run_rays(terrain);
+    run_boxes(boxes);
+
+    return 0;
+}
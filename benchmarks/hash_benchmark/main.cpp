@@ -0,0 +1,177 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark.hpp>
+#include <common/span.hpp>
+#include <math/math.hpp>
+
+namespace
+{
+
+using namespace framework;
+using namespace framework::math;
+
+constexpr std::size_t grid_size = 1000;
+constexpr float precision       = 1e-5f;
+
+// Not indexed height map grid, every cell has 6 vertices of two triangles, so most vertices are repeated 6 times.
+std::vector<Vector3f> make_vertices()
+{
+    const auto point = [](std::size_t x, std::size_t z) {
+        const float fx = static_cast<float>(x) * 0.01f;
+        const float fz = static_cast<float>(z) * 0.01f;
+        return Vector3f(fx, std::sin(fx * 3.0f) * std::cos(fz * 2.0f), fz);
+    };
+
+    std::vector<Vector3f> vertices;
+    vertices.reserve(grid_size * grid_size * 6);
+    for (std::size_t z = 0; z < grid_size; ++z) {
+        for (std::size_t x = 0; x < grid_size; ++x) {
+            vertices.insert(vertices.end(),
+                            {point(x, z), point(x + 1, z), point(x, z + 1), point(x + 1, z), point(x + 1, z + 1),
+                             point(x, z + 1)});
+        }
+    }
+
+    return vertices;
+}
+
+void run_hash(const std::vector<Vector3f>& vertices)
+{
+    benchmark::print_header("Hash of " + std::to_string(vertices.size() / 1000000) + "M vertices");
+
+    const auto array_hash = [&vertices]() { benchmark::keep(hash_array(Span<const Vector3f>(vertices))); };
+    const double array_ms = benchmark::measure(array_hash);
+
+    const double combine_ms = benchmark::measure([&vertices]() {
+        const std::hash<Vector3f> hasher;
+
+        std::size_t seed = 0;
+        for (const auto& v : vertices) {
+            seed = unility_hash::details::hash_combine(seed, hasher(v));
+        }
+
+        benchmark::keep(seed);
+    });
+
+    benchmark::print("hash_array", array_ms, vertices.size());
+    benchmark::print("std::hash and hash_combine", combine_ms, vertices.size());
+
+    benchmark::print_header("Hash of bytes");
+
+    for (std::size_t size : {12, 64, 256, 4096}) {
+        std::vector<std::uint8_t> bytes(size, 7);
+        const std::size_t count = 20000000 / size + 1000;
+
+        const double bytes_ms = benchmark::measure([&bytes, count]() {
+            std::uint64_t sum = 0;
+            for (std::size_t i = 0; i < count; ++i) {
+                bytes[0] = static_cast<std::uint8_t>(i);
+                sum += hash_bytes(bytes.data(), bytes.size());
+            }
+
+            benchmark::keep(static_cast<std::size_t>(sum));
+        });
+
+        benchmark::print("hash_bytes of " + std::to_string(size) + " bytes", bytes_ms, count);
+    }
+}
+
+// Vertices are welded to the unique points, every vertex gets the index of its point.
+void run_weld(const std::vector<Vector3f>& vertices)
+{
+    benchmark::print_header("Weld of " + std::to_string(vertices.size() / 1000000) + "M vertices");
+
+    std::size_t unique = 0;
+
+    const auto point_map_weld = [&]() {
+        PointMap<std::uint32_t> map(precision);
+        map.reserve(vertices.size());
+        for (const auto& v : vertices) {
+            map.insert(v, static_cast<std::uint32_t>(map.size()));
+        }
+
+        unique = map.size();
+    };
+    const double point_map_ms = benchmark::measure(point_map_weld, 3);
+    benchmark::print("PointMap, " + std::to_string(unique) + " unique", point_map_ms, vertices.size());
+
+    // The same rounding as in the PointMap.
+    const auto quantized_weld = [&]() {
+        std::unordered_map<Vector3f, std::uint32_t> map;
+        map.reserve(vertices.size());
+        for (const auto& v : vertices) {
+            const Vector3f cell(std::round(v.x / precision), std::round(v.y / precision), std::round(v.z / precision));
+            map.emplace(cell, static_cast<std::uint32_t>(map.size()));
+        }
+
+        unique = map.size();
+    };
+    const double quantized_ms = benchmark::measure(quantized_weld, 3);
+    benchmark::print("std::unordered_map, rounded, " + std::to_string(unique) + " unique",
+                     quantized_ms,
+                     vertices.size());
+
+    const auto exact_weld = [&]() {
+        std::unordered_map<Vector3f, std::uint32_t> map;
+        map.reserve(vertices.size());
+        for (const auto& v : vertices) {
+            map.emplace(v, static_cast<std::uint32_t>(map.size()));
+        }
+
+        unique = map.size();
+    };
+    const double exact_ms = benchmark::measure(exact_weld, 3);
+    benchmark::print("std::unordered_map, exact, " + std::to_string(unique) + " unique", exact_ms, vertices.size());
+}
+
+void run_lookup(const std::vector<Vector3f>& vertices)
+{
+    benchmark::print_header("Lookup of " + std::to_string(vertices.size() / 1000000) + "M vertices");
+
+    PointMap<std::uint32_t> point_map(precision);
+    std::unordered_map<Vector3f, std::uint32_t> unordered_map;
+    for (const auto& v : vertices) {
+        point_map.insert(v, 0);
+        unordered_map.emplace(v, 0);
+    }
+
+    const double point_map_ms = benchmark::measure([&]() {
+        std::size_t found = 0;
+        for (const auto& v : vertices) {
+            found += point_map.contains(v) ? 1 : 0;
+        }
+
+        benchmark::keep(found);
+    });
+
+    const double unordered_map_ms = benchmark::measure([&]() {
+        std::size_t found = 0;
+        for (const auto& v : vertices) {
+            found += unordered_map.count(v);
+        }
+
+        benchmark::keep(found);
+    });
+
+    benchmark::print("PointMap", point_map_ms, vertices.size());
+    benchmark::print("std::unordered_map", unordered_map_ms, vertices.size());
+}
+
+} // namespace
+
+int main()
+{
+    const std::vector<Vector3f> vertices = make_vertices();
+
+    run_hash(vertices);
+    run_weld(vertices);
+    run_lookup(vertices);
+
+    return 0;
+}
@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark.hpp>
+#include <common/exceptions.hpp>
+#include <common/utf.hpp>
+#include <graphics/font.hpp>
+#include <graphics/mesh.hpp>
+#include <math/math.hpp>
+
+namespace
+{
+
+using namespace framework;
+using namespace framework::graphics;
+using namespace framework::math;
+
+// Filled contour with the holes inside it, like the font glyphs are triangulated.
+struct Shape
+{
+    Polygon outline;
+    std::vector<Polygon> holes;
+};
+
+struct Input
+{
+    std::string name;
+    std::vector<Shape> shapes;
+};
+
+std::size_t points_count(const std::vector<Shape>& shapes)
+{
+    std::size_t count = 0;
+    for (const auto& shape : shapes) {
+        count += shape.outline.size();
+        for (const auto& hole : shape.holes) {
+            count += hole.size();
+        }
+    }
+
+    return count;
+}
+
+// Points of the smooth wavy circle, clockwise for the outline and counterclockwise for the hole.
+Polygon make_circle(const Vector2f& center, float radius, std::size_t count, bool clockwise)
+{
+    constexpr double pi = 3.14159265358979323846;
+
+    Polygon polygon;
+    polygon.reserve(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        const double angle = 2.0 * pi * static_cast<double>(i) / static_cast<double>(count) * (clockwise ? -1.0 : 1.0);
+        const double r     = radius * (1.0 + 0.2 * std::sin(9.0 * angle));
+        polygon.emplace_back(center.x + static_cast<float>(r * std::cos(angle)),
+                             center.y + static_cast<float>(r * std::sin(angle)));
+    }
+
+    return polygon;
+}
+
+Input make_polygon_input(std::size_t count)
+{
+    return {"polygon of " + std::to_string(count) + " points", {{make_circle({0.0f, 0.0f}, 100.0f, count, true), {}}}};
+}
+
+// Half of the points are in the outline, the rest are in the 10x10 grid of holes.
+Input make_holes_input(std::size_t count)
+{
+    Shape shape{make_circle({0.0f, 0.0f}, 100.0f, count / 2, true), {}};
+
+    const std::size_t hole_points = count / 2 / 100;
+    for (int y = 0; y < 10; ++y) {
+        for (int x = 0; x < 10; ++x) {
+            const Vector2f center(-45.0f + 10.0f * static_cast<float>(x), -45.0f + 10.0f * static_cast<float>(y));
+            shape.holes.push_back(make_circle(center, 2.5f, hole_points, false));
+        }
+    }
+
+    return {"polygon of " + std::to_string(count) + " points with 100 holes", {std::move(shape)}};
+}
+
+// Glyph mesh keeps the outline points and then the holes points of every shape in the contour order.
+// The contour ends at the point connected to its first point by the triangulation boundary edge.
+bool add_mesh_shapes(const Mesh& mesh, std::vector<Shape>& shapes)
+{
+    const Mesh::VertexData& vertices = mesh.vertices();
+
+    std::unordered_map<std::uint64_t, int> edges;
+    for (const auto& [index, submesh] : mesh.submeshes()) {
+        const Mesh::IndicesData& indices = submesh.indices;
+        for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+            for (std::size_t j = 0; j < 3; ++j) {
+                const std::uint64_t a = std::min(indices[i + j], indices[i + (j + 1) % 3]);
+                const std::uint64_t b = std::max(indices[i + j], indices[i + (j + 1) % 3]);
+                ++edges[(a << 32) | b];
+            }
+        }
+    }
+
+    // The last point of every contour.
+    std::vector<std::size_t> contour_end(vertices.size(), 0);
+    for (const auto& [edge, count] : edges) {
+        if (count == 1) {
+            const auto a   = static_cast<std::size_t>(edge >> 32);
+            const auto b   = static_cast<std::size_t>(edge & 0xffffffff);
+            contour_end[a] = std::max(contour_end[a], b);
+        }
+    }
+
+    std::size_t first = 0;
+    while (first < vertices.size()) {
+        const std::size_t last = contour_end[first];
+        if (last < first + 2) {
+            return false;
+        }
+
+        Polygon polygon;
+        for (std::size_t i = first; i <= last; ++i) {
+            polygon.emplace_back(vertices[i].x, vertices[i].y);
+        }
+
+        if (polygon_area(polygon) > 0.0f) {
+            shapes.push_back({std::move(polygon), {}});
+        } else if (!shapes.empty()) {
+            shapes.back().holes.push_back(std::move(polygon));
+        } else {
+            return false;
+        }
+
+        first = last + 1;
+    }
+
+    return true;
+}
+
+// Outlines of the Latin, Greek and Cyrillic glyphs, restored from the glyph meshes of the font.
+Input make_font_input(const std::filesystem::path& path)
+{
+    Input input{path.stem().string() + " glyphs", {}};
+
+    Font font;
+    if (font.load(path) != Font::LoadResult::Success) {
+        std::cout << "Can't load font: " << path << "\n";
+        return input;
+    }
+
+    // Glyphs that can't be decoded or restored are skipped.
+    for (char32_t codepoint = 0x20; codepoint <= 0x4FF; ++codepoint) {
+        try {
+            const Mesh mesh = font.create_text_mesh(utf::to_utf8(std::u32string(1, codepoint)));
+
+            std::vector<Shape> shapes;
+            if (add_mesh_shapes(mesh, shapes)) {
+                input.shapes.insert(input.shapes.end(), shapes.begin(), shapes.end());
+            }
+        } catch (const NotImplementedError&) {
+            continue;
+        }
+    }
+
+    return input;
+}
+
+std::vector<Input> make_inputs()
+{
+    std::vector<Input> inputs;
+
+    std::vector<std::filesystem::path> fonts;
+    for (const auto& entry : std::filesystem::directory_iterator("fonts")) {
+        fonts.push_back(entry.path());
+    }
+    std::sort(fonts.begin(), fonts.end());
+
+    for (const auto& font : fonts) {
+        inputs.push_back(make_font_input(font));
+    }
+
+    for (std::size_t count : {1000, 10000, 100000}) {
+        inputs.push_back(make_polygon_input(count));
+    }
+
+    inputs.push_back(make_holes_input(100000));
+
+    return inputs;
+}
+
+void run(const Input& input)
+{
+    benchmark::print_header(input.name + ", " + std::to_string(input.shapes.size()) + " shapes, " +
+                            std::to_string(points_count(input.shapes)) + " points");
+
+    const double ear_cut = benchmark::measure([&input]() {
+        for (const auto& shape : input.shapes) {
+            benchmark::keep(generate_ear_cut_triangulation(shape.outline, shape.holes).size());
+        }
+    });
+
+    const double delaunay = benchmark::measure([&input]() {
+        for (const auto& shape : input.shapes) {
+            benchmark::keep(generate_delaunay_triangulation(shape.outline, shape.holes).size());
+        }
+    });
+
+    benchmark::print("ear cut", ear_cut);
+    benchmark::print("delaunay", delaunay);
+}
+
+} // namespace
+
+int main()
+{
+    for (const auto& input : make_inputs()) {
+        run(input);
+    }
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#ifndef COMMON_MEMORY_MAPPED_FILE_HPP
+#define COMMON_MEMORY_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+
+#include <common/span.hpp>
+
+namespace framework
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup utils_types_module
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Read-only view of the whole file contents mapped to memory.
+///
+/// The file contents are paged in by the operating system on access,
+/// so parsers can work on the bytes directly without intermediate buffers.
+class MemoryMappedFile final
+{
+public:
+    /// @brief Creates closed MemoryMappedFile.
+    MemoryMappedFile() = default;
+
+    /// @brief Maps file to memory.
+    ///
+    /// @param filepath Path to the file.
+    ///
+    /// @see is_open
+    explicit MemoryMappedFile(const std::filesystem::path& filepath);
+
+    MemoryMappedFile(const MemoryMappedFile&) = delete;
+    MemoryMappedFile& operator=(const MemoryMappedFile&) = delete;
+
+    MemoryMappedFile(MemoryMappedFile&& other) noexcept;
+    MemoryMappedFile& operator=(MemoryMappedFile&& other) noexcept;
+
+    /// @brief Unmaps file.
+    ~MemoryMappedFile();
+
+    /// @brief Maps file to memory. The previously mapped file will be closed.
+    ///
+    /// @param filepath Path to the file.
+    ///
+    /// @return `true` if file is successfully mapped.
+    bool open(const std::filesystem::path& filepath);
+
+    /// @brief Unmaps file.
+    void close() noexcept;
+
+    /// @brief Checks if file is mapped.
+    ///
+    /// Empty file is considered successfully mapped, it has no data.
+    ///
+    /// @return `true` if file is mapped.
+    bool is_open() const noexcept;
+
+    /// @brief Pointer to the file contents.
+    ///
+    /// @return Pointer to the first byte of file or `nullptr` if file is empty or not mapped.
+    const std::uint8_t* data() const noexcept;
+
+    /// @brief Size of the file.
+    ///
+    /// @return Number of mapped bytes.
+    std::size_t size() const noexcept;
+
+    /// @brief File contents.
+    ///
+    /// @return Span over the all mapped bytes.
+    Span<const std::uint8_t> bytes() const noexcept;
+
+private:
+    bool map(const std::filesystem::path& filepath);
+    void unmap() noexcept;
+
+    const std::uint8_t* m_data = nullptr;
+    std::size_t m_size         = 0;
+    bool m_is_open             = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework
+
+#endif
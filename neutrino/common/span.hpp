@@ -0,0 +1,303 @@
+#ifndef COMMON_SPAN_HPP
+#define COMMON_SPAN_HPP
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+
+namespace framework
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup utils_types_module
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Non-owning view over a contiguous sequence of objects.
+///
+/// Minimal replacement of the C++20 std::span with dynamic extent.
+/// The Span doesn't manage the lifetime of the referenced objects.
+template <typename T>
+class Span
+{
+public:
+    using ElementType = T;
+    using ValueType   = std::remove_cv_t<T>;
+    using SizeType    = std::size_t;
+    using Iterator    = T*;
+
+    /// @brief Special value of count, which means the rest of the Span.
+    static constexpr SizeType npos = std::numeric_limits<SizeType>::max();
+
+    /// @brief Creates an empty Span.
+    constexpr Span() noexcept = default;
+
+    /// @brief Creates Span over the range [data, data + size).
+    ///
+    /// @param data Pointer to the first element.
+    /// @param size Number of elements.
+    constexpr Span(T* data, SizeType size) noexcept;
+
+    /// @brief Creates Span over the range [first, last).
+    ///
+    /// @param first Pointer to the first element.
+    /// @param last Pointer past the last element.
+    constexpr Span(T* first, T* last) noexcept;
+
+    /// @brief Creates Span over the array.
+    ///
+    /// @param array Array to view.
+    template <std::size_t N>
+    constexpr Span(T (&array)[N]) noexcept;
+
+    /// @brief Creates Span over the contiguous container, like std::vector, std::array or std::string.
+    ///
+    /// @param container Container to view.
+    template <typename Container,
+              typename = std::enable_if_t<std::is_convertible_v<decltype(std::data(std::declval<Container&>())), T*>>>
+    constexpr Span(Container& container) noexcept;
+
+    /// @brief Creates Span over the constant contiguous container, like std::vector, std::array or std::string.
+    ///
+    /// @param container Container to view.
+    template <typename Container,
+              typename = std::enable_if_t<
+              std::is_convertible_v<decltype(std::data(std::declval<const Container&>())), T*>>>
+    constexpr Span(const Container& container) noexcept;
+
+    /// @brief Creates Span from another one with compatible element type, e.g. Span<const T> from Span<T>.
+    ///
+    /// @param other Span to view the same range.
+    template <typename U, typename = std::enable_if_t<std::is_convertible_v<U (*)[], T (*)[]>>>
+    constexpr Span(const Span<U>& other) noexcept;
+
+    /// @brief Access operator.
+    ///
+    /// @param index Index of element.
+    ///
+    /// @return Reference to element at index.
+    constexpr T& operator[](SizeType index) const noexcept;
+
+    /// @brief Pointer to the first element.
+    ///
+    /// @return Pointer to the beginning of the sequence.
+    constexpr T* data() const noexcept;
+
+    /// @brief Number of elements.
+    ///
+    /// @return Number of elements in the Span.
+    constexpr SizeType size() const noexcept;
+
+    /// @brief Size of the sequence in bytes.
+    ///
+    /// @return Number of bytes the elements take.
+    constexpr SizeType size_bytes() const noexcept;
+
+    /// @brief Checks if the Span is empty.
+    ///
+    /// @return `true` if the Span has no elements.
+    constexpr bool empty() const noexcept;
+
+    /// @brief Iterator to the first element.
+    ///
+    /// @return Iterator to the beginning.
+    constexpr Iterator begin() const noexcept;
+
+    /// @brief Iterator past the last element.
+    ///
+    /// @return Iterator to the end.
+    constexpr Iterator end() const noexcept;
+
+    /// @brief First element.
+    ///
+    /// @return Reference to the first element.
+    constexpr T& front() const noexcept;
+
+    /// @brief Last element.
+    ///
+    /// @return Reference to the last element.
+    constexpr T& back() const noexcept;
+
+    /// @brief Span over the first count elements.
+    ///
+    /// @param count Number of elements, clamped to the size of the Span.
+    ///
+    /// @return Span over the first elements.
+    constexpr Span first(SizeType count) const noexcept;
+
+    /// @brief Span over the last count elements.
+    ///
+    /// @param count Number of elements, clamped to the size of the Span.
+    ///
+    /// @return Span over the last elements.
+    constexpr Span last(SizeType count) const noexcept;
+
+    /// @brief Span over the count elements starting from offset.
+    ///
+    /// Both offset and count are clamped to the size of the Span, so result is always a valid range.
+    ///
+    /// @param offset Index of the first element.
+    /// @param count Number of elements, or npos for the rest of the Span.
+    ///
+    /// @return Span over the elements range.
+    constexpr Span subspan(SizeType offset, SizeType count = npos) const noexcept;
+
+private:
+    T* m_data       = nullptr;
+    SizeType m_size = 0;
+};
+
+/// @brief Span deduction guide for containers.
+template <typename Container>
+Span(Container&) -> Span<std::remove_pointer_t<decltype(std::data(std::declval<Container&>()))>>;
+
+/// @brief Span deduction guide for constant containers.
+template <typename Container>
+Span(const Container&) -> Span<std::remove_pointer_t<decltype(std::data(std::declval<const Container&>()))>>;
+
+/// @brief Span deduction guide for arrays.
+template <typename T, std::size_t N>
+Span(T (&)[N]) -> Span<T>;
+
+/// @brief Span deduction guide for pointer and size.
+template <typename T>
+Span(T*, std::size_t) -> Span<T>;
+
+/// @brief Views the bytes of the Span elements.
+///
+/// @param span Span to view.
+///
+/// @return Span over the object representation of the elements.
+template <typename T>
+inline Span<const std::byte> as_bytes(Span<T> span) noexcept
+{
+    return Span<const std::byte>(reinterpret_cast<const std::byte*>(span.data()), span.size_bytes());
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+inline constexpr Span<T>::Span(T* data, SizeType size) noexcept
+    : m_data(data)
+    , m_size(size)
+{}
+
+template <typename T>
+inline constexpr Span<T>::Span(T* first, T* last) noexcept
+    : m_data(first)
+    , m_size(static_cast<SizeType>(last - first))
+{}
+
+template <typename T>
+template <std::size_t N>
+inline constexpr Span<T>::Span(T (&array)[N]) noexcept
+    : m_data(array)
+    , m_size(N)
+{}
+
+template <typename T>
+template <typename Container, typename>
+inline constexpr Span<T>::Span(Container& container) noexcept
+    : m_data(std::data(container))
+    , m_size(std::size(container))
+{}
+
+template <typename T>
+template <typename Container, typename>
+inline constexpr Span<T>::Span(const Container& container) noexcept
+    : m_data(std::data(container))
+    , m_size(std::size(container))
+{}
+
+template <typename T>
+template <typename U, typename>
+inline constexpr Span<T>::Span(const Span<U>& other) noexcept
+    : m_data(other.data())
+    , m_size(other.size())
+{}
+
+template <typename T>
+inline constexpr T& Span<T>::operator[](SizeType index) const noexcept
+{
+    assert(index < m_size);
+    return m_data[index];
+}
+
+template <typename T>
+inline constexpr T* Span<T>::data() const noexcept
+{
+    return m_data;
+}
+
+template <typename T>
+inline constexpr typename Span<T>::SizeType Span<T>::size() const noexcept
+{
+    return m_size;
+}
+
+template <typename T>
+inline constexpr typename Span<T>::SizeType Span<T>::size_bytes() const noexcept
+{
+    return m_size * sizeof(T);
+}
+
+template <typename T>
+inline constexpr bool Span<T>::empty() const noexcept
+{
+    return m_size == 0;
+}
+
+template <typename T>
+inline constexpr typename Span<T>::Iterator Span<T>::begin() const noexcept
+{
+    return m_data;
+}
+
+template <typename T>
+inline constexpr typename Span<T>::Iterator Span<T>::end() const noexcept
+{
+    return m_data + m_size;
+}
+
+template <typename T>
+inline constexpr T& Span<T>::front() const noexcept
+{
+    assert(m_size > 0);
+    return m_data[0];
+}
+
+template <typename T>
+inline constexpr T& Span<T>::back() const noexcept
+{
+    assert(m_size > 0);
+    return m_data[m_size - 1];
+}
+
+template <typename T>
+inline constexpr Span<T> Span<T>::first(SizeType count) const noexcept
+{
+    return subspan(0, count);
+}
+
+template <typename T>
+inline constexpr Span<T> Span<T>::last(SizeType count) const noexcept
+{
+    return count >= m_size ? *this : subspan(m_size - count);
+}
+
+template <typename T>
+inline constexpr Span<T> Span<T>::subspan(SizeType offset, SizeType count) const noexcept
+{
+    offset = offset < m_size ? offset : m_size;
+    count  = count < (m_size - offset) ? count : (m_size - offset);
+
+    return Span(m_data + offset, count);
+}
+
+} // namespace framework
+
+#endif
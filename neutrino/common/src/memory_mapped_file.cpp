@@ -0,0 +1,75 @@
+#include <utility>
+
+#include <common/memory_mapped_file.hpp>
+
+namespace framework
+{
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& filepath)
+{
+    open(filepath);
+}
+
+MemoryMappedFile::MemoryMappedFile(MemoryMappedFile&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr))
+    , m_size(std::exchange(other.m_size, 0))
+    , m_is_open(std::exchange(other.m_is_open, false))
+{}
+
+MemoryMappedFile& MemoryMappedFile::operator=(MemoryMappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+
+        m_data    = std::exchange(other.m_data, nullptr);
+        m_size    = std::exchange(other.m_size, 0);
+        m_is_open = std::exchange(other.m_is_open, false);
+    }
+
+    return *this;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    close();
+}
+
+bool MemoryMappedFile::open(const std::filesystem::path& filepath)
+{
+    close();
+
+    m_is_open = map(filepath);
+    return m_is_open;
+}
+
+void MemoryMappedFile::close() noexcept
+{
+    if (m_is_open) {
+        unmap();
+    }
+
+    m_data    = nullptr;
+    m_size    = 0;
+    m_is_open = false;
+}
+
+bool MemoryMappedFile::is_open() const noexcept
+{
+    return m_is_open;
+}
+
+const std::uint8_t* MemoryMappedFile::data() const noexcept
+{
+    return m_data;
+}
+
+std::size_t MemoryMappedFile::size() const noexcept
+{
+    return m_size;
+}
+
+Span<const std::uint8_t> MemoryMappedFile::bytes() const noexcept
+{
+    return Span<const std::uint8_t>(m_data, m_size);
+}
+
+} // namespace framework
@@ -0,0 +1,52 @@
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <common/memory_mapped_file.hpp>
+
+namespace framework
+{
+bool MemoryMappedFile::map(const std::filesystem::path& filepath)
+{
+    const int fd = ::open(filepath.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd == -1) {
+        return false;
+    }
+
+    struct stat file_stat = {};
+    if (::fstat(fd, &file_stat) == -1 || !S_ISREG(file_stat.st_mode)) {
+        ::close(fd);
+        return false;
+    }
+
+    // Mapping of zero length is invalid, empty file has no data.
+    if (file_stat.st_size == 0) {
+        ::close(fd);
+        return true;
+    }
+
+    const std::size_t size = static_cast<std::size_t>(file_stat.st_size);
+    void* address          = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // The mapping keeps the file referenced, descriptor isn't needed anymore.
+    ::close(fd);
+
+    if (address == MAP_FAILED) {
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(address);
+    m_size = size;
+
+    return true;
+}
+
+void MemoryMappedFile::unmap() noexcept
+{
+    if (m_data != nullptr) {
+        ::munmap(const_cast<std::uint8_t*>(m_data), m_size);
+    }
+}
+
+} // namespace framework
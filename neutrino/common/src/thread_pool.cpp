@@ -0,0 +1,142 @@
+#include <algorithm>
+
+#include <common/thread_pool.hpp>
+
+namespace
+{
+// Pool and index of the worker, which runs in the current thread.
+thread_local const framework::ThreadPool* current_pool = nullptr;
+thread_local std::size_t current_worker                = 0;
+
+} // namespace
+
+namespace framework
+{
+ThreadPool::ThreadPool(std::size_t threads_count)
+{
+    if (threads_count == 0) {
+        threads_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_queues.reserve(threads_count);
+    for (std::size_t i = 0; i < threads_count; ++i) {
+        m_queues.push_back(std::make_unique<Queue>());
+    }
+
+    m_threads.reserve(threads_count);
+    for (std::size_t i = 0; i < threads_count; ++i) {
+        m_threads.emplace_back(&ThreadPool::worker, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_task_added.notify_all();
+
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void ThreadPool::add_task(Task task)
+{
+    {
+        std::lock_guard lock(m_mutex);
+
+        std::size_t index = current_worker;
+        if (current_pool != this) {
+            index        = m_next_queue;
+            m_next_queue = (m_next_queue + 1) % m_queues.size();
+        }
+
+        // Counters are updated together with the queue, so a worker can't take the task before it's counted.
+        std::lock_guard queue_lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+
+        ++m_queued_tasks;
+        ++m_pending_tasks;
+    }
+
+    m_task_added.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock(m_mutex);
+    m_tasks_done.wait(lock, [this]() { return m_pending_tasks == 0; });
+}
+
+std::size_t ThreadPool::threads_count() const noexcept
+{
+    return m_threads.size();
+}
+
+void ThreadPool::worker(std::size_t index)
+{
+    current_pool   = this;
+    current_worker = index;
+
+    while (true) {
+        Task task;
+
+        if (pop_task(index, task)) {
+            try {
+                task();
+            } catch (...) {
+                // Exceptions are passed only through the futures of submitted functions.
+            }
+
+            task = nullptr;
+
+            std::lock_guard lock(m_mutex);
+            if (--m_pending_tasks == 0) {
+                m_tasks_done.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock lock(m_mutex);
+        m_task_added.wait(lock, [this]() { return m_stop || m_queued_tasks > 0; });
+
+        if (m_stop && m_queued_tasks == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::pop_task(std::size_t index, Task& task)
+{
+    auto take = [&task](Queue& queue, bool newest) {
+        std::lock_guard lock(queue.mutex);
+        if (queue.tasks.empty()) {
+            return false;
+        }
+
+        if (newest) {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        } else {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        return true;
+    };
+
+    bool found = take(*m_queues[index], true);
+    for (std::size_t i = 1; i < m_queues.size() && !found; ++i) {
+        found = take(*m_queues[(index + i) % m_queues.size()], false);
+    }
+
+    if (found) {
+        std::lock_guard lock(m_mutex);
+        --m_queued_tasks;
+    }
+
+    return found;
+}
+
+} // namespace framework
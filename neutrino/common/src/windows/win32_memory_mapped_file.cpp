@@ -0,0 +1,60 @@
+#include <windows.h>
+
+#include <common/memory_mapped_file.hpp>
+
+namespace framework
+{
+bool MemoryMappedFile::map(const std::filesystem::path& filepath)
+{
+    HANDLE file = CreateFileW(filepath.c_str(),
+                              GENERIC_READ,
+                              FILE_SHARE_READ,
+                              nullptr,
+                              OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                              nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+
+    LARGE_INTEGER file_size = {};
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // Mapping of zero length is invalid, empty file has no data.
+    if (file_size.QuadPart == 0) {
+        CloseHandle(file);
+        return true;
+    }
+
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+
+    if (mapping == nullptr) {
+        return false;
+    }
+
+    // The view keeps the mapping referenced, handle isn't needed anymore.
+    void* address = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+
+    if (address == nullptr) {
+        return false;
+    }
+
+    m_data = static_cast<const std::uint8_t*>(address);
+    m_size = static_cast<std::size_t>(file_size.QuadPart);
+
+    return true;
+}
+
+void MemoryMappedFile::unmap() noexcept
+{
+    if (m_data != nullptr) {
+        UnmapViewOfFile(m_data);
+    }
+}
+
+} // namespace framework
@@ -1,10 +1,20 @@
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <cmath>
 #include <cstring>
+#include <exception>
+#include <functional>
+#include <future>
 #include <iterator>
+#include <limits>
+#include <queue>
+#include <thread>
 #include <tuple>
+#include <utility>
 #include <vector>
 
+#include <common/thread_pool.hpp>
 #include <common/zlib.hpp>
 
 namespace
@@ -22,6 +32,71 @@ constexpr static std::uint32_t distance_alphabet_size = 32;
 
 constexpr static std::uint32_t end_of_block_code = 256;
 constexpr static std::uint32_t invalid_code      = 300;
+constexpr static std::uint32_t first_length_code = 257;
+
+constexpr static std::uint32_t max_litlen_codes          = 286;
+constexpr static std::uint32_t max_distance_codes        = 30;
+constexpr static std::uint32_t code_length_alphabet_size = 19;
+
+constexpr static std::uint8_t max_code_length             = 15;
+constexpr static std::uint8_t max_code_length_code_length = 7;
+
+constexpr static std::uint32_t min_match_length = 3;
+constexpr static std::uint32_t max_match_length = 258;
+constexpr static std::uint32_t too_far_distance = 4096; // Matches of min length with greater distance are useless
+
+constexpr static std::size_t hash_bits           = 15;
+constexpr static std::size_t hash_size           = 1 << hash_bits;
+constexpr static std::size_t block_symbols_count = 16384;
+constexpr static std::size_t min_segment_size    = 128 * 1024;
+
+constexpr static std::array<std::uint8_t, code_length_alphabet_size> code_length_order = {
+16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
+};
+
+//      Extra               Extra               Extra
+// Code Bits Length(s) Code Bits Lengths   Code Bits Length(s)
+// 257   0     3       267   1   15,16     277   4   67-82
+// 258   0     4       268   1   17,18     278   4   83-98
+// 259   0     5       269   2   19-22     279   4   99-114
+// 260   0     6       270   2   23-26     280   4  115-130
+// 261   0     7       271   2   27-30     281   5  131-162
+// 262   0     8       272   2   31-34     282   5  163-194
+// 263   0     9       273   3   35-42     283   5  195-226
+// 264   0    10       274   3   43-50     284   5  227-257
+// 265   1  11,12      275   3   51-58     285   0    258
+// 266   1  13,14      276   3   59-66
+
+constexpr static std::array<std::uint32_t, 29> length_extra_bits = {
+0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
+};
+
+constexpr static std::array<std::uint32_t, 29> length_base = {
+3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
+};
+
+//      Extra           Extra                Extra
+// Code Bits Dist  Code Bits   Dist     Code Bits Distance
+// ---- ---- ----  ---- ----  ------    ---- ---- --------
+// 0    0    1     10   4     33-48     20    9     1025-1536
+// 1    0    2     11   4     49-64     21    9     1537-2048
+// 2    0    3     12   5     65-96     22   10     2049-3072
+// 3    0    4     13   5     97-128    23   10     3073-4096
+// 4    1   5,6    14   6    129-192    24   11     4097-6144
+// 5    1   7,8    15   6    193-256    25   11     6145-8192
+// 6    2   9-12   16   7    257-384    26   12    8193-12288
+// 7    2  13-16   17   7    385-512    27   12   12289-16384
+// 8    3  17-24   18   8    513-768    28   13   16385-24576
+// 9    3  25-32   19   8   769-1024    29   13   24577-32768
+
+constexpr static std::array<std::uint32_t, max_distance_codes> distance_extra_bits = {
+0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
+};
+
+constexpr static std::array<std::uint32_t, max_distance_codes> distance_base = {
+1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
+193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
+};
 
 enum class CompressionAlgorithm
 {
@@ -31,10 +106,20 @@ enum class CompressionAlgorithm
     maximum           = 3, // - compressor used maximum compression, slowest algorithm
 };
 
+struct CompressionParameters
+{
+    CompressionAlgorithm algorithm; // Value of the FLEVEL field
+    std::uint32_t max_chain;        // Max number of hash chain entries to check
+    std::uint32_t good_length;      // Search less if match of this length is already found
+    std::uint32_t max_lazy;         // Don't look for the better match if match of this length is found
+    std::uint32_t nice_length;      // Stop searching if match of this length is found
+    bool lazy;                      // Check if the next position gives the better match
+};
+
 class BitStream
 {
 public:
-    explicit BitStream(const std::vector<std::uint8_t>& data)
+    explicit BitStream(Span<const std::uint8_t> data)
         : m_data(data)
     {}
 
@@ -89,7 +174,7 @@ private:
     std::uint32_t m_buffer = 0;
     std::uint32_t m_bits   = 0;
     std::size_t m_byte     = 0;
-    const std::vector<std::uint8_t>& m_data;
+    Span<const std::uint8_t> m_data;
 };
 
 std::uint16_t reflect(std::uint16_t value, std::uint8_t size)
@@ -145,7 +230,7 @@ public:
 private:
     void build_codes(const std::vector<std::uint8_t>& lengths)
     {
-        std::vector<std::uint8_t> bl_count(max_code_size);
+        std::vector<std::uint16_t> bl_count(max_code_size);
 
         for (auto len : lengths) {
             if (len >= max_code_size) {
@@ -202,7 +287,7 @@ struct ZlibHeader
     std::uint8_t cinfo : 4;
     std::uint8_t fcheck : 5;
     std::uint8_t fdict : 1;
-    std::uint8_t flevel : 3;
+    std::uint8_t flevel : 2;
 
     ZlibHeader() = default;
 
@@ -210,15 +295,6 @@ struct ZlibHeader
     {
         memcpy(this, &value, sizeof(value));
     }
-
-    std::uint16_t as_value() const
-    {
-        std::uint16_t tmp;
-        memcpy(&tmp, this, sizeof(std::uint16_t));
-
-        const std::uint16_t res = static_cast<std::uint16_t>(((tmp & 0xFF) << 8) | ((tmp >> 8) & 0xFF));
-        return res;
-    }
 };
 
 struct BlockHeader
@@ -252,7 +328,7 @@ struct BlockHeader
     }
 };
 
-LitLenDistanceCodes fixed_huffman_codes()
+const std::vector<std::uint8_t>& fixed_litlen_lengths()
 {
     /*
      Lit Value    Bits   Count   Codes
@@ -272,18 +348,25 @@ LitLenDistanceCodes fixed_huffman_codes()
     };
 
     static const std::vector<std::uint8_t> litlen_alphabet = init_litlen_alphabet();
+    return litlen_alphabet;
+}
+
+const std::vector<std::uint8_t>& fixed_distance_lengths()
+{
     static const std::vector<std::uint8_t> distance_alphabet(distance_alphabet_size, 5);
-    static const auto codes = std::make_tuple(HuffmanCodeTable(litlen_alphabet), HuffmanCodeTable(distance_alphabet));
+    return distance_alphabet;
+}
+
+LitLenDistanceCodes fixed_huffman_codes()
+{
+    static const auto codes = std::make_tuple(HuffmanCodeTable(fixed_litlen_lengths()),
+                                              HuffmanCodeTable(fixed_distance_lengths()));
 
     return codes;
 }
 
 LitLenDistanceCodes dynamic_huffman_codes(BitStream& in)
 {
-    constexpr static std::array<std::uint8_t, 19> length_order = {
-    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15,
-    };
-
     const std::uint16_t hlit  = in.get<std::uint16_t>(5);
     const std::uint16_t hdist = in.get<std::uint16_t>(5);
     const std::uint16_t hclen = in.get<std::uint16_t>(4);
@@ -295,7 +378,7 @@ LitLenDistanceCodes dynamic_huffman_codes(BitStream& in)
     std::vector<std::uint8_t> code_lengths(19);
 
     for (std::size_t i = 0; i < code_len_codes_count; ++i) {
-        code_lengths[length_order[i]] = static_cast<std::uint8_t>(in.get<std::uint16_t>(3));
+        code_lengths[code_length_order[i]] = static_cast<std::uint8_t>(in.get<std::uint16_t>(3));
     }
 
     const HuffmanCodeTable len_huffman(code_lengths);
@@ -331,31 +414,8 @@ LitLenDistanceCodes dynamic_huffman_codes(BitStream& in)
 
 std::uint16_t read_length(std::uint16_t value, BitStream& in)
 {
-    //      Extra               Extra               Extra
-    // Code Bits Length(s) Code Bits Lengths   Code Bits Length(s)
-    // 257   0     3       267   1   15,16     277   4   67-82
-    // 258   0     4       268   1   17,18     278   4   83-98
-    // 259   0     5       269   2   19-22     279   4   99-114
-    // 260   0     6       270   2   23-26     280   4  115-130
-    // 261   0     7       271   2   27-30     281   5  131-162
-    // 262   0     8       272   2   31-34     282   5  163-194
-    // 263   0     9       273   3   35-42     283   5  195-226
-    // 264   0    10       274   3   43-50     284   5  227-257
-    // 265   1  11,12      275   3   51-58     285   0    258
-    // 266   1  13,14      276   3   59-66
-
-    constexpr static std::uint16_t start_len = 257;
-
-    constexpr static std::array<std::uint32_t, 29> extra_bits_description = {
-    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0,
-    };
-
-    constexpr static std::array<std::uint32_t, 29> start_value_description = {
-    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258,
-    };
-
-    const std::uint32_t extra_bits  = extra_bits_description[value - start_len];
-    const std::uint32_t start_value = start_value_description[value - start_len];
+    const std::uint32_t extra_bits  = length_extra_bits[value - first_length_code];
+    const std::uint32_t start_value = length_base[value - first_length_code];
 
     std::uint32_t result = start_value;
     if (extra_bits > 0) {
@@ -367,31 +427,8 @@ std::uint16_t read_length(std::uint16_t value, BitStream& in)
 
 std::uint16_t read_distance(std::uint16_t value, BitStream& in)
 {
-    //      Extra           Extra                Extra
-    // Code Bits Dist  Code Bits   Dist     Code Bits Distance
-    // ---- ---- ----  ---- ----  ------    ---- ---- --------
-    // 0    0    1     10   4     33-48     20    9     1025-1536
-    // 1    0    2     11   4     49-64     21    9     1537-2048
-    // 2    0    3     12   5     65-96     22   10     2049-3072
-    // 3    0    4     13   5     97-128    23   10     3073-4096
-    // 4    1   5,6    14   6    129-192    24   11     4097-6144
-    // 5    1   7,8    15   6    193-256    25   11     6145-8192
-    // 6    2   9-12   16   7    257-384    26   12    8193-12288
-    // 7    2  13-16   17   7    385-512    27   12   12289-16384
-    // 8    3  17-24   18   8    513-768    28   13   16385-24576
-    // 9    3  25-32   19   8   769-1024    29   13   24577-32768
-
-    constexpr static std::array<std::uint32_t, 30> extra_bits_description = {
-    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13,
-    };
-
-    constexpr static std::array<std::uint32_t, 30> start_value_description = {
-    1,   2,   3,   4,   5,   7,    9,    13,   17,   25,   33,   49,   65,    97,    129,
-    193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577,
-    };
-
-    const std::uint32_t extra_bits  = extra_bits_description[value];
-    const std::uint32_t start_value = start_value_description[value];
+    const std::uint32_t extra_bits  = distance_extra_bits[value];
+    const std::uint32_t start_value = distance_base[value];
 
     std::uint32_t result = start_value;
     if (extra_bits > 0) {
@@ -426,7 +463,7 @@ void inflate_compression(const LitLenDistanceCodes& codes_pair, BitStream& in, s
             const std::uint16_t dist_code = distances.decode(in);
             const std::uint16_t distance  = read_distance(dist_code, in);
 
-            if (distance >= output.size()) {
+            if (distance > output.size()) {
                 break; // error
             }
 
@@ -451,43 +488,638 @@ inline void inflate_dynamic_huffman(BitStream& in, std::vector<std::uint8_t>& ou
     inflate_compression(codes_pair, in, output);
 }
 
-void deflate_no_compression(const std::vector<std::uint8_t>& data, std::vector<std::uint8_t>& output)
+#pragma region deflate
+
+struct Symbol
+{
+    std::uint16_t value;    // Literal byte or match length
+    std::uint16_t distance; // Match distance, zero for literals
+};
+
+struct Match
+{
+    std::uint32_t length   = 0;
+    std::uint32_t distance = 0;
+};
+
+struct HuffmanCode
+{
+    std::vector<std::uint8_t> lengths;
+    std::vector<std::uint16_t> codes; // Bit reversed codes, ready to be written LSB first
+};
+
+struct CodeLengthSymbol
+{
+    std::uint8_t symbol;
+    std::uint8_t extra;
+};
+
+struct DynamicHeader
+{
+    std::size_t hlit  = 0;
+    std::size_t hdist = 0;
+    std::size_t hclen = 0;
+    std::vector<CodeLengthSymbol> symbols;
+    HuffmanCode code;
+    std::size_t size = 0; // Size in bits
+};
+
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<std::uint8_t>& output)
+        : m_output(output)
+    {}
+
+    void put(std::uint32_t value, std::uint32_t count)
+    {
+        m_buffer |= static_cast<std::uint64_t>(value) << m_bits;
+        m_bits += count;
+
+        while (m_bits >= 8) {
+            m_output.push_back(static_cast<std::uint8_t>(m_buffer & 0xFF));
+            m_buffer >>= 8;
+            m_bits -= 8;
+        }
+    }
+
+    void put_bytes(Span<const std::uint8_t> bytes)
+    {
+        assert(m_bits == 0);
+        m_output.insert(m_output.end(), bytes.begin(), bytes.end());
+    }
+
+    void align_to_byte()
+    {
+        if (m_bits > 0) {
+            put(0, 8 - m_bits);
+        }
+    }
+
+private:
+    std::vector<std::uint8_t>& m_output;
+    std::uint64_t m_buffer = 0;
+    std::uint32_t m_bits   = 0;
+};
+
+class MatchFinder
+{
+public:
+    MatchFinder(Span<const std::uint8_t> data, const CompressionParameters& parameters)
+        : m_data(data)
+        , m_parameters(parameters)
+        , m_head(hash_size, no_position)
+        , m_prev(max_window_size, no_position)
+    {}
+
+    void insert(std::size_t position)
+    {
+        if (position + min_match_length > m_data.size()) {
+            return;
+        }
+
+        const std::size_t hash = hash_at(position);
+
+        m_prev[position & window_mask] = m_head[hash];
+        m_head[hash]                   = position;
+    }
+
+    // Finds the longest match, which is longer than min_length and doesn't cross the end.
+    Match find(std::size_t position, std::size_t end, std::uint32_t min_length) const
+    {
+        Match match;
+
+        const std::size_t limit = std::min<std::size_t>(max_match_length, end - position);
+        if (limit < min_match_length || min_length >= limit) {
+            return match;
+        }
+
+        std::size_t best_length = min_length;
+        std::uint32_t chain     = min_length >= m_parameters.good_length ? m_parameters.max_chain >> 2
+                                                                         : m_parameters.max_chain;
+
+        const std::uint8_t* current = m_data.data() + position;
+        std::size_t candidate       = m_head[hash_at(position)];
+
+        while (candidate < position && position - candidate <= max_window_size && chain-- > 0) {
+            const std::uint8_t* other = m_data.data() + candidate;
+
+            if (other[best_length] == current[best_length] && other[0] == current[0]) {
+                std::size_t length = 1;
+                while (length < limit && other[length] == current[length]) {
+                    ++length;
+                }
+
+                if (length > best_length) {
+                    best_length    = length;
+                    match.length   = static_cast<std::uint32_t>(length);
+                    match.distance = static_cast<std::uint32_t>(position - candidate);
+
+                    if (length >= m_parameters.nice_length || length >= limit) {
+                        break;
+                    }
+                }
+            }
+
+            const std::size_t next = m_prev[candidate & window_mask];
+            if (next >= candidate) {
+                break;
+            }
+            candidate = next;
+        }
+
+        return match;
+    }
+
+private:
+    static constexpr std::size_t no_position = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t window_mask = max_window_size - 1;
+
+    std::size_t hash_at(std::size_t position) const
+    {
+        const std::uint8_t* bytes = m_data.data() + position;
+        return ((static_cast<std::size_t>(bytes[0]) << 10) ^ (static_cast<std::size_t>(bytes[1]) << 5) ^ bytes[2]) &
+               (hash_size - 1);
+    }
+
+    Span<const std::uint8_t> m_data;
+    CompressionParameters m_parameters;
+    std::vector<std::size_t> m_head;
+    std::vector<std::size_t> m_prev;
+};
+
+CompressionParameters compression_parameters(zlib::CompressionLevel level)
+{
+    switch (level) {
+        case zlib::CompressionLevel::no_compression: return {CompressionAlgorithm::fastest, 0, 0, 0, 0, false};
+        case zlib::CompressionLevel::fastest: return {CompressionAlgorithm::fastest, 4, 4, 0, 8, false};
+        case zlib::CompressionLevel::default_compression:
+            return {CompressionAlgorithm::default_algorithm, 128, 8, 16, 128, true};
+        case zlib::CompressionLevel::best_compression:
+            return {CompressionAlgorithm::maximum, 4096, 32, max_match_length, max_match_length, true};
+    }
+
+    return {CompressionAlgorithm::default_algorithm, 128, 8, 16, 128, true};
+}
+
+std::array<std::uint8_t, max_match_length + 1> make_length_codes()
+{
+    std::array<std::uint8_t, max_match_length + 1> codes{};
+
+    for (std::size_t code = 0; code < length_base.size(); ++code) {
+        const std::size_t last = std::min<std::size_t>(length_base[code] + (1u << length_extra_bits[code]) - 1,
+                                                       max_match_length);
+
+        for (std::size_t length = length_base[code]; length <= last; ++length) {
+            codes[length] = static_cast<std::uint8_t>(code);
+        }
+    }
+
+    return codes;
+}
+
+// Codes for distances up to 256 are stored directly, for greater distances by the (distance - 1) / 128.
+std::array<std::uint8_t, 512> make_distance_codes()
+{
+    std::array<std::uint8_t, 512> codes{};
+
+    for (std::size_t code = 0; code < distance_base.size(); ++code) {
+        const std::size_t last = distance_base[code] + (1u << distance_extra_bits[code]) - 1;
+
+        for (std::size_t distance = distance_base[code] - 1; distance < last; ++distance) {
+            codes[distance < 256 ? distance : 256 + (distance >> 7)] = static_cast<std::uint8_t>(code);
+        }
+    }
+
+    return codes;
+}
+
+const std::array<std::uint8_t, max_match_length + 1> length_codes = make_length_codes();
+const std::array<std::uint8_t, 512> distance_codes                = make_distance_codes();
+
+inline std::uint32_t distance_code(std::uint32_t distance)
+{
+    const std::uint32_t value = distance - 1;
+    return distance_codes[value < 256 ? value : 256 + (value >> 7)];
+}
+
+inline std::uint32_t code_length_extra_bits(std::uint8_t symbol)
+{
+    switch (symbol) {
+        case 16: return 2;
+        case 17: return 3;
+        case 18: return 7;
+        default: return 0;
+    }
+}
+
+// Builds length limited Huffman code lengths.
+// If the tree is too deep, frequencies are flattened until it fits the max_length.
+std::vector<std::uint8_t> build_code_lengths(Span<const std::uint32_t> frequencies, std::uint8_t max_length)
+{
+    std::vector<std::uint8_t> lengths(frequencies.size(), 0);
+
+    std::vector<std::size_t> symbols;
+    for (std::size_t i = 0; i < frequencies.size(); ++i) {
+        if (frequencies[i] > 0) {
+            symbols.push_back(i);
+        }
+    }
+
+    if (symbols.size() < 2) {
+        // Code with one symbol is incomplete, add one more to make decoders happy.
+        lengths[(symbols.empty() || symbols[0] != 0) ? 0 : 1] = 1;
+        for (const auto symbol : symbols) {
+            lengths[symbol] = 1;
+        }
+        return lengths;
+    }
+
+    std::vector<std::uint64_t> weights(symbols.size());
+    for (std::size_t i = 0; i < symbols.size(); ++i) {
+        weights[i] = frequencies[symbols[i]];
+    }
+
+    using Node = std::pair<std::uint64_t, std::size_t>;
+
+    std::vector<std::size_t> parents(symbols.size() * 2 - 1);
+    std::vector<std::size_t> depths(parents.size());
+
+    while (true) {
+        std::priority_queue<Node, std::vector<Node>, std::greater<Node>> queue;
+        for (std::size_t i = 0; i < weights.size(); ++i) {
+            queue.emplace(weights[i], i);
+        }
+
+        std::size_t next_node = symbols.size();
+        while (queue.size() > 1) {
+            const Node first = queue.top();
+            queue.pop();
+            const Node second = queue.top();
+            queue.pop();
+
+            parents[first.second]  = next_node;
+            parents[second.second] = next_node;
+            queue.emplace(first.first + second.first, next_node++);
+        }
+
+        // Parents always have greater index than children, so the depths can be computed in one pass from the root.
+        const std::size_t root = next_node - 1;
+        std::size_t max_depth  = 0;
+
+        depths[root] = 0;
+        for (std::size_t node = root; node-- > 0;) {
+            depths[node] = depths[parents[node]] + 1;
+            if (node < symbols.size()) {
+                max_depth = std::max(max_depth, depths[node]);
+            }
+        }
+
+        if (max_depth <= max_length) {
+            for (std::size_t i = 0; i < symbols.size(); ++i) {
+                lengths[symbols[i]] = static_cast<std::uint8_t>(depths[i]);
+            }
+            return lengths;
+        }
+
+        for (auto& weight : weights) {
+            weight = (weight >> 1) | 1;
+        }
+    }
+}
+
+HuffmanCode make_huffman_code(std::vector<std::uint8_t> lengths)
+{
+    std::array<std::uint16_t, max_code_size> bl_count{};
+    for (const auto length : lengths) {
+        bl_count[length]++;
+    }
+    bl_count[0] = 0;
+
+    std::array<std::uint16_t, max_code_size> next_code{};
+    std::uint16_t code = 0;
+    for (std::size_t bits = 1; bits < max_code_size; ++bits) {
+        code            = static_cast<std::uint16_t>((code + bl_count[bits - 1]) << 1);
+        next_code[bits] = code;
+    }
+
+    std::vector<std::uint16_t> codes(lengths.size(), 0);
+    for (std::size_t i = 0; i < lengths.size(); ++i) {
+        if (lengths[i] != 0) {
+            codes[i] = reflect(next_code[lengths[i]]++, lengths[i]);
+        }
+    }
+
+    return HuffmanCode{std::move(lengths), std::move(codes)};
+}
+
+std::vector<CodeLengthSymbol> run_length_encode(const std::vector<std::uint8_t>& lengths)
+{
+    std::vector<CodeLengthSymbol> symbols;
+
+    for (std::size_t i = 0; i < lengths.size();) {
+        const std::uint8_t length = lengths[i];
+
+        std::size_t run = 1;
+        while (i + run < lengths.size() && lengths[i + run] == length) {
+            ++run;
+        }
+        i += run;
+
+        if (length == 0) {
+            while (run >= 11) {
+                const std::size_t count = std::min<std::size_t>(run, 138);
+                symbols.push_back({18, static_cast<std::uint8_t>(count - 11)});
+                run -= count;
+            }
+
+            if (run >= 3) {
+                symbols.push_back({17, static_cast<std::uint8_t>(run - 3)});
+                run = 0;
+            }
+        } else {
+            symbols.push_back({length, 0});
+            --run;
+
+            while (run >= 3) {
+                const std::size_t count = std::min<std::size_t>(run, 6);
+                symbols.push_back({16, static_cast<std::uint8_t>(count - 3)});
+                run -= count;
+            }
+        }
+
+        symbols.insert(symbols.end(), run, CodeLengthSymbol{length, 0});
+    }
+
+    return symbols;
+}
+
+DynamicHeader make_dynamic_header(const HuffmanCode& litlen, const HuffmanCode& distance)
+{
+    DynamicHeader header;
+
+    header.hlit = litlen.lengths.size();
+    while (header.hlit > first_length_code && litlen.lengths[header.hlit - 1] == 0) {
+        --header.hlit;
+    }
+
+    header.hdist = distance.lengths.size();
+    while (header.hdist > 1 && distance.lengths[header.hdist - 1] == 0) {
+        --header.hdist;
+    }
+
+    std::vector<std::uint8_t> lengths(litlen.lengths.begin(),
+                                      std::next(litlen.lengths.begin(), static_cast<std::ptrdiff_t>(header.hlit)));
+    lengths.insert(lengths.end(),
+                   distance.lengths.begin(),
+                   std::next(distance.lengths.begin(), static_cast<std::ptrdiff_t>(header.hdist)));
+
+    header.symbols = run_length_encode(lengths);
+
+    std::array<std::uint32_t, code_length_alphabet_size> frequencies{};
+    for (const auto& symbol : header.symbols) {
+        frequencies[symbol.symbol]++;
+    }
+
+    header.code = make_huffman_code(build_code_lengths(frequencies, max_code_length_code_length));
+
+    header.hclen = code_length_alphabet_size;
+    while (header.hclen > 4 && header.code.lengths[code_length_order[header.hclen - 1]] == 0) {
+        --header.hclen;
+    }
+
+    header.size = 5 + 5 + 4 + 3 * header.hclen;
+    for (const auto& symbol : header.symbols) {
+        header.size += header.code.lengths[symbol.symbol] + code_length_extra_bits(symbol.symbol);
+    }
+
+    return header;
+}
+
+const std::tuple<HuffmanCode, HuffmanCode>& fixed_huffman_encoding()
+{
+    static const auto codes = std::make_tuple(make_huffman_code(fixed_litlen_lengths()),
+                                              make_huffman_code(fixed_distance_lengths()));
+
+    return codes;
+}
+
+std::size_t encoded_size(Span<const std::uint32_t> frequencies, const std::vector<std::uint8_t>& lengths)
 {
-    const std::size_t blocks_count = (data.size() / max_block_size) + 1;
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < frequencies.size(); ++i) {
+        size += static_cast<std::size_t>(frequencies[i]) * lengths[i];
+    }
+    return size;
+}
+
+void write_stored_blocks(BitWriter& out, Span<const std::uint8_t> data, bool final)
+{
+    do {
+        const auto block = data.first(max_block_size);
+        data             = data.subspan(block.size());
+
+        const std::uint32_t len = static_cast<std::uint32_t>(block.size());
+
+        out.put(final && data.empty() ? 1 : 0, 1);
+        out.put(BlockHeader::no_compression, 2);
+        out.align_to_byte();
+        out.put(len, 16);
+        out.put(~len & 0xFFFF, 16);
+        out.put_bytes(block);
+    } while (!data.empty());
+}
 
-    for (std::size_t block = 0; block < blocks_count; ++block) {
-        BlockHeader b_header;
-        b_header.bfinal = ((block + 1) >= blocks_count ? 1 : 0);
-        b_header.btype  = BlockHeader::no_compression;
+void write_dynamic_header(BitWriter& out, const DynamicHeader& header)
+{
+    out.put(static_cast<std::uint32_t>(header.hlit - first_length_code), 5);
+    out.put(static_cast<std::uint32_t>(header.hdist - 1), 5);
+    out.put(static_cast<std::uint32_t>(header.hclen - 4), 4);
+
+    for (std::size_t i = 0; i < header.hclen; ++i) {
+        out.put(header.code.lengths[code_length_order[i]], 3);
+    }
+
+    for (const auto& symbol : header.symbols) {
+        out.put(header.code.codes[symbol.symbol], header.code.lengths[symbol.symbol]);
+        out.put(symbol.extra, code_length_extra_bits(symbol.symbol));
+    }
+}
 
-        output.push_back(static_cast<std::uint8_t>(b_header));
+void write_symbols(BitWriter& out, Span<const Symbol> symbols, const HuffmanCode& litlen, const HuffmanCode& distance)
+{
+    for (const auto& symbol : symbols) {
+        if (symbol.distance == 0) {
+            out.put(litlen.codes[symbol.value], litlen.lengths[symbol.value]);
+            continue;
+        }
 
-        const std::uint16_t len = static_cast<std::uint16_t>(
-        std::min(max_block_size, static_cast<std::uint32_t>(data.size() - block * max_block_size)));
+        const std::uint32_t length_code = length_codes[symbol.value];
+        const std::uint32_t litlen_code = first_length_code + length_code;
+        out.put(litlen.codes[litlen_code], litlen.lengths[litlen_code]);
+        out.put(symbol.value - length_base[length_code], length_extra_bits[length_code]);
 
-        output.push_back(static_cast<std::uint8_t>(len & 0xFF));
-        output.push_back(static_cast<std::uint8_t>((len >> 8) & 0xFF));
+        const std::uint32_t dist_code = distance_code(symbol.distance);
+        out.put(distance.codes[dist_code], distance.lengths[dist_code]);
+        out.put(symbol.distance - distance_base[dist_code], distance_extra_bits[dist_code]);
+    }
 
-        const std::uint16_t nlen = static_cast<std::uint16_t>(~len);
-        output.push_back(static_cast<std::uint8_t>(nlen & 0xFF));
-        output.push_back(static_cast<std::uint8_t>((nlen >> 8) & 0xFF));
+    out.put(litlen.codes[end_of_block_code], litlen.lengths[end_of_block_code]);
+}
 
-        for (std::size_t i = 0; i < max_block_size && i < data.size(); ++i) {
-            output.push_back(data[block * max_block_size + i]);
+// Writes block with the cheapest of dynamic Huffman, fixed Huffman or no compression encoding.
+void write_block(BitWriter& out, Span<const Symbol> symbols, Span<const std::uint8_t> data, bool final)
+{
+    std::array<std::uint32_t, max_litlen_codes> litlen_frequencies{};
+    std::array<std::uint32_t, max_distance_codes> distance_frequencies{};
+    std::size_t extra_bits_size = 0;
+
+    for (const auto& symbol : symbols) {
+        if (symbol.distance == 0) {
+            litlen_frequencies[symbol.value]++;
+            continue;
         }
+
+        const std::uint32_t length_code = length_codes[symbol.value];
+        const std::uint32_t dist_code   = distance_code(symbol.distance);
+
+        litlen_frequencies[first_length_code + length_code]++;
+        distance_frequencies[dist_code]++;
+        extra_bits_size += length_extra_bits[length_code] + distance_extra_bits[dist_code];
+    }
+    litlen_frequencies[end_of_block_code] = 1;
+
+    const HuffmanCode litlen   = make_huffman_code(build_code_lengths(litlen_frequencies, max_code_length));
+    const HuffmanCode distance = make_huffman_code(build_code_lengths(distance_frequencies, max_code_length));
+    const DynamicHeader header = make_dynamic_header(litlen, distance);
+
+    const auto& [fixed_litlen, fixed_distance] = fixed_huffman_encoding();
+
+    const std::size_t dynamic_size = 3 + header.size + extra_bits_size +
+                                     encoded_size(litlen_frequencies, litlen.lengths) +
+                                     encoded_size(distance_frequencies, distance.lengths);
+
+    const std::size_t fixed_size = 3 + extra_bits_size + encoded_size(litlen_frequencies, fixed_litlen.lengths) +
+                                   encoded_size(distance_frequencies, fixed_distance.lengths);
+
+    const std::size_t stored_blocks = std::max<std::size_t>(1, (data.size() + max_block_size - 1) / max_block_size);
+    const std::size_t stored_size   = (data.size() + stored_blocks * 5) * 8 + 7;
+
+    if (stored_size <= fixed_size && stored_size <= dynamic_size) {
+        write_stored_blocks(out, data, final);
+    } else if (fixed_size <= dynamic_size) {
+        out.put(final ? 1 : 0, 1);
+        out.put(BlockHeader::fixed_huffman, 2);
+        write_symbols(out, symbols, fixed_litlen, fixed_distance);
+    } else {
+        out.put(final ? 1 : 0, 1);
+        out.put(BlockHeader::dynamic_huffman, 2);
+        write_dynamic_header(out, header);
+        write_symbols(out, symbols, litlen, distance);
     }
 }
 
-std::uint32_t adler32(const std::vector<std::uint8_t>& data)
+// Compresses data range [begin, end) into the sequence of blocks.
+// Up to 32K bytes before the begin are used as a dictionary, so ranges can be compressed independently.
+// Not final range ends with the empty stored block to align output to the byte boundary.
+std::vector<std::uint8_t> deflate_range(Span<const std::uint8_t> data,
+                                        std::size_t begin,
+                                        std::size_t end,
+                                        const CompressionParameters& parameters,
+                                        bool final)
+{
+    std::vector<std::uint8_t> output;
+    BitWriter out(output);
+
+    if (parameters.max_chain == 0) {
+        write_stored_blocks(out, data.subspan(begin, end - begin), final);
+    } else {
+        MatchFinder finder(data, parameters);
+        for (std::size_t i = begin - std::min<std::size_t>(begin, max_window_size); i < begin; ++i) {
+            finder.insert(i);
+        }
+
+        auto find_match = [&finder, end](std::size_t position, std::uint32_t min_length) {
+            const Match match = finder.find(position, end, min_length);
+            if (match.length == min_match_length && match.distance > too_far_distance) {
+                return Match();
+            }
+            return match;
+        };
+
+        std::vector<Symbol> symbols;
+        symbols.reserve(block_symbols_count);
+
+        std::size_t block_begin = begin;
+        std::size_t position    = begin;
+
+        while (position < end) {
+            Match match = find_match(position, min_match_length - 1);
+            finder.insert(position);
+
+            if (match.length == 0) {
+                symbols.push_back({data[position], 0});
+                ++position;
+            } else {
+                while (parameters.lazy && match.length < parameters.max_lazy && position + 1 < end) {
+                    const Match next = find_match(position + 1, match.length);
+                    if (next.length == 0) {
+                        break;
+                    }
+
+                    symbols.push_back({data[position], 0});
+                    finder.insert(++position);
+                    match = next;
+                }
+
+                symbols.push_back(
+                {static_cast<std::uint16_t>(match.length), static_cast<std::uint16_t>(match.distance)});
+
+                for (std::size_t i = 1; i < match.length; ++i) {
+                    finder.insert(position + i);
+                }
+                position += match.length;
+            }
+
+            if (symbols.size() >= block_symbols_count && position < end) {
+                write_block(out, symbols, data.subspan(block_begin, position - block_begin), false);
+                symbols.clear();
+                block_begin = position;
+            }
+        }
+
+        write_block(out, symbols, data.subspan(block_begin, end - block_begin), final);
+    }
+
+    if (!final) {
+        write_stored_blocks(out, Span<const std::uint8_t>(), false);
+    }
+
+    out.align_to_byte();
+
+    return output;
+}
+
+#pragma endregion
+
+std::uint32_t adler32(Span<const std::uint8_t> data)
 {
     constexpr std::uint32_t base = 65521; // largest prime smaller than 65536
+    constexpr std::size_t nmax   = 5552;  // max bytes count before the s2 overflow
 
     std::uint32_t s1 = 1 & 0xffff;
     std::uint32_t s2 = (1 >> 16) & 0xffff;
 
-    for (auto v : data) {
-        s1 = (s1 + v) % base;
-        s2 = (s2 + s1) % base;
+    for (std::size_t i = 0; i < data.size();) {
+        const std::size_t last = std::min(data.size(), i + nmax);
+
+        for (; i < last; ++i) {
+            s1 += data[i];
+            s2 += s1;
+        }
+
+        s1 %= base;
+        s2 %= base;
     }
 
     const std::uint32_t adler = (s2 << 16) + s1;
@@ -496,11 +1128,89 @@ std::uint32_t adler32(const std::vector<std::uint8_t>& data)
            ((adler >> 24) & 0xFF);
 }
 
+// Compresses the data split into segments. The first segment is compressed in the calling thread,
+// the others by the pool.
+std::vector<std::uint8_t> deflate_segments(Span<const std::uint8_t> data,
+                                           zlib::CompressionLevel level,
+                                           std::size_t threads_count,
+                                           ThreadPool* pool)
+{
+    if (data.empty()) {
+        return std::vector<std::uint8_t>();
+    }
+
+    const CompressionParameters parameters = compression_parameters(level);
+
+    const std::size_t segment_size   = std::max(min_segment_size, (data.size() + threads_count - 1) / threads_count);
+    const std::size_t segments_count = pool != nullptr ? (data.size() + segment_size - 1) / segment_size : 1;
+
+    auto deflate_segment = [&](std::size_t segment) {
+        const std::size_t begin = segment * segment_size;
+        const std::size_t end   = segment + 1 == segments_count ? data.size() : begin + segment_size;
+
+        return deflate_range(data, begin, end, parameters, segment + 1 == segments_count);
+    };
+
+    std::vector<std::future<std::vector<std::uint8_t>>> tasks;
+    tasks.reserve(segments_count);
+    for (std::size_t segment = 1; segment < segments_count; ++segment) {
+        tasks.push_back(pool->submit([&deflate_segment, segment]() { return deflate_segment(segment); }));
+    }
+
+    std::exception_ptr error;
+    std::vector<std::uint8_t> first_segment;
+    try {
+        first_segment = deflate_segment(0);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // The tasks refer to the local data, so all of them are finished before an exception leaves.
+    for (auto& task : tasks) {
+        task.wait();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    const std::uint32_t adler = adler32(data);
+
+    const std::uint32_t cmf = (static_cast<std::uint32_t>(std::log2(max_window_size) - 8) << 4) |
+                              deflate_compression_method;
+    std::uint32_t flg = static_cast<std::uint32_t>(parameters.algorithm) << 6;
+    flg |= (31 - ((cmf << 8) | flg) % 31) % 31;
+
+    std::vector<std::uint8_t> output;
+    output.reserve(first_segment.size() * segments_count + 6);
+
+    output.push_back(static_cast<std::uint8_t>(cmf));
+    output.push_back(static_cast<std::uint8_t>(flg));
+    output.insert(output.end(), first_segment.begin(), first_segment.end());
+
+    for (auto& task : tasks) {
+        const std::vector<std::uint8_t> segment = task.get();
+        output.insert(output.end(), segment.begin(), segment.end());
+    }
+
+    output.push_back(static_cast<std::uint8_t>(adler & 0xFF));
+    output.push_back(static_cast<std::uint8_t>((adler >> 8) & 0xFF));
+    output.push_back(static_cast<std::uint8_t>((adler >> 16) & 0xFF));
+    output.push_back(static_cast<std::uint8_t>((adler >> 24) & 0xFF));
+
+    return output;
+}
+
 } // namespace
 
 namespace framework::zlib
 {
-std::vector<std::uint8_t> inflate(const std::vector<std::uint8_t>& data)
+std::vector<std::uint8_t> inflate(Span<const std::uint8_t> data)
+{
+    return inflate(data, std::numeric_limits<std::size_t>::max());
+}
+
+std::vector<std::uint8_t> inflate(Span<const std::uint8_t> data, std::size_t max_size)
 {
     if (data.empty()) {
         return std::vector<std::uint8_t>();
@@ -536,6 +1246,11 @@ std::vector<std::uint8_t> inflate(const std::vector<std::uint8_t>& data)
         if (header.bfinal) {
             break;
         }
+
+        if (output.size() >= max_size) {
+            output.resize(max_size);
+            return output;
+        }
     }
 
     in.skip_this_byte();
@@ -547,41 +1262,35 @@ std::vector<std::uint8_t> inflate(const std::vector<std::uint8_t>& data)
     const std::uint32_t adler          = adler32(output);
     const std::uint32_t original_adler = in.get<std::uint32_t>(32);
 
-    return adler == original_adler ? output : std::vector<std::uint8_t>();
-}
-
-std::vector<std::uint8_t> deflate(const std::vector<std::uint8_t>& data)
-{
-    if (data.empty()) {
+    if (adler != original_adler) {
         return std::vector<std::uint8_t>();
     }
 
-    std::vector<std::uint8_t> output;
-    ZlibHeader zlib_header;
-    zlib_header.cm     = deflate_compression_method;
-    zlib_header.cinfo  = static_cast<std::uint8_t>(std::log2(max_window_size) - 8);
-    zlib_header.fdict  = 0;
-    zlib_header.flevel = static_cast<std::uint8_t>(CompressionAlgorithm::fastest);
-    zlib_header.fcheck = 0;
-
-    std::uint16_t header_value = zlib_header.as_value();
-    if (header_value % 31 != 0) {
-        header_value = static_cast<std::uint16_t>((header_value / 31 + 1) * 31);
+    if (output.size() > max_size) {
+        output.resize(max_size);
     }
 
-    output.push_back(static_cast<std::uint8_t>((header_value >> 8) & 0xFF));
-    output.push_back(static_cast<std::uint8_t>(header_value & 0xFF));
+    return output;
+}
 
-    deflate_no_compression(data, output);
+std::vector<std::uint8_t> deflate(Span<const std::uint8_t> data, CompressionLevel level, std::size_t threads_count)
+{
+    if (threads_count == 0) {
+        threads_count = std::max(1u, std::thread::hardware_concurrency());
+    }
 
-    std::uint32_t adler = adler32(data);
+    // The calling thread compresses the first segment, so the pool is smaller by one thread.
+    if (threads_count < 2 || data.size() < min_segment_size * 2) {
+        return deflate_segments(data, level, 1, nullptr);
+    }
 
-    output.push_back(static_cast<std::uint8_t>(adler & 0xFF));
-    output.push_back(static_cast<std::uint8_t>((adler >> 8) & 0xFF));
-    output.push_back(static_cast<std::uint8_t>((adler >> 16) & 0xFF));
-    output.push_back(static_cast<std::uint8_t>((adler >> 24) & 0xFF));
+    ThreadPool pool(threads_count - 1);
+    return deflate_segments(data, level, threads_count, &pool);
+}
 
-    return output;
+std::vector<std::uint8_t> deflate(Span<const std::uint8_t> data, CompressionLevel level, ThreadPool& pool)
+{
+    return deflate_segments(data, level, pool.threads_count() + 1, &pool);
 }
 
 } // namespace framework::zlib
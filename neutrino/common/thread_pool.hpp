@@ -0,0 +1,112 @@
+#ifndef COMMON_THREAD_POOL_HPP
+#define COMMON_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace framework
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup utils_types_module
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Fixed size pool of worker threads.
+///
+/// Every worker has its own task queue. Tasks added from a worker thread go to the queue of this worker,
+/// the other tasks are distributed between all queues. Worker takes the last added task from its own queue
+/// and, when the queue is empty, steals the oldest task from the other workers.
+/// So the load stays balanced even if tasks have very different duration.
+class ThreadPool final
+{
+public:
+    /// @brief Task to execute.
+    using Task = std::function<void()>;
+
+    /// @brief Creates pool and starts worker threads.
+    ///
+    /// @param threads_count Number of worker threads, zero means the number of hardware threads.
+    explicit ThreadPool(std::size_t threads_count = 0);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// @brief Executes all added tasks and stops worker threads.
+    ~ThreadPool();
+
+    /// @brief Adds task to execute.
+    ///
+    /// Exceptions thrown by the task are ignored, use submit to get them.
+    ///
+    /// @param task Task to execute.
+    void add_task(Task task);
+
+    /// @brief Adds function to execute.
+    ///
+    /// @param function Function to execute.
+    ///
+    /// @return Future with the function result or exception.
+    template <typename Function>
+    std::future<std::invoke_result_t<std::decay_t<Function>>> submit(Function&& function);
+
+    /// @brief Waits until all added tasks are executed.
+    ///
+    /// Should not be called from the task of this pool.
+    void wait();
+
+    /// @brief Number of worker threads.
+    ///
+    /// @return Number of worker threads.
+    std::size_t threads_count() const noexcept;
+
+private:
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    void worker(std::size_t index);
+    bool pop_task(std::size_t index, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+
+    std::mutex m_mutex;
+    std::condition_variable m_task_added;
+    std::condition_variable m_tasks_done;
+
+    std::size_t m_queued_tasks  = 0;
+    std::size_t m_pending_tasks = 0;
+    std::size_t m_next_queue    = 0;
+    bool m_stop                 = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename Function>
+inline std::future<std::invoke_result_t<std::decay_t<Function>>> ThreadPool::submit(Function&& function)
+{
+    using ResultType = std::invoke_result_t<std::decay_t<Function>>;
+
+    auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<Function>(function));
+    auto res  = task->get_future();
+
+    add_task([task]() { (*task)(); });
+
+    return res;
+}
+
+} // namespace framework
+
+#endif
@@ -1,9 +1,13 @@
 #ifndef COMMON_ZLIB_HPP
 #define COMMON_ZLIB_HPP
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
+#include <common/span.hpp>
+#include <common/thread_pool.hpp>
+
 namespace framework::zlib
 {
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -11,6 +15,17 @@ namespace framework::zlib
 /// @{
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+/// @brief Compression level of the deflate encoder.
+///
+/// Higher levels spend more time looking for the longer matches.
+enum class CompressionLevel
+{
+    no_compression,      ///< Data is stored as is, fastest encoding
+    fastest,             ///< Greedy matching with the short search
+    default_compression, ///< Lazy matching, good balance between speed and compression ratio
+    best_compression,    ///< Lazy matching with the exhaustive search, slowest encoding
+};
+
 /// @brief Decompress byte sequence
 ///
 /// For details on the compression algorithm see the deflate specification [RFC-1951]
@@ -18,16 +33,47 @@ namespace framework::zlib
 /// @param data LZ77-compressed data
 ///
 /// @return Raw (uncompressed) data
-std::vector<std::uint8_t> inflate(const std::vector<std::uint8_t>& data);
+std::vector<std::uint8_t> inflate(Span<const std::uint8_t> data);
+
+/// @brief Decompress the beginning of byte sequence
+///
+/// Decoding stops after the block, which makes the output at least `max_size` bytes long,
+/// so the rest of the data isn't decompressed. The checksum can be verified only if the whole data is decompressed.
+///
+/// @param data LZ77-compressed data
+/// @param max_size Number of bytes to decompress.
+///
+/// @return First `max_size` bytes of raw data, or less if the raw data is shorter
+std::vector<std::uint8_t> inflate(Span<const std::uint8_t> data, std::size_t max_size);
 
 /// @brief Compress byte sequence
 ///
 /// For details on the compression algorithm see the deflate specification [RFC-1951]
 ///
+/// The data can be split into several segments, which are compressed in parallel.
+/// Each segment uses the tail of the previous one as a dictionary, so the compression ratio stays almost the same.
+/// Small data is always compressed in the calling thread.
+///
+/// @param data Data to compress
+/// @param level Compression level.
+/// @param threads_count Max number of threads to use, zero means the number of hardware threads.
+///
+/// @return LZ77-compressed data
+std::vector<std::uint8_t> deflate(Span<const std::uint8_t> data,
+                                  CompressionLevel level    = CompressionLevel::default_compression,
+                                  std::size_t threads_count = 1);
+
+/// @brief Compress byte sequence using the threads of the pool.
+///
+/// The data is split into segments for the pool threads and the calling thread.
+/// Should not be called from the task of this pool.
+///
 /// @param data Data to compress
+/// @param level Compression level.
+/// @param pool Pool to compress the segments.
 ///
 /// @return LZ77-compressed data
-std::vector<std::uint8_t> deflate(const std::vector<std::uint8_t>& data);
+std::vector<std::uint8_t> deflate(Span<const std::uint8_t> data, CompressionLevel level, ThreadPool& pool);
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @}
@@ -42,7 +42,7 @@ public:
 
     bool is_action_set(ActionState state) const;
 
-    math::Matrix4f get_view() const;
+    const math::Matrix4f& get_view() const;
 
 private:
     struct State
@@ -66,6 +66,8 @@ private:
     float m_sensitivity = 0.05f;
 
     State m_state = {0, 0, 0, 0, 0, 0};
+
+    math::Matrix4f m_view;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -7,6 +7,7 @@ Camera::Camera(math::Vector3f position, math::Vector3f front, math::Vector3f up)
     : m_position(position)
     , m_front(normalize(front))
     , m_up(normalize(up))
+    , m_view(look_at(m_position, m_position + m_front, m_up))
 {}
 
 void Camera::set_action(ActionState state, bool value)
@@ -88,6 +89,8 @@ void Camera::update(std::chrono::nanoseconds delata_time)
     if (any(math::Vector3b(direction))) {
         m_position += normalize(direction) * camera_speed;
     }
+
+    m_view = look_at(m_position, m_position + m_front, m_up);
 }
 
 bool Camera::is_action_set(ActionState state) const
@@ -105,9 +108,9 @@ bool Camera::is_action_set(ActionState state) const
     return false;
 }
 
-math::Matrix4f Camera::get_view() const
+const math::Matrix4f& Camera::get_view() const
 {
-    return look_at(m_position, m_position + m_front, m_up);
+    return m_view;
 }
 
 } // namespace framework::game_core
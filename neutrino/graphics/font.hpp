@@ -1,12 +1,17 @@
 #ifndef GRAPHICS_FONT_HPP
 #define GRAPHICS_FONT_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
+#include <memory>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
+#include <common/span.hpp>
 #include <common/utf.hpp>
+#include <graphics/image.hpp>
 #include <graphics/mesh.hpp>
 
 namespace framework::graphics
@@ -18,6 +23,20 @@ namespace framework::graphics
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 /// @brief Font rendering
+///
+/// Text can be rendered in two ways. `create_text_mesh` triangulates the glyph outlines,
+/// so the mesh needs no texture, but the vertex count grows with the text length and the mesh quality.
+/// `create_atlas_text_mesh` makes two triangles per glyph, which sample the signed distance field of glyphs
+/// stored in the atlas image. The text stays sharp at any scale.
+///
+/// The atlas stores distances to the glyph outline, mapped from [-range/2, range/2] pixels to [0, 1],
+/// values above 0.5 are inside the glyph. Fragment shader should compute the coverage like this:
+/// @code
+/// vec3 s = texture(atlas, uv).rgb;
+/// float distance = max(min(s.r, s.g), min(max(s.r, s.g), s.b)); // just s.r for the single channel atlas
+/// float width = fwidth(distance);
+/// float alpha = smoothstep(0.5 - width, 0.5 + width, distance);
+/// @endcode
 class Font
 {
 public:
@@ -38,11 +57,50 @@ public:
     /// @brief Represents font mesh qualyty. I.e. amount of points on a curves to make it look more smooth.
     using QualityType = std::size_t;
 
+    /// @brief Statistics of the glyph mesh cache.
+    struct CacheStatistics
+    {
+        std::size_t hits         = 0; ///< Glyphs found in the cache.
+        std::size_t misses       = 0; ///< Glyphs generated because they were not in the cache.
+        std::size_t evictions    = 0; ///< Glyphs removed from the cache to fit its capacity.
+        std::size_t glyphs_count = 0; ///< Glyphs in the cache.
+        std::size_t size         = 0; ///< Memory used by the cached glyph meshes in bytes.
+    };
+
+    /// @brief Default capacity of the glyph mesh cache in bytes.
+    static constexpr std::size_t default_cache_capacity = 4 * 1024 * 1024;
+
+    /// @brief Kind of the distance field in the glyph atlas.
+    enum class DistanceField
+    {
+        single_channel, ///< Distance to the outline, stored in r8 atlas. Corners get rounded when text is magnified.
+        multi_channel,  ///< Distances to the differently colored edges, stored in rgb8 atlas.
+                        ///< The median of channels keeps corners sharp.
+    };
+
+    /// @brief Glyph atlas options.
+    struct AtlasOptions
+    {
+        /// Kind of the distance field.
+        DistanceField distance_field = DistanceField::multi_channel;
+
+        /// Size of the em square in atlas pixels.
+        std::size_t glyph_size = 32;
+
+        /// Range of the encoded distances in pixels. Wider range allows bigger outline and shadow effects.
+        float distance_range = 4.0f;
+
+        /// Atlas width in pixels. The height is doubled each time new glyphs don't fit the atlas.
+        std::size_t width = 512;
+    };
+
     /// @brief Creates font
     ///
-    /// The quality value defines how many additional points on glyphs outline to generate for one bezier curve.
+    /// The quality value defines how close the mesh follows the glyphs outline. Curves are split into segments
+    /// adaptively, the max distance between the outline and the mesh is 1 / (32 * (quality + 1)^2) of em,
+    /// so flat curves get few points and only tight ones get many.
     /// Lager value results smoothed contours, but more complicated mesh would be generated.
-    /// Value from 1 to 3 is good enough for many cases. Max quality is clumped to 32 points.
+    /// Value from 1 to 3 is good enough for many cases. Max quality is clumped to 32.
     ///
     /// @param quality Mesh quality.
     explicit Font(QualityType quality = 1);
@@ -57,24 +115,98 @@ public:
 
     /// @brief Load font from file.
     ///
+    /// The file stays mapped to memory while the font is alive, glyph outlines are decoded from it on demand.
+    ///
     /// @param filepath File to load.
     ///
     /// @return LoadResult::Success if loading is successful or error code otherwise.
     LoadResult load(const std::filesystem::path& filepath);
 
+    /// @brief Load font from memory buffer.
+    ///
+    /// The buffer should contain the whole font file contents, e.g. a blob from an archive.
+    /// The buffer isn't referenced after loading, the glyph outlines data is copied to be decoded on demand.
+    ///
+    /// @param data Font file contents.
+    ///
+    /// @return LoadResult::Success if loading is successful or error code otherwise.
+    LoadResult load(Span<const std::byte> data);
+
+    /// @brief Create text mesh from the triangulated glyph outlines.
+    ///
+    /// Glyph meshes are kept in the cache, the least recently used glyphs are evicted when it's full.
+    /// Can be called from multiple threads at once, each missing glyph is generated only once.
+    ///
+    /// Glyphs are joined into one submesh per primitive type, so the whole text is drawn at once.
+    ///
+    /// @param text Text in UTF-8.
+    ///
+    /// @return Text mesh.
     Mesh create_text_mesh(const std::string& text);
 
+    /// @brief Set capacity of the glyph mesh cache.
+    ///
+    /// @param capacity Max memory used by the cached glyph meshes in bytes.
+    void set_cache_capacity(std::size_t capacity);
+
+    /// @brief Get capacity of the glyph mesh cache.
+    ///
+    /// @return Max memory used by the cached glyph meshes in bytes.
+    std::size_t cache_capacity() const;
+
+    /// @brief Get statistics of the glyph mesh cache.
+    ///
+    /// @return Cache statistics since the font is loaded.
+    CacheStatistics cache_statistics() const;
+
+    /// @brief Set options of the glyph atlas.
+    ///
+    /// The atlas is cleared, glyphs are added to it again by `create_atlas_text_mesh`.
+    ///
+    /// @param options New options.
+    void set_atlas_options(const AtlasOptions& options);
+
+    /// @brief Get options of the glyph atlas.
+    ///
+    /// @return Atlas options.
+    const AtlasOptions& atlas_options() const;
+
+    /// @brief Create text mesh, which samples the glyph atlas.
+    ///
+    /// Each glyph is a quad of two triangles, atlas texture coordinates are in the array 0.
+    /// Glyphs missing in the atlas are added to it.
+    ///
+    /// @note If the atlas grows, texture coordinates of previously created meshes become invalid.
+    ///       Create one mesh with all the required characters first to avoid it.
+    ///
+    /// @param text Text in UTF-8.
+    ///
+    /// @return Text mesh.
+    ///
+    /// @see atlas
+    Mesh create_atlas_text_mesh(const std::string& text);
+
+    /// @brief Get the glyph atlas image.
+    ///
+    /// The image should be uploaded to texture after creating meshes with new glyphs.
+    /// Pixels store distances, not colors, so the image gamma is 1.
+    ///
+    /// @return Atlas image.
+    const Image& atlas() const;
+
 private:
     class FontData;
 
+    friend class TextLayout;
     friend void swap(Font& lhs, Font& rhs) noexcept;
 
-    LoadResult parse(const std::filesystem::path& filepath);
-
-    void precache(const std::string& chars);
+    LoadResult load(Span<const std::byte> data, std::shared_ptr<const void> storage);
+    LoadResult parse(Span<const std::uint8_t> data, std::shared_ptr<const void> storage);
 
     std::unique_ptr<FontData> m_data;
-    QualityType m_quality = 1;
+    QualityType m_quality        = 1;
+    std::size_t m_cache_capacity = default_cache_capacity;
+    AtlasOptions m_atlas_options;
 };
 
 /// @brief Swaps two Fonts.
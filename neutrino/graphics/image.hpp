@@ -1,10 +1,15 @@
 #ifndef GRAPHICS_IMAGE_HPP
 #define GRAPHICS_IMAGE_HPP
 
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <vector>
 
+#include <common/span.hpp>
+#include <common/zlib.hpp>
 #include <graphics/color.hpp>
+#include <graphics/pixel_format.hpp>
 
 namespace framework::graphics
 {
@@ -15,10 +20,13 @@ namespace framework::graphics
 
 /// @brief Image class.
 ///
-/// Image can be loaded from a file or created with color data.
-/// Data stored as Color values in a row from left to right.
+/// Image can be loaded from a file, from a memory buffer or created with color data, and saved to a file.
+/// Data stored as tightly packed pixels of the PixelFormat in a row from left to right.
 /// Rows stored from bottom to top, so the image is upside down.
 ///
+/// Loaded image keeps the pixel format of the file, e.g. greyscale PNG takes one byte per pixel
+/// and 16 bit PNG keeps its precision. Use convert() to get the pixels in other format.
+///
 /// @code
 /// Image img;
 /// if (!img.load(file)) {
@@ -44,20 +52,93 @@ public:
         InvalidFileType,  ///< File type is unknown or not supported
         DataParsingError, ///< Can't parse image data
         Unsupported,      ///< Unsupported version of table or data
+        InvalidRegion,    ///< Region to load has no pixels of the image
         UnknownError,     ///< Unknown error
     };
 
+    /// @brief Result of saving operation.
+    enum class SaveResult
+    {
+        Success,       ///< Success saving
+        InvalidImage,  ///< Image is empty or data size doesn't match the image size
+        OpenFileError, ///< Can't open file for writing
+        WriteError,    ///< Can't write data to file
+        UnknownError,  ///< Unknown error
+    };
+
+    /// @brief Image decoding options.
+    ///
+    /// Region is set in the image coordinates: columns from the left and rows from the bottom, like in the image data.
+    /// The parts of the region outside the image are ignored.
+    struct LoadOptions
+    {
+        std::size_t x      = 0; ///< Left column of the region.
+        std::size_t y      = 0; ///< Bottom row of the region.
+        std::size_t width  = 0; ///< Region width, zero means up to the right image border.
+        std::size_t height = 0; ///< Region height, zero means up to the top image border.
+
+        /// Load only each 8th pixel of each 8th row of the region, counting from the top left corner of the image.
+        /// These are the pixels of the first Adam7 pass, so only the first pass of interlaced PNG is decoded.
+        bool preview = false;
+    };
+
+    /// @brief Image encoding options.
+    struct SaveOptions
+    {
+        /// Compression level of PNG data, trades the file size for the encoding speed.
+        zlib::CompressionLevel compression = zlib::CompressionLevel::default_compression;
+
+        /// Max number of threads to compress PNG data, zero means the number of hardware threads.
+        /// Each thread compresses its own part of image rows.
+        std::size_t threads_count = 1;
+    };
+
+    /// @brief Filter to compute mipmap levels.
+    enum class MipmapFilter
+    {
+        box,      ///< Average of the covered pixels. The fastest one, but fine details may alias.
+        kaiser,   ///< Kaiser windowed sinc. Sharp levels with little ringing.
+        lanczos3, ///< Lanczos windowed sinc with radius 3. The sharpest levels, but hard edges may ring.
+    };
+
+    /// @brief Mipmap generation options.
+    struct MipmapOptions
+    {
+        /// Filter to compute the levels.
+        MipmapFilter filter = MipmapFilter::box;
+
+        /// Filter colors in linear space. Colors of the integer pixel formats are treated as sRGB encoded,
+        /// unless the image gamma is 1.
+        bool gamma_correct = true;
+
+        /// Max number of levels, zero means all levels down to the 1x1 size.
+        std::size_t levels_count = 0;
+
+        /// Max number of threads, zero means the number of hardware threads.
+        /// Each thread filters its own part of image rows.
+        std::size_t threads_count = 1;
+    };
+
     using ColorDataType = std::vector<Color>;
 
     Image();
 
     /// @brief Creates image with Color data.
     ///
+    /// The image has PixelFormat::rgba8 format.
+    ///
     /// @param data Image color data.
     /// @param width Image width.
     /// @param height Inage height.
     Image(const ColorDataType& data, std::size_t width, std::size_t height);
 
+    /// @brief Creates image with all pixel bytes set to zero.
+    ///
+    /// @param width Image width.
+    /// @param height Image height.
+    /// @param format Pixel format.
+    Image(std::size_t width, std::size_t height, PixelFormat format);
+
     Image(const Image&)     = default;
     Image(Image&&) noexcept = default;
 
@@ -71,6 +152,59 @@ public:
     /// @return LoadResult::Success if loading is successful or error code otherwise.
     LoadResult load(const std::filesystem::path& file);
 
+    /// @brief Load part of the image from file.
+    ///
+    /// PNG decoder reconstructs only the rows of the region and the rows they are predicted from,
+    /// and stops decompression after the last row of the region.
+    /// Other formats are decoded fully and cropped.
+    ///
+    /// @param file File to load.
+    /// @param options Region to load.
+    ///
+    /// @return LoadResult::Success if loading is successful or error code otherwise.
+    LoadResult load(const std::filesystem::path& file, const LoadOptions& options);
+
+    /// @brief Load image from memory buffer.
+    ///
+    /// The buffer should contain the whole image file contents, e.g. a blob from an archive.
+    /// The data is decoded right from the buffer and isn't referenced after loading.
+    ///
+    /// @param data Image file contents.
+    ///
+    /// @return LoadResult::Success if loading is successful or error code otherwise.
+    LoadResult load(Span<const std::byte> data);
+
+    /// @brief Load part of the image from memory buffer.
+    ///
+    /// @param data Image file contents.
+    /// @param options Region to load.
+    ///
+    /// @return LoadResult::Success if loading is successful or error code otherwise.
+    ///
+    /// @see load(const std::filesystem::path&, const LoadOptions&)
+    LoadResult load(Span<const std::byte> data, const LoadOptions& options);
+
+    /// @brief Save image to file with default options.
+    ///
+    /// @param file File to write.
+    /// @param type Image file type.
+    ///
+    /// @return SaveResult::Success if saving is successful or error code otherwise.
+    SaveResult save(const std::filesystem::path& file, FileType type) const;
+
+    /// @brief Save image to file.
+    ///
+    /// PNG is written in the pixel format of the image, PixelFormat::rgba16f is written as 16 bit integer RGBA.
+    /// Each row gets the PNG filter, which suits it best, before the compression.
+    /// BMP is written as uncompressed 24 bit or 32 bit image with alpha channel.
+    ///
+    /// @param file File to write.
+    /// @param type Image file type.
+    /// @param options Encoding options.
+    ///
+    /// @return SaveResult::Success if saving is successful or error code otherwise.
+    SaveResult save(const std::filesystem::path& file, FileType type, const SaveOptions& options) const;
+
     /// @brief Get image width.
     ///
     /// @return Image width.
@@ -86,29 +220,111 @@ public:
     /// @return Image gamma.
     float gamma() const;
 
-    /// @brief Get image color data.
+    /// @brief Set image gamma.
+    ///
+    /// Pixels are not changed, use srgb_to_linear or linear_to_srgb to convert them.
+    ///
+    /// @param gamma New gamma, 1 means linear colors.
+    void set_gamma(float gamma);
+
+    /// @brief Get image pixel format.
+    ///
+    /// @return Pixel format.
+    PixelFormat format() const;
+
+    /// @brief Get image data.
+    ///
+    /// @return Pixel bytes.
+    Span<const std::uint8_t> bytes() const;
+
+    /// @brief Get image data.
     ///
-    /// @return Const reference to data storage.
-    const ColorDataType& data() const;
+    /// @return Pixel bytes.
+    Span<std::uint8_t> bytes();
 
-    /// @brief Get image color data.
+    /// @brief Get image pixels.
+    ///
+    /// @tparam Pixel Pixel type of the image format, e.g. PixelR8 or Color.
+    ///
+    /// @return Pixels or empty Span if Pixel doesn't match the image format.
+    template <typename Pixel>
+    Span<const Pixel> pixels() const;
+
+    /// @brief Get image pixels.
+    ///
+    /// @tparam Pixel Pixel type of the image format, e.g. PixelR8 or Color.
     ///
-    /// @return reference to data storage.
-    ColorDataType& data();
+    /// @return Pixels or empty Span if Pixel doesn't match the image format.
+    template <typename Pixel>
+    Span<Pixel> pixels();
+
+    /// @brief Convert image to other pixel format.
+    ///
+    /// Greyscale is expanded to all color channels, color is reduced to greyscale by its luma.
+    /// Missing alpha channel is opaque. 16 bit channels are narrowed to 8 bits by the most significant byte.
+    /// Floating point channels are clamped to [0, 1] range when converted to integer ones.
+    ///
+    /// @param format Pixel format of the result.
+    ///
+    /// @return Converted image.
+    Image convert(PixelFormat format) const;
+
+    /// @brief Generate mipmap levels with default options.
+    ///
+    /// @return Mipmap levels without the image itself, from the biggest to the smallest one.
+    std::vector<Image> generate_mipmaps() const;
+
+    /// @brief Generate mipmap levels.
+    ///
+    /// Each level is half the size of the previous one, rounded down, but not less than 1.
+    /// Levels are computed one from another in floating point and weighted by alpha,
+    /// so transparent pixels don't bleed their color into the visible ones.
+    /// Levels have the pixel format and gamma of the image.
+    ///
+    /// @param options Generation options.
+    ///
+    /// @return Mipmap levels without the image itself, from the biggest to the smallest one.
+    std::vector<Image> generate_mipmaps(const MipmapOptions& options) const;
 
 private:
     static constexpr float default_gamma = 2.2f;
 
     friend void swap(Image& lhs, Image& rhs) noexcept;
 
-    ColorDataType m_data;
+    std::vector<std::uint8_t> m_data;
 
     std::size_t m_width  = 0;
     std::size_t m_height = 0;
 
     float m_gamma = default_gamma;
+
+    PixelFormat m_format = PixelFormat::rgba8;
 };
 
+template <typename Pixel>
+inline Span<const Pixel> Image::pixels() const
+{
+    static_assert(sizeof(Pixel) == bytes_per_pixel(PixelTraits<Pixel>::format), "Pixel is expected to be packed.");
+
+    if (PixelTraits<Pixel>::format != m_format) {
+        return Span<const Pixel>();
+    }
+
+    return Span<const Pixel>(reinterpret_cast<const Pixel*>(m_data.data()), m_data.size() / sizeof(Pixel));
+}
+
+template <typename Pixel>
+inline Span<Pixel> Image::pixels()
+{
+    static_assert(sizeof(Pixel) == bytes_per_pixel(PixelTraits<Pixel>::format), "Pixel is expected to be packed.");
+
+    if (PixelTraits<Pixel>::format != m_format) {
+        return Span<Pixel>();
+    }
+
+    return Span<Pixel>(reinterpret_cast<Pixel*>(m_data.data()), m_data.size() / sizeof(Pixel));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// @brief Equality operator for Images.
 ///
@@ -0,0 +1,199 @@
+#ifndef GRAPHICS_IMAGE_LOADER_HPP
+#define GRAPHICS_IMAGE_LOADER_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+#include <common/thread_pool.hpp>
+#include <graphics/image.hpp>
+
+namespace framework::graphics
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup graphics_image_module
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Loads images in the background threads.
+///
+/// Requests are decoded on the work-stealing thread pool in order of their priority,
+/// requests with the same priority are decoded in order they were added.
+/// Pending request can be cancelled. Images are decoded only while they fit the memory budget,
+/// so a batch of big images doesn't allocate all memory at once.
+///
+/// @code
+/// ImageLoader loader;
+/// auto handles = loader.load(files);
+///
+/// for (auto& handle : handles) {
+///     ImageLoader::Result result = handle.get();
+///     if (result.status == Image::LoadResult::Success) {
+///         textures.emplace_back(std::move(result.image));
+///     }
+/// }
+/// @endcode
+class ImageLoader final
+{
+    struct Request;
+
+public:
+    /// @brief Priority of the request.
+    enum class Priority
+    {
+        low,
+        normal,
+        high,
+    };
+
+    /// @brief Result of the request.
+    struct Result
+    {
+        Image::LoadResult status = Image::LoadResult::UnknownError; ///< Result of loading operation
+        bool cancelled           = false;                           ///< Request is cancelled before decoding
+        Image image;                                                ///< Loaded image
+    };
+
+    /// @brief Callback to get the result of the request.
+    ///
+    /// It's called from the worker thread right before the result becomes available through the Handle.
+    /// For cancelled request it's called from the thread, which cancelled it.
+    /// Exceptions thrown by the callback are ignored, the result is still available through the Handle.
+    using Callback = std::function<void(const Result&)>;
+
+    /// @brief Handle of the added request.
+    class Handle
+    {
+    public:
+        /// @brief Creates invalid Handle.
+        Handle() = default;
+
+        /// @brief Checks if Handle refers to the request.
+        ///
+        /// @return `true` if result can be obtained.
+        bool valid() const noexcept;
+
+        /// @brief Checks if request is completed.
+        ///
+        /// @return `true` if result is available.
+        bool ready() const;
+
+        /// @brief Waits until request is completed.
+        void wait() const;
+
+        /// @brief Waits until request is completed and takes the result.
+        ///
+        /// Handle becomes invalid after this call.
+        ///
+        /// @return Result of the request.
+        Result get();
+
+        /// @brief Cancels the request, if its decoding isn't started yet.
+        ///
+        /// @return `true` if request is cancelled.
+        bool cancel();
+
+    private:
+        friend class ImageLoader;
+
+        Handle(std::shared_ptr<Request> request, std::future<Result> future);
+
+        std::shared_ptr<Request> m_request;
+        std::future<Result> m_future;
+    };
+
+    /// @brief Default limit of memory for images being decoded at once, in bytes.
+    static constexpr std::size_t default_memory_budget = 256 * 1024 * 1024;
+
+    /// @brief Creates ImageLoader.
+    ///
+    /// Image which doesn't fit the budget alone is still loaded, but only when nothing else is being decoded.
+    ///
+    /// @param threads_count Number of worker threads, zero means the number of hardware threads.
+    /// @param memory_budget Max amount of memory, which images being decoded can take.
+    explicit ImageLoader(std::size_t threads_count = 0, std::size_t memory_budget = default_memory_budget);
+
+    ImageLoader(const ImageLoader&) = delete;
+    ImageLoader& operator=(const ImageLoader&) = delete;
+
+    /// @brief Cancels pending requests and waits for the running ones.
+    ~ImageLoader();
+
+    /// @brief Adds request to load image from file.
+    ///
+    /// @param file File to load.
+    /// @param priority Request priority.
+    /// @param callback Callback to get the result.
+    ///
+    /// @return Handle of the request.
+    Handle load(const std::filesystem::path& file,
+                Priority priority = Priority::normal,
+                Callback callback = Callback());
+
+    /// @brief Adds request to load image from memory buffer.
+    ///
+    /// @param data Image file contents.
+    /// @param priority Request priority.
+    /// @param callback Callback to get the result.
+    ///
+    /// @return Handle of the request.
+    Handle load(std::vector<std::byte> data, Priority priority = Priority::normal, Callback callback = Callback());
+
+    /// @brief Adds requests to load images from files.
+    ///
+    /// @param files Files to load.
+    /// @param priority Priority of all requests.
+    ///
+    /// @return Handles of the requests in the same order as files.
+    std::vector<Handle> load(const std::vector<std::filesystem::path>& files, Priority priority = Priority::normal);
+
+    /// @brief Cancels all pending requests.
+    void cancel_all();
+
+    /// @brief Waits until all requests are completed.
+    void wait();
+
+    /// @brief Number of worker threads.
+    ///
+    /// @return Number of worker threads.
+    std::size_t threads_count() const noexcept;
+
+private:
+    struct RequestOrder
+    {
+        bool operator()(const std::shared_ptr<Request>& lhs, const std::shared_ptr<Request>& rhs) const;
+    };
+
+    Handle add_request(std::shared_ptr<Request> request);
+    void process_next_request();
+    Result decode(Request& request);
+
+    void acquire_memory(std::size_t size);
+    void release_memory(std::size_t size);
+
+    std::mutex m_mutex;
+    std::condition_variable m_memory_released;
+    std::priority_queue<std::shared_ptr<Request>, std::vector<std::shared_ptr<Request>>, RequestOrder> m_requests;
+
+    std::uint64_t m_requests_count = 0;
+    std::size_t m_memory_budget    = 0;
+    std::size_t m_memory_in_use    = 0;
+
+    // Should be destroyed first, because its tasks use the other members.
+    ThreadPool m_pool;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::graphics
+
+#endif
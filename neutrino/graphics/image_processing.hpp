@@ -0,0 +1,99 @@
+#ifndef GRAPHICS_IMAGE_PROCESSING_HPP
+#define GRAPHICS_IMAGE_PROCESSING_HPP
+
+#include <cstddef>
+
+#include <graphics/image.hpp>
+
+namespace framework::graphics
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup graphics_image_module
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Filter to resize images.
+enum class ResizeFilter
+{
+    box,      ///< Average of the covered pixels. Good for downscaling by integer factors, blocky when upscaling.
+    bilinear, ///< Linear interpolation between the adjacent pixels.
+    bicubic,  ///< Catmull-Rom spline. Sharper than bilinear with a slight overshoot on the hard edges.
+    lanczos3, ///< Lanczos windowed sinc with radius 3. The sharpest one, but hard edges may ring.
+};
+
+/// @brief Image resizing options.
+struct ResizeOptions
+{
+    /// Filter to compute the pixels.
+    ResizeFilter filter = ResizeFilter::bicubic;
+
+    /// Filter colors in linear space. Colors of the integer pixel formats are treated as sRGB encoded,
+    /// unless the image gamma is 1.
+    bool gamma_correct = true;
+
+    /// Colors of the image are already multiplied by alpha. Otherwise the colors are weighted by alpha while filtering,
+    /// so transparent pixels don't bleed their color into the visible ones.
+    bool premultiplied_alpha = false;
+
+    /// Max number of threads, zero means the number of hardware threads.
+    /// Each thread filters its own part of image rows.
+    std::size_t threads_count = 1;
+};
+
+/// @brief Resize image.
+///
+/// Filters are separable, so the image is filtered horizontally and then vertically.
+/// When the image is downscaled, the filter is stretched over the source pixels to avoid aliasing.
+/// Pixels out of the image border are clamped to it.
+///
+/// @param image Image to resize.
+/// @param width Width of the result.
+/// @param height Height of the result.
+/// @param options Resizing options.
+///
+/// @return Resized image of the same pixel format and gamma, or empty image if any size is zero.
+Image resize(const Image& image, std::size_t width, std::size_t height, const ResizeOptions& options = ResizeOptions());
+
+/// @brief Multiply color channels by alpha.
+///
+/// Does nothing with formats without alpha channel.
+///
+/// @param image Image to process.
+/// @param threads_count Max number of threads, zero means the number of hardware threads.
+void premultiply_alpha(Image& image, std::size_t threads_count = 1);
+
+/// @brief Divide color channels by alpha.
+///
+/// Pixels with zero alpha get black color. Does nothing with formats without alpha channel.
+///
+/// @param image Image to process.
+/// @param threads_count Max number of threads, zero means the number of hardware threads.
+void unpremultiply_alpha(Image& image, std::size_t threads_count = 1);
+
+/// @brief Decode sRGB colors to linear ones.
+///
+/// Integer formats are converted with lookup tables. Alpha channel is not changed.
+/// Image gamma becomes 1.
+///
+/// @note Linear colors need more bits, 8 bit formats lose precision in the dark colors.
+///
+/// @param image Image to process.
+/// @param threads_count Max number of threads, zero means the number of hardware threads.
+void srgb_to_linear(Image& image, std::size_t threads_count = 1);
+
+/// @brief Encode linear colors to sRGB.
+///
+/// Integer formats are converted with lookup tables. Alpha channel is not changed.
+/// Image gets the default gamma.
+///
+/// @param image Image to process.
+/// @param threads_count Max number of threads, zero means the number of hardware threads.
+void linear_to_srgb(Image& image, std::size_t threads_count = 1);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::graphics
+
+#endif
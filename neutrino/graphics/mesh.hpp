@@ -198,6 +198,9 @@ public:
 private:
     friend void swap(Mesh& lhs, Mesh& rhs) noexcept;
 
+    // Patches the vertices and indices in place on the incremental text update.
+    friend class TextLayout;
+
     VertexData m_vertices;
     VertexData m_normals;
     VertexData m_tanegents;
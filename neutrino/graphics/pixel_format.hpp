@@ -0,0 +1,152 @@
+#ifndef GRAPHICS_PIXEL_FORMAT_HPP
+#define GRAPHICS_PIXEL_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <graphics/color.hpp>
+
+namespace framework::graphics
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup graphics_image_module
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Format of the pixels in the Image data.
+///
+/// Pixels are tightly packed, 16 bit channels are stored in the native byte order.
+/// Formats with one channel hold the greyscale value, formats with two channels hold greyscale value and alpha.
+enum class PixelFormat
+{
+    r8,      ///< 8 bit greyscale.
+    rg8,     ///< 8 bit greyscale and alpha.
+    rgb8,    ///< 8 bit red, green and blue.
+    rgba8,   ///< 8 bit red, green, blue and alpha.
+    r16,     ///< 16 bit greyscale.
+    rgba16,  ///< 16 bit red, green, blue and alpha.
+    rgba16f, ///< 16 bit floating point red, green, blue and alpha.
+};
+
+/// @brief Pixel of PixelFormat::r8 format.
+struct PixelR8
+{
+    std::uint8_t r = 0; ///< Greyscale value.
+};
+
+/// @brief Pixel of PixelFormat::rg8 format.
+struct PixelRG8
+{
+    std::uint8_t r = 0; ///< Greyscale value.
+    std::uint8_t g = 0; ///< Alpha value.
+};
+
+/// @brief Pixel of PixelFormat::rgb8 format.
+struct PixelRGB8
+{
+    std::uint8_t r = 0; ///< Red channel.
+    std::uint8_t g = 0; ///< Green channel.
+    std::uint8_t b = 0; ///< Blue channel.
+};
+
+/// @brief Pixel of PixelFormat::r16 format.
+struct PixelR16
+{
+    std::uint16_t r = 0; ///< Greyscale value.
+};
+
+/// @brief Pixel of PixelFormat::rgba16 format.
+struct PixelRGBA16
+{
+    std::uint16_t r = 0; ///< Red channel.
+    std::uint16_t g = 0; ///< Green channel.
+    std::uint16_t b = 0; ///< Blue channel.
+    std::uint16_t a = 0; ///< Alpha channel.
+};
+
+/// @brief Pixel of PixelFormat::rgba16f format.
+///
+/// Channels hold the bits of IEEE 754 half precision floating point values.
+struct PixelRGBA16F
+{
+    std::uint16_t r = 0; ///< Red channel.
+    std::uint16_t g = 0; ///< Green channel.
+    std::uint16_t b = 0; ///< Blue channel.
+    std::uint16_t a = 0; ///< Alpha channel.
+};
+
+/// @brief Maps pixel type to its PixelFormat.
+///
+/// Color is the pixel type of the PixelFormat::rgba8 format.
+template <typename Pixel>
+struct PixelTraits;
+
+template <>
+struct PixelTraits<PixelR8>
+{
+    static constexpr PixelFormat format = PixelFormat::r8;
+};
+
+template <>
+struct PixelTraits<PixelRG8>
+{
+    static constexpr PixelFormat format = PixelFormat::rg8;
+};
+
+template <>
+struct PixelTraits<PixelRGB8>
+{
+    static constexpr PixelFormat format = PixelFormat::rgb8;
+};
+
+template <>
+struct PixelTraits<Color>
+{
+    static constexpr PixelFormat format = PixelFormat::rgba8;
+};
+
+template <>
+struct PixelTraits<PixelR16>
+{
+    static constexpr PixelFormat format = PixelFormat::r16;
+};
+
+template <>
+struct PixelTraits<PixelRGBA16>
+{
+    static constexpr PixelFormat format = PixelFormat::rgba16;
+};
+
+template <>
+struct PixelTraits<PixelRGBA16F>
+{
+    static constexpr PixelFormat format = PixelFormat::rgba16f;
+};
+
+/// @brief Get size of one pixel.
+///
+/// @param format Pixel format.
+///
+/// @return Size of the pixel in bytes.
+constexpr std::size_t bytes_per_pixel(PixelFormat format) noexcept
+{
+    switch (format) {
+        case PixelFormat::r8: return 1;
+        case PixelFormat::rg8: return 2;
+        case PixelFormat::rgb8: return 3;
+        case PixelFormat::rgba8: return 4;
+        case PixelFormat::r16: return 2;
+        case PixelFormat::rgba16: return 8;
+        case PixelFormat::rgba16f: return 8;
+    }
+
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::graphics
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef GRAPHICS_RENDERER_HPP
 #define GRAPHICS_RENDERER_HPP
 
+#include <cstddef>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -108,6 +109,21 @@ public:
     /// @return `true` if loading successful
     bool load(ResourceId res_id, const Mesh& mesh);
 
+    /// @brief Updates part of the Mesh loaded to renderer.
+    ///
+    /// Vertex data starting from the first vertex and indices starting from the first index are uploaded,
+    /// data before them must be the same as loaded. Indices of submeshes are counted one after another
+    /// in the order of the submeshes map. Buffers are grown with a spare space, so appending data is cheap.
+    /// The mesh is loaded entirely if it's not loaded yet or it has other vertex attributes.
+    ///
+    /// @param res_id Id of mesh.
+    /// @param mesh Mesh to update.
+    /// @param first_vertex First changed vertex.
+    /// @param first_index First changed index.
+    ///
+    /// @return `true` if updating successful
+    bool update(ResourceId res_id, const Mesh& mesh, std::size_t first_vertex, std::size_t first_index);
+
     /// @brief Loads Shader to renderer.
     ///
     /// @param res_id Id of shader.
@@ -0,0 +1,419 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <graphics/src/font/distance_field.hpp>
+
+namespace
+{
+using framework::graphics::details::font::DistanceFieldBitmap;
+using framework::graphics::details::font::GlyphData;
+using framework::math::Vector2f;
+
+// Outline turning by a greater angle is a corner, sin(3) is the cross product of the directions for 3 radians.
+inline constexpr float corner_cross_threshold = 0.1411f;
+
+// Max distance between the curve and its flattened polyline, in pixels.
+inline constexpr float flattening_tolerance = 1.0f / 16.0f;
+
+enum EdgeColor : std::uint8_t
+{
+    red     = 1,
+    green   = 2,
+    blue    = 4,
+    yellow  = red | green,
+    magenta = red | blue,
+    cyan    = green | blue,
+    white   = red | green | blue,
+};
+
+#pragma region Segments
+
+struct Segment
+{
+    Vector2f start;
+    Vector2f control;
+    Vector2f end;
+    bool is_curve = false;
+
+    Vector2f start_direction() const
+    {
+        return is_curve && control != start ? control - start : end - start;
+    }
+
+    Vector2f end_direction() const
+    {
+        return is_curve && control != end ? end - control : end - start;
+    }
+};
+
+// Converts TrueType points to lines and quadratic curves, the implied on curve points are restored.
+std::vector<Segment> make_segments(const GlyphData::ContourType& contour)
+{
+    std::vector<Segment> segments;
+
+    if (contour.size() < 2) {
+        return segments;
+    }
+
+    auto add_segment = [&segments](Vector2f start, const Vector2f* control, Vector2f end) {
+        if (control == nullptr && start != end) {
+            segments.push_back({start, start, end, false});
+        } else if (control != nullptr && (start != end || start != *control)) {
+            segments.push_back({start, *control, end, true});
+        }
+    };
+
+    const auto first_on_curve = std::find_if(contour.begin(), contour.end(), [](const auto& point) {
+        return point.is_on_curve;
+    });
+
+    // Contour of the off curve points only starts in the middle of the last and the first ones.
+    const bool has_on_curve      = first_on_curve != contour.end();
+    const std::size_t begin      = has_on_curve ? static_cast<std::size_t>(first_on_curve - contour.begin()) + 1 : 0;
+    const std::size_t count      = has_on_curve ? contour.size() - 1 : contour.size();
+    const Vector2f contour_start = has_on_curve ? first_on_curve->position
+                                                : (contour.back().position + contour.front().position) * 0.5f;
+
+    Vector2f current = contour_start;
+    Vector2f control;
+    bool has_control = false;
+
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto& point = contour[(begin + i) % contour.size()];
+
+        if (point.is_on_curve) {
+            add_segment(current, has_control ? &control : nullptr, point.position);
+            current     = point.position;
+            has_control = false;
+        } else {
+            if (has_control) {
+                const Vector2f middle = (control + point.position) * 0.5f;
+                add_segment(current, &control, middle);
+                current = middle;
+            }
+
+            control     = point.position;
+            has_control = true;
+        }
+    }
+
+    add_segment(current, has_control ? &control : nullptr, contour_start);
+
+    return segments;
+}
+
+// Appends segment points except the start one.
+void flatten(const Segment& segment, float tolerance, std::vector<Vector2f>& points)
+{
+    if (!segment.is_curve) {
+        points.push_back(segment.end);
+        return;
+    }
+
+    flatten_quadratic_bezier(segment.start, segment.control, segment.end, tolerance, points);
+}
+
+#pragma endregion
+
+#pragma region Edges
+
+// Part of the contour between two corners, curves are flattened.
+struct Edge
+{
+    std::vector<Vector2f> points;
+    std::uint8_t color = white;
+};
+
+bool is_corner(Vector2f in, Vector2f out)
+{
+    in  = normalize(in);
+    out = normalize(out);
+
+    return dot(in, out) <= 0.0f || std::abs(cross(in, out)) > corner_cross_threshold;
+}
+
+// Splits the only edge of the contour with one corner into three, so the corner gets two different colors.
+std::vector<Edge> split_teardrop(Edge edge)
+{
+    while (edge.points.size() < 4) {
+        edge.points.insert(edge.points.begin() + 1, (edge.points[0] + edge.points[1]) * 0.5f);
+    }
+
+    const std::size_t last   = edge.points.size() - 1;
+    const std::size_t first  = last / 3;
+    const std::size_t second = last * 2 / 3;
+
+    const auto begin = edge.points.begin();
+
+    std::vector<Edge> edges(3);
+    edges[0] = {std::vector<Vector2f>(begin, begin + static_cast<std::ptrdiff_t>(first) + 1), magenta};
+    edges[1] = {std::vector<Vector2f>(begin + static_cast<std::ptrdiff_t>(first),
+                                      begin + static_cast<std::ptrdiff_t>(second) + 1),
+                white};
+    edges[2] = {std::vector<Vector2f>(begin + static_cast<std::ptrdiff_t>(second), edge.points.end()), yellow};
+
+    return edges;
+}
+
+// Edges meeting in a corner share one color channel only.
+std::vector<Edge> make_edges(const std::vector<Segment>& segments, float tolerance)
+{
+    const std::size_t count = segments.size();
+
+    std::vector<std::size_t> corners;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Segment& previous = segments[(i + count - 1) % count];
+        if (is_corner(previous.end_direction(), segments[i].start_direction())) {
+            corners.push_back(i);
+        }
+    }
+
+    if (corners.empty()) {
+        Edge edge;
+        edge.points.push_back(segments.front().start);
+        for (const auto& segment : segments) {
+            flatten(segment, tolerance, edge.points);
+        }
+
+        return {std::move(edge)};
+    }
+
+    std::vector<Edge> edges(corners.size());
+    for (std::size_t c = 0; c < corners.size(); ++c) {
+        const std::size_t end = corners[(c + 1) % corners.size()];
+
+        std::size_t i = corners[c];
+        edges[c].points.push_back(segments[i].start);
+        do {
+            flatten(segments[i], tolerance, edges[c].points);
+            i = (i + 1) % count;
+        } while (i != end);
+
+        edges[c].color = c % 2 == 0 ? cyan : magenta;
+    }
+
+    if (edges.size() == 1) {
+        return split_teardrop(std::move(edges.front()));
+    }
+
+    if (edges.size() % 2 == 1) {
+        edges.back().color = yellow;
+    }
+
+    return edges;
+}
+
+#pragma endregion
+
+#pragma region Distances
+
+struct Line
+{
+    Vector2f start;
+    Vector2f direction;
+    float length       = 0.0f;
+    std::uint32_t edge = 0;
+    bool is_edge_start = false;
+    bool is_edge_end   = false;
+};
+
+struct EdgeDistance
+{
+    float distance        = std::numeric_limits<float>::max(); // Absolute distance to the closest point.
+    float orthogonality   = 1.0f; // Cosine of the angle between the edge and the direction to the point.
+    float signed_distance = 0.0f;
+    float pseudo_distance = 0.0f; // Distance to the edge, extended by tangent lines at the ends.
+
+    bool is_replaced_by(float other_distance, float other_orthogonality) const
+    {
+        return other_distance < distance || (other_distance == distance && other_orthogonality < orthogonality);
+    }
+
+    bool is_replaced_by(const EdgeDistance& other) const
+    {
+        return is_replaced_by(other.distance, other.orthogonality);
+    }
+};
+
+// Inside of the glyph is on the right side of the outline, as TrueType fills clockwise contours.
+void update_distance(const Line& line, Vector2f point, EdgeDistance& result)
+{
+    const Vector2f to_point = point - line.start;
+
+    const float t    = dot(to_point, line.direction) / (line.length * line.length);
+    const float side = cross(line.direction, to_point);
+
+    const Vector2f closest = line.start + line.direction * std::clamp(t, 0.0f, 1.0f);
+    const Vector2f offset  = point - closest;
+    const float distance   = length(offset);
+
+    float orthogonality = 0.0f;
+    if ((t <= 0.0f || t >= 1.0f) && distance > 0.0f) {
+        orthogonality = std::abs(dot(line.direction, offset)) / (line.length * distance);
+    }
+
+    if (!result.is_replaced_by(distance, orthogonality)) {
+        return;
+    }
+
+    result.distance        = distance;
+    result.orthogonality   = orthogonality;
+    result.signed_distance = side < 0.0f ? distance : -distance;
+    result.pseudo_distance = result.signed_distance;
+
+    if ((line.is_edge_start && t < 0.0f) || (line.is_edge_end && t > 1.0f)) {
+        const float pseudo_distance = -side / line.length;
+        if (std::abs(pseudo_distance) <= distance) {
+            result.pseudo_distance = pseudo_distance;
+        }
+    }
+}
+
+// Nonzero winding of the scanline crossings to the left of the point.
+struct Crossing
+{
+    float x       = 0.0f;
+    int direction = 0;
+};
+
+std::vector<Crossing> scanline_crossings(const std::vector<Line>& lines, float y)
+{
+    std::vector<Crossing> crossings;
+
+    for (const auto& line : lines) {
+        const float y0 = line.start.y;
+        const float y1 = line.start.y + line.direction.y;
+
+        if ((y0 <= y && y < y1) || (y1 <= y && y < y0)) {
+            const float x = line.start.x + (y - y0) * line.direction.x / line.direction.y;
+            crossings.push_back({x, y1 > y0 ? 1 : -1});
+        }
+    }
+
+    std::sort(crossings.begin(), crossings.end(), [](const auto& a, const auto& b) { return a.x < b.x; });
+
+    return crossings;
+}
+
+float median(float a, float b, float c)
+{
+    return std::max(std::min(a, b), std::min(std::max(a, b), c));
+}
+
+std::uint8_t encode(float distance, float scale, float range)
+{
+    const float value = std::clamp(0.5f + distance * scale / range, 0.0f, 1.0f);
+    return static_cast<std::uint8_t>(std::lround(value * 255.0f));
+}
+
+#pragma endregion
+
+} // namespace
+
+namespace framework::graphics::details::font
+{
+
+void generate_distance_field(const GlyphData::Contours& contours,
+                             math::Vector2f origin,
+                             float scale,
+                             float range,
+                             const DistanceFieldBitmap& bitmap)
+{
+    const float tolerance = flattening_tolerance / scale;
+
+    std::vector<Edge> edges;
+    for (const auto& contour : contours) {
+        const std::vector<Segment> segments = make_segments(contour);
+        if (!segments.empty()) {
+            std::vector<Edge> contour_edges = make_edges(segments, tolerance);
+            std::move(contour_edges.begin(), contour_edges.end(), std::back_inserter(edges));
+        }
+    }
+
+    std::vector<Line> lines;
+    for (std::size_t e = 0; e < edges.size(); ++e) {
+        const auto& points = edges[e].points;
+
+        for (std::size_t i = 0; i + 1 < points.size(); ++i) {
+            Line line;
+            line.start         = points[i];
+            line.direction     = points[i + 1] - points[i];
+            line.length        = length(line.direction);
+            line.edge          = static_cast<std::uint32_t>(e);
+            line.is_edge_start = i == 0;
+            line.is_edge_end   = i + 2 == points.size();
+
+            if (line.length > 0.0f) {
+                lines.push_back(line);
+            }
+        }
+    }
+
+    const bool multi_channel = bitmap.channels_count == 3;
+
+    std::vector<EdgeDistance> distances(edges.size());
+
+    for (std::size_t y = 0; y < bitmap.height; ++y) {
+        std::uint8_t* row = bitmap.data + y * bitmap.stride;
+
+        const float point_y                   = origin.y + (static_cast<float>(y) + 0.5f) / scale;
+        const std::vector<Crossing> crossings = scanline_crossings(lines, point_y);
+
+        std::size_t crossing = 0;
+        int winding          = 0;
+
+        for (std::size_t x = 0; x < bitmap.width; ++x) {
+            const Vector2f point(origin.x + (static_cast<float>(x) + 0.5f) / scale, point_y);
+
+            for (; crossing < crossings.size() && crossings[crossing].x < point.x; ++crossing) {
+                winding += crossings[crossing].direction;
+            }
+
+            std::fill(distances.begin(), distances.end(), EdgeDistance());
+            for (const auto& line : lines) {
+                update_distance(line, point, distances[line.edge]);
+            }
+
+            float distance = std::numeric_limits<float>::max();
+            for (const auto& edge_distance : distances) {
+                distance = std::min(distance, edge_distance.distance);
+            }
+
+            distance = winding != 0 ? distance : -distance;
+
+            std::uint8_t* pixel = row + x * bitmap.channels_count;
+            if (!multi_channel) {
+                pixel[0] = encode(distance, scale, range);
+                continue;
+            }
+
+            float channels[3] = {distance, distance, distance};
+            for (std::size_t c = 0; c < 3; ++c) {
+                const EdgeDistance* closest = nullptr;
+                for (std::size_t e = 0; e < edges.size(); ++e) {
+                    const bool has_channel = (edges[e].color & (1 << c)) != 0;
+                    if (has_channel && (closest == nullptr || closest->is_replaced_by(distances[e]))) {
+                        closest = &distances[e];
+                    }
+                }
+
+                if (closest != nullptr) {
+                    channels[c] = closest->pseudo_distance;
+                }
+            }
+
+            // Overlapping contours or close edges of the same color may give the wrong median.
+            if ((median(channels[0], channels[1], channels[2]) > 0.0f) != (winding != 0)) {
+                std::fill(std::begin(channels), std::end(channels), distance);
+            }
+
+            for (std::size_t c = 0; c < 3; ++c) {
+                pixel[c] = encode(channels[c], scale, range);
+            }
+        }
+    }
+}
+
+} // namespace framework::graphics::details::font
@@ -0,0 +1,38 @@
+#ifndef GRAPHICS_SRC_FONT_DISTANCE_FIELD_HPP
+#define GRAPHICS_SRC_FONT_DISTANCE_FIELD_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <math/math.hpp>
+
+#include <graphics/src/font/tables/glyph_data.hpp>
+
+namespace framework::graphics::details::font
+{
+// Pixels of the glyph bitmap, rows are stored from bottom to top.
+struct DistanceFieldBitmap
+{
+    std::uint8_t* data         = nullptr;
+    std::size_t width          = 0;
+    std::size_t height         = 0;
+    std::size_t stride         = 0; // Bytes between the rows.
+    std::size_t channels_count = 1; // 1 for the single channel field, 3 for the multi-channel one.
+};
+
+// Computes the signed distance field of the glyph outline in the centers of the bitmap pixels.
+//
+// The `origin` is the bottom left corner of the bitmap in font units, `scale` is the number of pixels per font unit.
+// Distance is positive inside the glyph, it's encoded as 0.5 + distance / range, where range is in pixels.
+//
+// The multi-channel field stores the distances to the differently colored edges, so the median of channels
+// keeps the sharp corners. Pixels where the median disagrees with the true inside test get the single channel value.
+void generate_distance_field(const GlyphData::Contours& contours,
+                             math::Vector2f origin,
+                             float scale,
+                             float range,
+                             const DistanceFieldBitmap& bitmap);
+
+} // namespace framework::graphics::details::font
+
+#endif
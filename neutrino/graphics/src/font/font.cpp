@@ -1,15 +1,15 @@
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstdint>
 #include <exception>
-#include <fstream>
 #include <functional>
-#include <numeric>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
 #include <common/exceptions.hpp>
+#include <common/memory_mapped_file.hpp>
 #include <common/utils.hpp>
 #include <graphics/color.hpp>
 #include <graphics/font.hpp>
@@ -17,6 +17,9 @@
 #include <log/log.hpp>
 #include <math/math.hpp>
 
+#include <graphics/src/font/font_data.hpp>
+#include <graphics/src/font/glyph_atlas.hpp>
+#include <graphics/src/font/glyph_cache.hpp>
 #include <graphics/src/font/tables/character_to_glyph_index_mapping.hpp>
 #include <graphics/src/font/tables/font_header.hpp>
 #include <graphics/src/font/tables/glyph_data.hpp>
@@ -41,7 +44,9 @@ using math::Polygon;
 
 struct TableRecord
 {
-    static TableRecord read(std::istream& in);
+    inline static constexpr std::size_t size = 16;
+
+    static TableRecord read(BytesData in);
 
     bool is_valid() const;
 
@@ -51,18 +56,13 @@ struct TableRecord
     std::uint32_t length   = 0;
 };
 
-TableRecord TableRecord::read(std::istream& in)
+TableRecord TableRecord::read(BytesData in)
 {
-    constexpr size_t size = 16;
-
-    std::array<char, size> buffer = {0};
-    in.read(buffer.data(), size);
-
     TableRecord table;
-    table.tag      = utils::big_endian_value<Tag>(buffer.begin());
-    table.checksum = utils::big_endian_value<std::uint32_t>(buffer.begin() + 4);
-    table.offset   = utils::big_endian_value<std::uint32_t>(buffer.begin() + 8);
-    table.length   = utils::big_endian_value<std::uint32_t>(buffer.begin() + 12);
+    table.tag      = utils::big_endian_value<Tag>(in.begin());
+    table.checksum = utils::big_endian_value<std::uint32_t>(in.begin() + 4);
+    table.offset   = utils::big_endian_value<std::uint32_t>(in.begin() + 8);
+    table.length   = utils::big_endian_value<std::uint32_t>(in.begin() + 12);
 
     return table;
 }
@@ -100,7 +100,9 @@ struct TableDirectory
     inline static constexpr std::uint32_t open_type_tag       = make_tag('O', 'T', 'T', 'O');
     inline static constexpr std::uint32_t font_collection_tag = make_tag('t', 't', 'c', 'f');
 
-    static TableDirectory read(std::istream& in);
+    inline static constexpr std::size_t size = 12;
+
+    static TableDirectory read(BytesData in);
 
     bool is_valid() const;
 
@@ -113,25 +115,27 @@ struct TableDirectory
     std::vector<TableRecord> table_records;
 };
 
-TableDirectory TableDirectory::read(std::istream& in)
+// Truncated records list is returned partially, so it's rejected by the is_valid check.
+TableDirectory TableDirectory::read(BytesData in)
 {
-    constexpr size_t size = 12;
-
-    std::array<char, size> buffer = {0};
+    TableDirectory table_directory;
 
-    in.read(buffer.data(), size);
+    if (in.size() < size) {
+        return table_directory;
+    }
 
-    TableDirectory table_directory;
-    table_directory.sfnt_version   = utils::big_endian_value<std::uint32_t>(buffer.begin());
-    table_directory.num_tables     = utils::big_endian_value<std::uint16_t>(buffer.begin() + 4);
-    table_directory.search_range   = utils::big_endian_value<std::uint16_t>(buffer.begin() + 6);
-    table_directory.entry_selector = utils::big_endian_value<std::uint16_t>(buffer.begin() + 8);
-    table_directory.range_shift    = utils::big_endian_value<std::uint16_t>(buffer.begin() + 10);
+    table_directory.sfnt_version   = utils::big_endian_value<std::uint32_t>(in.begin());
+    table_directory.num_tables     = utils::big_endian_value<std::uint16_t>(in.begin() + 4);
+    table_directory.search_range   = utils::big_endian_value<std::uint16_t>(in.begin() + 6);
+    table_directory.entry_selector = utils::big_endian_value<std::uint16_t>(in.begin() + 8);
+    table_directory.range_shift    = utils::big_endian_value<std::uint16_t>(in.begin() + 10);
 
     table_directory.table_records.reserve(table_directory.num_tables);
 
-    for (std::size_t i = 0; in && i < table_directory.num_tables; i++) {
-        table_directory.table_records.push_back(TableRecord::read(in));
+    BytesData records = in.subspan(size);
+    for (std::size_t i = 0; records.size() >= TableRecord::size && i < table_directory.num_tables; i++) {
+        table_directory.table_records.push_back(TableRecord::read(records));
+        records = records.subspan(TableRecord::size);
     }
 
     return table_directory;
@@ -175,23 +179,12 @@ bool TableDirectory::is_valid() const
 
 struct Table
 {
-    bool read_data(std::ifstream& in);
     bool is_valid() const;
 
     TableRecord record;
     BytesData data;
 };
 
-bool Table::read_data(std::ifstream& in)
-{
-    in.seekg(record.offset, in.beg);
-
-    data.resize(record.length);
-    in.read(reinterpret_cast<char*>(data.data()), record.length);
-
-    return in.good();
-}
-
 std::uint32_t table_checksum(const BytesData& data)
 {
     std::uint32_t sum = 0;
@@ -257,128 +250,108 @@ bool has_required_tables(const TableDirectory& table_directory)
     return true;
 }
 
-std::unordered_map<Tag, Table> read_all_tables(std::ifstream& in, const std::vector<TableRecord>& table_records)
+// Tables refer to the font data, no bytes are copied.
+std::unordered_map<Tag, Table> read_all_tables(BytesData data, const std::vector<TableRecord>& table_records)
 {
     std::unordered_map<Tag, Table> tables;
 
     for (const auto& record : table_records) {
-        tables[record.tag].record = record;
-
-        if (!tables[record.tag].read_data(in)) {
+        if (record.offset > data.size() || record.length > data.size() - record.offset) {
             break;
         }
+
+        tables[record.tag] = Table{record, data.subspan(record.offset, record.length)};
     }
 
     return tables;
 }
 
+// Zero is never given, so it means no font data.
+std::uint64_t next_font_data_generation()
+{
+    static std::atomic<std::uint64_t> generation = 0;
+    return ++generation;
+}
+
 #pragma endregion
 
 #pragma region Glyph Vertices Generation
 
-struct GlyphMeshData
+// Primitives that can be joined into one submesh. Joined strips and fans would be connected to each other.
+constexpr std::array<Mesh::PrimitiveType, 3> list_primitive_types = {Mesh::PrimitiveType::points,
+                                                                     Mesh::PrimitiveType::lines,
+                                                                     Mesh::PrimitiveType::triangles};
+
+std::size_t list_primitive_index(Mesh::PrimitiveType type)
 {
-    Mesh::VertexData vertices;
-    std::vector<Mesh::SubMesh> submeshes;
-    float advance_step = 1.0;
-};
+    const auto it = std::find(list_primitive_types.begin(), list_primitive_types.end(), type);
+    return static_cast<std::size_t>(it - list_primitive_types.begin());
+}
+
+// Max distance between the glyph outline and its polygon in em units is 1 / (32 * (quality + 1)^2).
+// It's the error of quality + 1 uniform steps on the curve with |p1 - 2 * p2 + p3| equal to a quarter of em.
+constexpr float flattening_tolerance_scale = 32.0f;
 
-Polygon generate_polygon(const GlyphData::ContourType& contour, Font::QualityType quality)
+Polygon generate_polygon(const GlyphData::ContourType& contour, float tolerance)
 {
     Polygon polygon;
 
+    // Off curve points are always between two on curve ones, the curve end point is appended by the curve.
     for (size_t i = 0; i < contour.size(); ++i) {
         const auto& point = contour[i];
+        const auto& prev  = (i == 0 ? contour.back() : contour[i - 1]);
 
-        if (point.is_on_curve) {
+        if (!point.is_on_curve) {
+            const auto& next = (i == contour.size() - 1 ? contour.front() : contour[i + 1]);
+            flatten_quadratic_bezier(prev.position, point.position, next.position, tolerance, polygon);
+        } else if (prev.is_on_curve) {
             polygon.push_back(point.position);
-        } else {
-            // genqrate points
-            const math::Vector2f p1 = (i == 0 ? contour.back().position : contour[i - 1].position);
-            const math::Vector2f p2 = (i == contour.size() - 1 ? contour.front().position : contour[i + 1].position);
-            const float q_step      = 1.0f / (quality + 1.0f);
-
-            for (Font::QualityType q = 0; q < quality; ++q) {
-                polygon.push_back(quadratic_bezier(p1, point.position, p2, (q + 1) * q_step));
-            }
         }
     }
 
     return polygon;
 }
 
-std::vector<Polygon> convert_polygons_with_holes_to_holeless_polygons(const std::vector<Polygon>& filled,
-                                                                      const std::vector<Polygon>& holes)
+// Filled contour with the holes inside it.
+struct GlyphShape
 {
-    std::vector<Polygon> holeless;
-    holeless.reserve(filled.size());
-
-    for (const auto& polygon : filled) {
-        std::vector<size_t> holes_in_polygon;
-        size_t holes_points_count = 0;
-        for (size_t i = 0; i < holes.size(); ++i) {
-            if (is_point_in_polygon(holes[i].front(), polygon)) {
-                holes_in_polygon.push_back(i);
-                holes_points_count += holes[i].size();
-            }
-        }
-
-        Polygon combine = polygon;
-        combine.reserve(polygon.size() + holes_points_count + holes_in_polygon.size() * 2);
-
-        for (const auto& hole_index : holes_in_polygon) {
-            const auto& hole              = holes[hole_index];
-            const math::Vector2f hole_top = hole.front();
-
-            // Find closest point in filled contour that higher than hole
-            auto closest_point_it = combine.begin();
-            for (auto it = std::next(combine.begin()); it != combine.end(); ++it) {
-                if (it->y < hole_top.y) {
-                    continue;
-                }
-
-                const float dist_prev = squared_distance(hole_top, *closest_point_it);
-                const float dist_curr = squared_distance(hole_top, *it);
-                if (dist_prev > dist_curr) {
-                    closest_point_it = it;
-                }
-            }
-
-            auto it = combine.insert(next(closest_point_it), *closest_point_it);
-            it      = combine.insert(it, hole.front());
-            combine.insert(it, hole.begin(), hole.end());
-        }
-
-        holeless.emplace_back(std::move(combine));
-    }
-
-    return holeless;
-}
+    Polygon outline;
+    std::vector<Polygon> holes;
+};
 
-std::vector<Polygon> generate_glyph_polygons(const GlyphData::Contours& contours, Font::QualityType quality)
+std::vector<GlyphShape> generate_glyph_shapes(const GlyphData::Contours& contours, float tolerance)
 {
-    std::vector<Polygon> filled;
+    std::vector<GlyphShape> shapes;
     std::vector<Polygon> holes;
 
     for (const auto& contour : contours) {
-        Polygon polygon = generate_polygon(contour, quality);
+        Polygon polygon = generate_polygon(contour, tolerance);
         if (polygon_area(polygon) > 0.0f) {
-            filled.emplace_back(std::move(polygon));
-        } else {
+            shapes.push_back({std::move(polygon), {}});
+        } else if (!polygon.empty()) {
             holes.emplace_back(std::move(polygon));
         }
     }
 
-    // Rearange points in hole so the top poiint go first
+    // The hole goes to the smallest filled contour around it, so nested contours are handled properly.
     for (auto& hole : holes) {
-        auto it = std::max_element(hole.begin(), hole.end(), [](const auto& a, const auto& b) { return a.y < b.y; });
-        std::rotate(hole.begin(), it, hole.end());
-    }
+        GlyphShape* owner = nullptr;
+        float owner_area  = 0.0f;
+
+        for (auto& shape : shapes) {
+            const float area = polygon_area(shape.outline);
+            if ((owner == nullptr || area < owner_area) && is_point_in_polygon(hole.front(), shape.outline)) {
+                owner      = &shape;
+                owner_area = area;
+            }
+        }
 
-    // Sort holes by top points
-    std::sort(holes.begin(), holes.end(), [](const auto& a, const auto& b) { return a[0].y > b[0].y; });
+        if (owner != nullptr) {
+            owner->holes.emplace_back(std::move(hole));
+        }
+    }
 
-    return convert_polygons_with_holes_to_holeless_polygons(filled, holes);
+    return shapes;
 }
 
 GlyphMeshData create_glyph_mesh(const GlyphData::Contours& contours,
@@ -387,20 +360,30 @@ GlyphMeshData create_glyph_mesh(const GlyphData::Contours& contours,
 {
     using graphics::Color;
 
-    const std::vector<Polygon> polygons = generate_glyph_polygons(contours, quality);
+    const auto steps                     = static_cast<float>(quality + 1);
+    const float tolerance                = units_per_em / (flattening_tolerance_scale * steps * steps);
+    const std::vector<GlyphShape> shapes = generate_glyph_shapes(contours, tolerance);
 
     // Generate result
     GlyphMeshData res;
     res.submeshes.push_back({{}, Mesh::PrimitiveType::triangles});
 
-    for (const auto& polygon : polygons) {
-        const auto& indices = generate_ear_cut_triangulation(polygon);
-
-        const auto indices_offset = static_cast<Mesh::IndicesData::value_type>(res.vertices.size());
+    const auto add_vertices = [&res, upm = units_per_em](const Polygon& polygon) {
         std::transform(polygon.begin(),
                        polygon.end(),
                        std::back_inserter(res.vertices),
-                       [upm = units_per_em](const auto& v) { return math::Vector3f(v / upm); });
+                       [upm](const auto& v) { return math::Vector3f(v / upm); });
+    };
+
+    for (const auto& shape : shapes) {
+        const auto& indices = generate_ear_cut_triangulation(shape.outline, shape.holes);
+
+        // Indices refer to the outline points followed by the holes points.
+        const auto indices_offset = static_cast<Mesh::IndicesData::value_type>(res.vertices.size());
+        add_vertices(shape.outline);
+        for (const auto& hole : shape.holes) {
+            add_vertices(hole);
+        }
 
         std::transform(indices.begin(),
                        indices.end(),
@@ -419,60 +402,29 @@ namespace framework::graphics
 {
 
 #pragma region class FontData
-class Font::FontData
-{
-public:
-    using GlyphIdToMeshMap = std::unordered_map<GlyphId, GlyphMeshData>;
-
-    FontData(FontHeader head,
-             HorizontalMetrics hmtx,
-             CharacterToGlyphIndexMapping cmap,
-             Os2 os2,
-             GlyphData glyf,
-             Font::QualityType quality);
-
-    FontData(const FontData& other);
-    FontData(FontData&& other) noexcept = default;
-
-    FontData& operator=(const FontData& other);
-    FontData& operator=(FontData&& other) noexcept = default;
-
-    ~FontData() = default;
-
-    void add_glyph(GlyphId id);
-
-    GlyphId glyph_index(CodePoint codepoint) const;
-    std::uint16_t advance_width(GlyphId id) const;
-    std::int16_t left_sidebearing(GlyphId id) const;
-    std::uint16_t units_per_em() const;
-
-    bool baseline_at_y_zero() const;
-
-    const GlyphIdToMeshMap& glyphs() const;
-
-private:
-    GlyphIdToMeshMap m_glyphs;
-    FontHeader m_head;
-    HorizontalMetrics m_hmtx;
-    CharacterToGlyphIndexMapping m_cmap;
-    Os2 m_os2;
-    GlyphData m_glyf;
-    Font::QualityType m_quality = 1;
-};
 
 Font::FontData::FontData(FontHeader head,
                          HorizontalMetrics hmtx,
                          CharacterToGlyphIndexMapping cmap,
                          Os2 os2,
                          GlyphData glyf,
-                         Font::QualityType quality)
+                         Font::QualityType quality,
+                         std::size_t cache_capacity,
+                         const Font::AtlasOptions& atlas_options)
     : m_head(std::move(head))
     , m_hmtx(std::move(hmtx))
     , m_cmap(std::move(cmap))
     , m_os2(std::move(os2))
     , m_glyf(std::move(glyf))
     , m_quality(std::move(quality))
-{}
+    , m_cache(std::make_unique<GlyphCache>(cache_capacity))
+    , m_atlas(atlas_options)
+    , m_generation(next_font_data_generation())
+{
+    if (m_os2.default_char() != 0) {
+        m_default_glyph = m_cmap.glyph_index(m_os2.default_char());
+    }
+}
 
 Font::FontData::FontData(const Font::FontData& other)
     : m_head(other.m_head)
@@ -480,7 +432,11 @@ Font::FontData::FontData(const Font::FontData& other)
     , m_cmap(other.m_cmap)
     , m_os2(other.m_os2)
     , m_glyf(other.m_glyf)
+    , m_default_glyph(other.m_default_glyph)
     , m_quality(other.m_quality)
+    , m_cache(std::make_unique<GlyphCache>(other.m_cache->capacity()))
+    , m_atlas(other.m_atlas.options())
+    , m_generation(next_font_data_generation())
 {}
 
 Font::FontData& Font::FontData::operator=(const Font::FontData& other)
@@ -488,44 +444,70 @@ Font::FontData& Font::FontData::operator=(const Font::FontData& other)
     using std::swap;
 
     FontData tmp(other);
-    swap(tmp.m_glyphs, m_glyphs);
     swap(tmp.m_head, m_head);
     swap(tmp.m_hmtx, m_hmtx);
     swap(tmp.m_cmap, m_cmap);
     swap(tmp.m_os2, m_os2);
     swap(tmp.m_glyf, m_glyf);
+    swap(tmp.m_default_glyph, m_default_glyph);
     swap(tmp.m_quality, m_quality);
+    swap(tmp.m_cache, m_cache);
+    swap(tmp.m_atlas, m_atlas);
+    swap(tmp.m_generation, m_generation);
 
     return *this;
 }
 
-void Font::FontData::add_glyph(GlyphId glyph_id)
+GlyphCache::GlyphPointer Font::FontData::glyph(GlyphId glyph_id) const
 {
-    if (m_glyphs.count(glyph_id) == 0) {
+    return m_cache->get(glyph_id, [this](GlyphId id) {
+        if (!m_glyf.has(id)) {
+            throw std::runtime_error(
+            "Trying to load glyph that is not in font. Cmap table must return missing_glyph_id in this case.");
+        }
+
+        GlyphMeshData glyph_mesh = create_glyph_mesh(m_glyf.at(id), units_per_em(), m_quality);
+        glyph_mesh.advance_step  = (advance_width(id) / static_cast<float>(units_per_em()));
+
+        return glyph_mesh;
+    });
+}
+
+void Font::FontData::add_atlas_glyph(GlyphId glyph_id)
+{
+    if (m_atlas.find(glyph_id) == nullptr) {
 
         if (!m_glyf.has(glyph_id)) {
             throw std::runtime_error(
             "Trying to load glyph that is not in font. Cmap table must return missing_glyph_id in this case.");
         }
 
-        m_glyphs.emplace(glyph_id, create_glyph_mesh(m_glyf.at(glyph_id), units_per_em(), m_quality));
-
-        m_glyphs[glyph_id].advance_step = (advance_width(glyph_id) / static_cast<float>(units_per_em()));
+        m_atlas.add(glyph_id, m_glyf.at(glyph_id), units_per_em());
     }
 }
 
+void Font::FontData::set_atlas_options(const Font::AtlasOptions& options)
+{
+    m_atlas = GlyphAtlas(options);
+}
+
+// Code points without glyphs are shown with the default character, if the font has it.
 GlyphId Font::FontData::glyph_index(CodePoint codepoint) const
 {
-    GlyphId id = m_cmap.glyph_index(codepoint);
+    const GlyphId id = m_cmap.glyph_index(codepoint);
+    return id != missig_glyph_id ? id : m_default_glyph;
+}
 
-    if (id == missig_glyph_id) {
-        auto codepoints = utf::to_codepoints(std::u16string(1u, static_cast<char16_t>(m_os2.default_char())));
-        if (!codepoints.empty()) {
-            id = m_cmap.glyph_index(codepoint);
-        }
+std::vector<GlyphId> Font::FontData::glyph_indices(Span<const CodePoint> codepoints) const
+{
+    std::vector<GlyphId> ids(codepoints.size());
+    m_cmap.glyph_indices(codepoints, Span(ids));
+
+    for (auto& id : ids) {
+        id = id != missig_glyph_id ? id : m_default_glyph;
     }
 
-    return id;
+    return ids;
 }
 
 std::uint16_t Font::FontData::advance_width(GlyphId id) const
@@ -543,14 +525,32 @@ std::uint16_t Font::FontData::units_per_em() const
     return m_head.units_per_em();
 }
 
+float Font::FontData::line_spacing() const
+{
+    const int spacing = m_os2.typo_ascender() - m_os2.typo_descender() + m_os2.typo_line_gap();
+
+    // Fonts without typographic metrics get lines one em apart.
+    return spacing > 0 ? static_cast<float>(spacing) / units_per_em() : 1.0f;
+}
+
 bool Font::FontData::baseline_at_y_zero() const
 {
     return m_head.baseline_at_y_zero();
 }
 
-const Font::FontData::GlyphIdToMeshMap& Font::FontData::glyphs() const
+GlyphCache& Font::FontData::cache() const
+{
+    return *m_cache;
+}
+
+const GlyphAtlas& Font::FontData::atlas() const
+{
+    return m_atlas;
+}
+
+std::uint64_t Font::FontData::generation() const
 {
-    return m_glyphs;
+    return m_generation;
 }
 
 #pragma endregion
@@ -564,6 +564,9 @@ Font::Font(Font::QualityType quality)
 
 Font::Font(const Font& other)
     : m_data(std::make_unique<FontData>(*other.m_data))
+    , m_quality(other.m_quality)
+    , m_cache_capacity(other.m_cache_capacity)
+    , m_atlas_options(other.m_atlas_options)
 {}
 
 Font::Font(Font&& other) noexcept
@@ -594,8 +597,24 @@ Font::LoadResult Font::load(const std::filesystem::path& file)
         return LoadResult::FileNotExists;
     }
 
+    auto mapped_file = std::make_shared<const MemoryMappedFile>(file);
+    if (!mapped_file->is_open()) {
+        return LoadResult::OpenFileError;
+    }
+
+    return load(as_bytes(mapped_file->bytes()), mapped_file);
+}
+
+Font::LoadResult Font::load(Span<const std::byte> data)
+{
+    return load(data, nullptr);
+}
+
+// Glyph outlines are decoded from the data while the storage is alive. Without the storage they are copied.
+Font::LoadResult Font::load(Span<const std::byte> data, std::shared_ptr<const void> storage)
+{
     try {
-        return parse(file);
+        return parse(Span(reinterpret_cast<const std::uint8_t*>(data.data()), data.size()), std::move(storage));
     } catch (UnsupportedError& e) {
         log::error("Exception:") << e.what();
         return LoadResult::Unsupported;
@@ -619,29 +638,31 @@ Mesh Font::create_text_mesh(const std::string& text)
         throw std::runtime_error("Font data is not loaded. See Font::load.");
     }
 
-    precache(text);
+    const std::vector<GlyphId> glyph_ids = m_data->glyph_indices(utf::to_codepoints(text));
 
-    std::vector<std::reference_wrapper<const GlyphMeshData>> glyphs;
-    glyphs.reserve(text.size());
+    // Glyphs are held, so they stay valid even if other threads evict them from the cache.
+    std::vector<GlyphCache::GlyphPointer> glyphs;
+    glyphs.reserve(glyph_ids.size());
 
     // Collect glyphs
-    for (const auto& cp : utf::to_codepoints(text)) {
-        const GlyphId glyph_id = m_data->glyph_index(cp);
+    for (const GlyphId glyph_id : glyph_ids) {
+        glyphs.push_back(m_data->glyph(glyph_id));
+    }
 
-        const auto it = m_data->glyphs().find(glyph_id);
-        if (it == m_data->glyphs().end()) {
-            throw std::runtime_error("Can't find glyph to create mesh.");
-        }
+    // Glyphs are joined into one submesh per primitive type, so the buffers are allocated once.
+    size_t vertices_count = 0;
+    std::array<size_t, list_primitive_types.size()> indices_counts{};
 
-        glyphs.push_back(it->second);
-    }
+    for (const auto& glyph : glyphs) {
+        vertices_count += glyph->vertices.size();
 
-    const size_t vertices_count = std::accumulate(glyphs.begin(),
-                                                  glyphs.end(),
-                                                  size_t(0),
-                                                  [](size_t sum, const auto& glyph) {
-                                                      return sum + glyph.get().vertices.size();
-                                                  });
+        for (const auto& submesh : glyph->submeshes) {
+            const size_t index = list_primitive_index(submesh.primitive_type);
+            if (index < indices_counts.size()) {
+                indices_counts[index] += submesh.indices.size();
+            }
+        }
+    }
 
     // for new line
     // see OS2 sTypoAscender, sTypoDescender and sTypoLineGap for linespacing
@@ -651,10 +672,15 @@ Mesh Font::create_text_mesh(const std::string& text)
     Mesh::VertexData vertices;
     vertices.reserve(vertices_count);
 
+    std::array<Mesh::IndicesData, list_primitive_types.size()> list_indices;
+    for (size_t i = 0; i < list_indices.size(); ++i) {
+        list_indices[i].reserve(indices_counts[i]);
+    }
+
     math::Vector3f vetricies_offset;
 
-    for (const auto& glyph_ref : glyphs) {
-        const GlyphMeshData& glyph = glyph_ref.get();
+    for (const auto& glyph_pointer : glyphs) {
+        const GlyphMeshData& glyph = *glyph_pointer;
 
         const IndicesDataType indices_offset = static_cast<IndicesDataType>(vertices.size());
 
@@ -665,12 +691,26 @@ Mesh Font::create_text_mesh(const std::string& text)
         vetricies_offset += math::Vector3f{glyph.advance_step, 0, 0};
 
         for (const auto& submesh : glyph.submeshes) {
-            Mesh::IndicesData indices;
-            indices.reserve(submesh.indices.size());
-            for (const auto& i : submesh.indices) {
-                indices.push_back(i + indices_offset);
+            const size_t index = list_primitive_index(submesh.primitive_type);
+
+            if (index < list_indices.size()) {
+                for (const auto& i : submesh.indices) {
+                    list_indices[index].push_back(i + indices_offset);
+                }
+            } else {
+                Mesh::IndicesData indices;
+                indices.reserve(submesh.indices.size());
+                for (const auto& i : submesh.indices) {
+                    indices.push_back(i + indices_offset);
+                }
+                mesh.add_submesh(std::move(indices), submesh.primitive_type);
             }
-            mesh.add_submesh(std::move(indices), submesh.primitive_type);
+        }
+    }
+
+    for (size_t i = 0; i < list_indices.size(); ++i) {
+        if (!list_indices[i].empty()) {
+            mesh.add_submesh(std::move(list_indices[i]), list_primitive_types[i]);
         }
     }
 
@@ -679,14 +719,124 @@ Mesh Font::create_text_mesh(const std::string& text)
     return mesh;
 }
 
-Font::LoadResult Font::parse(const std::filesystem::path& filepath)
+void Font::set_cache_capacity(std::size_t capacity)
 {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file) {
-        return LoadResult::OpenFileError;
+    m_cache_capacity = capacity;
+
+    if (m_data != nullptr) {
+        m_data->cache().set_capacity(m_cache_capacity);
+    }
+}
+
+std::size_t Font::cache_capacity() const
+{
+    return m_cache_capacity;
+}
+
+Font::CacheStatistics Font::cache_statistics() const
+{
+    return m_data != nullptr ? m_data->cache().statistics() : CacheStatistics();
+}
+
+void Font::set_atlas_options(const AtlasOptions& options)
+{
+    m_atlas_options = options;
+
+    if (m_data != nullptr) {
+        m_data->set_atlas_options(m_atlas_options);
+    }
+}
+
+const Font::AtlasOptions& Font::atlas_options() const
+{
+    return m_atlas_options;
+}
+
+Mesh Font::create_atlas_text_mesh(const std::string& text)
+{
+    using IndicesDataType = Mesh::IndicesData::value_type;
+
+    if (m_data == nullptr) {
+        throw std::runtime_error("Font data is not loaded. See Font::load.");
+    }
+
+    const std::vector<GlyphId> glyph_ids = m_data->glyph_indices(utf::to_codepoints(text));
+
+    // All glyphs are added before the texture coordinates are computed, as the atlas may grow.
+    for (const GlyphId glyph_id : glyph_ids) {
+        m_data->add_atlas_glyph(glyph_id);
+    }
+
+    const GlyphAtlas& atlas = m_data->atlas();
+    const float atlas_width  = static_cast<float>(atlas.image().width());
+    const float atlas_height = static_cast<float>(atlas.image().height());
+    const float units_per_em = static_cast<float>(m_data->units_per_em());
+
+    Mesh::VertexData vertices;
+    Mesh::TextureCoordinatesData texture_coordinates;
+    Mesh::IndicesData indices;
+
+    vertices.reserve(glyph_ids.size() * 4);
+    texture_coordinates.reserve(glyph_ids.size() * 4);
+    indices.reserve(glyph_ids.size() * 6);
+
+    float pen_position = 0.0f;
+
+    for (const GlyphId glyph_id : glyph_ids) {
+        const GlyphAtlas::Glyph& glyph = *atlas.find(glyph_id);
+
+        if (glyph.width != 0 && glyph.height != 0) {
+            const auto offset = static_cast<IndicesDataType>(vertices.size());
+
+            const math::Vector2f min = glyph.plane_min + math::Vector2f(pen_position, 0.0f);
+            const math::Vector2f max = glyph.plane_max + math::Vector2f(pen_position, 0.0f);
+
+            vertices.emplace_back(min.x, min.y, 0.0f);
+            vertices.emplace_back(max.x, min.y, 0.0f);
+            vertices.emplace_back(max.x, max.y, 0.0f);
+            vertices.emplace_back(min.x, max.y, 0.0f);
+
+            const float left   = static_cast<float>(glyph.x) / atlas_width;
+            const float bottom = static_cast<float>(glyph.y) / atlas_height;
+            const float right  = static_cast<float>(glyph.x + glyph.width) / atlas_width;
+            const float top    = static_cast<float>(glyph.y + glyph.height) / atlas_height;
+
+            texture_coordinates.emplace_back(left, bottom);
+            texture_coordinates.emplace_back(right, bottom);
+            texture_coordinates.emplace_back(right, top);
+            texture_coordinates.emplace_back(left, top);
+
+            for (const IndicesDataType i : {0, 1, 2, 0, 2, 3}) {
+                indices.push_back(offset + i);
+            }
+        }
+
+        pen_position += m_data->advance_width(glyph_id) / units_per_em;
+    }
+
+    Mesh mesh;
+    mesh.set_vertices(std::move(vertices));
+    mesh.set_texture_coordinates(0, std::move(texture_coordinates));
+
+    if (!indices.empty()) {
+        mesh.add_submesh(std::move(indices), Mesh::PrimitiveType::triangles);
     }
 
-    TableDirectory table_directory = TableDirectory::read(file);
+    return mesh;
+}
+
+const Image& Font::atlas() const
+{
+    if (m_data == nullptr) {
+        throw std::runtime_error("Font data is not loaded. See Font::load.");
+    }
+
+    return m_data->atlas().image();
+}
+
+Font::LoadResult Font::parse(Span<const std::uint8_t> data, std::shared_ptr<const void> storage)
+{
+    TableDirectory table_directory = TableDirectory::read(data);
     if (table_directory.sfnt_version == TableDirectory::open_type_tag) {
         return LoadResult::Unsupported;
     }
@@ -695,22 +845,20 @@ Font::LoadResult Font::parse(const std::filesystem::path& filepath)
         return LoadResult::Unsupported;
     }
 
-    if (!file || !table_directory.is_valid()) {
+    if (!table_directory.is_valid()) {
         return LoadResult::InvalidOffsetTable;
     }
 
     const bool has_tables = has_required_tables(table_directory);
-    if (!file || !has_tables) {
+    if (!has_tables) {
         return LoadResult::FileStructureError;
     }
 
-    const auto tables = read_all_tables(file, table_directory.table_records);
-    if (!file || tables.size() != table_directory.table_records.size()) {
+    const auto tables = read_all_tables(data, table_directory.table_records);
+    if (tables.size() != table_directory.table_records.size()) {
         return LoadResult::FileStructureError;
     }
 
-    file.close();
-
     const bool tables_valid = std::all_of(tables.begin(), tables.end(), [](const auto& it) {
         return it.second.is_valid();
     });
@@ -783,7 +931,7 @@ Font::LoadResult Font::parse(const std::filesystem::path& filepath)
         return LoadResult::TableParsingError;
     }
 
-    const GlyphData glyf(maxp.num_glyphs(), loca.offsets(), tables.at(Tag::Glyf).data);
+    GlyphData glyf(maxp.num_glyphs(), loca.offsets(), tables.at(Tag::Glyf).data, std::move(storage));
     if (!glyf.is_valid()) {
         return LoadResult::TableParsingError;
     }
@@ -793,22 +941,20 @@ Font::LoadResult Font::parse(const std::filesystem::path& filepath)
                                               std::move(cmap),
                                               std::move(os2),
                                               std::move(glyf),
-                                              m_quality);
+                                              m_quality,
+                                              m_cache_capacity,
+                                              m_atlas_options);
 
     return LoadResult::Success;
 }
 
-void Font::precache(const std::string& chars)
-{
-    for (const auto& cp : utf::to_codepoints(chars)) {
-        m_data->add_glyph(m_data->glyph_index(cp));
-    }
-}
-
 void swap(Font& lhs, Font& rhs) noexcept
 {
     using std::swap;
     swap(lhs.m_data, rhs.m_data);
+    swap(lhs.m_quality, rhs.m_quality);
+    swap(lhs.m_cache_capacity, rhs.m_cache_capacity);
+    swap(lhs.m_atlas_options, rhs.m_atlas_options);
 }
 
 } // namespace framework::graphics
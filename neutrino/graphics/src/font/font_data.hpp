@@ -0,0 +1,84 @@
+#ifndef GRAPHICS_SRC_FONT_FONT_DATA_HPP
+#define GRAPHICS_SRC_FONT_FONT_DATA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <graphics/font.hpp>
+
+#include <graphics/src/font/glyph_atlas.hpp>
+#include <graphics/src/font/glyph_cache.hpp>
+#include <graphics/src/font/tables/character_to_glyph_index_mapping.hpp>
+#include <graphics/src/font/tables/font_header.hpp>
+#include <graphics/src/font/tables/glyph_data.hpp>
+#include <graphics/src/font/tables/horizontal_metrics.hpp>
+#include <graphics/src/font/tables/os2.hpp>
+#include <graphics/src/font/types.hpp>
+
+namespace framework::graphics
+{
+
+class Font::FontData
+{
+public:
+    using GlyphId      = details::font::GlyphId;
+    using GlyphCache   = details::font::GlyphCache;
+    using GlyphAtlas   = details::font::GlyphAtlas;
+    using GlyphPointer = GlyphCache::GlyphPointer;
+
+    FontData(details::font::FontHeader head,
+             details::font::HorizontalMetrics hmtx,
+             details::font::CharacterToGlyphIndexMapping cmap,
+             details::font::Os2 os2,
+             details::font::GlyphData glyf,
+             Font::QualityType quality,
+             std::size_t cache_capacity,
+             const Font::AtlasOptions& atlas_options);
+
+    FontData(const FontData& other);
+    FontData(FontData&& other) noexcept = default;
+
+    FontData& operator=(const FontData& other);
+    FontData& operator=(FontData&& other) noexcept = default;
+
+    ~FontData() = default;
+
+    GlyphPointer glyph(GlyphId id) const;
+    void add_atlas_glyph(GlyphId id);
+    void set_atlas_options(const Font::AtlasOptions& options);
+
+    GlyphId glyph_index(details::font::CodePoint codepoint) const;
+    std::vector<GlyphId> glyph_indices(Span<const details::font::CodePoint> codepoints) const;
+    std::uint16_t advance_width(GlyphId id) const;
+    std::int16_t left_sidebearing(GlyphId id) const;
+    std::uint16_t units_per_em() const;
+
+    // Distance between baselines of the lines in em units.
+    float line_spacing() const;
+
+    bool baseline_at_y_zero() const;
+
+    GlyphCache& cache() const;
+    const GlyphAtlas& atlas() const;
+
+    // Unique number of the font data, a copy gets a new one. Unlike the address, it is never reused.
+    std::uint64_t generation() const;
+
+private:
+    details::font::FontHeader m_head;
+    details::font::HorizontalMetrics m_hmtx;
+    details::font::CharacterToGlyphIndexMapping m_cmap;
+    details::font::Os2 m_os2;
+    details::font::GlyphData m_glyf;
+    GlyphId m_default_glyph     = details::font::missig_glyph_id;
+    Font::QualityType m_quality = 1;
+    std::unique_ptr<GlyphCache> m_cache;
+    GlyphAtlas m_atlas;
+    std::uint64_t m_generation = 0;
+};
+
+} // namespace framework::graphics
+
+#endif
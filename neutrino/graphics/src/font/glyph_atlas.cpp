@@ -0,0 +1,174 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <graphics/src/font/distance_field.hpp>
+#include <graphics/src/font/glyph_atlas.hpp>
+
+namespace
+{
+using framework::graphics::Font;
+using framework::graphics::PixelFormat;
+
+// Empty pixels between the glyphs, so the filtering doesn't mix them.
+inline constexpr std::size_t glyph_spacing = 1;
+
+// New shelves are a bit taller than the glyph, so glyphs of slightly different heights share them.
+inline constexpr std::size_t shelf_height_step = 8;
+
+inline constexpr std::size_t min_atlas_height = 64;
+
+PixelFormat atlas_format(Font::DistanceField distance_field)
+{
+    switch (distance_field) {
+        case Font::DistanceField::single_channel: return PixelFormat::r8;
+        case Font::DistanceField::multi_channel:  return PixelFormat::rgb8;
+    }
+
+    return PixelFormat::r8;
+}
+
+std::size_t next_power_of_two(std::size_t value)
+{
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+
+    return result;
+}
+
+} // namespace
+
+namespace framework::graphics::details::font
+{
+
+GlyphAtlas::GlyphAtlas(const Font::AtlasOptions& options)
+    : m_options(options)
+{
+    m_options.glyph_size     = std::max<std::size_t>(m_options.glyph_size, 1);
+    m_options.distance_range = std::max(m_options.distance_range, 1.0f);
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::find(GlyphId id) const
+{
+    const auto it = m_glyphs.find(id);
+    return it != m_glyphs.end() ? &it->second : nullptr;
+}
+
+const GlyphAtlas::Glyph& GlyphAtlas::add(GlyphId id, const GlyphData::Contours& contours, std::uint16_t units_per_em)
+{
+    if (const Glyph* glyph = find(id)) {
+        return *glyph;
+    }
+
+    math::Vector2f min(std::numeric_limits<float>::max());
+    math::Vector2f max(std::numeric_limits<float>::lowest());
+    for (const auto& contour : contours) {
+        for (const auto& point : contour) {
+            min = math::min(min, point.position);
+            max = math::max(max, point.position);
+        }
+    }
+
+    Glyph& glyph = m_glyphs[id];
+    if (min.x >= max.x || min.y >= max.y) {
+        return glyph;
+    }
+
+    // Control points bound the curves, so the glyph fits the box with the encoded distances around.
+    const float scale        = static_cast<float>(m_options.glyph_size) / units_per_em;
+    const auto padding       = static_cast<float>(std::ceil(m_options.distance_range / 2.0f) + 1.0f);
+    const float left         = std::floor(min.x * scale) - padding;
+    const float bottom       = std::floor(min.y * scale) - padding;
+    const float right        = std::ceil(max.x * scale) + padding;
+    const float top          = std::ceil(max.y * scale) + padding;
+    const std::size_t width  = static_cast<std::size_t>(right - left);
+    const std::size_t height = static_cast<std::size_t>(top - bottom);
+
+    allocate(width, height, glyph);
+
+    const std::size_t pixel_size = bytes_per_pixel(m_image.format());
+
+    DistanceFieldBitmap bitmap;
+    bitmap.data           = m_image.bytes().data() + (glyph.y * m_image.width() + glyph.x) * pixel_size;
+    bitmap.width          = width;
+    bitmap.height         = height;
+    bitmap.stride         = m_image.width() * pixel_size;
+    bitmap.channels_count = pixel_size;
+
+    const math::Vector2f origin(left / scale, bottom / scale);
+    generate_distance_field(contours, origin, scale, m_options.distance_range, bitmap);
+
+    const float pixels_per_em = static_cast<float>(m_options.glyph_size);
+    glyph.plane_min           = math::Vector2f(left, bottom) / pixels_per_em;
+    glyph.plane_max           = math::Vector2f(right, top) / pixels_per_em;
+
+    return glyph;
+}
+
+const Image& GlyphAtlas::image() const
+{
+    return m_image;
+}
+
+const Font::AtlasOptions& GlyphAtlas::options() const
+{
+    return m_options;
+}
+
+void GlyphAtlas::allocate(std::size_t width, std::size_t height, Glyph& glyph)
+{
+    const std::size_t cell_width  = width + glyph_spacing;
+    const std::size_t cell_height = height + glyph_spacing;
+
+    if (cell_width > m_options.width) {
+        throw std::runtime_error("Glyph is wider than the atlas. Increase the atlas width or reduce the glyph size.");
+    }
+
+    // The lowest shelf the glyph fits.
+    Shelf* best = nullptr;
+    for (auto& shelf : m_shelves) {
+        const bool fits = shelf.height >= cell_height && shelf.width + cell_width <= m_options.width;
+        if (fits && (best == nullptr || shelf.height < best->height)) {
+            best = &shelf;
+        }
+    }
+
+    if (best == nullptr) {
+        const std::size_t y            = m_shelves.empty() ? 0 : m_shelves.back().y + m_shelves.back().height;
+        const std::size_t shelf_height = (cell_height + shelf_height_step - 1) / shelf_height_step * shelf_height_step;
+        if (y + shelf_height > m_image.height()) {
+            grow(y + shelf_height);
+        }
+
+        m_shelves.push_back({y, shelf_height, 0});
+        best = &m_shelves.back();
+    }
+
+    glyph.x      = best->width;
+    glyph.y      = best->y;
+    glyph.width  = width;
+    glyph.height = height;
+
+    best->width += cell_width;
+}
+
+// Rows are stored from the bottom, so the glyphs keep their pixel positions in the taller image.
+void GlyphAtlas::grow(std::size_t min_height)
+{
+    const std::size_t height = std::max({next_power_of_two(min_height), m_image.height() * 2, min_atlas_height});
+
+    Image image(m_options.width, height, atlas_format(m_options.distance_field));
+    image.set_gamma(1.0f);
+
+    if (!m_image.bytes().empty()) {
+        std::memcpy(image.bytes().data(), m_image.bytes().data(), m_image.bytes().size());
+    }
+
+    m_image = std::move(image);
+}
+
+} // namespace framework::graphics::details::font
@@ -0,0 +1,64 @@
+#ifndef GRAPHICS_SRC_FONT_GLYPH_ATLAS_HPP
+#define GRAPHICS_SRC_FONT_GLYPH_ATLAS_HPP
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <graphics/font.hpp>
+#include <graphics/image.hpp>
+#include <math/math.hpp>
+
+#include <graphics/src/font/tables/glyph_data.hpp>
+#include <graphics/src/font/types.hpp>
+
+namespace framework::graphics::details::font
+{
+
+// Distance fields of glyphs packed into rows of the atlas image.
+class GlyphAtlas final
+{
+public:
+    struct Glyph
+    {
+        // Quad of the glyph in em units, relative to the pen position.
+        math::Vector2f plane_min;
+        math::Vector2f plane_max;
+
+        // Pixels of the atlas, counted from the bottom left corner. Glyphs without outline have zero size.
+        std::size_t x      = 0;
+        std::size_t y      = 0;
+        std::size_t width  = 0;
+        std::size_t height = 0;
+    };
+
+    explicit GlyphAtlas(const Font::AtlasOptions& options);
+
+    const Glyph* find(GlyphId id) const;
+
+    const Glyph& add(GlyphId id, const GlyphData::Contours& contours, std::uint16_t units_per_em);
+
+    const Image& image() const;
+    const Font::AtlasOptions& options() const;
+
+private:
+    // Row of glyphs, glyphs are placed from left to right.
+    struct Shelf
+    {
+        std::size_t y      = 0;
+        std::size_t height = 0;
+        std::size_t width  = 0;
+    };
+
+    void allocate(std::size_t width, std::size_t height, Glyph& glyph);
+    void grow(std::size_t min_height);
+
+    Font::AtlasOptions m_options;
+    Image m_image;
+    std::vector<Shelf> m_shelves;
+    std::unordered_map<GlyphId, Glyph> m_glyphs;
+};
+
+} // namespace framework::graphics::details::font
+
+#endif
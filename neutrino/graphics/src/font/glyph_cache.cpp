@@ -0,0 +1,131 @@
+#include <exception>
+
+#include <graphics/src/font/glyph_cache.hpp>
+
+namespace
+{
+using framework::graphics::details::font::GlyphMeshData;
+
+std::size_t memory_size(const GlyphMeshData& glyph)
+{
+    std::size_t size = sizeof(GlyphMeshData) + glyph.vertices.capacity() * sizeof(glyph.vertices[0]) +
+                       glyph.submeshes.capacity() * sizeof(glyph.submeshes[0]);
+
+    for (const auto& submesh : glyph.submeshes) {
+        size += submesh.indices.capacity() * sizeof(submesh.indices[0]);
+    }
+
+    return size;
+}
+
+} // namespace
+
+namespace framework::graphics::details::font
+{
+
+GlyphCache::GlyphCache(std::size_t capacity)
+    : m_capacity(capacity)
+{}
+
+GlyphCache::GlyphPointer GlyphCache::get(GlyphId id, const Generator& generate)
+{
+    std::promise<GlyphPointer> promise;
+
+    {
+        std::unique_lock lock(m_mutex);
+
+        const auto it = m_entries.find(id);
+        if (it != m_entries.end()) {
+            ++m_statistics.hits;
+            m_order.splice(m_order.begin(), m_order, it->second.position);
+
+            const std::shared_future<GlyphPointer> glyph = it->second.glyph;
+            lock.unlock();
+
+            return glyph.get();
+        }
+
+        ++m_statistics.misses;
+        m_order.push_front(id);
+        m_entries.emplace(id, Entry{promise.get_future().share(), m_order.begin(), 0, &promise});
+    }
+
+    // The entry could be evicted or replaced while the glyph is generated, the owner tells if it's still ours.
+    auto find_own_entry = [this, id, &promise]() {
+        const auto it = m_entries.find(id);
+        return it != m_entries.end() && it->second.owner == &promise ? it : m_entries.end();
+    };
+
+    GlyphPointer glyph;
+    try {
+        glyph = std::make_shared<const GlyphMeshData>(generate(id));
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+
+        std::lock_guard lock(m_mutex);
+        if (const auto it = find_own_entry(); it != m_entries.end()) {
+            m_order.erase(it->second.position);
+            m_entries.erase(it);
+        }
+
+        throw;
+    }
+
+    promise.set_value(glyph);
+
+    std::lock_guard lock(m_mutex);
+    if (const auto it = find_own_entry(); it != m_entries.end()) {
+        it->second.size  = memory_size(*glyph);
+        it->second.owner = nullptr;
+
+        m_statistics.size += it->second.size;
+        m_statistics.glyphs_count++;
+
+        evict();
+    }
+
+    return glyph;
+}
+
+void GlyphCache::set_capacity(std::size_t capacity)
+{
+    std::lock_guard lock(m_mutex);
+
+    m_capacity = capacity;
+    evict();
+}
+
+std::size_t GlyphCache::capacity() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_capacity;
+}
+
+Font::CacheStatistics GlyphCache::statistics() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_statistics;
+}
+
+// Glyphs that are being generated have no size yet, so they are left in the cache.
+void GlyphCache::evict()
+{
+    auto it = m_order.end();
+    while (m_statistics.size > m_capacity && it != m_order.begin()) {
+        --it;
+
+        const auto entry = m_entries.find(*it);
+        if (entry->second.owner != nullptr) {
+            continue;
+        }
+
+        m_statistics.size -= entry->second.size;
+        m_statistics.glyphs_count--;
+        m_statistics.evictions++;
+
+        m_entries.erase(entry);
+        it = m_order.erase(it);
+    }
+}
+
+} // namespace framework::graphics::details::font
@@ -0,0 +1,68 @@
+#ifndef GRAPHICS_SRC_FONT_GLYPH_CACHE_HPP
+#define GRAPHICS_SRC_FONT_GLYPH_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <graphics/font.hpp>
+#include <graphics/mesh.hpp>
+
+#include <graphics/src/font/types.hpp>
+
+namespace framework::graphics::details::font
+{
+
+struct GlyphMeshData
+{
+    Mesh::VertexData vertices;
+    std::vector<Mesh::SubMesh> submeshes;
+    float advance_step = 1.0;
+};
+
+// Glyph meshes with the least recently used ones evicted to fit the capacity in bytes.
+//
+// Missing glyphs are generated out of the lock, so different glyphs are generated in parallel.
+// Threads requesting the glyph that is being generated wait for it.
+class GlyphCache final
+{
+public:
+    using GlyphPointer = std::shared_ptr<const GlyphMeshData>;
+    using Generator    = std::function<GlyphMeshData(GlyphId)>;
+
+    explicit GlyphCache(std::size_t capacity);
+
+    // Returned glyph stays valid even if it's evicted.
+    GlyphPointer get(GlyphId id, const Generator& generate);
+
+    void set_capacity(std::size_t capacity);
+    std::size_t capacity() const;
+
+    Font::CacheStatistics statistics() const;
+
+private:
+    struct Entry
+    {
+        std::shared_future<GlyphPointer> glyph;
+        std::list<GlyphId>::iterator position;
+        std::size_t size  = 0;
+        const void* owner = nullptr; // Generating thread, null if the glyph is ready.
+    };
+
+    void evict();
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<GlyphId, Entry> m_entries;
+    std::list<GlyphId> m_order; // The most recently used glyphs go first.
+    std::size_t m_capacity = 0;
+    Font::CacheStatistics m_statistics;
+};
+
+} // namespace framework::graphics::details::font
+
+#endif
@@ -1,3 +1,5 @@
+#include <algorithm>
+#include <limits>
 #include <set>
 
 #include <common/exceptions.hpp>
@@ -35,6 +37,12 @@ public:
     virtual void parse(std::uint32_t offset, const BytesData& data) = 0;
     virtual GlyphId glyph_index(CodePoint codepoint) const          = 0;
 
+    // Ranges of the code points, which can be mapped to glyphs. Both ends are included.
+    virtual std::vector<std::pair<CodePoint, CodePoint>> ranges() const
+    {
+        return {};
+    }
+
     virtual bool is_valid() const                  = 0;
     virtual std::unique_ptr<Subtable> copy() const = 0;
 };
@@ -46,6 +54,7 @@ class SubtableFormat4 final : public Subtable
 public:
     void parse(std::uint32_t offset, const BytesData& data) override;
     GlyphId glyph_index(CodePoint codepoint) const override;
+    std::vector<std::pair<CodePoint, CodePoint>> ranges() const override;
 
     bool is_valid() const override;
     std::unique_ptr<Subtable> copy() const override;
@@ -151,7 +160,7 @@ GlyphId SubtableFormat4::glyph_index(CodePoint codepoint) const
 
     //  glyphId = *(idRangeOffset[i]/2 + (c - startCode[i])  + &idRangeOffset[i])
     const std::uint16_t glyph_id_index = offset_in_glyph_id_array + start_code_offset;
-    if (glyph_id_index > m_glyph_id_array.size()) {
+    if (glyph_id_index >= m_glyph_id_array.size()) {
         return missig_glyph_id;
     }
 
@@ -164,6 +173,20 @@ GlyphId SubtableFormat4::glyph_index(CodePoint codepoint) const
     return static_cast<GlyphId>((static_cast<std::int32_t>(glyph_id) + id_delta) & 0xffff);
 }
 
+std::vector<std::pair<CodePoint, CodePoint>> SubtableFormat4::ranges() const
+{
+    std::vector<std::pair<CodePoint, CodePoint>> ranges;
+    ranges.reserve(m_start_code.size());
+
+    for (std::size_t i = 0; i < std::min(m_start_code.size(), m_end_code.size()); ++i) {
+        if (m_start_code[i] <= m_end_code[i]) {
+            ranges.emplace_back(m_start_code[i], m_end_code[i]);
+        }
+    }
+
+    return ranges;
+}
+
 bool SubtableFormat4::is_valid() const
 {
     const size_t seg_count = m_seg_count_x2 / 2;
@@ -269,24 +292,93 @@ class SubtableFormat12 final : public Subtable
 public:
     void parse(std::uint32_t offset, const BytesData& data) override;
     GlyphId glyph_index(CodePoint codepoint) const override;
+    std::vector<std::pair<CodePoint, CodePoint>> ranges() const override;
 
     bool is_valid() const override;
     std::unique_ptr<Subtable> copy() const override;
+
+private:
+    struct SequentialMapGroup
+    {
+        std::uint32_t start_char_code = 0;
+        std::uint32_t end_char_code   = 0;
+        std::uint32_t start_glyph_id  = 0;
+    };
+
+    std::uint16_t m_format     = 0;
+    std::uint16_t m_reserved   = 0;
+    std::uint32_t m_length     = 0;
+    std::uint32_t m_language   = 0;
+    std::uint32_t m_num_groups = 0;
+    std::vector<SequentialMapGroup> m_groups; //[numgroups]
 };
 
-void SubtableFormat12::parse(std::uint32_t, const BytesData&)
+void SubtableFormat12::parse(std::uint32_t offset, const BytesData& data)
+{
+    static constexpr std::size_t group_size = 12;
+
+    const auto from = std::next(data.begin(), offset);
+    BufferReader in = utils::make_big_endian_buffer_reader(from, data.end());
+
+    in >> m_format;
+    in >> m_reserved;
+    in >> m_length;
+    in >> m_language;
+    in >> m_num_groups;
+
+    // Groups count is not trusted, the groups should fit in the table data.
+    const auto bytes_left = static_cast<std::size_t>(std::distance(in.current(), in.end()));
+    if (bytes_left / group_size < m_num_groups) {
+        return;
+    }
+
+    m_groups.reserve(m_num_groups);
+    for (std::uint32_t i = 0; i < m_num_groups; ++i) {
+        SequentialMapGroup group;
+        in >> group.start_char_code;
+        in >> group.end_char_code;
+        in >> group.start_glyph_id;
+
+        m_groups.push_back(group);
+    }
+}
+
+GlyphId SubtableFormat12::glyph_index(CodePoint codepoint) const
 {
-    throw NotImplementedError("SubtableFormat12 parsing is not implemented yet");
+    // Groups are sorted by the start code, and don't overlap.
+    auto it = std::lower_bound(m_groups.begin(),
+                               m_groups.end(),
+                               codepoint,
+                               [](const SequentialMapGroup& group, CodePoint c) { return group.end_char_code < c; });
+    if (it == m_groups.end() || it->start_char_code > codepoint) {
+        return missig_glyph_id;
+    }
+
+    const std::uint64_t glyph_id = std::uint64_t{it->start_glyph_id} + (codepoint - it->start_char_code);
+    if (glyph_id > std::numeric_limits<GlyphId>::max()) {
+        return missig_glyph_id;
+    }
+
+    return static_cast<GlyphId>(glyph_id);
 }
 
-GlyphId SubtableFormat12::glyph_index(CodePoint) const
+std::vector<std::pair<CodePoint, CodePoint>> SubtableFormat12::ranges() const
 {
-    throw NotImplementedError("SubtableFormat12 glyph_index is not implemented yet");
+    std::vector<std::pair<CodePoint, CodePoint>> ranges;
+    ranges.reserve(m_groups.size());
+
+    for (const auto& group : m_groups) {
+        if (group.start_char_code <= group.end_char_code) {
+            ranges.emplace_back(group.start_char_code, group.end_char_code);
+        }
+    }
+
+    return ranges;
 }
 
 bool SubtableFormat12::is_valid() const
 {
-    return false;
+    return m_format == 12 && m_groups.size() == m_num_groups;
 }
 
 std::unique_ptr<Subtable> SubtableFormat12::copy() const
@@ -422,18 +514,29 @@ std::unique_ptr<Subtable> parse_subtable(const std::vector<EncodingRecord>& enco
         return nullptr;
     };
 
-    for (const auto& record : encoding_records) {
-        const auto from      = std::next(data.begin(), record.offset);
-        std::uint16_t format = utils::big_endian_value<std::uint16_t>(from);
+    auto format_of = [&data](const EncodingRecord& record) {
+        return utils::big_endian_value<std::uint16_t>(std::next(data.begin(), record.offset));
+    };
 
-        auto subtable = create_subtable(format);
-        if (subtable) {
-            subtable->parse(record.offset, data);
-            return subtable;
-        }
+    // Format 12 maps all Unicode planes, so it is preferred over the BMP only subtables.
+    auto record = std::find_if(encoding_records.begin(), encoding_records.end(), [&format_of](const auto& r) {
+        return format_of(r) == 12;
+    });
+
+    if (record == encoding_records.end()) {
+        record = std::find_if(encoding_records.begin(), encoding_records.end(), [&](const auto& r) {
+            return create_subtable(format_of(r)) != nullptr;
+        });
     }
 
-    return nullptr;
+    if (record == encoding_records.end()) {
+        return nullptr;
+    }
+
+    auto subtable = create_subtable(format_of(*record));
+    subtable->parse(record->offset, data);
+
+    return subtable;
 }
 
 #pragma endregion
@@ -452,11 +555,15 @@ CharacterToGlyphIndexMapping::CharacterToGlyphIndexMapping(const BytesData& data
 
     m_version  = version;
     m_subtable = parse_subtable(unicode_encoding_records, data);
+
+    build_pages();
 }
 
 CharacterToGlyphIndexMapping::CharacterToGlyphIndexMapping(const CharacterToGlyphIndexMapping& other)
     : m_version(other.m_version)
     , m_subtable(other.m_subtable->copy())
+    , m_page_offsets(other.m_page_offsets)
+    , m_pages(other.m_pages)
 {}
 
 CharacterToGlyphIndexMapping::CharacterToGlyphIndexMapping(CharacterToGlyphIndexMapping&& other) = default;
@@ -471,6 +578,8 @@ CharacterToGlyphIndexMapping& CharacterToGlyphIndexMapping::operator=(const Char
 
     swap(tmp.m_version, m_version);
     swap(tmp.m_subtable, m_subtable);
+    swap(tmp.m_page_offsets, m_page_offsets);
+    swap(tmp.m_pages, m_pages);
 
     return *this;
 }
@@ -482,13 +591,40 @@ bool CharacterToGlyphIndexMapping::is_valid() const
     return m_version == 0 && m_subtable != nullptr && m_subtable->is_valid();
 }
 
-GlyphId CharacterToGlyphIndexMapping::glyph_index(CodePoint codepoint) const
+// No branches, so the loop can be vectorized.
+void CharacterToGlyphIndexMapping::glyph_indices(Span<const CodePoint> codepoints, Span<GlyphId> glyph_ids) const
+{
+    const std::size_t count = std::min(codepoints.size(), glyph_ids.size());
+    for (std::size_t i = 0; i < count; ++i) {
+        glyph_ids[i] = glyph_index(codepoints[i]);
+    }
+}
+
+void CharacterToGlyphIndexMapping::build_pages()
 {
-    if (m_subtable) {
-        return m_subtable->glyph_index(codepoint);
+    m_page_offsets.assign(pages_count, 0);
+    m_pages.assign(page_size, missig_glyph_id);
+
+    if (m_subtable == nullptr || !m_subtable->is_valid()) {
+        return;
     }
 
-    return missig_glyph_id;
+    for (const auto& [first, last] : m_subtable->ranges()) {
+        for (CodePoint codepoint = first; codepoint <= std::min(last, max_codepoint); ++codepoint) {
+            const GlyphId id = m_subtable->glyph_index(codepoint);
+            if (id == missig_glyph_id) {
+                continue;
+            }
+
+            std::uint32_t& offset = m_page_offsets[codepoint >> page_bits];
+            if (offset == 0) {
+                offset = static_cast<std::uint32_t>(m_pages.size());
+                m_pages.resize(m_pages.size() + page_size, missig_glyph_id);
+            }
+
+            m_pages[offset + (codepoint & (page_size - 1))] = id;
+        }
+    }
 }
 
 } // namespace framework::graphics::details::font
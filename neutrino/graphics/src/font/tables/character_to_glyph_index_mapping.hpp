@@ -1,7 +1,9 @@
 #ifndef GRAPHICS_SRC_FONT_TABLES_CHARACTER_TO_GLYPH_INDEX_MAPPING_HPP
 #define GRAPHICS_SRC_FONT_TABLES_CHARACTER_TO_GLYPH_INDEX_MAPPING_HPP
 
-#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <memory>
 #include <vector>
 
 #include <graphics/src/font/types.hpp>
@@ -28,11 +30,39 @@ public:
 
     GlyphId glyph_index(CodePoint codepoint) const;
 
+    // Code points out of the Unicode range are mapped to missig_glyph_id.
+    void glyph_indices(Span<const CodePoint> codepoints, Span<GlyphId> glyph_ids) const;
+
 private:
+    static constexpr CodePoint max_codepoint = 0x10FFFF;
+
+    // Code points are split into pages, the last page is for the code points out of the Unicode range.
+    static constexpr std::size_t page_bits   = 8;
+    static constexpr std::size_t page_size   = std::size_t(1) << page_bits;
+    static constexpr std::size_t pages_count = (max_codepoint >> page_bits) + 2;
+
+    void build_pages();
+
+    std::size_t page_offset(CodePoint codepoint) const;
+
     std::uint16_t m_version = 0;
     std::unique_ptr<Subtable> m_subtable;
+
+    // Glyph ids of code points, mapped at loading. Pages without glyphs share the empty page at the beginning.
+    std::vector<std::uint32_t> m_page_offsets;
+    std::vector<GlyphId> m_pages;
 };
 
+inline std::size_t CharacterToGlyphIndexMapping::page_offset(CodePoint codepoint) const
+{
+    return m_page_offsets[std::min<std::size_t>(codepoint >> page_bits, pages_count - 1)];
+}
+
+inline GlyphId CharacterToGlyphIndexMapping::glyph_index(CodePoint codepoint) const
+{
+    return m_pages[page_offset(codepoint) + (codepoint & (page_size - 1))];
+}
+
 } // namespace framework::graphics::details::font
 
 #endif
@@ -1,4 +1,5 @@
-#include <optional>
+#include <algorithm>
+#include <stdexcept>
 
 #include <common/exceptions.hpp>
 #include <common/utils.hpp>
@@ -138,8 +139,17 @@ struct CompositeGlyph
     std::vector<std::uint8_t> instructions; // [instruction_length]
 };
 
-using SimpleGlyphMap    = std::unordered_map<GlyphId, SimpleGlyph>;
-using CompositeGlyphMap = std::unordered_map<GlyphId, CompositeGlyph>;
+// Composite glyphs can be made of other composite glyphs. Malformed fonts can have cycles of components,
+// or reuse components so many times that decoding takes exponential time, so both are limited.
+inline constexpr std::size_t max_composite_depth      = 32;
+inline constexpr std::size_t max_composite_components = 1024;
+
+// Glyphs on the path from the decoded glyph to the current component.
+struct CompositePath
+{
+    std::vector<GlyphId> glyphs;
+    std::size_t components_count = 0;
+};
 
 std::vector<std::uint8_t> parse_flags(const std::uint16_t points_count, BufferReader& in)
 {
@@ -443,89 +453,102 @@ void add_component_data(SimpleGlyph& new_glyph,
     }
 }
 
-std::optional<SimpleGlyph> convert_composite_glyph(const CompositeGlyph& glyph, const SimpleGlyphMap& simple_glyphs)
+SimpleGlyph read_glyph(GlyphId id,
+                       const std::vector<Offset32>& offsets,
+                       const details::BytesData& data,
+                       CompositePath& path)
 {
-    SimpleGlyph new_glyph;
+    if (path.glyphs.size() > max_composite_depth) {
+        throw ParsingError("Composite glyphs nesting is too deep.");
+    }
 
-    for (const auto& component : glyph.components) {
-        const auto& component_glyph = simple_glyphs.find(component.glyph_index);
-        if (component_glyph == simple_glyphs.end()) {
-            return std::nullopt;
-        }
-        add_component_data(new_glyph, component, component_glyph->second);
+    if (std::find(path.glyphs.begin(), path.glyphs.end(), id) != path.glyphs.end()) {
+        throw ParsingError("Composite glyph refers to itself.");
     }
 
-    if (!new_glyph.end_pts_of_contours.empty()) {
-        check_simple_glyph(new_glyph);
+    if (static_cast<std::size_t>(id) + 1 >= offsets.size()) {
+        throw ParsingError("Glyph index is out of the glyphs range.");
     }
 
-    return {new_glyph};
-}
+    const DataIterator begin = std::next(data.begin(), offsets[id]);
+    const DataIterator end   = std::next(data.begin(), offsets[id + 1u]);
 
-} // namespace
+    BufferReader in = framework::utils::make_big_endian_buffer_reader(begin, end);
+    if (!in) {
+        // Glyph has no outline, e.g. some space character
+        return SimpleGlyph{};
+    }
 
-namespace framework::graphics::details::font
-{
+    const GlyphHeader header(in);
+    if (header.number_of_contours >= 0) {
+        return parse_simple_glyph(static_cast<size_t>(header.number_of_contours), in);
+    }
 
-GlyphData::GlyphData(std::uint16_t num_glyphs, const std::vector<Offset32>& offsets, const BytesData& data)
-{
-    m_glyphs.reserve(num_glyphs);
+    const CompositeGlyph glyph = parse_composite_glyph(in);
 
-    SimpleGlyphMap simple_glyphs;
-    CompositeGlyphMap composite_glyphs;
+    path.components_count += glyph.components.size();
+    if (path.components_count > max_composite_components) {
+        throw ParsingError("Composite glyph has too many components.");
+    }
 
-    for (GlyphId id = 0; id < num_glyphs; ++id) {
-        DataIterator begin = std::next(data.begin(), offsets[id]);
-        DataIterator end   = std::next(data.begin(), offsets[id + 1u]);
+    path.glyphs.push_back(id);
 
-        BufferReader in = utils::make_big_endian_buffer_reader(begin, end);
-        if (in) {
-            const GlyphHeader header(in);
-            if (header.number_of_contours >= 0) {
-                simple_glyphs.emplace(id, parse_simple_glyph(static_cast<size_t>(header.number_of_contours), in));
-            } else {
-                composite_glyphs.emplace(id, parse_composite_glyph(in));
-            }
-        } else {
-            // Glyph has no outline, e.g. some space character
-            simple_glyphs.emplace(id, SimpleGlyph{});
-        }
+    SimpleGlyph new_glyph;
+    for (const auto& component : glyph.components) {
+        add_component_data(new_glyph, component, read_glyph(component.glyph_index, offsets, data, path));
     }
 
-    for (int counter = 0; counter < 32 && !composite_glyphs.empty(); ++counter) {
-        for (auto it = composite_glyphs.begin(); it != composite_glyphs.end();) {
-            const auto res = convert_composite_glyph(it->second, simple_glyphs);
-            if (res.has_value()) {
-                simple_glyphs.emplace(it->first, res.value());
-                it = composite_glyphs.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    }
+    path.glyphs.pop_back();
 
-    if (!composite_glyphs.empty()) {
-        throw ParsingError("All composite glyphs must be converted to simple glyphs.");
+    if (!new_glyph.end_pts_of_contours.empty()) {
+        check_simple_glyph(new_glyph);
     }
 
-    for (const auto& [id, simple_glyph] : simple_glyphs) {
-        m_glyphs.emplace(id, get_glyph_contours(simple_glyph));
+    return new_glyph;
+}
+
+} // namespace
+
+namespace framework::graphics::details::font
+{
+
+GlyphData::GlyphData(std::uint16_t num_glyphs,
+                     std::vector<Offset32> offsets,
+                     const BytesData& data,
+                     std::shared_ptr<const void> storage)
+    : m_num_glyphs(num_glyphs)
+    , m_offsets(std::move(offsets))
+    , m_data(data)
+    , m_storage(std::move(storage))
+{
+    if (m_storage == nullptr) {
+        auto copy = std::make_shared<const std::vector<std::uint8_t>>(data.begin(), data.end());
+        m_data    = BytesData(copy->data(), copy->size());
+        m_storage = std::move(copy);
     }
 }
 
 bool GlyphData::is_valid() const
 {
-    return !m_glyphs.empty();
+    const bool offsets_valid = m_offsets.size() == m_num_glyphs + 1u &&
+                               std::is_sorted(m_offsets.begin(), m_offsets.end()) && m_offsets.back() <= m_data.size();
+
+    return m_num_glyphs > 0 && offsets_valid;
 }
 
 bool GlyphData::has(GlyphId index) const
 {
-    return m_glyphs.count(index) != 0;
+    return index < m_num_glyphs;
 }
 
-const GlyphData::Contours& GlyphData::at(GlyphId index) const
+GlyphData::Contours GlyphData::at(GlyphId index) const
 {
-    return m_glyphs.at(index);
+    if (!has(index)) {
+        throw std::out_of_range("GlyphData::at: Glyph index is out of the glyphs range.");
+    }
+
+    CompositePath path;
+    return get_glyph_contours(read_glyph(index, m_offsets, m_data, path));
 }
 
 } // namespace framework::graphics::details::font
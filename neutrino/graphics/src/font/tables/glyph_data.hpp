@@ -1,7 +1,7 @@
 #ifndef GRAPHICS_SRC_FONT_TABLES_GLYPH_DATA_HPP
 #define GRAPHICS_SRC_FONT_TABLES_GLYPH_DATA_HPP
 
-#include <unordered_map>
+#include <memory>
 #include <vector>
 
 #include <math/math.hpp>
@@ -23,15 +23,25 @@ public:
     using ContourType = std::vector<ControlPoint>;
     using Contours    = std::vector<ContourType>;
 
-    GlyphData(std::uint16_t num_glyphs, const std::vector<Offset32>& offsets, const BytesData& data);
+    // Outlines are decoded on request, so the data must stay valid while the storage is alive.
+    // Without the storage the data is copied.
+    GlyphData(std::uint16_t num_glyphs,
+              std::vector<Offset32> offsets,
+              const BytesData& data,
+              std::shared_ptr<const void> storage = nullptr);
 
     bool is_valid() const;
 
     bool has(GlyphId index) const;
-    const Contours& at(GlyphId index) const;
+
+    // Throws ParsingError or NotImplementedError if the glyph can't be decoded.
+    Contours at(GlyphId index) const;
 
 private:
-    std::unordered_map<GlyphId, Contours> m_glyphs;
+    std::uint16_t m_num_glyphs = 0;
+    std::vector<Offset32> m_offsets; // Glyph data offsets from the loca table, [num_glyphs + 1]
+    BytesData m_data;
+    std::shared_ptr<const void> m_storage;
 };
 
 } // namespace framework::graphics::details::font
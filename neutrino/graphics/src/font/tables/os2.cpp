@@ -82,4 +82,19 @@ std::uint16_t Os2::default_char() const
     return m_default_char;
 }
 
+std::int16_t Os2::typo_ascender() const
+{
+    return m_typo_ascender;
+}
+
+std::int16_t Os2::typo_descender() const
+{
+    return m_typo_descender;
+}
+
+std::int16_t Os2::typo_line_gap() const
+{
+    return m_typo_linegap;
+}
+
 } // namespace framework::graphics::details::font
@@ -17,6 +17,10 @@ public:
 
     std::uint16_t default_char() const;
 
+    std::int16_t typo_ascender() const;
+    std::int16_t typo_descender() const;
+    std::int16_t typo_line_gap() const;
+
 private:
     std::uint16_t m_version             = 0;
     std::int16_t m_avg_char_width       = 0;
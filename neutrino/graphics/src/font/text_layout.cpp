@@ -0,0 +1,287 @@
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <common/utf.hpp>
+#include <graphics/text_layout.hpp>
+
+#include <graphics/src/font/font_data.hpp>
+
+namespace
+{
+
+std::vector<std::string> split_lines(const std::string& text)
+{
+    std::vector<std::string> lines;
+
+    std::string::size_type begin = 0;
+    std::string::size_type end   = text.find('\n');
+    while (end != std::string::npos) {
+        lines.push_back(text.substr(begin, end - begin));
+        begin = end + 1;
+        end   = text.find('\n', begin);
+    }
+
+    lines.push_back(text.substr(begin));
+
+    return lines;
+}
+
+} // namespace
+
+namespace framework::graphics
+{
+
+struct TextLayout::Line
+{
+    explicit Line(std::string line_text)
+        : text(std::move(line_text))
+    {}
+
+    std::string text;
+
+    // Glyphs are held, so they stay valid even if they are evicted from the font cache.
+    std::vector<Font::FontData::GlyphPointer> glyphs;
+    bool shaped = false;
+
+    std::size_t vertices_count = 0;
+    std::size_t indices_count  = 0;
+
+    // Position in the mesh, valid for the lines before the first changed one.
+    std::size_t first_vertex = 0;
+    std::size_t first_index  = 0;
+};
+
+TextLayout::TextLayout(const Font& font)
+    : m_font(font)
+{}
+
+TextLayout::TextLayout(const TextLayout& other) = default;
+
+TextLayout::TextLayout(TextLayout&& other) noexcept = default;
+
+TextLayout::~TextLayout() = default;
+
+TextLayout& TextLayout::operator=(const TextLayout& other) = default;
+
+TextLayout& TextLayout::operator=(TextLayout&& other) noexcept = default;
+
+void TextLayout::set_text(const std::string& text)
+{
+    std::vector<std::string> lines = split_lines(text);
+
+    const std::size_t common_count = std::min(lines.size(), m_lines.size());
+
+    std::size_t first_changed = 0;
+    while (first_changed < common_count && lines[first_changed] == m_lines[first_changed].text) {
+        ++first_changed;
+    }
+
+    m_lines.erase(m_lines.begin() + static_cast<std::ptrdiff_t>(first_changed), m_lines.end());
+    for (std::size_t i = first_changed; i < lines.size(); ++i) {
+        m_lines.emplace_back(std::move(lines[i]));
+    }
+
+    invalidate(first_changed);
+}
+
+void TextLayout::set_line(std::size_t index, const std::string& text)
+{
+    m_lines.at(index) = Line(text);
+    invalidate(index);
+}
+
+void TextLayout::insert_line(std::size_t index, const std::string& text)
+{
+    if (index > m_lines.size()) {
+        throw std::out_of_range("TextLayout::insert_line: Line index is out of range.");
+    }
+
+    m_lines.emplace(m_lines.begin() + static_cast<std::ptrdiff_t>(index), text);
+    invalidate(index);
+}
+
+void TextLayout::append_line(const std::string& text)
+{
+    insert_line(m_lines.size(), text);
+}
+
+void TextLayout::erase_line(std::size_t index)
+{
+    if (index >= m_lines.size()) {
+        throw std::out_of_range("TextLayout::erase_line: Line index is out of range.");
+    }
+
+    m_lines.erase(m_lines.begin() + static_cast<std::ptrdiff_t>(index));
+    invalidate(index);
+}
+
+void TextLayout::clear()
+{
+    m_lines.clear();
+    invalidate(0);
+}
+
+std::size_t TextLayout::lines_count() const
+{
+    return m_lines.size();
+}
+
+const std::string& TextLayout::line(std::size_t index) const
+{
+    return m_lines.at(index).text;
+}
+
+std::string TextLayout::text() const
+{
+    std::string text;
+    for (std::size_t i = 0; i < m_lines.size(); ++i) {
+        if (i != 0) {
+            text.push_back('\n');
+        }
+
+        text += m_lines[i].text;
+    }
+
+    return text;
+}
+
+void TextLayout::set_line_spacing(float spacing)
+{
+    if (m_line_spacing != spacing) {
+        m_line_spacing = spacing;
+        invalidate(0);
+    }
+}
+
+float TextLayout::line_spacing() const
+{
+    return m_line_spacing;
+}
+
+TextLayout::Changes TextLayout::update()
+{
+    using IndicesDataType = Mesh::IndicesData::value_type;
+
+    const Font::FontData* font_data = m_font.get().m_data.get();
+    if (font_data == nullptr) {
+        throw std::runtime_error("Font data is not loaded. See Font::load.");
+    }
+
+    // Glyphs of the previous font data are not valid anymore. The new data can take the address of the freed one,
+    // so the generations are compared.
+    if (font_data->generation() != m_font_generation) {
+        m_font_generation = font_data->generation();
+
+        for (Line& line : m_lines) {
+            line.shaped = false;
+        }
+
+        invalidate(0);
+    }
+
+    const std::size_t first_line = std::min(m_first_changed_line, m_lines.size());
+
+    Changes changes;
+    if (first_line != 0) {
+        const Line& previous = m_lines[first_line - 1];
+        changes.first_vertex = previous.first_vertex + previous.vertices_count;
+        changes.first_index  = previous.first_index + previous.indices_count;
+    }
+
+    const bool unchanged = first_line == m_lines.size() && !m_mesh.submeshes().empty() &&
+                           m_mesh.vertices().size() == changes.first_vertex;
+    if (unchanged) {
+        return changes;
+    }
+
+    std::size_t vertices_count = changes.first_vertex;
+    std::size_t indices_count  = changes.first_index;
+
+    for (std::size_t i = first_line; i < m_lines.size(); ++i) {
+        Line& line = m_lines[i];
+
+        if (!line.shaped) {
+            line.glyphs.clear();
+            line.vertices_count = 0;
+            line.indices_count  = 0;
+
+            for (const auto glyph_id : font_data->glyph_indices(utf::to_codepoints(line.text))) {
+                line.glyphs.push_back(font_data->glyph(glyph_id));
+                line.vertices_count += line.glyphs.back()->vertices.size();
+
+                for (const auto& submesh : line.glyphs.back()->submeshes) {
+                    line.indices_count += submesh.indices.size();
+                }
+            }
+
+            line.shaped = true;
+        }
+
+        vertices_count += line.vertices_count;
+        indices_count += line.indices_count;
+    }
+
+    if (vertices_count > std::numeric_limits<IndicesDataType>::max()) {
+        throw std::runtime_error("TextLayout::update: Trying to add too many vertices to mesh.");
+    }
+
+    // Data of the unchanged lines stays in the mesh, only the changed tail is rebuilt.
+    if (m_mesh.m_submeshes.empty()) {
+        m_mesh.add_submesh(Mesh::IndicesData(), Mesh::PrimitiveType::triangles);
+    }
+
+    Mesh::VertexData& vertices = m_mesh.m_vertices;
+    vertices.erase(vertices.begin() + static_cast<std::ptrdiff_t>(changes.first_vertex), vertices.end());
+    vertices.reserve(vertices_count);
+
+    Mesh::IndicesData& indices = m_mesh.m_submeshes.begin()->second.indices;
+    indices.erase(indices.begin() + static_cast<std::ptrdiff_t>(changes.first_index), indices.end());
+    indices.reserve(indices_count);
+
+    const float spacing = m_line_spacing != 0.0f ? m_line_spacing : font_data->line_spacing();
+
+    for (std::size_t i = first_line; i < m_lines.size(); ++i) {
+        Line& line        = m_lines[i];
+        line.first_vertex = vertices.size();
+        line.first_index  = indices.size();
+
+        math::Vector3f offset(0.0f, -spacing * static_cast<float>(i), 0.0f);
+
+        for (const auto& glyph : line.glyphs) {
+            const auto indices_offset = static_cast<IndicesDataType>(vertices.size());
+
+            for (const auto& v : glyph->vertices) {
+                vertices.push_back(v + offset);
+            }
+
+            // Glyph outlines are triangulated, so all glyphs go to one triangles submesh.
+            for (const auto& submesh : glyph->submeshes) {
+                for (const auto& index : submesh.indices) {
+                    indices.push_back(index + indices_offset);
+                }
+            }
+
+            offset += math::Vector3f{glyph->advance_step, 0, 0};
+        }
+    }
+
+    m_first_changed_line = m_lines.size();
+
+    return changes;
+}
+
+const Mesh& TextLayout::mesh() const
+{
+    return m_mesh;
+}
+
+void TextLayout::invalidate(std::size_t first_line)
+{
+    m_first_changed_line = std::min(m_first_changed_line, first_line);
+}
+
+} // namespace framework::graphics
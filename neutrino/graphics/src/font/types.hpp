@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <vector>
 
+#include <common/span.hpp>
 #include <common/utf.hpp>
 #include <common/utils.hpp>
 
@@ -29,8 +30,8 @@ static inline constexpr GlyphId missig_glyph_id = 0;
 
 using utf::CodePoint;
 
-using BytesData    = std::vector<std::uint8_t>;
-using DataIterator = BytesData::const_iterator;
+using BytesData    = Span<const std::uint8_t>;
+using DataIterator = BytesData::Iterator;
 using BufferReader = utils::BigEndianBufferReader<DataIterator>;
 
 enum class PlatformId : std::uint16_t
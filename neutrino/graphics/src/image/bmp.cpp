@@ -1,14 +1,15 @@
 #include <algorithm>
 #include <cmath>
-#include <fstream>
-#include <memory>
+#include <type_traits>
 #include <vector>
 
 #include <common/exceptions.hpp>
+#include <common/span.hpp>
 #include <common/utils.hpp>
 #include <graphics/color.hpp>
 
 #include <graphics/src/image/bmp.hpp>
+#include <graphics/src/image/pixel_conversion.hpp>
 
 namespace
 {
@@ -16,12 +17,16 @@ using namespace framework;
 using graphics::Color;
 using graphics::details::image::ImageInfo;
 
+using BytesData = Span<const std::uint8_t>;
+
 //  | signature | file size | reserved | reserved | pixel array offset |
 //  |------------------------------------------------------------------|
 //  | 2         | 4         | 2        | 2        | 4                  |
 struct FileHeader
 {
-    static FileHeader read(std::ifstream& in);
+    static constexpr std::size_t size = 14;
+
+    static FileHeader read(BytesData in);
 
     bool is_valid() const;
 
@@ -30,20 +35,17 @@ struct FileHeader
     std::uint32_t pixel_array_offset = 0;
 };
 
-FileHeader FileHeader::read(std::ifstream& in)
+FileHeader FileHeader::read(BytesData in)
 {
-    using std::begin;
-    using std::end;
-
-    constexpr size_t size = 14;
+    FileHeader header;
 
-    char buffer[size] = {0};
-    in.read(buffer, size);
+    if (in.size() < size) {
+        return header;
+    }
 
-    FileHeader header;
-    header.signature          = utils::little_endian_value<std::uint16_t>(begin(buffer));
-    header.file_size          = utils::little_endian_value<std::uint32_t>(begin(buffer) + 2);
-    header.pixel_array_offset = utils::little_endian_value<std::uint32_t>(begin(buffer) + 10);
+    header.signature          = utils::little_endian_value<std::uint16_t>(in.begin());
+    header.file_size          = utils::little_endian_value<std::uint32_t>(in.begin() + 2);
+    header.pixel_array_offset = utils::little_endian_value<std::uint32_t>(in.begin() + 10);
 
     return header;
 }
@@ -99,8 +101,8 @@ struct InfoHeader
 
     using ColorTable = std::vector<Color>;
 
-    static InfoHeader read(std::ifstream& in);
-    static ColorTable read_color_table(std::ifstream& in, const InfoHeader& info);
+    static InfoHeader read(BytesData in);
+    static ColorTable read_color_table(BytesData in, const InfoHeader& info);
 
     bool is_valid() const;
 
@@ -283,105 +285,117 @@ inline std::tuple<std::uint32_t, std::uint32_t, std::uint32_t, std::uint32_t> In
     return std::make_tuple(0, 0, 0, 0);
 }
 
-InfoHeader InfoHeader::read(std::ifstream& in)
+// Reads header, the bit masks which follow it and color table. Input starts right after the file header.
+// Truncated header is returned as undefined one.
+InfoHeader InfoHeader::read(BytesData in)
 {
-    using std::begin;
-    using std::end;
+    constexpr std::size_t size_field_size = sizeof(std::uint32_t);
 
-    char size_buffer[4];
-    in.read(size_buffer, sizeof(size_buffer));
+    if (in.size() < size_field_size) {
+        return InfoHeader();
+    }
 
     InfoHeader h;
-    h.size = utils::little_endian_value<std::uint32_t>(begin(size_buffer));
+    h.size = utils::little_endian_value<std::uint32_t>(in.begin());
+
+    if (h.type() == Type::undefined || in.size() < h.size) {
+        return InfoHeader();
+    }
 
-    const size_t data_size = h.size - sizeof(size_buffer);
-    std::unique_ptr<char[]> buffer(new char[data_size]);
-    in.read(buffer.get(), static_cast<std::streamsize>(data_size));
+    const std::uint8_t* buffer = in.data() + size_field_size;
+    BytesData tail             = in.subspan(h.size);
 
     if (h.type() == Type::bitmapcoreheader) {
-        h.width          = utils::little_endian_value<std::uint16_t>(buffer.get());
-        h.height         = utils::little_endian_value<std::uint16_t>(buffer.get() + 2);
-        h.planes         = utils::little_endian_value<std::uint16_t>(buffer.get() + 4);
-        h.bits_per_pixel = utils::little_endian_value<std::uint16_t>(buffer.get() + 6);
+        h.width          = utils::little_endian_value<std::uint16_t>(buffer);
+        h.height         = utils::little_endian_value<std::uint16_t>(buffer + 2);
+        h.planes         = utils::little_endian_value<std::uint16_t>(buffer + 4);
+        h.bits_per_pixel = utils::little_endian_value<std::uint16_t>(buffer + 6);
     } else {
-        h.width          = utils::little_endian_value<std::int32_t>(buffer.get());
-        h.height         = utils::little_endian_value<std::int32_t>(buffer.get() + 4);
-        h.planes         = utils::little_endian_value<std::uint16_t>(buffer.get() + 8);
-        h.bits_per_pixel = utils::little_endian_value<std::uint16_t>(buffer.get() + 10);
+        h.width          = utils::little_endian_value<std::int32_t>(buffer);
+        h.height         = utils::little_endian_value<std::int32_t>(buffer + 4);
+        h.planes         = utils::little_endian_value<std::uint16_t>(buffer + 8);
+        h.bits_per_pixel = utils::little_endian_value<std::uint16_t>(buffer + 10);
     }
 
     if (h.size >= static_cast<std::uint32_t>(InfoHeader::Type::bitmapinfoheader)) {
-        h.compression      = utils::little_endian_value<Compression>(buffer.get() + 12);
-        h.image_size       = utils::little_endian_value<std::uint32_t>(buffer.get() + 16);
-        h.x_ppm            = utils::little_endian_value<std::int32_t>(buffer.get() + 20);
-        h.y_ppm            = utils::little_endian_value<std::int32_t>(buffer.get() + 24);
-        h.colors_in_table  = utils::little_endian_value<std::uint32_t>(buffer.get() + 28);
-        h.important_colors = utils::little_endian_value<std::uint32_t>(buffer.get() + 32);
+        h.compression      = utils::little_endian_value<Compression>(buffer + 12);
+        h.image_size       = utils::little_endian_value<std::uint32_t>(buffer + 16);
+        h.x_ppm            = utils::little_endian_value<std::int32_t>(buffer + 20);
+        h.y_ppm            = utils::little_endian_value<std::int32_t>(buffer + 24);
+        h.colors_in_table  = utils::little_endian_value<std::uint32_t>(buffer + 28);
+        h.important_colors = utils::little_endian_value<std::uint32_t>(buffer + 32);
     }
 
     if (h.type() == InfoHeader::Type::bitmapinfoheader &&
         (h.compression == Compression::bi_bitfields || h.compression == Compression::bi_alphabitfields)) {
 
-        const size_t mask_buffer_size      = 3 * sizeof(std::uint32_t);
-        char mask_buffer[mask_buffer_size] = {};
-        in.read(mask_buffer, sizeof(mask_buffer_size));
+        constexpr std::size_t mask_buffer_size = 3 * sizeof(std::uint32_t);
+        if (tail.size() < mask_buffer_size) {
+            return InfoHeader();
+        }
+
+        h.red_chanel_bitmask   = utils::little_endian_value<std::uint32_t>(tail.begin());
+        h.green_chanel_bitmask = utils::little_endian_value<std::uint32_t>(tail.begin() + 4);
+        h.blue_chanel_bitmask  = utils::little_endian_value<std::uint32_t>(tail.begin() + 8);
 
-        h.red_chanel_bitmask   = utils::little_endian_value<std::uint32_t>(begin(mask_buffer));
-        h.green_chanel_bitmask = utils::little_endian_value<std::uint32_t>(begin(mask_buffer) + 4);
-        h.blue_chanel_bitmask  = utils::little_endian_value<std::uint32_t>(begin(mask_buffer) + 8);
+        tail = tail.subspan(mask_buffer_size);
     }
 
     if (h.size == static_cast<std::uint32_t>(InfoHeader::Type::bitmapinfoheader) &&
         h.compression == Compression::bi_alphabitfields) {
-        char mask_buffer[sizeof(std::uint32_t)] = {};
-        in.read(mask_buffer, sizeof(mask_buffer));
+        constexpr std::size_t mask_buffer_size = sizeof(std::uint32_t);
+        if (tail.size() < mask_buffer_size) {
+            return InfoHeader();
+        }
 
-        h.alpha_chanel_bitmask = utils::little_endian_value<std::uint32_t>(begin(mask_buffer));
+        h.alpha_chanel_bitmask = utils::little_endian_value<std::uint32_t>(tail.begin());
+
+        tail = tail.subspan(mask_buffer_size);
     }
 
     if (h.size >= static_cast<std::uint32_t>(InfoHeader::Type::bitmapv2infoheader)) {
-        h.red_chanel_bitmask   = utils::little_endian_value<std::uint32_t>(buffer.get() + 36);
-        h.green_chanel_bitmask = utils::little_endian_value<std::uint32_t>(buffer.get() + 40);
-        h.blue_chanel_bitmask  = utils::little_endian_value<std::uint32_t>(buffer.get() + 44);
+        h.red_chanel_bitmask   = utils::little_endian_value<std::uint32_t>(buffer + 36);
+        h.green_chanel_bitmask = utils::little_endian_value<std::uint32_t>(buffer + 40);
+        h.blue_chanel_bitmask  = utils::little_endian_value<std::uint32_t>(buffer + 44);
     }
 
     if (h.size >= static_cast<std::uint32_t>(InfoHeader::Type::bitmapv3infoheader)) {
-        h.alpha_chanel_bitmask = utils::little_endian_value<std::uint32_t>(buffer.get() + 48);
+        h.alpha_chanel_bitmask = utils::little_endian_value<std::uint32_t>(buffer + 48);
     }
 
     if (h.size >= static_cast<std::uint32_t>(InfoHeader::Type::bitmapv4header)) {
-        h.color_space_type = utils::little_endian_value<ColorSpace>(buffer.get() + 52);
+        h.color_space_type = utils::little_endian_value<ColorSpace>(buffer + 52);
 
-        h.endpoints.red.x   = utils::little_endian_value<std::uint32_t>(buffer.get() + 56);
-        h.endpoints.red.y   = utils::little_endian_value<std::uint32_t>(buffer.get() + 60);
-        h.endpoints.red.z   = utils::little_endian_value<std::uint32_t>(buffer.get() + 64);
-        h.endpoints.green.x = utils::little_endian_value<std::uint32_t>(buffer.get() + 68);
-        h.endpoints.green.y = utils::little_endian_value<std::uint32_t>(buffer.get() + 72);
-        h.endpoints.green.z = utils::little_endian_value<std::uint32_t>(buffer.get() + 76);
-        h.endpoints.blue.x  = utils::little_endian_value<std::uint32_t>(buffer.get() + 80);
-        h.endpoints.blue.y  = utils::little_endian_value<std::uint32_t>(buffer.get() + 84);
-        h.endpoints.blue.z  = utils::little_endian_value<std::uint32_t>(buffer.get() + 88);
+        h.endpoints.red.x   = utils::little_endian_value<std::uint32_t>(buffer + 56);
+        h.endpoints.red.y   = utils::little_endian_value<std::uint32_t>(buffer + 60);
+        h.endpoints.red.z   = utils::little_endian_value<std::uint32_t>(buffer + 64);
+        h.endpoints.green.x = utils::little_endian_value<std::uint32_t>(buffer + 68);
+        h.endpoints.green.y = utils::little_endian_value<std::uint32_t>(buffer + 72);
+        h.endpoints.green.z = utils::little_endian_value<std::uint32_t>(buffer + 76);
+        h.endpoints.blue.x  = utils::little_endian_value<std::uint32_t>(buffer + 80);
+        h.endpoints.blue.y  = utils::little_endian_value<std::uint32_t>(buffer + 84);
+        h.endpoints.blue.z  = utils::little_endian_value<std::uint32_t>(buffer + 88);
 
-        h.gamma_red   = utils::little_endian_value<std::uint32_t>(buffer.get() + 92);
-        h.gamma_green = utils::little_endian_value<std::uint32_t>(buffer.get() + 96);
-        h.gamma_blue  = utils::little_endian_value<std::uint32_t>(buffer.get() + 100);
+        h.gamma_red   = utils::little_endian_value<std::uint32_t>(buffer + 92);
+        h.gamma_green = utils::little_endian_value<std::uint32_t>(buffer + 96);
+        h.gamma_blue  = utils::little_endian_value<std::uint32_t>(buffer + 100);
     }
 
     if (h.size >= static_cast<std::uint32_t>(InfoHeader::Type::bitmapv5header)) {
-        h.intent               = utils::little_endian_value<std::uint32_t>(buffer.get() + 104);
-        h.color_profile_offset = utils::little_endian_value<std::uint32_t>(buffer.get() + 108);
-        h.color_profile_size   = utils::little_endian_value<std::uint32_t>(buffer.get() + 112);
-        h.reserved             = utils::little_endian_value<std::uint32_t>(buffer.get() + 116);
+        h.intent               = utils::little_endian_value<std::uint32_t>(buffer + 104);
+        h.color_profile_offset = utils::little_endian_value<std::uint32_t>(buffer + 108);
+        h.color_profile_size   = utils::little_endian_value<std::uint32_t>(buffer + 112);
+        h.reserved             = utils::little_endian_value<std::uint32_t>(buffer + 116);
     }
 
     if (h.bits_per_pixel <= 8) {
-        h.color_table = read_color_table(in, h);
+        h.color_table = read_color_table(tail, h);
     }
 
     return h;
 }
 
-InfoHeader::ColorTable InfoHeader::read_color_table(std::ifstream& in, const InfoHeader& info)
+InfoHeader::ColorTable InfoHeader::read_color_table(BytesData in, const InfoHeader& info)
 {
     const size_t colors_count = [&info]() {
         if (info.bits_per_pixel >= 1 && info.bits_per_pixel <= 8 &&
@@ -412,11 +426,7 @@ InfoHeader::ColorTable InfoHeader::read_color_table(std::ifstream& in, const Inf
         return ColorTable();
     }
 
-    const size_t buffer_size = colors_count * static_cast<size_t>(cell_size);
-    std::unique_ptr<char[]> buffer(new char[buffer_size]);
-    in.read(buffer.get(), static_cast<std::streamsize>(buffer_size));
-
-    if (!in) {
+    if (in.size() / cell_size < colors_count) {
         return ColorTable();
     }
 
@@ -424,20 +434,22 @@ InfoHeader::ColorTable InfoHeader::read_color_table(std::ifstream& in, const Inf
     for (std::uint32_t i = 0; i < colors_count; ++i) {
         const size_t offset = i * cell_size;
 
-        table[i].r = static_cast<std::uint8_t>(buffer[offset + 2]);
-        table[i].g = static_cast<std::uint8_t>(buffer[offset + 1]);
-        table[i].b = static_cast<std::uint8_t>(buffer[offset + 0]);
+        table[i].r = in[offset + 2];
+        table[i].g = in[offset + 1];
+        table[i].b = in[offset + 0];
         table[i].a = 255;
     }
 
     return table;
 }
 
-inline ImageInfo make_image_info(const InfoHeader& h, std::vector<Color>&& data) noexcept
+// Image is always decoded to PixelFormat::rgba8, because all pixel formats of BMP have to be converted anyway.
+inline ImageInfo make_image_info(const InfoHeader& h, std::vector<std::uint8_t>&& data) noexcept
 {
     return ImageInfo{static_cast<size_t>(h.width),
                      static_cast<size_t>(std::abs(h.height)),
                      graphics::details::image::default_gamma,
+                     graphics::PixelFormat::rgba8,
                      std::move(data)};
 }
 
@@ -459,169 +471,99 @@ inline std::uint8_t masked_value(std::uint32_t pixel, std::uint32_t mask, std::u
     return scale ? static_cast<std::uint8_t>((static_cast<float>(value) / static_cast<float>(scale)) * 255) : 0;
 }
 
-std::vector<Color>::iterator process_row_1bpp(std::vector<std::uint8_t>::iterator in,
-                                              std::vector<Color>::iterator out,
-                                              const InfoHeader& info)
+void process_row_indexed(const std::uint8_t* in, Color* out, const InfoHeader& info)
 {
-    for (std::int32_t x = 0; x < info.width; ++in) {
-        for (std::int32_t bit = 7; bit >= 0 && x < info.width; --bit, ++x) {
-            const std::uint32_t color_index = (*in & (1 << bit)) ? 1 : 0;
-
-            *out++ = info.color_table.at(color_index);
-        }
+    const bool valid = graphics::details::image::indexed_to_rgba8(in,
+                                                                  out,
+                                                                  static_cast<std::size_t>(info.width),
+                                                                  static_cast<std::uint8_t>(info.bits_per_pixel),
+                                                                  info.color_table.data(),
+                                                                  info.color_table.size());
+    if (!valid) {
+        throw ParsingError(graphics::details::image::error::read_data_error);
     }
-
-    return out;
 }
 
-std::vector<Color>::iterator process_row_2bpp(std::vector<std::uint8_t>::iterator in,
-                                              std::vector<Color>::iterator out,
-                                              const InfoHeader& info)
-{
-    const auto end = next(out, info.width);
-
-    std::int32_t offset = 6;
-    while (out != end) {
-        *out++ = info.color_table.at((*in >> offset) & 0x03);
-
-        if (offset == 0) {
-            offset = 6;
-            in++;
-        } else {
-            offset -= 2;
-        }
-    }
-
-    return out;
-}
-
-std::vector<Color>::iterator process_row_4bpp(std::vector<std::uint8_t>::iterator in,
-                                              std::vector<Color>::iterator out,
-                                              const InfoHeader& info)
-{
-    for (std::int32_t x = 0, offset = 4; x < info.width; ++x, offset = ((offset + 4) % 8)) {
-        *out++ = info.color_table.at((*in >> offset) & 0x0F);
-        if (offset == 0) {
-            in++;
-        }
-    }
-    return out;
-}
-
-std::vector<Color>::iterator process_row_8bpp(std::vector<std::uint8_t>::iterator in,
-                                              std::vector<Color>::iterator out,
-                                              const InfoHeader& info)
-{
-    for (std::int32_t x = 0; x < info.width; ++x) {
-        *out++ = info.color_table.at(*in++);
-    }
-    return out;
-}
-
-std::vector<Color>::iterator process_row_16bpp(std::vector<std::uint8_t>::iterator in,
-                                               std::vector<Color>::iterator out,
-                                               const InfoHeader& info)
+template <typename PixelType>
+void process_row_masked(const std::uint8_t* in, Color* out, const InfoHeader& info)
 {
     const auto [red_mask, green_mask, blue_mask, alpha_mask] = info.chanel_masks();
-
-    const std::uint32_t red_offset   = (red_mask ? get_offset(red_mask) : 0);
-    const std::uint32_t green_offset = (green_mask ? get_offset(green_mask) : 0);
-    const std::uint32_t blue_offset  = (blue_mask ? get_offset(blue_mask) : 0);
-    const std::uint32_t alpha_offset = (alpha_mask ? get_offset(alpha_mask) : 0);
+    const std::uint32_t red_offset                           = (red_mask ? get_offset(red_mask) : 0);
+    const std::uint32_t green_offset                         = (green_mask ? get_offset(green_mask) : 0);
+    const std::uint32_t blue_offset                          = (blue_mask ? get_offset(blue_mask) : 0);
+    const std::uint32_t alpha_offset                         = (alpha_mask ? get_offset(alpha_mask) : 0);
 
     for (std::int32_t x = 0; x < info.width; ++x) {
-        std::uint32_t pixel = *in++;
-        pixel += static_cast<std::uint32_t>(*in++ << 8);
+        const std::uint32_t pixel = utils::little_endian_value<PixelType>(in);
+        in += sizeof(PixelType);
 
-        const Color color(masked_value(pixel, red_mask, red_offset),
-                          masked_value(pixel, green_mask, green_offset),
-                          masked_value(pixel, blue_mask, blue_offset),
-                          (alpha_mask ? masked_value(pixel, alpha_mask, alpha_offset) : 255));
-        *out++ = color;
+        *out++ = Color(masked_value(pixel, red_mask, red_offset),
+                       masked_value(pixel, green_mask, green_offset),
+                       masked_value(pixel, blue_mask, blue_offset),
+                       (alpha_mask ? masked_value(pixel, alpha_mask, alpha_offset) : 255));
     }
-
-    return out;
 }
 
-std::vector<Color>::iterator process_row_24bpp(std::vector<std::uint8_t>::iterator in,
-                                               std::vector<Color>::iterator out,
-                                               const InfoHeader& info)
-{
-    for (std::int32_t x = 0; x < info.width; ++x) {
-        const Color color(*in++, *in++, *in++, 255U);
-        *out++ = color;
-    }
-
-    return out;
-}
-
-std::vector<Color>::iterator process_row_32bpp(std::vector<std::uint8_t>::iterator in,
-                                               std::vector<Color>::iterator out,
-                                               const InfoHeader& info)
+void process_row_32bpp(const std::uint8_t* in, Color* out, const InfoHeader& info)
 {
     const auto [red_mask, green_mask, blue_mask, alpha_mask] = info.chanel_masks();
-    const std::uint32_t red_offset                           = (red_mask ? get_offset(red_mask) : 0);
-    const std::uint32_t green_offset                         = (green_mask ? get_offset(green_mask) : 0);
-    const std::uint32_t blue_offset                          = (blue_mask ? get_offset(blue_mask) : 0);
-    const std::uint32_t alpha_offset                         = (alpha_mask ? get_offset(alpha_mask) : 0);
 
-    for (std::int32_t x = 0; x < info.width; ++x) {
-        std::uint32_t pixel = *in++;
-        pixel += static_cast<std::uint32_t>(*in++ << 8);
-        pixel += static_cast<std::uint32_t>(*in++ << 16);
-        pixel += static_cast<std::uint32_t>(*in++ << 24);
-
-        const Color color(masked_value(pixel, red_mask, red_offset),
-                          masked_value(pixel, green_mask, green_offset),
-                          masked_value(pixel, blue_mask, blue_offset),
-                          (alpha_mask ? masked_value(pixel, alpha_mask, alpha_offset) : 255));
-        *out++ = color;
+    if (red_mask == 0x00FF0000 && green_mask == 0x0000FF00 && blue_mask == 0x000000FF) {
+        if (alpha_mask == 0) {
+            return graphics::details::image::bgrx8_to_rgba8(in, out, static_cast<std::size_t>(info.width));
+        } else if (alpha_mask == 0xFF000000) {
+            return graphics::details::image::bgra8_to_rgba8(in, out, static_cast<std::size_t>(info.width));
+        }
     }
 
-    return out;
+    process_row_masked<std::uint32_t>(in, out, info);
 }
 
-std::vector<Color>::iterator process_row(std::vector<std::uint8_t>::iterator in,
-                                         std::vector<Color>::iterator out,
-                                         const InfoHeader& info)
+void process_row(const std::uint8_t* in, Color* out, const InfoHeader& info)
 {
     switch (info.bits_per_pixel) {
-        case 1: return process_row_1bpp(in, out, info);
-        case 2: return process_row_2bpp(in, out, info);
-        case 4: return process_row_4bpp(in, out, info);
-        case 8: return process_row_8bpp(in, out, info);
-        case 16: return process_row_16bpp(in, out, info);
-        case 24: return process_row_24bpp(in, out, info);
+        case 1:
+        case 2:
+        case 4:
+        case 8: return process_row_indexed(in, out, info);
+        case 16: return process_row_masked<std::uint16_t>(in, out, info);
+        case 24: return graphics::details::image::bgr8_to_rgba8(in, out, static_cast<std::size_t>(info.width));
         case 32: return process_row_32bpp(in, out, info);
         default: break;
     }
-
-    return out;
 }
 
-std::vector<Color> read_data_raw(std::ifstream& in, const InfoHeader& info)
+// Rows are converted straight to their place in the bottom-up result, so top-down images need no extra flip pass.
+std::vector<std::uint8_t> read_data_raw(BytesData in, const InfoHeader& info)
 {
     const std::int32_t height = std::abs(info.height);
     const size_t image_size   = static_cast<size_t>(info.width * height);
-    std::vector<Color> image_data(image_size);
+    std::vector<std::uint8_t> image_data(image_size * sizeof(Color));
+    Color* pixels             = reinterpret_cast<Color*>(image_data.data());
 
-    const std::uint32_t row_size = static_cast<std::uint32_t>(((info.bits_per_pixel * info.width + 31) / 32) * 4);
-    std::vector<std::uint8_t> buffer(row_size);
+    const std::size_t row_size = static_cast<std::size_t>(((info.bits_per_pixel * info.width + 31) / 32) * 4);
 
-    auto out = begin(image_data);
-    for (std::int32_t y = 0; y < height && in; ++y) {
-        if (in.read(reinterpret_cast<char*>(buffer.data()), row_size)) {
-            out = process_row(buffer.begin(), out, info);
-        }
+    std::int32_t y = 0;
+    for (; y < height && in.size() >= row_size; ++y) {
+        const std::int32_t row = info.bottom_up() ? y : height - 1 - y;
+        process_row(in.data(), pixels + static_cast<std::size_t>(row * info.width), info);
+
+        in = in.subspan(row_size);
+    }
+
+    // Rows missing in the truncated file are black.
+    for (; y < height; ++y) {
+        const std::int32_t row = info.bottom_up() ? y : height - 1 - y;
+        std::fill_n(pixels + static_cast<std::size_t>(row * info.width), info.width, Color());
     }
 
     return image_data;
 }
 
-inline std::vector<Color>::iterator fill_with_color_4(std::vector<Color>::iterator out,
-                                                      const InfoHeader::ColorTable& color_table,
-                                                      const std::vector<std::uint8_t>::iterator it,
-                                                      std::int32_t count)
+inline Color* fill_with_color_4(Color* out,
+                                const InfoHeader::ColorTable& color_table,
+                                const std::vector<std::uint8_t>::iterator it,
+                                std::int32_t count)
 {
     for (std::int32_t c = 0, offset = 4; c < count; ++c) {
         const std::size_t color_index = static_cast<std::size_t>((*it >> offset) & 0x0F);
@@ -631,10 +573,10 @@ inline std::vector<Color>::iterator fill_with_color_4(std::vector<Color>::iterat
     return out;
 }
 
-inline std::vector<Color>::iterator fill_with_color_8(std::vector<Color>::iterator out,
-                                                      const InfoHeader::ColorTable& color_table,
-                                                      const std::vector<std::uint8_t>::iterator it,
-                                                      std::int32_t count)
+inline Color* fill_with_color_8(Color* out,
+                                const InfoHeader::ColorTable& color_table,
+                                const std::vector<std::uint8_t>::iterator it,
+                                std::int32_t count)
 {
     const std::size_t color_index = static_cast<std::size_t>(*it);
     const Color color             = color_index < color_table.size() ? color_table[color_index] : Color(0x000000FFU);
@@ -644,10 +586,10 @@ inline std::vector<Color>::iterator fill_with_color_8(std::vector<Color>::iterat
     return out;
 }
 
-inline std::vector<Color>::iterator fill_from_buffer_4(std::vector<Color>::iterator out,
-                                                       const InfoHeader::ColorTable& color_table,
-                                                       std::vector<std::uint8_t>::iterator it,
-                                                       std::int32_t count)
+inline Color* fill_from_buffer_4(Color* out,
+                                 const InfoHeader::ColorTable& color_table,
+                                 std::vector<std::uint8_t>::iterator it,
+                                 std::int32_t count)
 {
     const std::int32_t colors_in_byte = 2;
     while (count > 0) {
@@ -658,10 +600,10 @@ inline std::vector<Color>::iterator fill_from_buffer_4(std::vector<Color>::itera
     return out;
 }
 
-inline std::vector<Color>::iterator fill_from_buffer_8(std::vector<Color>::iterator out,
-                                                       const InfoHeader::ColorTable& color_table,
-                                                       std::vector<std::uint8_t>::iterator it,
-                                                       std::int32_t count)
+inline Color* fill_from_buffer_8(Color* out,
+                                 const InfoHeader::ColorTable& color_table,
+                                 std::vector<std::uint8_t>::iterator it,
+                                 std::int32_t count)
 {
     while (count-- > 0) {
         const std::size_t color_index = static_cast<std::size_t>(*it++);
@@ -670,26 +612,34 @@ inline std::vector<Color>::iterator fill_from_buffer_8(std::vector<Color>::itera
     return out;
 }
 
-std::vector<Color> read_data_rle(std::ifstream& input, const InfoHeader& info)
+std::vector<std::uint8_t> read_data_rle(BytesData input, const InfoHeader& info)
 {
     const std::int32_t height     = std::abs(info.height);
     const std::int32_t image_size = info.width * height;
-    std::vector<Color> image_data(static_cast<std::size_t>(image_size));
+    std::vector<std::uint8_t> image_data(static_cast<std::size_t>(image_size) * sizeof(Color));
+
+    Color* const first = reinterpret_cast<Color*>(image_data.data());
+    Color* const last  = first + image_size;
+
+    // Skipped pixels are black.
+    std::fill(first, last, Color());
 
+    // The decoder looks ahead of the current position, so it works on the zero padded copy of the data.
+    const BytesData data = input.first(info.image_size);
     std::vector<std::uint8_t> buffer(info.image_size);
-    input.read(reinterpret_cast<char*>(buffer.data()), info.image_size);
+    std::copy(data.begin(), data.end(), buffer.begin());
 
-    auto in  = begin(buffer);
-    auto out = begin(image_data);
+    auto in    = begin(buffer);
+    Color* out = first;
 
-    while (in != end(buffer) && out != end(image_data)) {
+    while (in != end(buffer) && out != last) {
         if (*in == 0x00) {
             ++in;
             switch (*in) {
                 case 0x00: {
-                    const std::int32_t d = static_cast<std::int32_t>(distance(image_data.begin(), out)) % info.width;
+                    const std::int32_t d = static_cast<std::int32_t>(out - first) % info.width;
                     if (d != 0) {
-                        advance(out, info.width - d);
+                        out += info.width - d;
                     }
                     in++;
                 } break;
@@ -701,19 +651,19 @@ std::vector<Color> read_data_rle(std::ifstream& input, const InfoHeader& info)
                     const std::int32_t h = *in++;
 
                     const std::int32_t step = h * info.width + w;
-                    const std::int32_t dist = static_cast<std::int32_t>(std::distance(out, image_data.end()));
+                    const std::int32_t dist = static_cast<std::int32_t>(last - out);
 
                     if (step > dist) {
                         throw ParsingError("Bad rle encoding.");
                     }
 
-                    advance(out, step);
+                    out += step;
                 } break;
                 default: {
                     const std::int32_t count = *in++;
 
-                    if (next(out, count) > end(image_data)) {
-                        out = end(image_data);
+                    if (out + count > last) {
+                        out = last;
                         break;
                     }
 
@@ -730,8 +680,8 @@ std::vector<Color> read_data_rle(std::ifstream& input, const InfoHeader& info)
         } else {
             const std::int32_t count = *in++;
 
-            if (next(out, count) > end(image_data)) {
-                out = end(image_data);
+            if (out + count > last) {
+                out = last;
                 break;
             }
 
@@ -748,7 +698,12 @@ std::vector<Color> read_data_rle(std::ifstream& input, const InfoHeader& info)
     return image_data;
 }
 
-std::vector<Color> read_data(std::ifstream& in, const InfoHeader& info)
+inline bool is_rle(const InfoHeader& info)
+{
+    return info.compression == InfoHeader::Compression::bi_rle4 || info.compression == InfoHeader::Compression::bi_rle8;
+}
+
+std::vector<std::uint8_t> read_data(BytesData in, const InfoHeader& info)
 {
     switch (info.compression) {
         case InfoHeader::Compression::bi_rle4:
@@ -757,20 +712,22 @@ std::vector<Color> read_data(std::ifstream& in, const InfoHeader& info)
         case InfoHeader::Compression::bi_bitfields:
         case InfoHeader::Compression::bi_alphabitfields: return read_data_raw(in, info);
         case InfoHeader::Compression::bi_jpeg:
-        case InfoHeader::Compression::bi_png: return std::vector<Color>();
+        case InfoHeader::Compression::bi_png: return std::vector<std::uint8_t>();
     }
-    return std::vector<Color>();
+    return std::vector<std::uint8_t>();
 }
 
-std::vector<Color> flip_vertically(const InfoHeader& info, const std::vector<Color>& data)
+std::vector<std::uint8_t> flip_vertically(const InfoHeader& info, const std::vector<std::uint8_t>& data)
 {
-    std::vector<Color> tmp;
+    std::vector<std::uint8_t> tmp;
     tmp.reserve(data.size());
 
+    const std::ptrdiff_t row_size = static_cast<std::ptrdiff_t>(sizeof(Color)) * info.width;
+
     auto row_end = data.end();
 
     for (std::size_t y = 0; y < static_cast<std::size_t>(std::abs(info.height)); ++y) {
-        auto row_begin = std::prev(row_end, info.width);
+        auto row_begin = std::prev(row_end, row_size);
         std::copy(row_begin, row_end, std::back_inserter(tmp));
         row_end = row_begin;
     }
@@ -778,59 +735,138 @@ std::vector<Color> flip_vertically(const InfoHeader& info, const std::vector<Col
     return tmp;
 }
 
-} // namespace
+#pragma region encode
 
-namespace framework::graphics::details::image::bmp
+template <typename T>
+inline void put_little_endian(std::vector<std::uint8_t>& out, T value)
 {
-ImageInfo load(const std::filesystem::path& filepath)
+    const auto unsigned_value = static_cast<std::make_unsigned_t<T>>(value);
+    for (std::size_t i = 0; i < sizeof(T); ++i) {
+        out.push_back(static_cast<std::uint8_t>((unsigned_value >> (8 * i)) & 0xFF));
+    }
+}
+
+// Opaque images are written as 24 bit BI_RGB with BITMAPINFOHEADER,
+// images with alpha as 32 bit BI_BITFIELDS with BITMAPV4HEADER to keep the alpha mask.
+std::vector<std::uint8_t> encode_bmp(const graphics::details::image::ImageView& image)
 {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file) {
-        throw ParsingError(error::open_file_error);
+    constexpr std::uint16_t bm_signature   = 0x4D42;
+    constexpr std::int32_t pixels_per_meter = 2835; // 72 DPI
+
+    const bool alpha                  = graphics::details::image::has_alpha(image);
+    const std::size_t bytes_per_pixel = alpha ? 4 : 3;
+    const std::size_t row_size        = (image.width * bytes_per_pixel + 3) & ~std::size_t{3};
+    const std::size_t data_size       = row_size * image.height;
+
+    const InfoHeader::Type header_type = alpha ? InfoHeader::Type::bitmapv4header : InfoHeader::Type::bitmapinfoheader;
+    const std::size_t header_size      = static_cast<std::size_t>(header_type);
+    const std::size_t data_offset      = FileHeader::size + header_size;
+
+    std::vector<std::uint8_t> out;
+    out.reserve(data_offset + data_size);
+
+    put_little_endian(out, bm_signature);
+    put_little_endian(out, static_cast<std::uint32_t>(data_offset + data_size));
+    put_little_endian(out, std::uint32_t{0});
+    put_little_endian(out, static_cast<std::uint32_t>(data_offset));
+
+    put_little_endian(out, static_cast<std::uint32_t>(header_size));
+    put_little_endian(out, static_cast<std::int32_t>(image.width));
+    put_little_endian(out, static_cast<std::int32_t>(image.height)); // bottom-up
+    put_little_endian(out, std::uint16_t{1});
+    put_little_endian(out, static_cast<std::uint16_t>(bytes_per_pixel * 8));
+    put_little_endian(out, alpha ? InfoHeader::Compression::bi_bitfields : InfoHeader::Compression::bi_rgb);
+    put_little_endian(out, static_cast<std::uint32_t>(data_size));
+    put_little_endian(out, pixels_per_meter);
+    put_little_endian(out, pixels_per_meter);
+    put_little_endian(out, std::uint32_t{0});
+    put_little_endian(out, std::uint32_t{0});
+
+    if (alpha) {
+        put_little_endian(out, std::uint32_t{0x00FF0000});
+        put_little_endian(out, std::uint32_t{0x0000FF00});
+        put_little_endian(out, std::uint32_t{0x000000FF});
+        put_little_endian(out, std::uint32_t{0xFF000000});
+        put_little_endian(out, InfoHeader::ColorSpace::lcs_srgb);
+        out.resize(data_offset, 0); // endpoints and gamma are not used for sRGB
     }
 
-    FileHeader file_header = FileHeader::read(file);
+    const std::size_t padding = row_size - image.width * bytes_per_pixel;
+
+    // Image rows are already stored bottom to top.
+    const Color* in = reinterpret_cast<const Color*>(image.data.data());
+    for (std::size_t y = 0; y < image.height; ++y) {
+        for (std::size_t x = 0; x < image.width; ++x, ++in) {
+            out.push_back(in->b);
+            out.push_back(in->g);
+            out.push_back(in->r);
+            if (alpha) {
+                out.push_back(in->a);
+            }
+        }
+        out.insert(out.end(), padding, 0);
+    }
+
+    return out;
+}
+
+#pragma endregion
+
+} // namespace
+
+namespace framework::graphics::details::image::bmp
+{
+ImageInfo load(Span<const std::uint8_t> data)
+{
+    FileHeader file_header = FileHeader::read(data);
     if (!file_header.is_valid()) {
         throw ParsingError(error::read_header_error);
     }
-    if (!file) {
-        throw ParsingError(error::file_offset_error);
-    }
 
-    InfoHeader info = InfoHeader::read(file);
+    InfoHeader info = InfoHeader::read(data.subspan(FileHeader::size));
     if (!info.is_valid()) {
         throw ParsingError(error::read_header_error);
     }
-    if (!file) {
-        throw ParsingError(error::file_offset_error);
-    }
 
-    file.seekg(file_header.pixel_array_offset, std::ios::beg);
-    if (!file) {
+    if (file_header.pixel_array_offset > data.size()) {
         throw ParsingError(error::file_offset_error);
     }
 
-    std::vector<Color> data = read_data(file, info);
-    if (data.empty()) {
+    std::vector<std::uint8_t> image_data = read_data(data.subspan(file_header.pixel_array_offset), info);
+    if (image_data.empty()) {
         throw ParsingError(error::read_data_error);
     }
 
-    if (!info.bottom_up()) {
-        data = flip_vertically(info, data);
+    if (!info.bottom_up() && is_rle(info)) {
+        image_data = flip_vertically(info, image_data);
     }
 
-    return make_image_info(info, std::move(data));
+    return make_image_info(info, std::move(image_data));
 }
 
-bool is_bmp(const std::filesystem::path& filepath)
+ImageInfo read_header(Span<const std::uint8_t> data)
 {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file) {
-        return false;
+    const FileHeader file_header = FileHeader::read(data);
+    if (!file_header.is_valid()) {
+        throw ParsingError(error::read_header_error);
     }
 
-    FileHeader header = FileHeader::read(file);
-    return header.is_valid();
+    InfoHeader info = InfoHeader::read(data.subspan(FileHeader::size));
+    if (!info.is_valid()) {
+        throw ParsingError(error::read_header_error);
+    }
+
+    return make_image_info(info, std::vector<std::uint8_t>());
+}
+
+bool is_bmp(Span<const std::uint8_t> data)
+{
+    return FileHeader::read(data).is_valid();
+}
+
+std::vector<std::uint8_t> encode(const ImageView& image)
+{
+    return encode_bmp(image);
 }
 
 } // namespace framework::graphics::details::image::bmp
@@ -1,15 +1,22 @@
 #ifndef GRAPHICS_SRC_IMAGE_BMP_HPP
 #define GRAPHICS_SRC_IMAGE_BMP_HPP
 
-#include <filesystem>
+#include <cstdint>
+#include <vector>
+
+#include <common/span.hpp>
 
 #include <graphics/src/image/image_info.hpp>
 
 namespace framework::graphics::details::image::bmp
 {
-ImageInfo load(const std::filesystem::path& filepath);
+ImageInfo load(Span<const std::uint8_t> data);
+
+ImageInfo read_header(Span<const std::uint8_t> data);
+
+bool is_bmp(Span<const std::uint8_t> data);
 
-bool is_bmp(const std::filesystem::path& filepath);
+std::vector<std::uint8_t> encode(const ImageView& image);
 
 } // namespace framework::graphics::details::image::bmp
 
@@ -1,45 +1,148 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
 #include <common/exceptions.hpp>
+#include <common/memory_mapped_file.hpp>
 #include <graphics/image.hpp>
 #include <log/log.hpp>
 
 #include <graphics/src/image/bmp.hpp>
 #include <graphics/src/image/image_info.hpp>
+#include <graphics/src/image/pixel_conversion.hpp>
 #include <graphics/src/image/png.hpp>
 
+namespace
+{
+using framework::graphics::Image;
+using framework::graphics::details::image::ImageInfo;
+using framework::graphics::details::image::ImageRegion;
+
+// Rows of the image to preview are the rows of the first Adam7 pass.
+inline constexpr std::size_t preview_step = 8;
+
+// Converts the region to the file coordinates, where rows are counted from the top.
+ImageRegion make_region(const Image::LoadOptions& options, std::size_t width, std::size_t height)
+{
+    const std::size_t x = std::min(options.x, width);
+    const std::size_t y = std::min(options.y, height);
+
+    const std::size_t region_width  = options.width == 0 ? width - x : std::min(options.width, width - x);
+    const std::size_t region_height = options.height == 0 ? height - y : std::min(options.height, height - y);
+
+    ImageRegion region;
+    region.left   = x;
+    region.right  = x + region_width;
+    region.top    = height - (y + region_height);
+    region.bottom = height - y;
+    region.step   = options.preview ? preview_step : 1;
+
+    return region;
+}
+
+// Takes the region pixels out of the fully decoded image.
+ImageInfo copy_region(ImageInfo info, const ImageRegion& region)
+{
+    if (region.is_whole_image(info.width, info.height)) {
+        return info;
+    }
+
+    const std::size_t pixel_size = bytes_per_pixel(info.format);
+    const std::size_t width      = region.width();
+    const std::size_t height     = region.height();
+
+    std::vector<std::uint8_t> data(width * height * pixel_size);
+
+    for (std::size_t row = 0; row < height; ++row) {
+        const std::size_t y    = region.first_row() + row * region.step;
+        const std::uint8_t* in = info.data.data() + (info.height - 1 - y) * info.width * pixel_size;
+        std::uint8_t* out      = data.data() + (height - 1 - row) * width * pixel_size;
+
+        for (std::size_t column = 0; column < width; ++column) {
+            const std::size_t x = region.first_column() + column * region.step;
+            std::memcpy(out + column * pixel_size, in + x * pixel_size, pixel_size);
+        }
+    }
+
+    info.width  = width;
+    info.height = height;
+    info.data   = std::move(data);
+
+    return info;
+}
+
+} // namespace
+
 namespace framework::graphics
 {
 Image::Image() = default;
 
 Image::Image(const ColorDataType& data, std::size_t width, std::size_t height)
-    : m_data(data)
+    : m_data(data.size() * sizeof(Color))
     , m_width(width)
     , m_height(height)
+{
+    std::memcpy(m_data.data(), data.data(), m_data.size());
+}
+
+Image::Image(std::size_t width, std::size_t height, PixelFormat format)
+    : m_data(width * height * bytes_per_pixel(format), 0)
+    , m_width(width)
+    , m_height(height)
+    , m_format(format)
 {}
 
 Image::LoadResult Image::load(const std::filesystem::path& file)
 {
-    using namespace details::image;
-
-    auto load_function = [](const std::filesystem::path& f) {
-        if (bmp::is_bmp(f)) {
-            return bmp::load(f);
-        } else if (png::is_png(f)) {
-            return png::load(f);
-        }
-
-        throw FileTypeError(error::invalid_file_type);
-    };
+    return load(file, LoadOptions());
+}
 
+Image::LoadResult Image::load(const std::filesystem::path& file, const LoadOptions& options)
+{
     if (!std::filesystem::exists(file)) {
         return LoadResult::FileNotExists;
     }
 
+    const MemoryMappedFile mapped_file(file);
+    if (!mapped_file.is_open()) {
+        return LoadResult::OpenFileError;
+    }
+
+    return load(as_bytes(mapped_file.bytes()), options);
+}
+
+Image::LoadResult Image::load(Span<const std::byte> data)
+{
+    return load(data, LoadOptions());
+}
+
+Image::LoadResult Image::load(Span<const std::byte> data, const LoadOptions& options)
+{
+    using namespace details::image;
+
+    const Span<const std::uint8_t> bytes(reinterpret_cast<const std::uint8_t*>(data.data()), data.size());
+
     try {
-        ImageInfo info = load_function(file);
+        ImageInfo header;
+        if (bmp::is_bmp(bytes)) {
+            header = bmp::read_header(bytes);
+        } else if (png::is_png(bytes)) {
+            header = png::read_header(bytes);
+        } else {
+            throw FileTypeError(error::invalid_file_type);
+        }
+
+        const ImageRegion region = make_region(options, header.width, header.height);
+        if (region.width() == 0 || region.height() == 0) {
+            return LoadResult::InvalidRegion;
+        }
+
+        ImageInfo info = bmp::is_bmp(bytes) ? copy_region(bmp::load(bytes), region) : png::load(bytes, region);
 
         m_width  = info.width;
         m_height = info.height;
         m_gamma  = info.gamma;
+        m_format = info.format;
         m_data   = std::move(info.data);
 
         return LoadResult::Success;
@@ -61,6 +164,53 @@ Image::LoadResult Image::load(const std::filesystem::path& file)
     }
 }
 
+Image::SaveResult Image::save(const std::filesystem::path& file, FileType type) const
+{
+    return save(file, type, SaveOptions());
+}
+
+Image::SaveResult Image::save(const std::filesystem::path& file, FileType type, const SaveOptions& options) const
+{
+    using namespace details::image;
+
+    if (m_width == 0 || m_height == 0 || m_data.size() != m_width * m_height * bytes_per_pixel(m_format)) {
+        return SaveResult::InvalidImage;
+    }
+
+    // BMP stores only 8 bit colors, PNG can't store floating point ones.
+    PixelFormat format = m_format;
+    if (type == FileType::bmp) {
+        format = PixelFormat::rgba8;
+    } else if (m_format == PixelFormat::rgba16f) {
+        format = PixelFormat::rgba16;
+    }
+
+    const Image converted = format != m_format ? convert(format) : Image();
+    const Image& source   = format != m_format ? converted : *this;
+    const ImageView image{source.m_width, source.m_height, source.m_gamma, source.m_format, source.m_data};
+
+    std::vector<std::uint8_t> data;
+
+    try {
+        switch (type) {
+            case FileType::bmp: data = bmp::encode(image); break;
+            case FileType::png: data = png::encode(image, options.compression, options.threads_count); break;
+        }
+    } catch (std::exception& e) {
+        log::error("Exception:") << e.what();
+        return SaveResult::UnknownError;
+    }
+
+    std::ofstream stream(file, std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!stream) {
+        return SaveResult::OpenFileError;
+    }
+
+    stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+    return stream ? SaveResult::Success : SaveResult::WriteError;
+}
+
 std::size_t Image::width() const
 {
     return m_width;
@@ -76,22 +226,44 @@ float Image::gamma() const
     return m_gamma;
 }
 
-const Image::ColorDataType& Image::data() const
+void Image::set_gamma(float gamma)
+{
+    m_gamma = gamma;
+}
+
+PixelFormat Image::format() const
+{
+    return m_format;
+}
+
+Span<const std::uint8_t> Image::bytes() const
 {
     return m_data;
 }
 
-Image::ColorDataType& Image::data()
+Span<std::uint8_t> Image::bytes()
 {
     return m_data;
 }
 
+Image Image::convert(PixelFormat format) const
+{
+    Image res(m_width, m_height, format);
+    res.m_gamma = m_gamma;
+
+    const std::size_t count = std::min(m_width * m_height, m_data.size() / bytes_per_pixel(m_format));
+    details::image::convert_pixels(m_data.data(), m_format, res.m_data.data(), format, count);
+
+    return res;
+}
+
 #pragma region Helper function
 
 bool operator==(const Image& lhs, const Image& rhs) noexcept
 {
     return lhs.width() == rhs.width() && lhs.height() == rhs.height() && lhs.gamma() == rhs.gamma() &&
-           std::equal(lhs.data().begin(), lhs.data().end(), rhs.data().begin());
+           lhs.format() == rhs.format() &&
+           std::equal(lhs.bytes().begin(), lhs.bytes().end(), rhs.bytes().begin(), rhs.bytes().end());
 }
 
 bool operator!=(const Image& lhs, const Image& rhs) noexcept
@@ -107,6 +279,7 @@ void swap(Image& lhs, Image& rhs) noexcept
     swap(lhs.m_width, rhs.m_width);
     swap(lhs.m_height, rhs.m_height);
     swap(lhs.m_gamma, rhs.m_gamma);
+    swap(lhs.m_format, rhs.m_format);
 }
 
 #pragma endregion
@@ -1,9 +1,12 @@
 #ifndef GRAPHICS_SRC_IMAGE_IMAGE_INFO_HPP
 #define GRAPHICS_SRC_IMAGE_IMAGE_INFO_HPP
 
+#include <cstdint>
 #include <vector>
 
+#include <common/span.hpp>
 #include <graphics/color.hpp>
+#include <graphics/pixel_format.hpp>
 
 namespace framework::graphics::details::image
 {
@@ -27,9 +30,82 @@ struct ImageInfo
 
     float gamma = default_gamma;
 
-    std::vector<Color> data;
+    PixelFormat format = PixelFormat::rgba8;
+
+    std::vector<std::uint8_t> data;
+};
+
+// Pixels to decode. Rows are counted from the top of the image, like in the files.
+// Only pixels with both coordinates divisible by the step are decoded.
+struct ImageRegion
+{
+    std::size_t left   = 0;
+    std::size_t top    = 0;
+    std::size_t right  = 0; // One past the last column.
+    std::size_t bottom = 0; // One past the last row.
+    std::size_t step   = 1;
+
+    std::size_t first_column() const
+    {
+        return (left + step - 1) / step * step;
+    }
+
+    std::size_t first_row() const
+    {
+        return (top + step - 1) / step * step;
+    }
+
+    std::size_t width() const
+    {
+        return right > first_column() ? (right - first_column() + step - 1) / step : 0;
+    }
+
+    std::size_t height() const
+    {
+        return bottom > first_row() ? (bottom - first_row() + step - 1) / step : 0;
+    }
+
+    bool contains_column(std::size_t x) const
+    {
+        return x >= left && x < right && x % step == 0;
+    }
+
+    bool contains_row(std::size_t y) const
+    {
+        return y >= top && y < bottom && y % step == 0;
+    }
+
+    bool is_whole_image(std::size_t image_width, std::size_t image_height) const
+    {
+        return left == 0 && top == 0 && right == image_width && bottom == image_height && step == 1;
+    }
 };
 
+// Image data to encode. Rows are stored from bottom to top, like in the Image.
+struct ImageView
+{
+    std::size_t width  = 0;
+    std::size_t height = 0;
+
+    float gamma = default_gamma;
+
+    PixelFormat format = PixelFormat::rgba8;
+
+    Span<const std::uint8_t> data;
+};
+
+// Checks the alpha channel of the PixelFormat::rgba8 image.
+inline bool has_alpha(const ImageView& image)
+{
+    for (std::size_t i = 3; i < image.data.size(); i += sizeof(Color)) {
+        if (image.data[i] != Color::default_alpha) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 } // namespace framework::graphics::details::image
 
 #endif
@@ -0,0 +1,317 @@
+#include <atomic>
+#include <chrono>
+#include <utility>
+
+#include <common/memory_mapped_file.hpp>
+#include <graphics/image_loader.hpp>
+
+#include <graphics/src/image/bmp.hpp>
+#include <graphics/src/image/image_info.hpp>
+#include <graphics/src/image/png.hpp>
+
+namespace
+{
+using namespace framework;
+using namespace framework::graphics::details::image;
+
+// Estimates amount of memory to decode image: the input and the decoded pixels.
+std::size_t decoding_size(Span<const std::uint8_t> data)
+{
+    std::size_t size = data.size();
+
+    try {
+        ImageInfo info;
+        if (bmp::is_bmp(data)) {
+            info = bmp::read_header(data);
+        } else if (png::is_png(data)) {
+            info = png::read_header(data);
+        }
+
+        size += info.width * info.height * graphics::bytes_per_pixel(info.format);
+    } catch (std::exception&) {
+        // Image is invalid, decoding will fail early.
+    }
+
+    return size;
+}
+
+} // namespace
+
+namespace framework::graphics
+{
+struct ImageLoader::Request
+{
+    enum class State
+    {
+        pending,
+        running,
+        completed,
+    };
+
+    bool start()
+    {
+        State expected = State::pending;
+        return state.compare_exchange_strong(expected, State::running);
+    }
+
+    bool cancel()
+    {
+        State expected = State::pending;
+        if (!state.compare_exchange_strong(expected, State::completed)) {
+            return false;
+        }
+
+        Result result;
+        result.cancelled = true;
+        complete(std::move(result));
+
+        return true;
+    }
+
+    void complete(Result&& result)
+    {
+        state = State::completed;
+
+        // The promise is fulfilled even if the callback throws, otherwise the Handle would wait forever.
+        if (callback) {
+            try {
+                callback(result);
+            } catch (...) {
+                // Exceptions of the callback are ignored.
+            }
+        }
+
+        promise.set_value(std::move(result));
+    }
+
+    std::atomic<State> state = State::pending;
+    Priority priority        = Priority::normal;
+    std::uint64_t number     = 0;
+
+    std::filesystem::path file;
+    std::vector<std::byte> data;
+
+    Callback callback;
+    std::promise<Result> promise;
+};
+
+#pragma region Handle
+
+ImageLoader::Handle::Handle(std::shared_ptr<Request> request, std::future<Result> future)
+    : m_request(std::move(request))
+    , m_future(std::move(future))
+{}
+
+bool ImageLoader::Handle::valid() const noexcept
+{
+    return m_future.valid();
+}
+
+bool ImageLoader::Handle::ready() const
+{
+    return m_future.valid() && m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void ImageLoader::Handle::wait() const
+{
+    if (m_future.valid()) {
+        m_future.wait();
+    }
+}
+
+ImageLoader::Result ImageLoader::Handle::get()
+{
+    if (!m_future.valid()) {
+        return Result();
+    }
+
+    m_request.reset();
+    return m_future.get();
+}
+
+bool ImageLoader::Handle::cancel()
+{
+    return m_request && m_request->cancel();
+}
+
+#pragma endregion
+
+ImageLoader::ImageLoader(std::size_t threads_count, std::size_t memory_budget)
+    : m_memory_budget(memory_budget)
+    , m_pool(threads_count)
+{}
+
+ImageLoader::~ImageLoader()
+{
+    cancel_all();
+    m_pool.wait();
+}
+
+ImageLoader::Handle ImageLoader::load(const std::filesystem::path& file, Priority priority, Callback callback)
+{
+    auto request      = std::make_shared<Request>();
+    request->file     = file;
+    request->priority = priority;
+    request->callback = std::move(callback);
+
+    return add_request(std::move(request));
+}
+
+ImageLoader::Handle ImageLoader::load(std::vector<std::byte> data, Priority priority, Callback callback)
+{
+    auto request      = std::make_shared<Request>();
+    request->data     = std::move(data);
+    request->priority = priority;
+    request->callback = std::move(callback);
+
+    return add_request(std::move(request));
+}
+
+std::vector<ImageLoader::Handle> ImageLoader::load(const std::vector<std::filesystem::path>& files, Priority priority)
+{
+    std::vector<Handle> handles;
+    handles.reserve(files.size());
+
+    for (const auto& file : files) {
+        handles.push_back(load(file, priority));
+    }
+
+    return handles;
+}
+
+void ImageLoader::cancel_all()
+{
+    std::vector<std::shared_ptr<Request>> requests;
+
+    {
+        std::lock_guard lock(m_mutex);
+        while (!m_requests.empty()) {
+            requests.push_back(m_requests.top());
+            m_requests.pop();
+        }
+    }
+
+    // Callbacks of cancelled requests are called without lock, so they can add new requests.
+    for (const auto& request : requests) {
+        request->cancel();
+    }
+}
+
+void ImageLoader::wait()
+{
+    m_pool.wait();
+}
+
+std::size_t ImageLoader::threads_count() const noexcept
+{
+    return m_pool.threads_count();
+}
+
+bool ImageLoader::RequestOrder::operator()(const std::shared_ptr<Request>& lhs,
+                                           const std::shared_ptr<Request>& rhs) const
+{
+    if (lhs->priority != rhs->priority) {
+        return lhs->priority < rhs->priority;
+    }
+
+    return lhs->number > rhs->number;
+}
+
+ImageLoader::Handle ImageLoader::add_request(std::shared_ptr<Request> request)
+{
+    Handle handle(request, request->promise.get_future());
+
+    {
+        std::lock_guard lock(m_mutex);
+        request->number = m_requests_count++;
+        m_requests.push(std::move(request));
+    }
+
+    // Each task takes the most important request at the moment it runs, not the one it was added for.
+    m_pool.add_task([this]() { process_next_request(); });
+
+    return handle;
+}
+
+void ImageLoader::process_next_request()
+{
+    std::shared_ptr<Request> request;
+
+    {
+        std::lock_guard lock(m_mutex);
+        while (!m_requests.empty() && !request) {
+            request = m_requests.top();
+            m_requests.pop();
+
+            if (!request->start()) {
+                request.reset(); // cancelled one
+            }
+        }
+    }
+
+    if (!request) {
+        return;
+    }
+
+    Result result;
+
+    try {
+        result = decode(*request);
+    } catch (std::exception&) {
+        result.status = Image::LoadResult::UnknownError;
+    }
+
+    request->complete(std::move(result));
+}
+
+ImageLoader::Result ImageLoader::decode(Request& request)
+{
+    Result result;
+
+    MemoryMappedFile mapped_file;
+    Span<const std::uint8_t> data(reinterpret_cast<const std::uint8_t*>(request.data.data()), request.data.size());
+
+    if (!request.file.empty()) {
+        if (!std::filesystem::exists(request.file)) {
+            result.status = Image::LoadResult::FileNotExists;
+            return result;
+        }
+
+        if (!mapped_file.open(request.file)) {
+            result.status = Image::LoadResult::OpenFileError;
+            return result;
+        }
+
+        data = mapped_file.bytes();
+    }
+
+    const std::size_t size = decoding_size(data);
+
+    acquire_memory(size);
+    result.status = result.image.load(as_bytes(data));
+    release_memory(size);
+
+    return result;
+}
+
+void ImageLoader::acquire_memory(std::size_t size)
+{
+    std::unique_lock lock(m_mutex);
+    m_memory_released.wait(lock, [this, size]() {
+        return m_memory_in_use == 0 || m_memory_in_use + size <= m_memory_budget;
+    });
+
+    m_memory_in_use += size;
+}
+
+void ImageLoader::release_memory(std::size_t size)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_memory_in_use -= size;
+    }
+
+    m_memory_released.notify_all();
+}
+
+} // namespace framework::graphics
@@ -0,0 +1,473 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <common/thread_pool.hpp>
+#include <graphics/image_processing.hpp>
+
+#include <graphics/src/image/image_info.hpp>
+#include <graphics/src/image/linear_color.hpp>
+#include <graphics/src/image/pixel_conversion.hpp>
+#include <graphics/src/image/resample.hpp>
+#include <graphics/src/image/strips.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+using framework::ThreadPool;
+using framework::graphics::Image;
+using framework::graphics::PixelFormat;
+using framework::graphics::ResizeFilter;
+using framework::graphics::details::image::ResampleFilter;
+
+using ByteTable = std::array<std::uint8_t, 256>;
+using WordTable = std::vector<std::uint16_t>;
+
+inline constexpr std::uint32_t max_8  = 255;
+inline constexpr std::uint32_t max_16 = 65535;
+
+// Channels of the pixel, alpha is always the last one.
+struct PixelLayout
+{
+    std::size_t channels = 4;
+    bool alpha           = true;
+};
+
+PixelLayout pixel_layout(PixelFormat format)
+{
+    switch (format) {
+        case PixelFormat::r8: return {1, false};
+        case PixelFormat::rg8: return {2, true};
+        case PixelFormat::rgb8: return {3, false};
+        case PixelFormat::rgba8: return {4, true};
+        case PixelFormat::r16: return {1, false};
+        case PixelFormat::rgba16: return {4, true};
+        case PixelFormat::rgba16f: return {4, true};
+    }
+
+    return PixelLayout();
+}
+
+ResampleFilter resample_filter(ResizeFilter filter)
+{
+    switch (filter) {
+        case ResizeFilter::box: return ResampleFilter::box;
+        case ResizeFilter::bilinear: return ResampleFilter::triangle;
+        case ResizeFilter::bicubic: return ResampleFilter::cubic;
+        case ResizeFilter::lanczos3: return ResampleFilter::lanczos3;
+    }
+
+    return ResampleFilter::cubic;
+}
+
+bool is_valid(const Image& image)
+{
+    return image.width() != 0 && image.height() != 0 &&
+           image.bytes().size() == image.width() * image.height() * bytes_per_pixel(image.format());
+}
+
+// Creates pool only if the rows can be split between threads.
+std::unique_ptr<ThreadPool> make_pool(std::size_t threads_count, std::size_t rows_count)
+{
+    using framework::graphics::details::image::min_strip_rows;
+
+    if (threads_count == 1 || rows_count < min_strip_rows * 2) {
+        return nullptr;
+    }
+
+    return std::make_unique<ThreadPool>(threads_count);
+}
+
+// Calls function(bytes, pixels_count) for strips of image rows.
+template <typename Function>
+void for_each_pixels(Image& image, std::size_t threads_count, const Function& function)
+{
+    using framework::graphics::details::image::for_each_strip;
+
+    if (!is_valid(image)) {
+        return;
+    }
+
+    const auto pool            = make_pool(threads_count, image.height());
+    const std::size_t width    = image.width();
+    const std::size_t row_size = width * bytes_per_pixel(image.format());
+    std::uint8_t* const bytes  = image.bytes().data();
+
+    for_each_strip(image.height(), pool.get(), [&](std::size_t begin, std::size_t end) {
+        function(bytes + begin * row_size, (end - begin) * width);
+    });
+}
+
+#pragma region sRGB tables
+
+struct ByteTables
+{
+    ByteTable decode;
+    ByteTable encode;
+};
+
+struct WordTables
+{
+    WordTable decode;
+    WordTable encode;
+};
+
+const ByteTables& byte_tables()
+{
+    using namespace framework::graphics::details::image;
+
+    static const ByteTables tables = []() {
+        ByteTables res{};
+
+        for (std::size_t i = 0; i < res.decode.size(); ++i) {
+            const float value = srgb8_to_linear(static_cast<std::uint8_t>(i));
+            res.decode[i]     = static_cast<std::uint8_t>(std::lround(value * static_cast<float>(max_8)));
+            res.encode[i]     = linear_to_srgb8(static_cast<float>(i) / static_cast<float>(max_8));
+        }
+
+        return res;
+    }();
+
+    return tables;
+}
+
+// 16 bit tables take 256 KB, so they are built only if needed.
+const WordTables& word_tables()
+{
+    using namespace framework::graphics::details::image;
+
+    static const WordTables tables = []() {
+        WordTables res{WordTable(max_16 + 1), WordTable(max_16 + 1)};
+
+        for (std::size_t i = 0; i <= max_16; ++i) {
+            const float value = static_cast<float>(i) / static_cast<float>(max_16);
+
+            res.decode[i] = static_cast<std::uint16_t>(std::lround(srgb_to_linear(value) * max_16));
+            res.encode[i] = static_cast<std::uint16_t>(std::lround(linear_to_srgb(value) * max_16));
+        }
+
+        return res;
+    }();
+
+    return tables;
+}
+
+#pragma endregion
+
+#pragma region Transfer functions
+
+inline std::uint16_t load_16(const std::uint8_t* in)
+{
+    std::uint16_t value = 0;
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+inline void store_16(std::uint8_t* out, std::uint16_t value)
+{
+    std::memcpy(out, &value, sizeof(value));
+}
+
+void transform_colors_8(std::uint8_t* bytes, std::size_t count, PixelLayout layout, const ByteTable& table)
+{
+    const std::size_t colors = layout.channels - (layout.alpha ? 1 : 0);
+
+    for (std::size_t i = 0; i < count; ++i, bytes += layout.channels) {
+        for (std::size_t c = 0; c < colors; ++c) {
+            bytes[c] = table[bytes[c]];
+        }
+    }
+}
+
+void transform_colors_16(std::uint8_t* bytes, std::size_t count, PixelLayout layout, const WordTable& table)
+{
+    const std::size_t colors = layout.channels - (layout.alpha ? 1 : 0);
+
+    for (std::size_t i = 0; i < count; ++i, bytes += layout.channels * 2) {
+        for (std::size_t c = 0; c < colors; ++c) {
+            store_16(bytes + c * 2, table[load_16(bytes + c * 2)]);
+        }
+    }
+}
+
+template <typename Function>
+void transform_colors_half(std::uint8_t* bytes, std::size_t count, Function function)
+{
+    using namespace framework::graphics::details::image;
+
+    for (std::size_t i = 0; i < count; ++i, bytes += 8) {
+        for (std::size_t c = 0; c < 3; ++c) {
+            store_16(bytes + c * 2, float_to_half(function(half_to_float(load_16(bytes + c * 2)))));
+        }
+    }
+}
+
+#pragma endregion
+
+#pragma region Alpha
+
+// Rounded c * a / 255.
+inline std::uint8_t multiply_8(std::uint32_t color, std::uint32_t alpha)
+{
+    const std::uint32_t value = color * alpha + 128;
+    return static_cast<std::uint8_t>((value + (value >> 8)) >> 8);
+}
+
+// Rounded c * 255 / a.
+inline std::uint8_t divide_8(std::uint32_t color, std::uint32_t alpha)
+{
+    if (alpha == 0) {
+        return 0;
+    }
+
+    return static_cast<std::uint8_t>(std::min(max_8, (color * max_8 + alpha / 2) / alpha));
+}
+
+// Rounded c * a / 65535.
+inline std::uint16_t multiply_16(std::uint32_t color, std::uint32_t alpha)
+{
+    return static_cast<std::uint16_t>((color * alpha + max_16 / 2) / max_16);
+}
+
+// Rounded c * 65535 / a.
+inline std::uint16_t divide_16(std::uint32_t color, std::uint32_t alpha)
+{
+    if (alpha == 0) {
+        return 0;
+    }
+
+    const std::uint64_t value = (std::uint64_t{color} * max_16 + alpha / 2) / alpha;
+    return static_cast<std::uint16_t>(std::min<std::uint64_t>(max_16, value));
+}
+
+void premultiply_rgba8(std::uint8_t* bytes, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero       = _mm_setzero_si128();
+    const __m128i color_mask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+    const __m128i alpha_one  = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    const __m128i rounding   = _mm_set1_epi16(128);
+
+    // Multiplies two pixels in 16 bit lanes, alpha is multiplied by 255 to stay the same.
+    auto multiply = [&](__m128i pixels) {
+        __m128i alpha = _mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha         = _mm_shufflehi_epi16(alpha, _MM_SHUFFLE(3, 3, 3, 3));
+        alpha         = _mm_or_si128(_mm_and_si128(alpha, color_mask), alpha_one);
+
+        const __m128i value = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), rounding);
+        return _mm_srli_epi16(_mm_add_epi16(value, _mm_srli_epi16(value, 8)), 8);
+    };
+
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + i * 4));
+
+        const __m128i low  = multiply(_mm_unpacklo_epi8(pixels, zero));
+        const __m128i high = multiply(_mm_unpackhi_epi8(pixels, zero));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(bytes + i * 4), _mm_packus_epi16(low, high));
+    }
+#endif
+
+    for (std::uint8_t* pixel = bytes + i * 4; i < count; ++i, pixel += 4) {
+        pixel[0] = multiply_8(pixel[0], pixel[3]);
+        pixel[1] = multiply_8(pixel[1], pixel[3]);
+        pixel[2] = multiply_8(pixel[2], pixel[3]);
+    }
+}
+
+void premultiply_pixels(std::uint8_t* bytes, std::size_t count, PixelFormat format)
+{
+    using namespace framework::graphics::details::image;
+
+    switch (format) {
+        case PixelFormat::rg8:
+            for (std::size_t i = 0; i < count; ++i, bytes += 2) {
+                bytes[0] = multiply_8(bytes[0], bytes[1]);
+            }
+            break;
+        case PixelFormat::rgba8: premultiply_rgba8(bytes, count); break;
+        case PixelFormat::rgba16:
+            for (std::size_t i = 0; i < count; ++i, bytes += 8) {
+                const std::uint16_t alpha = load_16(bytes + 6);
+                for (std::size_t c = 0; c < 3; ++c) {
+                    store_16(bytes + c * 2, multiply_16(load_16(bytes + c * 2), alpha));
+                }
+            }
+            break;
+        case PixelFormat::rgba16f:
+            for (std::size_t i = 0; i < count; ++i, bytes += 8) {
+                const float alpha = half_to_float(load_16(bytes + 6));
+                for (std::size_t c = 0; c < 3; ++c) {
+                    store_16(bytes + c * 2, float_to_half(half_to_float(load_16(bytes + c * 2)) * alpha));
+                }
+            }
+            break;
+        case PixelFormat::r8:
+        case PixelFormat::rgb8:
+        case PixelFormat::r16: break;
+    }
+}
+
+void unpremultiply_pixels(std::uint8_t* bytes, std::size_t count, PixelFormat format)
+{
+    using namespace framework::graphics::details::image;
+
+    switch (format) {
+        case PixelFormat::rg8:
+            for (std::size_t i = 0; i < count; ++i, bytes += 2) {
+                bytes[0] = divide_8(bytes[0], bytes[1]);
+            }
+            break;
+        case PixelFormat::rgba8:
+            for (std::size_t i = 0; i < count; ++i, bytes += 4) {
+                bytes[0] = divide_8(bytes[0], bytes[3]);
+                bytes[1] = divide_8(bytes[1], bytes[3]);
+                bytes[2] = divide_8(bytes[2], bytes[3]);
+            }
+            break;
+        case PixelFormat::rgba16:
+            for (std::size_t i = 0; i < count; ++i, bytes += 8) {
+                const std::uint16_t alpha = load_16(bytes + 6);
+                for (std::size_t c = 0; c < 3; ++c) {
+                    store_16(bytes + c * 2, divide_16(load_16(bytes + c * 2), alpha));
+                }
+            }
+            break;
+        case PixelFormat::rgba16f:
+            for (std::size_t i = 0; i < count; ++i, bytes += 8) {
+                const float alpha = half_to_float(load_16(bytes + 6));
+                const float scale = alpha > 0.0f ? 1.0f / alpha : 0.0f;
+                for (std::size_t c = 0; c < 3; ++c) {
+                    store_16(bytes + c * 2, float_to_half(half_to_float(load_16(bytes + c * 2)) * scale));
+                }
+            }
+            break;
+        case PixelFormat::r8:
+        case PixelFormat::rgb8:
+        case PixelFormat::r16: break;
+    }
+}
+
+#pragma endregion
+
+} // namespace
+
+namespace framework::graphics
+{
+Image resize(const Image& image, std::size_t width, std::size_t height, const ResizeOptions& options)
+{
+    using namespace details::image;
+
+    if (width == 0 || height == 0 || !is_valid(image)) {
+        return Image();
+    }
+
+    const auto pool             = make_pool(options.threads_count, std::max(image.height(), height));
+    const PixelFormat format    = image.format();
+    const ResampleFilter filter = resample_filter(options.filter);
+    const std::size_t in_size   = image.width() * bytes_per_pixel(format);
+    const bool srgb             = options.gamma_correct && is_srgb_encoded(format, image.gamma());
+    const bool premultiply      = !options.premultiplied_alpha && pixel_layout(format).alpha;
+
+    std::vector<float> in(image.width() * image.height() * 4);
+    for_each_strip(image.height(), pool.get(), [&](std::size_t begin, std::size_t end) {
+        const std::size_t count = (end - begin) * image.width();
+        float* pixels           = in.data() + begin * image.width() * 4;
+
+        unpack_linear(image.bytes().data() + begin * in_size, format, pixels, count, srgb);
+        if (premultiply) {
+            details::image::premultiply_alpha(pixels, count);
+        }
+    });
+
+    std::vector<float> out(width * height * 4);
+    resample(in.data(), image.width(), image.height(), out.data(), width, height, filter, pool.get());
+
+    Image res(width, height, format);
+    res.set_gamma(image.gamma());
+
+    const std::size_t out_size = width * bytes_per_pixel(format);
+    for_each_strip(height, pool.get(), [&](std::size_t begin, std::size_t end) {
+        const std::size_t count = (end - begin) * width;
+        float* pixels           = out.data() + begin * width * 4;
+
+        if (premultiply) {
+            details::image::unpremultiply_alpha(pixels, count);
+        }
+        pack_linear(pixels, format, res.bytes().data() + begin * out_size, count, srgb);
+    });
+
+    return res;
+}
+
+void premultiply_alpha(Image& image, std::size_t threads_count)
+{
+    const PixelFormat format = image.format();
+
+    if (pixel_layout(format).alpha) {
+        for_each_pixels(image, threads_count, [format](std::uint8_t* bytes, std::size_t count) {
+            premultiply_pixels(bytes, count, format);
+        });
+    }
+}
+
+void unpremultiply_alpha(Image& image, std::size_t threads_count)
+{
+    const PixelFormat format = image.format();
+
+    if (pixel_layout(format).alpha) {
+        for_each_pixels(image, threads_count, [format](std::uint8_t* bytes, std::size_t count) {
+            unpremultiply_pixels(bytes, count, format);
+        });
+    }
+}
+
+void srgb_to_linear(Image& image, std::size_t threads_count)
+{
+    const PixelFormat format = image.format();
+    const PixelLayout layout = pixel_layout(format);
+
+    for_each_pixels(image, threads_count, [format, layout](std::uint8_t* bytes, std::size_t count) {
+        switch (format) {
+            case PixelFormat::r16:
+            case PixelFormat::rgba16: transform_colors_16(bytes, count, layout, word_tables().decode); break;
+            case PixelFormat::rgba16f: transform_colors_half(bytes, count, details::image::srgb_to_linear); break;
+            case PixelFormat::r8:
+            case PixelFormat::rg8:
+            case PixelFormat::rgb8:
+            case PixelFormat::rgba8: transform_colors_8(bytes, count, layout, byte_tables().decode); break;
+        }
+    });
+
+    image.set_gamma(1.0f);
+}
+
+void linear_to_srgb(Image& image, std::size_t threads_count)
+{
+    const PixelFormat format = image.format();
+    const PixelLayout layout = pixel_layout(format);
+
+    for_each_pixels(image, threads_count, [format, layout](std::uint8_t* bytes, std::size_t count) {
+        switch (format) {
+            case PixelFormat::r16:
+            case PixelFormat::rgba16: transform_colors_16(bytes, count, layout, word_tables().encode); break;
+            case PixelFormat::rgba16f: transform_colors_half(bytes, count, details::image::linear_to_srgb); break;
+            case PixelFormat::r8:
+            case PixelFormat::rg8:
+            case PixelFormat::rgb8:
+            case PixelFormat::rgba8: transform_colors_8(bytes, count, layout, byte_tables().encode); break;
+        }
+    });
+
+    image.set_gamma(details::image::default_gamma);
+}
+
+} // namespace framework::graphics
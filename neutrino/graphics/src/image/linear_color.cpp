@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include <graphics/src/image/linear_color.hpp>
+#include <graphics/src/image/pixel_conversion.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+using framework::graphics::PixelFormat;
+
+inline constexpr float max_8  = 255.0f;
+inline constexpr float max_16 = 65535.0f;
+
+// Size of the coarse table of the sRGB encoder. It's big enough to be at most one step away from the exact code.
+inline constexpr std::size_t srgb_encode_table_size = 4096;
+
+// Luminance of the linear sRGB color.
+inline constexpr float luminance_r = 0.2126f;
+inline constexpr float luminance_g = 0.7152f;
+inline constexpr float luminance_b = 0.0722f;
+
+struct SrgbTables
+{
+    // Linear values of all 8 bit codes.
+    std::array<float, 256> decode;
+
+    // Linear values in the middle between the adjacent 8 bit codes.
+    std::array<float, 255> thresholds;
+
+    // The 8 bit code of the linear value i / (srgb_encode_table_size - 1).
+    std::array<std::uint8_t, srgb_encode_table_size> encode;
+};
+
+const SrgbTables& srgb_tables()
+{
+    using framework::graphics::details::image::srgb_to_linear;
+
+    static const SrgbTables tables = []() {
+        SrgbTables res{};
+
+        for (std::size_t i = 0; i < res.decode.size(); ++i) {
+            res.decode[i] = srgb_to_linear(static_cast<float>(i) / max_8);
+        }
+
+        for (std::size_t i = 0; i < res.thresholds.size(); ++i) {
+            res.thresholds[i] = srgb_to_linear((static_cast<float>(i) + 0.5f) / max_8);
+        }
+
+        for (std::size_t i = 0; i < res.encode.size(); ++i) {
+            const float value = static_cast<float>(i) / static_cast<float>(srgb_encode_table_size - 1);
+            const auto code   = std::upper_bound(res.thresholds.begin(), res.thresholds.end(), value);
+            res.encode[i]     = static_cast<std::uint8_t>(code - res.thresholds.begin());
+        }
+
+        return res;
+    }();
+
+    return tables;
+}
+
+inline std::uint16_t load_16(const std::uint8_t* in)
+{
+    std::uint16_t value = 0;
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+inline void store_16(std::uint8_t* out, std::uint16_t value)
+{
+    std::memcpy(out, &value, sizeof(value));
+}
+
+inline float clamp_unit(float value)
+{
+    // Negated comparison maps NaN to zero.
+    if (!(value > 0.0f)) {
+        return 0.0f;
+    }
+
+    return value < 1.0f ? value : 1.0f;
+}
+
+inline float color_from_8(std::uint8_t value, bool srgb)
+{
+    using framework::graphics::details::image::srgb8_to_linear;
+
+    return srgb ? srgb8_to_linear(value) : static_cast<float>(value) / max_8;
+}
+
+inline float color_from_16(const std::uint8_t* in, bool srgb)
+{
+    using framework::graphics::details::image::srgb_to_linear;
+
+    const float value = static_cast<float>(load_16(in)) / max_16;
+    return srgb ? srgb_to_linear(value) : value;
+}
+
+inline std::uint8_t color_to_8(float value, bool srgb)
+{
+    using framework::graphics::details::image::linear_to_srgb8;
+
+    if (srgb) {
+        return linear_to_srgb8(value);
+    }
+
+    return static_cast<std::uint8_t>(std::lround(clamp_unit(value) * max_8));
+}
+
+inline std::uint16_t color_to_16(float value, bool srgb)
+{
+    using framework::graphics::details::image::linear_to_srgb;
+
+    const float unit = srgb ? linear_to_srgb(clamp_unit(value)) : clamp_unit(value);
+    return static_cast<std::uint16_t>(std::lround(unit * max_16));
+}
+
+inline std::uint8_t alpha_to_8(float value)
+{
+    return static_cast<std::uint8_t>(std::lround(clamp_unit(value) * max_8));
+}
+
+inline std::uint16_t alpha_to_16(float value)
+{
+    return static_cast<std::uint16_t>(std::lround(clamp_unit(value) * max_16));
+}
+
+inline float luminance(const float* in)
+{
+    return in[0] * luminance_r + in[1] * luminance_g + in[2] * luminance_b;
+}
+
+} // namespace
+
+namespace framework::graphics::details::image
+{
+void unpack_linear(const std::uint8_t* in, PixelFormat format, float* out, std::size_t count, bool srgb)
+{
+    switch (format) {
+        case PixelFormat::r8:
+            for (std::size_t i = 0; i < count; ++i, out += 4) {
+                out[0] = out[1] = out[2] = color_from_8(in[i], srgb);
+                out[3]                   = 1.0f;
+            }
+            break;
+        case PixelFormat::rg8:
+            for (std::size_t i = 0; i < count; ++i, in += 2, out += 4) {
+                out[0] = out[1] = out[2] = color_from_8(in[0], srgb);
+                out[3]                   = static_cast<float>(in[1]) / max_8;
+            }
+            break;
+        case PixelFormat::rgb8:
+            for (std::size_t i = 0; i < count; ++i, in += 3, out += 4) {
+                out[0] = color_from_8(in[0], srgb);
+                out[1] = color_from_8(in[1], srgb);
+                out[2] = color_from_8(in[2], srgb);
+                out[3] = 1.0f;
+            }
+            break;
+        case PixelFormat::rgba8:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 4) {
+                out[0] = color_from_8(in[0], srgb);
+                out[1] = color_from_8(in[1], srgb);
+                out[2] = color_from_8(in[2], srgb);
+                out[3] = static_cast<float>(in[3]) / max_8;
+            }
+            break;
+        case PixelFormat::r16:
+            for (std::size_t i = 0; i < count; ++i, in += 2, out += 4) {
+                out[0] = out[1] = out[2] = color_from_16(in, srgb);
+                out[3]                   = 1.0f;
+            }
+            break;
+        case PixelFormat::rgba16:
+            for (std::size_t i = 0; i < count; ++i, in += 8, out += 4) {
+                out[0] = color_from_16(in, srgb);
+                out[1] = color_from_16(in + 2, srgb);
+                out[2] = color_from_16(in + 4, srgb);
+                out[3] = static_cast<float>(load_16(in + 6)) / max_16;
+            }
+            break;
+        case PixelFormat::rgba16f:
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                out[i] = half_to_float(load_16(in + i * 2));
+            }
+            break;
+    }
+}
+
+void pack_linear(const float* in, PixelFormat format, std::uint8_t* out, std::size_t count, bool srgb)
+{
+    switch (format) {
+        case PixelFormat::r8:
+            for (std::size_t i = 0; i < count; ++i, in += 4) {
+                out[i] = color_to_8(luminance(in), srgb);
+            }
+            break;
+        case PixelFormat::rg8:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 2) {
+                out[0] = color_to_8(luminance(in), srgb);
+                out[1] = alpha_to_8(in[3]);
+            }
+            break;
+        case PixelFormat::rgb8:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 3) {
+                out[0] = color_to_8(in[0], srgb);
+                out[1] = color_to_8(in[1], srgb);
+                out[2] = color_to_8(in[2], srgb);
+            }
+            break;
+        case PixelFormat::rgba8:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 4) {
+                out[0] = color_to_8(in[0], srgb);
+                out[1] = color_to_8(in[1], srgb);
+                out[2] = color_to_8(in[2], srgb);
+                out[3] = alpha_to_8(in[3]);
+            }
+            break;
+        case PixelFormat::r16:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 2) {
+                store_16(out, color_to_16(luminance(in), srgb));
+            }
+            break;
+        case PixelFormat::rgba16:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 8) {
+                store_16(out, color_to_16(in[0], srgb));
+                store_16(out + 2, color_to_16(in[1], srgb));
+                store_16(out + 4, color_to_16(in[2], srgb));
+                store_16(out + 6, alpha_to_16(in[3]));
+            }
+            break;
+        case PixelFormat::rgba16f:
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                store_16(out + i * 2, float_to_half(in[i]));
+            }
+            break;
+    }
+}
+
+void premultiply_alpha(float* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 color_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+    for (; i < count; ++i) {
+        const __m128 pixel = _mm_loadu_ps(pixels + i * 4);
+        const __m128 alpha = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 color = _mm_and_ps(color_mask, _mm_mul_ps(pixel, alpha));
+
+        _mm_storeu_ps(pixels + i * 4, _mm_or_ps(color, _mm_andnot_ps(color_mask, pixel)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float* pixel = pixels + i * 4;
+
+        pixel[0] *= pixel[3];
+        pixel[1] *= pixel[3];
+        pixel[2] *= pixel[3];
+    }
+}
+
+void unpremultiply_alpha(float* pixels, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 color_mask = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+    const __m128 zero       = _mm_setzero_ps();
+
+    for (; i < count; ++i) {
+        const __m128 pixel   = _mm_loadu_ps(pixels + i * 4);
+        const __m128 alpha   = _mm_shuffle_ps(pixel, pixel, _MM_SHUFFLE(3, 3, 3, 3));
+        const __m128 visible = _mm_and_ps(color_mask, _mm_cmpgt_ps(alpha, zero));
+        const __m128 color   = _mm_and_ps(visible, _mm_div_ps(pixel, alpha));
+
+        _mm_storeu_ps(pixels + i * 4, _mm_or_ps(color, _mm_andnot_ps(color_mask, pixel)));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        float* pixel = pixels + i * 4;
+
+        const float scale = pixel[3] > 0.0f ? 1.0f / pixel[3] : 0.0f;
+
+        pixel[0] *= scale;
+        pixel[1] *= scale;
+        pixel[2] *= scale;
+    }
+}
+
+float srgb_to_linear(float value)
+{
+    if (value <= 0.04045f) {
+        return value / 12.92f;
+    }
+
+    return std::pow((value + 0.055f) / 1.055f, 2.4f);
+}
+
+float linear_to_srgb(float value)
+{
+    if (value <= 0.0031308f) {
+        return value * 12.92f;
+    }
+
+    return 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+}
+
+float srgb8_to_linear(std::uint8_t value)
+{
+    return srgb_tables().decode[value];
+}
+
+std::uint8_t linear_to_srgb8(float value)
+{
+    const SrgbTables& tables = srgb_tables();
+
+    value = clamp_unit(value);
+
+    // The coarse table gives the code of some close value, the thresholds make the rounding exact.
+    const auto index = static_cast<std::size_t>(value * static_cast<float>(srgb_encode_table_size - 1));
+
+    std::size_t code = tables.encode[index];
+    while (code < tables.thresholds.size() && value >= tables.thresholds[code]) {
+        ++code;
+    }
+
+    while (code > 0 && value < tables.thresholds[code - 1]) {
+        --code;
+    }
+
+    return static_cast<std::uint8_t>(code);
+}
+
+} // namespace framework::graphics::details::image
@@ -0,0 +1,47 @@
+#ifndef GRAPHICS_SRC_IMAGE_LINEAR_COLOR_HPP
+#define GRAPHICS_SRC_IMAGE_LINEAR_COLOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <graphics/pixel_format.hpp>
+
+namespace framework::graphics::details::image
+{
+// Floating point RGBA pixels, four floats per pixel. Used as intermediate format of the image filters.
+
+/// Checks if the image colors are sRGB encoded. Floating point colors and colors with gamma 1 are linear.
+inline bool is_srgb_encoded(PixelFormat format, float gamma)
+{
+    return format != PixelFormat::rgba16f && gamma != 1.0f;
+}
+
+/// Reads pixels of any format as RGBA floats, greyscale is expanded to all color channels.
+///
+/// Integer color channels are decoded from sRGB to linear values if `srgb` is set,
+/// alpha and floating point channels are read as is.
+void unpack_linear(const std::uint8_t* in, PixelFormat format, float* out, std::size_t count, bool srgb);
+
+/// Writes RGBA floats as pixels of any format, color is reduced to greyscale by its luminance.
+///
+/// Integer channels are clamped to the [0, 1] range and encoded to sRGB if `srgb` is set.
+void pack_linear(const float* in, PixelFormat format, std::uint8_t* out, std::size_t count, bool srgb);
+
+/// Multiplies color channels by alpha.
+void premultiply_alpha(float* pixels, std::size_t count);
+
+/// Divides color channels by alpha, pixels with zero alpha get zero color.
+void unpremultiply_alpha(float* pixels, std::size_t count);
+
+float srgb_to_linear(float value);
+float linear_to_srgb(float value);
+
+/// Table based sRGB decoding of 8 bit values.
+float srgb8_to_linear(std::uint8_t value);
+
+/// Table based sRGB encoding with exact rounding to 8 bits. The value is clamped to the [0, 1] range.
+std::uint8_t linear_to_srgb8(float value);
+
+} // namespace framework::graphics::details::image
+
+#endif
@@ -0,0 +1,106 @@
+#include <algorithm>
+#include <optional>
+
+#include <common/thread_pool.hpp>
+#include <graphics/image.hpp>
+
+#include <graphics/src/image/linear_color.hpp>
+#include <graphics/src/image/resample.hpp>
+
+namespace
+{
+using framework::graphics::Image;
+using framework::graphics::details::image::ResampleFilter;
+
+ResampleFilter resample_filter(Image::MipmapFilter filter)
+{
+    switch (filter) {
+        case Image::MipmapFilter::box: return ResampleFilter::box;
+        case Image::MipmapFilter::kaiser: return ResampleFilter::kaiser;
+        case Image::MipmapFilter::lanczos3: return ResampleFilter::lanczos3;
+    }
+
+    return ResampleFilter::box;
+}
+
+std::size_t max_levels_count(std::size_t width, std::size_t height)
+{
+    std::size_t count = 0;
+    for (std::size_t size = std::max(width, height); size > 1; size /= 2) {
+        ++count;
+    }
+
+    return count;
+}
+
+} // namespace
+
+namespace framework::graphics
+{
+std::vector<Image> Image::generate_mipmaps() const
+{
+    return generate_mipmaps(MipmapOptions());
+}
+
+std::vector<Image> Image::generate_mipmaps(const MipmapOptions& options) const
+{
+    using namespace details::image;
+
+    if (m_width == 0 || m_height == 0 || m_data.size() != m_width * m_height * bytes_per_pixel(m_format)) {
+        return {};
+    }
+
+    std::size_t levels_count = max_levels_count(m_width, m_height);
+    if (options.levels_count != 0) {
+        levels_count = std::min(levels_count, options.levels_count);
+    }
+
+    std::optional<ThreadPool> pool;
+    if (options.threads_count != 1) {
+        pool.emplace(options.threads_count);
+    }
+
+    ThreadPool* threads         = pool ? &*pool : nullptr;
+    const bool srgb             = options.gamma_correct && is_srgb_encoded(m_format, m_gamma);
+    const ResampleFilter filter = resample_filter(options.filter);
+
+    // The previous level is kept in floats, so the rounding errors don't accumulate down the chain.
+    std::vector<float> previous(m_width * m_height * 4);
+    unpack_linear(m_data.data(), m_format, previous.data(), m_width * m_height, srgb);
+    premultiply_alpha(previous.data(), m_width * m_height);
+
+    std::vector<float> current;
+    std::vector<float> pixels;
+
+    std::vector<Image> levels;
+    levels.reserve(levels_count);
+
+    std::size_t width  = m_width;
+    std::size_t height = m_height;
+
+    for (std::size_t i = 0; i < levels_count; ++i) {
+        const std::size_t level_width  = std::max<std::size_t>(width / 2, 1);
+        const std::size_t level_height = std::max<std::size_t>(height / 2, 1);
+        const std::size_t count        = level_width * level_height;
+
+        current.resize(count * 4);
+        resample(previous.data(), width, height, current.data(), level_width, level_height, filter, threads);
+
+        pixels.assign(current.begin(), current.end());
+        unpremultiply_alpha(pixels.data(), count);
+
+        Image level(level_width, level_height, m_format);
+        level.m_gamma = m_gamma;
+        pack_linear(pixels.data(), m_format, level.m_data.data(), count, srgb);
+
+        levels.push_back(std::move(level));
+
+        std::swap(previous, current);
+        width  = level_width;
+        height = level_height;
+    }
+
+    return levels;
+}
+
+} // namespace framework::graphics
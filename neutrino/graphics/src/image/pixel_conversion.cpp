@@ -0,0 +1,584 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include <graphics/src/image/pixel_conversion.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#if defined(__SSSE3__)
+    #include <tmmintrin.h>
+#endif
+
+namespace
+{
+using framework::graphics::Color;
+
+static_assert(sizeof(Color) == 4, "Color is expected to be tightly packed RGBA8.");
+
+// Amount of pixels converted at once by the multi-step converters. Keeps intermediate buffers on the stack.
+inline constexpr std::size_t chunk_size = 256;
+
+using ChunkBuffer = std::array<std::uint8_t, chunk_size * 4>;
+
+inline std::uint16_t load_16(const std::uint8_t* in)
+{
+    std::uint16_t value = 0;
+    std::memcpy(&value, in, sizeof(value));
+    return value;
+}
+
+inline void store_16(std::uint8_t* out, std::uint16_t value)
+{
+    std::memcpy(out, &value, sizeof(value));
+}
+
+inline std::uint16_t big_endian_16(const std::uint8_t* in)
+{
+    return static_cast<std::uint16_t>((in[0] << 8) | in[1]);
+}
+
+void narrow_16_to_8(const std::uint8_t* in, std::uint8_t* out, std::size_t samples_count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 16 <= samples_count; i += 16) {
+        const __m128i first  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+        const __m128i second = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2 + 16));
+
+        const __m128i packed = _mm_packus_epi16(_mm_srli_epi16(first, 8), _mm_srli_epi16(second, 8));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), packed);
+    }
+#endif
+
+    for (; i < samples_count; ++i) {
+        out[i] = static_cast<std::uint8_t>(load_16(in + i * 2) >> 8);
+    }
+}
+
+// Converts big endian samples to the native byte order.
+void swap_bytes_16(const std::uint8_t* in, std::uint8_t* out, std::size_t samples_count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 8 <= samples_count; i += 8) {
+        const __m128i samples = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i * 2),
+                         _mm_or_si128(_mm_slli_epi16(samples, 8), _mm_srli_epi16(samples, 8)));
+    }
+#endif
+
+    for (; i < samples_count; ++i) {
+        store_16(out + i * 2, big_endian_16(in + i * 2));
+    }
+}
+
+template <std::size_t SamplesPerPixel, typename Converter>
+void convert_16_bit(const std::uint8_t* in, Color* out, std::size_t count, Converter convert)
+{
+    ChunkBuffer buffer;
+    static_assert(SamplesPerPixel * chunk_size <= std::tuple_size_v<ChunkBuffer>);
+
+    while (count > 0) {
+        const std::size_t pixels = std::min(count, chunk_size);
+
+        narrow_16_to_8(in, buffer.data(), pixels * SamplesPerPixel);
+        convert(buffer.data(), out, pixels);
+
+        in += pixels * SamplesPerPixel * 2;
+        out += pixels;
+        count -= pixels;
+    }
+}
+
+#if defined(__SSSE3__)
+void shuffle_3_to_4(const std::uint8_t*& in, Color*& out, std::size_t& count, __m128i shuffle_mask)
+{
+    const __m128i alpha = _mm_set1_epi32(static_cast<int>(0xFF000000));
+
+    // Each step reads 16 bytes but consumes only 12 of them, so keep 6 pixels in reserve.
+    while (count >= 6) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle_mask), alpha));
+
+        in += 12;
+        out += 4;
+        count -= 4;
+    }
+}
+#endif
+
+template <bool HasAlpha>
+void swap_red_blue(const std::uint8_t* in, Color* out, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i red_blue_mask = _mm_set1_epi32(0x00FF00FF);
+    const __m128i alpha         = _mm_set1_epi32(HasAlpha ? 0 : static_cast<int>(0xFF000000));
+    for (; i + 4 <= count; i += 4) {
+        const __m128i pixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 4));
+
+        // Swap the blue and red bytes by swapping 16 bit halves of the masked 32 bit lanes.
+        __m128i red_blue = _mm_and_si128(pixels, red_blue_mask);
+        red_blue         = _mm_shufflelo_epi16(red_blue, _MM_SHUFFLE(2, 3, 0, 1));
+        red_blue         = _mm_shufflehi_epi16(red_blue, _MM_SHUFFLE(2, 3, 0, 1));
+
+        const __m128i green_alpha = _mm_or_si128(_mm_andnot_si128(red_blue_mask, pixels), alpha);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(red_blue, green_alpha));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const std::uint8_t* pixel = in + i * 4;
+        out[i] = Color(pixel[2], pixel[1], pixel[0], HasAlpha ? pixel[3] : Color::default_alpha);
+    }
+}
+
+void unpack_indices(const std::uint8_t* in, std::uint8_t* out, std::size_t count, std::uint8_t bit_depth)
+{
+    const std::size_t pixels_in_byte = 8 / bit_depth;
+    const std::uint8_t mask          = static_cast<std::uint8_t>((1 << bit_depth) - 1);
+
+    for (std::size_t i = 0; i < count; ++in) {
+        const std::uint8_t byte = *in;
+        for (std::size_t p = 0; p < pixels_in_byte && i < count; ++p, ++i) {
+            const std::size_t shift = 8 - bit_depth * (p + 1);
+            out[i]                  = static_cast<std::uint8_t>((byte >> shift) & mask);
+        }
+    }
+}
+
+// Calls `store(index, color)` for each of the indices.
+template <typename Store>
+bool lookup_palette(const std::uint8_t* indices,
+                    std::size_t count,
+                    const Color* palette,
+                    std::size_t palette_size,
+                    Store store)
+{
+    if (palette_size < 256 && count > 0 && *std::max_element(indices, indices + count) >= palette_size) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < count; ++i) {
+        store(i, palette[indices[i]]);
+    }
+
+    return true;
+}
+
+template <typename Store>
+bool expand_indices(const std::uint8_t* in,
+                    std::size_t count,
+                    std::uint8_t bit_depth,
+                    const Color* palette,
+                    std::size_t palette_size,
+                    Store store)
+{
+    if (bit_depth == 8) {
+        return lookup_palette(in, count, palette, palette_size, store);
+    }
+
+    std::array<std::uint8_t, chunk_size> indices;
+    const std::size_t bytes_per_chunk = chunk_size * bit_depth / 8;
+
+    for (std::size_t first = 0; first < count; first += chunk_size) {
+        const std::size_t pixels = std::min(count - first, chunk_size);
+
+        unpack_indices(in, indices.data(), pixels, bit_depth);
+
+        auto store_chunk = [&store, first](std::size_t i, const Color& color) { store(first + i, color); };
+        if (!lookup_palette(indices.data(), pixels, palette, palette_size, store_chunk)) {
+            return false;
+        }
+
+        in += bytes_per_chunk;
+    }
+
+    return true;
+}
+
+#pragma region generic conversion
+
+using framework::graphics::PixelFormat;
+
+using Rgba16Buffer = std::array<std::uint16_t, chunk_size * 4>;
+
+inline constexpr std::uint16_t max_16 = 0xFFFF;
+
+inline std::uint16_t expand_8_to_16(std::uint8_t value)
+{
+    return static_cast<std::uint16_t>(value * 257);
+}
+
+inline std::uint16_t luma(const std::uint16_t* rgb)
+{
+    return static_cast<std::uint16_t>((rgb[0] * 77u + rgb[1] * 150u + rgb[2] * 29u + 128u) >> 8);
+}
+
+inline std::uint16_t unit_float_to_16(float value)
+{
+    // Negated comparisons map NaN to zero.
+    if (!(value > 0.0f)) {
+        return 0;
+    }
+
+    return value < 1.0f ? static_cast<std::uint16_t>(std::lround(value * max_16)) : max_16;
+}
+
+// Reads pixels of any format as 16 bit RGBA values.
+void unpack_rgba16(const std::uint8_t* in, PixelFormat format, std::uint16_t* out, std::size_t count)
+{
+    using framework::graphics::details::image::half_to_float;
+
+    switch (format) {
+        case PixelFormat::r8:
+            for (std::size_t i = 0; i < count; ++i, out += 4) {
+                out[0] = out[1] = out[2] = expand_8_to_16(in[i]);
+                out[3]                   = max_16;
+            }
+            break;
+        case PixelFormat::rg8:
+            for (std::size_t i = 0; i < count; ++i, in += 2, out += 4) {
+                out[0] = out[1] = out[2] = expand_8_to_16(in[0]);
+                out[3]                   = expand_8_to_16(in[1]);
+            }
+            break;
+        case PixelFormat::rgb8:
+            for (std::size_t i = 0; i < count; ++i, in += 3, out += 4) {
+                out[0] = expand_8_to_16(in[0]);
+                out[1] = expand_8_to_16(in[1]);
+                out[2] = expand_8_to_16(in[2]);
+                out[3] = max_16;
+            }
+            break;
+        case PixelFormat::rgba8:
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                out[i] = expand_8_to_16(in[i]);
+            }
+            break;
+        case PixelFormat::r16:
+            for (std::size_t i = 0; i < count; ++i, out += 4) {
+                out[0] = out[1] = out[2] = load_16(in + i * 2);
+                out[3]                   = max_16;
+            }
+            break;
+        case PixelFormat::rgba16: std::memcpy(out, in, count * 4 * sizeof(std::uint16_t)); break;
+        case PixelFormat::rgba16f:
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                out[i] = unit_float_to_16(half_to_float(load_16(in + i * 2)));
+            }
+            break;
+    }
+}
+
+// Writes 16 bit RGBA values as pixels of any format.
+void pack_rgba16(const std::uint16_t* in, PixelFormat format, std::uint8_t* out, std::size_t count)
+{
+    using framework::graphics::details::image::float_to_half;
+
+    switch (format) {
+        case PixelFormat::r8:
+            for (std::size_t i = 0; i < count; ++i, in += 4) {
+                out[i] = static_cast<std::uint8_t>(luma(in) >> 8);
+            }
+            break;
+        case PixelFormat::rg8:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 2) {
+                out[0] = static_cast<std::uint8_t>(luma(in) >> 8);
+                out[1] = static_cast<std::uint8_t>(in[3] >> 8);
+            }
+            break;
+        case PixelFormat::rgb8:
+            for (std::size_t i = 0; i < count; ++i, in += 4, out += 3) {
+                out[0] = static_cast<std::uint8_t>(in[0] >> 8);
+                out[1] = static_cast<std::uint8_t>(in[1] >> 8);
+                out[2] = static_cast<std::uint8_t>(in[2] >> 8);
+            }
+            break;
+        case PixelFormat::rgba8:
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                out[i] = static_cast<std::uint8_t>(in[i] >> 8);
+            }
+            break;
+        case PixelFormat::r16:
+            for (std::size_t i = 0; i < count; ++i, in += 4) {
+                store_16(out + i * 2, luma(in));
+            }
+            break;
+        case PixelFormat::rgba16: std::memcpy(out, in, count * 4 * sizeof(std::uint16_t)); break;
+        case PixelFormat::rgba16f:
+            for (std::size_t i = 0; i < count * 4; ++i) {
+                store_16(out + i * 2, float_to_half(static_cast<float>(in[i]) / max_16));
+            }
+            break;
+    }
+}
+
+#pragma endregion
+
+} // namespace
+
+namespace framework::graphics::details::image
+{
+void rgb8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+#if defined(__SSSE3__)
+    shuffle_3_to_4(in, out, count, _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1));
+#endif
+
+    for (std::size_t i = 0; i < count; ++i, in += 3) {
+        out[i] = Color(in[0], in[1], in[2]);
+    }
+}
+
+void bgr8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+#if defined(__SSSE3__)
+    shuffle_3_to_4(in, out, count, _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1));
+#endif
+
+    for (std::size_t i = 0; i < count; ++i, in += 3) {
+        out[i] = Color(in[2], in[1], in[0]);
+    }
+}
+
+void bgra8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+    swap_red_blue<true>(in, out, count);
+}
+
+void bgrx8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+    swap_red_blue<false>(in, out, count);
+}
+
+void grey8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i alpha = _mm_set1_epi8(static_cast<char>(0xFF));
+    for (; i + 16 <= count; i += 16) {
+        const __m128i grey = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i));
+
+        const __m128i grey_grey_low   = _mm_unpacklo_epi8(grey, grey);
+        const __m128i grey_grey_high  = _mm_unpackhi_epi8(grey, grey);
+        const __m128i grey_alpha_low  = _mm_unpacklo_epi8(grey, alpha);
+        const __m128i grey_alpha_high = _mm_unpackhi_epi8(grey, alpha);
+
+        __m128i* destination = reinterpret_cast<__m128i*>(out + i);
+        _mm_storeu_si128(destination + 0, _mm_unpacklo_epi16(grey_grey_low, grey_alpha_low));
+        _mm_storeu_si128(destination + 1, _mm_unpackhi_epi16(grey_grey_low, grey_alpha_low));
+        _mm_storeu_si128(destination + 2, _mm_unpacklo_epi16(grey_grey_high, grey_alpha_high));
+        _mm_storeu_si128(destination + 3, _mm_unpackhi_epi16(grey_grey_high, grey_alpha_high));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        out[i] = Color(in[i], in[i], in[i]);
+    }
+}
+
+void grey_alpha8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i low_byte_mask = _mm_set1_epi16(0x00FF);
+    for (; i + 8 <= count; i += 8) {
+        const __m128i grey_alpha = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + i * 2));
+
+        const __m128i grey      = _mm_and_si128(grey_alpha, low_byte_mask);
+        const __m128i grey_grey = _mm_or_si128(grey, _mm_slli_epi16(grey, 8));
+
+        __m128i* destination = reinterpret_cast<__m128i*>(out + i);
+        _mm_storeu_si128(destination + 0, _mm_unpacklo_epi16(grey_grey, grey_alpha));
+        _mm_storeu_si128(destination + 1, _mm_unpackhi_epi16(grey_grey, grey_alpha));
+    }
+#endif
+
+    for (; i < count; ++i) {
+        const std::uint8_t* pixel = in + i * 2;
+        out[i]                    = Color(pixel[0], pixel[0], pixel[0], pixel[1]);
+    }
+}
+
+void rgba16_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+    convert_16_bit<4>(in, out, count, [](const std::uint8_t* rgba, Color* colors, std::size_t pixels) {
+        std::memcpy(colors, rgba, pixels * sizeof(Color));
+    });
+}
+
+void grey16_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count)
+{
+    convert_16_bit<1>(in, out, count, grey8_to_rgba8);
+}
+
+void grey16be_to_r16(const std::uint8_t* in, std::uint8_t* out, std::size_t count)
+{
+    swap_bytes_16(in, out, count);
+}
+
+void grey_alpha16be_to_rgba16(const std::uint8_t* in, std::uint8_t* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, in += 4, out += 8) {
+        const std::uint16_t grey = big_endian_16(in);
+
+        store_16(out + 0, grey);
+        store_16(out + 2, grey);
+        store_16(out + 4, grey);
+        store_16(out + 6, big_endian_16(in + 2));
+    }
+}
+
+void rgb16be_to_rgba16(const std::uint8_t* in, std::uint8_t* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i, in += 6, out += 8) {
+        store_16(out + 0, big_endian_16(in + 0));
+        store_16(out + 2, big_endian_16(in + 2));
+        store_16(out + 4, big_endian_16(in + 4));
+        store_16(out + 6, max_16);
+    }
+}
+
+void rgba16be_to_rgba16(const std::uint8_t* in, std::uint8_t* out, std::size_t count)
+{
+    swap_bytes_16(in, out, count * 4);
+}
+
+void grey_bits_to_r8(const std::uint8_t* in, std::uint8_t* out, std::size_t count, std::uint8_t bit_depth)
+{
+    unpack_indices(in, out, count, bit_depth);
+
+    const std::uint32_t max_value = (1u << bit_depth) - 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        out[i] = static_cast<std::uint8_t>(out[i] * 0xFFu / max_value);
+    }
+}
+
+bool indexed_to_rgba8(const std::uint8_t* in,
+                      Color* out,
+                      std::size_t count,
+                      std::uint8_t bit_depth,
+                      const Color* palette,
+                      std::size_t palette_size)
+{
+    return expand_indices(in, count, bit_depth, palette, palette_size, [out](std::size_t i, const Color& color) {
+        out[i] = color;
+    });
+}
+
+bool indexed_to_rgb8(const std::uint8_t* in,
+                     std::uint8_t* out,
+                     std::size_t count,
+                     std::uint8_t bit_depth,
+                     const Color* palette,
+                     std::size_t palette_size)
+{
+    return expand_indices(in, count, bit_depth, palette, palette_size, [out](std::size_t i, const Color& color) {
+        out[i * 3 + 0] = color.r;
+        out[i * 3 + 1] = color.g;
+        out[i * 3 + 2] = color.b;
+    });
+}
+
+void convert_pixels(const std::uint8_t* in,
+                    PixelFormat in_format,
+                    std::uint8_t* out,
+                    PixelFormat out_format,
+                    std::size_t count)
+{
+    if (in_format == out_format) {
+        std::memcpy(out, in, count * bytes_per_pixel(in_format));
+        return;
+    }
+
+    if (out_format == PixelFormat::rgba8) {
+        Color* colors = reinterpret_cast<Color*>(out);
+        switch (in_format) {
+            case PixelFormat::r8: return grey8_to_rgba8(in, colors, count);
+            case PixelFormat::rg8: return grey_alpha8_to_rgba8(in, colors, count);
+            case PixelFormat::rgb8: return rgb8_to_rgba8(in, colors, count);
+            case PixelFormat::r16: return grey16_to_rgba8(in, colors, count);
+            case PixelFormat::rgba16: return rgba16_to_rgba8(in, colors, count);
+            case PixelFormat::rgba8:
+            case PixelFormat::rgba16f: break;
+        }
+    }
+
+    const std::size_t in_pixel_size  = bytes_per_pixel(in_format);
+    const std::size_t out_pixel_size = bytes_per_pixel(out_format);
+
+    Rgba16Buffer buffer;
+    while (count > 0) {
+        const std::size_t pixels = std::min(count, chunk_size);
+
+        unpack_rgba16(in, in_format, buffer.data(), pixels);
+        pack_rgba16(buffer.data(), out_format, out, pixels);
+
+        in += pixels * in_pixel_size;
+        out += pixels * out_pixel_size;
+        count -= pixels;
+    }
+}
+
+std::uint16_t float_to_half(float value)
+{
+    std::uint32_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const std::uint16_t sign = static_cast<std::uint16_t>((bits >> 16) & 0x8000);
+    bits &= 0x7FFFFFFF;
+
+    if (bits >= 0x7F800000) {
+        // Infinity or NaN.
+        return static_cast<std::uint16_t>(sign | 0x7C00 | (bits > 0x7F800000 ? 0x0200 : 0));
+    }
+
+    if (bits >= 0x477FF000) {
+        // Rounds to a value greater than the max half value.
+        return static_cast<std::uint16_t>(sign | 0x7C00);
+    }
+
+    if (bits < 0x38800000) {
+        // Subnormal half value is a multiple of 2^-24.
+        float magnitude = 0.0f;
+        std::memcpy(&magnitude, &bits, sizeof(magnitude));
+        return static_cast<std::uint16_t>(sign | static_cast<std::uint16_t>(std::nearbyint(magnitude * 16777216.0f)));
+    }
+
+    // Rebias the exponent and round the mantissa to the nearest even.
+    const std::uint32_t rounded = bits + 0x0FFF + ((bits >> 13) & 1);
+    return static_cast<std::uint16_t>(sign | ((rounded - 0x38000000) >> 13));
+}
+
+float half_to_float(std::uint16_t value)
+{
+    const std::uint32_t sign     = static_cast<std::uint32_t>(value & 0x8000) << 16;
+    const std::uint32_t exponent = (value >> 10) & 0x1F;
+    const std::uint32_t mantissa = value & 0x03FF;
+
+    std::uint32_t bits = sign;
+    if (exponent == 0x1F) {
+        bits |= 0x7F800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits |= ((exponent + 112) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+        const float magnitude = static_cast<float>(mantissa) / 16777216.0f;
+        return sign != 0 ? -magnitude : magnitude;
+    }
+
+    float result = 0.0f;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+} // namespace framework::graphics::details::image
@@ -0,0 +1,67 @@
+#ifndef GRAPHICS_SRC_IMAGE_PIXEL_CONVERSION_HPP
+#define GRAPHICS_SRC_IMAGE_PIXEL_CONVERSION_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <graphics/color.hpp>
+#include <graphics/pixel_format.hpp>
+
+namespace framework::graphics::details::image
+{
+// Bulk row converters. Each function reads `count` pixels from `in` and writes `count` pixels to `out`.
+// Samples with the `be` suffix are 16 bit big endian (PNG byte order), other 16 bit samples are in native byte order.
+
+void rgb8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+void bgr8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+void bgra8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+void bgrx8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+void grey8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+void grey_alpha8_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+
+// 16 bit samples are narrowed to 8 bits by taking the most significant byte.
+void rgba16_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+void grey16_to_rgba8(const std::uint8_t* in, Color* out, std::size_t count);
+
+void grey16be_to_r16(const std::uint8_t* in, std::uint8_t* out, std::size_t count);
+void grey_alpha16be_to_rgba16(const std::uint8_t* in, std::uint8_t* out, std::size_t count);
+void rgb16be_to_rgba16(const std::uint8_t* in, std::uint8_t* out, std::size_t count);
+void rgba16be_to_rgba16(const std::uint8_t* in, std::uint8_t* out, std::size_t count);
+
+/// Scales packed 1, 2 or 4 bit greyscale values to 8 bits. Pixels are packed starting from the most significant bit.
+void grey_bits_to_r8(const std::uint8_t* in, std::uint8_t* out, std::size_t count, std::uint8_t bit_depth);
+
+/// Expands packed 1, 2, 4 or 8 bit palette indices. Pixels are packed starting from the most significant bit.
+///
+/// @return `false` if some index is out of the palette range, the output is undefined in that case.
+bool indexed_to_rgba8(const std::uint8_t* in,
+                      Color* out,
+                      std::size_t count,
+                      std::uint8_t bit_depth,
+                      const Color* palette,
+                      std::size_t palette_size);
+
+/// Same as indexed_to_rgba8, but drops the alpha channel of the palette colors.
+bool indexed_to_rgb8(const std::uint8_t* in,
+                     std::uint8_t* out,
+                     std::size_t count,
+                     std::uint8_t bit_depth,
+                     const Color* palette,
+                     std::size_t palette_size);
+
+/// Converts pixels between any formats.
+///
+/// Greyscale is expanded to all color channels, color is reduced to greyscale by its luma.
+/// Floating point channels are clamped to the [0, 1] range when converted to integer ones.
+void convert_pixels(const std::uint8_t* in,
+                    PixelFormat in_format,
+                    std::uint8_t* out,
+                    PixelFormat out_format,
+                    std::size_t count);
+
+std::uint16_t float_to_half(float value);
+float half_to_float(std::uint16_t value);
+
+} // namespace framework::graphics::details::image
+
+#endif
@@ -1,38 +1,39 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
-#include <fstream>
+#include <cstring>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <common/crc.hpp>
 #include <common/exceptions.hpp>
+#include <common/span.hpp>
 #include <common/utils.hpp>
 #include <common/zlib.hpp>
 
+#include <graphics/src/image/pixel_conversion.hpp>
 #include <graphics/src/image/png.hpp>
 
 namespace
 {
 using namespace framework;
 using graphics::Color;
+using graphics::PixelFormat;
 using graphics::details::image::ImageInfo;
+using graphics::details::image::ImageRegion;
+
+using BytesData = Span<const std::uint8_t>;
 
 inline constexpr size_t signature_length = 8;
 inline constexpr size_t pass_count       = 7;
+inline constexpr size_t ihdr_length      = 13;
 
-std::vector<std::uint8_t> read_bytes(std::ifstream& in, size_t count)
-{
-    std::vector<std::uint8_t> data(count);
-
-    in.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(count));
-
-    if (!in) {
-        return std::vector<std::uint8_t>();
-    }
-
-    return data;
-}
+inline constexpr std::array<std::uint8_t, signature_length> signature =
+{0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a};
 
 #pragma region chunk
 
@@ -65,35 +66,42 @@ struct Chunk
     Type type            = Type::undefined;
     std::uint32_t crc    = 0;
 
-    std::vector<std::uint8_t> data;
+    BytesData data;
 
-    static Chunk read(std::ifstream& in);
+    static Chunk read(BytesData& in);
 
     bool is_critical() const;
     bool is_valid() const;
 };
 
-Chunk Chunk::read(std::ifstream& in)
+// Reads chunk from the beginning of the input and advances the input past it.
+// Truncated chunk is returned with undefined type, and the input is exhausted.
+Chunk Chunk::read(BytesData& in)
 {
-    using std::begin;
-    using std::end;
-
-    char buffer[4] = {0};
+    constexpr std::size_t length_size = 4;
+    constexpr std::size_t type_size   = 4;
+    constexpr std::size_t crc_size    = 4;
+    constexpr std::size_t frame_size  = length_size + type_size + crc_size;
 
     Chunk c;
 
-    in.read(buffer, 4);
-    c.length = utils::big_endian_value<std::uint32_t>(begin(buffer));
-
-    in.read(buffer, 4);
-    c.type = utils::big_endian_value<Chunk::Type>(begin(buffer));
+    if (in.size() < frame_size) {
+        in = BytesData();
+        return c;
+    }
 
-    if (c.length > 0) {
-        c.data = read_bytes(in, c.length);
+    const std::uint32_t length = utils::big_endian_value<std::uint32_t>(in.begin());
+    if (in.size() - frame_size < length) {
+        in = BytesData();
+        return c;
     }
 
-    in.read(buffer, 4);
-    c.crc = utils::big_endian_value<std::uint32_t>(begin(buffer));
+    c.length = length;
+    c.type   = utils::big_endian_value<Chunk::Type>(in.begin() + length_size);
+    c.data   = in.subspan(length_size + type_size, length);
+    c.crc    = utils::big_endian_value<std::uint32_t>(c.data.end());
+
+    in = in.subspan(frame_size + length);
 
     return c;
 }
@@ -154,20 +162,21 @@ struct FileHeader
     FilterMethod filter_method           = FilterMethod::adaptive;
     InterlaceMethod interlace_method     = InterlaceMethod::no;
 
-    static FileHeader read(std::ifstream& in);
+    static FileHeader read(BytesData& in);
 
     bool is_valid() const;
     std::int32_t samples_per_pixel() const;
     std::int32_t bits_per_pixel() const;
     std::int32_t bytes_per_pixel() const;
 
+    PixelFormat pixel_format() const;
     ImageInfo image_info() const;
 };
 
-FileHeader FileHeader::read(std::ifstream& in)
+FileHeader FileHeader::read(BytesData& in)
 {
     auto c = Chunk::read(in);
-    if (c.type != Chunk::Type::IHDR || !c.is_valid()) {
+    if (c.type != Chunk::Type::IHDR || c.data.size() < ihdr_length || !c.is_valid()) {
         return FileHeader();
     }
 
@@ -230,15 +239,33 @@ std::int32_t FileHeader::bytes_per_pixel() const
     return (bits_per_pixel() + 7) / 8;
 }
 
-ImageInfo FileHeader::image_info() const
+// Image keeps the precision and the channels of the file, formats without a 16 bit match are widened to RGBA16.
+PixelFormat FileHeader::pixel_format() const
 {
-    return ImageInfo{static_cast<std::size_t>(width), static_cast<std::size_t>(height), true, {}};
+    const bool is_16_bit = bit_depth == 16;
+
+    switch (color_type) {
+        case ColorType::greyscale: return is_16_bit ? PixelFormat::r16 : PixelFormat::r8;
+        case ColorType::truecolor: return is_16_bit ? PixelFormat::rgba16 : PixelFormat::rgb8;
+        case ColorType::indexed: return PixelFormat::rgb8;
+        case ColorType::greyscale_alpha: return is_16_bit ? PixelFormat::rgba16 : PixelFormat::rg8;
+        case ColorType::truecolor_alpha: return is_16_bit ? PixelFormat::rgba16 : PixelFormat::rgba8;
+    }
+
+    return PixelFormat::rgba8;
 }
 
-bool check_signature(const std::vector<std::uint8_t>& data)
+ImageInfo FileHeader::image_info() const
 {
-    constexpr std::array<std::uint8_t, signature_length> signature = {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a};
+    return ImageInfo{static_cast<std::size_t>(width),
+                     static_cast<std::size_t>(height),
+                     graphics::details::image::default_gamma,
+                     pixel_format(),
+                     {}};
+}
 
+bool check_signature(BytesData data)
+{
     if (data.size() < signature.size()) {
         return false;
     }
@@ -393,119 +420,46 @@ enum class FilterType : std::uint8_t
     peath   = 4
 };
 
-std::tuple<std::vector<std::uint8_t>::iterator, std::vector<std::uint8_t>::iterator> reconstruct_pass(
-std::vector<std::uint8_t>::iterator in,
-std::vector<std::uint8_t>::iterator out,
-const PassInfo& pass,
-std::int32_t bytes_per_pixel)
+void reconstruct_row(FilterType filter_type,
+                     const std::uint8_t* first,
+                     const std::uint8_t* last,
+                     const std::uint8_t* previous,
+                     std::uint8_t* current,
+                     std::size_t bytes_per_pixel)
 {
-    const std::int32_t bytes_in_row        = (pass.bytes_per_scanline + bytes_per_pixel);
-    const size_t result_size               = static_cast<size_t>(bytes_in_row) * (static_cast<size_t>(pass.height) + 1);
-    const std::ptrdiff_t second_row_offset = static_cast<std::ptrdiff_t>(bytes_in_row + bytes_per_pixel);
-
-    std::vector<std::uint8_t> res(result_size, 0);
-
-    auto res_a = next(res.begin(), bytes_in_row);
-    auto res_b = next(res.begin(), bytes_per_pixel);
-    auto res_c = res.begin();
-    auto res_x = next(res.begin(), second_row_offset);
-
-    for (std::int32_t h = 0; h < pass.height;) {
-        const FilterType ft = static_cast<FilterType>(*in++);
+    // Both rows have one zero pixel in front, so `a` and `c` of the first pixel are zeros.
+    const std::uint8_t* a = current;
+    const std::uint8_t* b = previous + bytes_per_pixel;
+    const std::uint8_t* c = previous;
+    std::uint8_t* x       = current + bytes_per_pixel;
 
-        auto last = next(in, pass.bytes_per_scanline);
-
-        switch (ft) {
-            case FilterType::none: std::copy(in, last, res_x); break;
-            case FilterType::sub: reconstruct_sub(in, last, res_a, res_x); break;
-            case FilterType::up: reconstruct_up(in, last, res_b, res_x); break;
-            case FilterType::average: reconstruct_average(in, last, res_a, res_b, res_x); break;
-            case FilterType::peath: reconstruct_peath(in, last, res_a, res_b, res_c, res_x); break;
-        }
-
-        ++h;
-        if (h < pass.height) {
-            advance(res_a, bytes_in_row);
-            advance(res_b, bytes_in_row);
-            advance(res_c, bytes_in_row);
-            advance(res_x, bytes_in_row);
-            in = last;
-        }
+    switch (filter_type) {
+        case FilterType::none: std::copy(first, last, x); return;
+        case FilterType::sub: reconstruct_sub(first, last, a, x); return;
+        case FilterType::up: reconstruct_up(first, last, b, x); return;
+        case FilterType::average: reconstruct_average(first, last, a, b, x); return;
+        case FilterType::peath: reconstruct_peath(first, last, a, b, c, x); return;
     }
 
-    auto it = next(res.begin(), second_row_offset);
-    for (std::int32_t h = 0; h < pass.height;) {
-        auto last = next(it, pass.bytes_per_scanline);
-
-        out = std::copy(it, last, out);
-
-        ++h;
-        if (h < pass.height) {
-            advance(it, bytes_in_row);
-        }
-    }
-
-    return std::make_tuple(in, out);
-}
-
-std::vector<std::uint8_t> reconstruct(const FileHeader& header, std::vector<std::uint8_t>&& data)
-{
-    if (data.empty()) {
-        return std::vector<std::uint8_t>();
-    }
-
-    std::vector<std::uint8_t> res(data.size(), 0);
-
-    auto in  = data.begin();
-    auto out = res.begin();
-    for (const auto& pass : get_pass_info(header)) {
-        std::tie(in, out) = reconstruct_pass(in, out, pass, header.bytes_per_pixel());
-    }
-
-    return res;
+    throw ParsingError(graphics::details::image::error::read_data_error);
 }
 
 #pragma endregion
 
 #pragma region unserialize
 
-template <size_t BitDepth>
-constexpr std::uint8_t sample(size_t input)
-{
-    static_assert(BitDepth < 8);
-    constexpr size_t maxinput  = (1 << BitDepth) - 1;
-    constexpr size_t maxoutput = (1 << 8) - 1;
-    return static_cast<std::uint8_t>(input * maxoutput / maxinput);
-}
-
-template <size_t N, size_t Size = (1 << N)>
-using Palette = std::array<Color, Size>;
+using Palette = std::array<Color, 256>;
 
-template <size_t BitDepth>
-constexpr Palette<BitDepth> greyscale_palette()
+Palette read_palette(const Chunk& chunk)
 {
-    static_assert(BitDepth < 8);
-    Palette<BitDepth> res = {Color(0x000000FFU)};
-
-    for (size_t input = 0; input < res.size(); input++) {
-        const std::uint8_t c = sample<BitDepth>(input);
-        res[input]           = Color(c, c, c, 0xFF);
-    }
-
-    return res;
-}
-
-template <size_t BitDepth>
-Palette<BitDepth> read_palette(const Chunk chunk)
-{
-    static_assert(BitDepth <= 8);
-    Palette<BitDepth> res = {Color(0x000000FFU)};
+    Palette res;
 
     if (chunk.type != Chunk::Type::PLTE || (chunk.data.size() % 3 != 0)) {
         return res;
     }
 
-    for (size_t i = 0; i < chunk.data.size() / 3; ++i) {
+    const std::size_t count = std::min(chunk.data.size() / 3, res.size());
+    for (size_t i = 0; i < count; ++i) {
         res[i].r = chunk.data[i * 3];
         res[i].g = chunk.data[i * 3 + 1];
         res[i].b = chunk.data[i * 3 + 2];
@@ -514,296 +468,366 @@ Palette<BitDepth> read_palette(const Chunk chunk)
     return res;
 }
 
-using SampleTuple = std::tuple<Color, std::vector<std::uint8_t>::iterator>;
-
-template <ColorType CType, std::uint8_t BitDepth>
-inline SampleTuple get_color(std::vector<std::uint8_t>::iterator in);
-
-template <>
-inline SampleTuple get_color<ColorType::greyscale, 8>(std::vector<std::uint8_t>::iterator in)
+void unserialize_row(const FileHeader& header,
+                     const Palette& palette,
+                     const std::uint8_t* in,
+                     std::uint8_t* out,
+                     std::size_t count)
 {
-    const std::uint8_t c = *in++;
-    return std::make_tuple(Color(c, c, c, 0xFF), in);
-}
+    using namespace graphics::details::image;
 
-template <>
-inline SampleTuple get_color<ColorType::greyscale, 16>(std::vector<std::uint8_t>::iterator in)
-{
-    const std::uint8_t c = *in++;
-    in++;
-    return std::make_tuple(Color(c, c, c, 0xFF), in);
-}
-
-template <>
-inline SampleTuple get_color<ColorType::truecolor, 8>(std::vector<std::uint8_t>::iterator in)
-{
-    const std::uint8_t r = *in++;
-    const std::uint8_t g = *in++;
-    const std::uint8_t b = *in++;
+    // 8 bit samples have the same layout in the image.
+    if (header.bit_depth == 8 && header.color_type != ColorType::indexed) {
+        std::memcpy(out, in, count * static_cast<std::size_t>(header.samples_per_pixel()));
+        return;
+    }
 
-    return std::make_tuple(Color(r, g, b, 0xFF), in);
+    switch (header.color_type) {
+        case ColorType::greyscale:
+            if (header.bit_depth < 8) {
+                grey_bits_to_r8(in, out, count, header.bit_depth);
+            } else {
+                grey16be_to_r16(in, out, count);
+            }
+            break;
+        case ColorType::truecolor: rgb16be_to_rgba16(in, out, count); break;
+        case ColorType::indexed:
+            indexed_to_rgb8(in, out, count, header.bit_depth, palette.data(), palette.size());
+            break;
+        case ColorType::greyscale_alpha: grey_alpha16be_to_rgba16(in, out, count); break;
+        case ColorType::truecolor_alpha: rgba16be_to_rgba16(in, out, count); break;
+    }
 }
 
-template <>
-inline SampleTuple get_color<ColorType::truecolor, 16>(std::vector<std::uint8_t>::iterator in)
+// Filters, which predict the scanline from the previous one.
+bool refers_previous_row(std::uint8_t filter_type)
 {
-    const std::uint8_t r = *in++;
-    in++;
-    const std::uint8_t g = *in++;
-    in++;
-    const std::uint8_t b = *in++;
-    in++;
-
-    return std::make_tuple(Color(r, g, b, 0xFF), in);
+    const auto type = static_cast<FilterType>(filter_type);
+    return type != FilterType::none && type != FilterType::sub;
 }
 
-template <>
-inline SampleTuple get_color<ColorType::greyscale_alpha, 8>(std::vector<std::uint8_t>::iterator in)
+// Pixels of the pass scanline, which fall into the region columns.
+struct PassColumns
 {
-    const std::uint8_t c = *in++;
-    const std::uint8_t a = *in++;
-    return std::make_tuple(Color(c, c, c, a), in);
-}
+    std::size_t begin = 0;
+    std::size_t end   = 0;
+};
 
-template <>
-inline SampleTuple get_color<ColorType::greyscale_alpha, 16>(std::vector<std::uint8_t>::iterator in)
+PassColumns get_pass_columns(const PassInfo& pass, const ImageRegion& region)
 {
-    const std::uint8_t c = *in++;
-    in++;
-    const std::uint8_t a = *in++;
-    in++;
-    return std::make_tuple(Color(c, c, c, a), in);
-}
+    const auto position = static_cast<std::size_t>(pass.position.x);
+    const auto offset   = static_cast<std::size_t>(pass.offset.x);
+    const auto width    = static_cast<std::size_t>(pass.width);
 
-template <>
-inline SampleTuple get_color<ColorType::truecolor_alpha, 8>(std::vector<std::uint8_t>::iterator in)
-{
-    const std::uint8_t r = *in++;
-    const std::uint8_t g = *in++;
-    const std::uint8_t b = *in++;
-    const std::uint8_t a = *in++;
+    auto column_index = [&](std::size_t x) {
+        return x > position ? std::min(width, (x - position + offset - 1) / offset) : 0;
+    };
 
-    return std::make_tuple(Color(r, g, b, a), in);
-}
+    PassColumns res{column_index(region.left), column_index(region.right)};
 
-template <>
-inline SampleTuple get_color<ColorType::truecolor_alpha, 16>(std::vector<std::uint8_t>::iterator in)
-{
-    const std::uint8_t r = *in++;
-    in++;
-    const std::uint8_t g = *in++;
-    in++;
-    const std::uint8_t b = *in++;
-    in++;
-    const std::uint8_t a = *in++;
-    in++;
+    // Skips the pass if none of its pixels is on the region step.
+    bool has_pixels = false;
+    for (std::size_t w = res.begin; w < res.end && !has_pixels; ++w) {
+        has_pixels = region.contains_column(position + offset * w);
+    }
 
-    return std::make_tuple(Color(r, g, b, a), in);
+    return has_pixels ? res : PassColumns();
 }
 
-template <ColorType ColorType, std::uint8_t BitDepth>
-inline std::vector<std::uint8_t>::iterator unserialize_pass(std::vector<std::uint8_t>::iterator in,
-                                                            const PassInfo& pass,
-                                                            const FileHeader& header,
-                                                            std::vector<Color>& out)
+// Reconstructs filtered scanlines one by one and converts each of them directly into the resulting image rows.
+// Only scanlines of the region and the ones, which region scanlines are predicted from, are reconstructed.
+// The data is inflated up to the last region scanline, so preview of interlaced image takes only the first pass.
+std::vector<std::uint8_t> unserialize(const FileHeader& header,
+                                      const Chunk& plte_chunk,
+                                      BytesData compressed,
+                                      const ImageRegion& region)
 {
-    static_assert(BitDepth == 8 || BitDepth == 16);
-    for (std::int32_t h = 0; h < pass.height; ++h) {
-        std::uint32_t pos = static_cast<std::uint32_t>(
-        (header.height - 1 - (pass.position.y + pass.offset.y * h)) * header.width + pass.position.x);
-        for (std::int32_t w = 0; w < pass.width; ++w) {
-            std::tie(out[pos], in) = get_color<ColorType, BitDepth>(in);
-            pos += static_cast<std::uint32_t>(pass.offset.x);
-        }
+    const std::vector<PassInfo> passes = get_pass_info(header);
+    const std::size_t bytes_per_pixel  = static_cast<std::size_t>(header.bytes_per_pixel());
+    const std::size_t pixel_size       = graphics::bytes_per_pixel(header.pixel_format());
+    const std::size_t width            = region.width();
+    const std::size_t height           = region.height();
+
+    if (passes.empty()) {
+        throw ParsingError(graphics::details::image::error::read_data_error);
     }
 
-    return in;
-}
+    std::vector<PassColumns> pass_columns;
+    std::vector<std::size_t> pass_offsets;
 
-template <std::uint8_t BitDepth>
-inline std::vector<std::uint8_t>::iterator unserialize_palette_pass(std::vector<std::uint8_t>::iterator in,
-                                                                    const PassInfo& pass,
-                                                                    const FileHeader& header,
-                                                                    const Palette<BitDepth>& palette,
-                                                                    std::vector<Color>& out)
-{
-    static_assert(BitDepth <= 8);
-    constexpr size_t mask = (1 << BitDepth) - 1;
+    std::size_t offset                 = 0;
+    std::size_t required_size          = 0;
+    std::size_t max_bytes_per_scanline = 0;
 
-    for (std::int32_t h = 0; h < pass.height; ++h) {
-        std::uint32_t pos = static_cast<std::uint32_t>(
-        (header.height - 1 - (pass.position.y + pass.offset.y * h)) * header.width + pass.position.x);
-        std::uint8_t byte = 0;
-        for (std::int32_t w = 0, i = 0; w < pass.width; ++w, i = (i + BitDepth) % 8) {
-            if (i == 0) {
-                byte = *in++;
+    for (const auto& pass : passes) {
+        const std::size_t stride = static_cast<std::size_t>(pass.bytes_per_scanline) + 1;
+
+        pass_columns.push_back(get_pass_columns(pass, region));
+        pass_offsets.push_back(offset);
+
+        if (pass_columns.back().begin != pass_columns.back().end) {
+            for (std::int32_t h = 0; h < pass.height; ++h) {
+                if (region.contains_row(static_cast<std::size_t>(pass.position.y + pass.offset.y * h))) {
+                    required_size = std::max(required_size, offset + static_cast<std::size_t>(h + 1) * stride);
+                }
             }
-            out[pos] = palette[(byte >> ((8 - BitDepth) - i)) & mask];
-            pos += static_cast<std::uint32_t>(pass.offset.x);
         }
+
+        offset += static_cast<std::size_t>(pass.height) * stride;
+        max_bytes_per_scanline = std::max(max_bytes_per_scanline, stride - 1);
     }
 
-    return in;
-}
+    const std::vector<std::uint8_t> data = zlib::inflate(compressed, required_size);
+    if (data.size() < required_size) {
+        throw ParsingError(graphics::details::image::error::read_data_error);
+    }
 
-template <ColorType ColorType, std::uint8_t BitDepth>
-inline std::vector<Color> unserialize_impl(const FileHeader& header, std::vector<std::uint8_t>&& data)
-{
-    static_assert(BitDepth == 8 || BitDepth == 16);
+    const Palette palette = header.color_type == ColorType::indexed ? read_palette(plte_chunk) : Palette();
 
-    const size_t result_size = static_cast<size_t>(header.width * header.height);
+    std::vector<std::uint8_t> res(width * height * pixel_size);
+    std::vector<std::uint8_t> rows(2 * (max_bytes_per_scanline + bytes_per_pixel));
+    std::vector<std::uint8_t> pass_row(static_cast<std::size_t>(header.width) * pixel_size);
+    std::vector<bool> reconstruct;
 
-    std::vector<Color> res(result_size, Color(std::uint32_t(0x000000FF)));
+    for (std::size_t i = 0; i < passes.size(); ++i) {
+        const PassInfo& pass                 = passes[i];
+        const PassColumns columns            = pass_columns[i];
+        const std::size_t bytes_per_scanline = static_cast<std::size_t>(pass.bytes_per_scanline);
+        const std::size_t pass_height        = static_cast<std::size_t>(pass.height);
+        const std::uint8_t* pass_data        = data.data() + pass_offsets[i];
 
-    auto in = data.begin();
-    for (const auto& pass : get_pass_info(header)) {
-        in = unserialize_pass<ColorType, BitDepth>(in, pass, header, res);
-    }
+        if (columns.begin == columns.end) {
+            continue;
+        }
 
-    return res;
-}
+        auto row_position = [&pass](std::size_t h) {
+            return static_cast<std::size_t>(pass.position.y) + static_cast<std::size_t>(pass.offset.y) * h;
+        };
 
-template <std::uint8_t BitDepth>
-inline std::vector<Color> unserialize_palette_impl(const FileHeader& header,
-                                                   const Palette<BitDepth>& palette,
-                                                   std::vector<std::uint8_t>&& data)
-{
-    static_assert(BitDepth <= 8);
+        auto column_position = [&pass](std::size_t w) {
+            return static_cast<std::size_t>(pass.position.x) + static_cast<std::size_t>(pass.offset.x) * w;
+        };
+
+        // Walks back from the last region scanline and marks the scanlines, which the next marked one refers to.
+        reconstruct.assign(pass_height, false);
+        bool referenced = false;
+        for (std::size_t h = pass_height; h-- > 0;) {
+            reconstruct[h] = referenced || region.contains_row(row_position(h));
+            referenced     = reconstruct[h] && refers_previous_row(pass_data[h * (bytes_per_scanline + 1)]);
+        }
+
+        // Output pixels of the pass form a continuous span only if the pass has all pixels of the rows.
+        const bool continuous         = pass.offset.x == 1 && region.step == 1 && header.bit_depth >= 8;
+        const std::size_t first_pixel = header.bit_depth >= 8 ? columns.begin : 0;
 
-    const size_t result_size = static_cast<size_t>(header.width * header.height);
+        std::uint8_t* previous = rows.data();
+        std::uint8_t* current  = rows.data() + bytes_per_scanline + bytes_per_pixel;
+        std::fill(rows.begin(), rows.end(), std::uint8_t{0});
 
-    std::vector<Color> res(result_size, Color(std::uint32_t(0x000000FF)));
+        for (std::size_t h = 0; h < pass_height; ++h) {
+            if (!reconstruct[h]) {
+                continue;
+            }
 
-    auto in = data.begin();
-    for (const auto& pass : get_pass_info(header)) {
-        in = unserialize_palette_pass<BitDepth>(in, pass, header, palette, res);
+            const std::uint8_t* in       = pass_data + h * (bytes_per_scanline + 1);
+            const FilterType filter_type = static_cast<FilterType>(*in++);
+            reconstruct_row(filter_type, in, in + bytes_per_scanline, previous, current, bytes_per_pixel);
+
+            const std::size_t y = row_position(h);
+            if (region.contains_row(y)) {
+                const std::size_t row        = height - 1 - (y - region.first_row()) / region.step;
+                const std::uint8_t* scanline = current + bytes_per_pixel + first_pixel * bytes_per_pixel;
+                std::uint8_t* out            = res.data() + row * width * pixel_size;
+
+                if (continuous) {
+                    const std::size_t x = column_position(columns.begin) - region.first_column();
+                    unserialize_row(header, palette, scanline, out + x * pixel_size, columns.end - columns.begin);
+                } else {
+                    unserialize_row(header, palette, scanline, pass_row.data(), columns.end - first_pixel);
+
+                    for (std::size_t w = columns.begin; w < columns.end; ++w) {
+                        const std::size_t x = column_position(w);
+                        if (region.contains_column(x)) {
+                            std::memcpy(out + (x - region.first_column()) / region.step * pixel_size,
+                                        pass_row.data() + (w - first_pixel) * pixel_size,
+                                        pixel_size);
+                        }
+                    }
+                }
+            }
+
+            std::swap(previous, current);
+        }
     }
 
     return res;
 }
 
-inline std::vector<Color> unserialize_greyscale(const FileHeader& header, std::vector<std::uint8_t>&& data)
+#pragma endregion
+
+float decode_gamma(const Chunk& chunk)
 {
-    if (data.empty()) {
-        return std::vector<Color>();
+    if (chunk.type != Chunk::Type::gAMA || chunk.data.size() < 4) {
+        return 1.0f;
     }
 
-    switch (header.bit_depth) {
-        case 1: return unserialize_palette_impl<1>(header, greyscale_palette<1>(), std::move(data));
-        case 2: return unserialize_palette_impl<2>(header, greyscale_palette<2>(), std::move(data));
-        case 4: return unserialize_palette_impl<4>(header, greyscale_palette<4>(), std::move(data));
-        case 8: return unserialize_impl<ColorType::greyscale, 8>(header, std::move(data));
-        case 16: return unserialize_impl<ColorType::greyscale, 16>(header, std::move(data));
-    }
+    const float gamma = static_cast<float>(utils::big_endian_value<std::uint32_t>(chunk.data.begin()));
 
-    return std::vector<Color>();
+    return (gamma / 100000.0f);
 }
 
-inline std::vector<Color> unserialize_truecolor(const FileHeader& header, std::vector<std::uint8_t>&& data)
-{
-    if (data.empty()) {
-        return std::vector<Color>();
-    }
+#pragma region encode
 
-    switch (header.bit_depth) {
-        case 8: return unserialize_impl<ColorType::truecolor, 8>(header, std::move(data));
-        case 16: return unserialize_impl<ColorType::truecolor, 16>(header, std::move(data));
+template <typename T>
+inline void put_big_endian(std::vector<std::uint8_t>& out, T value)
+{
+    const auto unsigned_value = static_cast<std::make_unsigned_t<T>>(value);
+    for (std::size_t i = sizeof(T); i-- > 0;) {
+        out.push_back(static_cast<std::uint8_t>((unsigned_value >> (8 * i)) & 0xFF));
     }
-
-    return std::vector<Color>();
 }
 
-inline std::vector<Color> unserialize_indexed(const FileHeader& header,
-                                              const Chunk& plte_chunk,
-                                              std::vector<std::uint8_t>&& data)
+void write_chunk(std::vector<std::uint8_t>& out, Chunk::Type type, BytesData data)
 {
-    if (data.empty()) {
-        return std::vector<Color>();
-    }
+    put_big_endian(out, static_cast<std::uint32_t>(data.size()));
 
-    switch (header.bit_depth) {
-        case 1: return unserialize_palette_impl<1>(header, read_palette<1>(plte_chunk), std::move(data));
-        case 2: return unserialize_palette_impl<2>(header, read_palette<2>(plte_chunk), std::move(data));
-        case 4: return unserialize_palette_impl<4>(header, read_palette<4>(plte_chunk), std::move(data));
-        case 8: return unserialize_palette_impl<8>(header, read_palette<8>(plte_chunk), std::move(data));
-    }
+    const std::size_t type_offset = out.size();
+    put_big_endian(out, type);
+    out.insert(out.end(), data.begin(), data.end());
 
-    return std::vector<Color>();
+    const std::uint32_t crc = utils::Crc32::calculate(std::next(out.begin(), static_cast<std::ptrdiff_t>(type_offset)),
+                                                      out.end());
+    put_big_endian(out, crc);
 }
 
-inline std::vector<Color> unserialize_greyscale_alpha(const FileHeader& header, std::vector<std::uint8_t>&& data)
+// Filters the row and returns the sum of absolute values of the filtered bytes, taken as signed ones.
+// Both rows have one zero pixel in front, like in the reconstruction.
+template <typename Predictor>
+inline std::uint64_t filter_row(const std::uint8_t* current,
+                                const std::uint8_t* previous,
+                                std::size_t size,
+                                std::size_t bytes_per_pixel,
+                                std::uint8_t* out,
+                                Predictor predictor)
 {
-    if (data.empty()) {
-        return std::vector<Color>();
-    }
+    std::uint64_t sum = 0;
 
-    switch (header.bit_depth) {
-        case 8: return unserialize_impl<ColorType::greyscale_alpha, 8>(header, std::move(data));
-        case 16: return unserialize_impl<ColorType::greyscale_alpha, 16>(header, std::move(data));
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::uint8_t a = current[i - bytes_per_pixel];
+        const std::uint8_t b = previous[i];
+        const std::uint8_t c = previous[i - bytes_per_pixel];
+
+        const std::uint8_t value = static_cast<std::uint8_t>(current[i] - predictor(a, b, c));
+
+        out[i] = value;
+        sum += value < 128 ? value : 256 - value;
     }
 
-    return std::vector<Color>();
+    return sum;
 }
 
-inline std::vector<Color> unserialize_truecolor_alpha(const FileHeader& header, std::vector<std::uint8_t>&& data)
+std::uint64_t filter_row(FilterType filter_type,
+                         const std::uint8_t* current,
+                         const std::uint8_t* previous,
+                         std::size_t size,
+                         std::size_t bytes_per_pixel,
+                         std::uint8_t* out)
 {
-    if (data.empty()) {
-        return std::vector<Color>();
-    }
+    using Byte = std::uint8_t;
 
-    switch (header.bit_depth) {
-        case 8: return unserialize_impl<ColorType::truecolor_alpha, 8>(header, std::move(data));
-        case 16: return unserialize_impl<ColorType::truecolor_alpha, 16>(header, std::move(data));
+    switch (filter_type) {
+        case FilterType::none:
+            return filter_row(current, previous, size, bytes_per_pixel, out, [](Byte, Byte, Byte) { return 0; });
+        case FilterType::sub:
+            return filter_row(current, previous, size, bytes_per_pixel, out, [](Byte a, Byte, Byte) { return a; });
+        case FilterType::up:
+            return filter_row(current, previous, size, bytes_per_pixel, out, [](Byte, Byte b, Byte) { return b; });
+        case FilterType::average:
+            return filter_row(current, previous, size, bytes_per_pixel, out, [](Byte a, Byte b, Byte) {
+                return (static_cast<std::int32_t>(a) + b) >> 1;
+            });
+        case FilterType::peath:
+            return filter_row(current, previous, size, bytes_per_pixel, out, [](Byte a, Byte b, Byte c) {
+                return paeth_predictor(a, b, c);
+            });
     }
 
-    return std::vector<Color>();
+    return 0;
 }
 
-inline std::vector<Color> unserialize(const FileHeader& header,
-                                      const Chunk& plte_chunk,
-                                      std::vector<std::uint8_t>&& data)
+// Converts image rows to the top-down scanlines.
+// With adaptive filtering every row gets the filter type, which gives the minimum sum of absolute differences.
+std::vector<std::uint8_t> serialize(const graphics::details::image::ImageView& image, bool adaptive)
 {
-    switch (header.color_type) {
-        case ColorType::greyscale: return unserialize_greyscale(header, std::move(data));
-        case ColorType::truecolor: return unserialize_truecolor(header, std::move(data));
-        case ColorType::indexed: return unserialize_indexed(header, plte_chunk, std::move(data));
-        case ColorType::greyscale_alpha: return unserialize_greyscale_alpha(header, std::move(data));
-        case ColorType::truecolor_alpha: return unserialize_truecolor_alpha(header, std::move(data));
-    }
+    constexpr std::array<FilterType, 5> filters =
+    {FilterType::none, FilterType::sub, FilterType::up, FilterType::average, FilterType::peath};
 
-    return std::vector<Color>();
-}
+    const std::size_t bytes_per_pixel    = graphics::bytes_per_pixel(image.format);
+    const std::size_t bytes_per_scanline = image.width * bytes_per_pixel;
+    const bool is_16_bit                 = image.format == PixelFormat::r16 || image.format == PixelFormat::rgba16;
 
-#pragma endregion
+    std::vector<std::uint8_t> rows(2 * (bytes_per_scanline + bytes_per_pixel), 0);
+    std::vector<std::uint8_t> filtered(2 * bytes_per_scanline);
 
-float decode_gamma(const Chunk& chunk)
-{
-    if (chunk.type != Chunk::Type::gAMA) {
-        return 1.0f;
-    }
+    std::uint8_t* previous = rows.data() + bytes_per_pixel;
+    std::uint8_t* current  = previous + bytes_per_scanline + bytes_per_pixel;
+    std::uint8_t* best     = filtered.data();
+    std::uint8_t* probe    = best + bytes_per_scanline;
 
-    const float gamma = static_cast<float>(utils::big_endian_value<std::uint32_t>(chunk.data.begin()));
+    std::vector<std::uint8_t> out;
+    out.reserve(image.height * (bytes_per_scanline + 1));
 
-    return (gamma / 100000.0f);
+    for (std::size_t y = 0; y < image.height; ++y) {
+        const std::uint8_t* in = image.data.data() + (image.height - 1 - y) * bytes_per_scanline;
+
+        if (is_16_bit) {
+            // Swapping bytes of each sample converts the native byte order to the big endian one as well.
+            graphics::details::image::grey16be_to_r16(in, current, bytes_per_scanline / 2);
+        } else {
+            std::memcpy(current, in, bytes_per_scanline);
+        }
+
+        FilterType best_filter = FilterType::none;
+
+        if (!adaptive) {
+            filter_row(best_filter, current, previous, bytes_per_scanline, bytes_per_pixel, best);
+        } else {
+            std::uint64_t best_sum = std::numeric_limits<std::uint64_t>::max();
+            for (const auto filter : filters) {
+                const std::uint64_t sum =
+                filter_row(filter, current, previous, bytes_per_scanline, bytes_per_pixel, probe);
+                if (sum < best_sum) {
+                    best_sum    = sum;
+                    best_filter = filter;
+                    std::swap(best, probe);
+                }
+            }
+        }
+
+        out.push_back(static_cast<std::uint8_t>(best_filter));
+        out.insert(out.end(), best, best + bytes_per_scanline);
+
+        std::swap(previous, current);
+    }
+
+    return out;
 }
 
+#pragma endregion
+
 } // namespace
 
 namespace framework::graphics::details::image::png
 {
-ImageInfo load(const std::filesystem::path& filepath)
+ImageInfo load(Span<const std::uint8_t> data, const ImageRegion& region)
 {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    if (!file) {
-        throw ParsingError(error::open_file_error);
-    }
-
-    auto signature = read_bytes(file, signature_length);
-    if (!check_signature(signature)) {
+    if (!check_signature(data)) {
         throw ParsingError(error::invalid_file_signature);
     }
 
-    FileHeader header = FileHeader::read(file);
+    BytesData in = data.subspan(signature_length);
+
+    FileHeader header = FileHeader::read(in);
     if (!header.is_valid()) {
         throw ParsingError(error::read_header_error);
     }
@@ -811,8 +835,12 @@ ImageInfo load(const std::filesystem::path& filepath)
     Chunk plte_chunk;
     float gamma = default_gamma;
 
-    std::vector<std::uint8_t> data;
-    for (Chunk chunk = Chunk::read(file); file && chunk.type != Chunk::Type::IEND; chunk = Chunk::read(file)) {
+    // Single IDAT chunk is inflated right from the input, multiple ones have to be joined.
+    BytesData compressed;
+    std::vector<std::uint8_t> joined;
+
+    Chunk chunk = Chunk::read(in);
+    while (chunk.type != Chunk::Type::undefined && chunk.type != Chunk::Type::IEND) {
         if (!chunk.is_valid() && chunk.is_critical()) {
             throw ParsingError(error::read_data_error);
         }
@@ -823,7 +851,15 @@ ImageInfo load(const std::filesystem::path& filepath)
                 plte_chunk = chunk;
             } break;
             case Chunk::Type::IDAT: {
-                data.insert(end(data), begin(chunk.data), end(chunk.data));
+                if (compressed.empty() && joined.empty()) {
+                    compressed = chunk.data;
+                } else {
+                    if (joined.empty()) {
+                        joined.assign(compressed.begin(), compressed.end());
+                    }
+                    joined.insert(joined.end(), chunk.data.begin(), chunk.data.end());
+                    compressed = joined;
+                }
             } break;
             case Chunk::Type::IEND: break; // end
             case Chunk::Type::cHRM: break; /// ???
@@ -842,9 +878,11 @@ ImageInfo load(const std::filesystem::path& filepath)
             case Chunk::Type::zTXt: break;      // ignore
             case Chunk::Type::undefined: break; // error
         }
+
+        chunk = Chunk::read(in);
     }
 
-    if (data.empty()) {
+    if (compressed.empty()) {
         throw ParsingError(error::read_data_error);
     }
 
@@ -852,19 +890,84 @@ ImageInfo load(const std::filesystem::path& filepath)
         throw ParsingError(error::read_data_error);
     }
 
-    std::vector<std::uint8_t> recontructed = reconstruct(header, zlib::inflate(data));
-    std::vector<Color> image_data          = unserialize(header, plte_chunk, std::move(recontructed));
+    if (region.right > static_cast<std::size_t>(header.width) ||
+        region.bottom > static_cast<std::size_t>(header.height) || region.width() == 0 || region.height() == 0) {
+        throw ParsingError(error::read_data_error);
+    }
 
     ImageInfo info = header.image_info();
+    info.width     = region.width();
+    info.height    = region.height();
     info.gamma     = gamma;
-    info.data      = std::move(image_data);
+    info.data      = unserialize(header, plte_chunk, compressed, region);
     return info;
 }
 
-bool is_png(const std::filesystem::path& filepath)
+ImageInfo read_header(Span<const std::uint8_t> data)
+{
+    if (!check_signature(data)) {
+        throw ParsingError(error::invalid_file_signature);
+    }
+
+    BytesData in = data.subspan(signature_length);
+
+    const FileHeader header = FileHeader::read(in);
+    if (!header.is_valid()) {
+        throw ParsingError(error::read_header_error);
+    }
+
+    return header.image_info();
+}
+
+bool is_png(Span<const std::uint8_t> data)
 {
-    std::ifstream file(filepath, std::ios::in | std::ios::binary);
-    return check_signature(read_bytes(file, signature_length));
+    return check_signature(data);
+}
+
+std::vector<std::uint8_t> encode(const ImageView& image, zlib::CompressionLevel level, std::size_t threads_count)
+{
+    const bool adaptive = level != zlib::CompressionLevel::no_compression;
+
+    auto [bit_depth, color_type] = [format = image.format]() -> std::pair<std::uint8_t, ColorType> {
+        switch (format) {
+            case PixelFormat::r8: return {8, ColorType::greyscale};
+            case PixelFormat::rg8: return {8, ColorType::greyscale_alpha};
+            case PixelFormat::rgb8: return {8, ColorType::truecolor};
+            case PixelFormat::rgba8: return {8, ColorType::truecolor_alpha};
+            case PixelFormat::r16: return {16, ColorType::greyscale};
+            case PixelFormat::rgba16: return {16, ColorType::truecolor_alpha};
+            case PixelFormat::rgba16f: break;
+        }
+
+        throw UnsupportedError("Floating point pixels can't be stored in PNG.");
+    }();
+
+    std::vector<std::uint8_t> header;
+    put_big_endian(header, static_cast<std::uint32_t>(image.width));
+    put_big_endian(header, static_cast<std::uint32_t>(image.height));
+    header.push_back(bit_depth);
+    header.push_back(static_cast<std::uint8_t>(color_type));
+    header.push_back(static_cast<std::uint8_t>(CompressionMethod::deflate_inflate));
+    header.push_back(static_cast<std::uint8_t>(FilterMethod::adaptive));
+    header.push_back(static_cast<std::uint8_t>(InterlaceMethod::no));
+
+    const std::vector<std::uint8_t> compressed = zlib::deflate(serialize(image, adaptive), level, threads_count);
+
+    std::vector<std::uint8_t> out(signature.begin(), signature.end());
+    out.reserve(compressed.size() + 128);
+
+    write_chunk(out, Chunk::Type::IHDR, header);
+
+    if (image.gamma != default_gamma) {
+        std::vector<std::uint8_t> gamma;
+        put_big_endian(gamma, static_cast<std::uint32_t>(std::lround(image.gamma * 100000.0f)));
+        write_chunk(out, Chunk::Type::gAMA, gamma);
+    }
+
+    write_chunk(out, Chunk::Type::IDAT, compressed);
+    write_chunk(out, Chunk::Type::IEND, BytesData());
+
+    return out;
 }
 
 } // namespace framework::graphics::details::image::png
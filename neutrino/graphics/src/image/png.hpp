@@ -1,15 +1,25 @@
 #ifndef GRAPHICS_SRC_IMAGE_PNG_HPP
 #define GRAPHICS_SRC_IMAGE_PNG_HPP
 
-#include <filesystem>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <common/span.hpp>
+#include <common/zlib.hpp>
 
 #include <graphics/src/image/image_info.hpp>
 
 namespace framework::graphics::details::image::png
 {
-ImageInfo load(const std::filesystem::path& filepath);
+// Decodes only the region pixels, the region should be inside the image.
+ImageInfo load(Span<const std::uint8_t> data, const ImageRegion& region);
+
+ImageInfo read_header(Span<const std::uint8_t> data);
+
+bool is_png(Span<const std::uint8_t> data);
 
-bool is_png(const std::filesystem::path& filepath);
+std::vector<std::uint8_t> encode(const ImageView& image, zlib::CompressionLevel level, std::size_t threads_count);
 
 } // namespace framework::graphics::details::image::png
 
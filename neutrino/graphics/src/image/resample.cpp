@@ -0,0 +1,307 @@
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include <graphics/src/image/resample.hpp>
+#include <graphics/src/image/strips.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+using framework::graphics::details::image::ResampleFilter;
+
+inline constexpr double pi = 3.14159265358979323846;
+
+// Filter radiuses in destination pixels.
+inline constexpr double triangle_radius = 1.0;
+inline constexpr double cubic_radius    = 2.0;
+inline constexpr double sinc_radius     = 3.0;
+
+// Shape parameter of the Kaiser window, bigger values give less ringing but more blur.
+inline constexpr double kaiser_alpha = 4.0;
+
+#pragma region Filters
+
+double sinc(double x)
+{
+    if (x == 0.0) {
+        return 1.0;
+    }
+
+    return std::sin(pi * x) / (pi * x);
+}
+
+// Modified Bessel function of the first kind of order zero.
+double bessel_i0(double x)
+{
+    double sum  = 1.0;
+    double term = 1.0;
+
+    for (int k = 1; k < 32 && term > sum * 1e-12; ++k) {
+        const double factor = x / (2.0 * k);
+
+        term *= factor * factor;
+        sum += term;
+    }
+
+    return sum;
+}
+
+double triangle(double x)
+{
+    return std::max(1.0 - std::abs(x), 0.0);
+}
+
+// Catmull-Rom spline, the cubic filter with B = 0 and C = 0.5.
+double cubic(double x)
+{
+    x = std::abs(x);
+
+    if (x < 1.0) {
+        return (1.5 * x - 2.5) * x * x + 1.0;
+    }
+
+    if (x < cubic_radius) {
+        return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+    }
+
+    return 0.0;
+}
+
+double lanczos3(double x)
+{
+    return std::abs(x) < sinc_radius ? sinc(x) * sinc(x / sinc_radius) : 0.0;
+}
+
+double kaiser(double x)
+{
+    static const double normalization = 1.0 / bessel_i0(kaiser_alpha);
+
+    if (std::abs(x) >= sinc_radius) {
+        return 0.0;
+    }
+
+    const double t = x / sinc_radius;
+    return sinc(x) * bessel_i0(kaiser_alpha * std::sqrt(1.0 - t * t)) * normalization;
+}
+
+#pragma endregion
+
+#pragma region Weights
+
+// Source pixels contributing to one destination pixel.
+struct Taps
+{
+    std::size_t first  = 0;
+    std::size_t count  = 0;
+    std::size_t offset = 0; // Offset of the first weight.
+};
+
+struct Weights
+{
+    std::vector<Taps> taps;
+    std::vector<float> values;
+};
+
+void add_taps(Weights& weights, std::size_t first, const std::vector<double>& values)
+{
+    double sum = 0.0;
+    for (double value : values) {
+        sum += value;
+    }
+
+    weights.taps.push_back({first, values.size(), weights.values.size()});
+
+    for (double value : values) {
+        weights.values.push_back(static_cast<float>(sum != 0.0 ? value / sum : value));
+    }
+}
+
+// Box filter takes each source pixel with the weight of its part covered by the destination pixel.
+Weights box_weights(std::size_t in_size, std::size_t out_size)
+{
+    const double scale = static_cast<double>(in_size) / static_cast<double>(out_size);
+
+    Weights weights;
+    std::vector<double> values;
+
+    for (std::size_t i = 0; i < out_size; ++i) {
+        const double begin = static_cast<double>(i) * scale;
+        const double end   = static_cast<double>(i + 1) * scale;
+
+        const auto first = static_cast<std::size_t>(begin);
+        const auto last  = std::min(static_cast<std::size_t>(std::ceil(end)), in_size);
+
+        values.clear();
+        for (std::size_t j = first; j < last; ++j) {
+            values.push_back(std::min(end, static_cast<double>(j + 1)) - std::max(begin, static_cast<double>(j)));
+        }
+
+        add_taps(weights, first, values);
+    }
+
+    return weights;
+}
+
+// Filter kernels are sampled in the centers of the source pixels, out of range pixels are clamped.
+template <typename Kernel>
+Weights kernel_weights(std::size_t in_size, std::size_t out_size, Kernel kernel, double kernel_radius)
+{
+    const double scale        = static_cast<double>(in_size) / static_cast<double>(out_size);
+    const double filter_scale = std::max(scale, 1.0);
+    const double radius       = kernel_radius * filter_scale;
+    const auto last_pixel     = static_cast<std::ptrdiff_t>(in_size) - 1;
+
+    Weights weights;
+    std::vector<double> values;
+
+    for (std::size_t i = 0; i < out_size; ++i) {
+        const double center = (static_cast<double>(i) + 0.5) * scale;
+
+        const auto begin = static_cast<std::ptrdiff_t>(std::floor(center - radius));
+        const auto end   = static_cast<std::ptrdiff_t>(std::ceil(center + radius));
+
+        const std::ptrdiff_t first = std::clamp<std::ptrdiff_t>(begin, 0, last_pixel);
+        const std::ptrdiff_t last  = std::clamp<std::ptrdiff_t>(end, 0, last_pixel);
+
+        values.assign(static_cast<std::size_t>(last - first + 1), 0.0);
+        for (std::ptrdiff_t j = begin; j <= end; ++j) {
+            const double x   = (static_cast<double>(j) + 0.5 - center) / filter_scale;
+            const auto pixel = std::clamp<std::ptrdiff_t>(j, first, last);
+            values[static_cast<std::size_t>(pixel - first)] += kernel(x);
+        }
+
+        add_taps(weights, static_cast<std::size_t>(first), values);
+    }
+
+    return weights;
+}
+
+Weights compute_weights(std::size_t in_size, std::size_t out_size, ResampleFilter filter)
+{
+    switch (filter) {
+        case ResampleFilter::box: return box_weights(in_size, out_size);
+        case ResampleFilter::triangle: return kernel_weights(in_size, out_size, triangle, triangle_radius);
+        case ResampleFilter::cubic: return kernel_weights(in_size, out_size, cubic, cubic_radius);
+        case ResampleFilter::kaiser: return kernel_weights(in_size, out_size, kaiser, sinc_radius);
+        case ResampleFilter::lanczos3: return kernel_weights(in_size, out_size, lanczos3, sinc_radius);
+    }
+
+    return Weights();
+}
+
+#pragma endregion
+
+#pragma region Passes
+
+void filter_row(const float* in, float* out, const Weights& weights)
+{
+    for (const Taps& taps : weights.taps) {
+        const float* pixel  = in + taps.first * 4;
+        const float* values = weights.values.data() + taps.offset;
+
+#if defined(__SSE2__)
+        __m128 sum = _mm_setzero_ps();
+        for (std::size_t k = 0; k < taps.count; ++k, pixel += 4) {
+            sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(pixel), _mm_set1_ps(values[k])));
+        }
+
+        _mm_storeu_ps(out, sum);
+#else
+        float sum[4] = {};
+        for (std::size_t k = 0; k < taps.count; ++k, pixel += 4) {
+            for (std::size_t c = 0; c < 4; ++c) {
+                sum[c] += pixel[c] * values[k];
+            }
+        }
+
+        std::memcpy(out, sum, sizeof(sum));
+#endif
+
+        out += 4;
+    }
+}
+
+// Weighted sum of the source rows, `size` is the number of floats in a row.
+void filter_column(const float* in, std::size_t size, float* out, const Taps& taps, const float* values)
+{
+    std::fill(out, out + size, 0.0f);
+
+    for (std::size_t k = 0; k < taps.count; ++k) {
+        const float* row = in + (taps.first + k) * size;
+
+        std::size_t i = 0;
+
+#if defined(__SSE2__)
+        const __m128 weight = _mm_set1_ps(values[k]);
+        for (; i + 4 <= size; i += 4) {
+            _mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), _mm_mul_ps(_mm_loadu_ps(row + i), weight)));
+        }
+#endif
+
+        for (; i < size; ++i) {
+            out[i] += row[i] * values[k];
+        }
+    }
+}
+
+#pragma endregion
+
+} // namespace
+
+namespace framework::graphics::details::image
+{
+void resample(const float* in,
+              std::size_t in_width,
+              std::size_t in_height,
+              float* out,
+              std::size_t out_width,
+              std::size_t out_height,
+              ResampleFilter filter,
+              ThreadPool* pool)
+{
+    if (in_width == out_width && in_height == out_height) {
+        std::copy(in, in + in_width * in_height * 4, out);
+        return;
+    }
+
+    // Horizontal pass goes first, it makes the rows for the vertical pass shorter when the image is downscaled.
+    std::vector<float> buffer;
+    const float* rows = in;
+
+    if (in_width != out_width) {
+        const Weights weights = compute_weights(in_width, out_width, filter);
+
+        float* horizontal = out;
+        if (in_height != out_height) {
+            buffer.resize(out_width * in_height * 4);
+            horizontal = buffer.data();
+        }
+
+        for_each_strip(in_height, pool, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t y = begin; y < end; ++y) {
+                filter_row(in + y * in_width * 4, horizontal + y * out_width * 4, weights);
+            }
+        });
+
+        rows = horizontal;
+    }
+
+    if (in_height != out_height) {
+        const Weights weights      = compute_weights(in_height, out_height, filter);
+        const std::size_t row_size = out_width * 4;
+
+        for_each_strip(out_height, pool, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t y = begin; y < end; ++y) {
+                const Taps& taps = weights.taps[y];
+                filter_column(rows, row_size, out + y * row_size, taps, weights.values.data() + taps.offset);
+            }
+        });
+    }
+}
+
+} // namespace framework::graphics::details::image
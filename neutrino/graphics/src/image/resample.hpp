@@ -0,0 +1,37 @@
+#ifndef GRAPHICS_SRC_IMAGE_RESAMPLE_HPP
+#define GRAPHICS_SRC_IMAGE_RESAMPLE_HPP
+
+#include <cstddef>
+
+namespace framework
+{
+class ThreadPool;
+} // namespace framework
+
+namespace framework::graphics::details::image
+{
+enum class ResampleFilter
+{
+    box,      // Averages the covered source pixels.
+    triangle, // Linear interpolation, radius 1.
+    cubic,    // Catmull-Rom spline, radius 2.
+    kaiser,   // Kaiser windowed sinc, radius 3.
+    lanczos3, // Lanczos windowed sinc, radius 3.
+};
+
+// Resizes RGBA float image with the separable filter, the image border is clamped.
+// The filter is stretched over the source pixels when the image is downscaled.
+//
+// Rows are split into strips processed by the `pool` threads, nullptr means the current thread.
+void resample(const float* in,
+              std::size_t in_width,
+              std::size_t in_height,
+              float* out,
+              std::size_t out_width,
+              std::size_t out_height,
+              ResampleFilter filter,
+              ThreadPool* pool);
+
+} // namespace framework::graphics::details::image
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef GRAPHICS_SRC_IMAGE_STRIPS_HPP
+#define GRAPHICS_SRC_IMAGE_STRIPS_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <future>
+#include <vector>
+
+#include <common/thread_pool.hpp>
+
+namespace framework::graphics::details::image
+{
+// Minimal number of rows processed by one thread. Smaller strips cost more to schedule than to compute.
+inline constexpr std::size_t min_strip_rows = 8;
+
+// Calls function(begin, end) for strips of rows, in parallel if there is a pool.
+// Each strip is processed by one thread, so the function should not write out of its rows.
+// If the function throws, the first exception is rethrown after all strips are processed.
+template <typename Function>
+void for_each_strip(std::size_t rows_count, ThreadPool* pool, const Function& function)
+{
+    if (pool == nullptr || pool->threads_count() < 2 || rows_count < min_strip_rows * 2) {
+        function(std::size_t{0}, rows_count);
+        return;
+    }
+
+    const std::size_t max_strips   = (rows_count + min_strip_rows - 1) / min_strip_rows;
+    const std::size_t strips_count = std::min(pool->threads_count() * 4, max_strips);
+
+    std::vector<std::future<void>> strips;
+    strips.reserve(strips_count);
+
+    for (std::size_t i = 0; i < strips_count; ++i) {
+        const std::size_t begin = rows_count * i / strips_count;
+        const std::size_t end   = rows_count * (i + 1) / strips_count;
+
+        strips.push_back(pool->submit([&function, begin, end]() { function(begin, end); }));
+    }
+
+    // The strips refer to the function, so all of them are finished before an exception of one of them leaves.
+    for (auto& strip : strips) {
+        strip.wait();
+    }
+
+    for (auto& strip : strips) {
+        strip.get();
+    }
+}
+
+} // namespace framework::graphics::details::image
+
+#endif
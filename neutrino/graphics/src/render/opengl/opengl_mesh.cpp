@@ -122,7 +122,7 @@ GLenum get_opengl_primitive_type(Mesh::PrimitiveType type)
 }
 
 template <typename T>
-void load_data_buffer(GLuint buffer, GLenum buffer_type, const std::vector<T>& data)
+void load_data_buffer(GLuint buffer, GLenum buffer_type, const std::vector<T>& data, std::size_t& capacity)
 {
     if (buffer == 0 || data.empty() || data.size() > max_size) {
         return;
@@ -133,21 +133,25 @@ void load_data_buffer(GLuint buffer, GLenum buffer_type, const std::vector<T>& d
     glBindBuffer(buffer_type, buffer);
     glBufferData(buffer_type, data_size, data.data(), GL_DYNAMIC_DRAW);
     glBindBuffer(buffer_type, 0);
+
+    capacity = static_cast<std::size_t>(data_size);
+}
+
+std::size_t get_indices_count(const Mesh::SubMeshMap& submeshes)
+{
+    return std::accumulate(submeshes.begin(),
+                           submeshes.end(),
+                           std::size_t(0),
+                           [](std::size_t acc, const auto& submesh) { return acc + submesh.second.indices.size(); });
 }
 
-void load_index_buffer(GLuint buffer, GLenum buffer_type, const Mesh::SubMeshMap& submeshes)
+void load_index_buffer(GLuint buffer, GLenum buffer_type, const Mesh::SubMeshMap& submeshes, std::size_t& capacity)
 {
     if (submeshes.empty()) {
         return;
     }
 
-    const std::size_t data_size = std::accumulate(submeshes.begin(),
-                                                  submeshes.end(),
-                                                  std::size_t(0),
-                                                  [](std::size_t acc, const auto& submesh) {
-                                                      return acc + submesh.second.indices.size() *
-                                                                   sizeof(Mesh::IndicesData::value_type);
-                                                  });
+    const std::size_t data_size = get_indices_count(submeshes) * sizeof(Mesh::IndicesData::value_type);
 
     glBindBuffer(buffer_type, buffer);
     glBufferData(buffer_type, static_cast<GLsizeiptr>(data_size), nullptr, GL_DYNAMIC_DRAW);
@@ -160,6 +164,83 @@ void load_index_buffer(GLuint buffer, GLenum buffer_type, const Mesh::SubMeshMap
     }
 
     glBindBuffer(buffer_type, 0);
+
+    capacity = data_size;
+}
+
+// Buffers are reallocated with a spare space, so the data appended next time fits them.
+std::size_t grow_capacity(std::size_t size)
+{
+    return size + size / 2;
+}
+
+// Uploads data starting from the first element, the buffer is reallocated and filled entirely if data doesn't fit it.
+template <typename T>
+void update_data_buffer(GLuint buffer,
+                        GLenum buffer_type,
+                        const std::vector<T>& data,
+                        std::size_t first,
+                        std::size_t& capacity)
+{
+    if (buffer == 0 || data.empty() || data.size() > max_size) {
+        return;
+    }
+
+    const std::size_t data_size = data.size() * sizeof(T);
+
+    glBindBuffer(buffer_type, buffer);
+
+    if (data_size > capacity) {
+        capacity = grow_capacity(data_size);
+        glBufferData(buffer_type, static_cast<GLsizeiptr>(capacity), nullptr, GL_DYNAMIC_DRAW);
+        first = 0;
+    }
+
+    if (first < data.size()) {
+        glBufferSubData(buffer_type,
+                        static_cast<GLintptr>(first * sizeof(T)),
+                        static_cast<GLsizeiptr>((data.size() - first) * sizeof(T)),
+                        data.data() + first);
+    }
+
+    glBindBuffer(buffer_type, 0);
+}
+
+// Indices of submeshes are stored one after another, only the ones starting from the first index are uploaded.
+void update_index_buffer(GLuint buffer,
+                         GLenum buffer_type,
+                         const Mesh::SubMeshMap& submeshes,
+                         std::size_t first_index,
+                         std::size_t& capacity)
+{
+    using IndexType = Mesh::IndicesData::value_type;
+
+    const std::size_t data_size = get_indices_count(submeshes) * sizeof(IndexType);
+
+    glBindBuffer(buffer_type, buffer);
+
+    if (data_size > capacity) {
+        capacity = grow_capacity(data_size);
+        glBufferData(buffer_type, static_cast<GLsizeiptr>(capacity), nullptr, GL_DYNAMIC_DRAW);
+        first_index = 0;
+    }
+
+    std::size_t offset = 0;
+    for (const auto& [_, submesh] : submeshes) {
+        const std::size_t count = submesh.indices.size();
+
+        if (offset + count > first_index) {
+            const std::size_t skip = first_index > offset ? first_index - offset : 0;
+            glBufferSubData(buffer_type,
+                            static_cast<GLintptr>((offset + skip) * sizeof(IndexType)),
+                            static_cast<GLsizeiptr>((count - skip) * sizeof(IndexType)),
+                            submesh.indices.data() + skip);
+        }
+
+        offset += count;
+    }
+
+    glBindBuffer(buffer_type, 0);
 }
 
 } // namespace
@@ -225,18 +306,18 @@ bool OpenglMesh::load(const Mesh& mesh)
     }
 
     // clang-format off
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::position)].buffer,  GL_ARRAY_BUFFER, mesh.vertices());
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::normal)].buffer,    GL_ARRAY_BUFFER, mesh.normals());
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::tangent)].buffer,   GL_ARRAY_BUFFER, mesh.tangents());
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::color)].buffer,     GL_ARRAY_BUFFER, mesh.colors());
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord0)].buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(0));
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord1)].buffer,  GL_ARRAY_BUFFER, mesh.texture_coordinates(1));
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord2)].buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(2));
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord3)].buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(3));
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord4)].buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(4));
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord5)].buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(5));
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord6)].buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(6));
-    load_data_buffer(m_vertex_buffers[static_cast<std::size_t>(Attribute::texcoord7)].buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(7));
+    load_data_buffer(buffer(Attribute::position).buffer,  GL_ARRAY_BUFFER, mesh.vertices(),               buffer(Attribute::position).capacity);
+    load_data_buffer(buffer(Attribute::normal).buffer,    GL_ARRAY_BUFFER, mesh.normals(),                buffer(Attribute::normal).capacity);
+    load_data_buffer(buffer(Attribute::tangent).buffer,   GL_ARRAY_BUFFER, mesh.tangents(),               buffer(Attribute::tangent).capacity);
+    load_data_buffer(buffer(Attribute::color).buffer,     GL_ARRAY_BUFFER, mesh.colors(),                 buffer(Attribute::color).capacity);
+    load_data_buffer(buffer(Attribute::texcoord0).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(0),   buffer(Attribute::texcoord0).capacity);
+    load_data_buffer(buffer(Attribute::texcoord1).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(1),   buffer(Attribute::texcoord1).capacity);
+    load_data_buffer(buffer(Attribute::texcoord2).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(2),   buffer(Attribute::texcoord2).capacity);
+    load_data_buffer(buffer(Attribute::texcoord3).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(3),   buffer(Attribute::texcoord3).capacity);
+    load_data_buffer(buffer(Attribute::texcoord4).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(4),   buffer(Attribute::texcoord4).capacity);
+    load_data_buffer(buffer(Attribute::texcoord5).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(5),   buffer(Attribute::texcoord5).capacity);
+    load_data_buffer(buffer(Attribute::texcoord6).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(6),   buffer(Attribute::texcoord6).capacity);
+    load_data_buffer(buffer(Attribute::texcoord7).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(7),   buffer(Attribute::texcoord7).capacity);
     // clang-format on
 
     if (m_index_buffer.buffer == 0) {
@@ -248,19 +329,54 @@ bool OpenglMesh::load(const Mesh& mesh)
         return false;
     }
 
-    m_index_buffer.submeshes.clear();
-    m_index_buffer.submeshes.reserve(mesh.submeshes().size());
-    for (const auto& [_, submesh] : mesh.submeshes()) {
-        m_index_buffer.submeshes.push_back(
-        {static_cast<GLsizei>(submesh.indices.size()), get_opengl_primitive_type(submesh.primitive_type)});
+    set_submeshes(mesh);
+
+    load_index_buffer(m_index_buffer.buffer, GL_ELEMENT_ARRAY_BUFFER, mesh.submeshes(), m_index_buffer.capacity);
+
+    glBindVertexArray(0);
+
+    return is_valid();
+}
+
+bool OpenglMesh::update(const Mesh& mesh, std::size_t first_vertex, std::size_t first_index)
+{
+    if (!is_valid()) {
+        return load(mesh);
     }
 
-    static_assert(std::is_same_v<std::uint32_t, Mesh::IndicesData::value_type>,
-                  "Type of indices is changed, update the type field below.");
+    // New attributes need new buffers.
+    for (const auto& attrib : attributes_list) {
+        const auto size = get_data_size(attrib, mesh);
 
-    m_index_buffer.type = static_cast<GLenum>(GL_UNSIGNED_INT);
+        if (size != 0 && size < max_size && buffer(attrib).buffer == 0) {
+            return load(mesh);
+        }
+    }
+
+    glBindVertexArray(m_vertex_array);
+
+    // clang-format off
+    update_data_buffer(buffer(Attribute::position).buffer,  GL_ARRAY_BUFFER, mesh.vertices(),             first_vertex, buffer(Attribute::position).capacity);
+    update_data_buffer(buffer(Attribute::normal).buffer,    GL_ARRAY_BUFFER, mesh.normals(),              first_vertex, buffer(Attribute::normal).capacity);
+    update_data_buffer(buffer(Attribute::tangent).buffer,   GL_ARRAY_BUFFER, mesh.tangents(),             first_vertex, buffer(Attribute::tangent).capacity);
+    update_data_buffer(buffer(Attribute::color).buffer,     GL_ARRAY_BUFFER, mesh.colors(),               first_vertex, buffer(Attribute::color).capacity);
+    update_data_buffer(buffer(Attribute::texcoord0).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(0), first_vertex, buffer(Attribute::texcoord0).capacity);
+    update_data_buffer(buffer(Attribute::texcoord1).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(1), first_vertex, buffer(Attribute::texcoord1).capacity);
+    update_data_buffer(buffer(Attribute::texcoord2).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(2), first_vertex, buffer(Attribute::texcoord2).capacity);
+    update_data_buffer(buffer(Attribute::texcoord3).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(3), first_vertex, buffer(Attribute::texcoord3).capacity);
+    update_data_buffer(buffer(Attribute::texcoord4).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(4), first_vertex, buffer(Attribute::texcoord4).capacity);
+    update_data_buffer(buffer(Attribute::texcoord5).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(5), first_vertex, buffer(Attribute::texcoord5).capacity);
+    update_data_buffer(buffer(Attribute::texcoord6).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(6), first_vertex, buffer(Attribute::texcoord6).capacity);
+    update_data_buffer(buffer(Attribute::texcoord7).buffer, GL_ARRAY_BUFFER, mesh.texture_coordinates(7), first_vertex, buffer(Attribute::texcoord7).capacity);
+    // clang-format on
+
+    set_submeshes(mesh);
 
-    load_index_buffer(m_index_buffer.buffer, GL_ELEMENT_ARRAY_BUFFER, mesh.submeshes());
+    update_index_buffer(m_index_buffer.buffer,
+                        GL_ELEMENT_ARRAY_BUFFER,
+                        mesh.submeshes(),
+                        first_index,
+                        m_index_buffer.capacity);
 
     glBindVertexArray(0);
 
@@ -289,6 +405,26 @@ bool OpenglMesh::is_valid() const
     return m_vertex_array != 0 && m_index_buffer.buffer != 0 && !m_index_buffer.submeshes.empty();
 }
 
+void OpenglMesh::set_submeshes(const Mesh& mesh)
+{
+    m_index_buffer.submeshes.clear();
+    m_index_buffer.submeshes.reserve(mesh.submeshes().size());
+    for (const auto& [_, submesh] : mesh.submeshes()) {
+        m_index_buffer.submeshes.push_back(
+        {static_cast<GLsizei>(submesh.indices.size()), get_opengl_primitive_type(submesh.primitive_type)});
+    }
+
+    static_assert(std::is_same_v<std::uint32_t, Mesh::IndicesData::value_type>,
+                  "Type of indices is changed, update the type field below.");
+
+    m_index_buffer.type = static_cast<GLenum>(GL_UNSIGNED_INT);
+}
+
+OpenglMesh::VertexBufferInfo& OpenglMesh::buffer(Attribute attribute)
+{
+    return m_vertex_buffers[static_cast<std::size_t>(attribute)];
+}
+
 void OpenglMesh::enable_attribute(Attribute attribute) const
 {
     const GLuint attr_index      = static_cast<GLuint>(attribute);
@@ -2,6 +2,7 @@
 #define GRAPHICS_SRC_RENDER_OPENGL_OPENGL_MESH_HPP
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 
@@ -19,6 +20,7 @@ public:
         std::uint32_t buffer = 0;
         unsigned int type    = 0;
         int component_size   = 0; /// < Specifies the number of components per  vertex attribute. Must be 1, 2, 3, 4.
+        std::size_t capacity = 0; /// < Allocated size in bytes.
     };
 
     struct SubMeshInfo
@@ -31,6 +33,7 @@ public:
     {
         std::uint32_t buffer = 0;
         unsigned int type    = 0;
+        std::size_t capacity = 0;
         std::vector<SubMeshInfo> submeshes;
     };
 
@@ -45,6 +48,7 @@ public:
     ~OpenglMesh();
 
     bool load(const Mesh& mesh);
+    bool update(const Mesh& mesh, std::size_t first_vertex, std::size_t first_index);
     void clear();
 
     void draw() const;
@@ -52,6 +56,8 @@ public:
 
 private:
     void enable_attribute(Attribute attribute) const;
+    void set_submeshes(const Mesh& mesh);
+    VertexBufferInfo& buffer(Attribute attribute);
 
     std::uint32_t m_vertex_array = 0;
     IndexBufferInfo m_index_buffer;
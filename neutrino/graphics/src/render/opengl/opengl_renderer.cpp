@@ -136,6 +136,21 @@ bool OpenglRenderer::load(ResourceId res_id, const Mesh& mesh)
     return loaded;
 }
 
+bool OpenglRenderer::update(ResourceId res_id, const Mesh& mesh, std::size_t first_vertex, std::size_t first_index)
+{
+    const bool updated = m_meshes[res_id].update(mesh, first_vertex, first_index);
+    if (!updated) {
+        m_meshes.erase(res_id);
+        log::error(tag) << "Failed to update Mesh: " << res_id;
+    }
+
+    if (HAS_OPENGL_ERRORS()) {
+        return false;
+    }
+
+    return updated;
+}
+
 bool OpenglRenderer::load(ResourceId res_id, const Shader& shader)
 {
     const bool loaded = m_shaders[res_id].load(shader);
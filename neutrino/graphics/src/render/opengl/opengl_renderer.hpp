@@ -36,6 +36,8 @@ public:
     bool load(ResourceId res_id, const Shader& shader) override;
     bool load(ResourceId res_id, const Texture& texture) override;
 
+    bool update(ResourceId res_id, const Mesh& mesh, std::size_t first_vertex, std::size_t first_index) override;
+
     void start_frame() override;
     void render(const Renderer::Command& command) override;
     void end_frame() override;
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cstdint>
 
 #include <graphics/texture.hpp>
@@ -13,6 +14,9 @@ using namespace framework::graphics::details::opengl;
 
 namespace
 {
+// Initial value of GL_TEXTURE_MAX_LEVEL.
+constexpr GLint default_max_level = 1000;
+
 int convert_min_filter(Texture::MinFilter filter) noexcept
 {
     switch (filter) {
@@ -48,6 +52,85 @@ int convert_wrap_parameter(Texture::Wrap wrap) noexcept
 
     return 0;
 }
+
+struct TextureFormat
+{
+    GLint internal_format = GL_RGBA8;
+    GLenum format         = GL_RGBA;
+    GLenum type           = GL_UNSIGNED_BYTE;
+};
+
+TextureFormat convert_pixel_format(PixelFormat format) noexcept
+{
+    switch (format) {
+        case PixelFormat::r8: return {GL_R8, GL_RED, GL_UNSIGNED_BYTE};
+        case PixelFormat::rg8: return {GL_RG8, GL_RG, GL_UNSIGNED_BYTE};
+        case PixelFormat::rgb8: return {GL_RGB8, GL_RGB, GL_UNSIGNED_BYTE};
+        case PixelFormat::rgba8: return {GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE};
+        case PixelFormat::r16: return {GL_R16, GL_RED, GL_UNSIGNED_SHORT};
+        case PixelFormat::rgba16: return {GL_RGBA16, GL_RGBA, GL_UNSIGNED_SHORT};
+        case PixelFormat::rgba16f: return {GL_RGBA16F, GL_RGBA, GL_HALF_FLOAT};
+    }
+
+    return TextureFormat();
+}
+
+// Greyscale formats are sampled as RGBA, like the colors they were expanded to before.
+void set_swizzle(PixelFormat format) noexcept
+{
+    const GLint grey[]       = {GL_RED, GL_RED, GL_RED, GL_ONE};
+    const GLint grey_alpha[] = {GL_RED, GL_RED, GL_RED, GL_GREEN};
+    const GLint rgba[]       = {GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA};
+
+    switch (format) {
+        case PixelFormat::r8:
+        case PixelFormat::r16: glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, grey); break;
+        case PixelFormat::rg8: glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, grey_alpha); break;
+        case PixelFormat::rgb8:
+        case PixelFormat::rgba8:
+        case PixelFormat::rgba16:
+        case PixelFormat::rgba16f: glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, rgba); break;
+    }
+}
+
+void upload_image(GLint level, const Image& image, const TextureFormat& format) noexcept
+{
+    glTexImage2D(GL_TEXTURE_2D,
+                 level,
+                 format.internal_format,
+                 static_cast<GLsizei>(image.width()),
+                 static_cast<GLsizei>(image.height()),
+                 0,
+                 format.format,
+                 format.type,
+                 image.bytes().data());
+}
+
+// Uploads precomputed mipmaps up to the first level, which doesn't fit the chain.
+//
+// Returns the number of uploaded levels.
+GLint upload_mipmaps(const Texture& texture, const TextureFormat& format)
+{
+    const Image& image = texture.image();
+
+    std::size_t width  = image.width();
+    std::size_t height = image.height();
+
+    GLint level = 0;
+    for (const Image& mipmap : texture.mipmaps()) {
+        width  = std::max<std::size_t>(width / 2, 1);
+        height = std::max<std::size_t>(height / 2, 1);
+
+        if (mipmap.width() != width || mipmap.height() != height || mipmap.format() != image.format()) {
+            log::warning("OpenGL") << "Mipmap level " << level + 1 << " doesn't fit the texture image.";
+            break;
+        }
+
+        upload_image(++level, mipmap, format);
+    }
+
+    return level;
+}
 } // namespace
 
 namespace framework::graphics
@@ -85,17 +168,24 @@ bool OpenglTexture::load(const Texture& texture)
     Colorf c = static_cast<Colorf>(texture.border_color());
     glTexParameterfv(GL_TEXTURE_2D, GL_TEXTURE_BORDER_COLOR, c.data());
 
-    glTexImage2D(GL_TEXTURE_2D,
-                 0,
-                 GL_RGBA,
-                 static_cast<GLsizei>(texture.image().width()),
-                 static_cast<GLsizei>(texture.image().height()),
-                 0,
-                 GL_RGBA,
-                 GL_UNSIGNED_BYTE,
-                 texture.image().data().data());
+    const Image& image         = texture.image();
+    const TextureFormat format = convert_pixel_format(image.format());
+
+    set_swizzle(image.format());
+
+    // Image rows are tightly packed.
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    upload_image(0, image, format);
+
+    if (texture.mipmaps().empty()) {
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, default_max_level);
+        glGenerateMipmap(GL_TEXTURE_2D);
+    } else {
+        // Limits the texture to the uploaded levels, so it's complete even without the smallest ones.
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, upload_mipmaps(texture, format));
+    }
 
-    glGenerateMipmap(GL_TEXTURE_2D);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
     glBindTexture(GL_TEXTURE_2D, 0);
 
     if (HAS_OPENGL_ERRORS()) {
@@ -125,6 +125,17 @@ bool Renderer::load(ResourceId res_id, const Mesh& mesh)
     return m_impl->load(res_id, mesh);
 }
 
+bool Renderer::update(ResourceId res_id, const Mesh& mesh, std::size_t first_vertex, std::size_t first_index)
+{
+    if (mesh.submeshes().empty()) {
+        // Can't load mesh without sub meshes.
+        return false;
+    }
+
+    m_context.get().make_current();
+    return m_impl->update(res_id, mesh, first_vertex, first_index);
+}
+
 bool Renderer::load(ResourceId res_id, const Shader& shader)
 {
     m_context.get().make_current();
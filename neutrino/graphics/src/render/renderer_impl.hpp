@@ -29,6 +29,11 @@ public:
     virtual bool load(Renderer::ResourceId res_id, const Shader& shader)   = 0;
     virtual bool load(Renderer::ResourceId res_id, const Texture& texture) = 0;
 
+    virtual bool update(Renderer::ResourceId res_id,
+                        const Mesh& mesh,
+                        std::size_t first_vertex,
+                        std::size_t first_index) = 0;
+
     virtual void start_frame()                            = 0;
     virtual void render(const Renderer::Command& command) = 0;
     virtual void end_frame()                              = 0;
@@ -1,3 +1,5 @@
+#include <utility>
+
 #include <graphics/texture.hpp>
 
 #include <graphics/src/opengl/opengl.hpp>
@@ -7,6 +9,7 @@ namespace framework::graphics
 
 Texture::Texture(const Texture& other)
     : m_image(other.m_image)
+    , m_mipmaps(other.m_mipmaps)
     , m_wrap_s(other.m_wrap_s)
     , m_wrap_t(other.m_wrap_t)
     , m_border_color(other.m_border_color)
@@ -37,12 +40,19 @@ Texture& Texture::operator=(Texture&& other) noexcept
 void Texture::set_image(const Image& image)
 {
     m_image = image;
+    m_mipmaps.clear();
 }
 
 void Texture::set_image(Image&& image)
 {
     using std::swap;
     swap(m_image, image);
+    m_mipmaps.clear();
+}
+
+void Texture::set_mipmaps(std::vector<Image> mipmaps)
+{
+    m_mipmaps = std::move(mipmaps);
 }
 
 void Texture::set_wrap_s_parameter(Wrap wrap)
@@ -76,6 +86,7 @@ void Texture::clear()
 
     Image tmp;
     swap(m_image, tmp);
+    m_mipmaps.clear();
 
     m_wrap_s = Wrap::repeat;
     m_wrap_t = Wrap::repeat;
@@ -91,6 +102,11 @@ const Image& Texture::image() const
     return m_image;
 }
 
+const std::vector<Image>& Texture::mipmaps() const
+{
+    return m_mipmaps;
+}
+
 Texture::Wrap Texture::wrap_s_parameter() const
 {
     return m_wrap_s;
@@ -120,6 +136,7 @@ void swap(Texture& lhs, Texture& rhs) noexcept
 {
     using std::swap;
     swap(lhs.m_image, rhs.m_image);
+    swap(lhs.m_mipmaps, rhs.m_mipmaps);
 
     swap(lhs.m_wrap_s, rhs.m_wrap_s);
     swap(lhs.m_wrap_t, rhs.m_wrap_t);
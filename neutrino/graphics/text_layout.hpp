@@ -0,0 +1,169 @@
+#ifndef GRAPHICS_TEXT_LAYOUT_HPP
+#define GRAPHICS_TEXT_LAYOUT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <graphics/font.hpp>
+#include <graphics/mesh.hpp>
+
+namespace framework::graphics
+{
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup graphics_font_module
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Multiline text mesh, which is updated incrementally.
+///
+/// Each line keeps its glyphs, so only edited lines are decoded from UTF-8 and mapped to glyphs again.
+/// The mesh is rebuilt starting from the first changed line, lines above it keep their vertices and indices.
+/// Appending lines, as in a chat log, or typing on the last line of a text field changes only the end of the mesh,
+/// which can be uploaded to the renderer without the rest of the text:
+/// @code
+/// TextLayout layout(font);
+/// layout.set_text("Hello\nWorld");
+/// layout.update();
+/// renderer.load(text_id, layout.mesh());
+///
+/// layout.append_line("New message");
+/// const TextLayout::Changes changes = layout.update();
+/// renderer.update(text_id, layout.mesh(), changes.first_vertex, changes.first_index);
+/// @endcode
+///
+/// The mesh is the same as Font::create_text_mesh makes for each line. The first line baseline is at y = 0,
+/// next lines go down by the line spacing.
+class TextLayout
+{
+public:
+    /// @brief Part of the mesh changed by the update.
+    ///
+    /// Vertices and indices before the first changed ones are the same as before the update.
+    struct Changes
+    {
+        std::size_t first_vertex = 0; ///< First changed vertex.
+        std::size_t first_index  = 0; ///< First changed index of the triangles submesh.
+    };
+
+    /// @brief Creates empty layout.
+    ///
+    /// @param font Font to make the text mesh. Must outlive the layout.
+    explicit TextLayout(const Font& font);
+
+    TextLayout(const TextLayout& other);
+    TextLayout(TextLayout&& other) noexcept;
+
+    ~TextLayout();
+
+    TextLayout& operator=(const TextLayout& other);
+    TextLayout& operator=(TextLayout&& other) noexcept;
+
+    /// @brief Set the whole text.
+    ///
+    /// Lines before the first changed one keep their glyphs.
+    ///
+    /// @param text Text in UTF-8, lines are separated by '\n'.
+    void set_text(const std::string& text);
+
+    /// @brief Replace line text.
+    ///
+    /// @param index Line index.
+    /// @param text Line text in UTF-8 without line breaks.
+    ///
+    /// @throw std::out_of_range if there is no line with such index.
+    void set_line(std::size_t index, const std::string& text);
+
+    /// @brief Insert new line before the line at index.
+    ///
+    /// @param index Line index, equal to the lines count to append the line.
+    /// @param text Line text in UTF-8 without line breaks.
+    ///
+    /// @throw std::out_of_range if index is greater than the lines count.
+    void insert_line(std::size_t index, const std::string& text);
+
+    /// @brief Add new line after the last one.
+    ///
+    /// @param text Line text in UTF-8 without line breaks.
+    void append_line(const std::string& text);
+
+    /// @brief Remove line.
+    ///
+    /// @param index Line index.
+    ///
+    /// @throw std::out_of_range if there is no line with such index.
+    void erase_line(std::size_t index);
+
+    /// @brief Remove all lines.
+    void clear();
+
+    /// @brief Get lines count.
+    ///
+    /// @return Lines count.
+    std::size_t lines_count() const;
+
+    /// @brief Get line text.
+    ///
+    /// @param index Line index.
+    ///
+    /// @return Line text in UTF-8.
+    ///
+    /// @throw std::out_of_range if there is no line with such index.
+    const std::string& line(std::size_t index) const;
+
+    /// @brief Get the whole text.
+    ///
+    /// @return Lines joined with '\n'.
+    std::string text() const;
+
+    /// @brief Set distance between baselines of the lines.
+    ///
+    /// @param spacing Line spacing in em units. Zero to use the font line spacing.
+    void set_line_spacing(float spacing);
+
+    /// @brief Get distance between baselines of the lines.
+    ///
+    /// @return Line spacing in em units, zero if the font line spacing is used.
+    float line_spacing() const;
+
+    /// @brief Rebuild the changed part of the mesh.
+    ///
+    /// Lines are mapped to glyphs again if the font is reloaded.
+    ///
+    /// @return Part of the mesh changed since the previous update.
+    ///
+    /// @throw std::runtime_error if the font is not loaded.
+    Changes update();
+
+    /// @brief Get text mesh.
+    ///
+    /// The mesh has one triangles submesh, it's rebuilt by `update` only.
+    ///
+    /// @return Text mesh.
+    const Mesh& mesh() const;
+
+private:
+    struct Line;
+
+    void invalidate(std::size_t first_line);
+
+    std::reference_wrapper<const Font> m_font;
+    std::uint64_t m_font_generation = 0;
+
+    std::vector<Line> m_lines;
+    std::size_t m_first_changed_line = 0;
+    float m_line_spacing             = 0.0f;
+
+    Mesh m_mesh;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::graphics
+
+#endif
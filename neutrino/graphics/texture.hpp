@@ -1,6 +1,8 @@
 #ifndef GRAPHICS_TEXTURE_HPP
 #define GRAPHICS_TEXTURE_HPP
 
+#include <vector>
+
 #include <graphics/image.hpp>
 
 namespace framework::graphics
@@ -70,14 +72,29 @@ public:
 
     /// @brief Set image to Texture.
     ///
+    /// Removes the mipmaps of the previous image.
+    ///
     /// @param image New texture image.
     void set_image(const Image& image);
 
     /// @brief Set image to Texture.
     ///
+    /// Removes the mipmaps of the previous image.
+    ///
     /// @param image New texture image.
     void set_image(Image&& image);
 
+    /// @brief Set precomputed mipmap levels.
+    ///
+    /// Levels are uploaded as they are instead of generating them on the GPU.
+    /// Each level should be half the size of the previous one and have the pixel format of the image,
+    /// the upload stops at the first level which doesn't fit.
+    ///
+    /// @param mipmaps Mipmap levels without the image itself, from the biggest to the smallest one.
+    ///
+    /// @see Image::generate_mipmaps.
+    void set_mipmaps(std::vector<Image> mipmaps);
+
     /// @brief Set the Texture wrap parameter for the S axis.
     ///
     /// @param wrap New parameter value.
@@ -117,6 +134,11 @@ public:
     /// @return Texture image.
     const Image& image() const;
 
+    /// @brief Get the precomputed mipmap levels.
+    ///
+    /// @return Mipmap levels, empty if mipmaps are generated on the GPU.
+    const std::vector<Image>& mipmaps() const;
+
     /// @brief Get the Texture wrap parameter for the S axis.
     ///
     /// @return The wrap parametr value.
@@ -146,6 +168,7 @@ private:
     friend void swap(Texture& lhs, Texture& rhs) noexcept;
 
     Image m_image;
+    std::vector<Image> m_mipmaps;
 
     Wrap m_wrap_s = Wrap::repeat;
     Wrap m_wrap_t = Wrap::repeat;
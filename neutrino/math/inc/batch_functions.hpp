@@ -0,0 +1,149 @@
+#ifndef MATH_INC_BATCH_FUNCTIONS_HPP
+#define MATH_INC_BATCH_FUNCTIONS_HPP
+
+#include <cstddef>
+
+#include <common/span.hpp>
+#include <common/thread_pool.hpp>
+#include <math/inc/matrix_type.hpp>
+#include <math/inc/quaternion_type.hpp>
+#include <math/inc/vector_type.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_batch_functions
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Structure of arrays view of 3d vectors.
+///
+/// Each component is stored in its own array, all arrays should have the same size.
+template <typename T>
+struct Vector3Span
+{
+    Span<T> x; ///< X components.
+    Span<T> y; ///< Y components.
+    Span<T> z; ///< Z components.
+
+    /// @brief Number of vectors.
+    ///
+    /// @return Number of vectors in the view.
+    constexpr std::size_t size() const noexcept
+    {
+        return x.size();
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Batch functions
+///
+/// Functions process the arrays with SSE instructions if they are enabled.
+///
+/// The result can be the same array as the source one. Source and result arrays should have the same size.
+///
+/// With the pool the arrays are split into chunks, which are processed in parallel. The calling thread
+/// processes one of the chunks and waits for the others, so functions should not be called from a task of the
+/// same pool. Small arrays are processed in the calling thread.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Transforms points.
+///
+/// Points are multiplied by the matrix as 4d vectors with w = 1, w of the product is dropped.
+///
+/// @param m Transformation matrix.
+/// @param points Points to transform.
+/// @param result Transformed points.
+/// @param pool Pool to process the points in parallel, can be null.
+void transform_points(const Matrix<4, 4, float>& m,
+                      Span<const Vector<3, float>> points,
+                      Span<Vector<3, float>> result,
+                      ThreadPool* pool = nullptr);
+
+/// @copydoc transform_points
+void transform_points(const Matrix<4, 4, float>& m,
+                      Vector3Span<const float> points,
+                      Vector3Span<float> result,
+                      ThreadPool* pool = nullptr);
+
+/// @brief Transforms directions.
+///
+/// Directions are multiplied by the matrix as 4d vectors with w = 0, so they are not translated.
+/// Normals should be transformed by the inverse transpose of the matrix and normalized after that.
+///
+/// @param m Transformation matrix.
+/// @param directions Directions to transform.
+/// @param result Transformed directions.
+/// @param pool Pool to process the directions in parallel, can be null.
+void transform_directions(const Matrix<4, 4, float>& m,
+                          Span<const Vector<3, float>> directions,
+                          Span<Vector<3, float>> result,
+                          ThreadPool* pool = nullptr);
+
+/// @copydoc transform_directions
+void transform_directions(const Matrix<4, 4, float>& m,
+                          Vector3Span<const float> directions,
+                          Vector3Span<float> result,
+                          ThreadPool* pool = nullptr);
+
+/// @brief Transforms 4d vectors.
+///
+/// @param m Transformation matrix.
+/// @param vectors Vectors to transform.
+/// @param result Products of the matrix and vectors.
+/// @param pool Pool to process the vectors in parallel, can be null.
+void transform_vectors(const Matrix<4, 4, float>& m,
+                       Span<const Vector<4, float>> vectors,
+                       Span<Vector<4, float>> result,
+                       ThreadPool* pool = nullptr);
+
+/// @brief Normalizes vectors.
+///
+/// As for the normalize function, zero vectors give NaN components.
+///
+/// @param vectors Vectors to normalize.
+/// @param result Vectors of length one.
+/// @param pool Pool to process the vectors in parallel, can be null.
+void normalize(Span<const Vector<3, float>> vectors, Span<Vector<3, float>> result, ThreadPool* pool = nullptr);
+
+/// @copydoc normalize(Span<const Vector<3, float>>, Span<Vector<3, float>>, ThreadPool*)
+void normalize(Vector3Span<const float> vectors, Vector3Span<float> result, ThreadPool* pool = nullptr);
+
+/// @brief Multiplies matrices pairwise.
+///
+/// @param lhs First multipliers.
+/// @param rhs Second multipliers.
+/// @param result Products lhs[i] * rhs[i].
+/// @param pool Pool to multiply the matrices in parallel, can be null.
+void multiply(Span<const Matrix<4, 4, float>> lhs,
+              Span<const Matrix<4, 4, float>> rhs,
+              Span<Matrix<4, 4, float>> result,
+              ThreadPool* pool = nullptr);
+
+/// @brief Builds transformation matrices from translation, rotation and scale.
+///
+/// Each matrix is translate * rotate * scale, so the scale is applied first.
+///
+/// @param translations Translations.
+/// @param rotations Rotations, unit quaternions.
+/// @param scales Scales.
+/// @param result Transformation matrices.
+/// @param pool Pool to build the matrices in parallel, can be null.
+void compose_transforms(Span<const Vector<3, float>> translations,
+                        Span<const Quaternion<float>> rotations,
+                        Span<const Vector<3, float>> scales,
+                        Span<Matrix<4, 4, float>> result,
+                        ThreadPool* pool = nullptr);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::math
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef MATH_INC_BEZIER_FUNCTIONS_HPP
 #define MATH_INC_BEZIER_FUNCTIONS_HPP
 
+#include <math/inc/polygon_functions.hpp>
 #include <math/inc/vector_type.hpp>
 
 namespace framework::math
@@ -58,6 +59,40 @@ inline Vector<N, R> cubic_bezier(const Vector<N, T>& p1,
     return t1 * t1 * t1 * p1 + 3 * t1 * t1 * t * p2 + 3 * t1 * t * t * p3 + t * t * t * p4;
 }
 
+/// @brief Approximates quadratic bezier curve with line segments.
+///
+/// The number of segments depends on the curve bend, so the straight curves give one segment
+/// and tight ones as many as needed to keep within the tolerance.
+///
+/// @param p1 First control point (on curve).
+/// @param p2 Second control point (off curve).
+/// @param p3 Third control point (on curve).
+/// @param tolerance Maximum distance between the curve and the segments, should be positive.
+/// @param polygon Polygon to append the segments end points to. The p1 point is not appended, the p3 is.
+void flatten_quadratic_bezier(const Vector<2, float>& p1,
+                              const Vector<2, float>& p2,
+                              const Vector<2, float>& p3,
+                              float tolerance,
+                              Polygon& polygon);
+
+/// @brief Approximates cubic bezier curve with line segments.
+///
+/// The curve is divided in halves until each part is flat enough, so the segments are shorter
+/// on the tight parts of the curve.
+///
+/// @param p1 First control point (on curve).
+/// @param p2 Second control point (off curve).
+/// @param p3 Third control point (off curve).
+/// @param p4 Fourth control point (on curve).
+/// @param tolerance Maximum distance between the curve and the segments, should be positive.
+/// @param polygon Polygon to append the segments end points to. The p1 point is not appended, the p4 is.
+void flatten_cubic_bezier(const Vector<2, float>& p1,
+                          const Vector<2, float>& p2,
+                          const Vector<2, float>& p3,
+                          const Vector<2, float>& p4,
+                          float tolerance,
+                          Polygon& polygon);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,199 @@
+#ifndef MATH_INC_BVH_TYPE_HPP
+#define MATH_INC_BVH_TYPE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <vector>
+
+#include <common/span.hpp>
+#include <common/thread_pool.hpp>
+#include <math/inc/primitive_types.hpp>
+#include <math/inc/vector_type.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_bvh_implementation
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Bounding volume hierarchy.
+///
+/// Spatial index over boxes of scene objects or over triangles of a mesh. Primitives are identified by their
+/// indices in the arrays the hierarchy is built from.
+///
+/// The hierarchy is built with the surface area heuristic, primitives are split by the best of binned planes
+/// along each axis. Nodes are stored in one array aligned to the cache line, children of a node are next to each
+/// other starting from an even index, so both of them are loaded with one cache line.
+///
+/// For the dynamic objects the hierarchy can be refitted to the new boxes without rebuilding. Refit keeps the tree
+/// structure, so queries become slower if the objects move far from their initial places.
+///
+/// Mesh triangles are indexed as the triangles submesh of the graphics::Mesh, so the hierarchy can be built
+/// from the Mesh::vertices() and submesh indices directly.
+class Bvh final
+{
+public:
+    /// @brief Node of the hierarchy.
+    ///
+    /// Inner node has two children at indices first and first + 1, leaf node refers to count primitives starting
+    /// from first in the primitives array. The first index of the inner node is always even.
+    struct alignas(32) Node
+    {
+        Aabb<float> bounds;      ///< Box containing all primitives of the node.
+        std::uint32_t first = 0; ///< Index of the first child or the first primitive.
+        std::uint32_t count = 0; ///< Number of primitives, zero for inner nodes.
+    };
+
+    /// @brief Closest intersection of a ray and a primitive.
+    struct Hit
+    {
+        std::uint32_t primitive = 0; ///< Index of the primitive.
+        float distance          = 0; ///< Ray parameter of the hit point.
+        float u                 = 0; ///< Barycentric coordinate of the second triangle vertex, zero for boxes.
+        float v                 = 0; ///< Barycentric coordinate of the third triangle vertex, zero for boxes.
+    };
+
+    /// @brief Maximal number of primitives in the leaf.
+    static constexpr std::uint32_t max_leaf_size = 8;
+
+    /// @brief Builds hierarchy over boxes.
+    ///
+    /// With the pool subtrees are built in parallel, the function should not be called from a task of the same
+    /// pool. Small arrays are processed in the calling thread.
+    ///
+    /// @param boxes Boxes of primitives, should not be empty.
+    /// @param pool Pool to build the hierarchy in parallel, can be null.
+    void build(Span<const Aabb<float>> boxes, ThreadPool* pool = nullptr);
+
+    /// @brief Builds hierarchy over triangles.
+    ///
+    /// Each three indices form a triangle, the primitive index is the index of the triangle.
+    /// Triangles are copied to the hierarchy in the order of leaves.
+    ///
+    /// @param vertices Vertices of triangles.
+    /// @param indices Indices of triangles vertices, the size should be a multiple of three.
+    /// @param pool Pool to build the hierarchy in parallel, can be null.
+    void build(Span<const Vector<3, float>> vertices, Span<const std::uint32_t> indices, ThreadPool* pool = nullptr);
+
+    /// @brief Updates boxes of primitives keeping the tree structure.
+    ///
+    /// @param boxes New boxes of primitives, the same number as the hierarchy was built from.
+    void refit(Span<const Aabb<float>> boxes);
+
+    /// @brief Updates triangles keeping the tree structure.
+    ///
+    /// @param vertices New vertices of triangles.
+    /// @param indices Indices of triangles vertices, the same number as the hierarchy was built from.
+    void refit(Span<const Vector<3, float>> vertices, Span<const std::uint32_t> indices);
+
+    /// @brief Removes all nodes and primitives.
+    void clear() noexcept;
+
+    /// @brief Finds the closest primitive hit by a ray.
+    ///
+    /// Triangles are hit as by the intersect function, both sides are hit. Boxes are hit at the entry point.
+    ///
+    /// @param ray Ray.
+    /// @param hit Closest hit, set only if the ray hits a primitive.
+    /// @param max_distance Hits farther than the distance are ignored.
+    ///
+    /// @return `true` if the ray hits a primitive.
+    bool intersect(const Ray<float>& ray,
+                   Hit& hit,
+                   float max_distance = std::numeric_limits<float>::infinity()) const;
+
+    /// @brief Finds primitives overlapping a box.
+    ///
+    /// Primitives are checked by their bounding boxes.
+    ///
+    /// @param box Box.
+    /// @param result Array to append indices of primitives.
+    void query(const Aabb<float>& box, std::vector<std::uint32_t>& result) const;
+
+    /// @brief Finds primitives visible in a frustum.
+    ///
+    /// Primitives are checked by their bounding boxes, as by the is_visible function.
+    ///
+    /// @param frustum Frustum.
+    /// @param result Array to append indices of primitives.
+    void query(const Frustum<float>& frustum, std::vector<std::uint32_t>& result) const;
+
+    /// @brief Checks if the hierarchy is empty.
+    ///
+    /// @return `true` if there are no primitives.
+    bool empty() const noexcept;
+
+    /// @brief Box containing all primitives.
+    ///
+    /// @return Bounds of the root node, the empty box for the empty hierarchy.
+    Aabb<float> bounds() const noexcept;
+
+    /// @brief Nodes of the hierarchy.
+    ///
+    /// The second node is unused, it aligns the pairs of children to the cache lines.
+    ///
+    /// @return Nodes, the root node is the first one.
+    Span<const Node> nodes() const noexcept;
+
+    /// @brief Primitives in the order of leaves.
+    ///
+    /// @return Indices of primitives referred by the leaf nodes.
+    const std::vector<std::uint32_t>& primitives() const noexcept;
+
+private:
+    // Allocates nodes aligned to the cache line.
+    template <typename T>
+    struct NodeAllocator
+    {
+        using value_type = T;
+
+        static constexpr std::align_val_t alignment{64};
+
+        NodeAllocator() noexcept = default;
+
+        template <typename U>
+        NodeAllocator(const NodeAllocator<U>&) noexcept
+        {}
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(::operator new(count * sizeof(T), alignment));
+        }
+
+        void deallocate(T* pointer, std::size_t) noexcept
+        {
+            ::operator delete(pointer, alignment);
+        }
+
+        template <typename U>
+        bool operator==(const NodeAllocator<U>&) const noexcept
+        {
+            return true;
+        }
+
+        template <typename U>
+        bool operator!=(const NodeAllocator<U>&) const noexcept
+        {
+            return false;
+        }
+    };
+
+    void build_nodes(ThreadPool* pool);
+    void update_nodes();
+
+    std::vector<Node, NodeAllocator<Node>> m_nodes;
+    std::vector<std::uint32_t> m_primitives;
+    std::vector<Aabb<float>> m_boxes;
+    std::vector<Vector<3, float>> m_triangles;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::math
+
+#endif
@@ -0,0 +1,376 @@
+#ifndef MATH_INC_FAST_FUNCTIONS_HPP
+#define MATH_INC_FAST_FUNCTIONS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include <common/span.hpp>
+#include <math/inc/fast_functions_details.hpp>
+#include <math/inc/vector_type.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace framework::math::fast
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_fast_functions
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Fast approximations
+///
+/// Polynomial approximations of float functions. They have no branches, so loops over them can be vectorized,
+/// and the batch forms process four values at once with SSE instructions if they are enabled.
+///
+/// The error is measured in units in the last place (ULP) of the exact result. Functions don't set errno,
+/// and arguments out of the documented domain give unspecified results.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Computes the sine and cosine of the value.
+///
+/// Maximum error is 2 ULP, or 2^-23 absolute error for results less than 0.25 in magnitude.
+///
+/// @param value Angle in radians, in range [-8192, 8192].
+/// @param sin_result Sine of the value.
+/// @param cos_result Cosine of the value.
+inline void sincos(float value, float& sin_result, float& cos_result) noexcept
+{
+    using namespace fast_functions_details;
+
+    // Reduction to [-pi/4, pi/4], the quadrant selects the polynomial and the signs.
+    const float q           = (value * two_over_pi + round_magic) - round_magic;
+    const std::int32_t quad = static_cast<std::int32_t>(q);
+
+    const float r  = ((value - q * half_pi_hi) - q * half_pi_mid) - q * half_pi_lo;
+    const float r2 = r * r;
+
+    const float s = r + r * r2 * (sin_c3 + r2 * (sin_c5 + r2 * sin_c7));
+    const float c = 1.0f - 0.5f * r2 + r2 * r2 * (cos_c4 + r2 * (cos_c6 + r2 * cos_c8));
+
+    const bool swap              = (quad & 1) != 0;
+    const std::uint32_t sin_sign = static_cast<std::uint32_t>(quad & 2) << 30;
+    const std::uint32_t cos_sign = static_cast<std::uint32_t>((quad + 1) & 2) << 30;
+
+    sin_result = from_bits(to_bits(swap ? c : s) ^ sin_sign);
+    cos_result = from_bits(to_bits(swap ? s : c) ^ cos_sign);
+}
+
+/// @brief Computes the sine of the value.
+///
+/// Maximum error is 2 ULP, or 2^-23 absolute error for results less than 0.25 in magnitude.
+///
+/// @param value Angle in radians, in range [-8192, 8192].
+///
+/// @return The sine of the value.
+inline float sin(float value) noexcept
+{
+    float s = 0.0f;
+    float c = 0.0f;
+    sincos(value, s, c);
+    return s;
+}
+
+/// @brief Computes the cosine of the value.
+///
+/// Maximum error is 2 ULP, or 2^-23 absolute error for results less than 0.25 in magnitude.
+///
+/// @param value Angle in radians, in range [-8192, 8192].
+///
+/// @return The cosine of the value.
+inline float cos(float value) noexcept
+{
+    float s = 0.0f;
+    float c = 0.0f;
+    sincos(value, s, c);
+    return c;
+}
+
+/// @brief Computes 2 raised to the power of the value.
+///
+/// Maximum error is 2 ULP for normal results. Values above 128 give infinity, values below -150 give zero.
+///
+/// @param value Power, not NaN.
+///
+/// @return 2 raised to the power of the value.
+inline float exp2(float value) noexcept
+{
+    using namespace fast_functions_details;
+
+    const float x = std::min(std::max(value, exp2_min), exp2_max);
+    const float q = (x + round_magic) - round_magic;
+    const float f = x - q;
+
+    const float p = 1.0f + f * (exp2_c1 + f * (exp2_c2 + f * (exp2_c3 + f * (exp2_c4 + f * (exp2_c5 + f * exp2_c6)))));
+
+    // 2^q is applied in two steps, so the results near the range limits become subnormal or infinity
+    // instead of the wrong exponent.
+    const std::int32_t n  = static_cast<std::int32_t>(q);
+    const std::int32_t n1 = n / 2;
+    const std::int32_t n2 = n - n1;
+
+    const float scale1 = from_bits(static_cast<std::uint32_t>(n1 + 127) << 23);
+    const float scale2 = from_bits(static_cast<std::uint32_t>(n2 + 127) << 23);
+
+    return p * scale1 * scale2;
+}
+
+/// @brief Computes the base 2 logarithm of the value.
+///
+/// Maximum error is 4 ULP.
+///
+/// @param value Positive normal number.
+///
+/// @return The base 2 logarithm of the value.
+inline float log2(float value) noexcept
+{
+    using namespace fast_functions_details;
+
+    const std::uint32_t bits = to_bits(value);
+    const float mantissa     = from_bits((bits & mantissa_mask) | one_bits);
+
+    // The mantissa is moved to [sqrt(2) / 2, sqrt(2)] to keep the series argument small.
+    const bool above = mantissa > sqrt_two;
+    const float m    = above ? mantissa * 0.5f : mantissa;
+    const float e    = static_cast<float>(static_cast<std::int32_t>(bits >> 23) - (above ? 126 : 127));
+
+    const float t  = (m - 1.0f) / (m + 1.0f);
+    const float t2 = t * t;
+
+    return e + t * (log2_c1 + t2 * (log2_c3 + t2 * (log2_c5 + t2 * (log2_c7 + t2 * log2_c9))));
+}
+
+/// @brief Computes the base raised to the power.
+///
+/// Calculated as exp2(power * log2(base)), so the error grows with the magnitude of the result exponent.
+/// Maximum error is 3 + 2 * |log2(result)| ULP.
+///
+/// @param base Positive normal number.
+/// @param power Power.
+///
+/// @return The base raised to the power.
+inline float pow(float base, float power) noexcept
+{
+    return fast::exp2(power * fast::log2(base));
+}
+
+/// @brief Computes the inverse square root of the value.
+///
+/// Uses the hardware estimate refined by one Newton-Raphson step if SSE is enabled.
+/// Maximum error is 4 ULP.
+///
+/// @param value Positive normal number.
+///
+/// @return The inverse square root of the value.
+inline float rsqrt(float value) noexcept
+{
+#if defined(__SSE2__)
+    const __m128 x = _mm_set_ss(value);
+    const __m128 r = _mm_rsqrt_ss(x);
+
+    // r + r * (1 - x * r * r) / 2
+    const __m128 e = _mm_sub_ss(_mm_set_ss(1.0f), _mm_mul_ss(_mm_mul_ss(x, r), r));
+    return _mm_cvtss_f32(_mm_add_ss(r, _mm_mul_ss(_mm_mul_ss(r, _mm_set_ss(0.5f)), e)));
+#else
+    return 1.0f / std::sqrt(value);
+#endif
+}
+
+/// @brief Computes the arc tangent of y / x using the signs of arguments to determine the quadrant.
+///
+/// Maximum error is 4 ULP. Returns 0 or pi if both arguments are zero, as std::atan2 does.
+///
+/// @param y Finite value.
+/// @param x Finite value.
+///
+/// @return The angle in radians, in range [-pi, pi].
+inline float atan2(float y, float x) noexcept
+{
+    using namespace fast_functions_details;
+
+    const float ax = std::abs(x);
+    const float ay = std::abs(y);
+    const float mn = std::min(ax, ay);
+    const float mx = std::max(ax, ay);
+
+    // atan(a) for a in [0, 1], values above tan(pi/8) use atan(a) = pi/4 + atan((a - 1) / (a + 1)).
+    const float a      = mx > 0.0f ? mn / mx : 0.0f;
+    const bool reduce  = a > tan_pi_8;
+    const float t      = reduce ? (a - 1.0f) / (a + 1.0f) : a;
+    const float offset = reduce ? quarter_pi : 0.0f;
+    const float t2     = t * t;
+
+    float r = offset + (t + t * t2 * (atan_c3 + t2 * (atan_c5 + t2 * (atan_c7 + t2 * atan_c9))));
+    r       = ay > ax ? half_pi - r : r;
+    r       = (to_bits(x) & sign_mask) != 0 ? pi - r : r;
+
+    return from_bits(to_bits(r) | (to_bits(y) & sign_mask));
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Fast approximations for vectors
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Applies the fast::sin function to every component of the vector.
+///
+/// @param value Vector of angles in radians.
+///
+/// @return The vector of sine values.
+template <std::size_t N>
+inline Vector<N, float> sin(const Vector<N, float>& value) noexcept
+{
+    return transform(value, [](float v) { return fast::sin(v); });
+}
+
+/// @brief Applies the fast::cos function to every component of the vector.
+///
+/// @param value Vector of angles in radians.
+///
+/// @return The vector of cosine values.
+template <std::size_t N>
+inline Vector<N, float> cos(const Vector<N, float>& value) noexcept
+{
+    return transform(value, [](float v) { return fast::cos(v); });
+}
+
+/// @brief Applies the fast::exp2 function to every component of the vector.
+///
+/// @param value Vector of powers.
+///
+/// @return The vector of 2 raised to the powers.
+template <std::size_t N>
+inline Vector<N, float> exp2(const Vector<N, float>& value) noexcept
+{
+    return transform(value, [](float v) { return fast::exp2(v); });
+}
+
+/// @brief Applies the fast::log2 function to every component of the vector.
+///
+/// @param value Vector of positive values.
+///
+/// @return The vector of base 2 logarithms.
+template <std::size_t N>
+inline Vector<N, float> log2(const Vector<N, float>& value) noexcept
+{
+    return transform(value, [](float v) { return fast::log2(v); });
+}
+
+/// @brief Applies the fast::pow function to every component of the vectors.
+///
+/// @param base Vector of positive bases.
+/// @param power Vector of powers.
+///
+/// @return The vector of bases raised to the powers.
+template <std::size_t N>
+inline Vector<N, float> pow(const Vector<N, float>& base, const Vector<N, float>& power) noexcept
+{
+    return transform(base, power, [](float b, float p) { return fast::pow(b, p); });
+}
+
+/// @brief Applies the fast::rsqrt function to every component of the vector.
+///
+/// @param value Vector of positive values.
+///
+/// @return The vector of inverse square roots.
+template <std::size_t N>
+inline Vector<N, float> rsqrt(const Vector<N, float>& value) noexcept
+{
+    return transform(value, [](float v) { return fast::rsqrt(v); });
+}
+
+/// @brief Applies the fast::atan2 function to every component of the vectors.
+///
+/// @param y Vector of numerators.
+/// @param x Vector of denominators.
+///
+/// @return The vector of angles in radians.
+template <std::size_t N>
+inline Vector<N, float> atan2(const Vector<N, float>& y, const Vector<N, float>& x) noexcept
+{
+    return transform(y, x, [](float a, float b) { return fast::atan2(a, b); });
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Fast approximations for arrays
+///
+/// Use the same approximations as the scalar functions. The result can be the same array as the source one.
+/// Source and result arrays should have the same size.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Computes the sine and cosine of the values.
+///
+/// @param values Angles in radians.
+/// @param sin_result Sines of the values.
+/// @param cos_result Cosines of the values.
+void sincos(Span<const float> values, Span<float> sin_result, Span<float> cos_result);
+
+/// @brief Computes the sine of the values.
+///
+/// @param values Angles in radians.
+/// @param result Sines of the values.
+void sin(Span<const float> values, Span<float> result);
+
+/// @brief Computes the cosine of the values.
+///
+/// @param values Angles in radians.
+/// @param result Cosines of the values.
+void cos(Span<const float> values, Span<float> result);
+
+/// @brief Computes 2 raised to the power of the values.
+///
+/// @param values Powers.
+/// @param result 2 raised to the powers.
+void exp2(Span<const float> values, Span<float> result);
+
+/// @brief Computes the base 2 logarithm of the values.
+///
+/// @param values Positive values.
+/// @param result Base 2 logarithms of the values.
+void log2(Span<const float> values, Span<float> result);
+
+/// @brief Computes the bases raised to the powers.
+///
+/// @param bases Positive bases.
+/// @param powers Powers.
+/// @param result Bases raised to the powers.
+void pow(Span<const float> bases, Span<const float> powers, Span<float> result);
+
+/// @brief Computes the inverse square root of the values.
+///
+/// @param values Positive values.
+/// @param result Inverse square roots of the values.
+void rsqrt(Span<const float> values, Span<float> result);
+
+/// @brief Computes the arc tangent of y / x for the pairs of values.
+///
+/// @param y Numerators.
+/// @param x Denominators.
+/// @param result Angles in radians.
+void atan2(Span<const float> y, Span<const float> x, Span<float> result);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::math::fast
+
+#endif
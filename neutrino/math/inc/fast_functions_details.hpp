@@ -0,0 +1,79 @@
+#ifndef MATH_INC_FAST_FUNCTIONS_DETAILS_HPP
+#define MATH_INC_FAST_FUNCTIONS_DETAILS_HPP
+
+#include <cstdint>
+#include <cstring>
+
+namespace framework::math::fast::fast_functions_details
+{
+
+// Adding and subtracting 1.5 * 2^23 rounds a float to the nearest integer.
+inline constexpr float round_magic = 12582912.0f;
+
+inline constexpr std::uint32_t sign_mask = 0x80000000u;
+
+// pi / 2 split into three parts for the Cody-Waite range reduction.
+// Products of the first two parts by the quadrant are exact for |x| <= 8192.
+inline constexpr float two_over_pi = 0.636619772367581343f;
+inline constexpr float half_pi_hi  = 1.5703125f;
+inline constexpr float half_pi_mid = 4.837512969970703125e-4f;
+inline constexpr float half_pi_lo  = 7.54978995489188216e-8f;
+
+// Sine and cosine polynomials on [-pi/4, pi/4].
+inline constexpr float sin_c3 = -1.6666654611e-1f;
+inline constexpr float sin_c5 = 8.3321608736e-3f;
+inline constexpr float sin_c7 = -1.9515295891e-4f;
+
+inline constexpr float cos_c4 = 4.166664568298827e-2f;
+inline constexpr float cos_c6 = -1.388731625493765e-3f;
+inline constexpr float cos_c8 = 2.443315711809948e-5f;
+
+// 2^x polynomial on [-0.5, 0.5].
+inline constexpr float exp2_c1 = 6.931471825e-1f;
+inline constexpr float exp2_c2 = 2.402264476e-1f;
+inline constexpr float exp2_c3 = 5.550347269e-2f;
+inline constexpr float exp2_c4 = 9.618384764e-3f;
+inline constexpr float exp2_c5 = 1.339262701e-3f;
+inline constexpr float exp2_c6 = 1.535920892e-4f;
+
+inline constexpr float exp2_min = -151.0f;
+inline constexpr float exp2_max = 128.0f;
+
+// log2((1 + t) / (1 - t)) series for the mantissa in [sqrt(2) / 2, sqrt(2)].
+inline constexpr float sqrt_two = 1.41421356237309505f;
+inline constexpr float log2_c1  = 2.885390081777927f;
+inline constexpr float log2_c3  = 0.961796693925976f;
+inline constexpr float log2_c5  = 0.577078016355585f;
+inline constexpr float log2_c7  = 0.412198583111132f;
+inline constexpr float log2_c9  = 0.320598897975325f;
+
+inline constexpr std::uint32_t mantissa_mask = 0x007fffffu;
+inline constexpr std::uint32_t one_bits      = 0x3f800000u;
+
+// Arctangent polynomial on [-tan(pi/8), tan(pi/8)].
+inline constexpr float tan_pi_8   = 0.414213562373095049f;
+inline constexpr float atan_c3    = -3.33329491539e-1f;
+inline constexpr float atan_c5    = 1.99777106478e-1f;
+inline constexpr float atan_c7    = -1.38776856032e-1f;
+inline constexpr float atan_c9    = 8.05374449538e-2f;
+inline constexpr float quarter_pi = 0.785398163397448310f;
+inline constexpr float half_pi    = 1.57079632679489662f;
+inline constexpr float pi         = 3.14159265358979324f;
+
+inline std::uint32_t to_bits(float value) noexcept
+{
+    std::uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+inline float from_bits(std::uint32_t bits) noexcept
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+} // namespace framework::math::fast::fast_functions_details
+
+#endif
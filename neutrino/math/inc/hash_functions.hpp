@@ -0,0 +1,81 @@
+#ifndef MATH_INC_HASH_FUNCTIONS_HPP
+#define MATH_INC_HASH_FUNCTIONS_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+#include <common/span.hpp>
+#include <math/inc/matrix_type.hpp>
+#include <math/inc/vector_type.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_hash_functions
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Hash of arrays
+///
+/// Fast hash of contiguous memory for arrays of vertices, meshes and other large data.
+///
+/// Large arrays are processed by 64 byte stripes in 8 independent lanes, with SSE instructions if they are enabled,
+/// small arrays take a few multiplications. The result is the same on all platforms with the same byte order,
+/// but it is not compatible with other hash libraries and can change in the next versions,
+/// so it should not be stored.
+///
+/// Arrays are hashed by bytes, so -0.0 and 0.0 floating point values give different hashes.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Hash of bytes.
+///
+/// @param data Pointer to the bytes, can be null if size is zero.
+/// @param size Number of bytes.
+/// @param seed Seed, different seeds give independent hashes.
+///
+/// @return Hash of the bytes.
+std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed = 0) noexcept;
+
+/// @brief Hash of array of vectors.
+///
+/// @param values Vectors.
+/// @param seed Seed, different seeds give independent hashes.
+///
+/// @return Hash of the vectors bytes.
+template <std::size_t N, typename T>
+std::uint64_t hash_array(Span<const Vector<N, T>> values, std::uint64_t seed = 0) noexcept;
+
+/// @brief Hash of array of matrices.
+///
+/// @param values Matrices.
+/// @param seed Seed, different seeds give independent hashes.
+///
+/// @return Hash of the matrices bytes.
+template <std::size_t C, std::size_t R, typename T>
+std::uint64_t hash_array(Span<const Matrix<C, R, T>> values, std::uint64_t seed = 0) noexcept;
+
+/// @}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <std::size_t N, typename T>
+inline std::uint64_t hash_array(Span<const Vector<N, T>> values, std::uint64_t seed) noexcept
+{
+    static_assert(sizeof(Vector<N, T>) == N * sizeof(T), "Vector should not have padding.");
+    return hash_bytes(values.data(), values.size_bytes(), seed);
+}
+
+template <std::size_t C, std::size_t R, typename T>
+inline std::uint64_t hash_array(Span<const Matrix<C, R, T>> values, std::uint64_t seed) noexcept
+{
+    static_assert(sizeof(Matrix<C, R, T>) == C * R * sizeof(T), "Matrix should not have padding.");
+    return hash_bytes(values.data(), values.size_bytes(), seed);
+}
+
+} // namespace framework::math
+
+#endif
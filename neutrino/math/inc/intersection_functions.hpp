@@ -0,0 +1,456 @@
+#ifndef MATH_INC_INTERSECTION_FUNCTIONS_HPP
+#define MATH_INC_INTERSECTION_FUNCTIONS_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include <common/span.hpp>
+#include <math/inc/batch_functions.hpp>
+#include <math/inc/common_functions.hpp>
+#include <math/inc/geometric_functions.hpp>
+#include <math/inc/matrix_type.hpp>
+#include <math/inc/primitive_types.hpp>
+#include <math/inc/vector_type.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_intersection_functions
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Structure of arrays view of axis-aligned bounding boxes.
+///
+/// All arrays should have the same size.
+template <typename T>
+struct AabbSpan
+{
+    Vector3Span<T> min_points; ///< Corners with the minimal coordinates.
+    Vector3Span<T> max_points; ///< Corners with the maximal coordinates.
+
+    /// @brief Number of boxes.
+    ///
+    /// @return Number of boxes in the view.
+    constexpr std::size_t size() const noexcept
+    {
+        return min_points.size();
+    }
+};
+
+/// @brief Structure of arrays packet of rays.
+///
+/// Rays of the packet are tested against the same primitive at once. The packet of 4 rays fills an SSE register.
+template <std::size_t N>
+struct RayPacket
+{
+    static_assert(N == 4 || N == 8, "Expected packet of 4 or 8 rays.");
+
+    static constexpr std::size_t size = N; ///< Number of rays.
+
+    std::array<float, N> origin_x;    ///< X components of origins.
+    std::array<float, N> origin_y;    ///< Y components of origins.
+    std::array<float, N> origin_z;    ///< Z components of origins.
+    std::array<float, N> direction_x; ///< X components of directions.
+    std::array<float, N> direction_y; ///< Y components of directions.
+    std::array<float, N> direction_z; ///< Z components of directions.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Bounding box functions
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Merges two boxes.
+///
+/// @param a Box.
+/// @param b Box.
+///
+/// @return The smallest box containing both boxes.
+template <typename T>
+inline constexpr Aabb<T> merge(const Aabb<T>& a, const Aabb<T>& b) noexcept
+{
+    return Aabb<T>(min(a.min_point, b.min_point), max(a.max_point, b.max_point));
+}
+
+/// @brief Merges box and point.
+///
+/// @param box Box.
+/// @param point Point.
+///
+/// @return The smallest box containing the box and the point.
+template <typename T>
+inline constexpr Aabb<T> merge(const Aabb<T>& box, const Vector<3, T>& point) noexcept
+{
+    return Aabb<T>(min(box.min_point, point), max(box.max_point, point));
+}
+
+/// @brief Checks if two boxes overlap.
+///
+/// Boxes touching by a face, an edge or a corner overlap.
+///
+/// @param a Box.
+/// @param b Box.
+///
+/// @return `true` if boxes have common points.
+template <typename T>
+inline constexpr bool overlaps(const Aabb<T>& a, const Aabb<T>& b) noexcept
+{
+    return a.min_point.x <= b.max_point.x && b.min_point.x <= a.max_point.x && a.min_point.y <= b.max_point.y &&
+           b.min_point.y <= a.max_point.y && a.min_point.z <= b.max_point.z && b.min_point.z <= a.max_point.z;
+}
+
+/// @brief Checks if a box contains a point.
+///
+/// Points on the faces of the box are included.
+///
+/// @param box Box.
+/// @param point Point.
+///
+/// @return `true` if the point is inside the box.
+template <typename T>
+inline constexpr bool contains(const Aabb<T>& box, const Vector<3, T>& point) noexcept
+{
+    return box.min_point.x <= point.x && point.x <= box.max_point.x && box.min_point.y <= point.y &&
+           point.y <= box.max_point.y && box.min_point.z <= point.z && point.z <= box.max_point.z;
+}
+
+/// @brief Transforms a box.
+///
+/// Uses the Arvo method: the center is transformed as a point and the half size by the absolute values of the
+/// matrix, so only the first three rows of the matrix are used.
+///
+/// @param m Affine transformation matrix.
+/// @param box Box, should not be empty.
+///
+/// @return The smallest axis-aligned box containing the transformed box.
+template <typename T>
+inline Aabb<T> transform(const Matrix<4, 4, T>& m, const Aabb<T>& box) noexcept
+{
+    const Vector<3, T> center = box.center();
+    const Vector<3, T> extent = box.size() * T{0.5};
+
+    const Vector<3, T> new_center = Vector<3, T>(m[0]) * center.x + Vector<3, T>(m[1]) * center.y +
+                                    Vector<3, T>(m[2]) * center.z + Vector<3, T>(m[3]);
+    const Vector<3, T> new_extent = abs(Vector<3, T>(m[0])) * extent.x + abs(Vector<3, T>(m[1])) * extent.y +
+                                    abs(Vector<3, T>(m[2])) * extent.z;
+
+    return Aabb<T>(new_center - new_extent, new_center + new_extent);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Plane and frustum functions
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Computes the signed distance from a plane to a point.
+///
+/// @param plane Plane with the unit normal.
+/// @param point Point.
+///
+/// @return Distance, positive for points on the side of the normal.
+template <typename T>
+inline T signed_distance(const Plane<T>& plane, const Vector<3, T>& point) noexcept
+{
+    return dot(plane.normal, point) + plane.distance;
+}
+
+/// @brief Checks if a box is visible in a frustum.
+///
+/// The test is conservative: a box near a frustum corner can be reported as visible while it's outside.
+///
+/// @param frustum Frustum.
+/// @param box Box.
+///
+/// @return `false` if the box is entirely outside of one of the frustum planes.
+template <typename T>
+inline bool is_visible(const Frustum<T>& frustum, const Aabb<T>& box) noexcept
+{
+    for (const Plane<T>& plane : frustum.planes) {
+        // The box corner farthest along the plane normal.
+        const Vector<3, T> corner(plane.normal.x >= T{0} ? box.max_point.x : box.min_point.x,
+                                  plane.normal.y >= T{0} ? box.max_point.y : box.min_point.y,
+                                  plane.normal.z >= T{0} ? box.max_point.z : box.min_point.z);
+
+        if (signed_distance(plane, corner) < T{0}) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/// @brief Checks if a sphere is visible in a frustum.
+///
+/// The test is conservative: a sphere near a frustum corner can be reported as visible while it's outside.
+///
+/// @param frustum Frustum.
+/// @param sphere Sphere.
+///
+/// @return `false` if the sphere is entirely outside of one of the frustum planes.
+template <typename T>
+inline bool is_visible(const Frustum<T>& frustum, const Sphere<T>& sphere) noexcept
+{
+    for (const Plane<T>& plane : frustum.planes) {
+        if (signed_distance(plane, sphere.center) < -sphere.radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Ray functions
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Finds intersection of a ray and a box.
+///
+/// Uses the slab method. Rays with origin inside the box hit it at zero distance,
+/// rays lying in a face of the box hit it too.
+///
+/// @param ray Ray.
+/// @param box Box.
+/// @param distance Ray parameter of the entry point, set only if the ray hits the box.
+///
+/// @return `true` if the ray hits the box.
+template <typename T>
+inline bool intersect(const Ray<T>& ray, const Aabb<T>& box, T& distance) noexcept
+{
+    T entry = T{0};
+    T exit  = std::numeric_limits<T>::infinity();
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        const T inverse_direction = T{1} / ray.direction[i];
+
+        // The ray parallel to the slab is inside it or misses the box. The slab bounds are not used for it,
+        // because zero by infinity is NaN if the origin is on the slab plane.
+        if (std::isinf(inverse_direction)) {
+            if (ray.origin[i] < box.min_point[i] || ray.origin[i] > box.max_point[i]) {
+                return false;
+            }
+
+            continue;
+        }
+
+        const T t1 = (box.min_point[i] - ray.origin[i]) * inverse_direction;
+        const T t2 = (box.max_point[i] - ray.origin[i]) * inverse_direction;
+
+        entry = std::max(entry, std::min(t1, t2));
+        exit  = std::min(exit, std::max(t1, t2));
+    }
+
+    if (entry > exit) {
+        return false;
+    }
+
+    distance = entry;
+    return true;
+}
+
+/// @brief Finds intersection of a ray and a sphere.
+///
+/// Rays with origin inside the sphere hit it at zero distance.
+///
+/// @param ray Ray.
+/// @param sphere Sphere.
+/// @param distance Ray parameter of the entry point, set only if the ray hits the sphere.
+///
+/// @return `true` if the ray hits the sphere.
+template <typename T>
+inline bool intersect(const Ray<T>& ray, const Sphere<T>& sphere, T& distance) noexcept
+{
+    const Vector<3, T> offset = ray.origin - sphere.center;
+
+    const T a = dot(ray.direction, ray.direction);
+    const T b = dot(offset, ray.direction);
+    const T c = dot(offset, offset) - sphere.radius * sphere.radius;
+
+    if (c <= T{0}) {
+        distance = T{0};
+        return true;
+    }
+
+    const T discriminant = b * b - a * c;
+    if (b > T{0} || discriminant < T{0}) {
+        return false;
+    }
+
+    distance = (-b - std::sqrt(discriminant)) / a;
+    return true;
+}
+
+/// @brief Finds intersection of a ray and a plane.
+///
+/// @param ray Ray.
+/// @param plane Plane.
+/// @param distance Ray parameter of the hit point, set only if the ray hits the plane.
+///
+/// @return `true` if the ray hits the plane. Rays parallel to the plane miss it.
+template <typename T>
+inline bool intersect(const Ray<T>& ray, const Plane<T>& plane, T& distance) noexcept
+{
+    const T denominator = dot(plane.normal, ray.direction);
+    if (denominator == T{0}) {
+        return false;
+    }
+
+    const T t = -signed_distance(plane, ray.origin) / denominator;
+    if (t < T{0}) {
+        return false;
+    }
+
+    distance = t;
+    return true;
+}
+
+/// @brief Finds intersection of a ray and a triangle.
+///
+/// Uses the Möller–Trumbore algorithm. Both sides of the triangle are hit. Rays in the plane of the triangle
+/// and hits at zero distance are missed.
+///
+/// @param ray Ray.
+/// @param v1 Vertex of a triangle.
+/// @param v2 Vertex of a triangle.
+/// @param v3 Vertex of a triangle.
+/// @param hit Distance and barycentric coordinates of the hit point, set only if the ray hits the triangle.
+///
+/// @return `true` if the ray hits the triangle.
+template <typename T>
+inline bool intersect(const Ray<T>& ray,
+                      const Vector<3, T>& v1,
+                      const Vector<3, T>& v2,
+                      const Vector<3, T>& v3,
+                      RayHit<T>& hit) noexcept
+{
+    const Vector<3, T> edge1 = v2 - v1;
+    const Vector<3, T> edge2 = v3 - v1;
+
+    const Vector<3, T> p = cross(ray.direction, edge2);
+    const T determinant  = dot(edge1, p);
+    if (determinant == T{0}) {
+        return false;
+    }
+
+    const T inverse_determinant = T{1} / determinant;
+
+    const Vector<3, T> s = ray.origin - v1;
+    const T u            = dot(s, p) * inverse_determinant;
+    if (u < T{0} || u > T{1}) {
+        return false;
+    }
+
+    const Vector<3, T> q = cross(s, edge1);
+    const T v            = dot(ray.direction, q) * inverse_determinant;
+    if (v < T{0} || u + v > T{1}) {
+        return false;
+    }
+
+    const T t = dot(edge2, q) * inverse_determinant;
+    if (t <= T{0}) {
+        return false;
+    }
+
+    hit = RayHit<T>{t, u, v};
+    return true;
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Batch intersection functions
+///
+/// Functions process the arrays with SSE instructions if they are enabled. Results are written as 1 for `true`
+/// and 0 for `false`, the result array should have the same size as the source arrays.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Checks if boxes are visible in a frustum.
+///
+/// @param frustum Frustum.
+/// @param boxes Boxes to check.
+/// @param result Results of the is_visible function for each box.
+void is_visible(const Frustum<float>& frustum, AabbSpan<const float> boxes, Span<std::uint8_t> result);
+
+/// @brief Checks if spheres are visible in a frustum.
+///
+/// @param frustum Frustum.
+/// @param centers Centers of spheres.
+/// @param radii Radii of spheres.
+/// @param result Results of the is_visible function for each sphere.
+void is_visible(const Frustum<float>& frustum,
+                Vector3Span<const float> centers,
+                Span<const float> radii,
+                Span<std::uint8_t> result);
+
+/// @brief Checks if boxes overlap a box.
+///
+/// @param box Box.
+/// @param boxes Boxes to check.
+/// @param result Results of the overlaps function for each box.
+void overlaps(const Aabb<float>& box, AabbSpan<const float> boxes, Span<std::uint8_t> result);
+
+/// @brief Merges boxes.
+///
+/// @param boxes Boxes to merge.
+///
+/// @return The smallest box containing all boxes, the empty box if there are no boxes.
+Aabb<float> merge(AabbSpan<const float> boxes);
+
+/// @brief Finds intersections of a packet of rays and a triangle.
+///
+/// Hits are searched as by the intersect function for each ray of the packet. Hits closer than the current
+/// distances replace them, so the closest hit is found by calling the function for each triangle.
+///
+/// @param rays Rays.
+/// @param v1 Vertex of a triangle.
+/// @param v2 Vertex of a triangle.
+/// @param v3 Vertex of a triangle.
+/// @param distances Distances to the closest hits, infinity for rays without hits.
+///
+/// @return Mask with the bit i set if the ray i hits the triangle closer than the distance.
+std::uint32_t intersect(const RayPacket<4>& rays,
+                        const Vector<3, float>& v1,
+                        const Vector<3, float>& v2,
+                        const Vector<3, float>& v3,
+                        std::array<float, 4>& distances);
+
+/// @brief Finds intersections of a packet of rays and a triangle.
+///
+/// The packet of 8 rays is processed as two packets of 4 rays.
+///
+/// @param rays Rays.
+/// @param v1 Vertex of a triangle.
+/// @param v2 Vertex of a triangle.
+/// @param v3 Vertex of a triangle.
+/// @param distances Distances to the closest hits, infinity for rays without hits.
+///
+/// @return Mask with the bit i set if the ray i hits the triangle closer than the distance.
+std::uint32_t intersect(const RayPacket<8>& rays,
+                        const Vector<3, float>& v1,
+                        const Vector<3, float>& v2,
+                        const Vector<3, float>& v3,
+                        std::array<float, 8>& distances);
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::math
+
+#endif
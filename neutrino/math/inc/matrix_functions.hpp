@@ -105,6 +105,8 @@ inline T determinant(const Matrix<C, R, T>& value)
 /// The values in the returned Matrix are undefined if Matrix is singular or
 /// poorly-conditioned (nearly singular).
 ///
+/// Matrix4f is inverted with SSE instructions if they are enabled.
+///
 /// @param value Specifies the Matrix of which to take the inverse.
 ///
 /// @return The inverse of a Matrix.
@@ -122,6 +122,18 @@ inline Matrix<4, 4, T> inverse(const Matrix<4, 4, T>& m)
     return result / det;
 }
 
+inline Matrix<4, 4, float> inverse(const Matrix<4, 4, float>& m)
+{
+#if defined(__SSE2__)
+    Matrix<4, 4, float> result;
+    matrix_simd_details::inverse(m.data(), result.data());
+
+    return result;
+#else
+    return inverse<float>(m);
+#endif
+}
+
 template <typename T>
 inline Matrix<3, 3, T> inverse(const Matrix<3, 3, T>& m)
 {
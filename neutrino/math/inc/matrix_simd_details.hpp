@@ -0,0 +1,188 @@
+#ifndef MATH_INC_MATRIX_SIMD_DETAILS_HPP
+#define MATH_INC_MATRIX_SIMD_DETAILS_HPP
+
+#if defined(__AVX__)
+    #include <immintrin.h>
+#elif defined(__SSE2__)
+    #include <emmintrin.h>
+#elif defined(__ARM_NEON)
+    #include <arm_neon.h>
+#endif
+
+// Column-major 4x4 float matrices as 16 contiguous floats.
+// Sums go in the same order as in the generic templates, so the results are the same as the scalar ones.
+// Products and sums are separate instructions, fused multiply-add would round differently.
+namespace framework::math::matrix_simd_details
+{
+
+inline void multiply(const float* lhs, const float* rhs, float* result) noexcept
+{
+#if defined(__AVX__)
+    // Two result columns at once, lhs columns are duplicated in both halves.
+    const __m256 l0 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs));
+    const __m256 l1 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 4));
+    const __m256 l2 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 8));
+    const __m256 l3 = _mm256_broadcast_ps(reinterpret_cast<const __m128*>(lhs + 12));
+
+    for (int n = 0; n < 16; n += 8) {
+        const __m256 r = _mm256_loadu_ps(rhs + n);
+
+        __m256 column = _mm256_mul_ps(l0, _mm256_shuffle_ps(r, r, 0x00));
+        column        = _mm256_add_ps(column, _mm256_mul_ps(l1, _mm256_shuffle_ps(r, r, 0x55)));
+        column        = _mm256_add_ps(column, _mm256_mul_ps(l2, _mm256_shuffle_ps(r, r, 0xAA)));
+        column        = _mm256_add_ps(column, _mm256_mul_ps(l3, _mm256_shuffle_ps(r, r, 0xFF)));
+
+        _mm256_storeu_ps(result + n, column);
+    }
+#elif defined(__SSE2__)
+    const __m128 l0 = _mm_loadu_ps(lhs);
+    const __m128 l1 = _mm_loadu_ps(lhs + 4);
+    const __m128 l2 = _mm_loadu_ps(lhs + 8);
+    const __m128 l3 = _mm_loadu_ps(lhs + 12);
+
+    for (int n = 0; n < 16; n += 4) {
+        const __m128 r = _mm_loadu_ps(rhs + n);
+
+        __m128 column = _mm_mul_ps(l0, _mm_shuffle_ps(r, r, 0x00));
+        column        = _mm_add_ps(column, _mm_mul_ps(l1, _mm_shuffle_ps(r, r, 0x55)));
+        column        = _mm_add_ps(column, _mm_mul_ps(l2, _mm_shuffle_ps(r, r, 0xAA)));
+        column        = _mm_add_ps(column, _mm_mul_ps(l3, _mm_shuffle_ps(r, r, 0xFF)));
+
+        _mm_storeu_ps(result + n, column);
+    }
+#elif defined(__ARM_NEON)
+    const float32x4_t l0 = vld1q_f32(lhs);
+    const float32x4_t l1 = vld1q_f32(lhs + 4);
+    const float32x4_t l2 = vld1q_f32(lhs + 8);
+    const float32x4_t l3 = vld1q_f32(lhs + 12);
+
+    for (int n = 0; n < 16; n += 4) {
+        float32x4_t column = vmulq_n_f32(l0, rhs[n]);
+        column             = vaddq_f32(column, vmulq_n_f32(l1, rhs[n + 1]));
+        column             = vaddq_f32(column, vmulq_n_f32(l2, rhs[n + 2]));
+        column             = vaddq_f32(column, vmulq_n_f32(l3, rhs[n + 3]));
+
+        vst1q_f32(result + n, column);
+    }
+#else
+    for (int n = 0; n < 16; n += 4) {
+        for (int r = 0; r < 4; ++r) {
+            result[n + r] = lhs[r] * rhs[n] + lhs[4 + r] * rhs[n + 1] + lhs[8 + r] * rhs[n + 2] +
+                            lhs[12 + r] * rhs[n + 3];
+        }
+    }
+#endif
+}
+
+inline void transform(const float* m, const float* v, float* result) noexcept
+{
+#if defined(__SSE2__)
+    const __m128 vector = _mm_loadu_ps(v);
+
+    __m128 column = _mm_mul_ps(_mm_loadu_ps(m), _mm_shuffle_ps(vector, vector, 0x00));
+    column        = _mm_add_ps(column, _mm_mul_ps(_mm_loadu_ps(m + 4), _mm_shuffle_ps(vector, vector, 0x55)));
+    column        = _mm_add_ps(column, _mm_mul_ps(_mm_loadu_ps(m + 8), _mm_shuffle_ps(vector, vector, 0xAA)));
+    column        = _mm_add_ps(column, _mm_mul_ps(_mm_loadu_ps(m + 12), _mm_shuffle_ps(vector, vector, 0xFF)));
+
+    _mm_storeu_ps(result, column);
+#elif defined(__ARM_NEON)
+    float32x4_t column = vmulq_n_f32(vld1q_f32(m), v[0]);
+    column             = vaddq_f32(column, vmulq_n_f32(vld1q_f32(m + 4), v[1]));
+    column             = vaddq_f32(column, vmulq_n_f32(vld1q_f32(m + 8), v[2]));
+    column             = vaddq_f32(column, vmulq_n_f32(vld1q_f32(m + 12), v[3]));
+
+    vst1q_f32(result, column);
+#else
+    for (int r = 0; r < 4; ++r) {
+        result[r] = m[r] * v[0] + m[4 + r] * v[1] + m[8 + r] * v[2] + m[12 + r] * v[3];
+    }
+#endif
+}
+
+#if defined(__SSE2__)
+
+// 2x2 matrices are packed as {m00, m01, m10, m11}.
+inline __m128 multiply_2x2(__m128 lhs, __m128 rhs) noexcept
+{
+    return _mm_add_ps(_mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(3, 0, 3, 0))),
+                      _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)),
+                                 _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+// adjugate(lhs) * rhs
+inline __m128 adjugate_multiply_2x2(__m128 lhs, __m128 rhs) noexcept
+{
+    return _mm_sub_ps(_mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(0, 0, 3, 3)), rhs),
+                      _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 2, 1, 1)),
+                                 _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 0, 3, 2))));
+}
+
+// lhs * adjugate(rhs)
+inline __m128 multiply_adjugate_2x2(__m128 lhs, __m128 rhs) noexcept
+{
+    return _mm_sub_ps(_mm_mul_ps(lhs, _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(0, 3, 0, 3))),
+                      _mm_mul_ps(_mm_shuffle_ps(lhs, lhs, _MM_SHUFFLE(2, 3, 0, 1)),
+                                 _mm_shuffle_ps(rhs, rhs, _MM_SHUFFLE(1, 2, 1, 2))));
+}
+
+// Blockwise inversion of the matrix split into 2x2 blocks:
+// | A B |-1                     | X Y |
+// | C D |   = 1 / determinant * | Z W |
+// The inverse of the transposed matrix is the transposed inverse, so it works for the column-major storage as is.
+inline void inverse(const float* m, float* result) noexcept
+{
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+
+    const __m128 a = _mm_movelh_ps(c0, c1);
+    const __m128 b = _mm_movehl_ps(c1, c0);
+    const __m128 c = _mm_movelh_ps(c2, c3);
+    const __m128 d = _mm_movehl_ps(c3, c2);
+
+    // Determinants of the blocks as {|A|, |B|, |C|, |D|}.
+    const __m128 blocks_determinant = _mm_sub_ps(
+    _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(2, 0, 2, 0)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(3, 1, 3, 1))),
+    _mm_mul_ps(_mm_shuffle_ps(c0, c2, _MM_SHUFFLE(3, 1, 3, 1)), _mm_shuffle_ps(c1, c3, _MM_SHUFFLE(2, 0, 2, 0))));
+
+    const __m128 det_a = _mm_shuffle_ps(blocks_determinant, blocks_determinant, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 det_b = _mm_shuffle_ps(blocks_determinant, blocks_determinant, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 det_c = _mm_shuffle_ps(blocks_determinant, blocks_determinant, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 det_d = _mm_shuffle_ps(blocks_determinant, blocks_determinant, _MM_SHUFFLE(3, 3, 3, 3));
+
+    const __m128 d_c = adjugate_multiply_2x2(d, c);
+    const __m128 a_b = adjugate_multiply_2x2(a, b);
+
+    // Adjugates of the result blocks.
+    __m128 x = _mm_sub_ps(_mm_mul_ps(det_d, a), multiply_2x2(b, d_c));
+    __m128 w = _mm_sub_ps(_mm_mul_ps(det_a, d), multiply_2x2(c, a_b));
+    __m128 y = _mm_sub_ps(_mm_mul_ps(det_b, c), multiply_adjugate_2x2(d, a_b));
+    __m128 z = _mm_sub_ps(_mm_mul_ps(det_c, b), multiply_adjugate_2x2(a, d_c));
+
+    // |M| = |A| * |D| + |B| * |C| - trace(A#B * D#C)
+    __m128 trace = _mm_mul_ps(a_b, _mm_shuffle_ps(d_c, d_c, _MM_SHUFFLE(3, 1, 2, 0)));
+    trace        = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(1, 0, 3, 2)));
+    trace        = _mm_add_ps(trace, _mm_shuffle_ps(trace, trace, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    const __m128 determinant = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(det_a, det_d), _mm_mul_ps(det_b, det_c)), trace);
+
+    // The signs of the adjugate are applied along with the determinant.
+    const __m128 inverse_determinant = _mm_div_ps(_mm_setr_ps(1.0f, -1.0f, -1.0f, 1.0f), determinant);
+
+    x = _mm_mul_ps(x, inverse_determinant);
+    y = _mm_mul_ps(y, inverse_determinant);
+    z = _mm_mul_ps(z, inverse_determinant);
+    w = _mm_mul_ps(w, inverse_determinant);
+
+    _mm_storeu_ps(result, _mm_shuffle_ps(x, y, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(result + 4, _mm_shuffle_ps(x, y, _MM_SHUFFLE(0, 2, 0, 2)));
+    _mm_storeu_ps(result + 8, _mm_shuffle_ps(z, w, _MM_SHUFFLE(1, 3, 1, 3)));
+    _mm_storeu_ps(result + 12, _mm_shuffle_ps(z, w, _MM_SHUFFLE(0, 2, 0, 2)));
+}
+
+#endif
+
+} // namespace framework::math::matrix_simd_details
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <cassert>
 
+#include <math/inc/matrix_simd_details.hpp>
 #include <math/inc/matrix_type_details.hpp>
 #include <math/inc/vector_type.hpp>
 
@@ -3343,6 +3344,38 @@ inline const Vector<R, RT> operator*(const Matrix<C, R, T>& lhs, const Vector<C,
 
     return temp;
 }
+
+/// @brief Multiplication operator.
+///
+/// Matrix4f specialization, uses AVX, SSE or NEON instructions if they are enabled.
+///
+/// @param lhs Matrix of floating-point type.
+/// @param rhs Matrix of floating-point type.
+///
+/// @return Product of two matrices.
+inline const Matrix<4, 4, float> operator*(const Matrix<4, 4, float>& lhs, const Matrix<4, 4, float>& rhs) noexcept
+{
+    Matrix<4, 4, float> temp;
+    matrix_simd_details::multiply(lhs.data(), rhs.data(), temp.data());
+
+    return temp;
+}
+
+/// @brief Multiplication operator.
+///
+/// Matrix4f specialization, uses SSE or NEON instructions if they are enabled.
+///
+/// @param lhs Matrix of floating-point type.
+/// @param rhs Vector of floating-point type.
+///
+/// @return Product of vector and Matrix.
+inline const Vector<4, float> operator*(const Matrix<4, 4, float>& lhs, const Vector<4, float>& rhs) noexcept
+{
+    Vector<4, float> temp;
+    matrix_simd_details::transform(lhs.data(), rhs.data(), temp.data());
+
+    return temp;
+}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,427 @@
+#ifndef MATH_INC_POINT_MAP_TYPE_HPP
+#define MATH_INC_POINT_MAP_TYPE_HPP
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <common/span.hpp>
+#include <math/inc/utility_hash_details.hpp>
+#include <math/inc/vector_type.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_point_map_implementation
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Hash map with points as keys.
+///
+/// Points are equal if their coordinates are rounded to the same multiples of the precision, so the map merges
+/// close points to weld mesh vertices, remove duplicates or find points in the cells of a spatial grid.
+/// Points closer than the precision still can be rounded to different values if they are on the opposite sides
+/// of the rounding boundary.
+///
+/// The map uses open addressing with linear probing, the table has only rounded keys and indices of entries,
+/// while keys and values are stored in arrays in the order of insertion. The index of the inserted entry
+/// doesn't change until something is erased, so it can be used as the index of the welded vertex.
+///
+/// Coordinates divided by the precision should be finite and fit in 32 bit integers.
+template <typename T>
+class PointMap final
+{
+public:
+    using KeyType   = Vector<3, float>; ///< Key type.
+    using ValueType = T;                ///< Value type.
+    using SizeType  = std::size_t;      ///< Size type.
+
+    /// @brief Creates the empty map.
+    ///
+    /// @param precision Step of the coordinates rounding, should be positive.
+    explicit PointMap(float precision = 1e-5f) noexcept;
+
+    /// @brief Inserts the value if there is no equal key.
+    ///
+    /// @param key Key.
+    /// @param value Value.
+    ///
+    /// @return Index of the entry with the key and `true` if the value is inserted.
+    std::pair<SizeType, bool> insert(const KeyType& key, const ValueType& value);
+
+    /// @copydoc insert
+    std::pair<SizeType, bool> insert(const KeyType& key, ValueType&& value);
+
+    /// @brief Value of the key, inserts the default value if there is no equal key.
+    ///
+    /// @param key Key.
+    ///
+    /// @return Reference to the value.
+    ValueType& operator[](const KeyType& key);
+
+    /// @brief Finds the value of the key.
+    ///
+    /// @param key Key.
+    ///
+    /// @return Pointer to the value or null if there is no equal key.
+    ValueType* find(const KeyType& key) noexcept;
+
+    /// @copydoc find
+    const ValueType* find(const KeyType& key) const noexcept;
+
+    /// @brief Checks if there is an equal key.
+    ///
+    /// @param key Key.
+    ///
+    /// @return `true` if the map contains the key.
+    bool contains(const KeyType& key) const noexcept;
+
+    /// @brief Removes the entry with the key.
+    ///
+    /// The last entry is moved to the place of the removed one.
+    ///
+    /// @param key Key.
+    ///
+    /// @return `true` if the entry is removed.
+    bool erase(const KeyType& key);
+
+    /// @brief Reserves space for entries, so the table is not rehashed until the size exceeds the count.
+    ///
+    /// @param count Number of entries.
+    void reserve(SizeType count);
+
+    /// @brief Removes all entries.
+    void clear() noexcept;
+
+    /// @brief Number of entries.
+    ///
+    /// @return Size of the map.
+    SizeType size() const noexcept;
+
+    /// @brief Checks if the map is empty.
+    ///
+    /// @return `true` if there are no entries.
+    bool empty() const noexcept;
+
+    /// @brief Step of the coordinates rounding.
+    ///
+    /// @return Precision of the map.
+    float precision() const noexcept;
+
+    /// @brief Keys of entries.
+    ///
+    /// @return Keys in the order of entries, each one is the key the entry was inserted with.
+    Span<const KeyType> keys() const noexcept;
+
+    /// @brief Values of entries.
+    ///
+    /// @return Values in the order of entries.
+    Span<ValueType> values() noexcept;
+
+    /// @copydoc values
+    Span<const ValueType> values() const noexcept;
+
+private:
+    struct Cell
+    {
+        std::int32_t x = 0;
+        std::int32_t y = 0;
+        std::int32_t z = 0;
+    };
+
+    // Slot of the table keeps the rounded key, so the probe doesn't touch the arrays of entries.
+    struct Slot
+    {
+        Cell cell;
+        std::uint32_t entry = empty_entry;
+    };
+
+    static constexpr std::uint32_t empty_entry = std::numeric_limits<std::uint32_t>::max();
+    static constexpr SizeType min_capacity     = 16;
+
+    template <typename V>
+    std::pair<SizeType, bool> emplace(const KeyType& key, V&& value);
+
+    Cell quantize(const KeyType& key) const noexcept;
+    SizeType find_slot(const Cell& cell, std::uint64_t hashed) const noexcept;
+    void rehash(SizeType capacity);
+
+    static std::int32_t round(float value) noexcept;
+    static std::uint64_t hash(const Cell& cell) noexcept;
+    static bool equal(const Cell& lhs, const Cell& rhs) noexcept;
+
+    std::vector<Slot> m_slots;
+    std::vector<KeyType> m_keys;
+    std::vector<ValueType> m_values;
+
+    float m_precision = 0;
+    float m_scale     = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+inline PointMap<T>::PointMap(float precision) noexcept
+    : m_precision(precision)
+    , m_scale(1.0f / precision)
+{
+    assert(precision > 0.0f);
+}
+
+template <typename T>
+inline std::pair<typename PointMap<T>::SizeType, bool> PointMap<T>::insert(const KeyType& key, const ValueType& value)
+{
+    return emplace(key, value);
+}
+
+template <typename T>
+inline std::pair<typename PointMap<T>::SizeType, bool> PointMap<T>::insert(const KeyType& key, ValueType&& value)
+{
+    return emplace(key, std::move(value));
+}
+
+template <typename T>
+inline typename PointMap<T>::ValueType& PointMap<T>::operator[](const KeyType& key)
+{
+    return m_values[emplace(key, ValueType()).first];
+}
+
+template <typename T>
+inline typename PointMap<T>::ValueType* PointMap<T>::find(const KeyType& key) noexcept
+{
+    return const_cast<ValueType*>(static_cast<const PointMap&>(*this).find(key));
+}
+
+template <typename T>
+inline const typename PointMap<T>::ValueType* PointMap<T>::find(const KeyType& key) const noexcept
+{
+    if (m_values.empty()) {
+        return nullptr;
+    }
+
+    const Cell cell           = quantize(key);
+    const std::uint32_t entry = m_slots[find_slot(cell, hash(cell))].entry;
+
+    return entry != empty_entry ? &m_values[entry] : nullptr;
+}
+
+template <typename T>
+inline bool PointMap<T>::contains(const KeyType& key) const noexcept
+{
+    return find(key) != nullptr;
+}
+
+template <typename T>
+inline bool PointMap<T>::erase(const KeyType& key)
+{
+    if (m_values.empty()) {
+        return false;
+    }
+
+    const Cell cell           = quantize(key);
+    const SizeType mask       = m_slots.size() - 1;
+    SizeType i                = find_slot(cell, hash(cell));
+    const std::uint32_t entry = m_slots[i].entry;
+
+    if (entry == empty_entry) {
+        return false;
+    }
+
+    // Shifts back the following slots of the probe sequence, which home is not between the free slot and them.
+    for (SizeType j = (i + 1) & mask; m_slots[j].entry != empty_entry; j = (j + 1) & mask) {
+        const SizeType home = hash(m_slots[j].cell) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            m_slots[i] = m_slots[j];
+            i          = j;
+        }
+    }
+
+    m_slots[i] = Slot();
+
+    // The last entry takes the place of the removed one.
+    const auto last = static_cast<std::uint32_t>(m_values.size() - 1);
+    if (entry != last) {
+        SizeType slot = hash(quantize(m_keys[last])) & mask;
+        while (m_slots[slot].entry != last) {
+            slot = (slot + 1) & mask;
+        }
+
+        m_slots[slot].entry = entry;
+
+        m_keys[entry]   = m_keys[last];
+        m_values[entry] = std::move(m_values[last]);
+    }
+
+    m_keys.pop_back();
+    m_values.pop_back();
+
+    return true;
+}
+
+template <typename T>
+inline void PointMap<T>::reserve(SizeType count)
+{
+    m_keys.reserve(count);
+    m_values.reserve(count);
+
+    // The table is at most half full.
+    SizeType capacity = min_capacity;
+    while (capacity < count * 2) {
+        capacity *= 2;
+    }
+
+    if (capacity > m_slots.size()) {
+        rehash(capacity);
+    }
+}
+
+template <typename T>
+inline void PointMap<T>::clear() noexcept
+{
+    std::fill(m_slots.begin(), m_slots.end(), Slot());
+    m_keys.clear();
+    m_values.clear();
+}
+
+template <typename T>
+inline typename PointMap<T>::SizeType PointMap<T>::size() const noexcept
+{
+    return m_values.size();
+}
+
+template <typename T>
+inline bool PointMap<T>::empty() const noexcept
+{
+    return m_values.empty();
+}
+
+template <typename T>
+inline float PointMap<T>::precision() const noexcept
+{
+    return m_precision;
+}
+
+template <typename T>
+inline Span<const typename PointMap<T>::KeyType> PointMap<T>::keys() const noexcept
+{
+    return Span<const KeyType>(m_keys);
+}
+
+template <typename T>
+inline Span<typename PointMap<T>::ValueType> PointMap<T>::values() noexcept
+{
+    return Span<ValueType>(m_values);
+}
+
+template <typename T>
+inline Span<const typename PointMap<T>::ValueType> PointMap<T>::values() const noexcept
+{
+    return Span<const ValueType>(m_values);
+}
+
+template <typename T>
+template <typename V>
+inline std::pair<typename PointMap<T>::SizeType, bool> PointMap<T>::emplace(const KeyType& key, V&& value)
+{
+    if ((m_values.size() + 1) * 2 > m_slots.size()) {
+        rehash(std::max(min_capacity, m_slots.size() * 2));
+    }
+
+    const Cell cell = quantize(key);
+    Slot& slot      = m_slots[find_slot(cell, hash(cell))];
+
+    if (slot.entry != empty_entry) {
+        return {slot.entry, false};
+    }
+
+    assert(m_values.size() < empty_entry);
+    const auto entry = static_cast<std::uint32_t>(m_values.size());
+
+    m_values.push_back(std::forward<V>(value));
+    m_keys.push_back(key);
+
+    slot.cell  = cell;
+    slot.entry = entry;
+
+    return {entry, true};
+}
+
+template <typename T>
+inline typename PointMap<T>::Cell PointMap<T>::quantize(const KeyType& key) const noexcept
+{
+    return Cell{round(key.x * m_scale), round(key.y * m_scale), round(key.z * m_scale)};
+}
+
+template <typename T>
+inline typename PointMap<T>::SizeType PointMap<T>::find_slot(const Cell& cell, std::uint64_t hashed) const noexcept
+{
+    const SizeType mask = m_slots.size() - 1;
+
+    // The table is at most half full, so there is always an empty slot.
+    for (SizeType i = hashed & mask;; i = (i + 1) & mask) {
+        const Slot& slot = m_slots[i];
+        if (slot.entry == empty_entry || equal(slot.cell, cell)) {
+            return i;
+        }
+    }
+}
+
+template <typename T>
+inline void PointMap<T>::rehash(SizeType capacity)
+{
+    std::vector<Slot> slots(capacity);
+    std::swap(m_slots, slots);
+
+    const SizeType mask = capacity - 1;
+    for (const Slot& slot : slots) {
+        if (slot.entry == empty_entry) {
+            continue;
+        }
+
+        SizeType i = hash(slot.cell) & mask;
+        while (m_slots[i].entry != empty_entry) {
+            i = (i + 1) & mask;
+        }
+
+        m_slots[i] = slot;
+    }
+}
+
+template <typename T>
+inline std::int32_t PointMap<T>::round(float value) noexcept
+{
+    // Rounds half up without a call of the library function.
+    const float shifted        = value + 0.5f;
+    const auto truncated       = static_cast<std::int32_t>(shifted);
+    const bool below_truncated = shifted < static_cast<float>(truncated);
+
+    return truncated - (below_truncated ? 1 : 0);
+}
+
+template <typename T>
+inline std::uint64_t PointMap<T>::hash(const Cell& cell) noexcept
+{
+    using namespace unility_hash::details;
+
+    const std::uint64_t xy = (std::uint64_t{static_cast<std::uint32_t>(cell.x)} << 32) |
+                             static_cast<std::uint32_t>(cell.y);
+    const std::uint64_t z  = static_cast<std::uint32_t>(cell.z);
+
+    return mix(xy ^ secret0, z ^ secret1);
+}
+
+template <typename T>
+inline bool PointMap<T>::equal(const Cell& lhs, const Cell& rhs) noexcept
+{
+    return lhs.x == rhs.x && lhs.y == rhs.y && lhs.z == rhs.z;
+}
+
+} // namespace framework::math
+
+#endif
@@ -45,7 +45,10 @@ bool is_point_in_polygon(const Vector<2, float>& point, const Polygon& polygon);
 /// @brief Generates triangulation of a polygon.
 ///
 /// Uses the ear cut algorithm.
-/// Assuming the polygon has no holes or edge intersections.
+/// Polygon points are kept in a linked list, so removing an ear takes constant time,
+/// and only reflex points are tested to be inside an ear. Polygons with more than 80 points
+/// are hashed with a z-order curve, so only the points near an ear are tested.
+/// Small self intersections are cured, the polygon is split in two if there are no ears left.
 /// Creates polygon point indexes that represent the triangles in the resulting triangulation. Every 3 indices is 1
 /// triangle. The points in the triangle are arranged counterclockwise.
 ///
@@ -54,7 +57,56 @@ bool is_point_in_polygon(const Vector<2, float>& point, const Polygon& polygon);
 /// @return Indices of polygon points that form triangles in the triangulation.
 std::vector<std::uint32_t> generate_ear_cut_triangulation(const Polygon& polygon);
 
-// DelaunayTriangulation
+/// @brief Generates triangulation of a polygon with holes.
+///
+/// Each hole is joined with the polygon by a bridge edge from its leftmost point, then the polygon is triangulated
+/// the same way as the one without holes. Winding order of the polygon and the holes doesn't matter.
+/// Indices refer to the polygon points followed by the points of each hole in order.
+///
+/// @param polygon Outer polygon.
+/// @param holes Holes inside the polygon.
+///
+/// @return Indices of polygon and holes points that form triangles in the triangulation.
+std::vector<std::uint32_t> generate_ear_cut_triangulation(const Polygon& polygon, const std::vector<Polygon>& holes);
+
+/// @brief Generates constrained Delaunay triangulation of a polygon.
+///
+/// Polygon edges are kept, other edges are flipped until no point of the adjacent triangles is inside a triangle
+/// circumcircle. Among the triangulations with the polygon edges, the result has the largest minimal angle,
+/// so there are less sliver triangles than in the ear cut triangulation.
+/// The points in the triangle are arranged counterclockwise.
+///
+/// @param polygon Polygon to build triangulation.
+///
+/// @return Indices of polygon points that form triangles in the triangulation.
+std::vector<std::uint32_t> generate_delaunay_triangulation(const Polygon& polygon);
+
+/// @brief Generates constrained Delaunay triangulation of a polygon with holes.
+///
+/// Holes edges are kept as the polygon edges.
+///
+/// @param polygon Outer polygon.
+/// @param holes Holes inside the polygon.
+///
+/// @return Indices of polygon and holes points that form triangles in the triangulation.
+std::vector<std::uint32_t> generate_delaunay_triangulation(const Polygon& polygon, const std::vector<Polygon>& holes);
+
+/// @brief Generates constrained Delaunay triangulation of a polygon with holes and Steiner points.
+///
+/// Steiner points become the triangulation vertices, so big triangles can be refined, as for the terrain height map.
+/// Points outside of the polygon or inside the holes are skipped.
+/// The orientation test is exact for the float coordinates, the circumcircle test has a rounding error bound,
+/// points that can't be surely classified don't cause the edge flips.
+///
+/// @param polygon Outer polygon.
+/// @param holes Holes inside the polygon.
+/// @param points Steiner points.
+///
+/// @return Indices of polygon, holes and Steiner points that form triangles in the triangulation.
+std::vector<std::uint32_t> generate_delaunay_triangulation(const Polygon& polygon,
+                                                           const std::vector<Polygon>& holes,
+                                                           const std::vector<Vector<2, float>>& points);
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 /// @}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
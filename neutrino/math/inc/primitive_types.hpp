@@ -0,0 +1,252 @@
+#ifndef MATH_INC_PRIMITIVE_TYPES_HPP
+#define MATH_INC_PRIMITIVE_TYPES_HPP
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#include <math/inc/geometric_functions.hpp>
+#include <math/inc/matrix_type.hpp>
+#include <math/inc/vector_type.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_primitive_types
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Axis-aligned bounding box.
+///
+/// @note Can be instantiated only with floating-point type.
+template <typename T>
+struct Aabb final
+{
+    static_assert(std::is_floating_point_v<T>, "Expected floating-point type.");
+
+    using ValueType = T; ///< Value type
+
+    /// @brief Default constructor.
+    ///
+    /// Initializes the empty box. Merge of the empty box with a point gives the box of that point.
+    constexpr Aabb() noexcept = default;
+
+    /// @brief Initializes box with provided corners.
+    ///
+    /// @param min_value Corner with the minimal coordinates.
+    /// @param max_value Corner with the maximal coordinates.
+    constexpr Aabb(const Vector<3, T>& min_value, const Vector<3, T>& max_value) noexcept
+        : min_point(min_value)
+        , max_point(max_value)
+    {}
+
+    /// @brief Checks if the box is empty.
+    ///
+    /// @return `true` if the minimal corner is greater than the maximal one in any dimension.
+    constexpr bool empty() const noexcept
+    {
+        return min_point.x > max_point.x || min_point.y > max_point.y || min_point.z > max_point.z;
+    }
+
+    /// @brief Center of the box.
+    ///
+    /// @return Point in the middle of the box.
+    constexpr Vector<3, T> center() const noexcept
+    {
+        return (min_point + max_point) * T{0.5};
+    }
+
+    /// @brief Size of the box.
+    ///
+    /// @return Width, height and depth of the box.
+    constexpr Vector<3, T> size() const noexcept
+    {
+        return max_point - min_point;
+    }
+
+    Vector<3, T> min_point = Vector<3, T>(std::numeric_limits<T>::max());    ///< Corner with the minimal coordinates.
+    Vector<3, T> max_point = Vector<3, T>(std::numeric_limits<T>::lowest()); ///< Corner with the maximal coordinates.
+};
+
+/// @brief Sphere.
+///
+/// @note Can be instantiated only with floating-point type.
+template <typename T>
+struct Sphere final
+{
+    static_assert(std::is_floating_point_v<T>, "Expected floating-point type.");
+
+    using ValueType = T; ///< Value type
+
+    /// @brief Default constructor.
+    ///
+    /// Initializes the sphere of zero radius at the origin.
+    constexpr Sphere() noexcept = default;
+
+    /// @brief Initializes sphere with provided values.
+    ///
+    /// @param center_value Center.
+    /// @param radius_value Radius.
+    constexpr Sphere(const Vector<3, T>& center_value, const T& radius_value) noexcept
+        : center(center_value)
+        , radius(radius_value)
+    {}
+
+    Vector<3, T> center = Vector<3, T>(T{0}); ///< Center.
+    T radius            = T{0};               ///< Radius.
+};
+
+/// @brief Plane.
+///
+/// Points of the plane satisfy the equation dot(normal, point) + distance = 0. For the unit normal the distance is
+/// the signed distance from the plane to the origin, measured against the normal.
+///
+/// @note Can be instantiated only with floating-point type.
+template <typename T>
+struct Plane final
+{
+    static_assert(std::is_floating_point_v<T>, "Expected floating-point type.");
+
+    using ValueType = T; ///< Value type
+
+    /// @brief Default constructor.
+    ///
+    /// Initializes the xz plane with the normal along the y axis.
+    constexpr Plane() noexcept = default;
+
+    /// @brief Initializes plane with provided values.
+    ///
+    /// @param normal_value Normal.
+    /// @param distance_value Distance term of the plane equation.
+    constexpr Plane(const Vector<3, T>& normal_value, const T& distance_value) noexcept
+        : normal(normal_value)
+        , distance(distance_value)
+    {}
+
+    /// @brief Initializes plane by normal and point.
+    ///
+    /// @param normal_value Normal.
+    /// @param point Point on the plane.
+    Plane(const Vector<3, T>& normal_value, const Vector<3, T>& point) noexcept
+        : normal(normal_value)
+        , distance(-dot(normal_value, point))
+    {}
+
+    Vector<3, T> normal = Vector<3, T>(T{0}, T{1}, T{0}); ///< Normal.
+    T distance          = T{0};                           ///< Distance term of the plane equation.
+};
+
+/// @brief Ray.
+///
+/// Points of the ray are origin + direction * t, where t >= 0.
+///
+/// @note Can be instantiated only with floating-point type.
+template <typename T>
+struct Ray final
+{
+    static_assert(std::is_floating_point_v<T>, "Expected floating-point type.");
+
+    using ValueType = T; ///< Value type
+
+    /// @brief Default constructor.
+    ///
+    /// Initializes the ray from the origin along the negative z axis.
+    constexpr Ray() noexcept = default;
+
+    /// @brief Initializes ray with provided values.
+    ///
+    /// @param origin_value Origin.
+    /// @param direction_value Direction, should not be zero.
+    constexpr Ray(const Vector<3, T>& origin_value, const Vector<3, T>& direction_value) noexcept
+        : origin(origin_value)
+        , direction(direction_value)
+    {}
+
+    Vector<3, T> origin    = Vector<3, T>(T{0});              ///< Origin.
+    Vector<3, T> direction = Vector<3, T>(T{0}, T{0}, T{-1}); ///< Direction.
+};
+
+/// @brief Intersection of a ray and a triangle.
+///
+/// The hit point is origin + direction * distance or, in the barycentric coordinates of the triangle,
+/// v1 * (1 - u - v) + v2 * u + v3 * v.
+template <typename T>
+struct RayHit final
+{
+    T distance = T{0}; ///< Ray parameter of the hit point.
+    T u        = T{0}; ///< Barycentric coordinate of the second vertex.
+    T v        = T{0}; ///< Barycentric coordinate of the third vertex.
+};
+
+/// @brief View frustum.
+///
+/// Six planes with normals directed inside the frustum. Points inside the frustum are on the positive side of
+/// each plane.
+///
+/// @note Can be instantiated only with floating-point type.
+template <typename T>
+struct Frustum final
+{
+    static_assert(std::is_floating_point_v<T>, "Expected floating-point type.");
+
+    using ValueType = T; ///< Value type
+
+    /// @brief Planes indices.
+    enum PlaneIndex : std::size_t
+    {
+        left_plane   = 0,
+        right_plane  = 1,
+        bottom_plane = 2,
+        top_plane    = 3,
+        near_plane   = 4,
+        far_plane    = 5,
+    };
+
+    static constexpr std::size_t planes_count = 6; ///< Number of planes.
+
+    /// @brief Default constructor.
+    ///
+    /// Initializes the frustum of the identity projection, the cube from -1 to 1.
+    Frustum() noexcept
+        : Frustum(Matrix<4, 4, T>())
+    {}
+
+    /// @brief Initializes frustum from the view projection matrix.
+    ///
+    /// Planes are extracted from the rows of the matrix, as it's done in the Gribb and Hartmann method. The clip
+    /// space depth is expected in [-1, 1], as the perspective and ortho functions give. Planes are normalized.
+    ///
+    /// @param view_projection Product of the projection and view matrices.
+    explicit Frustum(const Matrix<4, 4, T>& view_projection) noexcept
+    {
+        const Matrix<4, 4, T>& m = view_projection;
+
+        const auto row = [&m](std::size_t i) { return Vector<4, T>(m[0][i], m[1][i], m[2][i], m[3][i]); };
+
+        const Vector<4, T> w = row(3);
+        const std::array<Vector<4, T>, planes_count> equations = {w + row(0),
+                                                                  w - row(0),
+                                                                  w + row(1),
+                                                                  w - row(1),
+                                                                  w + row(2),
+                                                                  w - row(2)};
+
+        for (std::size_t i = 0; i < planes_count; ++i) {
+            const Vector<3, T> normal(equations[i]);
+            const T scale = T{1} / length(normal);
+
+            planes[i] = Plane<T>(normal * scale, equations[i].w * scale);
+        }
+    }
+
+    std::array<Plane<T>, planes_count> planes; ///< Planes directed inside the frustum.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::math
+
+#endif
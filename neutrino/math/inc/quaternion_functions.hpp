@@ -0,0 +1,233 @@
+#ifndef MATH_INC_QUATERNION_FUNCTIONS_HPP
+#define MATH_INC_QUATERNION_FUNCTIONS_HPP
+
+#include <math/inc/exponential_functions.hpp>
+#include <math/inc/geometric_functions.hpp>
+#include <math/inc/matrix_type.hpp>
+#include <math/inc/quaternion_type.hpp>
+#include <math/inc/trigonometric_functions.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_quaternion_implementation
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Quaternion functions.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Calculates the dot product of two quaternions.
+///
+/// @param a First quaternion.
+/// @param b Second quaternion.
+///
+/// @return Sum of the component-wise products.
+template <typename T>
+inline constexpr T dot(const Quaternion<T>& a, const Quaternion<T>& b) noexcept
+{
+    return (a.x * b.x) + (a.y * b.y) + (a.z * b.z) + (a.w * b.w);
+}
+
+/// @brief Calculates the length of a quaternion.
+///
+/// @param q Quaternion.
+///
+/// @return Length of the quaternion.
+template <typename T>
+inline T length(const Quaternion<T>& q)
+{
+    return framework::math::sqrt(dot(q, q));
+}
+
+/// @brief Calculates the unit quaternion with the same direction as the original one.
+///
+/// @param q Quaternion to normalize.
+///
+/// @return Quaternion of length one.
+template <typename T>
+inline Quaternion<T> normalize(const Quaternion<T>& q)
+{
+    return q * framework::math::invsqrt(dot(q, q));
+}
+
+/// @brief Calculates the conjugate of a quaternion.
+///
+/// For unit quaternions it's the inverse rotation.
+///
+/// @param q Quaternion.
+///
+/// @return Quaternion with the negated vector part.
+template <typename T>
+inline constexpr Quaternion<T> conjugate(const Quaternion<T>& q) noexcept
+{
+    return {-q.x, -q.y, -q.z, q.w};
+}
+
+/// @brief Calculates the inverse of a quaternion.
+///
+/// Use conjugate for unit quaternions, it gives the same result without division.
+///
+/// @param q Quaternion.
+///
+/// @return Quaternion r, such that q * r is the identity quaternion.
+template <typename T>
+inline constexpr Quaternion<T> inverse(const Quaternion<T>& q) noexcept
+{
+    return conjugate(q) * (T{1} / dot(q, q));
+}
+
+/// @brief Creates a quaternion of the rotation around an axis.
+///
+/// @param axis Rotation axis, should be normalized.
+/// @param angle Rotation angle expressed in radians.
+///
+/// @return Unit quaternion of the rotation.
+template <typename T>
+inline Quaternion<T> angle_axis(const T& angle, const Vector<3, T>& axis)
+{
+    const T half_angle = angle * T{0.5};
+    return Quaternion<T>(axis * framework::math::sin(half_angle), framework::math::cos(half_angle));
+}
+
+/// @brief Normalized linear interpolation of two rotations.
+///
+/// Interpolates along the shortest path. It's faster than slerp, but the angular speed is not constant.
+///
+/// @param a Rotation for t = 0.
+/// @param b Rotation for t = 1.
+/// @param t Interpolation factor in range [0, 1].
+///
+/// @return Unit quaternion between a and b.
+template <typename T>
+inline Quaternion<T> nlerp(const Quaternion<T>& a, const Quaternion<T>& b, const T& t)
+{
+    const Quaternion<T> end = dot(a, b) < T{0} ? -b : b;
+    return normalize(a * (T{1} - t) + end * t);
+}
+
+/// @brief Spherical linear interpolation of two rotations.
+///
+/// Interpolates along the shortest path with constant angular speed.
+/// Falls back to nlerp for nearly equal rotations.
+///
+/// @param a Rotation for t = 0.
+/// @param b Rotation for t = 1.
+/// @param t Interpolation factor in range [0, 1].
+///
+/// @return Unit quaternion between a and b.
+template <typename T>
+inline Quaternion<T> slerp(const Quaternion<T>& a, const Quaternion<T>& b, const T& t)
+{
+    T cos_angle = dot(a, b);
+
+    Quaternion<T> end = b;
+    if (cos_angle < T{0}) {
+        cos_angle = -cos_angle;
+        end       = -b;
+    }
+
+    // The sine of the angle is too small to divide by it.
+    if (cos_angle > T{0.9995}) {
+        return normalize(a * (T{1} - t) + end * t);
+    }
+
+    const T angle     = framework::math::acos(cos_angle);
+    const T sin_angle = framework::math::sin(angle);
+
+    return a * (framework::math::sin((T{1} - t) * angle) / sin_angle) +
+           end * (framework::math::sin(t * angle) / sin_angle);
+}
+
+/// @brief Builds a rotation 4x4 Matrix from a unit quaternion.
+///
+/// @param q Unit quaternion.
+///
+/// @return The Matrix which contains rotation transformation.
+template <typename T>
+inline constexpr Matrix<4, 4, T> to_matrix(const Quaternion<T>& q) noexcept
+{
+    const T xx = q.x * q.x;
+    const T yy = q.y * q.y;
+    const T zz = q.z * q.z;
+    const T xy = q.x * q.y;
+    const T xz = q.x * q.z;
+    const T yz = q.y * q.z;
+    const T wx = q.w * q.x;
+    const T wy = q.w * q.y;
+    const T wz = q.w * q.z;
+
+    // clang-format off
+    return Matrix<4, 4, T>(T{1} - T{2} * (yy + zz), T{2} * (xy + wz),        T{2} * (xz - wy),        T{0},
+                           T{2} * (xy - wz),        T{1} - T{2} * (xx + zz), T{2} * (yz + wx),        T{0},
+                           T{2} * (xz + wy),        T{2} * (yz - wx),        T{1} - T{2} * (xx + yy), T{0},
+                           T{0},                    T{0},                    T{0},                    T{1});
+    // clang-format on
+}
+
+/// @brief Extracts rotation from a 3x3 Matrix.
+///
+/// @param m Rotation Matrix, should be orthonormal.
+///
+/// @return Unit quaternion of the same rotation.
+template <typename T>
+inline Quaternion<T> to_quaternion(const Matrix<3, 3, T>& m)
+{
+    // Components are m[column][row]. The largest of the quaternion components is found first,
+    // the others are divided by it, so the divisor is never close to zero.
+    const T trace = m[0][0] + m[1][1] + m[2][2];
+
+    if (trace > T{0}) {
+        const T s = framework::math::sqrt(trace + T{1}) * T{2};
+        return {(m[1][2] - m[2][1]) / s, (m[2][0] - m[0][2]) / s, (m[0][1] - m[1][0]) / s, s / T{4}};
+    }
+
+    if (m[0][0] > m[1][1] && m[0][0] > m[2][2]) {
+        const T s = framework::math::sqrt(T{1} + m[0][0] - m[1][1] - m[2][2]) * T{2};
+        return {s / T{4}, (m[1][0] + m[0][1]) / s, (m[2][0] + m[0][2]) / s, (m[1][2] - m[2][1]) / s};
+    }
+
+    if (m[1][1] > m[2][2]) {
+        const T s = framework::math::sqrt(T{1} + m[1][1] - m[0][0] - m[2][2]) * T{2};
+        return {(m[1][0] + m[0][1]) / s, s / T{4}, (m[2][1] + m[1][2]) / s, (m[2][0] - m[0][2]) / s};
+    }
+
+    const T s = framework::math::sqrt(T{1} + m[2][2] - m[0][0] - m[1][1]) * T{2};
+    return {(m[2][0] + m[0][2]) / s, (m[2][1] + m[1][2]) / s, s / T{4}, (m[0][1] - m[1][0]) / s};
+}
+
+/// @brief Extracts rotation from a 4x4 Matrix.
+///
+/// @param m Matrix, upper left 3x3 part should be orthonormal.
+///
+/// @return Unit quaternion of the same rotation.
+template <typename T>
+inline Quaternion<T> to_quaternion(const Matrix<4, 4, T>& m)
+{
+    return to_quaternion(Matrix<3, 3, T>(m));
+}
+
+/// @brief Applies rotation to a Matrix.
+///
+/// @param m Matrix multiplied by the rotation Matrix.
+/// @param q Unit quaternion of the rotation.
+///
+/// @return Product of the Matrix and the rotation Matrix.
+template <typename T>
+inline Matrix<4, 4, T> rotate(const Matrix<4, 4, T>& m, const Quaternion<T>& q)
+{
+    return m * to_matrix(q);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::math
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef MATH_INC_QUATERNION_TYPE_HPP
+#define MATH_INC_QUATERNION_TYPE_HPP
+
+#include <cassert>
+#include <type_traits>
+
+#include <math/inc/vector_type.hpp>
+#include <math/inc/vector_type_details.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_quaternion_implementation
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Quaternion type.
+///
+/// Unit quaternions represent rotations. The x, y and z components are the vector part, w is the scalar part.
+/// Product of two rotations rotates by the right one first: (a * b) * v == a * (b * v).
+///
+/// @note Can be instantiated only with floating-point type.
+/// @note Quaternion<float> is 16 bytes aligned as Vector<4, float>.
+template <typename T>
+struct alignas(vector_type_details::alignment<4, T>) Quaternion final
+{
+    static_assert(std::is_floating_point_v<T>, "Expected floating-point type.");
+
+    using ValueType = T; ///< Value type
+
+    /// @brief Default constructor.
+    ///
+    /// Initializes quaternion as {0, 0, 0, 1}, the rotation by zero angle.
+    constexpr Quaternion() noexcept;
+
+    /// @brief Initializes quaternion with provided values.
+    ///
+    /// @param x_value Value for x component.
+    /// @param y_value Value for y component.
+    /// @param z_value Value for z component.
+    /// @param w_value Value for w component.
+    constexpr Quaternion(const T& x_value, const T& y_value, const T& z_value, const T& w_value) noexcept;
+
+    /// @brief Initializes quaternion from vector and scalar parts.
+    ///
+    /// @param vector Value for x, y and z components.
+    /// @param scalar Value for w component.
+    constexpr Quaternion(const Vector<3, T>& vector, const T& scalar) noexcept;
+
+    /// @brief Access operator.
+    ///
+    /// @param index Index of component.
+    ///
+    /// @return Reference to component of quaternion.
+    ///
+    /// @warning There is no size check. May cause memory access error.
+    ValueType& operator[](std::size_t index);
+
+    /// @brief Const access operator.
+    ///
+    /// @param index Index of component.
+    ///
+    /// @return Reference to constant component of quaternion.
+    ///
+    /// @warning There is no size check. May cause memory access error.
+    const ValueType& operator[](std::size_t index) const;
+
+    /// @brief Provides direct access to internal content.
+    ///
+    /// @return A pointer to the x component.
+    ValueType* data() noexcept;
+
+    /// @brief Provides direct access to internal content.
+    ///
+    /// @return A pointer to the x component.
+    const ValueType* data() const noexcept;
+
+    /// @brief Vector part of the quaternion.
+    ///
+    /// @return Vector of x, y and z components.
+    constexpr Vector<3, T> vector() const noexcept;
+
+    ValueType x; ///< The x component.
+    ValueType y; ///< The y component.
+    ValueType z; ///< The z component.
+    ValueType w; ///< The w component.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Quaternion operators.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Unary minus operator.
+///
+/// Negated quaternion represents the same rotation.
+///
+/// @param q Quaternion to negate.
+///
+/// @return Negated quaternion.
+template <typename T>
+inline constexpr Quaternion<T> operator-(const Quaternion<T>& q) noexcept
+{
+    return {-q.x, -q.y, -q.z, -q.w};
+}
+
+/// @brief Addition operator.
+///
+/// @param lhs First addend.
+/// @param rhs Second addend.
+///
+/// @return Component-wise sum of two quaternions.
+template <typename T>
+inline constexpr Quaternion<T> operator+(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return {lhs.x + rhs.x, lhs.y + rhs.y, lhs.z + rhs.z, lhs.w + rhs.w};
+}
+
+/// @brief Subtraction operator.
+///
+/// @param lhs Quaternion to subtract from.
+/// @param rhs Quaternion to subtract.
+///
+/// @return Component-wise difference of two quaternions.
+template <typename T>
+inline constexpr Quaternion<T> operator-(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return {lhs.x - rhs.x, lhs.y - rhs.y, lhs.z - rhs.z, lhs.w - rhs.w};
+}
+
+/// @brief Multiplication operator.
+///
+/// @param lhs Quaternion.
+/// @param rhs Scalar value.
+///
+/// @return Component-wise product of quaternion and scalar value.
+template <typename T>
+inline constexpr Quaternion<T> operator*(const Quaternion<T>& lhs, const T& rhs) noexcept
+{
+    return {lhs.x * rhs, lhs.y * rhs, lhs.z * rhs, lhs.w * rhs};
+}
+
+/// @brief Multiplication operator.
+///
+/// @param lhs Scalar value.
+/// @param rhs Quaternion.
+///
+/// @return Component-wise product of scalar value and quaternion.
+template <typename T>
+inline constexpr Quaternion<T> operator*(const T& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return rhs * lhs;
+}
+
+/// @brief Multiplication operator.
+///
+/// For unit quaternions the product is the composition of rotations, the rhs rotation is applied first.
+///
+/// @param lhs First multiplier.
+/// @param rhs Second multiplier.
+///
+/// @return Hamilton product of two quaternions.
+template <typename T>
+inline constexpr Quaternion<T> operator*(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return {lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y,
+            lhs.w * rhs.y + lhs.y * rhs.w + lhs.z * rhs.x - lhs.x * rhs.z,
+            lhs.w * rhs.z + lhs.z * rhs.w + lhs.x * rhs.y - lhs.y * rhs.x,
+            lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z};
+}
+
+/// @brief Multiplication assignment operator.
+///
+/// @param lhs First multiplier.
+/// @param rhs Second multiplier.
+///
+/// @return Reference to product of two quaternions.
+template <typename T>
+inline constexpr Quaternion<T>& operator*=(Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return (lhs = lhs * rhs);
+}
+
+/// @brief Multiplication operator.
+///
+/// Rotates the vector by the unit quaternion without building the rotation matrix.
+///
+/// @param lhs Unit quaternion.
+/// @param rhs Vector to rotate.
+///
+/// @return Rotated vector.
+template <typename T>
+inline constexpr Vector<3, T> operator*(const Quaternion<T>& lhs, const Vector<3, T>& rhs) noexcept
+{
+    // v + 2w(u x v) + 2u x (u x v), where u is the vector part.
+    const Vector<3, T> u = lhs.vector();
+    const Vector<3, T> t = T{2} * Vector<3, T>(u.y * rhs.z - u.z * rhs.y,
+                                               u.z * rhs.x - u.x * rhs.z,
+                                               u.x * rhs.y - u.y * rhs.x);
+
+    return rhs + lhs.w * t + Vector<3, T>(u.y * t.z - u.z * t.y, u.z * t.x - u.x * t.z, u.x * t.y - u.y * t.x);
+}
+
+/// @brief Equality operator.
+///
+/// @param lhs Quaternion of floating-point type.
+/// @param rhs Quaternion of floating-point type.
+///
+/// @return `true` if lhs equals rhs, otherwise `false`.
+template <typename T>
+inline constexpr bool operator==(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return vector_type_details::equals(lhs.x, rhs.x) && vector_type_details::equals(lhs.y, rhs.y) &&
+           vector_type_details::equals(lhs.z, rhs.z) && vector_type_details::equals(lhs.w, rhs.w);
+}
+
+/// @brief Inequality operator.
+///
+/// @param lhs Quaternion of floating-point type.
+/// @param rhs Quaternion of floating-point type.
+///
+/// @return `true` if lhs isn't equal rhs, otherwise `false`.
+template <typename T>
+inline constexpr bool operator!=(const Quaternion<T>& lhs, const Quaternion<T>& rhs) noexcept
+{
+    return !(lhs == rhs);
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+template <typename T>
+inline constexpr Quaternion<T>::Quaternion() noexcept
+    : x{T(0)}
+    , y{T(0)}
+    , z{T(0)}
+    , w{T(1)}
+{}
+
+template <typename T>
+inline constexpr Quaternion<T>::Quaternion(const T& x_value,
+                                           const T& y_value,
+                                           const T& z_value,
+                                           const T& w_value) noexcept
+    : x{x_value}
+    , y{y_value}
+    , z{z_value}
+    , w{w_value}
+{}
+
+template <typename T>
+inline constexpr Quaternion<T>::Quaternion(const Vector<3, T>& vector, const T& scalar) noexcept
+    : Quaternion{vector.x, vector.y, vector.z, scalar}
+{}
+
+template <typename T>
+inline typename Quaternion<T>::ValueType& Quaternion<T>::operator[](std::size_t index)
+{
+    assert(index < 4);
+    return data()[index];
+}
+
+template <typename T>
+inline const typename Quaternion<T>::ValueType& Quaternion<T>::operator[](std::size_t index) const
+{
+    assert(index < 4);
+    return data()[index];
+}
+
+template <typename T>
+inline typename Quaternion<T>::ValueType* Quaternion<T>::data() noexcept
+{
+    return &x;
+}
+
+template <typename T>
+inline const typename Quaternion<T>::ValueType* Quaternion<T>::data() const noexcept
+{
+    return &x;
+}
+
+template <typename T>
+inline constexpr Vector<3, T> Quaternion<T>::vector() const noexcept
+{
+    return {x, y, z};
+}
+
+} // namespace framework::math
+
+#endif
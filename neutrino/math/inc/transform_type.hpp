@@ -0,0 +1,141 @@
+#ifndef MATH_INC_TRANSFORM_TYPE_HPP
+#define MATH_INC_TRANSFORM_TYPE_HPP
+
+#include <type_traits>
+
+#include <math/inc/matrix_type.hpp>
+#include <math/inc/quaternion_functions.hpp>
+#include <math/inc/quaternion_type.hpp>
+#include <math/inc/vector_type.hpp>
+
+namespace framework::math
+{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_transform_implementation
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Translation, rotation and scale transformation.
+///
+/// Points are scaled first, then rotated and translated, as by the translate * rotate * scale Matrix.
+/// Composition and inversion don't need 4x4 matrices, which makes them cheap for the scene and skeleton
+/// hierarchies. The Matrix is built once for the final transformation.
+///
+/// @note Transformation with non-uniform scale, composed with a rotated child or inverted, becomes skewed.
+///       Translation, rotation and scale can't represent the skew, so such results are approximate.
+/// @note Can be instantiated only with floating-point type.
+template <typename T>
+struct Transform final
+{
+    static_assert(std::is_floating_point_v<T>, "Expected floating-point type.");
+
+    using ValueType = T; ///< Value type
+
+    /// @brief Default constructor.
+    ///
+    /// Initializes the identity transformation.
+    constexpr Transform() noexcept = default;
+
+    /// @brief Initializes transformation with provided values.
+    ///
+    /// @param translation_value Translation.
+    /// @param rotation_value Rotation, unit quaternion.
+    /// @param scale_value Scale.
+    constexpr Transform(const Vector<3, T>& translation_value,
+                        const Quaternion<T>& rotation_value,
+                        const Vector<3, T>& scale_value = Vector<3, T>(T{1})) noexcept
+        : translation(translation_value)
+        , rotation(rotation_value)
+        , scale(scale_value)
+    {}
+
+    Vector<3, T> translation = Vector<3, T>(T{0}); ///< Translation.
+    Quaternion<T> rotation;                        ///< Rotation, unit quaternion.
+    Vector<3, T> scale = Vector<3, T>(T{1});       ///< Scale.
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @name Transform operators and functions.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+/// @brief Multiplication operator.
+///
+/// Applies transformation to a point.
+///
+/// @param lhs Transformation.
+/// @param rhs Point.
+///
+/// @return Transformed point.
+template <typename T>
+inline constexpr Vector<3, T> operator*(const Transform<T>& lhs, const Vector<3, T>& rhs) noexcept
+{
+    return lhs.translation + lhs.rotation * (lhs.scale * rhs);
+}
+
+/// @brief Multiplication operator.
+///
+/// Composes two transformations, the rhs is applied first. For the hierarchy it's parent * local.
+///
+/// @param lhs Second transformation.
+/// @param rhs First transformation.
+///
+/// @return Composition of two transformations.
+template <typename T>
+inline constexpr Transform<T> operator*(const Transform<T>& lhs, const Transform<T>& rhs) noexcept
+{
+    return Transform<T>(lhs * rhs.translation, lhs.rotation * rhs.rotation, lhs.scale * rhs.scale);
+}
+
+/// @brief Multiplication assignment operator.
+///
+/// @param lhs Second transformation.
+/// @param rhs First transformation.
+///
+/// @return Reference to composition of two transformations.
+template <typename T>
+inline constexpr Transform<T>& operator*=(Transform<T>& lhs, const Transform<T>& rhs) noexcept
+{
+    return (lhs = lhs * rhs);
+}
+
+/// @brief Calculates the inverse transformation.
+///
+/// @param value Transformation, scale components should not be zero.
+///
+/// @return Transformation, which composed with value gives the identity one.
+template <typename T>
+inline constexpr Transform<T> inverse(const Transform<T>& value) noexcept
+{
+    const Vector<3, T> scale     = T{1} / value.scale;
+    const Quaternion<T> rotation = conjugate(value.rotation);
+
+    return Transform<T>(scale * (rotation * -value.translation), rotation, scale);
+}
+
+/// @brief Builds the transformation Matrix.
+///
+/// @param value Transformation.
+///
+/// @return The translate * rotate * scale Matrix.
+template <typename T>
+inline constexpr Matrix<4, 4, T> to_matrix(const Transform<T>& value) noexcept
+{
+    const Matrix<4, 4, T> rotation = to_matrix(value.rotation);
+
+    return Matrix<4, 4, T>(rotation[0] * value.scale.x,
+                           rotation[1] * value.scale.y,
+                           rotation[2] * value.scale.z,
+                           Vector<4, T>(value.translation, T{1}));
+}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+} // namespace framework::math
+
+#endif
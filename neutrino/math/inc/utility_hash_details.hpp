@@ -2,6 +2,11 @@
 #define MATH_INC_UTILITY_HASH_DETAILS_HPP
 
 #include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    #include <intrin.h>
+#endif
 
 namespace framework::math::unility_hash::details
 {
@@ -13,6 +18,44 @@ constexpr inline std::size_t hash_combine(std::size_t seed, std::size_t hash) no
     return seed;
 }
 
+// Random odd constants with half of bits set.
+constexpr std::uint64_t secret0 = 0xa0761d6478bd642full;
+constexpr std::uint64_t secret1 = 0xe7037ed1a0b428dbull;
+
+// Full 128 bit product of two values.
+inline void multiply(std::uint64_t a, std::uint64_t b, std::uint64_t& low, std::uint64_t& high) noexcept
+{
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 Uint128;
+
+    const Uint128 product = static_cast<Uint128>(a) * b;
+
+    low  = static_cast<std::uint64_t>(product);
+    high = static_cast<std::uint64_t>(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    low = _umul128(a, b, &high);
+#else
+    const std::uint64_t lo_lo = (a & 0xffffffff) * (b & 0xffffffff);
+    const std::uint64_t hi_lo = (a >> 32) * (b & 0xffffffff);
+    const std::uint64_t lo_hi = (a & 0xffffffff) * (b >> 32);
+    const std::uint64_t hi_hi = (a >> 32) * (b >> 32);
+
+    const std::uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xffffffff) + lo_hi;
+
+    low  = (cross << 32) | (lo_lo & 0xffffffff);
+    high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+#endif
+}
+
+// Mixes bits of two values, each bit of the result depends on all bits of both values.
+inline std::uint64_t mix(std::uint64_t a, std::uint64_t b) noexcept
+{
+    std::uint64_t low  = 0;
+    std::uint64_t high = 0;
+    multiply(a, b, low, high);
+    return low ^ high;
+}
+
 } // namespace framework::math::unility_hash::details
 
 #endif
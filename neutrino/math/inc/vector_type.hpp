@@ -21,8 +21,9 @@ struct Vector;
 /// @brief Vector<4, T> type specialization.
 ///
 /// @note Can be instantiated only with arithmetic type.
+/// @note Vector<4, float> is 16 bytes aligned for the SIMD instructions.
 template <typename T>
-struct Vector<4, T> final
+struct alignas(vector_type_details::alignment<4, T>) Vector<4, T> final
 {
     static_assert(std::is_arithmetic_v<T>, "Expected floating-point or integer type.");
 
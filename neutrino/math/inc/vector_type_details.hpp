@@ -1,12 +1,17 @@
 #ifndef MATH_INC_VECTOR_TYPE_DETAILS_HPP
 #define MATH_INC_VECTOR_TYPE_DETAILS_HPP
 
+#include <cstddef>
 #include <functional>
 #include <type_traits>
 
 namespace framework::math::vector_type_details
 {
 
+// Vector<4, float> is aligned to be loaded into the SIMD register at once.
+template <std::size_t N, typename T>
+inline constexpr std::size_t alignment = (N == 4 && std::is_same_v<T, float>) ? 16 : alignof(T);
+
 template <typename T>
 inline constexpr bool equals(const T& a, const T& b, std::true_type /*unused*/)
 {
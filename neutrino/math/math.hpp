@@ -1,16 +1,26 @@
 #ifndef MATH_MATH_HPP
 #define MATH_MATH_HPP
 
+#include <math/inc/batch_functions.hpp>
 #include <math/inc/bezier_functions.hpp>
+#include <math/inc/bvh_type.hpp>
 #include <math/inc/common_functions.hpp>
 #include <math/inc/constants.hpp>
 #include <math/inc/exponential_functions.hpp>
+#include <math/inc/fast_functions.hpp>
 #include <math/inc/geometric_functions.hpp>
+#include <math/inc/hash_functions.hpp>
+#include <math/inc/intersection_functions.hpp>
 #include <math/inc/matrix_functions.hpp>
 #include <math/inc/matrix_type.hpp>
+#include <math/inc/point_map_type.hpp>
 #include <math/inc/polygon_functions.hpp>
+#include <math/inc/primitive_types.hpp>
+#include <math/inc/quaternion_functions.hpp>
+#include <math/inc/quaternion_type.hpp>
 #include <math/inc/relational_functions.hpp>
 #include <math/inc/transform_functions.hpp>
+#include <math/inc/transform_type.hpp>
 #include <math/inc/trigonometric_functions.hpp>
 #include <math/inc/utility_hash.hpp>
 #include <math/inc/vector_type.hpp>
@@ -96,6 +106,66 @@ using Matrix4x3f = Matrix<4, 3, float>; ///< Matrix with 4 columns and 4 rows of
 /// @}
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_quaternion_implementation
+/// @{
+///
+/// @name Quaternion types.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using Quaterniond = Quaternion<double>; ///< Quaternion of double values.
+using Quaternionf = Quaternion<float>;  ///< Quaternion of float values.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+///
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_transform_implementation
+/// @{
+///
+/// @name Transform types.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using Transformd = Transform<double>; ///< Transformation of double values.
+using Transformf = Transform<float>;  ///< Transformation of float values.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+///
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @addtogroup math_primitive_types
+/// @{
+///
+/// @name Primitive types.
+/// @{
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+using Aabbd    = Aabb<double>;    ///< Axis-aligned bounding box of double values.
+using Frustumd = Frustum<double>; ///< View frustum of double values.
+using Planed   = Plane<double>;   ///< Plane of double values.
+using Rayd     = Ray<double>;     ///< Ray of double values.
+using Sphered  = Sphere<double>;  ///< Sphere of double values.
+
+using Aabbf    = Aabb<float>;    ///< Axis-aligned bounding box of float values.
+using Frustumf = Frustum<float>; ///< View frustum of float values.
+using Planef   = Plane<float>;   ///< Plane of float values.
+using Rayf     = Ray<float>;     ///< Ray of float values.
+using Spheref  = Sphere<float>;  ///< Sphere of float values.
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// @}
+///
+/// @}
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
 } // namespace framework::math
 
 #endif
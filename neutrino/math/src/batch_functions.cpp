@@ -0,0 +1,457 @@
+#include <algorithm>
+#include <cassert>
+#include <exception>
+#include <future>
+#include <vector>
+
+#include <math/inc/batch_functions.hpp>
+#include <math/inc/geometric_functions.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+using framework::Span;
+using framework::ThreadPool;
+using framework::math::Matrix;
+using framework::math::Quaternion;
+using framework::math::Vector;
+using framework::math::Vector3Span;
+
+using Matrix4f    = Matrix<4, 4, float>;
+using Quaternionf = Quaternion<float>;
+using Vector3f    = Vector<3, float>;
+using Vector4f    = Vector<4, float>;
+
+// Arrays shorter than two chunks are processed in the calling thread.
+constexpr std::size_t min_chunk_size = 8192;
+
+// Calls function(begin, end) for the chunks of the range [0, count).
+template <typename Function>
+void parallel_for(std::size_t count, ThreadPool* pool, const Function& function)
+{
+    const std::size_t chunks_count = pool != nullptr ? std::min(pool->threads_count(), count / min_chunk_size) : 0;
+    if (chunks_count < 2) {
+        function(std::size_t{0}, count);
+        return;
+    }
+
+    // Chunks are aligned to the SIMD width, so only the last one has the scalar tail.
+    const std::size_t chunk_size = ((count + chunks_count - 1) / chunks_count + 3) & ~std::size_t{3};
+
+    std::vector<std::future<void>> tasks;
+    for (std::size_t begin = chunk_size; begin < count; begin += chunk_size) {
+        const std::size_t end = std::min(count, begin + chunk_size);
+        tasks.push_back(pool->submit([&function, begin, end]() { function(begin, end); }));
+    }
+
+    std::exception_ptr error;
+    try {
+        function(std::size_t{0}, chunk_size);
+    } catch (...) {
+        error = std::current_exception();
+    }
+
+    // The tasks refer to the function, so all of them are finished before an exception leaves.
+    for (auto& task : tasks) {
+        task.wait();
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    for (auto& task : tasks) {
+        task.get();
+    }
+}
+
+Vector3f transform(const Matrix4f& m, const Vector3f& v, float w)
+{
+    return Vector3f(m * Vector4f(v, w));
+}
+
+Matrix4f compose_transform(const Vector3f& t, const Quaternionf& q, const Vector3f& s)
+{
+    const float xx = q.x * q.x;
+    const float yy = q.y * q.y;
+    const float zz = q.z * q.z;
+    const float xy = q.x * q.y;
+    const float xz = q.x * q.z;
+    const float yz = q.y * q.z;
+    const float wx = q.w * q.x;
+    const float wy = q.w * q.y;
+    const float wz = q.w * q.z;
+
+    return Matrix4f((1.0f - 2.0f * (yy + zz)) * s.x,
+                    2.0f * (xy + wz) * s.x,
+                    2.0f * (xz - wy) * s.x,
+                    0.0f,
+
+                    2.0f * (xy - wz) * s.y,
+                    (1.0f - 2.0f * (xx + zz)) * s.y,
+                    2.0f * (yz + wx) * s.y,
+                    0.0f,
+
+                    2.0f * (xz + wy) * s.z,
+                    2.0f * (yz - wx) * s.z,
+                    (1.0f - 2.0f * (xx + yy)) * s.z,
+                    0.0f,
+
+                    t.x,
+                    t.y,
+                    t.z,
+                    1.0f);
+}
+
+#if defined(__SSE2__)
+
+// Four 3d vectors {x0 y0 z0 x1} {y1 z1 x2 y2} {z2 x3 y3 z3} to the {x0 x1 x2 x3}, {y0 y1 y2 y3}, {z0 z1 z2 z3}.
+inline void load_vectors(const Vector3f* vectors, __m128& x, __m128& y, __m128& z)
+{
+    const float* data = vectors->data();
+
+    const __m128 a = _mm_loadu_ps(data);
+    const __m128 b = _mm_loadu_ps(data + 4);
+    const __m128 c = _mm_loadu_ps(data + 8);
+
+    x = _mm_shuffle_ps(a, _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2)), _MM_SHUFFLE(2, 0, 3, 0));
+    y = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 0, 1)),
+                       _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 2, 0, 3)),
+                       _MM_SHUFFLE(2, 0, 2, 0));
+    z = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 1, 0, 2)), c, _MM_SHUFFLE(3, 0, 2, 0));
+}
+
+// Reverse of the load_vectors.
+inline void store_vectors(Vector3f* vectors, __m128 x, __m128 y, __m128 z)
+{
+    float* data = vectors->data();
+
+    const __m128 xy_low  = _mm_unpacklo_ps(x, y);
+    const __m128 xy_high = _mm_unpackhi_ps(x, y);
+
+    const __m128 a = _mm_shuffle_ps(xy_low,
+                                    _mm_shuffle_ps(z, xy_low, _MM_SHUFFLE(0, 2, 0, 0)),
+                                    _MM_SHUFFLE(2, 0, 1, 0));
+    const __m128 b = _mm_shuffle_ps(_mm_shuffle_ps(xy_low, z, _MM_SHUFFLE(0, 1, 0, 3)),
+                                    xy_high,
+                                    _MM_SHUFFLE(1, 0, 2, 0));
+    const __m128 c = _mm_shuffle_ps(_mm_shuffle_ps(z, xy_high, _MM_SHUFFLE(0, 2, 0, 2)),
+                                    _mm_shuffle_ps(xy_high, z, _MM_SHUFFLE(0, 3, 0, 3)),
+                                    _MM_SHUFFLE(2, 0, 2, 0));
+
+    _mm_storeu_ps(data, a);
+    _mm_storeu_ps(data + 4, b);
+    _mm_storeu_ps(data + 8, c);
+}
+
+// Matrix components broadcasted to transform four vectors at once.
+class SimdTransform
+{
+public:
+    SimdTransform(const Matrix4f& m, float w)
+    {
+        for (std::size_t c = 0; c < 3; ++c) {
+            for (std::size_t r = 0; r < 3; ++r) {
+                m_columns[c][r] = _mm_set1_ps(m[c][r]);
+            }
+            m_translation[c] = _mm_set1_ps(m[3][c] * w);
+        }
+    }
+
+    void apply(__m128& x, __m128& y, __m128& z) const
+    {
+        __m128 result[3];
+        for (std::size_t r = 0; r < 3; ++r) {
+            result[r] = _mm_mul_ps(m_columns[0][r], x);
+            result[r] = _mm_add_ps(result[r], _mm_mul_ps(m_columns[1][r], y));
+            result[r] = _mm_add_ps(result[r], _mm_mul_ps(m_columns[2][r], z));
+            result[r] = _mm_add_ps(result[r], m_translation[r]);
+        }
+
+        x = result[0];
+        y = result[1];
+        z = result[2];
+    }
+
+private:
+    __m128 m_columns[3][3];
+    __m128 m_translation[3];
+};
+
+inline void normalize_vectors(__m128& x, __m128& y, __m128& z)
+{
+    const __m128 squared_length = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+    const __m128 inverse_length = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(squared_length));
+
+    x = _mm_mul_ps(x, inverse_length);
+    y = _mm_mul_ps(y, inverse_length);
+    z = _mm_mul_ps(z, inverse_length);
+}
+
+#endif
+
+void transform_range(const Matrix4f& m,
+                     Span<const Vector3f> vectors,
+                     Span<Vector3f> result,
+                     float w,
+                     std::size_t begin,
+                     std::size_t end)
+{
+    std::size_t i = begin;
+
+#if defined(__SSE2__)
+    const SimdTransform simd_transform(m, w);
+    for (; i + 4 <= end; i += 4) {
+        __m128 x, y, z;
+        load_vectors(vectors.data() + i, x, y, z);
+        simd_transform.apply(x, y, z);
+        store_vectors(result.data() + i, x, y, z);
+    }
+#endif
+
+    for (; i < end; ++i) {
+        result[i] = transform(m, vectors[i], w);
+    }
+}
+
+void transform_range(const Matrix4f& m,
+                     Vector3Span<const float> vectors,
+                     Vector3Span<float> result,
+                     float w,
+                     std::size_t begin,
+                     std::size_t end)
+{
+    std::size_t i = begin;
+
+#if defined(__SSE2__)
+    const SimdTransform simd_transform(m, w);
+    for (; i + 4 <= end; i += 4) {
+        __m128 x = _mm_loadu_ps(vectors.x.data() + i);
+        __m128 y = _mm_loadu_ps(vectors.y.data() + i);
+        __m128 z = _mm_loadu_ps(vectors.z.data() + i);
+
+        simd_transform.apply(x, y, z);
+
+        _mm_storeu_ps(result.x.data() + i, x);
+        _mm_storeu_ps(result.y.data() + i, y);
+        _mm_storeu_ps(result.z.data() + i, z);
+    }
+#endif
+
+    for (; i < end; ++i) {
+        const Vector3f v = transform(m, Vector3f(vectors.x[i], vectors.y[i], vectors.z[i]), w);
+
+        result.x[i] = v.x;
+        result.y[i] = v.y;
+        result.z[i] = v.z;
+    }
+}
+
+[[maybe_unused]] bool is_valid(Vector3Span<const float> vectors, Vector3Span<float> result)
+{
+    const std::size_t size = vectors.size();
+    return vectors.y.size() == size && vectors.z.size() == size && result.x.size() == size &&
+           result.y.size() == size && result.z.size() == size;
+}
+
+} // namespace
+
+namespace framework::math
+{
+
+void transform_points(const Matrix4f& m, Span<const Vector3f> points, Span<Vector3f> result, ThreadPool* pool)
+{
+    assert(points.size() == result.size());
+
+    parallel_for(points.size(), pool, [&](std::size_t begin, std::size_t end) {
+        transform_range(m, points, result, 1.0f, begin, end);
+    });
+}
+
+void transform_points(const Matrix4f& m, Vector3Span<const float> points, Vector3Span<float> result, ThreadPool* pool)
+{
+    assert(is_valid(points, result));
+
+    parallel_for(points.size(), pool, [&](std::size_t begin, std::size_t end) {
+        transform_range(m, points, result, 1.0f, begin, end);
+    });
+}
+
+void transform_directions(const Matrix4f& m,
+                          Span<const Vector3f> directions,
+                          Span<Vector3f> result,
+                          ThreadPool* pool)
+{
+    assert(directions.size() == result.size());
+
+    parallel_for(directions.size(), pool, [&](std::size_t begin, std::size_t end) {
+        transform_range(m, directions, result, 0.0f, begin, end);
+    });
+}
+
+void transform_directions(const Matrix4f& m,
+                          Vector3Span<const float> directions,
+                          Vector3Span<float> result,
+                          ThreadPool* pool)
+{
+    assert(is_valid(directions, result));
+
+    parallel_for(directions.size(), pool, [&](std::size_t begin, std::size_t end) {
+        transform_range(m, directions, result, 0.0f, begin, end);
+    });
+}
+
+void transform_vectors(const Matrix4f& m, Span<const Vector4f> vectors, Span<Vector4f> result, ThreadPool* pool)
+{
+    assert(vectors.size() == result.size());
+
+    // Matrix4f * Vector4f is already done with SIMD instructions.
+    parallel_for(vectors.size(), pool, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            result[i] = m * vectors[i];
+        }
+    });
+}
+
+void normalize(Span<const Vector3f> vectors, Span<Vector3f> result, ThreadPool* pool)
+{
+    assert(vectors.size() == result.size());
+
+    parallel_for(vectors.size(), pool, [&](std::size_t begin, std::size_t end) {
+        std::size_t i = begin;
+
+#if defined(__SSE2__)
+        for (; i + 4 <= end; i += 4) {
+            __m128 x, y, z;
+            load_vectors(vectors.data() + i, x, y, z);
+            normalize_vectors(x, y, z);
+            store_vectors(result.data() + i, x, y, z);
+        }
+#endif
+
+        for (; i < end; ++i) {
+            result[i] = normalize(vectors[i]);
+        }
+    });
+}
+
+void normalize(Vector3Span<const float> vectors, Vector3Span<float> result, ThreadPool* pool)
+{
+    assert(is_valid(vectors, result));
+
+    parallel_for(vectors.size(), pool, [&](std::size_t begin, std::size_t end) {
+        std::size_t i = begin;
+
+#if defined(__SSE2__)
+        for (; i + 4 <= end; i += 4) {
+            __m128 x = _mm_loadu_ps(vectors.x.data() + i);
+            __m128 y = _mm_loadu_ps(vectors.y.data() + i);
+            __m128 z = _mm_loadu_ps(vectors.z.data() + i);
+
+            normalize_vectors(x, y, z);
+
+            _mm_storeu_ps(result.x.data() + i, x);
+            _mm_storeu_ps(result.y.data() + i, y);
+            _mm_storeu_ps(result.z.data() + i, z);
+        }
+#endif
+
+        for (; i < end; ++i) {
+            const Vector3f v = normalize(Vector3f(vectors.x[i], vectors.y[i], vectors.z[i]));
+
+            result.x[i] = v.x;
+            result.y[i] = v.y;
+            result.z[i] = v.z;
+        }
+    });
+}
+
+void multiply(Span<const Matrix4f> lhs, Span<const Matrix4f> rhs, Span<Matrix4f> result, ThreadPool* pool)
+{
+    assert(lhs.size() == rhs.size() && lhs.size() == result.size());
+
+    // Matrix4f * Matrix4f is already done with SIMD instructions.
+    parallel_for(lhs.size(), pool, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            result[i] = lhs[i] * rhs[i];
+        }
+    });
+}
+
+void compose_transforms(Span<const Vector3f> translations,
+                        Span<const Quaternionf> rotations,
+                        Span<const Vector3f> scales,
+                        Span<Matrix4f> result,
+                        ThreadPool* pool)
+{
+    assert(translations.size() == result.size() && rotations.size() == result.size() &&
+           scales.size() == result.size());
+
+    parallel_for(result.size(), pool, [&](std::size_t begin, std::size_t end) {
+        std::size_t i = begin;
+
+#if defined(__SSE2__)
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 one  = _mm_set1_ps(1.0f);
+        const __m128 two  = _mm_set1_ps(2.0f);
+
+        for (; i + 4 <= end; i += 4) {
+            __m128 tx, ty, tz;
+            load_vectors(translations.data() + i, tx, ty, tz);
+
+            __m128 sx, sy, sz;
+            load_vectors(scales.data() + i, sx, sy, sz);
+
+            __m128 qx = _mm_loadu_ps(rotations[i].data());
+            __m128 qy = _mm_loadu_ps(rotations[i + 1].data());
+            __m128 qz = _mm_loadu_ps(rotations[i + 2].data());
+            __m128 qw = _mm_loadu_ps(rotations[i + 3].data());
+            _MM_TRANSPOSE4_PS(qx, qy, qz, qw);
+
+            const __m128 xx = _mm_mul_ps(qx, qx);
+            const __m128 yy = _mm_mul_ps(qy, qy);
+            const __m128 zz = _mm_mul_ps(qz, qz);
+            const __m128 xy = _mm_mul_ps(qx, qy);
+            const __m128 xz = _mm_mul_ps(qx, qz);
+            const __m128 yz = _mm_mul_ps(qy, qz);
+            const __m128 wx = _mm_mul_ps(qw, qx);
+            const __m128 wy = _mm_mul_ps(qw, qy);
+            const __m128 wz = _mm_mul_ps(qw, qz);
+
+            // Components of four matrices, the same expressions as in compose_transform.
+            __m128 columns[4][4] = {
+            {_mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(yy, zz))), sx),
+             _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xy, wz)), sx),
+             _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xz, wy)), sx),
+             zero},
+            {_mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(xy, wz)), sy),
+             _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, zz))), sy),
+             _mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(yz, wx)), sy),
+             zero},
+            {_mm_mul_ps(_mm_mul_ps(two, _mm_add_ps(xz, wy)), sz),
+             _mm_mul_ps(_mm_mul_ps(two, _mm_sub_ps(yz, wx)), sz),
+             _mm_mul_ps(_mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(xx, yy))), sz),
+             zero},
+            {tx, ty, tz, one},
+            };
+
+            for (std::size_t c = 0; c < 4; ++c) {
+                _MM_TRANSPOSE4_PS(columns[c][0], columns[c][1], columns[c][2], columns[c][3]);
+
+                for (std::size_t k = 0; k < 4; ++k) {
+                    _mm_storeu_ps(result[i + k][c].data(), columns[c][k]);
+                }
+            }
+        }
+#endif
+
+        for (; i < end; ++i) {
+            result[i] = compose_transform(translations[i], rotations[i], scales[i]);
+        }
+    });
+}
+
+} // namespace framework::math
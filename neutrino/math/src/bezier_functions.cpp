@@ -0,0 +1,105 @@
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+
+#include <math/inc/bezier_functions.hpp>
+#include <math/inc/common_functions.hpp>
+#include <math/inc/geometric_functions.hpp>
+
+namespace
+{
+using framework::math::Polygon;
+using Vector2f = framework::math::Vector<2, float>;
+
+// Limits for the curves with the huge bend or the tiny tolerance.
+constexpr std::size_t max_quadratic_steps = 256;
+constexpr int max_cubic_depth             = 8;
+
+float squared_distance_to_segment(const Vector2f& point, const Vector2f& a, const Vector2f& b)
+{
+    using framework::math::clamp;
+    using framework::math::dot;
+
+    const Vector2f ab = b - a;
+    const float t     = dot(ab, ab) > 0.0f ? clamp(dot(point - a, ab) / dot(ab, ab), 0.0f, 1.0f) : 0.0f;
+    const Vector2f d  = point - (a + ab * t);
+
+    return dot(d, d);
+}
+
+void flatten_cubic(const Vector2f& p1,
+                   const Vector2f& p2,
+                   const Vector2f& p3,
+                   const Vector2f& p4,
+                   float squared_tolerance,
+                   int depth,
+                   Polygon& polygon)
+{
+    // The curve deviates from the chord by no more than sqrt(max(ax^2, bx^2) + max(ay^2, by^2)) / 4.
+    const Vector2f a = 3.0f * p2 - 2.0f * p1 - p4;
+    const Vector2f b = 3.0f * p3 - p1 - 2.0f * p4;
+
+    const float deviation = std::max(a.x * a.x, b.x * b.x) + std::max(a.y * a.y, b.y * b.y);
+
+    // The curve is inside the hull of the control points, so it's also flat if the off curve points are close
+    // to the chord. This one holds for the straight curves with uneven control points.
+    const float hull_deviation = std::max(squared_distance_to_segment(p2, p1, p4),
+                                          squared_distance_to_segment(p3, p1, p4));
+
+    if (deviation <= 16.0f * squared_tolerance || hull_deviation <= squared_tolerance || depth == max_cubic_depth) {
+        polygon.push_back(p4);
+        return;
+    }
+
+    // De Casteljau split at the middle.
+    const Vector2f p12   = (p1 + p2) * 0.5f;
+    const Vector2f p23   = (p2 + p3) * 0.5f;
+    const Vector2f p34   = (p3 + p4) * 0.5f;
+    const Vector2f p123  = (p12 + p23) * 0.5f;
+    const Vector2f p234  = (p23 + p34) * 0.5f;
+    const Vector2f p1234 = (p123 + p234) * 0.5f;
+
+    flatten_cubic(p1, p12, p123, p1234, squared_tolerance, depth + 1, polygon);
+    flatten_cubic(p1234, p234, p34, p4, squared_tolerance, depth + 1, polygon);
+}
+
+} // namespace
+
+namespace framework::math
+{
+
+void flatten_quadratic_bezier(const Vector2f& p1,
+                              const Vector2f& p2,
+                              const Vector2f& p3,
+                              float tolerance,
+                              Polygon& polygon)
+{
+    assert(tolerance > 0.0f);
+
+    // The second derivative of the quadratic curve is constant, so the uniform steps are the best ones.
+    // The curve deviates from the chord of the step by |p1 - 2 * p2 + p3| / (4 * steps^2).
+    const float deviation   = length(p1 - 2.0f * p2 + p3);
+    const auto steps_count  = static_cast<std::size_t>(std::ceil(std::sqrt(deviation / (4.0f * tolerance))));
+    const std::size_t steps = std::clamp<std::size_t>(steps_count, 1, max_quadratic_steps);
+
+    for (std::size_t i = 1; i < steps; ++i) {
+        polygon.push_back(quadratic_bezier(p1, p2, p3, static_cast<float>(i) / static_cast<float>(steps)));
+    }
+
+    polygon.push_back(p3);
+}
+
+void flatten_cubic_bezier(const Vector2f& p1,
+                          const Vector2f& p2,
+                          const Vector2f& p3,
+                          const Vector2f& p4,
+                          float tolerance,
+                          Polygon& polygon)
+{
+    assert(tolerance > 0.0f);
+
+    flatten_cubic(p1, p2, p3, p4, tolerance * tolerance, 0, polygon);
+}
+
+} // namespace framework::math
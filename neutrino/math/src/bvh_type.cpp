@@ -0,0 +1,668 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <future>
+
+#include <math/inc/bvh_type.hpp>
+#include <math/inc/intersection_functions.hpp>
+
+namespace
+{
+using framework::Span;
+using framework::ThreadPool;
+using framework::math::Aabb;
+using framework::math::Bvh;
+using framework::math::Frustum;
+using framework::math::Plane;
+using framework::math::Ray;
+using framework::math::Vector;
+
+using Aabbf    = Aabb<float>;
+using Node     = Bvh::Node;
+using Vector3f = Vector<3, float>;
+
+constexpr std::size_t bins_count = 16;
+
+// Below this depth splits halve the primitives, so the depth is limited by 64 for any input.
+constexpr std::size_t max_sah_depth = 32;
+constexpr std::size_t max_depth     = 64;
+
+// Cost of the node traversal relative to the primitive test.
+constexpr float traversal_cost = 1.0f;
+
+// Subtrees smaller than this are not split between the tasks.
+constexpr std::uint32_t min_task_size = 4096;
+
+const float infinity = std::numeric_limits<float>::infinity();
+
+float half_area(const Aabbf& box)
+{
+    const Vector3f size = box.size();
+    return size.x * size.y + size.y * size.z + size.z * size.x;
+}
+
+Aabbf triangle_box(const Vector3f& v1, const Vector3f& v2, const Vector3f& v3)
+{
+    return merge(Aabbf(v1, v1), Aabbf(min(v2, v3), max(v2, v3)));
+}
+
+// Subtree, which is built by a separate task.
+struct Task
+{
+    std::size_t node;
+    std::uint32_t begin;
+    std::uint32_t end;
+    std::size_t depth;
+};
+
+// Primitive with its box. Builder partitions the references instead of indices, so the boxes are read sequentially.
+struct Reference
+{
+    Aabbf box;
+    std::uint32_t primitive;
+};
+
+// Doubled center of the box, the scale doesn't matter for binning.
+Vector3f centroid(const Reference& reference)
+{
+    return reference.box.min_point + reference.box.max_point;
+}
+
+class Builder
+{
+public:
+    explicit Builder(std::vector<Reference>& references)
+        : m_references(references)
+    {}
+
+    // Builds nodes of the subtree. With the tasks array, subtrees not larger than the task size are added to it
+    // instead of building them.
+    void build(std::vector<Node>& nodes,
+               std::size_t node,
+               std::uint32_t begin,
+               std::uint32_t end,
+               std::size_t depth,
+               std::vector<Task>* tasks,
+               std::uint32_t task_size) const
+    {
+        Aabbf bounds;
+        Aabbf centroid_bounds;
+        for (std::uint32_t i = begin; i < end; ++i) {
+            bounds          = merge(bounds, m_references[i].box);
+            centroid_bounds = merge(centroid_bounds, centroid(m_references[i]));
+        }
+
+        nodes[node].bounds = bounds;
+
+        const std::uint32_t count = end - begin;
+        if (tasks != nullptr && count <= task_size) {
+            tasks->push_back(Task{node, begin, end, depth});
+            return;
+        }
+
+        const std::uint32_t middle = split(bounds, centroid_bounds, begin, end, depth);
+        if (middle == begin) {
+            nodes[node].first = begin;
+            nodes[node].count = count;
+            return;
+        }
+
+        const std::size_t left = nodes.size();
+        nodes.resize(left + 2);
+
+        nodes[node].first = static_cast<std::uint32_t>(left);
+        nodes[node].count = 0;
+
+        build(nodes, left, begin, middle, depth + 1, tasks, task_size);
+        build(nodes, left + 1, middle, end, depth + 1, tasks, task_size);
+    }
+
+private:
+    // Partitions primitives and returns the beginning of the right part, or begin for the leaf.
+    std::uint32_t split(const Aabbf& bounds,
+                        const Aabbf& centroid_bounds,
+                        std::uint32_t begin,
+                        std::uint32_t end,
+                        std::size_t depth) const
+    {
+        const std::uint32_t count = end - begin;
+        if (count == 1) {
+            return begin;
+        }
+
+        const Vector3f extent = centroid_bounds.size();
+
+        std::size_t best_axis = 0;
+        std::size_t best_bin  = 0;
+        float best_cost       = infinity;
+
+        if (depth < max_sah_depth) {
+            // Axes with zero extent get all primitives to the first bin, so they have no splits.
+            Vector3f scale;
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                scale[axis] = extent[axis] > 0.0f ? static_cast<float>(bins_count) / extent[axis] : 0.0f;
+            }
+
+            std::array<std::array<Aabbf, bins_count>, 3> bins;
+            std::array<std::array<std::uint32_t, bins_count>, 3> bin_counts{};
+
+            for (std::uint32_t i = begin; i < end; ++i) {
+                const Aabbf& box      = m_references[i].box;
+                const Vector3f center = centroid(m_references[i]);
+
+                for (std::size_t axis = 0; axis < 3; ++axis) {
+                    const std::size_t bin = bin_index(center[axis], centroid_bounds.min_point[axis], scale[axis]);
+
+                    bins[axis][bin] = merge(bins[axis][bin], box);
+                    ++bin_counts[axis][bin];
+                }
+            }
+
+            for (std::size_t axis = 0; axis < 3; ++axis) {
+                const float cost = find_split(bins[axis], bin_counts[axis], best_bin, best_cost);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_axis = axis;
+                }
+            }
+        }
+
+        // Not splitting is cheaper, or the split is not found.
+        const float area      = half_area(bounds);
+        const float leaf_cost = static_cast<float>(count) * area;
+        if (count <= Bvh::max_leaf_size && !(best_cost + traversal_cost * area < leaf_cost)) {
+            return begin;
+        }
+
+        Reference* first = m_references.data() + begin;
+        Reference* last  = m_references.data() + end;
+
+        if (best_cost == infinity) {
+            // All centroids are at the same point or the tree is too deep, halve the primitives.
+            const std::size_t axis = extent.x >= extent.y && extent.x >= extent.z ? 0 : (extent.y >= extent.z ? 1 : 2);
+            Reference* middle      = first + count / 2;
+
+            std::nth_element(first, middle, last, [axis](const Reference& a, const Reference& b) {
+                return centroid(a)[axis] < centroid(b)[axis];
+            });
+
+            return begin + count / 2;
+        }
+
+        const float scale = static_cast<float>(bins_count) / extent[best_axis];
+        const float start = centroid_bounds.min_point[best_axis];
+
+        Reference* middle = std::partition(first, last, [&](const Reference& reference) {
+            return bin_index(centroid(reference)[best_axis], start, scale) <= best_bin;
+        });
+
+        return static_cast<std::uint32_t>(middle - m_references.data());
+    }
+
+    // Finds the split with the lowest cost after one of the bins. Updates the bin only if the cost is lower than
+    // the current one, returns the lowest cost.
+    static float find_split(const std::array<Aabbf, bins_count>& bins,
+                            const std::array<std::uint32_t, bins_count>& bin_counts,
+                            std::size_t& best_bin,
+                            float current_cost)
+    {
+        // Areas and counts of the right parts for the splits after each bin.
+        std::array<float, bins_count> right_areas{};
+        std::array<std::uint32_t, bins_count> right_counts{};
+
+        Aabbf right_box;
+        std::uint32_t right_count = 0;
+        for (std::size_t bin = bins_count - 1; bin > 0; --bin) {
+            right_box   = merge(right_box, bins[bin]);
+            right_count = right_count + bin_counts[bin];
+
+            right_areas[bin - 1]  = right_count > 0 ? half_area(right_box) : 0.0f;
+            right_counts[bin - 1] = right_count;
+        }
+
+        float best_cost = current_cost;
+
+        Aabbf left_box;
+        std::uint32_t left_count = 0;
+        for (std::size_t bin = 0; bin + 1 < bins_count; ++bin) {
+            left_box   = merge(left_box, bins[bin]);
+            left_count = left_count + bin_counts[bin];
+
+            if (left_count == 0 || right_counts[bin] == 0) {
+                continue;
+            }
+
+            const float cost = static_cast<float>(left_count) * half_area(left_box) +
+                               static_cast<float>(right_counts[bin]) * right_areas[bin];
+            if (cost < best_cost) {
+                best_cost = cost;
+                best_bin  = bin;
+            }
+        }
+
+        return best_cost;
+    }
+
+    static std::size_t bin_index(float value, float start, float scale)
+    {
+        const auto bin = static_cast<int>((value - start) * scale);
+        return static_cast<std::size_t>(std::min(bin, static_cast<int>(bins_count) - 1));
+    }
+
+    std::vector<Reference>& m_references;
+};
+
+// Ray prepared for the slab tests. The near and far planes of the boxes are chosen by the direction signs.
+// Zero direction components are made positive, so their inverse is positive infinity, and a slab bound is NaN
+// only for the origin on the plane, which is inside the slab.
+struct RaySlabs
+{
+    explicit RaySlabs(const Ray<float>& ray)
+        : origin(ray.origin)
+        , inverse_direction(1.0f / (ray.direction + Vector3f(0.0f)))
+        , negative{inverse_direction.x < 0.0f, inverse_direction.y < 0.0f, inverse_direction.z < 0.0f}
+    {}
+
+    Vector3f origin;
+    Vector3f inverse_direction;
+    std::array<bool, 3> negative;
+};
+
+// Returns the distance to the box entry point, or infinity if the ray misses the box.
+float entry_distance(const RaySlabs& ray, const Aabbf& box, float max_distance)
+{
+    const Vector3f near_point(ray.negative[0] ? box.max_point.x : box.min_point.x,
+                              ray.negative[1] ? box.max_point.y : box.min_point.y,
+                              ray.negative[2] ? box.max_point.z : box.min_point.z);
+    const Vector3f far_point(ray.negative[0] ? box.min_point.x : box.max_point.x,
+                             ray.negative[1] ? box.min_point.y : box.max_point.y,
+                             ray.negative[2] ? box.min_point.z : box.max_point.z);
+
+    const Vector3f t_near = (near_point - ray.origin) * ray.inverse_direction;
+    const Vector3f t_far  = (far_point - ray.origin) * ray.inverse_direction;
+
+    // Comparisons with NaN are false, so NaN bounds are skipped.
+    float entry = 0.0f;
+    float exit  = max_distance;
+    for (std::size_t i = 0; i < 3; ++i) {
+        entry = t_near[i] > entry ? t_near[i] : entry;
+        exit  = t_far[i] < exit ? t_far[i] : exit;
+    }
+
+    return entry <= exit ? entry : infinity;
+}
+
+enum class Overlap
+{
+    none,
+    partial,
+    full,
+};
+
+Overlap classify(const Aabbf& box, const Aabbf& bounds)
+{
+    if (!overlaps(box, bounds)) {
+        return Overlap::none;
+    }
+
+    return contains(box, bounds.min_point) && contains(box, bounds.max_point) ? Overlap::full : Overlap::partial;
+}
+
+Overlap classify(const Frustum<float>& frustum, const Aabbf& bounds)
+{
+    Overlap overlap = Overlap::full;
+    for (const Plane<float>& plane : frustum.planes) {
+        // The box corners farthest and closest along the plane normal.
+        const Vector3f far_corner(plane.normal.x >= 0.0f ? bounds.max_point.x : bounds.min_point.x,
+                                  plane.normal.y >= 0.0f ? bounds.max_point.y : bounds.min_point.y,
+                                  plane.normal.z >= 0.0f ? bounds.max_point.z : bounds.min_point.z);
+        const Vector3f near_corner(plane.normal.x >= 0.0f ? bounds.min_point.x : bounds.max_point.x,
+                                   plane.normal.y >= 0.0f ? bounds.min_point.y : bounds.max_point.y,
+                                   plane.normal.z >= 0.0f ? bounds.min_point.z : bounds.max_point.z);
+
+        if (signed_distance(plane, far_corner) < 0.0f) {
+            return Overlap::none;
+        }
+
+        if (signed_distance(plane, near_corner) < 0.0f) {
+            overlap = Overlap::partial;
+        }
+    }
+
+    return overlap;
+}
+
+// Calls function(first, last, check) for the ranges of primitives in the overlapped nodes. Primitives of the nodes
+// entirely inside the region are not checked.
+template <typename Region, typename Function>
+void traverse(Span<const Node> nodes, const Region& region, const Function& function)
+{
+    if (nodes.empty()) {
+        return;
+    }
+
+    std::array<std::uint32_t, max_depth + 2> stack;
+    std::size_t stack_size = 0;
+
+    stack[stack_size++] = 0;
+    while (stack_size > 0) {
+        const Node& node      = nodes[stack[--stack_size]];
+        const Overlap overlap = classify(region, node.bounds);
+
+        if (overlap == Overlap::none) {
+            continue;
+        }
+
+        if (overlap == Overlap::full) {
+            // Primitives of the subtree are between its leftmost and rightmost leaves.
+            const Node* leftmost  = &node;
+            const Node* rightmost = &node;
+            while (leftmost->count == 0) {
+                leftmost = &nodes[leftmost->first];
+            }
+            while (rightmost->count == 0) {
+                rightmost = &nodes[rightmost->first + 1];
+            }
+
+            function(leftmost->first, rightmost->first + rightmost->count, false);
+        } else if (node.count > 0) {
+            function(node.first, node.first + node.count, true);
+        } else {
+            stack[stack_size++] = node.first + 1;
+            stack[stack_size++] = node.first;
+        }
+    }
+}
+
+} // namespace
+
+namespace framework::math
+{
+
+void Bvh::build(Span<const Aabb<float>> boxes, ThreadPool* pool)
+{
+    m_boxes.assign(boxes.begin(), boxes.end());
+    m_triangles.clear();
+
+    build_nodes(pool);
+}
+
+void Bvh::build(Span<const Vector<3, float>> vertices, Span<const std::uint32_t> indices, ThreadPool* pool)
+{
+    assert(indices.size() % 3 == 0);
+
+    m_boxes.clear();
+    m_boxes.reserve(indices.size() / 3);
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        m_boxes.push_back(triangle_box(vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]]));
+    }
+
+    build_nodes(pool);
+
+    m_triangles.resize(indices.size());
+    for (std::size_t i = 0; i < m_primitives.size(); ++i) {
+        const std::size_t triangle = std::size_t{m_primitives[i]} * 3;
+
+        m_triangles[i * 3]     = vertices[indices[triangle]];
+        m_triangles[i * 3 + 1] = vertices[indices[triangle + 1]];
+        m_triangles[i * 3 + 2] = vertices[indices[triangle + 2]];
+    }
+}
+
+void Bvh::refit(Span<const Aabb<float>> boxes)
+{
+    assert(boxes.size() == m_primitives.size());
+
+    for (std::size_t i = 0; i < m_primitives.size(); ++i) {
+        m_boxes[i] = boxes[m_primitives[i]];
+    }
+
+    update_nodes();
+}
+
+void Bvh::refit(Span<const Vector<3, float>> vertices, Span<const std::uint32_t> indices)
+{
+    assert(indices.size() == m_primitives.size() * 3);
+
+    for (std::size_t i = 0; i < m_primitives.size(); ++i) {
+        const std::size_t triangle = std::size_t{m_primitives[i]} * 3;
+
+        m_triangles[i * 3]     = vertices[indices[triangle]];
+        m_triangles[i * 3 + 1] = vertices[indices[triangle + 1]];
+        m_triangles[i * 3 + 2] = vertices[indices[triangle + 2]];
+
+        m_boxes[i] = triangle_box(m_triangles[i * 3], m_triangles[i * 3 + 1], m_triangles[i * 3 + 2]);
+    }
+
+    update_nodes();
+}
+
+void Bvh::clear() noexcept
+{
+    m_nodes.clear();
+    m_primitives.clear();
+    m_boxes.clear();
+    m_triangles.clear();
+}
+
+bool Bvh::intersect(const Ray<float>& ray, Hit& hit, float max_distance) const
+{
+    if (m_nodes.empty()) {
+        return false;
+    }
+
+    const RaySlabs slabs(ray);
+
+    float closest = max_distance;
+    bool found    = false;
+
+    std::array<std::uint32_t, max_depth> stack;
+    std::size_t stack_size = 0;
+
+    std::uint32_t index = 0;
+    if (entry_distance(slabs, m_nodes[0].bounds, closest) == infinity) {
+        return false;
+    }
+
+    while (true) {
+        const Node& node = m_nodes[index];
+        if (node.count > 0) {
+            for (std::uint32_t i = node.first; i < node.first + node.count; ++i) {
+                if (m_triangles.empty()) {
+                    const float distance = entry_distance(slabs, m_boxes[i], closest);
+                    if (distance < closest) {
+                        closest = distance;
+                        found   = true;
+                        hit     = Hit{m_primitives[i], distance, 0.0f, 0.0f};
+                    }
+                    continue;
+                }
+
+                const Vector3f* triangle = m_triangles.data() + std::size_t{i} * 3;
+
+                RayHit<float> triangle_hit;
+                if (math::intersect(ray, triangle[0], triangle[1], triangle[2], triangle_hit) &&
+                    triangle_hit.distance < closest) {
+                    closest = triangle_hit.distance;
+                    found   = true;
+                    hit     = Hit{m_primitives[i], triangle_hit.distance, triangle_hit.u, triangle_hit.v};
+                }
+            }
+        } else {
+            // Visit the closer child first, the farther one can be skipped after that.
+            std::uint32_t near_child = node.first;
+            std::uint32_t far_child  = node.first + 1;
+
+            float near_distance = entry_distance(slabs, m_nodes[near_child].bounds, closest);
+            float far_distance  = entry_distance(slabs, m_nodes[far_child].bounds, closest);
+
+            if (far_distance < near_distance) {
+                std::swap(near_child, far_child);
+                std::swap(near_distance, far_distance);
+            }
+
+            if (far_distance != infinity) {
+                stack[stack_size++] = far_child;
+            }
+
+            if (near_distance != infinity) {
+                index = near_child;
+                continue;
+            }
+        }
+
+        // Skip nodes farther than the closest hit found after they were pushed.
+        do {
+            if (stack_size == 0) {
+                return found;
+            }
+
+            index = stack[--stack_size];
+        } while (entry_distance(slabs, m_nodes[index].bounds, closest) == infinity);
+    }
+}
+
+void Bvh::query(const Aabb<float>& box, std::vector<std::uint32_t>& result) const
+{
+    traverse(m_nodes, box, [&](std::uint32_t first, std::uint32_t last, bool check) {
+        for (std::uint32_t i = first; i < last; ++i) {
+            if (!check || overlaps(box, m_boxes[i])) {
+                result.push_back(m_primitives[i]);
+            }
+        }
+    });
+}
+
+void Bvh::query(const Frustum<float>& frustum, std::vector<std::uint32_t>& result) const
+{
+    traverse(m_nodes, frustum, [&](std::uint32_t first, std::uint32_t last, bool check) {
+        for (std::uint32_t i = first; i < last; ++i) {
+            if (!check || is_visible(frustum, m_boxes[i])) {
+                result.push_back(m_primitives[i]);
+            }
+        }
+    });
+}
+
+bool Bvh::empty() const noexcept
+{
+    return m_primitives.empty();
+}
+
+Aabb<float> Bvh::bounds() const noexcept
+{
+    return m_nodes.empty() ? Aabb<float>() : m_nodes[0].bounds;
+}
+
+Span<const Bvh::Node> Bvh::nodes() const noexcept
+{
+    return Span<const Node>(m_nodes);
+}
+
+const std::vector<std::uint32_t>& Bvh::primitives() const noexcept
+{
+    return m_primitives;
+}
+
+void Bvh::build_nodes(ThreadPool* pool)
+{
+    assert(m_boxes.size() < std::numeric_limits<std::uint32_t>::max());
+
+    const auto count = static_cast<std::uint32_t>(m_boxes.size());
+
+    m_nodes.clear();
+    m_primitives.clear();
+
+    if (count == 0) {
+        return;
+    }
+
+    std::vector<Reference> references(count);
+    for (std::uint32_t i = 0; i < count; ++i) {
+        references[i] = Reference{m_boxes[i], i};
+    }
+
+    const Builder builder(references);
+
+    // The root is followed by the unused node, so the pairs of children start at even indices.
+    std::vector<Node> nodes(2);
+    nodes.reserve(count);
+
+    const std::size_t threads_count = pool != nullptr ? pool->threads_count() : 0;
+    if (threads_count < 2 || count < min_task_size * 2) {
+        builder.build(nodes, 0, 0, count, 0, nullptr, 0);
+    } else {
+        // The top of the tree is built in the calling thread, the subtrees are built by the tasks.
+        const auto task_size = std::max(min_task_size, static_cast<std::uint32_t>(count / (threads_count * 4)));
+
+        std::vector<Task> tasks;
+        builder.build(nodes, 0, 0, count, 0, &tasks, task_size);
+
+        std::vector<std::vector<Node>> subtrees(tasks.size());
+        std::vector<std::future<void>> futures;
+        futures.reserve(tasks.size());
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            futures.push_back(pool->submit([&builder, &subtrees, &tasks, i]() {
+                subtrees[i].resize(2);
+                builder.build(subtrees[i], 0, tasks[i].begin, tasks[i].end, tasks[i].depth, nullptr, 0);
+            }));
+        }
+
+        // The tasks refer to the local data, so all of them are finished before an exception leaves.
+        for (auto& future : futures) {
+            future.wait();
+        }
+
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            futures[i].get();
+
+            // The subtree root replaces the task node, other nodes except the unused one are appended.
+            const std::vector<Node>& subtree = subtrees[i];
+            const std::size_t offset         = nodes.size() - 2;
+
+            const auto relocate = [offset](const Node& node) {
+                Node result = node;
+                if (result.count == 0) {
+                    result.first += static_cast<std::uint32_t>(offset);
+                }
+                return result;
+            };
+
+            nodes[tasks[i].node] = relocate(subtree[0]);
+            for (std::size_t j = 2; j < subtree.size(); ++j) {
+                nodes.push_back(relocate(subtree[j]));
+            }
+        }
+    }
+
+    m_nodes.assign(nodes.begin(), nodes.end());
+
+    // Boxes are stored in the order of leaves.
+    m_primitives.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        m_primitives[i] = references[i].primitive;
+        m_boxes[i]      = references[i].box;
+    }
+}
+
+void Bvh::update_nodes()
+{
+    // Children are always after the parent, so nodes are updated in the reverse order. The second node is unused.
+    for (std::size_t i = m_nodes.size(); i-- > 0;) {
+        if (i == 1) {
+            continue;
+        }
+
+        Node& node = m_nodes[i];
+        if (node.count > 0) {
+            node.bounds = Aabb<float>();
+            for (std::uint32_t j = node.first; j < node.first + node.count; ++j) {
+                node.bounds = merge(node.bounds, m_boxes[j]);
+            }
+        } else {
+            node.bounds = merge(m_nodes[node.first].bounds, m_nodes[node.first + 1].bounds);
+        }
+    }
+}
+
+} // namespace framework::math
@@ -0,0 +1,524 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <math/inc/polygon_functions.hpp>
+
+namespace
+{
+using namespace framework::math;
+
+using Point = Vector<2, float>;
+
+constexpr std::uint32_t no_triangle = std::numeric_limits<std::uint32_t>::max();
+
+// Sum and its rounding error, a + b == sum + error exactly.
+void two_sum(double a, double b, double& sum, double& error)
+{
+    sum                    = a + b;
+    const double b_virtual = sum - a;
+    const double a_virtual = sum - b_virtual;
+    error                  = (a - a_virtual) + (b - b_virtual);
+}
+
+// Product and its rounding error, a * b == product + error exactly.
+void two_product(double a, double b, double& product, double& error)
+{
+    product = a * b;
+    error   = std::fma(a, b, -product);
+}
+
+// Sign of the exact sum of the values.
+// Values are accumulated into the nonoverlapping expansion by J. R. Shewchuk, its largest component gives the sign.
+double exact_sum_sign(const std::array<double, 16>& values)
+{
+    std::array<double, 16> expansion{};
+    std::size_t size = 0;
+
+    for (double value : values) {
+        for (std::size_t i = 0; i < size; ++i) {
+            two_sum(value, expansion[i], value, expansion[i]);
+        }
+
+        expansion[size++] = value;
+    }
+
+    for (std::size_t i = size; i > 0; --i) {
+        if (expansion[i - 1] != 0.0) {
+            return expansion[i - 1] > 0.0 ? 1.0 : -1.0;
+        }
+    }
+
+    return 0.0;
+}
+
+// Exact sign of acx * bcy - acy * bcx.
+// Differences of the float coordinates are split into two doubles, so all products are exact expansions.
+double exact_orientation(const Point& a, const Point& b, const Point& c)
+{
+    std::array<double, 2> acx{};
+    std::array<double, 2> acy{};
+    std::array<double, 2> bcx{};
+    std::array<double, 2> bcy{};
+    two_sum(static_cast<double>(a.x), -static_cast<double>(c.x), acx[0], acx[1]);
+    two_sum(static_cast<double>(a.y), -static_cast<double>(c.y), acy[0], acy[1]);
+    two_sum(static_cast<double>(b.x), -static_cast<double>(c.x), bcx[0], bcx[1]);
+    two_sum(static_cast<double>(b.y), -static_cast<double>(c.y), bcy[0], bcy[1]);
+
+    std::array<double, 16> terms{};
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < 2; ++i) {
+        for (std::size_t j = 0; j < 2; ++j) {
+            two_product(acx[i], bcy[j], terms[count], terms[count + 1]);
+            two_product(-acy[i], bcx[j], terms[count + 2], terms[count + 3]);
+            count += 4;
+        }
+    }
+
+    return exact_sum_sign(terms);
+}
+
+// Twice the signed area of the triangle, positive for the counterclockwise points.
+// The sign is exact for all float coordinates: results within the rounding error bound by J. R. Shewchuk
+// are recomputed exactly, then only the sign is returned.
+double orientation(const Point& a, const Point& b, const Point& c)
+{
+    const double acx = static_cast<double>(a.x) - static_cast<double>(c.x);
+    const double acy = static_cast<double>(a.y) - static_cast<double>(c.y);
+    const double bcx = static_cast<double>(b.x) - static_cast<double>(c.x);
+    const double bcy = static_cast<double>(b.y) - static_cast<double>(c.y);
+
+    const double left  = acx * bcy;
+    const double right = acy * bcx;
+    const double det   = left - right;
+
+    constexpr double epsilon     = std::numeric_limits<double>::epsilon() / 2.0;
+    constexpr double error_bound = (3.0 + 16.0 * epsilon) * epsilon;
+
+    if (std::abs(det) > error_bound * (std::abs(left) + std::abs(right))) {
+        return det;
+    }
+
+    return exact_orientation(a, b, c);
+}
+
+// Check if the point d is inside the circumcircle of the counterclockwise triangle abc.
+// The result within the rounding error bound is treated as outside, so the edge flipping always terminates.
+bool is_in_circumcircle(const Point& a, const Point& b, const Point& c, const Point& d)
+{
+    const double adx = static_cast<double>(a.x) - static_cast<double>(d.x);
+    const double ady = static_cast<double>(a.y) - static_cast<double>(d.y);
+    const double bdx = static_cast<double>(b.x) - static_cast<double>(d.x);
+    const double bdy = static_cast<double>(b.y) - static_cast<double>(d.y);
+    const double cdx = static_cast<double>(c.x) - static_cast<double>(d.x);
+    const double cdy = static_cast<double>(c.y) - static_cast<double>(d.y);
+
+    const double bdxcdy = bdx * cdy;
+    const double cdxbdy = cdx * bdy;
+    const double cdxady = cdx * ady;
+    const double adxcdy = adx * cdy;
+    const double adxbdy = adx * bdy;
+    const double bdxady = bdx * ady;
+
+    const double alift = adx * adx + ady * ady;
+    const double blift = bdx * bdx + bdy * bdy;
+    const double clift = cdx * cdx + cdy * cdy;
+
+    const double det = alift * (bdxcdy - cdxbdy) + blift * (cdxady - adxcdy) + clift * (adxbdy - bdxady);
+
+    const double permanent = (std::abs(bdxcdy) + std::abs(cdxbdy)) * alift +
+                             (std::abs(cdxady) + std::abs(adxcdy)) * blift +
+                             (std::abs(adxbdy) + std::abs(bdxady)) * clift;
+
+    // Error bound of the incircle test by J. R. Shewchuk.
+    constexpr double epsilon     = std::numeric_limits<double>::epsilon() / 2.0;
+    constexpr double error_bound = (10.0 + 96.0 * epsilon) * epsilon;
+
+    return det > error_bound * permanent;
+}
+
+std::uint64_t edge_key(std::uint32_t a, std::uint32_t b)
+{
+    if (a > b) {
+        std::swap(a, b);
+    }
+
+    return (static_cast<std::uint64_t>(a) << 32) | b;
+}
+
+// Edge i of the triangle is opposite to the vertex i.
+struct Triangle
+{
+    std::array<std::uint32_t, 3> vertices  = {0, 0, 0};
+    std::array<std::uint32_t, 3> neighbors = {no_triangle, no_triangle, no_triangle};
+    std::array<bool, 3> constrained        = {false, false, false}; // Polygon edges can't be flipped.
+};
+
+// Triangle and the index of its edge.
+using EdgeReference = std::pair<std::uint32_t, std::size_t>;
+
+class DelaunayTriangulation
+{
+public:
+    explicit DelaunayTriangulation(const std::vector<Point>& points);
+
+    void build(const std::vector<std::uint32_t>& triangles, const std::unordered_set<std::uint64_t>& constraints);
+    void insert(std::uint32_t point);
+
+    std::vector<std::uint32_t> indices() const;
+
+private:
+    std::uint32_t locate(const Point& point) const;
+    bool contains(const Triangle& triangle, const Point& point) const;
+
+    void split_triangle(std::uint32_t t, std::uint32_t p);
+    void split_edge(std::uint32_t t, std::size_t edge, std::uint32_t p);
+
+    void legalize();
+    void flip(std::uint32_t t, std::size_t edge);
+
+    std::size_t edge_to(std::uint32_t t, std::uint32_t neighbor) const;
+    void replace_neighbor(std::uint32_t t, std::uint32_t old_neighbor, std::uint32_t new_neighbor);
+
+    const std::vector<Point>& m_points;
+    std::vector<Triangle> m_triangles;
+    std::vector<EdgeReference> m_edges_to_check;
+    std::uint32_t m_last_triangle = 0;
+};
+
+DelaunayTriangulation::DelaunayTriangulation(const std::vector<Point>& points)
+    : m_points(points)
+{}
+
+void DelaunayTriangulation::build(const std::vector<std::uint32_t>& triangles,
+                                  const std::unordered_set<std::uint64_t>& constraints)
+{
+    m_triangles.resize(triangles.size() / 3);
+
+    std::unordered_map<std::uint64_t, EdgeReference> open_edges;
+    open_edges.reserve(triangles.size());
+
+    for (std::uint32_t t = 0; t < m_triangles.size(); ++t) {
+        Triangle& triangle = m_triangles[t];
+        triangle.vertices  = {triangles[t * 3], triangles[t * 3 + 1], triangles[t * 3 + 2]};
+
+        for (std::size_t i = 0; i < 3; ++i) {
+            const std::uint64_t key = edge_key(triangle.vertices[(i + 1) % 3], triangle.vertices[(i + 2) % 3]);
+            triangle.constrained[i] = constraints.count(key) != 0;
+
+            // Edges shared by more than two triangles of the degenerate polygon stay unlinked.
+            const auto it = open_edges.find(key);
+            if (it == open_edges.end()) {
+                open_edges.emplace(key, EdgeReference{t, i});
+            } else if (it->second.first != no_triangle) {
+                const auto [other, other_edge] = it->second;
+
+                triangle.neighbors[i]                    = other;
+                m_triangles[other].neighbors[other_edge] = t;
+                it->second.first                         = no_triangle;
+                m_edges_to_check.emplace_back(t, i);
+            }
+        }
+    }
+
+    legalize();
+}
+
+void DelaunayTriangulation::insert(std::uint32_t point)
+{
+    const Point& p        = m_points[point];
+    const std::uint32_t t = locate(p);
+    if (t == no_triangle) {
+        // Point is outside of the polygon or inside a hole.
+        return;
+    }
+
+    const Triangle& triangle = m_triangles[t];
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (m_points[triangle.vertices[i]] == p) {
+            return;
+        }
+    }
+
+    for (std::size_t i = 0; i < 3; ++i) {
+        const Point& a = m_points[triangle.vertices[(i + 1) % 3]];
+        const Point& b = m_points[triangle.vertices[(i + 2) % 3]];
+        if (orientation(a, b, p) == 0.0) {
+            split_edge(t, i, point);
+            legalize();
+            return;
+        }
+    }
+
+    split_triangle(t, point);
+    legalize();
+}
+
+std::vector<std::uint32_t> DelaunayTriangulation::indices() const
+{
+    std::vector<std::uint32_t> indices;
+    indices.reserve(m_triangles.size() * 3);
+
+    for (const auto& triangle : m_triangles) {
+        indices.insert(indices.end(), triangle.vertices.begin(), triangle.vertices.end());
+    }
+
+    return indices;
+}
+
+// Walks from the last triangle towards the point, the whole triangulation is scanned if the walk leaves the polygon.
+std::uint32_t DelaunayTriangulation::locate(const Point& point) const
+{
+    std::uint32_t t = m_last_triangle < m_triangles.size() ? m_last_triangle : 0;
+
+    for (std::size_t step = 0; step < m_triangles.size() && t != no_triangle; ++step) {
+        const Triangle& triangle = m_triangles[t];
+
+        std::uint32_t next = t;
+        for (std::size_t i = 0; i < 3 && next == t; ++i) {
+            const Point& a = m_points[triangle.vertices[(i + 1) % 3]];
+            const Point& b = m_points[triangle.vertices[(i + 2) % 3]];
+            if (orientation(a, b, point) < 0.0) {
+                next = triangle.neighbors[i];
+            }
+        }
+
+        if (next == t) {
+            if (contains(triangle, point)) {
+                return t;
+            }
+            break;
+        }
+
+        t = next;
+    }
+
+    for (std::uint32_t i = 0; i < m_triangles.size(); ++i) {
+        if (contains(m_triangles[i], point)) {
+            return i;
+        }
+    }
+
+    return no_triangle;
+}
+
+bool DelaunayTriangulation::contains(const Triangle& triangle, const Point& point) const
+{
+    const Point& a = m_points[triangle.vertices[0]];
+    const Point& b = m_points[triangle.vertices[1]];
+    const Point& c = m_points[triangle.vertices[2]];
+
+    return orientation(a, b, c) > 0.0 && orientation(b, c, point) >= 0.0 && orientation(c, a, point) >= 0.0 &&
+           orientation(a, b, point) >= 0.0;
+}
+
+// Splits the triangle abc in three triangles: pbc, pca, pab.
+void DelaunayTriangulation::split_triangle(std::uint32_t t, std::uint32_t p)
+{
+    const Triangle triangle = m_triangles[t];
+    const auto [a, b, c]    = triangle.vertices;
+
+    const auto tb = static_cast<std::uint32_t>(m_triangles.size());
+    const auto tc = tb + 1;
+
+    m_triangles[t] = {{p, b, c}, {triangle.neighbors[0], tb, tc}, {triangle.constrained[0], false, false}};
+    m_triangles.push_back({{p, c, a}, {triangle.neighbors[1], tc, t}, {triangle.constrained[1], false, false}});
+    m_triangles.push_back({{p, a, b}, {triangle.neighbors[2], t, tb}, {triangle.constrained[2], false, false}});
+
+    replace_neighbor(triangle.neighbors[1], t, tb);
+    replace_neighbor(triangle.neighbors[2], t, tc);
+
+    m_edges_to_check.emplace_back(t, 0);
+    m_edges_to_check.emplace_back(tb, 0);
+    m_edges_to_check.emplace_back(tc, 0);
+
+    m_last_triangle = t;
+}
+
+// Splits the edge bc of the triangle abc and the triangle dcb on the other side of it.
+// Triangles abp, apc, dcp and dpb are made.
+void DelaunayTriangulation::split_edge(std::uint32_t t, std::size_t edge, std::uint32_t p)
+{
+    const Triangle triangle = m_triangles[t];
+
+    const std::size_t ia = edge;
+    const std::size_t ib = (edge + 1) % 3;
+    const std::size_t ic = (edge + 2) % 3;
+
+    const std::uint32_t a = triangle.vertices[ia];
+    const std::uint32_t b = triangle.vertices[ib];
+    const std::uint32_t c = triangle.vertices[ic];
+
+    const bool constrained = triangle.constrained[ia];
+    const std::uint32_t u  = triangle.neighbors[ia];
+
+    const auto t2 = static_cast<std::uint32_t>(m_triangles.size());
+    const auto u2 = u != no_triangle ? t2 + 1 : no_triangle;
+
+    m_triangles[t] = {{a, b, p}, {u2, t2, triangle.neighbors[ic]}, {constrained, false, triangle.constrained[ic]}};
+    m_triangles.push_back({{a, p, c}, {u, triangle.neighbors[ib], t}, {constrained, triangle.constrained[ib], false}});
+
+    replace_neighbor(triangle.neighbors[ib], t, t2);
+
+    m_edges_to_check.emplace_back(t, 2);
+    m_edges_to_check.emplace_back(t2, 1);
+
+    if (u != no_triangle) {
+        const Triangle other = m_triangles[u];
+
+        const std::size_t id = edge_to(u, t);
+        const std::size_t jc = (id + 1) % 3;
+        const std::size_t jb = (id + 2) % 3;
+
+        const std::uint32_t d = other.vertices[id];
+
+        m_triangles[u] = {{d, c, p}, {t2, u2, other.neighbors[jb]}, {constrained, false, other.constrained[jb]}};
+        m_triangles.push_back({{d, p, b}, {t, other.neighbors[jc], u}, {constrained, other.constrained[jc], false}});
+
+        replace_neighbor(other.neighbors[jc], u, u2);
+
+        m_edges_to_check.emplace_back(u, 2);
+        m_edges_to_check.emplace_back(u2, 1);
+    }
+
+    m_last_triangle = t;
+}
+
+// Lawson flipping: edges are flipped until every edge is locally Delaunay or constrained.
+void DelaunayTriangulation::legalize()
+{
+    while (!m_edges_to_check.empty()) {
+        const auto [t, edge] = m_edges_to_check.back();
+        m_edges_to_check.pop_back();
+
+        flip(t, edge);
+    }
+}
+
+// Flips the edge bc shared by the triangles abc and dcb to the edge ad, if d is inside the circumcircle of abc.
+// Triangles abd and adc are made.
+void DelaunayTriangulation::flip(std::uint32_t t, std::size_t edge)
+{
+    const Triangle triangle = m_triangles[t];
+    const std::uint32_t u   = triangle.neighbors[edge];
+    if (u == no_triangle || triangle.constrained[edge]) {
+        return;
+    }
+
+    const Triangle other = m_triangles[u];
+
+    const std::size_t ia = edge;
+    const std::size_t ib = (edge + 1) % 3;
+    const std::size_t ic = (edge + 2) % 3;
+    const std::size_t id = edge_to(u, t);
+    const std::size_t jc = (id + 1) % 3;
+    const std::size_t jb = (id + 2) % 3;
+
+    const std::uint32_t a = triangle.vertices[ia];
+    const std::uint32_t b = triangle.vertices[ib];
+    const std::uint32_t c = triangle.vertices[ic];
+    const std::uint32_t d = other.vertices[id];
+
+    const Point& pa = m_points[a];
+    const Point& pb = m_points[b];
+    const Point& pc = m_points[c];
+    const Point& pd = m_points[d];
+
+    // The new edge must be inside of the quadrilateral abdc.
+    if (orientation(pa, pd, pb) >= 0.0 || orientation(pa, pd, pc) <= 0.0) {
+        return;
+    }
+
+    if (!is_in_circumcircle(pa, pb, pc, pd)) {
+        return;
+    }
+
+    m_triangles[t] = {{a, b, d},
+                      {other.neighbors[jc], u, triangle.neighbors[ic]},
+                      {other.constrained[jc], false, triangle.constrained[ic]}};
+    m_triangles[u] = {{a, d, c},
+                      {other.neighbors[jb], triangle.neighbors[ib], t},
+                      {other.constrained[jb], triangle.constrained[ib], false}};
+
+    replace_neighbor(other.neighbors[jc], u, t);
+    replace_neighbor(triangle.neighbors[ib], t, u);
+
+    m_edges_to_check.emplace_back(t, 0);
+    m_edges_to_check.emplace_back(t, 2);
+    m_edges_to_check.emplace_back(u, 0);
+    m_edges_to_check.emplace_back(u, 1);
+}
+
+std::size_t DelaunayTriangulation::edge_to(std::uint32_t t, std::uint32_t neighbor) const
+{
+    const auto& neighbors = m_triangles[t].neighbors;
+    if (neighbors[0] == neighbor) {
+        return 0;
+    }
+
+    return neighbors[1] == neighbor ? 1 : 2;
+}
+
+void DelaunayTriangulation::replace_neighbor(std::uint32_t t, std::uint32_t old_neighbor, std::uint32_t new_neighbor)
+{
+    if (t != no_triangle) {
+        m_triangles[t].neighbors[edge_to(t, old_neighbor)] = new_neighbor;
+    }
+}
+
+void add_constraints(const Polygon& polygon, std::uint32_t first_index, std::unordered_set<std::uint64_t>& constraints)
+{
+    const auto size = static_cast<std::uint32_t>(polygon.size());
+    for (std::uint32_t i = 0; i < size; ++i) {
+        constraints.insert(edge_key(first_index + i, first_index + (i + 1) % size));
+    }
+}
+
+} // namespace
+
+namespace framework::math
+{
+
+std::vector<std::uint32_t> generate_delaunay_triangulation(const Polygon& polygon)
+{
+    return generate_delaunay_triangulation(polygon, {}, {});
+}
+
+std::vector<std::uint32_t> generate_delaunay_triangulation(const Polygon& polygon, const std::vector<Polygon>& holes)
+{
+    return generate_delaunay_triangulation(polygon, holes, {});
+}
+
+std::vector<std::uint32_t> generate_delaunay_triangulation(const Polygon& polygon,
+                                                           const std::vector<Polygon>& holes,
+                                                           const std::vector<Vector<2, float>>& points)
+{
+    std::vector<Point> all_points = polygon;
+    std::unordered_set<std::uint64_t> constraints;
+
+    add_constraints(polygon, 0, constraints);
+    for (const auto& hole : holes) {
+        add_constraints(hole, static_cast<std::uint32_t>(all_points.size()), constraints);
+        all_points.insert(all_points.end(), hole.begin(), hole.end());
+    }
+
+    const auto first_steiner_point = static_cast<std::uint32_t>(all_points.size());
+    all_points.insert(all_points.end(), points.begin(), points.end());
+
+    DelaunayTriangulation triangulation(all_points);
+    triangulation.build(generate_ear_cut_triangulation(polygon, holes), constraints);
+
+    for (auto i = first_steiner_point; i < all_points.size(); ++i) {
+        triangulation.insert(i);
+    }
+
+    return triangulation.indices();
+}
+
+} // namespace framework::math
@@ -0,0 +1,375 @@
+#include <cassert>
+#include <cstddef>
+
+#include <math/inc/fast_functions.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+using framework::Span;
+
+namespace fast    = framework::math::fast;
+namespace details = framework::math::fast::fast_functions_details;
+
+#if defined(__SSE2__)
+
+// The SSE versions repeat the scalar functions operation by operation, so the results are the same.
+
+__m128 select(__m128 mask, __m128 a, __m128 b)
+{
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+__m128 from_int_bits(__m128i bits)
+{
+    return _mm_castsi128_ps(bits);
+}
+
+void sincos_ps(__m128 value, __m128& sin_result, __m128& cos_result)
+{
+    using namespace details;
+
+    const __m128 magic = _mm_set1_ps(round_magic);
+    const __m128 q     = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(value, _mm_set1_ps(two_over_pi)), magic), magic);
+    const __m128i quad = _mm_cvttps_epi32(q);
+
+    __m128 r = _mm_sub_ps(value, _mm_mul_ps(q, _mm_set1_ps(half_pi_hi)));
+    r        = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(half_pi_mid)));
+    r        = _mm_sub_ps(r, _mm_mul_ps(q, _mm_set1_ps(half_pi_lo)));
+
+    const __m128 r2 = _mm_mul_ps(r, r);
+
+    __m128 s = _mm_add_ps(_mm_set1_ps(sin_c5), _mm_mul_ps(r2, _mm_set1_ps(sin_c7)));
+    s        = _mm_add_ps(_mm_set1_ps(sin_c3), _mm_mul_ps(r2, s));
+    s        = _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, r2), s));
+
+    __m128 c = _mm_add_ps(_mm_set1_ps(cos_c6), _mm_mul_ps(r2, _mm_set1_ps(cos_c8)));
+    c        = _mm_add_ps(_mm_set1_ps(cos_c4), _mm_mul_ps(r2, c));
+    c        = _mm_mul_ps(_mm_mul_ps(r2, r2), c);
+    c        = _mm_add_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_set1_ps(0.5f), r2)), c);
+
+    const __m128i one  = _mm_set1_epi32(1);
+    const __m128i two  = _mm_set1_epi32(2);
+    const __m128 swap  = from_int_bits(_mm_cmpeq_epi32(_mm_and_si128(quad, one), one));
+    const __m128 s_sgn = from_int_bits(_mm_slli_epi32(_mm_and_si128(quad, two), 30));
+    const __m128 c_sgn = from_int_bits(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(quad, one), two), 30));
+
+    sin_result = _mm_xor_ps(select(swap, c, s), s_sgn);
+    cos_result = _mm_xor_ps(select(swap, s, c), c_sgn);
+}
+
+__m128 exp2_ps(__m128 value)
+{
+    using namespace details;
+
+    const __m128 magic = _mm_set1_ps(round_magic);
+    const __m128 x     = _mm_min_ps(_mm_max_ps(value, _mm_set1_ps(exp2_min)), _mm_set1_ps(exp2_max));
+    const __m128 q     = _mm_sub_ps(_mm_add_ps(x, magic), magic);
+    const __m128 f     = _mm_sub_ps(x, q);
+
+    __m128 p = _mm_add_ps(_mm_set1_ps(exp2_c5), _mm_mul_ps(f, _mm_set1_ps(exp2_c6)));
+    p        = _mm_add_ps(_mm_set1_ps(exp2_c4), _mm_mul_ps(f, p));
+    p        = _mm_add_ps(_mm_set1_ps(exp2_c3), _mm_mul_ps(f, p));
+    p        = _mm_add_ps(_mm_set1_ps(exp2_c2), _mm_mul_ps(f, p));
+    p        = _mm_add_ps(_mm_set1_ps(exp2_c1), _mm_mul_ps(f, p));
+    p        = _mm_add_ps(_mm_set1_ps(1.0f), _mm_mul_ps(f, p));
+
+    // n / 2 rounded toward zero, as the integer division does.
+    const __m128i n  = _mm_cvttps_epi32(q);
+    const __m128i n1 = _mm_srai_epi32(_mm_sub_epi32(n, _mm_srai_epi32(n, 31)), 1);
+    const __m128i n2 = _mm_sub_epi32(n, n1);
+
+    const __m128i bias  = _mm_set1_epi32(127);
+    const __m128 scale1 = from_int_bits(_mm_slli_epi32(_mm_add_epi32(n1, bias), 23));
+    const __m128 scale2 = from_int_bits(_mm_slli_epi32(_mm_add_epi32(n2, bias), 23));
+
+    return _mm_mul_ps(_mm_mul_ps(p, scale1), scale2);
+}
+
+__m128 log2_ps(__m128 value)
+{
+    using namespace details;
+
+    const __m128i bits    = _mm_castps_si128(value);
+    const __m128 mantissa = from_int_bits(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(mantissa_mask)),
+                                                       _mm_set1_epi32(one_bits)));
+
+    const __m128 above = _mm_cmpgt_ps(mantissa, _mm_set1_ps(sqrt_two));
+    const __m128 m     = select(above, _mm_mul_ps(mantissa, _mm_set1_ps(0.5f)), mantissa);
+
+    // The mask of the mantissa above sqrt(2) is -1, so subtracting it increments the exponent.
+    const __m128i exponent = _mm_sub_epi32(_mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127)),
+                                           _mm_castps_si128(above));
+    const __m128 e         = _mm_cvtepi32_ps(exponent);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+    const __m128 t   = _mm_div_ps(_mm_sub_ps(m, one), _mm_add_ps(m, one));
+    const __m128 t2  = _mm_mul_ps(t, t);
+
+    __m128 p = _mm_add_ps(_mm_set1_ps(log2_c7), _mm_mul_ps(t2, _mm_set1_ps(log2_c9)));
+    p        = _mm_add_ps(_mm_set1_ps(log2_c5), _mm_mul_ps(t2, p));
+    p        = _mm_add_ps(_mm_set1_ps(log2_c3), _mm_mul_ps(t2, p));
+    p        = _mm_add_ps(_mm_set1_ps(log2_c1), _mm_mul_ps(t2, p));
+
+    return _mm_add_ps(e, _mm_mul_ps(t, p));
+}
+
+__m128 rsqrt_ps(__m128 value)
+{
+    const __m128 r = _mm_rsqrt_ps(value);
+    const __m128 e = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(_mm_mul_ps(value, r), r));
+
+    return _mm_add_ps(r, _mm_mul_ps(_mm_mul_ps(r, _mm_set1_ps(0.5f)), e));
+}
+
+__m128 atan2_ps(__m128 y, __m128 x)
+{
+    using namespace details;
+
+    const __m128 sign = from_int_bits(_mm_set1_epi32(static_cast<int>(sign_mask)));
+    const __m128 ax   = _mm_andnot_ps(sign, x);
+    const __m128 ay   = _mm_andnot_ps(sign, y);
+    const __m128 mn   = _mm_min_ps(ax, ay);
+    const __m128 mx   = _mm_max_ps(ax, ay);
+
+    const __m128 one = _mm_set1_ps(1.0f);
+
+    const __m128 a      = _mm_and_ps(_mm_cmpgt_ps(mx, _mm_setzero_ps()), _mm_div_ps(mn, mx));
+    const __m128 reduce = _mm_cmpgt_ps(a, _mm_set1_ps(tan_pi_8));
+    const __m128 t      = select(reduce, _mm_div_ps(_mm_sub_ps(a, one), _mm_add_ps(a, one)), a);
+    const __m128 offset = _mm_and_ps(reduce, _mm_set1_ps(quarter_pi));
+    const __m128 t2     = _mm_mul_ps(t, t);
+
+    __m128 p = _mm_add_ps(_mm_set1_ps(atan_c7), _mm_mul_ps(t2, _mm_set1_ps(atan_c9)));
+    p        = _mm_add_ps(_mm_set1_ps(atan_c5), _mm_mul_ps(t2, p));
+    p        = _mm_add_ps(_mm_set1_ps(atan_c3), _mm_mul_ps(t2, p));
+
+    __m128 r = _mm_add_ps(offset, _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(t, t2), p)));
+    r        = select(_mm_cmpgt_ps(ay, ax), _mm_sub_ps(_mm_set1_ps(half_pi), r), r);
+
+    const __m128 x_negative = from_int_bits(_mm_srai_epi32(_mm_castps_si128(x), 31));
+    r                       = select(x_negative, _mm_sub_ps(_mm_set1_ps(pi), r), r);
+
+    return _mm_or_ps(r, _mm_and_ps(y, sign));
+}
+
+#endif
+
+// Functions are objects with the scalar and SSE versions of the call operator.
+struct SinFunction
+{
+    float operator()(float value) const
+    {
+        return fast::sin(value);
+    }
+
+#if defined(__SSE2__)
+    __m128 operator()(__m128 value) const
+    {
+        __m128 s;
+        __m128 c;
+        sincos_ps(value, s, c);
+        return s;
+    }
+#endif
+};
+
+struct CosFunction
+{
+    float operator()(float value) const
+    {
+        return fast::cos(value);
+    }
+
+#if defined(__SSE2__)
+    __m128 operator()(__m128 value) const
+    {
+        __m128 s;
+        __m128 c;
+        sincos_ps(value, s, c);
+        return c;
+    }
+#endif
+};
+
+struct Exp2Function
+{
+    float operator()(float value) const
+    {
+        return fast::exp2(value);
+    }
+
+#if defined(__SSE2__)
+    __m128 operator()(__m128 value) const
+    {
+        return exp2_ps(value);
+    }
+#endif
+};
+
+struct Log2Function
+{
+    float operator()(float value) const
+    {
+        return fast::log2(value);
+    }
+
+#if defined(__SSE2__)
+    __m128 operator()(__m128 value) const
+    {
+        return log2_ps(value);
+    }
+#endif
+};
+
+struct PowFunction
+{
+    float operator()(float base, float power) const
+    {
+        return fast::pow(base, power);
+    }
+
+#if defined(__SSE2__)
+    __m128 operator()(__m128 base, __m128 power) const
+    {
+        return exp2_ps(_mm_mul_ps(power, log2_ps(base)));
+    }
+#endif
+};
+
+struct RsqrtFunction
+{
+    float operator()(float value) const
+    {
+        return fast::rsqrt(value);
+    }
+
+#if defined(__SSE2__)
+    __m128 operator()(__m128 value) const
+    {
+        return rsqrt_ps(value);
+    }
+#endif
+};
+
+struct Atan2Function
+{
+    float operator()(float y, float x) const
+    {
+        return fast::atan2(y, x);
+    }
+
+#if defined(__SSE2__)
+    __m128 operator()(__m128 y, __m128 x) const
+    {
+        return atan2_ps(y, x);
+    }
+#endif
+};
+
+// Applies the function to the values, four at once if SSE is enabled.
+template <typename Function>
+void apply(Span<const float> values, Span<float> result)
+{
+    assert(values.size() == result.size());
+
+    const Function function{};
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= values.size(); i += 4) {
+        _mm_storeu_ps(result.data() + i, function(_mm_loadu_ps(values.data() + i)));
+    }
+#endif
+
+    for (; i < values.size(); ++i) {
+        result[i] = function(values[i]);
+    }
+}
+
+// Applies the function of two arguments to the pairs of values.
+template <typename Function>
+void apply(Span<const float> a, Span<const float> b, Span<float> result)
+{
+    assert(a.size() == result.size() && b.size() == result.size());
+
+    const Function function{};
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= a.size(); i += 4) {
+        _mm_storeu_ps(result.data() + i, function(_mm_loadu_ps(a.data() + i), _mm_loadu_ps(b.data() + i)));
+    }
+#endif
+
+    for (; i < a.size(); ++i) {
+        result[i] = function(a[i], b[i]);
+    }
+}
+
+} // namespace
+
+namespace framework::math::fast
+{
+
+void sincos(Span<const float> values, Span<float> sin_result, Span<float> cos_result)
+{
+    assert(values.size() == sin_result.size() && values.size() == cos_result.size());
+
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= values.size(); i += 4) {
+        __m128 s;
+        __m128 c;
+        sincos_ps(_mm_loadu_ps(values.data() + i), s, c);
+
+        _mm_storeu_ps(sin_result.data() + i, s);
+        _mm_storeu_ps(cos_result.data() + i, c);
+    }
+#endif
+
+    for (; i < values.size(); ++i) {
+        fast::sincos(values[i], sin_result[i], cos_result[i]);
+    }
+}
+
+void sin(Span<const float> values, Span<float> result)
+{
+    apply<SinFunction>(values, result);
+}
+
+void cos(Span<const float> values, Span<float> result)
+{
+    apply<CosFunction>(values, result);
+}
+
+void exp2(Span<const float> values, Span<float> result)
+{
+    apply<Exp2Function>(values, result);
+}
+
+void log2(Span<const float> values, Span<float> result)
+{
+    apply<Log2Function>(values, result);
+}
+
+void pow(Span<const float> bases, Span<const float> powers, Span<float> result)
+{
+    apply<PowFunction>(bases, powers, result);
+}
+
+void rsqrt(Span<const float> values, Span<float> result)
+{
+    apply<RsqrtFunction>(values, result);
+}
+
+void atan2(Span<const float> y, Span<const float> x, Span<float> result)
+{
+    apply<Atan2Function>(y, x, result);
+}
+
+} // namespace framework::math::fast
@@ -0,0 +1,213 @@
+#include <cstring>
+
+#include <math/inc/hash_functions.hpp>
+#include <math/inc/utility_hash_details.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+using namespace framework::math::unility_hash::details;
+
+constexpr std::size_t lanes_count       = 8;
+constexpr std::size_t stripe_size       = lanes_count * sizeof(std::uint64_t);
+constexpr std::size_t stripes_per_block = 16;
+
+constexpr std::uint64_t prime32 = 0x9e3779b1;
+constexpr std::uint64_t prime64 = 0x9e3779b97f4a7c15ull;
+
+// Random keys. Each stripe of a block takes the lane keys from the next 8 bytes of the secret, so equal stripes
+// give different results, and the last 64 bytes are the keys of the accumulators scramble.
+constexpr std::size_t secret_size = 192;
+
+alignas(16) constexpr std::uint64_t secret_words[secret_size / sizeof(std::uint64_t)] = {
+    0xdb0eda407f5e8e61ull, 0x5d357ffe4423f60dull, 0xe40c58c9a32d60b1ull, 0xb14a81b53e13272full,
+    0xc453b92e79219369ull, 0x547e1371f867f339ull, 0x89daa17b15cee28dull, 0x3971d00b513fbea1ull,
+    0x8e83a364ad2b6e45ull, 0xee272ba515d25ff7ull, 0x58e0aff5273fd14bull, 0x1937f9a9d34525bbull,
+    0x58f6f004facf1de9ull, 0x38ee2c0651c02d67ull, 0x1198da733060458dull, 0xdd4053c7f8ed9599ull,
+    0xfcf5f11454340c5full, 0xe4a78cf19a919f4full, 0x6dca3d159b84bd81ull, 0x16c5deada28e9f8bull,
+    0xed6042a1ea5723e9ull, 0x1062a1d3f663558full, 0x9a9a6d5bb17221a9ull, 0x5592002fd32ce3ddull};
+
+constexpr std::size_t scramble_offset = secret_size - stripe_size;
+constexpr std::size_t last_offset     = 7;
+constexpr std::size_t merge_offset    = 11;
+
+static_assert((stripes_per_block - 1) * sizeof(std::uint64_t) + stripe_size <= secret_size, "Secret is too small.");
+
+inline const std::uint8_t* secret_at(std::size_t offset) noexcept
+{
+    return reinterpret_cast<const std::uint8_t*>(secret_words) + offset;
+}
+
+inline std::uint64_t read64(const std::uint8_t* data) noexcept
+{
+    std::uint64_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+inline std::uint64_t read32(const std::uint8_t* data) noexcept
+{
+    std::uint32_t value = 0;
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+// Each lane adds the product of the halves of the keyed data, and the data itself to the neighbor lane,
+// so the data bits are not lost if the product is zero.
+#if defined(__SSE2__)
+
+void accumulate(std::uint64_t* accumulators, const std::uint8_t* stripe, const std::uint8_t* keys) noexcept
+{
+    for (std::size_t i = 0; i < lanes_count; i += 2) {
+        const std::size_t offset = i * sizeof(std::uint64_t);
+
+        const __m128i data  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(stripe + offset));
+        const __m128i key   = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + offset));
+        const __m128i keyed = _mm_xor_si128(data, key);
+
+        const __m128i product = _mm_mul_epu32(keyed, _mm_shuffle_epi32(keyed, _MM_SHUFFLE(0, 3, 0, 1)));
+        const __m128i swapped = _mm_shuffle_epi32(data, _MM_SHUFFLE(1, 0, 3, 2));
+
+        __m128i* lanes = reinterpret_cast<__m128i*>(accumulators + i);
+        _mm_store_si128(lanes, _mm_add_epi64(_mm_load_si128(lanes), _mm_add_epi64(product, swapped)));
+    }
+}
+
+void scramble(std::uint64_t* accumulators) noexcept
+{
+    const __m128i prime = _mm_set1_epi32(static_cast<int>(prime32));
+    const auto* keys    = reinterpret_cast<const __m128i*>(secret_at(scramble_offset));
+
+    for (std::size_t i = 0; i < lanes_count; i += 2) {
+        __m128i* lanes = reinterpret_cast<__m128i*>(accumulators + i);
+
+        __m128i value = _mm_load_si128(lanes);
+        value         = _mm_xor_si128(value, _mm_srli_epi64(value, 47));
+        value         = _mm_xor_si128(value, _mm_load_si128(keys + i / 2));
+
+        // 64 bit product by 32 bit prime from two 32 bit products.
+        const __m128i low  = _mm_mul_epu32(value, prime);
+        const __m128i high = _mm_mul_epu32(_mm_shuffle_epi32(value, _MM_SHUFFLE(0, 3, 0, 1)), prime);
+
+        _mm_store_si128(lanes, _mm_add_epi64(low, _mm_slli_epi64(high, 32)));
+    }
+}
+
+#else
+
+void accumulate(std::uint64_t* accumulators, const std::uint8_t* stripe, const std::uint8_t* keys) noexcept
+{
+    for (std::size_t i = 0; i < lanes_count; ++i) {
+        const std::uint64_t data  = read64(stripe + i * sizeof(std::uint64_t));
+        const std::uint64_t keyed = data ^ read64(keys + i * sizeof(std::uint64_t));
+
+        accumulators[i ^ 1] += data;
+        accumulators[i] += (keyed & 0xffffffff) * (keyed >> 32);
+    }
+}
+
+void scramble(std::uint64_t* accumulators) noexcept
+{
+    for (std::size_t i = 0; i < lanes_count; ++i) {
+        std::uint64_t value = accumulators[i];
+        value ^= value >> 47;
+        value ^= read64(secret_at(scramble_offset + i * sizeof(std::uint64_t)));
+        accumulators[i] = value * prime32;
+    }
+}
+
+#endif
+
+std::uint64_t avalanche(std::uint64_t value) noexcept
+{
+    value ^= value >> 37;
+    value *= 0x165667919e3779f9ull;
+    value ^= value >> 32;
+    return value;
+}
+
+// Up to 64 bytes are mixed by 16 byte chunks.
+std::uint64_t hash_short(const std::uint8_t* data, std::size_t size, std::uint64_t seed) noexcept
+{
+    seed ^= mix(seed ^ secret0, secret1);
+
+    std::uint64_t a = 0;
+    std::uint64_t b = 0;
+    if (size >= 16) {
+        std::size_t i = size;
+        for (; i > 16; i -= 16) {
+            seed = mix(read64(data + size - i) ^ secret1, read64(data + size - i + 8) ^ seed);
+        }
+
+        a = read64(data + size - 16);
+        b = read64(data + size - 8);
+    } else if (size >= 4) {
+        // Two overlapping pairs of 4 byte words cover all bytes.
+        const std::size_t offset = (size >> 3) << 2;
+
+        a = (read32(data) << 32) | read32(data + offset);
+        b = (read32(data + size - 4) << 32) | read32(data + size - 4 - offset);
+    } else if (size > 0) {
+        a = (std::uint64_t{data[0]} << 16) | (std::uint64_t{data[size >> 1]} << 8) | data[size - 1];
+    }
+
+    std::uint64_t low  = 0;
+    std::uint64_t high = 0;
+    multiply(a ^ secret1, b ^ seed, low, high);
+
+    return mix(low ^ secret0 ^ size, high ^ secret1);
+}
+
+std::uint64_t hash_long(const std::uint8_t* data, std::size_t size, std::uint64_t seed) noexcept
+{
+    alignas(16) std::uint64_t accumulators[lanes_count];
+    for (std::size_t i = 0; i < lanes_count; ++i) {
+        accumulators[i] = secret_words[i] + seed;
+    }
+
+    // The last stripe is always processed from the end of the data, so it can overlap the previous one.
+    const std::size_t stripes_count = (size - 1) / stripe_size;
+    for (std::size_t i = 0; i < stripes_count; ++i) {
+        const std::size_t stripe = i % stripes_per_block;
+        accumulate(accumulators, data + i * stripe_size, secret_at(stripe * sizeof(std::uint64_t)));
+
+        if (stripe == stripes_per_block - 1) {
+            scramble(accumulators);
+        }
+    }
+
+    accumulate(accumulators, data + size - stripe_size, secret_at(last_offset));
+
+    const std::uint8_t* keys = secret_at(merge_offset);
+
+    std::uint64_t result = size * prime64;
+    for (std::size_t i = 0; i < lanes_count; i += 2) {
+        const std::uint64_t a = accumulators[i] ^ read64(keys + i * sizeof(std::uint64_t));
+        const std::uint64_t b = accumulators[i + 1] ^ read64(keys + (i + 1) * sizeof(std::uint64_t));
+
+        result += mix(a, b);
+    }
+
+    return avalanche(result ^ seed);
+}
+
+} // namespace
+
+namespace framework::math
+{
+
+std::uint64_t hash_bytes(const void* data, std::size_t size, std::uint64_t seed) noexcept
+{
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+
+    if (size <= stripe_size) {
+        return hash_short(bytes, size, seed);
+    }
+
+    return hash_long(bytes, size, seed);
+}
+
+} // namespace framework::math
@@ -0,0 +1,343 @@
+#include <cassert>
+
+#include <math/inc/intersection_functions.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace
+{
+using framework::math::Aabb;
+using framework::math::Frustum;
+using framework::math::Plane;
+using framework::math::RayHit;
+using framework::math::RayPacket;
+using framework::math::Sphere;
+using framework::math::Vector;
+
+using Vector3f = Vector<3, float>;
+
+// Boxes, which corners are taken from the same arrays for all planes.
+struct AabbArrays
+{
+    const float* min_x;
+    const float* min_y;
+    const float* min_z;
+    const float* max_x;
+    const float* max_y;
+    const float* max_z;
+};
+
+Aabb<float> get_box(const AabbArrays& boxes, std::size_t i)
+{
+    return Aabb<float>(Vector3f(boxes.min_x[i], boxes.min_y[i], boxes.min_z[i]),
+                       Vector3f(boxes.max_x[i], boxes.max_y[i], boxes.max_z[i]));
+}
+
+#if defined(__SSE2__)
+
+void store_mask(int mask, std::uint8_t* result)
+{
+    for (std::size_t i = 0; i < 4; ++i) {
+        result[i] = static_cast<std::uint8_t>((mask >> i) & 1);
+    }
+}
+
+// Returns the outside mask of 4 boxes for the plane.
+__m128 box_outside_plane_ps(const Plane<float>& plane, const AabbArrays& boxes, std::size_t i)
+{
+    // The box corners farthest along the plane normal are the same for all boxes.
+    const __m128 x = _mm_loadu_ps((plane.normal.x >= 0.0f ? boxes.max_x : boxes.min_x) + i);
+    const __m128 y = _mm_loadu_ps((plane.normal.y >= 0.0f ? boxes.max_y : boxes.min_y) + i);
+    const __m128 z = _mm_loadu_ps((plane.normal.z >= 0.0f ? boxes.max_z : boxes.min_z) + i);
+
+    const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normal.x), x),
+                                             _mm_mul_ps(_mm_set1_ps(plane.normal.y), y)),
+                                  _mm_mul_ps(_mm_set1_ps(plane.normal.z), z));
+
+    return _mm_cmplt_ps(_mm_add_ps(dot, _mm_set1_ps(plane.distance)), _mm_setzero_ps());
+}
+
+// Intersects 4 rays starting from the offset in the packet with the triangle.
+template <std::size_t N>
+std::uint32_t intersect_ps(const RayPacket<N>& rays,
+                           std::size_t offset,
+                           const Vector3f& v1,
+                           const Vector3f& edge1,
+                           const Vector3f& edge2,
+                           float* distances)
+{
+    const __m128 dx = _mm_loadu_ps(rays.direction_x.data() + offset);
+    const __m128 dy = _mm_loadu_ps(rays.direction_y.data() + offset);
+    const __m128 dz = _mm_loadu_ps(rays.direction_z.data() + offset);
+
+    const __m128 e1x = _mm_set1_ps(edge1.x);
+    const __m128 e1y = _mm_set1_ps(edge1.y);
+    const __m128 e1z = _mm_set1_ps(edge1.z);
+    const __m128 e2x = _mm_set1_ps(edge2.x);
+    const __m128 e2y = _mm_set1_ps(edge2.y);
+    const __m128 e2z = _mm_set1_ps(edge2.z);
+
+    const auto dot = [](__m128 ax, __m128 ay, __m128 az, __m128 bx, __m128 by, __m128 bz) {
+        return _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, bx), _mm_mul_ps(ay, by)), _mm_mul_ps(az, bz));
+    };
+
+    // p = cross(direction, edge2)
+    const __m128 px = _mm_sub_ps(_mm_mul_ps(dy, e2z), _mm_mul_ps(dz, e2y));
+    const __m128 py = _mm_sub_ps(_mm_mul_ps(dz, e2x), _mm_mul_ps(dx, e2z));
+    const __m128 pz = _mm_sub_ps(_mm_mul_ps(dx, e2y), _mm_mul_ps(dy, e2x));
+
+    const __m128 determinant         = dot(e1x, e1y, e1z, px, py, pz);
+    const __m128 inverse_determinant = _mm_div_ps(_mm_set1_ps(1.0f), determinant);
+
+    // s = origin - v1
+    const __m128 sx = _mm_sub_ps(_mm_loadu_ps(rays.origin_x.data() + offset), _mm_set1_ps(v1.x));
+    const __m128 sy = _mm_sub_ps(_mm_loadu_ps(rays.origin_y.data() + offset), _mm_set1_ps(v1.y));
+    const __m128 sz = _mm_sub_ps(_mm_loadu_ps(rays.origin_z.data() + offset), _mm_set1_ps(v1.z));
+
+    // q = cross(s, edge1)
+    const __m128 qx = _mm_sub_ps(_mm_mul_ps(sy, e1z), _mm_mul_ps(sz, e1y));
+    const __m128 qy = _mm_sub_ps(_mm_mul_ps(sz, e1x), _mm_mul_ps(sx, e1z));
+    const __m128 qz = _mm_sub_ps(_mm_mul_ps(sx, e1y), _mm_mul_ps(sy, e1x));
+
+    const __m128 u = _mm_mul_ps(dot(sx, sy, sz, px, py, pz), inverse_determinant);
+    const __m128 v = _mm_mul_ps(dot(dx, dy, dz, qx, qy, qz), inverse_determinant);
+    const __m128 t = _mm_mul_ps(dot(e2x, e2y, e2z, qx, qy, qz), inverse_determinant);
+
+    const __m128 zero     = _mm_setzero_ps();
+    const __m128 one      = _mm_set1_ps(1.0f);
+    const __m128 distance = _mm_loadu_ps(distances + offset);
+
+    // Comparisons with NaN are false, so rays in the triangle plane are missed.
+    __m128 hit = _mm_cmpneq_ps(determinant, zero);
+    hit        = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(u, zero), _mm_cmple_ps(u, one)));
+    hit        = _mm_and_ps(hit, _mm_and_ps(_mm_cmpge_ps(v, zero), _mm_cmple_ps(_mm_add_ps(u, v), one)));
+    hit        = _mm_and_ps(hit, _mm_and_ps(_mm_cmpgt_ps(t, zero), _mm_cmplt_ps(t, distance)));
+
+    _mm_storeu_ps(distances + offset, _mm_or_ps(_mm_and_ps(hit, t), _mm_andnot_ps(hit, distance)));
+
+    return static_cast<std::uint32_t>(_mm_movemask_ps(hit)) << offset;
+}
+
+#endif
+
+template <std::size_t N>
+std::uint32_t intersect_packet(const RayPacket<N>& rays,
+                               const Vector3f& v1,
+                               const Vector3f& v2,
+                               const Vector3f& v3,
+                               std::array<float, N>& distances)
+{
+    std::uint32_t mask = 0;
+
+#if defined(__SSE2__)
+    const Vector3f edge1 = v2 - v1;
+    const Vector3f edge2 = v3 - v1;
+
+    for (std::size_t offset = 0; offset < N; offset += 4) {
+        mask |= intersect_ps(rays, offset, v1, edge1, edge2, distances.data());
+    }
+#else
+    for (std::size_t i = 0; i < N; ++i) {
+        const framework::math::Ray<float> ray(Vector3f(rays.origin_x[i], rays.origin_y[i], rays.origin_z[i]),
+                                              Vector3f(rays.direction_x[i], rays.direction_y[i], rays.direction_z[i]));
+
+        RayHit<float> hit;
+        if (intersect(ray, v1, v2, v3, hit) && hit.distance < distances[i]) {
+            distances[i] = hit.distance;
+            mask |= std::uint32_t{1} << i;
+        }
+    }
+#endif
+
+    return mask;
+}
+
+} // namespace
+
+namespace framework::math
+{
+
+void is_visible(const Frustum<float>& frustum, AabbSpan<const float> boxes, Span<std::uint8_t> result)
+{
+    assert(boxes.max_points.size() == boxes.size());
+    assert(result.size() == boxes.size());
+
+    const AabbArrays arrays{boxes.min_points.x.data(),
+                            boxes.min_points.y.data(),
+                            boxes.min_points.z.data(),
+                            boxes.max_points.x.data(),
+                            boxes.max_points.y.data(),
+                            boxes.max_points.z.data()};
+
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= boxes.size(); i += 4) {
+        __m128 outside = _mm_setzero_ps();
+        for (const Plane<float>& plane : frustum.planes) {
+            outside = _mm_or_ps(outside, box_outside_plane_ps(plane, arrays, i));
+        }
+
+        store_mask(~_mm_movemask_ps(outside), result.data() + i);
+    }
+#endif
+
+    for (; i < boxes.size(); ++i) {
+        result[i] = is_visible(frustum, get_box(arrays, i)) ? 1 : 0;
+    }
+}
+
+void is_visible(const Frustum<float>& frustum,
+                Vector3Span<const float> centers,
+                Span<const float> radii,
+                Span<std::uint8_t> result)
+{
+    assert(radii.size() == centers.size());
+    assert(result.size() == centers.size());
+
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    for (; i + 4 <= centers.size(); i += 4) {
+        const __m128 x      = _mm_loadu_ps(centers.x.data() + i);
+        const __m128 y      = _mm_loadu_ps(centers.y.data() + i);
+        const __m128 z      = _mm_loadu_ps(centers.z.data() + i);
+        const __m128 radius = _mm_loadu_ps(radii.data() + i);
+
+        const __m128 negative_radius = _mm_sub_ps(_mm_setzero_ps(), radius);
+
+        __m128 outside = _mm_setzero_ps();
+        for (const Plane<float>& plane : frustum.planes) {
+            const __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.normal.x), x),
+                                                     _mm_mul_ps(_mm_set1_ps(plane.normal.y), y)),
+                                          _mm_mul_ps(_mm_set1_ps(plane.normal.z), z));
+
+            const __m128 distance = _mm_add_ps(dot, _mm_set1_ps(plane.distance));
+            outside               = _mm_or_ps(outside, _mm_cmplt_ps(distance, negative_radius));
+        }
+
+        store_mask(~_mm_movemask_ps(outside), result.data() + i);
+    }
+#endif
+
+    for (; i < centers.size(); ++i) {
+        const Sphere<float> sphere(Vector3f(centers.x[i], centers.y[i], centers.z[i]), radii[i]);
+        result[i] = is_visible(frustum, sphere) ? 1 : 0;
+    }
+}
+
+void overlaps(const Aabb<float>& box, AabbSpan<const float> boxes, Span<std::uint8_t> result)
+{
+    assert(boxes.max_points.size() == boxes.size());
+    assert(result.size() == boxes.size());
+
+    const AabbArrays arrays{boxes.min_points.x.data(),
+                            boxes.min_points.y.data(),
+                            boxes.min_points.z.data(),
+                            boxes.max_points.x.data(),
+                            boxes.max_points.y.data(),
+                            boxes.max_points.z.data()};
+
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128 box_min_x = _mm_set1_ps(box.min_point.x);
+    const __m128 box_min_y = _mm_set1_ps(box.min_point.y);
+    const __m128 box_min_z = _mm_set1_ps(box.min_point.z);
+    const __m128 box_max_x = _mm_set1_ps(box.max_point.x);
+    const __m128 box_max_y = _mm_set1_ps(box.max_point.y);
+    const __m128 box_max_z = _mm_set1_ps(box.max_point.z);
+
+    for (; i + 4 <= boxes.size(); i += 4) {
+        __m128 overlap = _mm_and_ps(_mm_cmple_ps(box_min_x, _mm_loadu_ps(arrays.max_x + i)),
+                                    _mm_cmple_ps(_mm_loadu_ps(arrays.min_x + i), box_max_x));
+        overlap        = _mm_and_ps(overlap, _mm_cmple_ps(box_min_y, _mm_loadu_ps(arrays.max_y + i)));
+        overlap        = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(arrays.min_y + i), box_max_y));
+        overlap        = _mm_and_ps(overlap, _mm_cmple_ps(box_min_z, _mm_loadu_ps(arrays.max_z + i)));
+        overlap        = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(arrays.min_z + i), box_max_z));
+
+        store_mask(_mm_movemask_ps(overlap), result.data() + i);
+    }
+#endif
+
+    for (; i < boxes.size(); ++i) {
+        result[i] = overlaps(box, get_box(arrays, i)) ? 1 : 0;
+    }
+}
+
+Aabb<float> merge(AabbSpan<const float> boxes)
+{
+    assert(boxes.max_points.size() == boxes.size());
+
+    const AabbArrays arrays{boxes.min_points.x.data(),
+                            boxes.min_points.y.data(),
+                            boxes.min_points.z.data(),
+                            boxes.max_points.x.data(),
+                            boxes.max_points.y.data(),
+                            boxes.max_points.z.data()};
+
+    Aabb<float> result;
+    std::size_t i = 0;
+
+#if defined(__SSE2__)
+    if (boxes.size() >= 4) {
+        __m128 min_x = _mm_loadu_ps(arrays.min_x);
+        __m128 min_y = _mm_loadu_ps(arrays.min_y);
+        __m128 min_z = _mm_loadu_ps(arrays.min_z);
+        __m128 max_x = _mm_loadu_ps(arrays.max_x);
+        __m128 max_y = _mm_loadu_ps(arrays.max_y);
+        __m128 max_z = _mm_loadu_ps(arrays.max_z);
+
+        for (i = 4; i + 4 <= boxes.size(); i += 4) {
+            min_x = _mm_min_ps(min_x, _mm_loadu_ps(arrays.min_x + i));
+            min_y = _mm_min_ps(min_y, _mm_loadu_ps(arrays.min_y + i));
+            min_z = _mm_min_ps(min_z, _mm_loadu_ps(arrays.min_z + i));
+            max_x = _mm_max_ps(max_x, _mm_loadu_ps(arrays.max_x + i));
+            max_y = _mm_max_ps(max_y, _mm_loadu_ps(arrays.max_y + i));
+            max_z = _mm_max_ps(max_z, _mm_loadu_ps(arrays.max_z + i));
+        }
+
+        alignas(16) float lanes[6][4];
+        _mm_store_ps(lanes[0], min_x);
+        _mm_store_ps(lanes[1], min_y);
+        _mm_store_ps(lanes[2], min_z);
+        _mm_store_ps(lanes[3], max_x);
+        _mm_store_ps(lanes[4], max_y);
+        _mm_store_ps(lanes[5], max_z);
+
+        for (std::size_t lane = 0; lane < 4; ++lane) {
+            result = merge(result,
+                           Aabb<float>(Vector3f(lanes[0][lane], lanes[1][lane], lanes[2][lane]),
+                                       Vector3f(lanes[3][lane], lanes[4][lane], lanes[5][lane])));
+        }
+    }
+#endif
+
+    for (; i < boxes.size(); ++i) {
+        result = merge(result, get_box(arrays, i));
+    }
+
+    return result;
+}
+
+std::uint32_t intersect(const RayPacket<4>& rays,
+                        const Vector<3, float>& v1,
+                        const Vector<3, float>& v2,
+                        const Vector<3, float>& v3,
+                        std::array<float, 4>& distances)
+{
+    return intersect_packet(rays, v1, v2, v3, distances);
+}
+
+std::uint32_t intersect(const RayPacket<8>& rays,
+                        const Vector<3, float>& v1,
+                        const Vector<3, float>& v2,
+                        const Vector<3, float>& v3,
+                        std::array<float, 8>& distances)
+{
+    return intersect_packet(rays, v1, v2, v3, distances);
+}
+
+} // namespace framework::math
@@ -1,6 +1,24 @@
+// The ear cut triangulation is a port of the earcut library (https://github.com/mapbox/earcut):
+//
+// ISC License
+//
+// Copyright (c) 2016, Mapbox
+//
+// Permission to use, copy, modify, and/or distribute this software for any purpose
+// with or without fee is hereby granted, provided that the above copyright notice
+// and this permission notice appear in all copies.
+//
+// THE SOFTWARE IS PROVIDED "AS IS" AND ISC DISCLAIMS ALL WARRANTIES WITH REGARD TO
+// THIS SOFTWARE INCLUDING ALL IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS.
+// IN NO EVENT SHALL ISC BE LIABLE FOR ANY SPECIAL, DIRECT, INDIRECT, OR
+// CONSEQUENTIAL DAMAGES OR ANY DAMAGES WHATSOEVER RESULTING FROM LOSS OF USE, DATA
+// OR PROFITS, WHETHER IN AN ACTION OF CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION,
+// ARISING OUT OF OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+
 #include <algorithm>
-#include <numeric>
-#include <stdexcept>
+#include <cmath>
+#include <deque>
+#include <limits>
 
 #include <math/inc/geometric_functions.hpp>
 #include <math/inc/polygon_functions.hpp>
@@ -9,85 +27,718 @@ namespace
 {
 using namespace framework::math;
 
-struct PointInfo
+#pragma region Ear cut
+
+// Port of the earcut library, see the license notice at the top of the file.
+
+// Polygons with more points use the z-order curve to find points inside the ears.
+constexpr std::size_t z_order_hashing_threshold = 80;
+
+// Polygon point in the doubly linked list of the remaining polygon points.
+struct Node
 {
-    std::uint32_t prev_index = 0;
-    std::uint32_t curr_index = 0;
-    std::uint32_t next_index = 0;
-    float dot                = 0;
-    bool is_ear              = false;
+    Node(std::uint32_t point_index, const Vector<2, float>& point)
+        : index(point_index)
+        , x(point.x)
+        , y(point.y)
+    {}
+
+    std::uint32_t index = 0;
+    float x             = 0.0f;
+    float y             = 0.0f;
+
+    Node* prev = nullptr;
+    Node* next = nullptr;
+
+    // Neighbors in the list sorted by the z-order curve.
+    std::uint32_t z = 0;
+    Node* prev_z    = nullptr;
+    Node* next_z    = nullptr;
+
+    // Single point holes are never removed as collinear points.
+    bool steiner = false;
 };
 
-void update_info(std::vector<PointInfo>& indices,
-                 std::size_t index_in_indices,
-                 const Polygon& polygon,
-                 const bool is_ccw)
+// Twice the signed area of a triangle, it's negative for the counterclockwise points.
+float signed_area(const Node* p, const Node* q, const Node* r)
+{
+    return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+}
+
+bool equals(const Node* a, const Node* b)
+{
+    return a->x == b->x && a->y == b->y;
+}
+
+int sign(float value)
+{
+    return (value > 0.0f) - (value < 0.0f);
+}
+
+bool is_inside_triangle(float ax, float ay, float bx, float by, float cx, float cy, float px, float py)
+{
+    return (cx - px) * (ay - py) >= (ax - px) * (cy - py) && (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+           (bx - px) * (cy - py) >= (cx - px) * (by - py);
+}
+
+// Check if point q lies on segment pr, assuming they are collinear.
+bool on_segment(const Node* p, const Node* q, const Node* r)
+{
+    return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x) && q->y <= std::max(p->y, r->y) &&
+           q->y >= std::min(p->y, r->y);
+}
+
+bool intersects(const Node* p1, const Node* q1, const Node* p2, const Node* q2)
+{
+    const int o1 = sign(signed_area(p1, q1, p2));
+    const int o2 = sign(signed_area(p1, q1, q2));
+    const int o3 = sign(signed_area(p2, q2, p1));
+    const int o4 = sign(signed_area(p2, q2, q1));
+
+    if (o1 != o2 && o3 != o4) {
+        return true;
+    }
+
+    return (o1 == 0 && on_segment(p1, p2, q1)) || (o2 == 0 && on_segment(p1, q2, q1)) ||
+           (o3 == 0 && on_segment(p2, p1, q2)) || (o4 == 0 && on_segment(p2, q1, q2));
+}
+
+// Check if the diagonal ab intersects any polygon edge.
+bool intersects_polygon(const Node* a, const Node* b)
+{
+    const Node* p = a;
+    do {
+        if (p->index != a->index && p->next->index != a->index && p->index != b->index &&
+            p->next->index != b->index && intersects(p, p->next, a, b)) {
+            return true;
+        }
+        p = p->next;
+    } while (p != a);
+
+    return false;
+}
+
+// Check if the diagonal ab starts inside the polygon near the point a.
+bool is_locally_inside(const Node* a, const Node* b)
+{
+    if (signed_area(a->prev, a, a->next) < 0.0f) {
+        return signed_area(a, b, a->next) >= 0.0f && signed_area(a, a->prev, b) >= 0.0f;
+    }
+
+    return signed_area(a, b, a->prev) < 0.0f || signed_area(a, a->next, b) < 0.0f;
+}
+
+// Check if the middle of the diagonal ab is inside the polygon.
+bool is_middle_inside(const Node* a, const Node* b)
+{
+    const float px = (a->x + b->x) / 2.0f;
+    const float py = (a->y + b->y) / 2.0f;
+
+    bool inside   = false;
+    const Node* p = a;
+    do {
+        if (((p->y > py) != (p->next->y > py)) && p->next->y != p->y &&
+            (px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)) {
+            inside = !inside;
+        }
+        p = p->next;
+    } while (p != a);
+
+    return inside;
+}
+
+// Check if the sector of the point m contains the sector of the point p, both points have the same position.
+bool sector_contains_sector(const Node* m, const Node* p)
+{
+    return signed_area(m->prev, m, p->prev) < 0.0f && signed_area(p->next, m, m->next) < 0.0f;
+}
+
+bool is_valid_diagonal(const Node* a, const Node* b)
+{
+    if (a->next->index == b->index || a->prev->index == b->index || intersects_polygon(a, b)) {
+        return false;
+    }
+
+    const bool visible = is_locally_inside(a, b) && is_locally_inside(b, a) && is_middle_inside(a, b) &&
+                         (signed_area(a->prev, a, b->prev) != 0.0f || signed_area(a, b->prev, b) != 0.0f);
+
+    // Zero length diagonal between two convex points is valid too.
+    const bool zero_length = equals(a, b) && signed_area(a->prev, a, a->next) > 0.0f &&
+                             signed_area(b->prev, b, b->next) > 0.0f;
+
+    return visible || zero_length;
+}
+
+void remove_node(Node* p)
+{
+    p->next->prev = p->prev;
+    p->prev->next = p->next;
+
+    if (p->prev_z != nullptr) {
+        p->prev_z->next_z = p->next_z;
+    }
+
+    if (p->next_z != nullptr) {
+        p->next_z->prev_z = p->prev_z;
+    }
+}
+
+// Remove duplicated and collinear points.
+Node* filter_points(Node* start, Node* end = nullptr)
 {
-    const auto prev_index_in_indices = (index_in_indices + indices.size() - 1) % indices.size();
-    const auto next_index_in_indices = (index_in_indices + 1) % indices.size();
+    if (start == nullptr) {
+        return start;
+    }
 
-    const std::uint32_t prev_point_index = indices[prev_index_in_indices].curr_index;
-    const std::uint32_t curr_point_index = indices[index_in_indices].curr_index;
-    const std::uint32_t next_point_index = indices[next_index_in_indices].curr_index;
+    if (end == nullptr) {
+        end = start;
+    }
 
-    const auto& prev = polygon[prev_point_index];
-    const auto& curr = polygon[curr_point_index];
-    const auto& next = polygon[next_point_index];
+    Node* p    = start;
+    bool again = false;
+    do {
+        again = false;
 
-    // update point neighbors indices
-    indices[index_in_indices].next_index = next_point_index;
-    indices[index_in_indices].prev_index = prev_point_index;
+        if (!p->steiner && (equals(p, p->next) || signed_area(p->prev, p, p->next) == 0.0f)) {
+            remove_node(p);
+            p = end = p->prev;
+            if (p == p->next) {
+                break;
+            }
+            again = true;
+        } else {
+            p = p->next;
+        }
+    } while (again || p != end);
 
-    // update dot
-    indices[index_in_indices].dot = dot(normalize(prev - curr), normalize(next - curr));
+    return end;
+}
 
-    // update is ear
-    const auto c           = cross(prev - curr, next - curr);
-    const bool valid_angle = !((!is_ccw && c <= 0.0f) || (is_ccw && c >= 0.0f));
+Node* get_leftmost(Node* start)
+{
+    Node* p        = start;
+    Node* leftmost = start;
+    do {
+        if (p->x < leftmost->x || (p->x == leftmost->x && p->y < leftmost->y)) {
+            leftmost = p;
+        }
+        p = p->next;
+    } while (p != start);
+
+    return leftmost;
+}
 
-    if (valid_angle) {
-        indices[index_in_indices].is_ear = [&]() {
-            for (const auto& pi : indices) {
-                const auto& p = polygon[pi.curr_index];
-                if (p == prev || p == curr || p == next) {
-                    continue;
+// Interleaves bits of the coordinates scaled to 15 bits.
+std::uint32_t z_order(float x, float y, float min_x, float min_y, float inv_size)
+{
+    const auto spread = [](std::uint32_t value) {
+        value = (value | (value << 8)) & 0x00FF00FFu;
+        value = (value | (value << 4)) & 0x0F0F0F0Fu;
+        value = (value | (value << 2)) & 0x33333333u;
+        value = (value | (value << 1)) & 0x55555555u;
+        return value;
+    };
+
+    const auto ix = static_cast<std::uint32_t>((x - min_x) * inv_size);
+    const auto iy = static_cast<std::uint32_t>((y - min_y) * inv_size);
+
+    return spread(ix) | (spread(iy) << 1);
+}
+
+// Merge sort of the z-order list, doesn't need extra memory.
+Node* sort_by_z_order(Node* list)
+{
+    std::size_t in_size = 1;
+    std::size_t merges  = 0;
+
+    do {
+        Node* p    = list;
+        Node* tail = nullptr;
+        list       = nullptr;
+        merges     = 0;
+
+        while (p != nullptr) {
+            ++merges;
+
+            Node* q            = p;
+            std::size_t p_size = 0;
+            for (std::size_t i = 0; i < in_size && q != nullptr; ++i) {
+                ++p_size;
+                q = q->next_z;
+            }
+
+            std::size_t q_size = in_size;
+            while (p_size > 0 || (q_size > 0 && q != nullptr)) {
+                Node* e = nullptr;
+                if (p_size != 0 && (q_size == 0 || q == nullptr || p->z <= q->z)) {
+                    e = p;
+                    p = p->next_z;
+                    --p_size;
+                } else {
+                    e = q;
+                    q = q->next_z;
+                    --q_size;
                 }
 
-                if (is_point_in_triangle(p, prev, next, curr)) {
-                    return false;
+                if (tail != nullptr) {
+                    tail->next_z = e;
+                } else {
+                    list = e;
                 }
+
+                e->prev_z = tail;
+                tail      = e;
             }
-            return true;
-        }();
-    } else {
-        indices[index_in_indices].is_ear = false;
+
+            p = q;
+        }
+
+        tail->next_z = nullptr;
+        in_size *= 2;
+    } while (merges > 1);
+
+    return list;
+}
+
+// Triangulates polygon cutting off the ears. Points are kept in the linked list, so the ear removal is O(1).
+// Only reflex points can be inside an ear, so other points are skipped in the containment test.
+// For big polygons points are also linked in the z-order curve order, so only points near the ear are tested.
+class EarCut
+{
+public:
+    EarCut(const Polygon& polygon, const std::vector<Polygon>& holes);
+
+    std::vector<std::uint32_t> triangulate();
+
+private:
+    Node* create_list(const Polygon& polygon, std::uint32_t first_index, bool counterclockwise);
+    Node* insert_node(std::uint32_t index, const Vector<2, float>& point, Node* last);
+    Node* split_polygon(Node* a, Node* b);
+
+    Node* eliminate_holes(Node* outer);
+    Node* eliminate_hole(Node* hole, Node* outer);
+    Node* find_hole_bridge(const Node* hole, Node* outer);
+
+    void index_curve(Node* start);
+    bool is_ear(const Node* ear) const;
+    bool is_ear_hashed(const Node* ear) const;
+
+    void triangulate_linked(Node* ear, int pass);
+    Node* cure_local_intersections(Node* start);
+    void split_triangulation(Node* start);
+
+    void add_triangle(const Node* a, const Node* b, const Node* c);
+
+    const Polygon& m_polygon;
+    const std::vector<Polygon>& m_holes;
+
+    // Deque keeps the node addresses on growth.
+    std::deque<Node> m_nodes;
+    std::vector<Node*> m_hole_nodes;
+    std::vector<std::uint32_t> m_triangles;
+
+    float m_min_x    = 0.0f;
+    float m_min_y    = 0.0f;
+    float m_inv_size = 0.0f;
+};
+
+EarCut::EarCut(const Polygon& polygon, const std::vector<Polygon>& holes)
+    : m_polygon(polygon)
+    , m_holes(holes)
+{}
+
+std::vector<std::uint32_t> EarCut::triangulate()
+{
+    Node* outer = create_list(m_polygon, 0, true);
+    if (outer == nullptr || outer->next == outer->prev) {
+        return {};
     }
+
+    std::size_t points_count = m_polygon.size();
+
+    auto first_index = static_cast<std::uint32_t>(m_polygon.size());
+    for (const auto& hole : m_holes) {
+        if (Node* list = create_list(hole, first_index, false); list != nullptr) {
+            if (list == list->next) {
+                list->steiner = true;
+            }
+            m_hole_nodes.push_back(get_leftmost(list));
+        }
+
+        first_index += static_cast<std::uint32_t>(hole.size());
+        points_count += hole.size();
+    }
+
+    outer = eliminate_holes(outer);
+
+    if (points_count > z_order_hashing_threshold) {
+        float max_x = outer->x;
+        float max_y = outer->y;
+        m_min_x     = outer->x;
+        m_min_y     = outer->y;
+
+        const Node* p = outer;
+        do {
+            m_min_x = std::min(m_min_x, p->x);
+            m_min_y = std::min(m_min_y, p->y);
+            max_x   = std::max(max_x, p->x);
+            max_y   = std::max(max_y, p->y);
+            p       = p->next;
+        } while (p != outer);
+
+        // Coordinates are scaled to 15 bits.
+        const float size = std::max(max_x - m_min_x, max_y - m_min_y);
+        m_inv_size       = size != 0.0f ? 32767.0f / size : 0.0f;
+    }
+
+    m_triangles.reserve((points_count + m_holes.size() * 2) * 3);
+    triangulate_linked(outer, 0);
+
+    return std::move(m_triangles);
 }
 
-std::size_t next_ear_index(const std::vector<PointInfo>& indices)
+Node* EarCut::create_list(const Polygon& polygon, std::uint32_t first_index, bool counterclockwise)
 {
-    std::vector<std::size_t> ears;
-    ears.reserve(indices.size());
+    Node* last = nullptr;
 
-    // find all ears
-    for (std::size_t i = 0; i < indices.size(); ++i) {
-        if (indices[i].is_ear) {
-            ears.push_back(i);
+    const auto size = static_cast<std::uint32_t>(polygon.size());
+    if (counterclockwise == (polygon_area(polygon) < 0.0f)) {
+        for (std::uint32_t i = 0; i < size; ++i) {
+            last = insert_node(first_index + i, polygon[i], last);
+        }
+    } else {
+        for (std::uint32_t i = size; i > 0; --i) {
+            last = insert_node(first_index + i - 1, polygon[i - 1], last);
         }
     }
 
-    if (ears.empty()) {
-        throw std::runtime_error("Ears are empty. It's bug in triangulation algorithm.");
+    if (last != nullptr && equals(last, last->next)) {
+        remove_node(last);
+        last = last->next;
     }
 
-    // get best ear
-    const auto it = std::max_element(ears.begin(), ears.end(), [&indices](std::size_t a, std::size_t b) {
-        return indices[a].dot < indices[b].dot;
+    return last;
+}
+
+Node* EarCut::insert_node(std::uint32_t index, const Vector<2, float>& point, Node* last)
+{
+    Node* p = &m_nodes.emplace_back(index, point);
+
+    if (last == nullptr) {
+        p->prev = p;
+        p->next = p;
+    } else {
+        p->next          = last->next;
+        p->prev          = last;
+        last->next->prev = p;
+        last->next       = p;
+    }
+
+    return p;
+}
+
+// Links a and b with the diagonal. If they are in one polygon, it's split in two.
+// If they are in different polygons, they are merged in one.
+Node* EarCut::split_polygon(Node* a, Node* b)
+{
+    Node* a2 = &m_nodes.emplace_back(*a);
+    Node* b2 = &m_nodes.emplace_back(*b);
+    Node* an = a->next;
+    Node* bp = b->prev;
+
+    a2->prev_z = a2->next_z = nullptr;
+    b2->prev_z = b2->next_z = nullptr;
+
+    a->next = b;
+    b->prev = a;
+
+    a2->next = an;
+    an->prev = a2;
+
+    b2->next = a2;
+    a2->prev = b2;
+
+    bp->next = b2;
+    b2->prev = bp;
+
+    return b2;
+}
+
+// Holes are joined with the outer polygon from left to right by the bridge edges.
+Node* EarCut::eliminate_holes(Node* outer)
+{
+    std::sort(m_hole_nodes.begin(), m_hole_nodes.end(), [](const Node* a, const Node* b) {
+        return a->x < b->x || (a->x == b->x && a->y < b->y);
     });
 
-    return *it;
+    for (Node* hole : m_hole_nodes) {
+        outer = eliminate_hole(hole, outer);
+    }
+
+    return outer;
+}
+
+Node* EarCut::eliminate_hole(Node* hole, Node* outer)
+{
+    Node* bridge = find_hole_bridge(hole, outer);
+    if (bridge == nullptr) {
+        return outer;
+    }
+
+    Node* bridge_reverse = split_polygon(bridge, hole);
+
+    // Filter collinear points around the cuts.
+    Node* filtered_bridge = filter_points(bridge, bridge->next);
+    filter_points(bridge_reverse, bridge_reverse->next);
+
+    return outer == bridge ? filtered_bridge : outer;
+}
+
+// Finds the outer polygon point visible from the leftmost hole point.
+Node* EarCut::find_hole_bridge(const Node* hole, Node* outer)
+{
+    const float hx = hole->x;
+    const float hy = hole->y;
+    float qx       = std::numeric_limits<float>::lowest();
+    Node* m        = nullptr;
+
+    // Find the segment intersected by the ray from the hole to the left,
+    // its endpoint with the lesser x is the potential connection point.
+    Node* p = outer;
+    do {
+        if (hy <= p->y && hy >= p->next->y && p->next->y != p->y) {
+            const float x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+            if (x <= hx && x > qx) {
+                qx = x;
+                m  = p->x < p->next->x ? p : p->next;
+                if (x == hx) {
+                    // The hole touches the outer segment.
+                    return m;
+                }
+            }
+        }
+        p = p->next;
+    } while (p != outer);
+
+    if (m == nullptr) {
+        return nullptr;
+    }
+
+    // Points inside the triangle of the hole point, the intersection and the endpoint block the connection.
+    // The point with the minimum angle with the ray is chosen then.
+    const Node* stop = m;
+    const float mx   = m->x;
+    const float my   = m->y;
+    float tan_min    = std::numeric_limits<float>::infinity();
+
+    p = m;
+    do {
+        if (hx >= p->x && p->x >= mx && hx != p->x &&
+            is_inside_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y)) {
+            const float tan = std::abs(hy - p->y) / (hx - p->x);
+
+            if (is_locally_inside(p, hole) &&
+                (tan < tan_min ||
+                 (tan == tan_min && (p->x > m->x || (p->x == m->x && sector_contains_sector(m, p)))))) {
+                m       = p;
+                tan_min = tan;
+            }
+        }
+        p = p->next;
+    } while (p != stop);
+
+    return m;
+}
+
+void EarCut::index_curve(Node* start)
+{
+    Node* p = start;
+    do {
+        p->z      = z_order(p->x, p->y, m_min_x, m_min_y, m_inv_size);
+        p->prev_z = p->prev;
+        p->next_z = p->next;
+        p         = p->next;
+    } while (p != start);
+
+    p->prev_z->next_z = nullptr;
+    p->prev_z         = nullptr;
+
+    sort_by_z_order(p);
 }
 
+bool EarCut::is_ear(const Node* ear) const
+{
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+
+    // Reflex point can't be an ear.
+    if (signed_area(a, b, c) >= 0.0f) {
+        return false;
+    }
+
+    const float x0 = std::min({a->x, b->x, c->x});
+    const float y0 = std::min({a->y, b->y, c->y});
+    const float x1 = std::max({a->x, b->x, c->x});
+    const float y1 = std::max({a->y, b->y, c->y});
+
+    for (const Node* p = c->next; p != a; p = p->next) {
+        if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+            is_inside_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+            signed_area(p->prev, p, p->next) >= 0.0f) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool EarCut::is_ear_hashed(const Node* ear) const
+{
+    const Node* a = ear->prev;
+    const Node* b = ear;
+    const Node* c = ear->next;
+
+    if (signed_area(a, b, c) >= 0.0f) {
+        return false;
+    }
+
+    const float x0 = std::min({a->x, b->x, c->x});
+    const float y0 = std::min({a->y, b->y, c->y});
+    const float x1 = std::max({a->x, b->x, c->x});
+    const float y1 = std::max({a->y, b->y, c->y});
+
+    // Points inside the triangle bounding box have the z-order values in this range.
+    const std::uint32_t min_z = z_order(x0, y0, m_min_x, m_min_y, m_inv_size);
+    const std::uint32_t max_z = z_order(x1, y1, m_min_x, m_min_y, m_inv_size);
+
+    const auto blocks_ear = [&](const Node* p) {
+        return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+               is_inside_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+               signed_area(p->prev, p, p->next) >= 0.0f;
+    };
+
+    // Look for points in both directions along the curve.
+    const Node* p = ear->prev_z;
+    const Node* n = ear->next_z;
+    while (p != nullptr && p->z >= min_z && n != nullptr && n->z <= max_z) {
+        if (blocks_ear(p) || blocks_ear(n)) {
+            return false;
+        }
+        p = p->prev_z;
+        n = n->next_z;
+    }
+
+    for (; p != nullptr && p->z >= min_z; p = p->prev_z) {
+        if (blocks_ear(p)) {
+            return false;
+        }
+    }
+
+    for (; n != nullptr && n->z <= max_z; n = n->next_z) {
+        if (blocks_ear(n)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// When no ears are left, the duplicated points are removed on the pass 1, the small self intersections are cured on
+// the pass 2 and the polygon is split in two by a valid diagonal after that.
+void EarCut::triangulate_linked(Node* ear, int pass)
+{
+    if (ear == nullptr) {
+        return;
+    }
+
+    const bool hashed = m_inv_size != 0.0f;
+    if (pass == 0 && hashed) {
+        index_curve(ear);
+    }
+
+    Node* stop = ear;
+    while (ear->prev != ear->next) {
+        Node* prev = ear->prev;
+        Node* next = ear->next;
+
+        if (hashed ? is_ear_hashed(ear) : is_ear(ear)) {
+            add_triangle(prev, ear, next);
+            remove_node(ear);
+
+            // Skipping the next point leads to less sliver triangles.
+            ear  = next->next;
+            stop = next->next;
+            continue;
+        }
+
+        ear = next;
+
+        if (ear == stop) {
+            if (pass == 0) {
+                triangulate_linked(filter_points(ear), 1);
+            } else if (pass == 1) {
+                triangulate_linked(cure_local_intersections(filter_points(ear)), 2);
+            } else if (pass == 2) {
+                split_triangulation(ear);
+            }
+
+            break;
+        }
+    }
+}
+
+// Cuts off the triangles at the small self intersections, where ab and cd intersect in the a-b-c-d sequence.
+Node* EarCut::cure_local_intersections(Node* start)
+{
+    Node* p = start;
+    do {
+        Node* a = p->prev;
+        Node* b = p->next->next;
+
+        if (!equals(a, b) && intersects(a, p, p->next, b) && is_locally_inside(a, b) && is_locally_inside(b, a)) {
+            add_triangle(a, p, b);
+
+            remove_node(p);
+            remove_node(p->next);
+
+            p = start = b;
+        }
+        p = p->next;
+    } while (p != start);
+
+    return filter_points(p);
+}
+
+void EarCut::split_triangulation(Node* start)
+{
+    Node* a = start;
+    do {
+        for (Node* b = a->next->next; b != a->prev; b = b->next) {
+            if (a->index != b->index && is_valid_diagonal(a, b)) {
+                Node* c = split_polygon(a, b);
+
+                a = filter_points(a, a->next);
+                c = filter_points(c, c->next);
+
+                triangulate_linked(a, 0);
+                triangulate_linked(c, 0);
+                return;
+            }
+        }
+        a = a->next;
+    } while (a != start);
+}
+
+void EarCut::add_triangle(const Node* a, const Node* b, const Node* c)
+{
+    m_triangles.push_back(a->index);
+    m_triangles.push_back(b->index);
+    m_triangles.push_back(c->index);
+}
+
+#pragma endregion
+
 } // namespace
 
 namespace framework::math
@@ -150,58 +801,12 @@ bool is_point_in_polygon(const Vector<2, float>& point, const Polygon& polygon)
 
 std::vector<std::uint32_t> generate_ear_cut_triangulation(const Polygon& polygon)
 {
-    const bool is_ccw = polygon_area(polygon) < 0;
-
-    // fill initial indices
-    std::vector<PointInfo> indices(polygon.size());
-    for (std::uint32_t i = 0; i < indices.size(); ++i) {
-        indices[i].curr_index = i;
-    }
-
-    // precalculate point infos
-    for (size_t i = 0; i < indices.size(); ++i) {
-        update_info(indices, i, polygon, is_ccw);
-    }
-
-    // triangles for triangulation result
-    std::vector<std::uint32_t> triangles;
-    triangles.reserve((polygon.size() - 2) * 3);
-
-    while (indices.size() > 3) {
-        const auto ear_index   = next_ear_index(indices);
-        const auto& point_info = indices[ear_index];
-
-        // Add triangle
-        triangles.push_back(point_info.curr_index);
-        if (is_ccw) {
-            triangles.push_back(point_info.next_index);
-            triangles.push_back(point_info.prev_index);
-        } else {
-            triangles.push_back(point_info.prev_index);
-            triangles.push_back(point_info.next_index);
-        }
-
-        indices.erase(std::next(indices.begin(), ear_index));
-
-        const auto prev_index_in_indices = (ear_index + indices.size() - 1) % indices.size();
-        const auto next_index_in_indices = ear_index % indices.size();
-
-        // update neighbors point infos
-        update_info(indices, prev_index_in_indices, polygon, is_ccw);
-        update_info(indices, next_index_in_indices, polygon, is_ccw);
-    }
-
-    // Add last triangle
-    triangles.push_back(indices[0].curr_index);
-    if (is_ccw) {
-        triangles.push_back(indices[1].curr_index);
-        triangles.push_back(indices[2].curr_index);
-    } else {
-        triangles.push_back(indices[2].curr_index);
-        triangles.push_back(indices[1].curr_index);
-    }
+    return generate_ear_cut_triangulation(polygon, {});
+}
 
-    return triangles;
+std::vector<std::uint32_t> generate_ear_cut_triangulation(const Polygon& polygon, const std::vector<Polygon>& holes)
+{
+    return EarCut(polygon, holes).triangulate();
 }
 
 } // namespace framework::math
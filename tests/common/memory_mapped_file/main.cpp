@@ -0,0 +1,104 @@
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <common/memory_mapped_file.hpp>
+#include <unit_test/suite.hpp>
+
+namespace
+{
+const std::string test_file_name  = "memory_mapped_file_test.bin";
+const std::string empty_file_name = "memory_mapped_file_empty.bin";
+
+void write_file(const std::string& name, const std::vector<std::uint8_t>& data)
+{
+    std::ofstream file(name, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+} // namespace
+
+class MemoryMappedFileTest : public framework::unit_test::Suite
+{
+public:
+    MemoryMappedFileTest()
+        : Suite("MemoryMappedFileTest")
+    {
+        add_test([this]() { map_file(); }, "map_file");
+        add_test([this]() { map_empty_file(); }, "map_empty_file");
+        add_test([this]() { map_missing_file(); }, "map_missing_file");
+        add_test([this]() { move_file(); }, "move_file");
+    }
+
+private:
+    void map_file()
+    {
+        using framework::MemoryMappedFile;
+
+        std::vector<std::uint8_t> data(10000);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<std::uint8_t>(i * 7);
+        }
+
+        write_file(test_file_name, data);
+
+        MemoryMappedFile file(test_file_name);
+
+        TEST_ASSERT(file.is_open(), "File is not mapped.");
+        TEST_ASSERT(file.size() == data.size(), "Wrong file size.");
+        TEST_ASSERT(std::equal(data.begin(), data.end(), file.bytes().begin(), file.bytes().end()),
+                    "Wrong file contents.");
+
+        file.close();
+
+        TEST_ASSERT(!file.is_open(), "File is not closed.");
+        TEST_ASSERT(file.data() == nullptr && file.size() == 0, "Closed file has data.");
+    }
+
+    void map_empty_file()
+    {
+        using framework::MemoryMappedFile;
+
+        write_file(empty_file_name, {});
+
+        const MemoryMappedFile file(empty_file_name);
+
+        TEST_ASSERT(file.is_open(), "Empty file is not mapped.");
+        TEST_ASSERT(file.size() == 0 && file.bytes().empty(), "Empty file has data.");
+    }
+
+    void map_missing_file()
+    {
+        using framework::MemoryMappedFile;
+
+        MemoryMappedFile file;
+
+        TEST_ASSERT(!file.open("missing_file.bin"), "Missing file is mapped.");
+        TEST_ASSERT(!file.is_open() && file.bytes().empty(), "Missing file has data.");
+    }
+
+    void move_file()
+    {
+        using framework::MemoryMappedFile;
+
+        const std::vector<std::uint8_t> data = {1, 2, 3, 4, 5};
+        write_file(test_file_name, data);
+
+        MemoryMappedFile file(test_file_name);
+        MemoryMappedFile other(std::move(file));
+
+        TEST_ASSERT(!file.is_open() && file.bytes().empty(), "Moved file is still open.");
+        TEST_ASSERT(other.is_open() && other.size() == data.size(), "File is not moved.");
+
+        file = std::move(other);
+
+        TEST_ASSERT(file.is_open() && file.bytes()[4] == 5, "File is not moved back.");
+        TEST_ASSERT(!other.is_open(), "Moved file is still open.");
+    }
+};
+
+int main()
+{
+    return run_tests(MemoryMappedFileTest());
+}
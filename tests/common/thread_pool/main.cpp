@@ -0,0 +1,104 @@
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <common/thread_pool.hpp>
+#include <unit_test/suite.hpp>
+
+class ThreadPoolTest : public framework::unit_test::Suite
+{
+public:
+    ThreadPoolTest()
+        : Suite("ThreadPoolTest")
+    {
+        add_test([this]() { run_tasks(); }, "run_tasks");
+        add_test([this]() { submit_functions(); }, "submit_functions");
+        add_test([this]() { nested_tasks(); }, "nested_tasks");
+        add_test([this]() { destroy_with_tasks(); }, "destroy_with_tasks");
+    }
+
+private:
+    void run_tasks()
+    {
+        framework::ThreadPool pool(4);
+
+        TEST_ASSERT(pool.threads_count() == 4, "Wrong threads count.");
+
+        std::atomic<int> counter = 0;
+        for (int i = 0; i < 1000; ++i) {
+            pool.add_task([&counter]() { counter++; });
+        }
+
+        pool.add_task([]() { throw std::runtime_error("Task error"); });
+
+        pool.wait();
+
+        TEST_ASSERT(counter == 1000, "Not all tasks are executed.");
+    }
+
+    void submit_functions()
+    {
+        framework::ThreadPool pool(3);
+
+        std::vector<std::future<int>> results;
+        for (int i = 0; i < 100; ++i) {
+            results.push_back(pool.submit([i]() { return i * i; }));
+        }
+
+        bool valid = true;
+        for (int i = 0; i < 100; ++i) {
+            valid = valid && results[static_cast<std::size_t>(i)].get() == i * i;
+        }
+
+        TEST_ASSERT(valid, "Wrong function results.");
+
+        auto error = pool.submit([]() -> int { throw std::runtime_error("Function error"); });
+
+        bool thrown = false;
+        try {
+            error.get();
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+
+        TEST_ASSERT(thrown, "Exception is not passed through the future.");
+    }
+
+    void nested_tasks()
+    {
+        framework::ThreadPool pool(2);
+
+        std::atomic<int> counter = 0;
+        for (int i = 0; i < 10; ++i) {
+            pool.add_task([&pool, &counter]() {
+                for (int j = 0; j < 10; ++j) {
+                    pool.add_task([&counter]() { counter++; });
+                }
+            });
+        }
+
+        pool.wait();
+
+        TEST_ASSERT(counter == 100, "Not all nested tasks are executed.");
+    }
+
+    void destroy_with_tasks()
+    {
+        std::atomic<int> counter = 0;
+
+        {
+            framework::ThreadPool pool(2);
+            for (int i = 0; i < 100; ++i) {
+                pool.add_task([&counter]() { counter++; });
+            }
+        }
+
+        TEST_ASSERT(counter == 100, "Tasks are lost on destruction.");
+    }
+};
+
+int main()
+{
+    return run_tests(ThreadPoolTest());
+}
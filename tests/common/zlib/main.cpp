@@ -315,6 +315,8 @@ public:
         add_test([this]() { inflate_test(); }, "inflate_test");
         add_test([this]() { inflate_huge_test(); }, "inflate_huge_test");
         add_test([this]() { deflate_test(); }, "daflate_test");
+        add_test([this]() { deflate_levels_test(); }, "deflate_levels_test");
+        add_test([this]() { deflate_multithreaded_test(); }, "deflate_multithreaded_test");
     }
 
 private:
@@ -350,6 +352,56 @@ private:
         TEST_ASSERT(decompressed == data, "Deflate error.");
     }
 
+    void deflate_levels_test()
+    {
+        using namespace framework::zlib;
+
+        const std::vector<std::uint8_t> text(huge_text.begin(), huge_text.end());
+
+        for (const auto level : {CompressionLevel::no_compression,
+                                 CompressionLevel::fastest,
+                                 CompressionLevel::default_compression,
+                                 CompressionLevel::best_compression}) {
+            const std::vector<std::uint8_t> compressed = deflate(text, level);
+
+            TEST_ASSERT(inflate(compressed) == text, "Deflate error.");
+            TEST_ASSERT(inflate(deflate(data, level)) == data, "Deflate error.");
+
+            if (level != CompressionLevel::no_compression) {
+                TEST_ASSERT(compressed.size() < text.size() / 2, "Data is not compressed.");
+            }
+        }
+    }
+
+    void deflate_multithreaded_test()
+    {
+        using namespace framework::zlib;
+
+        std::vector<std::uint8_t> big_data;
+        std::uint32_t seed = 1;
+        while (big_data.size() < 1024 * 1024) {
+            seed = seed * 1103515245 + 12345;
+            if ((seed >> 16) % 4 == 0) {
+                big_data.push_back(static_cast<std::uint8_t>(seed >> 24));
+            } else {
+                big_data.insert(big_data.end(), huge_text.begin(), huge_text.begin() + (seed >> 16) % 300);
+            }
+        }
+
+        const std::vector<std::uint8_t> single = deflate(big_data, CompressionLevel::fastest, 1);
+        const std::vector<std::uint8_t> multi  = deflate(big_data, CompressionLevel::fastest, 4);
+        const std::vector<std::uint8_t> stored = deflate(big_data, CompressionLevel::no_compression, 0);
+
+        TEST_ASSERT(inflate(single) == big_data, "Deflate error.");
+        TEST_ASSERT(inflate(multi) == big_data, "Multithreaded deflate error.");
+        TEST_ASSERT(inflate(stored) == big_data, "Multithreaded deflate error.");
+        TEST_ASSERT(multi.size() < single.size() + single.size() / 100, "Multithreaded deflate is much worse.");
+
+        // The calling thread compresses one segment too, so three pool threads give the same segments.
+        framework::ThreadPool pool(3);
+        TEST_ASSERT(deflate(big_data, CompressionLevel::fastest, pool) == multi, "Deflate with the pool error.");
+    }
+
     std::vector<std::uint8_t> data;
 
     std::vector<std::uint8_t> fixed_huffman = {
@@ -0,0 +1,180 @@
+#include <cstdint>
+#include <vector>
+
+#include <graphics/src/font/tables/character_to_glyph_index_mapping.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::graphics::details::font::CharacterToGlyphIndexMapping;
+using framework::graphics::details::font::CodePoint;
+using framework::graphics::details::font::missig_glyph_id;
+
+namespace
+{
+
+// Builds the cmap table with the Unicode subtables.
+class CmapTable
+{
+public:
+    // Maps one code point to the glyph.
+    void add_format4_subtable(std::uint16_t codepoint, std::uint16_t glyph_id)
+    {
+        m_subtables.push_back({3, {}});
+        auto& data = m_subtables.back().data;
+
+        write16(data, 4);  // format
+        write16(data, 32); // length
+        write16(data, 0);  // language
+        write16(data, 4);  // segments count x2
+        write16(data, 4);  // search range
+        write16(data, 1);  // entry selector
+        write16(data, 0);  // range shift
+
+        // End codes, reserved pad, start codes, id deltas and id range offsets of the code point segment
+        // and of the last 0xFFFF segment.
+        write16(data, codepoint);
+        write16(data, 0xFFFF);
+        write16(data, 0);
+        write16(data, codepoint);
+        write16(data, 0xFFFF);
+        write16(data, static_cast<std::uint16_t>(glyph_id - codepoint));
+        write16(data, 1);
+        write16(data, 0);
+        write16(data, 0);
+    }
+
+    struct Group
+    {
+        std::uint32_t first    = 0;
+        std::uint32_t last     = 0;
+        std::uint32_t glyph_id = 0;
+    };
+
+    void add_format12_subtable(const std::vector<Group>& groups)
+    {
+        m_subtables.push_back({4, {}});
+        auto& data = m_subtables.back().data;
+
+        write16(data, 12); // format
+        write16(data, 0);  // reserved
+        write32(data, static_cast<std::uint32_t>(16 + groups.size() * 12));
+        write32(data, 0); // language
+        write32(data, static_cast<std::uint32_t>(groups.size()));
+
+        for (const auto& group : groups) {
+            write32(data, group.first);
+            write32(data, group.last);
+            write32(data, group.glyph_id);
+        }
+    }
+
+    std::vector<std::uint8_t> data() const
+    {
+        std::vector<std::uint8_t> data;
+        write16(data, 0); // version
+        write16(data, static_cast<std::uint16_t>(m_subtables.size()));
+
+        std::uint32_t offset = static_cast<std::uint32_t>(4 + m_subtables.size() * 8);
+        for (const auto& subtable : m_subtables) {
+            write16(data, 0); // Unicode platform
+            write16(data, subtable.encoding_id);
+            write32(data, offset);
+            offset += static_cast<std::uint32_t>(subtable.data.size());
+        }
+
+        for (const auto& subtable : m_subtables) {
+            data.insert(data.end(), subtable.data.begin(), subtable.data.end());
+        }
+
+        return data;
+    }
+
+private:
+    struct Subtable
+    {
+        std::uint16_t encoding_id = 0;
+        std::vector<std::uint8_t> data;
+    };
+
+    static void write16(std::vector<std::uint8_t>& data, std::uint16_t value)
+    {
+        data.push_back(static_cast<std::uint8_t>(value >> 8));
+        data.push_back(static_cast<std::uint8_t>(value & 0xff));
+    }
+
+    static void write32(std::vector<std::uint8_t>& data, std::uint32_t value)
+    {
+        write16(data, static_cast<std::uint16_t>(value >> 16));
+        write16(data, static_cast<std::uint16_t>(value & 0xffff));
+    }
+
+    std::vector<Subtable> m_subtables;
+};
+
+} // namespace
+
+class CharacterMappingTest : public framework::unit_test::Suite
+{
+public:
+    CharacterMappingTest()
+        : Suite("CharacterMappingTest")
+    {
+        add_test([this]() { format4(); }, "format4");
+        add_test([this]() { format12(); }, "format12");
+    }
+
+private:
+    void format4()
+    {
+        CmapTable table;
+        table.add_format4_subtable(0x41, 7);
+
+        const std::vector<std::uint8_t> data = table.data();
+        const CharacterToGlyphIndexMapping mapping(data);
+
+        TEST_ASSERT(mapping.is_valid(), "Mapping should be valid.");
+        TEST_ASSERT(mapping.glyph_index(0x41) == 7, "Wrong glyph of mapped code point.");
+        TEST_ASSERT(mapping.glyph_index(0x42) == missig_glyph_id, "Code point should not be mapped.");
+        TEST_ASSERT(mapping.glyph_index(0x1F600) == missig_glyph_id, "Code point should not be mapped.");
+    }
+
+    void format12()
+    {
+        CmapTable table;
+        table.add_format4_subtable(0x41, 7);
+        table.add_format12_subtable({
+            {0x41, 0x43, 10},
+            {0xFFF0, 0xFFF1, 0xFFFF},
+            {0x1F600, 0x1F602, 20},
+            {0x10FFFF, 0x10FFFF, 30},
+        });
+
+        const std::vector<std::uint8_t> data = table.data();
+        const CharacterToGlyphIndexMapping mapping(data);
+
+        TEST_ASSERT(mapping.is_valid(), "Mapping should be valid.");
+        TEST_ASSERT(mapping.glyph_index(0x41) == 10 && mapping.glyph_index(0x43) == 12,
+                    "Format 12 subtable should be used.");
+        TEST_ASSERT(mapping.glyph_index(0x44) == missig_glyph_id, "Code point should not be mapped.");
+
+        TEST_ASSERT(mapping.glyph_index(0xFFF0) == 0xFFFF, "Wrong glyph of mapped code point.");
+        TEST_ASSERT(mapping.glyph_index(0xFFF1) == missig_glyph_id, "Glyph id out of range should not be mapped.");
+
+        TEST_ASSERT(mapping.glyph_index(0x1F600) == 20 && mapping.glyph_index(0x1F602) == 22,
+                    "Supplementary plane code points should be mapped.");
+        TEST_ASSERT(mapping.glyph_index(0x1F603) == missig_glyph_id, "Code point should not be mapped.");
+        TEST_ASSERT(mapping.glyph_index(0x10FFFF) == 30, "Last code point should be mapped.");
+        TEST_ASSERT(mapping.glyph_index(0x110000) == missig_glyph_id, "Code point out of range should not be mapped.");
+
+        const std::vector<CodePoint> codepoints = {0x42, 0x1F601, 0x110000};
+        std::vector<framework::graphics::details::font::GlyphId> glyph_ids(codepoints.size());
+        mapping.glyph_indices(codepoints, glyph_ids);
+
+        TEST_ASSERT(glyph_ids[0] == 11 && glyph_ids[1] == 21 && glyph_ids[2] == missig_glyph_id,
+                    "Wrong glyphs of code points.");
+    }
+};
+
+int main()
+{
+    return run_tests(CharacterMappingTest());
+}
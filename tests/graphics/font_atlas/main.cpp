@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <graphics/font.hpp>
+#include <unit_test/suite.hpp>
+
+using namespace framework;
+using namespace framework::graphics;
+
+namespace
+{
+const std::string text = "Sphinx of black quartz, judge my vow!";
+
+Font load_font(const std::string& file, const Font::AtlasOptions& options = Font::AtlasOptions())
+{
+    Font font;
+    font.set_atlas_options(options);
+    font.load(file);
+
+    return font;
+}
+
+Font::AtlasOptions make_options(Font::DistanceField distance_field, std::size_t width = 512)
+{
+    Font::AtlasOptions options;
+    options.distance_field = distance_field;
+    options.width          = width;
+
+    return options;
+}
+
+// Distance encoded in the atlas pixel, the median of channels for multi-channel atlas.
+std::uint8_t distance(const Image& atlas, std::size_t x, std::size_t y)
+{
+    const std::size_t pixel_size = bytes_per_pixel(atlas.format());
+    const std::uint8_t* pixel    = atlas.bytes().data() + (y * atlas.width() + x) * pixel_size;
+
+    if (pixel_size == 1) {
+        return pixel[0];
+    }
+
+    return std::max(std::min(pixel[0], pixel[1]), std::min(std::max(pixel[0], pixel[1]), pixel[2]));
+}
+
+// Atlas pixel at the point of the first glyph quad, the point is set in fractions of the quad size.
+std::uint8_t glyph_distance(const Font& font, const Mesh& mesh, float u, float v)
+{
+    const auto& coordinates = mesh.texture_coordinates(0);
+
+    const float x = coordinates[0].x + (coordinates[2].x - coordinates[0].x) * u;
+    const float y = coordinates[0].y + (coordinates[2].y - coordinates[0].y) * v;
+
+    return distance(font.atlas(),
+                    static_cast<std::size_t>(x * static_cast<float>(font.atlas().width())),
+                    static_cast<std::size_t>(y * static_cast<float>(font.atlas().height())));
+}
+
+} // namespace
+
+class FontAtlasTest : public unit_test::Suite
+{
+public:
+    FontAtlasTest()
+        : Suite("FontAtlasTest")
+    {
+        add_test([this]() { atlas_text_mesh(); }, "atlas_text_mesh");
+        add_test([this]() { distance_field(); }, "distance_field");
+        add_test([this]() { atlas_growth(); }, "atlas_growth");
+        add_test([this]() { atlas_options(); }, "atlas_options");
+    }
+
+private:
+    void atlas_text_mesh()
+    {
+        Font font = load_font("data/UbuntuMono-Regular.ttf");
+
+        const Mesh mesh = font.create_atlas_text_mesh(text);
+
+        const std::size_t glyphs_count = static_cast<std::size_t>(std::count_if(text.begin(), text.end(), [](char c) {
+            return c != ' ';
+        }));
+
+        TEST_ASSERT(mesh.vertices().size() == glyphs_count * 4, "Each glyph should be a quad.");
+        TEST_ASSERT(mesh.texture_coordinates(0).size() == mesh.vertices().size(), "Wrong texture coordinates count.");
+        TEST_ASSERT(mesh.submeshes().size() == 1 && mesh.submeshes().begin()->second.indices.size() == glyphs_count * 6,
+                    "Each glyph should have two triangles.");
+
+        const auto& coordinates = mesh.texture_coordinates(0);
+        TEST_ASSERT(std::all_of(coordinates.begin(),
+                                coordinates.end(),
+                                [](const auto& c) { return c.x >= 0.0f && c.x <= 1.0f && c.y >= 0.0f && c.y <= 1.0f; }),
+                    "Texture coordinates are out of the atlas.");
+
+        // Glyphs of the monospaced font are placed at the same step, spaces included.
+        const Mesh letters = font.create_atlas_text_mesh("ll l");
+        const float step   = letters.vertices()[4].x - letters.vertices()[0].x;
+        TEST_ASSERT(step > 0.0f && std::abs(letters.vertices()[8].x - letters.vertices()[4].x - 2 * step) < 1e-5f,
+                    "Wrong glyph positions.");
+
+        TEST_ASSERT(font.atlas().format() == PixelFormat::rgb8 && font.atlas().gamma() == 1.0f,
+                    "Wrong atlas format.");
+        TEST_ASSERT(font.atlas().width() == font.atlas_options().width, "Wrong atlas width.");
+
+        const Mesh spaces = font.create_atlas_text_mesh("   ");
+        TEST_ASSERT(spaces.vertices().empty() && spaces.submeshes().empty(), "Spaces should not have geometry.");
+    }
+
+    void distance_field()
+    {
+        for (auto distance_field : {Font::DistanceField::single_channel, Font::DistanceField::multi_channel}) {
+            Font font = load_font("data/Amethysta-Regular.ttf", make_options(distance_field));
+
+            // The glyph quad has the margin of encoded distances, so its corners are outside.
+            const Mesh stem = font.create_atlas_text_mesh("l");
+            TEST_ASSERT(glyph_distance(font, stem, 0.5f, 0.5f) > 128, "Center of 'l' should be inside.");
+            TEST_ASSERT(glyph_distance(font, stem, 0.01f, 0.01f) < 128, "Corner of 'l' should be outside.");
+
+            const Mesh ring = font.create_atlas_text_mesh("o");
+            TEST_ASSERT(glyph_distance(font, ring, 0.5f, 0.5f) < 128, "Center of 'o' should be outside.");
+        }
+    }
+
+    void atlas_growth()
+    {
+        Font font = load_font("data/Amethysta-Regular.ttf", make_options(Font::DistanceField::single_channel, 128));
+
+        const Mesh first = font.create_atlas_text_mesh("A");
+
+        const Image atlas        = font.atlas();
+        const auto& coordinates  = first.texture_coordinates(0);
+        const std::size_t left   = static_cast<std::size_t>(coordinates[0].x * static_cast<float>(atlas.width()));
+        const std::size_t bottom = static_cast<std::size_t>(coordinates[0].y * static_cast<float>(atlas.height()));
+        const std::size_t right  = static_cast<std::size_t>(coordinates[2].x * static_cast<float>(atlas.width()));
+        const std::size_t top    = static_cast<std::size_t>(coordinates[2].y * static_cast<float>(atlas.height()));
+
+        font.create_atlas_text_mesh(text);
+
+        TEST_ASSERT(font.atlas().height() > atlas.height(), "Atlas should grow.");
+
+        bool same = true;
+        for (std::size_t y = bottom; y < top && same; ++y) {
+            for (std::size_t x = left; x < right && same; ++x) {
+                same = distance(atlas, x, y) == distance(font.atlas(), x, y);
+            }
+        }
+
+        TEST_ASSERT(same, "Glyphs should keep their place in the grown atlas.");
+    }
+
+    void atlas_options()
+    {
+        Font font = load_font("data/UbuntuMono-Regular.ttf");
+        font.create_atlas_text_mesh(text);
+
+        const Image multi_channel = font.atlas();
+
+        font.set_atlas_options(make_options(Font::DistanceField::single_channel));
+        TEST_ASSERT(font.atlas().bytes().empty(), "Atlas should be cleared.");
+
+        font.create_atlas_text_mesh(text);
+        TEST_ASSERT(font.atlas().format() == PixelFormat::r8 && font.atlas().width() == multi_channel.width() &&
+                    font.atlas().height() == multi_channel.height(),
+                    "Wrong single channel atlas.");
+
+        const Font copy = font;
+        TEST_ASSERT(copy.atlas_options().distance_field == Font::DistanceField::single_channel,
+                    "Atlas options should be copied.");
+    }
+};
+
+int main()
+{
+    return run_tests(FontAtlasTest());
+}
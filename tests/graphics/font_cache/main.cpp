@@ -0,0 +1,168 @@
+#include <cstddef>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <graphics/font.hpp>
+#include <unit_test/suite.hpp>
+
+using namespace framework;
+using namespace framework::graphics;
+
+namespace
+{
+const std::string text = "abracadabra";
+
+std::size_t unique_chars_count(const std::string& str)
+{
+    return std::set<char>(str.begin(), str.end()).size();
+}
+
+bool same_meshes(const Mesh& lhs, const Mesh& rhs)
+{
+    if (lhs.vertices() != rhs.vertices() || lhs.submeshes().size() != rhs.submeshes().size()) {
+        return false;
+    }
+
+    for (const auto& [index, submesh] : lhs.submeshes()) {
+        const auto it = rhs.submeshes().find(index);
+        if (it == rhs.submeshes().end() || it->second.indices != submesh.indices ||
+            it->second.primitive_type != submesh.primitive_type) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+class FontCacheTest : public unit_test::Suite
+{
+public:
+    FontCacheTest()
+        : Suite("FontCacheTest")
+    {
+        add_test([this]() { cache_statistics(); }, "cache_statistics");
+        add_test([this]() { cache_eviction(); }, "cache_eviction");
+        add_test([this]() { multiple_threads(); }, "multiple_threads");
+        add_test([this]() { single_submesh(); }, "single_submesh");
+    }
+
+private:
+    void cache_statistics()
+    {
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        TEST_ASSERT(font.cache_capacity() == Font::default_cache_capacity, "Wrong default cache capacity.");
+
+        font.create_text_mesh(text);
+
+        const Font::CacheStatistics statistics = font.cache_statistics();
+        TEST_ASSERT(statistics.misses == unique_chars_count(text), "Each glyph should be generated once.");
+        TEST_ASSERT(statistics.hits == text.size() - unique_chars_count(text), "Repeated glyphs should be cached.");
+        TEST_ASSERT(statistics.glyphs_count == unique_chars_count(text) && statistics.evictions == 0,
+                    "All glyphs should stay in the cache.");
+        TEST_ASSERT(statistics.size > 0 && statistics.size <= font.cache_capacity(), "Wrong cache size.");
+
+        const Font copy = font;
+        TEST_ASSERT(copy.cache_statistics().misses == 0 && copy.cache_capacity() == font.cache_capacity(),
+                    "Copy should have empty cache of the same capacity.");
+    }
+
+    void cache_eviction()
+    {
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        const Mesh mesh             = font.create_text_mesh(text);
+        const std::size_t full_size = font.cache_statistics().size;
+
+        font.set_cache_capacity(full_size / 2);
+
+        Font::CacheStatistics statistics = font.cache_statistics();
+        TEST_ASSERT(statistics.evictions > 0 && statistics.size <= full_size / 2, "Glyphs should be evicted.");
+        TEST_ASSERT(statistics.glyphs_count + statistics.evictions == unique_chars_count(text),
+                    "Wrong cached glyphs count.");
+
+        // Every glyph is evicted right after it's generated.
+        font.set_cache_capacity(0);
+
+        const Mesh uncached = font.create_text_mesh(text);
+        TEST_ASSERT(same_meshes(mesh, uncached), "Evicted glyphs should be generated again.");
+
+        statistics = font.cache_statistics();
+        TEST_ASSERT(statistics.glyphs_count == 0 && statistics.size == 0, "Cache should be empty.");
+        TEST_ASSERT(statistics.misses == unique_chars_count(text) + text.size(), "Each glyph should be generated.");
+    }
+
+    void multiple_threads()
+    {
+        const std::string long_text = "The quick brown fox jumps over the lazy dog. Pack my box with five dozen jugs.";
+
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        Font reference = font;
+        const Mesh expected = reference.create_text_mesh(long_text);
+
+        constexpr std::size_t threads_count = 8;
+
+        std::vector<Mesh> meshes(threads_count);
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < threads_count; ++i) {
+            threads.emplace_back([&font, &long_text, &mesh = meshes[i]]() { mesh = font.create_text_mesh(long_text); });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        for (const auto& mesh : meshes) {
+            TEST_ASSERT(same_meshes(mesh, expected), "Mesh created in thread differs from the expected one.");
+        }
+
+        const Font::CacheStatistics statistics = font.cache_statistics();
+        TEST_ASSERT(statistics.misses == unique_chars_count(long_text), "Each glyph should be generated once.");
+        TEST_ASSERT(statistics.hits + statistics.misses == long_text.size() * threads_count, "Wrong requests count.");
+    }
+
+    void single_submesh()
+    {
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        std::string long_text;
+        while (long_text.size() < 10000) {
+            long_text += text;
+        }
+
+        const Mesh mesh = font.create_text_mesh(long_text);
+
+        TEST_ASSERT(mesh.submeshes().size() == 1, "Text should be drawn with one submesh.");
+
+        const Mesh::SubMesh& submesh = mesh.submeshes().begin()->second;
+        TEST_ASSERT(submesh.primitive_type == Mesh::PrimitiveType::triangles, "Wrong primitive type.");
+
+        const Mesh word           = font.create_text_mesh(text);
+        const std::size_t repeats = long_text.size() / text.size();
+
+        TEST_ASSERT(mesh.vertices().size() == word.vertices().size() * repeats &&
+                    submesh.indices.size() == word.submeshes().begin()->second.indices.size() * repeats,
+                    "Wrong text mesh size.");
+
+        bool valid_indices = true;
+        for (std::size_t i = 0; i < submesh.indices.size() && valid_indices; ++i) {
+            valid_indices = submesh.indices[i] < mesh.vertices().size();
+        }
+
+        TEST_ASSERT(valid_indices, "Indices are out of the vertices.");
+    }
+};
+
+int main()
+{
+    return run_tests(FontCacheTest());
+}
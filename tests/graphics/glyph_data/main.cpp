@@ -0,0 +1,139 @@
+#include <cstdint>
+#include <vector>
+
+#include <common/exceptions.hpp>
+#include <graphics/src/font/tables/glyph_data.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::ParsingError;
+using framework::graphics::details::font::GlyphData;
+using framework::graphics::details::font::GlyphId;
+using framework::graphics::details::font::Offset32;
+
+namespace
+{
+
+// Builds the glyf table and the glyph offsets in it.
+class GlyphTable
+{
+public:
+    // Glyph of one contour with three points.
+    void add_simple_glyph()
+    {
+        start_glyph(1);
+        write16(2); // end point of the contour
+        write16(0); // instructions length
+        for (int i = 0; i < 3; ++i) {
+            // On curve point, the same x and y as the previous one.
+            m_data.push_back(0x31);
+        }
+    }
+
+    void add_composite_glyph(const std::vector<GlyphId>& components)
+    {
+        start_glyph(-1);
+        for (std::size_t i = 0; i < components.size(); ++i) {
+            const bool last = i + 1 == components.size();
+            write16(last ? 0x0002 : 0x0022); // args are xy values, more components
+            write16(components[i]);
+            m_data.push_back(0); // x offset
+            m_data.push_back(0); // y offset
+        }
+    }
+
+    GlyphData glyph_data()
+    {
+        std::vector<Offset32> offsets = m_offsets;
+        offsets.push_back(static_cast<Offset32>(m_data.size()));
+
+        return GlyphData(static_cast<std::uint16_t>(m_offsets.size()), offsets, m_data);
+    }
+
+private:
+    void start_glyph(std::int16_t contours_count)
+    {
+        m_offsets.push_back(static_cast<Offset32>(m_data.size()));
+
+        write16(static_cast<std::uint16_t>(contours_count));
+        for (int i = 0; i < 4; ++i) {
+            write16(0); // bounding box
+        }
+    }
+
+    void write16(std::uint16_t value)
+    {
+        m_data.push_back(static_cast<std::uint8_t>(value >> 8));
+        m_data.push_back(static_cast<std::uint8_t>(value & 0xff));
+    }
+
+    std::vector<std::uint8_t> m_data;
+    std::vector<Offset32> m_offsets;
+};
+
+bool throws_parsing_error(const GlyphData& data, GlyphId id)
+{
+    try {
+        data.at(id);
+    } catch (ParsingError&) {
+        return true;
+    }
+
+    return false;
+}
+
+} // namespace
+
+class GlyphDataTest : public framework::unit_test::Suite
+{
+public:
+    GlyphDataTest()
+        : Suite("GlyphDataTest")
+    {
+        add_test([this]() { composite_glyphs(); }, "composite_glyphs");
+        add_test([this]() { composite_cycles(); }, "composite_cycles");
+    }
+
+private:
+    void composite_glyphs()
+    {
+        GlyphTable table;
+        table.add_simple_glyph();
+        table.add_composite_glyph({0, 0});
+        table.add_composite_glyph({1, 0, 1});
+
+        const GlyphData data = table.glyph_data();
+
+        TEST_ASSERT(data.is_valid(), "Glyph data should be valid.");
+        TEST_ASSERT(data.at(0).size() == 1 && data.at(0)[0].size() == 3, "Wrong simple glyph.");
+        TEST_ASSERT(data.at(1).size() == 2, "Wrong composite glyph.");
+        TEST_ASSERT(data.at(2).size() == 5, "Wrong nested composite glyph.");
+    }
+
+    void composite_cycles()
+    {
+        GlyphTable table;
+        table.add_simple_glyph();
+        table.add_composite_glyph({1, 1}); // 1: refers to itself twice
+        table.add_composite_glyph({0, 3}); // 2: cycle of 2 and 3
+        table.add_composite_glyph({2});    // 3
+
+        // 4..15: each glyph uses the next one twice, so the last one is used 2^12 times.
+        for (GlyphId id = 4; id < 16; ++id) {
+            table.add_composite_glyph({static_cast<GlyphId>(id + 1), static_cast<GlyphId>(id + 1)});
+        }
+        table.add_simple_glyph(); // 16
+
+        const GlyphData data = table.glyph_data();
+
+        TEST_ASSERT(throws_parsing_error(data, 1), "Self-referencing composite glyph should be rejected.");
+        TEST_ASSERT(throws_parsing_error(data, 2) && throws_parsing_error(data, 3),
+                    "Cycle of composite glyphs should be rejected.");
+        TEST_ASSERT(throws_parsing_error(data, 4), "Too many components should be rejected.");
+        TEST_ASSERT(data.at(12).size() == 16, "Composite glyph with few components should be decoded.");
+    }
+};
+
+int main()
+{
+    return run_tests(GlyphDataTest());
+}
@@ -1,8 +1,50 @@
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
 #include <sstream>
+#include <vector>
 
 #include <graphics/image.hpp>
 #include <unit_test/suite.hpp>
 
+namespace
+{
+std::vector<std::byte> read_file(const std::string& name)
+{
+    std::ifstream file(name, std::ios::in | std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::vector<std::byte> bytes(data.size());
+    std::transform(data.begin(), data.end(), bytes.begin(), [](char c) { return static_cast<std::byte>(c); });
+
+    return bytes;
+}
+
+// Takes every `step` pixel of the region, the `top` row is counted from the top of the image.
+std::vector<std::uint8_t> take_pixels(const framework::graphics::Image& image,
+                                      std::size_t left,
+                                      std::size_t top,
+                                      std::size_t width,
+                                      std::size_t height,
+                                      std::size_t step = 1)
+{
+    const std::size_t pixel_size = framework::graphics::bytes_per_pixel(image.format());
+
+    std::vector<std::uint8_t> pixels;
+    for (std::size_t row = 0; row < height; ++row) {
+        const std::size_t y = image.height() - 1 - (top + (height - 1 - row) * step);
+        for (std::size_t column = 0; column < width; ++column) {
+            const auto pixel = image.bytes().begin() + (y * image.width() + left + column * step) * pixel_size;
+            pixels.insert(pixels.end(), pixel, pixel + pixel_size);
+        }
+    }
+
+    return pixels;
+}
+
+} // namespace
+
 class BmpImageTest : public framework::unit_test::Suite
 {
 public:
@@ -12,6 +54,10 @@ public:
         add_test([this]() { bmp_load_good(); }, "bmp_load_good");
         add_test([this]() { bmp_load_questionable(); }, "bmp_load_questionable");
         add_test([this]() { bmp_load_bad(); }, "bmp_load_bad");
+        add_test([this]() { bmp_load_bitfields(); }, "bmp_load_bitfields");
+        add_test([this]() { bmp_load_from_memory(); }, "bmp_load_from_memory");
+        add_test([this]() { bmp_save(); }, "bmp_save");
+        add_test([this]() { bmp_load_region(); }, "bmp_load_region");
     }
 
 private:
@@ -138,6 +184,138 @@ private:
             TEST_ASSERT(result != Image::LoadResult::Success, error_msg.str());
         }
     }
+
+    void bmp_load_bitfields()
+    {
+        using framework::graphics::Image;
+
+        const std::vector<std::pair<std::string, std::string>> files =
+        {{"bmp/good/rgb16bfdef.bmp", "bmp/good/rgb16.bmp"},
+         {"bmp/good/rgb32bf.bmp", "bmp/good/rgb32.bmp"},
+         {"bmp/good/rgb32bfdef.bmp", "bmp/good/rgb32.bmp"}};
+
+        for (const auto& [bitfields_file, file] : files) {
+            Image bitfields;
+            Image image;
+
+            std::stringstream error_msg;
+            error_msg << "Image " << bitfields_file << " differs from " << file << ".";
+
+            TEST_ASSERT(bitfields.load(bitfields_file) == Image::LoadResult::Success &&
+                        image.load(file) == Image::LoadResult::Success && bitfields == image,
+                        error_msg.str());
+        }
+    }
+
+    void bmp_load_from_memory()
+    {
+        using framework::graphics::Image;
+
+        const std::vector<std::string> files = {"bmp/good/pal4rle.bmp",
+                                                "bmp/good/pal8topdown.bmp",
+                                                "bmp/good/rgb24.bmp",
+                                                "bmp/good/rgb32bf.bmp"};
+
+        for (const auto& file : files) {
+            const std::vector<std::byte> data = read_file(file);
+
+            Image from_file;
+            Image from_memory;
+
+            std::stringstream error_msg;
+            error_msg << "Image " << file << " loaded from memory differs from the file one.";
+
+            TEST_ASSERT(from_file.load(file) == Image::LoadResult::Success &&
+                        from_memory.load(data) == Image::LoadResult::Success && from_file == from_memory,
+                        error_msg.str());
+        }
+
+        Image image;
+        TEST_ASSERT(image.load(std::vector<std::byte>()) == Image::LoadResult::InvalidFileType,
+                    "Empty buffer should have invalid file type.");
+    }
+
+    void bmp_save()
+    {
+        using framework::graphics::Color;
+        using framework::graphics::Image;
+
+        const std::vector<std::string> files = {"bmp/good/pal8.bmp", "bmp/good/rgb24.bmp", "bmp/good/rgb32.bmp"};
+
+        for (const auto& file : files) {
+            Image image;
+            Image saved;
+
+            std::stringstream error_msg;
+            error_msg << "Image " << file << " differs from the saved one.";
+
+            TEST_ASSERT(image.load(file) == Image::LoadResult::Success &&
+                        image.save("bmp_save_test.bmp", Image::FileType::bmp) == Image::SaveResult::Success &&
+                        saved.load("bmp_save_test.bmp") == Image::LoadResult::Success && image == saved,
+                        error_msg.str());
+        }
+
+        constexpr std::size_t width  = 13;
+        constexpr std::size_t height = 7;
+
+        Image::ColorDataType data(width * height);
+        for (std::size_t i = 0; i < data.size(); ++i) {
+            data[i] = Color(static_cast<std::uint8_t>(i * 3),
+                            static_cast<std::uint8_t>(i * 5),
+                            static_cast<std::uint8_t>(i * 7),
+                            static_cast<std::uint8_t>(i * 11));
+        }
+
+        const Image transparent(data, width, height);
+        Image saved;
+
+        TEST_ASSERT(transparent.save("bmp_save_test.bmp", Image::FileType::bmp) == Image::SaveResult::Success &&
+                    saved.load("bmp_save_test.bmp") == Image::LoadResult::Success && transparent == saved,
+                    "Image with alpha differs from the saved one.");
+
+        TEST_ASSERT(Image(data, width, width).save("bmp_save_test.bmp", Image::FileType::bmp) ==
+                    Image::SaveResult::InvalidImage,
+                    "Image with wrong data size should not be saved.");
+    }
+
+    void bmp_load_region()
+    {
+        using framework::graphics::Image;
+
+        const std::vector<std::string> files = {"bmp/good/pal4rle.bmp",
+                                                "bmp/good/pal8topdown.bmp",
+                                                "bmp/good/rgb24.bmp"};
+
+        for (const auto& file : files) {
+            Image image;
+            image.load(file);
+
+            // Preview pixels are aligned to the top-left corner of the image, not to the region.
+            Image::LoadOptions options;
+            options.x       = 8;
+            options.y       = image.height() - 32 - 30;
+            options.width   = 20;
+            options.height  = 30;
+            options.preview = true;
+
+            const std::size_t width  = (options.width + 7) / 8;
+            const std::size_t height = (options.height + 7) / 8;
+            const std::size_t top    = image.height() - options.y - options.height;
+
+            Image region;
+
+            std::stringstream error_msg;
+            error_msg << "Region of " << file << " differs from the full image.";
+
+            TEST_ASSERT(region.load(file, options) == Image::LoadResult::Success &&
+                        region.width() == width && region.height() == height,
+                        error_msg.str());
+
+            const std::vector<std::uint8_t> expected = take_pixels(image, options.x, top, width, height, 8);
+            TEST_ASSERT(std::equal(expected.begin(), expected.end(), region.bytes().begin(), region.bytes().end()),
+                        error_msg.str());
+        }
+    }
 };
 
 int main()
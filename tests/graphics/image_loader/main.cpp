@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <graphics/image_loader.hpp>
+#include <unit_test/suite.hpp>
+
+namespace
+{
+const std::vector<std::filesystem::path> files = {"png/basn0g01.png",
+                                                  "png/basn0g16.png",
+                                                  "png/basn2c08.png",
+                                                  "png/basn2c16.png",
+                                                  "png/basn3p04.png",
+                                                  "png/basn4a08.png",
+                                                  "png/basn6a08.png",
+                                                  "png/basn6a16.png"};
+
+std::vector<std::byte> read_file(const std::filesystem::path& name)
+{
+    std::ifstream file(name, std::ios::in | std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::vector<std::byte> bytes(data.size());
+    std::transform(data.begin(), data.end(), bytes.begin(), [](char c) { return static_cast<std::byte>(c); });
+
+    return bytes;
+}
+
+} // namespace
+
+class ImageLoaderTest : public framework::unit_test::Suite
+{
+public:
+    ImageLoaderTest()
+        : Suite("ImageLoaderTest")
+    {
+        add_test([this]() { load_files(); }, "load_files");
+        add_test([this]() { load_buffers(); }, "load_buffers");
+        add_test([this]() { load_errors(); }, "load_errors");
+        add_test([this]() { priority_order(); }, "priority_order");
+        add_test([this]() { cancel_requests(); }, "cancel_requests");
+        add_test([this]() { small_memory_budget(); }, "small_memory_budget");
+        add_test([this]() { throwing_callback(); }, "throwing_callback");
+    }
+
+private:
+    void load_files()
+    {
+        using framework::graphics::Image;
+        using framework::graphics::ImageLoader;
+
+        ImageLoader loader(4);
+        auto handles = loader.load(files);
+
+        TEST_ASSERT(handles.size() == files.size(), "Wrong handles count.");
+
+        for (std::size_t i = 0; i < files.size(); ++i) {
+            Image image;
+            image.load(files[i]);
+
+            ImageLoader::Result result = handles[i].get();
+
+            std::stringstream error_msg;
+            error_msg << "Image " << files[i] << " differs from the loaded one.";
+
+            TEST_ASSERT(result.status == Image::LoadResult::Success && !result.cancelled && result.image == image,
+                        error_msg.str());
+            TEST_ASSERT(!handles[i].valid(), "Handle is valid after getting the result.");
+        }
+    }
+
+    void load_buffers()
+    {
+        using framework::graphics::Image;
+        using framework::graphics::ImageLoader;
+
+        ImageLoader loader(2);
+
+        std::mutex mutex;
+        std::vector<Image> images;
+
+        for (const auto& file : files) {
+            loader.load(read_file(file), ImageLoader::Priority::normal, [&mutex, &images](const auto& result) {
+                std::lock_guard lock(mutex);
+                images.push_back(result.image);
+            });
+        }
+
+        loader.wait();
+
+        TEST_ASSERT(images.size() == files.size(), "Not all callbacks are called.");
+
+        for (const auto& file : files) {
+            Image image;
+            image.load(file);
+
+            TEST_ASSERT(std::find(images.begin(), images.end(), image) != images.end(), "Image is not loaded.");
+        }
+    }
+
+    void load_errors()
+    {
+        using framework::graphics::Image;
+        using framework::graphics::ImageLoader;
+
+        ImageLoader loader(1);
+
+        auto missing = loader.load("png/missing.png");
+        auto invalid = loader.load(std::vector<std::byte>(100, std::byte{1}));
+
+        TEST_ASSERT(missing.get().status == Image::LoadResult::FileNotExists, "Wrong missing file status.");
+        TEST_ASSERT(invalid.get().status == Image::LoadResult::InvalidFileType, "Wrong invalid buffer status.");
+    }
+
+    void priority_order()
+    {
+        using framework::graphics::ImageLoader;
+
+        ImageLoader loader(1);
+
+        // Blocks the only worker until all requests are added.
+        std::promise<void> start;
+        std::shared_future<void> started = start.get_future().share();
+
+        loader.load(files[0], ImageLoader::Priority::high, [started](const auto&) { started.wait(); });
+
+        std::mutex mutex;
+        std::vector<ImageLoader::Priority> order;
+
+        auto add = [&](ImageLoader::Priority priority) {
+            loader.load(files[1], priority, [&mutex, &order, priority](const auto&) {
+                std::lock_guard lock(mutex);
+                order.push_back(priority);
+            });
+        };
+
+        add(ImageLoader::Priority::low);
+        add(ImageLoader::Priority::normal);
+        add(ImageLoader::Priority::high);
+        add(ImageLoader::Priority::low);
+        add(ImageLoader::Priority::high);
+
+        start.set_value();
+        loader.wait();
+
+        const std::vector<ImageLoader::Priority> expected = {ImageLoader::Priority::high,
+                                                             ImageLoader::Priority::high,
+                                                             ImageLoader::Priority::normal,
+                                                             ImageLoader::Priority::low,
+                                                             ImageLoader::Priority::low};
+
+        TEST_ASSERT(order == expected, "Requests are not processed in order of priority.");
+    }
+
+    void cancel_requests()
+    {
+        using framework::graphics::ImageLoader;
+
+        ImageLoader loader(1);
+
+        // Blocks the only worker, so the other requests stay pending.
+        std::promise<void> running;
+        std::promise<void> start;
+        std::shared_future<void> started = start.get_future().share();
+
+        auto blocking = loader.load(files[0], ImageLoader::Priority::high, [&running, started](const auto&) {
+            running.set_value();
+            started.wait();
+        });
+
+        running.get_future().wait();
+
+        std::atomic<int> cancelled_callbacks = 0;
+        auto callback                        = [&cancelled_callbacks](const ImageLoader::Result& result) {
+            if (result.cancelled) {
+                cancelled_callbacks++;
+            }
+        };
+
+        auto first  = loader.load(files[1], ImageLoader::Priority::normal, callback);
+        auto second = loader.load(files[2], ImageLoader::Priority::normal, callback);
+        auto third  = loader.load(files[3], ImageLoader::Priority::normal, callback);
+
+        TEST_ASSERT(first.cancel(), "Pending request is not cancelled.");
+        TEST_ASSERT(!first.cancel(), "Request is cancelled twice.");
+
+        loader.cancel_all();
+
+        start.set_value();
+
+        TEST_ASSERT(!blocking.cancel(), "Running request is cancelled.");
+        TEST_ASSERT(blocking.get().status == framework::graphics::Image::LoadResult::Success, "Request is not loaded.");
+        TEST_ASSERT(first.get().cancelled && second.get().cancelled && third.get().cancelled,
+                    "Requests are not cancelled.");
+        TEST_ASSERT(cancelled_callbacks == 3, "Callbacks of cancelled requests are not called.");
+    }
+
+    void small_memory_budget()
+    {
+        using framework::graphics::Image;
+        using framework::graphics::ImageLoader;
+
+        ImageLoader loader(4, 1);
+        auto handles = loader.load(files, ImageLoader::Priority::low);
+
+        bool loaded = true;
+        for (auto& handle : handles) {
+            loaded = loaded && handle.get().status == Image::LoadResult::Success;
+        }
+
+        TEST_ASSERT(loaded, "Images bigger than memory budget are not loaded.");
+    }
+
+    void throwing_callback()
+    {
+        using framework::graphics::Image;
+        using framework::graphics::ImageLoader;
+
+        ImageLoader loader(2);
+
+        auto callback = [](const ImageLoader::Result&) { throw std::runtime_error("Callback error."); };
+
+        auto handle = loader.load(files[0], ImageLoader::Priority::normal, callback);
+        TEST_ASSERT(handle.get().status == Image::LoadResult::Success, "Result is lost after callback exception.");
+
+        std::vector<ImageLoader::Handle> handles;
+        for (const auto& file : files) {
+            handles.push_back(loader.load(file, ImageLoader::Priority::low, callback));
+        }
+
+        loader.cancel_all();
+
+        bool completed = true;
+        for (auto& pending : handles) {
+            const ImageLoader::Result result = pending.get();
+            const bool loaded                = result.status == Image::LoadResult::Success;
+
+            completed = completed && (result.cancelled || loaded);
+        }
+
+        TEST_ASSERT(completed, "Requests are not completed after callback exceptions.");
+    }
+};
+
+int main()
+{
+    return run_tests(ImageLoaderTest());
+}
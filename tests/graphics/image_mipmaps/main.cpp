@@ -0,0 +1,157 @@
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+#include <graphics/image.hpp>
+#include <unit_test/suite.hpp>
+
+using namespace framework;
+using namespace framework::graphics;
+
+namespace
+{
+const std::vector<Image::MipmapFilter> filters = {Image::MipmapFilter::box,
+                                                  Image::MipmapFilter::kaiser,
+                                                  Image::MipmapFilter::lanczos3};
+
+const std::vector<PixelFormat> formats = {PixelFormat::r8,
+                                          PixelFormat::rg8,
+                                          PixelFormat::rgb8,
+                                          PixelFormat::rgba8,
+                                          PixelFormat::r16,
+                                          PixelFormat::rgba16,
+                                          PixelFormat::rgba16f};
+
+Image make_image(std::size_t width, std::size_t height, const std::vector<Color>& colors)
+{
+    Image::ColorDataType data(width * height);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = colors[i % colors.size()];
+    }
+
+    return Image(data, width, height);
+}
+
+Image::MipmapOptions make_options(Image::MipmapFilter filter, std::size_t threads_count = 1)
+{
+    Image::MipmapOptions options;
+    options.filter        = filter;
+    options.threads_count = threads_count;
+
+    return options;
+}
+
+} // namespace
+
+class ImageMipmapsTest : public unit_test::Suite
+{
+public:
+    ImageMipmapsTest()
+        : Suite("ImageMipmapsTest")
+    {
+        add_test([this]() { mipmap_sizes(); }, "mipmap_sizes");
+        add_test([this]() { uniform_color(); }, "uniform_color");
+        add_test([this]() { gamma_correct(); }, "gamma_correct");
+        add_test([this]() { alpha_weighting(); }, "alpha_weighting");
+        add_test([this]() { multiple_threads(); }, "multiple_threads");
+    }
+
+private:
+    void mipmap_sizes()
+    {
+        const std::vector<Image> square = make_image(8, 8, {Color(0xFF0088FFu)}).generate_mipmaps();
+        TEST_ASSERT(square.size() == 3, "Wrong levels count.");
+        TEST_ASSERT(square[0].width() == 4 && square[1].width() == 2 && square[2].width() == 1,
+                    "Wrong levels width.");
+
+        const std::vector<Image> odd = make_image(5, 3, {Color(0xFF0088FFu)}).generate_mipmaps();
+        TEST_ASSERT(odd.size() == 2, "Wrong levels count.");
+        TEST_ASSERT(odd[0].width() == 2 && odd[0].height() == 1, "Wrong level size.");
+        TEST_ASSERT(odd[1].width() == 1 && odd[1].height() == 1, "Wrong level size.");
+
+        Image::MipmapOptions options;
+        options.levels_count = 1;
+        TEST_ASSERT(make_image(8, 8, {Color(0xFF0088FFu)}).generate_mipmaps(options).size() == 1,
+                    "Levels count is not limited.");
+
+        TEST_ASSERT(Image().generate_mipmaps().empty(), "Empty image should not have mipmaps.");
+        TEST_ASSERT(make_image(1, 1, {Color(0xFF0088FFu)}).generate_mipmaps().empty(),
+                    "Image of 1x1 size should not have mipmaps.");
+    }
+
+    void uniform_color()
+    {
+        const Image color = make_image(7, 5, {Color(0x80402060u)});
+
+        for (PixelFormat format : formats) {
+            const Image image = color.convert(format);
+
+            for (auto filter : filters) {
+                std::stringstream error_msg;
+                error_msg << "Uniform color is changed, format: " << static_cast<int>(format)
+                          << ", filter: " << static_cast<int>(filter) << ".";
+
+                const std::vector<Image> levels = image.generate_mipmaps(make_options(filter));
+
+                bool uniform = levels.size() == 2;
+                for (const Image& level : levels) {
+                    uniform = uniform && level.format() == format && level.gamma() == image.gamma();
+
+                    const std::size_t pixel_size = bytes_per_pixel(format);
+                    for (std::size_t i = 0; i < level.bytes().size() && uniform; ++i) {
+                        uniform = level.bytes()[i] == image.bytes()[i % pixel_size];
+                    }
+                }
+
+                TEST_ASSERT(uniform, error_msg.str());
+            }
+        }
+    }
+
+    void gamma_correct()
+    {
+        const Image stripes = make_image(2, 2, {Color(0x000000FFu), Color(0xFFFFFFFFu)});
+
+        Image::MipmapOptions options;
+
+        // Half of the linear intensity is 188 in sRGB.
+        const std::vector<Image> linear = stripes.generate_mipmaps(options);
+        TEST_ASSERT(linear.size() == 1 && linear[0].pixels<Color>()[0] == Color(0xBCBCBCFFu),
+                    "Wrong gamma correct average.");
+
+        options.gamma_correct = false;
+
+        const std::vector<Image> encoded = stripes.generate_mipmaps(options);
+        TEST_ASSERT(encoded.size() == 1 && encoded[0].pixels<Color>()[0] == Color(0x808080FFu),
+                    "Wrong average of encoded colors.");
+    }
+
+    void alpha_weighting()
+    {
+        const Image image = make_image(2, 1, {Color(0xFF0000FFu), Color(0x00FF0000u)});
+
+        for (auto filter : filters) {
+            const std::vector<Image> levels = image.generate_mipmaps(make_options(filter));
+
+            TEST_ASSERT(levels.size() == 1 && levels[0].pixels<Color>()[0] == Color(0xFF000080u),
+                        "Transparent color bleeds into the visible one.");
+        }
+    }
+
+    void multiple_threads()
+    {
+        const Image image = make_image(67, 45, {Color(0xFF0088FFu), Color(0x12345678u), Color(0x00FF00A0u)});
+
+        for (auto filter : filters) {
+            const std::vector<Image> single   = image.generate_mipmaps(make_options(filter, 1));
+            const std::vector<Image> multiple = image.generate_mipmaps(make_options(filter, 4));
+
+            TEST_ASSERT(single.size() == 6 && single == multiple, "Levels depend on the threads count.");
+        }
+    }
+};
+
+int main()
+{
+    return run_tests(ImageMipmapsTest());
+}
@@ -1,8 +1,50 @@
+#include <algorithm>
+#include <cstddef>
+#include <fstream>
+#include <iterator>
 #include <sstream>
+#include <vector>
 
 #include <graphics/image.hpp>
 #include <unit_test/suite.hpp>
 
+namespace
+{
+std::vector<std::byte> read_file(const std::string& name)
+{
+    std::ifstream file(name, std::ios::in | std::ios::binary);
+    std::vector<char> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    std::vector<std::byte> bytes(data.size());
+    std::transform(data.begin(), data.end(), bytes.begin(), [](char c) { return static_cast<std::byte>(c); });
+
+    return bytes;
+}
+
+// Takes every `step` pixel of the region, the `top` row is counted from the top of the image.
+std::vector<std::uint8_t> take_pixels(const framework::graphics::Image& image,
+                                      std::size_t left,
+                                      std::size_t top,
+                                      std::size_t width,
+                                      std::size_t height,
+                                      std::size_t step = 1)
+{
+    const std::size_t pixel_size = framework::graphics::bytes_per_pixel(image.format());
+
+    std::vector<std::uint8_t> pixels;
+    for (std::size_t row = 0; row < height; ++row) {
+        const std::size_t y = image.height() - 1 - (top + (height - 1 - row) * step);
+        for (std::size_t column = 0; column < width; ++column) {
+            const auto pixel = image.bytes().begin() + (y * image.width() + left + column * step) * pixel_size;
+            pixels.insert(pixels.end(), pixel, pixel + pixel_size);
+        }
+    }
+
+    return pixels;
+}
+
+} // namespace
+
 class PngImageTest : public framework::unit_test::Suite
 {
 public:
@@ -11,6 +53,13 @@ public:
     {
         add_test([this]() { png_load_good(); }, "png_load_good");
         add_test([this]() { png_load_bad(); }, "png_load_bad");
+        add_test([this]() { png_load_interlaced(); }, "png_load_interlaced");
+        add_test([this]() { png_load_from_memory(); }, "png_load_from_memory");
+        add_test([this]() { png_save(); }, "png_save");
+        add_test([this]() { png_pixel_formats(); }, "png_pixel_formats");
+        add_test([this]() { convert_pixel_formats(); }, "convert_pixel_formats");
+        add_test([this]() { png_load_region(); }, "png_load_region");
+        add_test([this]() { png_load_preview(); }, "png_load_preview");
     }
 
 private:
@@ -93,6 +142,287 @@ private:
             TEST_ASSERT(result != Image::LoadResult::Success, error_msg.str());
         }
     }
+
+    void png_load_interlaced()
+    {
+        using framework::graphics::Image;
+
+        const std::vector<std::pair<std::string, std::string>> files =
+        {{"png/basi0g01.png", "png/basn0g01.png"},
+         {"png/basi0g16.png", "png/basn0g16.png"},
+         {"png/basi2c08.png", "png/basn2c08.png"},
+         {"png/basi2c16.png", "png/basn2c16.png"},
+         {"png/basi3p02.png", "png/basn3p02.png"},
+         {"png/basi4a08.png", "png/basn4a08.png"},
+         {"png/basi6a16.png", "png/basn6a16.png"},
+         {"png/s01i3p01.png", "png/s01n3p01.png"},
+         {"png/s09i3p02.png", "png/s09n3p02.png"},
+         {"png/s39i3p04.png", "png/s39n3p04.png"}};
+
+        for (const auto& [interlaced_file, file] : files) {
+            Image interlaced;
+            Image image;
+
+            std::stringstream error_msg;
+            error_msg << "Image " << interlaced_file << " differs from " << file << ".";
+
+            TEST_ASSERT(interlaced.load(interlaced_file) == Image::LoadResult::Success &&
+                        image.load(file) == Image::LoadResult::Success && interlaced == image,
+                        error_msg.str());
+        }
+    }
+
+    void png_load_from_memory()
+    {
+        using framework::graphics::Image;
+
+        const std::vector<std::string> files = {"png/basn0g01.png",
+                                                "png/basi2c16.png",
+                                                "png/basn3p04.png",
+                                                "png/basn6a08.png"};
+
+        for (const auto& file : files) {
+            const std::vector<std::byte> data = read_file(file);
+
+            Image from_file;
+            Image from_memory;
+
+            std::stringstream error_msg;
+            error_msg << "Image " << file << " loaded from memory differs from the file one.";
+
+            TEST_ASSERT(from_file.load(file) == Image::LoadResult::Success &&
+                        from_memory.load(data) == Image::LoadResult::Success && from_file == from_memory,
+                        error_msg.str());
+        }
+
+        Image image;
+        TEST_ASSERT(image.load(std::vector<std::byte>()) == Image::LoadResult::InvalidFileType,
+                    "Empty buffer should have invalid file type.");
+    }
+
+    void png_save()
+    {
+        using framework::graphics::Image;
+        using framework::zlib::CompressionLevel;
+
+        const std::vector<std::string> files = {"png/basn0g04.png",
+                                                "png/basn0g16.png",
+                                                "png/basn2c08.png",
+                                                "png/basn3p04.png",
+                                                "png/basn4a08.png",
+                                                "png/basn6a08.png",
+                                                "png/basn6a16.png",
+                                                "png/g03n2c08.png",
+                                                "png/z09n2c08.png"};
+
+        const std::vector<Image::SaveOptions> options = {{CompressionLevel::no_compression, 1},
+                                                         {CompressionLevel::fastest, 1},
+                                                         {CompressionLevel::default_compression, 1},
+                                                         {CompressionLevel::best_compression, 1},
+                                                         {CompressionLevel::default_compression, 4}};
+
+        for (const auto& file : files) {
+            Image image;
+            TEST_ASSERT(image.load(file) == Image::LoadResult::Success, "Can't load image.");
+
+            for (const auto& option : options) {
+                Image saved;
+
+                std::stringstream error_msg;
+                error_msg << "Image " << file << " differs from the saved one.";
+
+                TEST_ASSERT(image.save("png_save_test.png", Image::FileType::png, option) ==
+                            Image::SaveResult::Success &&
+                            saved.load("png_save_test.png") == Image::LoadResult::Success && image == saved,
+                            error_msg.str());
+            }
+        }
+
+        TEST_ASSERT(Image().save("png_save_test.png", Image::FileType::png) == Image::SaveResult::InvalidImage,
+                    "Empty image should not be saved.");
+    }
+
+    void png_pixel_formats()
+    {
+        using framework::graphics::Color;
+        using framework::graphics::Image;
+        using framework::graphics::PixelFormat;
+        using framework::graphics::PixelR16;
+        using framework::graphics::PixelR8;
+
+        const std::vector<std::pair<std::string, PixelFormat>> files = {{"png/basn0g01.png", PixelFormat::r8},
+                                                                        {"png/basn0g08.png", PixelFormat::r8},
+                                                                        {"png/basn0g16.png", PixelFormat::r16},
+                                                                        {"png/basn2c08.png", PixelFormat::rgb8},
+                                                                        {"png/basn2c16.png", PixelFormat::rgba16},
+                                                                        {"png/basn3p04.png", PixelFormat::rgb8},
+                                                                        {"png/basn4a08.png", PixelFormat::rg8},
+                                                                        {"png/basn4a16.png", PixelFormat::rgba16},
+                                                                        {"png/basn6a08.png", PixelFormat::rgba8},
+                                                                        {"png/basn6a16.png", PixelFormat::rgba16}};
+
+        for (const auto& [file, format] : files) {
+            Image image;
+
+            std::stringstream error_msg;
+            error_msg << "Image " << file << " has wrong pixel format.";
+
+            TEST_ASSERT(image.load(file) == Image::LoadResult::Success && image.format() == format &&
+                        image.bytes().size() == image.width() * image.height() * bytes_per_pixel(format),
+                        error_msg.str());
+        }
+
+        Image grey;
+        grey.load("png/basn0g08.png");
+
+        TEST_ASSERT(grey.pixels<PixelR8>().size() == grey.width() * grey.height(), "Wrong pixels view size.");
+        TEST_ASSERT(grey.pixels<Color>().empty() && grey.pixels<PixelR16>().empty(),
+                    "Pixels view of other format should be empty.");
+
+        // The grey values of basn0g08 increase from left to right and from top to bottom.
+        TEST_ASSERT(grey.pixels<PixelR8>()[(grey.height() - 1) * grey.width()].r == 0, "Wrong grey value.");
+    }
+
+    void convert_pixel_formats()
+    {
+        using framework::graphics::Color;
+        using framework::graphics::Image;
+        using framework::graphics::PixelFormat;
+        using framework::graphics::PixelRG8;
+        using framework::graphics::PixelRGBA16F;
+
+        Image grey;
+        grey.load("png/basn4a08.png");
+
+        const Image rgba = grey.convert(PixelFormat::rgba8);
+
+        bool expanded = rgba.pixels<Color>().size() == grey.pixels<PixelRG8>().size();
+        for (std::size_t i = 0; i < rgba.pixels<Color>().size() && expanded; ++i) {
+            const Color color    = rgba.pixels<Color>()[i];
+            const PixelRG8 pixel = grey.pixels<PixelRG8>()[i];
+
+            expanded = color.r == pixel.r && color.g == pixel.r && color.b == pixel.r && color.a == pixel.g;
+        }
+
+        TEST_ASSERT(expanded, "Greyscale is not expanded to color.");
+        TEST_ASSERT(rgba.convert(PixelFormat::rg8) == grey, "Greyscale is changed by conversion to color and back.");
+        TEST_ASSERT(rgba.convert(PixelFormat::rgba16).convert(PixelFormat::rgba8) == rgba,
+                    "Color is changed by conversion to 16 bit and back.");
+
+        Image image;
+        image.load("png/basn6a16.png");
+
+        TEST_ASSERT(image.convert(PixelFormat::rgba16) == image, "Conversion to the same format changes the image.");
+
+        Image half(2, 1, PixelFormat::rgba16f);
+        half.pixels<PixelRGBA16F>()[0] = {0x3C00, 0x3800, 0x0000, 0x4000}; // 1.0, 0.5, 0.0, 2.0
+        half.pixels<PixelRGBA16F>()[1] = {0xBC00, 0x7E00, 0x3C00, 0x3C00}; // -1.0, NaN, 1.0, 1.0
+
+        const Image colors = half.convert(PixelFormat::rgba8);
+        TEST_ASSERT(colors.pixels<Color>()[0] == Color(0xFF8000FFu) &&
+                    colors.pixels<Color>()[1] == Color(0x0000FFFFu),
+                    "Wrong conversion of floating point values.");
+
+        const Image back = colors.convert(PixelFormat::rgba16f);
+        TEST_ASSERT(back.pixels<PixelRGBA16F>()[1].b == 0x3C00 && back.pixels<PixelRGBA16F>()[1].r == 0,
+                    "Wrong conversion to floating point values.");
+    }
+
+    void png_load_region()
+    {
+        using framework::graphics::Image;
+
+        const std::vector<std::string> files = {"png/basn0g01.png",
+                                                "png/basi0g01.png",
+                                                "png/basn3p04.png",
+                                                "png/basi2c16.png",
+                                                "png/basn6a08.png",
+                                                "png/f04n2c08.png",
+                                                "png/s39i3p04.png"};
+
+        for (const auto& file : files) {
+            Image image;
+            image.load(file);
+
+            Image::LoadOptions options;
+            options.x      = 3;
+            options.y      = 5;
+            options.width  = 17;
+            options.height = 9;
+
+            const std::size_t width  = std::min(options.width, image.width() - options.x);
+            const std::size_t height = std::min(options.height, image.height() - options.y);
+            const std::size_t top    = image.height() - options.y - height;
+
+            Image region;
+
+            std::stringstream error_msg;
+            error_msg << "Region of " << file << " differs from the full image.";
+
+            TEST_ASSERT(region.load(file, options) == Image::LoadResult::Success, error_msg.str());
+            TEST_ASSERT(region.width() == width && region.height() == height, error_msg.str());
+            TEST_ASSERT(region.format() == image.format() && region.gamma() == image.gamma(), error_msg.str());
+
+            const std::vector<std::uint8_t> expected = take_pixels(image, options.x, top, width, height);
+            TEST_ASSERT(std::equal(expected.begin(), expected.end(), region.bytes().begin(), region.bytes().end()),
+                        error_msg.str());
+
+            // Region up to the image border.
+            options.width  = 0;
+            options.height = 0;
+
+            TEST_ASSERT(region.load(read_file(file), options) == Image::LoadResult::Success &&
+                        region.width() == image.width() - options.x && region.height() == image.height() - options.y,
+                        error_msg.str());
+        }
+
+        Image image;
+
+        Image::LoadOptions options;
+        options.x = 32;
+        TEST_ASSERT(image.load("png/basn0g08.png", options) == Image::LoadResult::InvalidRegion,
+                    "Region out of the image should be invalid.");
+
+        options.x = 0;
+        options.y = 40;
+        TEST_ASSERT(image.load("png/basn0g08.png", options) == Image::LoadResult::InvalidRegion,
+                    "Region out of the image should be invalid.");
+    }
+
+    void png_load_preview()
+    {
+        using framework::graphics::Image;
+
+        const std::vector<std::string> files = {"png/basi0g01.png",
+                                                "png/basi0g16.png",
+                                                "png/basi3p04.png",
+                                                "png/basi6a08.png",
+                                                "png/basn2c08.png",
+                                                "png/s39i3p04.png"};
+
+        for (const auto& file : files) {
+            Image image;
+            image.load(file);
+
+            Image::LoadOptions options;
+            options.preview = true;
+
+            const std::size_t width  = (image.width() + 7) / 8;
+            const std::size_t height = (image.height() + 7) / 8;
+
+            Image preview;
+
+            std::stringstream error_msg;
+            error_msg << "Preview of " << file << " differs from the full image.";
+
+            TEST_ASSERT(preview.load(file, options) == Image::LoadResult::Success, error_msg.str());
+            TEST_ASSERT(preview.width() == width && preview.height() == height, error_msg.str());
+
+            const std::vector<std::uint8_t> expected = take_pixels(image, 0, 0, width, height, 8);
+            TEST_ASSERT(std::equal(expected.begin(), expected.end(), preview.bytes().begin(), preview.bytes().end()),
+                        error_msg.str());
+        }
+    }
 };
 
 int main()
@@ -0,0 +1,248 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <common/thread_pool.hpp>
+#include <graphics/image_processing.hpp>
+#include <unit_test/suite.hpp>
+
+#include <graphics/src/image/strips.hpp>
+
+using namespace framework;
+using namespace framework::graphics;
+
+namespace
+{
+const std::vector<ResizeFilter> filters = {ResizeFilter::box,
+                                           ResizeFilter::bilinear,
+                                           ResizeFilter::bicubic,
+                                           ResizeFilter::lanczos3};
+
+const std::vector<PixelFormat> formats = {PixelFormat::r8,
+                                          PixelFormat::rg8,
+                                          PixelFormat::rgb8,
+                                          PixelFormat::rgba8,
+                                          PixelFormat::r16,
+                                          PixelFormat::rgba16,
+                                          PixelFormat::rgba16f};
+
+Image make_image(std::size_t width, std::size_t height, const std::vector<Color>& colors)
+{
+    Image::ColorDataType data(width * height);
+    for (std::size_t i = 0; i < data.size(); ++i) {
+        data[i] = colors[i % colors.size()];
+    }
+
+    return Image(data, width, height);
+}
+
+ResizeOptions make_options(ResizeFilter filter, std::size_t threads_count = 1)
+{
+    ResizeOptions options;
+    options.filter        = filter;
+    options.threads_count = threads_count;
+
+    return options;
+}
+
+} // namespace
+
+class ImageProcessingTest : public unit_test::Suite
+{
+public:
+    ImageProcessingTest()
+        : Suite("ImageProcessingTest")
+    {
+        add_test([this]() { resize_size(); }, "resize_size");
+        add_test([this]() { resize_uniform_color(); }, "resize_uniform_color");
+        add_test([this]() { resize_bilinear(); }, "resize_bilinear");
+        add_test([this]() { premultiplied_alpha(); }, "premultiplied_alpha");
+        add_test([this]() { srgb_conversion(); }, "srgb_conversion");
+        add_test([this]() { multiple_threads(); }, "multiple_threads");
+        add_test([this]() { throwing_strip(); }, "throwing_strip");
+    }
+
+private:
+    void resize_size()
+    {
+        Image image = make_image(7, 5, {Color(0xFF0088FFu), Color(0x00FF00A0u)}).convert(PixelFormat::rg8);
+        image.set_gamma(1.0f);
+
+        for (auto filter : filters) {
+            const Image res = resize(image, 3, 9, make_options(filter));
+
+            TEST_ASSERT(res.width() == 3 && res.height() == 9, "Wrong image size.");
+            TEST_ASSERT(res.format() == image.format() && res.gamma() == image.gamma(), "Wrong image format.");
+            TEST_ASSERT(res.bytes().size() == 3 * 9 * bytes_per_pixel(image.format()), "Wrong image data size.");
+        }
+
+        TEST_ASSERT(resize(image, 0, 9) == Image(), "Image of zero width should be empty.");
+        TEST_ASSERT(resize(Image(), 3, 9) == Image(), "Empty image can't be resized.");
+    }
+
+    void resize_uniform_color()
+    {
+        const Image color = make_image(7, 5, {Color(0x80402060u)});
+
+        for (PixelFormat format : formats) {
+            const Image image = color.convert(format);
+
+            for (auto filter : filters) {
+                std::stringstream error_msg;
+                error_msg << "Uniform color is changed, format: " << static_cast<int>(format)
+                          << ", filter: " << static_cast<int>(filter) << ".";
+
+                const Image smaller = resize(image, 3, 2, make_options(filter));
+                const Image bigger  = resize(image, 16, 11, make_options(filter));
+
+                const std::size_t pixel_size = bytes_per_pixel(format);
+
+                bool uniform = true;
+                for (std::size_t i = 0; i < smaller.bytes().size() && uniform; ++i) {
+                    uniform = smaller.bytes()[i] == image.bytes()[i % pixel_size];
+                }
+
+                for (std::size_t i = 0; i < bigger.bytes().size() && uniform; ++i) {
+                    uniform = bigger.bytes()[i] == image.bytes()[i % pixel_size];
+                }
+
+                TEST_ASSERT(uniform, error_msg.str());
+            }
+        }
+    }
+
+    void resize_bilinear()
+    {
+        const Image image = make_image(2, 1, {Color(0x000000FFu), Color(0xFFFFFFFFu)}).convert(PixelFormat::r8);
+
+        ResizeOptions options = make_options(ResizeFilter::bilinear);
+        options.gamma_correct = false;
+
+        const Image res = resize(image, 4, 1, options);
+
+        const std::vector<std::uint8_t> expected = {0, 64, 191, 255};
+        TEST_ASSERT(std::equal(expected.begin(), expected.end(), res.bytes().begin(), res.bytes().end()),
+                    "Wrong interpolated values.");
+    }
+
+    void premultiplied_alpha()
+    {
+        // Enough pixels to check both the vectorized and the scalar code.
+        Image image = make_image(37, 1, {Color(0xFF804080u), Color(0x12345600u), Color(0xFFFFFFFFu)});
+
+        premultiply_alpha(image);
+
+        const Span<const Color> premultiplied = image.pixels<Color>();
+        TEST_ASSERT(premultiplied[0] == Color(0x80402080u) && premultiplied[1] == Color(0x00000000u) &&
+                    premultiplied[2] == Color(0xFFFFFFFFu) && premultiplied[36] == Color(0x80402080u),
+                    "Wrong premultiplied colors.");
+
+        unpremultiply_alpha(image);
+
+        const Span<const Color> colors = image.pixels<Color>();
+        TEST_ASSERT(colors[0] == Color(0xFF804080u) && colors[1] == Color(0x00000000u) &&
+                    colors[2] == Color(0xFFFFFFFFu) && colors[36] == Color(0xFF804080u),
+                    "Wrong unpremultiplied colors.");
+
+        Image grey = make_image(2, 2, {Color(0xFFFFFF80u)}).convert(PixelFormat::rg8);
+        premultiply_alpha(grey);
+        TEST_ASSERT(grey.bytes()[0] == 0x80 && grey.bytes()[1] == 0x80, "Wrong premultiplied greyscale.");
+
+        Image wide = make_image(2, 2, {Color(0xFF804080u)}).convert(PixelFormat::rgba16);
+        premultiply_alpha(wide);
+        TEST_ASSERT(wide.convert(PixelFormat::rgba8).pixels<Color>()[0] == Color(0x80402080u),
+                    "Wrong premultiplied 16 bit colors.");
+
+        const Image opaque = make_image(2, 2, {Color(0xFF804080u)}).convert(PixelFormat::rgb8);
+        Image copy         = opaque;
+        premultiply_alpha(copy);
+        TEST_ASSERT(copy == opaque, "Image without alpha should not be changed.");
+    }
+
+    void srgb_conversion()
+    {
+        const Image color = make_image(3, 3, {Color(0x808080A0u), Color(0xFFFFFFFFu), Color(0x000000FFu)});
+
+        for (PixelFormat format : formats) {
+            const Image image = color.convert(format);
+
+            Image linear = image;
+            srgb_to_linear(linear);
+
+            TEST_ASSERT(linear.gamma() == 1.0f, "Linear image should have gamma 1.");
+
+            // The linear value of 128 is 55.
+            const Color first = linear.convert(PixelFormat::rgba8).pixels<Color>()[0];
+            TEST_ASSERT(first.r == 55 && first.g == 55 && first.b == 55, "Wrong linear color.");
+
+            linear_to_srgb(linear);
+
+            TEST_ASSERT(linear.gamma() == image.gamma(), "Wrong sRGB image gamma.");
+            TEST_ASSERT(linear.convert(PixelFormat::rgba8) == image.convert(PixelFormat::rgba8),
+                        "Wrong sRGB colors.");
+        }
+    }
+
+    void multiple_threads()
+    {
+        const Image image = make_image(67, 45, {Color(0xFF0088FFu), Color(0x12345678u), Color(0x00FF00A0u)});
+
+        for (auto filter : filters) {
+            const Image single   = resize(image, 31, 97, make_options(filter, 1));
+            const Image multiple = resize(image, 31, 97, make_options(filter, 4));
+
+            TEST_ASSERT(single == multiple, "Resized image depends on the threads count.");
+        }
+
+        Image single   = image;
+        Image multiple = image;
+
+        premultiply_alpha(single, 1);
+        premultiply_alpha(multiple, 4);
+        TEST_ASSERT(single == multiple, "Premultiplied image depends on the threads count.");
+
+        srgb_to_linear(single, 1);
+        srgb_to_linear(multiple, 4);
+        TEST_ASSERT(single == multiple, "Linear image depends on the threads count.");
+    }
+
+    void throwing_strip()
+    {
+        using framework::graphics::details::image::for_each_strip;
+
+        ThreadPool pool(4);
+
+        constexpr std::size_t rows_count        = 256;
+        std::atomic<std::size_t> processed_rows = 0;
+        std::size_t first_strip_rows            = 0;
+
+        bool thrown = false;
+        try {
+            for_each_strip(rows_count, &pool, [&](std::size_t begin, std::size_t end) {
+                if (begin == 0) {
+                    first_strip_rows = end;
+                    throw std::runtime_error("Strip error");
+                }
+
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                processed_rows += end - begin;
+            });
+        } catch (std::runtime_error&) {
+            thrown = true;
+        }
+
+        TEST_ASSERT(thrown, "Exception of the strip should be rethrown.");
+        TEST_ASSERT(processed_rows == rows_count - first_strip_rows,
+                    "All strips should be processed before the exception is rethrown.");
+    }
+};
+
+int main()
+{
+    return run_tests(ImageProcessingTest());
+}
@@ -0,0 +1,215 @@
+#include <string>
+
+#include <graphics/font.hpp>
+#include <graphics/text_layout.hpp>
+#include <unit_test/suite.hpp>
+
+using namespace framework;
+using namespace framework::graphics;
+
+namespace
+{
+const std::string text = "Hello, world!\nSecond line\n\nLast line";
+
+const Mesh::IndicesData& indices(const Mesh& mesh)
+{
+    return mesh.submeshes().begin()->second.indices;
+}
+
+std::size_t glyph_requests(const Font& font)
+{
+    return font.cache_statistics().hits + font.cache_statistics().misses;
+}
+
+bool same_meshes(const Mesh& lhs, const Mesh& rhs)
+{
+    return lhs.vertices() == rhs.vertices() && lhs.submeshes().size() == 1 && rhs.submeshes().size() == 1 &&
+           indices(lhs) == indices(rhs);
+}
+
+Mesh layout_mesh(const Font& font, const std::string& str)
+{
+    TextLayout layout(font);
+    layout.set_text(str);
+    layout.update();
+
+    return layout.mesh();
+}
+
+} // namespace
+
+class TextLayoutTest : public unit_test::Suite
+{
+public:
+    TextLayoutTest()
+        : Suite("TextLayoutTest")
+    {
+        add_test([this]() { lines(); }, "lines");
+        add_test([this]() { text_mesh(); }, "text_mesh");
+        add_test([this]() { append_line(); }, "append_line");
+        add_test([this]() { edit_lines(); }, "edit_lines");
+        add_test([this]() { set_text(); }, "set_text");
+    }
+
+private:
+    void lines()
+    {
+        Font font;
+        TextLayout layout(font);
+
+        layout.set_text(text);
+        TEST_ASSERT(layout.lines_count() == 4, "Wrong lines count.");
+        TEST_ASSERT(layout.line(0) == "Hello, world!" && layout.line(2).empty(), "Wrong lines.");
+        TEST_ASSERT(layout.text() == text, "Text should be the same.");
+
+        layout.insert_line(0, "First");
+        layout.erase_line(3);
+        layout.append_line("");
+        TEST_ASSERT(layout.text() == "First\nHello, world!\nSecond line\nLast line\n", "Wrong text after editing.");
+
+        layout.clear();
+        TEST_ASSERT(layout.lines_count() == 0 && layout.text().empty(), "Layout should be empty.");
+
+        bool thrown = false;
+        try {
+            layout.update();
+        } catch (const std::runtime_error&) {
+            thrown = true;
+        }
+
+        TEST_ASSERT(thrown, "Update should fail without the font data.");
+    }
+
+    void text_mesh()
+    {
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        TextLayout layout(font);
+        layout.set_text("Hello, world!");
+        layout.update();
+
+        TEST_ASSERT(same_meshes(layout.mesh(), font.create_text_mesh("Hello, world!")),
+                    "Single line mesh should be the same as Font::create_text_mesh makes.");
+
+        // The second line is the same text moved down by the line spacing.
+        layout.set_line_spacing(1.5f);
+        layout.set_text("Hello, world!\nHello, world!");
+        layout.update();
+
+        const Mesh::VertexData& vertices = layout.mesh().vertices();
+        const std::size_t line_size      = vertices.size() / 2;
+
+        bool moved = true;
+        for (std::size_t i = 0; i < line_size; ++i) {
+            const math::Vector3f offset = vertices[i] - vertices[line_size + i];
+            moved &= math::length(offset - math::Vector3f(0.0f, 1.5f, 0.0f)) < 0.0001f;
+        }
+
+        TEST_ASSERT(moved, "Lines should be placed by the line spacing.");
+        TEST_ASSERT(indices(layout.mesh()).size() == indices(font.create_text_mesh("Hello, world!")).size() * 2,
+                    "Wrong indices count.");
+    }
+
+    void append_line()
+    {
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        TextLayout layout(font);
+        layout.set_text(text);
+        layout.update();
+
+        const Mesh previous = layout.mesh();
+
+        layout.append_line("New message");
+        const std::size_t requests      = glyph_requests(font);
+        const TextLayout::Changes changes = layout.update();
+
+        TEST_ASSERT(glyph_requests(font) - requests == std::string("New message").size(),
+                    "Only the new line should be mapped to glyphs.");
+        TEST_ASSERT(changes.first_vertex == previous.vertices().size() &&
+                    changes.first_index == indices(previous).size(),
+                    "Only the new line should be changed.");
+        TEST_ASSERT(same_meshes(layout.mesh(), layout_mesh(font, text + "\nNew message")),
+                    "Mesh should be the same as the new layout makes.");
+
+        const TextLayout::Changes no_changes = layout.update();
+        TEST_ASSERT(no_changes.first_vertex == layout.mesh().vertices().size() &&
+                    no_changes.first_index == indices(layout.mesh()).size(),
+                    "Nothing should be changed without edits.");
+    }
+
+    void edit_lines()
+    {
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        TextLayout layout(font);
+        layout.set_text(text);
+        layout.update();
+
+        const std::size_t first_line_vertices = font.create_text_mesh(layout.line(0)).vertices().size();
+
+        layout.set_line(1, "Edited line");
+        TextLayout::Changes changes = layout.update();
+        TEST_ASSERT(changes.first_vertex == first_line_vertices, "The first line should stay unchanged.");
+        TEST_ASSERT(same_meshes(layout.mesh(), layout_mesh(font, "Hello, world!\nEdited line\n\nLast line")),
+                    "Wrong mesh after setting the line.");
+
+        layout.insert_line(1, "Inserted");
+        changes = layout.update();
+        TEST_ASSERT(changes.first_vertex == first_line_vertices, "The first line should stay unchanged.");
+        TEST_ASSERT(same_meshes(layout.mesh(), layout_mesh(font, "Hello, world!\nInserted\nEdited line\n\nLast line")),
+                    "Wrong mesh after inserting the line.");
+
+        layout.erase_line(0);
+        changes = layout.update();
+        TEST_ASSERT(changes.first_vertex == 0 && changes.first_index == 0, "All lines should be moved.");
+        TEST_ASSERT(same_meshes(layout.mesh(), layout_mesh(font, "Inserted\nEdited line\n\nLast line")),
+                    "Wrong mesh after erasing the line.");
+
+        layout.erase_line(3);
+        layout.update();
+        TEST_ASSERT(same_meshes(layout.mesh(), layout_mesh(font, "Inserted\nEdited line\n")),
+                    "Wrong mesh after erasing the last line.");
+    }
+
+    void set_text()
+    {
+        Font font;
+        font.load("data/Amethysta-Regular.ttf");
+
+        TextLayout layout(font);
+        layout.set_text(text);
+        layout.update();
+
+        const std::size_t requests = glyph_requests(font);
+
+        layout.set_text("Hello, world!\nSecond line\n\nLast line!");
+        layout.update();
+
+        TEST_ASSERT(glyph_requests(font) - requests == std::string("Last line!").size(),
+                    "Only the changed line should be mapped to glyphs.");
+        TEST_ASSERT(same_meshes(layout.mesh(), layout_mesh(font, "Hello, world!\nSecond line\n\nLast line!")),
+                    "Wrong mesh after setting the text.");
+
+        // Glyphs of the reloaded font are taken again.
+        font.load("data/Amethysta-Regular.ttf");
+        layout.update();
+
+        TEST_ASSERT(font.cache_statistics().misses > 0, "Lines should be mapped to glyphs of the reloaded font.");
+
+        // The font data of the second load can take the address of the data, which the layout was updated with.
+        font.load("data/Amethysta-Regular.ttf");
+        font.load("data/Amethysta-Regular.ttf");
+        layout.update();
+
+        TEST_ASSERT(font.cache_statistics().misses > 0, "Lines should be mapped to glyphs of the reloaded font.");
+    }
+};
+
+int main()
+{
+    return run_tests(TextLayoutTest());
+}
@@ -14,6 +14,7 @@ public:
         add_test([this]() { texture_data(); }, "texture_data");
         add_test([this]() { texture_copy(); }, "texture_copy");
         add_test([this]() { texture_move(); }, "texture_move");
+        add_test([this]() { texture_mipmaps(); }, "texture_mipmaps");
     }
 
 private:
@@ -108,6 +109,33 @@ private:
         TEST_ASSERT(texture.min_filter() == Texture::MinFilter::nearest_mipmap_linear, "Wrong min filter.");
         TEST_ASSERT(texture.mag_filter() == Texture::MagFilter::linear, "Wrong mag filter.");
     }
+
+    void texture_mipmaps()
+    {
+        std::vector<Color> data = {Color{0xFF0088FF}, Color{0xFF0088FF}, Color{0xFF0088FF}, Color{0xFF0088FF}};
+
+        Image img(data, 2, 2);
+
+        Texture texture;
+
+        texture.set_image(img);
+        texture.set_mipmaps(img.generate_mipmaps());
+
+        TEST_ASSERT(texture.mipmaps().size() == 1 && texture.mipmaps()[0].pixels<Color>()[0] == Color{0xFF0088FFu},
+                    "Wrong mipmaps.");
+
+        Texture texture1(texture);
+
+        TEST_ASSERT(texture1.mipmaps() == texture.mipmaps(), "Mipmaps are not copied.");
+
+        texture.set_image(img);
+
+        TEST_ASSERT(texture.mipmaps().empty(), "Mipmaps of the previous image are not removed.");
+
+        texture1.clear();
+
+        TEST_ASSERT(texture1.mipmaps().empty(), "Mipmaps are not removed.");
+    }
 };
 
 int main()
@@ -0,0 +1,248 @@
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <common/thread_pool.hpp>
+#include <math/math.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::ThreadPool;
+using framework::math::Matrix4f;
+using framework::math::Quaternionf;
+using framework::math::normalize;
+using framework::math::Vector3f;
+using framework::math::Vector4f;
+
+namespace
+{
+
+// Sizes to check both SIMD and scalar parts of the loops.
+const std::vector<std::size_t> sizes = {0, 1, 3, 4, 5, 8, 1001};
+
+std::vector<Vector3f> make_vectors(std::size_t count)
+{
+    std::vector<Vector3f> vectors;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto value = static_cast<float>(i);
+        vectors.emplace_back(std::sin(value) * 10.0f, std::cos(value * 0.7f) * 5.0f, value * 0.01f - 3.0f);
+    }
+
+    return vectors;
+}
+
+const Matrix4f transform_matrix = scale(rotate(translate(Matrix4f(), Vector3f(1.5f, -2.0f, 3.0f)),
+                                               normalize(Vector3f(1.0f, 2.0f, -0.5f)),
+                                               0.8f),
+                                        Vector3f(2.0f, 0.5f, 1.25f));
+
+struct SoaVectors
+{
+    explicit SoaVectors(const std::vector<Vector3f>& vectors)
+    {
+        for (const auto& v : vectors) {
+            x.push_back(v.x);
+            y.push_back(v.y);
+            z.push_back(v.z);
+        }
+    }
+
+    Vector3f operator[](std::size_t index) const
+    {
+        return Vector3f(x[index], y[index], z[index]);
+    }
+
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> z;
+};
+
+bool is_close(const Matrix4f& a, const Matrix4f& b)
+{
+    for (std::size_t c = 0; c < 4; ++c) {
+        for (std::size_t r = 0; r < 4; ++r) {
+            if (std::abs(a[c][r] - b[c][r]) > 1e-5f) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+} // namespace
+
+class BatchFunctionsTest : public framework::unit_test::Suite
+{
+public:
+    BatchFunctionsTest()
+        : Suite("BatchFunctionsTest")
+    {
+        add_test([this]() { transform_points_function(); }, "transform_points_function");
+        add_test([this]() { transform_directions_function(); }, "transform_directions_function");
+        add_test([this]() { transform_vectors_function(); }, "transform_vectors_function");
+        add_test([this]() { normalize_function(); }, "normalize_function");
+        add_test([this]() { multiply_function(); }, "multiply_function");
+        add_test([this]() { compose_transforms_function(); }, "compose_transforms_function");
+        add_test([this]() { parallel_processing(); }, "parallel_processing");
+    }
+
+private:
+    void transform_points_function()
+    {
+        for (const std::size_t size : sizes) {
+            const std::vector<Vector3f> points = make_vectors(size);
+
+            std::vector<Vector3f> result(size);
+            transform_points(transform_matrix, points, result);
+
+            SoaVectors soa(points);
+            SoaVectors soa_result(points);
+            transform_points(transform_matrix, {soa.x, soa.y, soa.z}, {soa_result.x, soa_result.y, soa_result.z});
+
+            // In place.
+            transform_points(transform_matrix, {soa.x, soa.y, soa.z}, {soa.x, soa.y, soa.z});
+
+            for (std::size_t i = 0; i < size; ++i) {
+                const Vector3f expected(transform_matrix * Vector4f(points[i], 1.0f));
+
+                TEST_ASSERT(result[i] == expected, "Points transform failed.");
+                TEST_ASSERT(soa_result[i] == expected, "Points transform for SoA failed.");
+                TEST_ASSERT(soa[i] == expected, "Points transform in place failed.");
+            }
+        }
+    }
+
+    void transform_directions_function()
+    {
+        for (const std::size_t size : sizes) {
+            std::vector<Vector3f> directions = make_vectors(size);
+            const std::vector<Vector3f> source = directions;
+
+            SoaVectors soa(directions);
+            transform_directions(transform_matrix, {soa.x, soa.y, soa.z}, {soa.x, soa.y, soa.z});
+
+            transform_directions(transform_matrix, directions, directions);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                const Vector3f expected(transform_matrix * Vector4f(source[i], 0.0f));
+
+                TEST_ASSERT(directions[i] == expected, "Directions transform failed.");
+                TEST_ASSERT(soa[i] == expected, "Directions transform for SoA failed.");
+            }
+        }
+    }
+
+    void transform_vectors_function()
+    {
+        for (const std::size_t size : sizes) {
+            std::vector<Vector4f> vectors;
+            for (const auto& v : make_vectors(size)) {
+                vectors.emplace_back(v, v.x * 0.5f);
+            }
+
+            std::vector<Vector4f> result(size);
+            transform_vectors(transform_matrix, vectors, result);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                TEST_ASSERT(result[i] == transform_matrix * vectors[i], "Vectors transform failed.");
+            }
+        }
+    }
+
+    void normalize_function()
+    {
+        for (const std::size_t size : sizes) {
+            const std::vector<Vector3f> vectors = make_vectors(size);
+
+            std::vector<Vector3f> result(size);
+            normalize(vectors, result);
+
+            SoaVectors soa(vectors);
+            normalize({soa.x, soa.y, soa.z}, {soa.x, soa.y, soa.z});
+
+            for (std::size_t i = 0; i < size; ++i) {
+                TEST_ASSERT(almost_equal(result[i], normalize(vectors[i]), 1), "Normalize failed.");
+                TEST_ASSERT(almost_equal(soa[i], normalize(vectors[i]), 1), "Normalize for SoA failed.");
+            }
+        }
+    }
+
+    void multiply_function()
+    {
+        for (const std::size_t size : sizes) {
+            std::vector<Matrix4f> lhs;
+            std::vector<Matrix4f> rhs;
+            for (const auto& v : make_vectors(size)) {
+                lhs.push_back(rotate(transform_matrix, normalize(v), v.x));
+                rhs.push_back(translate(Matrix4f(), v));
+            }
+
+            std::vector<Matrix4f> result(size);
+            multiply(lhs, rhs, result);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                TEST_ASSERT(result[i] == lhs[i] * rhs[i], "Matrices multiply failed.");
+            }
+        }
+    }
+
+    void compose_transforms_function()
+    {
+        for (const std::size_t size : sizes) {
+            const std::vector<Vector3f> translations = make_vectors(size);
+
+            std::vector<Vector3f> axes;
+            std::vector<Quaternionf> rotations;
+            std::vector<Vector3f> scales;
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto angle = static_cast<float>(i) * 0.1f;
+                axes.push_back(normalize(Vector3f(std::cos(angle), 1.0f, std::sin(angle * 3.0f))));
+                rotations.emplace_back(axes.back() * std::sin(angle / 2), std::cos(angle / 2));
+                scales.emplace_back(1.0f + std::sin(angle) * 0.5f, 2.0f, 0.5f);
+            }
+
+            std::vector<Matrix4f> result(size);
+            compose_transforms(translations, rotations, scales, result);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                const auto angle        = static_cast<float>(i) * 0.1f;
+                const Matrix4f expected = scale(rotate(translate(Matrix4f(), translations[i]), axes[i], angle),
+                                                scales[i]);
+
+                TEST_ASSERT(is_close(result[i], expected), "Compose transforms failed.");
+            }
+        }
+    }
+
+    void parallel_processing()
+    {
+        ThreadPool pool(4);
+
+        const std::vector<Vector3f> points = make_vectors(100003);
+
+        std::vector<Vector3f> expected(points.size());
+        transform_points(transform_matrix, points, expected);
+
+        std::vector<Vector3f> result(points.size());
+        transform_points(transform_matrix, points, result, &pool);
+
+        TEST_ASSERT(result == expected, "Parallel points transform failed.");
+
+        SoaVectors soa(points);
+        normalize({soa.x, soa.y, soa.z}, {soa.x, soa.y, soa.z}, &pool);
+        normalize(points, result, &pool);
+        normalize(points, expected);
+
+        bool normalized = true;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            normalized = normalized && soa[i] == expected[i] && result[i] == expected[i];
+        }
+
+        TEST_ASSERT(normalized, "Parallel normalize failed.");
+    }
+};
+
+int main()
+{
+    return run_tests(BatchFunctionsTest());
+}
@@ -1,6 +1,48 @@
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+
 #include <math/math.hpp>
 #include <unit_test/suite.hpp>
 
+namespace
+{
+
+using framework::math::Polygon;
+using framework::math::Vector2f;
+
+float distance_to_segment(const Vector2f& point, const Vector2f& a, const Vector2f& b)
+{
+    using framework::math::clamp;
+    using framework::math::dot;
+    using framework::math::length;
+
+    const Vector2f ab = b - a;
+    const float t     = dot(ab, ab) > 0.0f ? clamp(dot(point - a, ab) / dot(ab, ab), 0.0f, 1.0f) : 0.0f;
+    return length(point - (a + ab * t));
+}
+
+// Maximum distance from the curve points to the polyline.
+float max_distance(const std::function<Vector2f(float)>& curve, const Polygon& polyline)
+{
+    float result = 0.0f;
+    for (int i = 0; i <= 1000; ++i) {
+        const Vector2f point = curve(static_cast<float>(i) / 1000.0f);
+
+        float distance = std::numeric_limits<float>::max();
+        for (std::size_t j = 0; j + 1 < polyline.size(); ++j) {
+            distance = std::min(distance, distance_to_segment(point, polyline[j], polyline[j + 1]));
+        }
+
+        result = std::max(result, distance);
+    }
+
+    return result;
+}
+
+} // namespace
+
 class BezierFunctionsTest : public framework::unit_test::Suite
 {
 public:
@@ -9,6 +51,8 @@ public:
     {
         add_test([this]() { quadratic_bezier_function(); }, "quadratic_bezier_function");
         add_test([this]() { cubic_bezier_function(); }, "cubic_bezier_function");
+        add_test([this]() { flatten_quadratic_bezier_function(); }, "flatten_quadratic_bezier_function");
+        add_test([this]() { flatten_cubic_bezier_function(); }, "flatten_cubic_bezier_function");
     }
 
 private:
@@ -51,6 +95,72 @@ private:
         TEST_ASSERT(cubic_bezier(p1, p2, p3, p4, 1.0f) == p4, "Cubic bezier function error.");
         TEST_ASSERT(almost_equal(cubic_bezier(p1, p2, p3, p4, 0.5f), t3, 2), "Cubic bezier function error.");
     }
+
+    void flatten_quadratic_bezier_function()
+    {
+        using framework::math::flatten_quadratic_bezier;
+        using framework::math::quadratic_bezier;
+
+        const Vector2f p1{0.0f, 0.0f};
+        const Vector2f p2{0.0f, 80.0f};
+        const Vector2f p3{80.0f, 80.0f};
+
+        const auto curve = [&](float t) { return quadratic_bezier(p1, p2, p3, t); };
+
+        for (const float tolerance : {0.01f, 0.1f, 0.5f, 2.0f}) {
+            Polygon polyline = {p1};
+            flatten_quadratic_bezier(p1, p2, p3, tolerance, polyline);
+
+            TEST_ASSERT(polyline.back() == p3, "Last point is not the curve end.");
+            TEST_ASSERT(max_distance(curve, polyline) <= tolerance, "Polyline is too far from the curve.");
+        }
+
+        Polygon coarse;
+        Polygon fine;
+        flatten_quadratic_bezier(p1, p2, p3, 1.0f, coarse);
+        flatten_quadratic_bezier(p1, p2, p3, 0.01f, fine);
+        TEST_ASSERT(coarse.size() < fine.size(), "Smaller tolerance doesn't add points.");
+
+        // The straight curve is one segment.
+        Polygon line;
+        flatten_quadratic_bezier(p1, Vector2f(40.0f, 40.0f), p3, 0.1f, line);
+        TEST_ASSERT(line.size() == 1 && line.back() == p3, "Straight curve is not one segment.");
+    }
+
+    void flatten_cubic_bezier_function()
+    {
+        using framework::math::cubic_bezier;
+        using framework::math::flatten_cubic_bezier;
+
+        const Vector2f p1{0.0f, 0.0f};
+        const Vector2f p2{0.0f, 80.0f};
+        const Vector2f p3{80.0f, 80.0f};
+        const Vector2f p4{80.0f, 0.0f};
+
+        // Loop shaped curve has both flat and tight parts.
+        const Vector2f q2{150.0f, 60.0f};
+        const Vector2f q3{-70.0f, 60.0f};
+
+        const auto curve      = [&](float t) { return cubic_bezier(p1, p2, p3, p4, t); };
+        const auto loop_curve = [&](float t) { return cubic_bezier(p1, q2, q3, p4, t); };
+
+        for (const float tolerance : {0.01f, 0.1f, 0.5f, 2.0f}) {
+            Polygon polyline = {p1};
+            flatten_cubic_bezier(p1, p2, p3, p4, tolerance, polyline);
+
+            TEST_ASSERT(polyline.back() == p4, "Last point is not the curve end.");
+            TEST_ASSERT(max_distance(curve, polyline) <= tolerance, "Polyline is too far from the curve.");
+
+            Polygon loop = {p1};
+            flatten_cubic_bezier(p1, q2, q3, p4, tolerance, loop);
+
+            TEST_ASSERT(max_distance(loop_curve, loop) <= tolerance, "Polyline is too far from the loop.");
+        }
+
+        Polygon line;
+        flatten_cubic_bezier(p1, Vector2f(20.0f, 0.0f), Vector2f(60.0f, 0.0f), p4, 0.1f, line);
+        TEST_ASSERT(line.size() == 1 && line.back() == p4, "Straight curve is not one segment.");
+    }
 };
 
 int main()
@@ -0,0 +1,354 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <common/thread_pool.hpp>
+#include <math/math.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::ThreadPool;
+using framework::math::Aabbf;
+using framework::math::Bvh;
+using framework::math::Frustumf;
+using framework::math::RayHit;
+using framework::math::Rayf;
+using framework::math::Vector3f;
+
+namespace
+{
+
+std::vector<Aabbf> make_boxes(std::size_t count, float offset = 0.0f)
+{
+    std::vector<Aabbf> boxes;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto value = static_cast<float>(i);
+
+        const Vector3f center(std::sin(value) * 50.0f + offset,
+                              std::cos(value * 0.7f) * 30.0f,
+                              std::sin(value * 1.3f) * 60.0f - 50.0f);
+        const Vector3f extent(0.5f + std::abs(std::sin(value * 2.1f)), 0.5f, 0.5f + std::abs(std::cos(value)));
+
+        boxes.emplace_back(center - extent, center + extent);
+    }
+
+    return boxes;
+}
+
+// Wavy surface of the triangles over the xz plane.
+void make_surface(std::size_t size, std::vector<Vector3f>& vertices, std::vector<std::uint32_t>& indices)
+{
+    for (std::size_t z = 0; z <= size; ++z) {
+        for (std::size_t x = 0; x <= size; ++x) {
+            const auto fx = static_cast<float>(x);
+            const auto fz = static_cast<float>(z);
+            vertices.emplace_back(fx, std::sin(fx * 0.3f) * std::cos(fz * 0.2f) * 3.0f, fz);
+        }
+    }
+
+    for (std::uint32_t z = 0; z < size; ++z) {
+        for (std::uint32_t x = 0; x < size; ++x) {
+            const auto row = static_cast<std::uint32_t>(size + 1);
+            const std::uint32_t i = z * row + x;
+
+            indices.insert(indices.end(), {i, i + 1, i + row, i + 1, i + row + 1, i + row});
+        }
+    }
+}
+
+std::vector<Rayf> make_rays(std::size_t count, float size)
+{
+    std::vector<Rayf> rays;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto value = static_cast<float>(i);
+
+        const Vector3f origin(std::abs(std::sin(value)) * size, 10.0f, std::abs(std::cos(value * 0.3f)) * size);
+        const Vector3f direction(std::sin(value * 1.7f) * 0.5f, -1.0f, std::cos(value * 2.3f) * 0.5f);
+
+        rays.emplace_back(origin, direction);
+    }
+
+    return rays;
+}
+
+bool is_valid(const Bvh& bvh, std::size_t primitives_count)
+{
+    const framework::Span<const Bvh::Node> nodes = bvh.nodes();
+
+    std::vector<std::uint32_t> primitives = bvh.primitives();
+    std::sort(primitives.begin(), primitives.end());
+
+    bool valid = primitives.size() == primitives_count;
+    for (std::size_t i = 0; i < primitives.size(); ++i) {
+        valid = valid && primitives[i] == i;
+    }
+
+    // Pairs of children are in one cache line.
+    valid = valid && reinterpret_cast<std::uintptr_t>(nodes.data()) % 64 == 0;
+
+    std::size_t leaf_primitives = 0;
+    for (std::size_t i = 0; i < nodes.size(); ++i) {
+        if (i == 1) {
+            continue;
+        }
+
+        const Bvh::Node& node = nodes[i];
+
+        if (node.count > 0) {
+            valid = valid && node.count <= Bvh::max_leaf_size;
+            leaf_primitives += node.count;
+            continue;
+        }
+
+        valid = valid && node.first % 2 == 0 && node.first > 1;
+
+        const Aabbf children = merge(nodes[node.first].bounds, nodes[node.first + 1].bounds);
+        valid = valid && children.min_point == node.bounds.min_point && children.max_point == node.bounds.max_point;
+    }
+
+    return valid && leaf_primitives == primitives_count;
+}
+
+std::vector<std::uint32_t> sorted(std::vector<std::uint32_t> values)
+{
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+} // namespace
+
+class BvhTypeTest : public framework::unit_test::Suite
+{
+public:
+    BvhTypeTest()
+        : Suite("BvhTypeTest")
+    {
+        add_test([this]() { empty_hierarchy(); }, "empty_hierarchy");
+        add_test([this]() { build_from_boxes(); }, "build_from_boxes");
+        add_test([this]() { box_and_frustum_queries(); }, "box_and_frustum_queries");
+        add_test([this]() { ray_queries(); }, "ray_queries");
+        add_test([this]() { parallel_build(); }, "parallel_build");
+        add_test([this]() { refit(); }, "refit");
+    }
+
+private:
+    void empty_hierarchy()
+    {
+        Bvh bvh;
+        bvh.build(std::vector<Aabbf>());
+
+        TEST_ASSERT(bvh.empty() && bvh.nodes().empty() && bvh.bounds().empty(), "Hierarchy expected to be empty.");
+
+        Bvh::Hit hit;
+        std::vector<std::uint32_t> result;
+        bvh.query(Aabbf(Vector3f(-1.0f), Vector3f(1.0f)), result);
+
+        TEST_ASSERT(!bvh.intersect(Rayf(), hit) && result.empty(), "Empty hierarchy has no primitives.");
+    }
+
+    void build_from_boxes()
+    {
+        for (const std::size_t size : {1, 2, 7, 100, 1000}) {
+            const std::vector<Aabbf> boxes = make_boxes(size);
+
+            Bvh bvh;
+            bvh.build(boxes);
+
+            TEST_ASSERT(is_valid(bvh, size), "Invalid hierarchy.");
+
+            Aabbf bounds;
+            for (const Aabbf& box : boxes) {
+                bounds = merge(bounds, box);
+            }
+
+            TEST_ASSERT(bvh.bounds().min_point == bounds.min_point && bvh.bounds().max_point == bounds.max_point,
+                        "Wrong hierarchy bounds.");
+        }
+
+        // Boxes at the same place can't be split by the surface area heuristic.
+        const std::vector<Aabbf> same(100, Aabbf(Vector3f(-1.0f), Vector3f(1.0f)));
+
+        Bvh bvh;
+        bvh.build(same);
+
+        TEST_ASSERT(is_valid(bvh, same.size()), "Invalid hierarchy of the same boxes.");
+    }
+
+    void box_and_frustum_queries()
+    {
+        const std::vector<Aabbf> boxes = make_boxes(2000);
+
+        Bvh bvh;
+        bvh.build(boxes);
+
+        const std::vector<Aabbf> regions = {Aabbf(Vector3f(-10.0f), Vector3f(10.0f)),
+                                            Aabbf(Vector3f(20.0f, -5.0f, -100.0f), Vector3f(60.0f, 5.0f, 0.0f)),
+                                            Aabbf(Vector3f(100.0f), Vector3f(200.0f))};
+
+        for (const Aabbf& region : regions) {
+            std::vector<std::uint32_t> expected;
+            for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+                if (overlaps(region, boxes[i])) {
+                    expected.push_back(i);
+                }
+            }
+
+            std::vector<std::uint32_t> result;
+            bvh.query(region, result);
+
+            TEST_ASSERT(sorted(result) == expected, "Box query failed.");
+        }
+
+        const Frustumf frustum(framework::math::perspective(1.0f, 1.5f, 1.0f, 100.0f));
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < boxes.size(); ++i) {
+            if (is_visible(frustum, boxes[i])) {
+                expected.push_back(i);
+            }
+        }
+
+        std::vector<std::uint32_t> result;
+        bvh.query(frustum, result);
+
+        TEST_ASSERT(!expected.empty() && sorted(result) == expected, "Frustum query failed.");
+    }
+
+    void ray_queries()
+    {
+        std::vector<Vector3f> vertices;
+        std::vector<std::uint32_t> indices;
+        make_surface(40, vertices, indices);
+
+        Bvh bvh;
+        bvh.build(vertices, indices);
+
+        TEST_ASSERT(is_valid(bvh, indices.size() / 3), "Invalid triangles hierarchy.");
+
+        std::size_t hits_count = 0;
+        bool same              = true;
+        for (const Rayf& ray : make_rays(300, 40.0f)) {
+            float closest          = std::numeric_limits<float>::infinity();
+            std::uint32_t expected = 0;
+
+            for (std::uint32_t i = 0; i < indices.size(); i += 3) {
+                RayHit<float> hit;
+                if (intersect(ray, vertices[indices[i]], vertices[indices[i + 1]], vertices[indices[i + 2]], hit) &&
+                    hit.distance < closest) {
+                    closest  = hit.distance;
+                    expected = i / 3;
+                }
+            }
+
+            Bvh::Hit hit;
+            const bool found = bvh.intersect(ray, hit);
+
+            same = same && found == (closest != std::numeric_limits<float>::infinity());
+            same = same && (!found || (hit.primitive == expected && hit.distance == closest));
+            hits_count += found ? 1 : 0;
+        }
+
+        TEST_ASSERT(same && hits_count > 0, "Ray query failed.");
+
+        Bvh::Hit hit;
+        const Rayf ray(Vector3f(10.5f, 10.0f, 10.5f), Vector3f(0.0f, -1.0f, 0.0f));
+        TEST_ASSERT(bvh.intersect(ray, hit) && !bvh.intersect(ray, hit, hit.distance * 0.5f),
+                    "Max distance of the ray query failed.");
+
+        // Hierarchy of boxes gives the closest box.
+        const std::vector<Aabbf> boxes = {Aabbf(Vector3f(-1.0f, -1.0f, -6.0f), Vector3f(1.0f, 1.0f, -4.0f)),
+                                          Aabbf(Vector3f(-1.0f, -1.0f, -3.0f), Vector3f(1.0f, 1.0f, -2.0f)),
+                                          Aabbf(Vector3f(2.0f, -1.0f, -3.0f), Vector3f(3.0f, 1.0f, -2.0f))};
+        bvh.build(boxes);
+
+        TEST_ASSERT(bvh.intersect(Rayf(), hit) && hit.primitive == 1 && hit.distance == 2.0f, "Box ray query failed.");
+
+        // Rays along the edges of the boxes, the zero direction components give NaN slab bounds.
+        TEST_ASSERT(bvh.intersect(Rayf(Vector3f(1.0f), Vector3f(0.0f, 0.0f, -1.0f)), hit) && hit.primitive == 1 &&
+                        hit.distance == 3.0f,
+                    "Ray along the max edge of the box failed.");
+        TEST_ASSERT(bvh.intersect(Rayf(Vector3f(2.0f, -1.0f, 0.0f), Vector3f(-0.0f, 0.0f, -1.0f)), hit) &&
+                        hit.primitive == 2 && hit.distance == 2.0f,
+                    "Ray along the min edge of the box failed.");
+    }
+
+    void parallel_build()
+    {
+        ThreadPool pool(4);
+
+        const std::vector<Aabbf> boxes = make_boxes(50000);
+
+        Bvh bvh;
+        bvh.build(boxes, &pool);
+
+        TEST_ASSERT(is_valid(bvh, boxes.size()), "Invalid hierarchy built in parallel.");
+
+        Bvh serial;
+        serial.build(boxes);
+
+        const Aabbf region(Vector3f(-20.0f), Vector3f(20.0f));
+
+        std::vector<std::uint32_t> result;
+        std::vector<std::uint32_t> expected;
+        bvh.query(region, result);
+        serial.query(region, expected);
+
+        TEST_ASSERT(sorted(result) == sorted(expected), "Query of parallel hierarchy failed.");
+    }
+
+    void refit()
+    {
+        const std::vector<Aabbf> boxes = make_boxes(1000);
+
+        Bvh bvh;
+        bvh.build(boxes);
+
+        const std::vector<Aabbf> moved = make_boxes(1000, 25.0f);
+        bvh.refit(moved);
+
+        TEST_ASSERT(is_valid(bvh, moved.size()), "Invalid refitted hierarchy.");
+
+        const Aabbf region(Vector3f(20.0f, -10.0f, -60.0f), Vector3f(40.0f, 10.0f, -20.0f));
+
+        std::vector<std::uint32_t> expected;
+        for (std::uint32_t i = 0; i < moved.size(); ++i) {
+            if (overlaps(region, moved[i])) {
+                expected.push_back(i);
+            }
+        }
+
+        std::vector<std::uint32_t> result;
+        bvh.query(region, result);
+
+        TEST_ASSERT(sorted(result) == expected, "Query of refitted hierarchy failed.");
+
+        // Triangles are refitted by the new vertices.
+        std::vector<Vector3f> vertices;
+        std::vector<std::uint32_t> indices;
+        make_surface(10, vertices, indices);
+
+        bvh.build(vertices, indices);
+        for (Vector3f& vertex : vertices) {
+            vertex.y += 5.0f;
+        }
+        bvh.refit(vertices, indices);
+
+        Bvh::Hit hit;
+        const Rayf ray(Vector3f(5.5f, 20.0f, 5.5f), Vector3f(0.0f, -1.0f, 0.0f));
+
+        Bvh rebuilt;
+        rebuilt.build(vertices, indices);
+
+        Bvh::Hit expected_hit;
+        TEST_ASSERT(bvh.intersect(ray, hit) && rebuilt.intersect(ray, expected_hit) &&
+                        hit.primitive == expected_hit.primitive && hit.distance == expected_hit.distance,
+                    "Ray query of refitted triangles failed.");
+    }
+};
+
+int main()
+{
+    return run_tests(BvhTypeTest());
+}
@@ -0,0 +1,314 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include <math/math.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::math::Vector4f;
+
+namespace fast = framework::math::fast;
+
+namespace
+{
+
+constexpr int samples_count = 100000;
+
+// Error of the float value in units in the last place of the exact result.
+double ulp_error(float value, double expected)
+{
+    int exponent = 0;
+    std::frexp(expected, &exponent);
+
+    const double ulp = std::ldexp(1.0, std::max(exponent - 24, -149));
+    return std::abs(static_cast<double>(value) - expected) / ulp;
+}
+
+// Maximum error of the function on the evenly spaced values of the range.
+double max_error(double from,
+                 double to,
+                 const std::function<float(float)>& function,
+                 const std::function<double(double)>& expected)
+{
+    double error = 0.0;
+    for (int i = 0; i <= samples_count; ++i) {
+        const auto value = static_cast<float>(from + (to - from) * i / samples_count);
+        error            = std::max(error, ulp_error(function(value), expected(value)));
+    }
+
+    return error;
+}
+
+// Maximum error of the function on the logarithmically spaced values of the positive range.
+double max_log_error(double from,
+                     double to,
+                     const std::function<float(float)>& function,
+                     const std::function<double(double)>& expected)
+{
+    double error = 0.0;
+    for (int i = 0; i <= samples_count; ++i) {
+        const auto value = static_cast<float>(from * std::pow(to / from, static_cast<double>(i) / samples_count));
+        error            = std::max(error, ulp_error(function(value), expected(value)));
+    }
+
+    return error;
+}
+
+std::vector<float> make_values(std::size_t count, float from, float to)
+{
+    std::vector<float> values;
+    for (std::size_t i = 0; i < count; ++i) {
+        values.push_back(from + (to - from) * static_cast<float>(i) / static_cast<float>(count));
+    }
+
+    return values;
+}
+
+// Sizes to check both SIMD and scalar parts of the loops.
+const std::vector<std::size_t> sizes = {0, 1, 3, 4, 5, 8, 1001};
+
+bool is_close(float a, float b)
+{
+    return ulp_error(a, b) <= 1.0;
+}
+
+} // namespace
+
+class FastFunctionsAccuracyTest : public framework::unit_test::Suite
+{
+public:
+    FastFunctionsAccuracyTest()
+        : Suite("FastFunctionsAccuracyTest")
+    {
+        add_test([this]() { sin_cos_functions(); }, "sin_cos_functions");
+        add_test([this]() { exp2_function(); }, "exp2_function");
+        add_test([this]() { log2_function(); }, "log2_function");
+        add_test([this]() { pow_function(); }, "pow_function");
+        add_test([this]() { rsqrt_function(); }, "rsqrt_function");
+        add_test([this]() { atan2_function(); }, "atan2_function");
+        add_test([this]() { vector_functions(); }, "vector_functions");
+    }
+
+private:
+    void sin_cos_functions()
+    {
+        // Results near zero are compared by the absolute error.
+        const auto sin_error = [](double from, double to) {
+            double error = 0.0;
+            for (int i = 0; i <= samples_count; ++i) {
+                const auto value    = static_cast<float>(from + (to - from) * i / samples_count);
+                const double sin    = std::sin(static_cast<double>(value));
+                const double cos    = std::cos(static_cast<double>(value));
+                const auto absolute = [](float v, double e) { return std::abs(v - e) * std::ldexp(1.0, 23); };
+
+                error = std::max(error, std::abs(sin) < 0.25 ? absolute(fast::sin(value), sin)
+                                                               : ulp_error(fast::sin(value), sin) / 2.0);
+                error = std::max(error, std::abs(cos) < 0.25 ? absolute(fast::cos(value), cos)
+                                                               : ulp_error(fast::cos(value), cos) / 2.0);
+            }
+            return error;
+        };
+
+        TEST_ASSERT(sin_error(-4.0, 4.0) <= 1.0, "Sine or cosine error is too big.");
+        TEST_ASSERT(sin_error(-8192.0, 8192.0) <= 1.0, "Sine or cosine error for big angles is too big.");
+
+        float s = 0.0f;
+        float c = 0.0f;
+        fast::sincos(0.0f, s, c);
+        TEST_ASSERT(s == 0.0f && c == 1.0f, "Sincos of zero is wrong.");
+    }
+
+    void exp2_function()
+    {
+        const auto exp2     = [](float v) { return fast::exp2(v); };
+        const auto std_exp2 = [](double v) { return std::exp2(v); };
+
+        TEST_ASSERT(max_error(-10.0, 10.0, exp2, std_exp2) <= 2.0, "Exp2 error is too big.");
+        TEST_ASSERT(max_error(-126.0, 127.99, exp2, std_exp2) <= 2.0, "Exp2 error for the full range is too big.");
+
+        TEST_ASSERT(fast::exp2(0.0f) == 1.0f, "Exp2 of zero is not one.");
+        TEST_ASSERT(fast::exp2(10.0f) == 1024.0f, "Exp2 of integer is not exact.");
+        TEST_ASSERT(std::isinf(fast::exp2(129.0f)), "Exp2 doesn't overflow.");
+        TEST_ASSERT(fast::exp2(-200.0f) == 0.0f, "Exp2 doesn't underflow.");
+        TEST_ASSERT(fast::exp2(-140.0f) == std::exp2(-140.0f), "Exp2 doesn't give subnormal result.");
+    }
+
+    void log2_function()
+    {
+        const auto log2     = [](float v) { return fast::log2(v); };
+        const auto std_log2 = [](double v) { return std::log2(v); };
+
+        TEST_ASSERT(max_error(0.5, 2.0, log2, std_log2) <= 4.0, "Log2 error near one is too big.");
+        TEST_ASSERT(max_log_error(1e-30, 1e30, log2, std_log2) <= 4.0, "Log2 error is too big.");
+
+        TEST_ASSERT(fast::log2(1.0f) == 0.0f, "Log2 of one is not zero.");
+        TEST_ASSERT(fast::log2(1024.0f) == 10.0f, "Log2 of power of two is not exact.");
+    }
+
+    void pow_function()
+    {
+        for (const float base : {0.01f, 0.5f, 0.9f, 1.1f, 2.0f, 10.0f, 1000.0f}) {
+            for (int i = 0; i <= samples_count / 10; ++i) {
+                const float power     = -8.0f + 16.0f * static_cast<float>(i) / (samples_count / 10);
+                const double expected = std::pow(static_cast<double>(base), static_cast<double>(power));
+                const double bound    = 3.0 + 2.0 * std::abs(std::log2(expected));
+
+                TEST_ASSERT(ulp_error(fast::pow(base, power), expected) <= bound, "Pow error is too big.");
+            }
+        }
+    }
+
+    void rsqrt_function()
+    {
+        const auto rsqrt     = [](float v) { return fast::rsqrt(v); };
+        const auto std_rsqrt = [](double v) { return 1.0 / std::sqrt(v); };
+
+        TEST_ASSERT(max_error(0.01, 100.0, rsqrt, std_rsqrt) <= 4.0, "Rsqrt error is too big.");
+        TEST_ASSERT(max_log_error(1e-30, 1e30, rsqrt, std_rsqrt) <= 4.0, "Rsqrt error for the full range is too big.");
+    }
+
+    void atan2_function()
+    {
+        for (const float y : {-100.0f, -1.0f, -0.001f, 0.0f, 0.001f, 1.0f, 3.0f}) {
+            const auto atan2     = [y](float x) { return fast::atan2(y, x); };
+            const auto std_atan2 = [y](double x) { return std::atan2(static_cast<double>(y), x); };
+
+            TEST_ASSERT(max_error(-100.0, 100.0, atan2, std_atan2) <= 4.0, "Atan2 error is too big.");
+        }
+
+        for (const float x : {-2.0f, -0.5f, 0.5f, 2.0f}) {
+            const auto atan2     = [x](float y) { return fast::atan2(y, x); };
+            const auto std_atan2 = [x](double y) { return std::atan2(y, static_cast<double>(x)); };
+
+            TEST_ASSERT(max_error(-100.0, 100.0, atan2, std_atan2) <= 4.0, "Atan2 error is too big.");
+        }
+
+        TEST_ASSERT(fast::atan2(0.0f, 0.0f) == std::atan2(0.0f, 0.0f), "Atan2 of zeros is wrong.");
+        TEST_ASSERT(fast::atan2(0.0f, -0.0f) == std::atan2(0.0f, -0.0f), "Atan2 of zeros is wrong.");
+        TEST_ASSERT(fast::atan2(-0.0f, -1.0f) == std::atan2(-0.0f, -1.0f), "Atan2 of negative zero is wrong.");
+    }
+
+    void vector_functions()
+    {
+        const Vector4f v(0.5f, 1.0f, 2.0f, 3.0f);
+        const Vector4f p(2.0f, -1.0f, 0.5f, 3.0f);
+
+        const Vector4f sin   = fast::sin(v);
+        const Vector4f pow   = fast::pow(v, p);
+        const Vector4f atan2 = fast::atan2(v, p);
+
+        for (std::size_t i = 0; i < 4; ++i) {
+            TEST_ASSERT(sin[i] == fast::sin(v[i]), "Vector sin is wrong.");
+            TEST_ASSERT(fast::cos(v)[i] == fast::cos(v[i]), "Vector cos is wrong.");
+            TEST_ASSERT(fast::exp2(v)[i] == fast::exp2(v[i]), "Vector exp2 is wrong.");
+            TEST_ASSERT(fast::log2(v)[i] == fast::log2(v[i]), "Vector log2 is wrong.");
+            TEST_ASSERT(fast::rsqrt(v)[i] == fast::rsqrt(v[i]), "Vector rsqrt is wrong.");
+            TEST_ASSERT(pow[i] == fast::pow(v[i], p[i]), "Vector pow is wrong.");
+            TEST_ASSERT(atan2[i] == fast::atan2(v[i], p[i]), "Vector atan2 is wrong.");
+        }
+    }
+};
+
+class FastFunctionsBatchTest : public framework::unit_test::Suite
+{
+public:
+    FastFunctionsBatchTest()
+        : Suite("FastFunctionsBatchTest")
+    {
+        add_test([this]() { single_argument_functions(); }, "single_argument_functions");
+        add_test([this]() { sincos_function(); }, "sincos_function");
+        add_test([this]() { two_arguments_functions(); }, "two_arguments_functions");
+        add_test([this]() { in_place(); }, "in_place");
+    }
+
+private:
+    void single_argument_functions()
+    {
+        using BatchFunction  = void (*)(framework::Span<const float>, framework::Span<float>);
+        using ScalarFunction = float (*)(float);
+
+        const std::vector<std::pair<BatchFunction, ScalarFunction>> functions = {
+            {fast::sin, fast::sin},
+            {fast::cos, fast::cos},
+            {fast::exp2, fast::exp2},
+            {fast::log2, fast::log2},
+            {fast::rsqrt, fast::rsqrt},
+        };
+
+        for (const auto& [batch, scalar] : functions) {
+            for (const std::size_t size : sizes) {
+                const std::vector<float> values = make_values(size, 0.01f, 20.0f);
+                std::vector<float> result(size);
+
+                batch(values, result);
+
+                for (std::size_t i = 0; i < size; ++i) {
+                    TEST_ASSERT(is_close(result[i], scalar(values[i])), "Batch function differs from scalar one.");
+                }
+            }
+        }
+    }
+
+    void sincos_function()
+    {
+        for (const std::size_t size : sizes) {
+            const std::vector<float> values = make_values(size, -100.0f, 100.0f);
+            std::vector<float> sin(size);
+            std::vector<float> cos(size);
+
+            fast::sincos(values, sin, cos);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                TEST_ASSERT(is_close(sin[i], fast::sin(values[i])), "Batch sin differs from scalar one.");
+                TEST_ASSERT(is_close(cos[i], fast::cos(values[i])), "Batch cos differs from scalar one.");
+            }
+        }
+    }
+
+    void two_arguments_functions()
+    {
+        for (const std::size_t size : sizes) {
+            const std::vector<float> a = make_values(size, 0.1f, 10.0f);
+            const std::vector<float> b = make_values(size, -5.0f, 5.0f);
+            std::vector<float> pow(size);
+            std::vector<float> atan2(size);
+
+            fast::pow(a, b, pow);
+            fast::atan2(b, a, atan2);
+
+            for (std::size_t i = 0; i < size; ++i) {
+                TEST_ASSERT(is_close(pow[i], fast::pow(a[i], b[i])), "Batch pow differs from scalar one.");
+                TEST_ASSERT(is_close(atan2[i], fast::atan2(b[i], a[i])), "Batch atan2 differs from scalar one.");
+            }
+        }
+
+        // Negative x and zeros select the quadrants in the SIMD code.
+        const std::vector<float> y = {0.0f, -0.0f, 1.0f, -1.0f, 0.0f, 2.0f, -3.0f, 0.5f};
+        const std::vector<float> x = {0.0f, -1.0f, -1.0f, -1.0f, -0.0f, -0.1f, -4.0f, 0.0f};
+        std::vector<float> result(y.size());
+
+        fast::atan2(y, x, result);
+        for (std::size_t i = 0; i < y.size(); ++i) {
+            TEST_ASSERT(is_close(result[i], fast::atan2(y[i], x[i])), "Batch atan2 differs from scalar one.");
+        }
+    }
+
+    void in_place()
+    {
+        std::vector<float> values       = make_values(1001, -10.0f, 10.0f);
+        const std::vector<float> source = values;
+
+        fast::exp2(values, values);
+
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            TEST_ASSERT(is_close(values[i], fast::exp2(source[i])), "In place exp2 failed.");
+        }
+    }
+};
+
+int main()
+{
+    return run_tests(FastFunctionsAccuracyTest(), FastFunctionsBatchTest());
+}
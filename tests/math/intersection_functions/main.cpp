@@ -0,0 +1,401 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <math/math.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::math::Aabbf;
+using framework::math::Frustumf;
+using framework::math::Matrix4f;
+using framework::math::Planef;
+using framework::math::RayHit;
+using framework::math::RayPacket;
+using framework::math::Rayf;
+using framework::math::Spheref;
+using framework::math::Vector3f;
+
+namespace
+{
+
+// Sizes to check both SIMD and scalar parts of the loops.
+const std::vector<std::size_t> sizes = {0, 1, 3, 4, 5, 8, 1001};
+
+const float infinity = std::numeric_limits<float>::infinity();
+
+bool is_close(float a, float b)
+{
+    return std::abs(a - b) <= 1e-5f * std::max(1.0f, std::abs(b));
+}
+
+bool is_close(const Vector3f& a, const Vector3f& b)
+{
+    return is_close(a.x, b.x) && is_close(a.y, b.y) && is_close(a.z, b.z);
+}
+
+Vector3f make_point(std::size_t index)
+{
+    const auto value = static_cast<float>(index);
+    return Vector3f(std::sin(value) * 30.0f, std::cos(value * 0.7f) * 20.0f, std::sin(value * 1.3f) * 60.0f - 50.0f);
+}
+
+struct SoaBoxes
+{
+    explicit SoaBoxes(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i) {
+            const Vector3f center = make_point(i);
+            const Vector3f extent = Vector3f(1.0f) + abs(make_point(i + 7)) * 0.05f;
+
+            boxes.emplace_back(center - extent, center + extent);
+            min_x.push_back(boxes.back().min_point.x);
+            min_y.push_back(boxes.back().min_point.y);
+            min_z.push_back(boxes.back().min_point.z);
+            max_x.push_back(boxes.back().max_point.x);
+            max_y.push_back(boxes.back().max_point.y);
+            max_z.push_back(boxes.back().max_point.z);
+        }
+    }
+
+    framework::math::AabbSpan<const float> span() const
+    {
+        return {{min_x, min_y, min_z}, {max_x, max_y, max_z}};
+    }
+
+    std::vector<Aabbf> boxes;
+    std::vector<float> min_x;
+    std::vector<float> min_y;
+    std::vector<float> min_z;
+    std::vector<float> max_x;
+    std::vector<float> max_y;
+    std::vector<float> max_z;
+};
+
+const Frustumf frustum(framework::math::perspective(1.0f, 1.5f, 1.0f, 100.0f));
+
+} // namespace
+
+class IntersectionFunctionsTest : public framework::unit_test::Suite
+{
+public:
+    IntersectionFunctionsTest()
+        : Suite("IntersectionFunctionsTest")
+    {
+        add_test([this]() { aabb_functions(); }, "aabb_functions");
+        add_test([this]() { aabb_transform(); }, "aabb_transform");
+        add_test([this]() { frustum_planes(); }, "frustum_planes");
+        add_test([this]() { frustum_visibility(); }, "frustum_visibility");
+        add_test([this]() { ray_intersections(); }, "ray_intersections");
+        add_test([this]() { ray_triangle_intersection(); }, "ray_triangle_intersection");
+        add_test([this]() { batch_frustum_visibility(); }, "batch_frustum_visibility");
+        add_test([this]() { batch_aabb_functions(); }, "batch_aabb_functions");
+        add_test([this]() { ray_packet_intersection(); }, "ray_packet_intersection");
+    }
+
+private:
+    void aabb_functions()
+    {
+        const Aabbf empty;
+        TEST_ASSERT(empty.empty(), "Default box is not empty.");
+
+        const Aabbf point = merge(empty, Vector3f(1.0f, 2.0f, 3.0f));
+        TEST_ASSERT(!point.empty(), "Box of point is empty.");
+        TEST_ASSERT(point.min_point == Vector3f(1.0f, 2.0f, 3.0f) && point.max_point == point.min_point,
+                    "Merge with point failed.");
+
+        const Aabbf a(Vector3f(0.0f), Vector3f(2.0f));
+        const Aabbf b(Vector3f(1.0f, -1.0f, 1.0f), Vector3f(3.0f, 1.0f, 1.5f));
+        const Aabbf c(Vector3f(2.0f, 0.0f, 0.0f), Vector3f(4.0f));
+        const Aabbf d(Vector3f(2.5f, 0.0f, 0.0f), Vector3f(4.0f));
+
+        const Aabbf ab = merge(a, b);
+        TEST_ASSERT(ab.min_point == Vector3f(0.0f, -1.0f, 0.0f) && ab.max_point == Vector3f(3.0f, 2.0f, 2.0f),
+                    "Merge of boxes failed.");
+        TEST_ASSERT(ab.center() == Vector3f(1.5f, 0.5f, 1.0f), "Center of box failed.");
+        TEST_ASSERT(ab.size() == Vector3f(3.0f, 3.0f, 2.0f), "Size of box failed.");
+        TEST_ASSERT(merge(a, empty).min_point == a.min_point && merge(a, empty).max_point == a.max_point,
+                    "Merge with empty box failed.");
+
+        TEST_ASSERT(overlaps(a, b) && overlaps(b, a), "Overlapping boxes expected.");
+        TEST_ASSERT(overlaps(a, c), "Touching boxes expected to overlap.");
+        TEST_ASSERT(!overlaps(a, d) && !overlaps(d, a), "Separate boxes expected.");
+        TEST_ASSERT(!overlaps(a, empty), "Empty box expected to overlap nothing.");
+
+        TEST_ASSERT(contains(a, Vector3f(1.0f)), "Point inside the box expected.");
+        TEST_ASSERT(contains(a, Vector3f(2.0f, 0.0f, 1.0f)), "Point on the face expected to be inside.");
+        TEST_ASSERT(!contains(a, Vector3f(1.0f, 2.5f, 1.0f)), "Point outside the box expected.");
+    }
+
+    void aabb_transform()
+    {
+        const Aabbf box(Vector3f(-1.0f, -2.0f, -3.0f), Vector3f(1.0f, 2.0f, 3.0f));
+
+        const Matrix4f m = rotate(translate(Matrix4f(), Vector3f(10.0f, 0.0f, 0.0f)),
+                                  Vector3f(0.0f, 0.0f, 1.0f),
+                                  framework::math::half_pi<float>);
+
+        const Aabbf result = transform(m, box);
+        TEST_ASSERT(is_close(result.min_point, Vector3f(8.0f, -1.0f, -3.0f)), "Transformed box min failed.");
+        TEST_ASSERT(is_close(result.max_point, Vector3f(12.0f, 1.0f, 3.0f)), "Transformed box max failed.");
+
+        // Transformed box should contain all transformed corners.
+        const Matrix4f skew = rotate(Matrix4f(), normalize(Vector3f(1.0f, 2.0f, 3.0f)), 0.7f);
+        const Aabbf skewed  = transform(skew, box);
+
+        bool contains_corners = true;
+        for (std::size_t i = 0; i < 8; ++i) {
+            const Vector3f corner((i & 1) ? box.max_point.x : box.min_point.x,
+                                  (i & 2) ? box.max_point.y : box.min_point.y,
+                                  (i & 4) ? box.max_point.z : box.min_point.z);
+
+            const Vector3f point(skew * framework::math::Vector4f(corner, 1.0f));
+            contains_corners = contains_corners && contains(skewed, point * 0.9999f);
+        }
+
+        TEST_ASSERT(contains_corners, "Transformed box should contain transformed corners.");
+    }
+
+    void frustum_planes()
+    {
+        const Frustumf cube;
+
+        TEST_ASSERT(is_close(signed_distance(cube.planes[Frustumf::left_plane], Vector3f(0.0f)), 1.0f),
+                    "Left plane failed.");
+        TEST_ASSERT(is_close(signed_distance(cube.planes[Frustumf::near_plane], Vector3f(0.0f, 0.0f, -1.0f)), 0.0f),
+                    "Near plane failed.");
+        TEST_ASSERT(is_close(signed_distance(cube.planes[Frustumf::far_plane], Vector3f(0.0f, 0.0f, -1.0f)), 2.0f),
+                    "Far plane failed.");
+
+        bool normalized = true;
+        for (const Planef& plane : frustum.planes) {
+            normalized = normalized && is_close(length(plane.normal), 1.0f);
+        }
+
+        TEST_ASSERT(normalized, "Planes are not normalized.");
+
+        // The camera looks along the negative z axis.
+        TEST_ASSERT(is_close(signed_distance(frustum.planes[Frustumf::near_plane], Vector3f(0.0f, 0.0f, -1.0f)), 0.0f),
+                    "Perspective near plane failed.");
+
+        // The far plane is the difference of close rows, so it's less precise.
+        const float far_distance = signed_distance(frustum.planes[Frustumf::far_plane], Vector3f(0.0f, 0.0f, -99.0f));
+        TEST_ASSERT(std::abs(far_distance - 1.0f) < 1e-3f, "Perspective far plane failed.");
+
+        const Planef plane(Vector3f(0.0f, 1.0f, 0.0f), Vector3f(5.0f, 2.0f, -3.0f));
+        TEST_ASSERT(is_close(signed_distance(plane, Vector3f(1.0f, 5.0f, 1.0f)), 3.0f), "Plane from point failed.");
+    }
+
+    void frustum_visibility()
+    {
+        TEST_ASSERT(is_visible(frustum, Spheref(Vector3f(0.0f, 0.0f, -10.0f), 1.0f)), "Sphere in front expected.");
+        TEST_ASSERT(!is_visible(frustum, Spheref(Vector3f(0.0f, 0.0f, 10.0f), 1.0f)), "Sphere behind expected.");
+        TEST_ASSERT(!is_visible(frustum, Spheref(Vector3f(0.0f, 0.0f, -0.5f), 0.1f)), "Sphere before near plane.");
+        TEST_ASSERT(is_visible(frustum, Spheref(Vector3f(0.0f, 0.0f, -0.5f), 1.0f)), "Sphere crossing near plane.");
+        TEST_ASSERT(!is_visible(frustum, Spheref(Vector3f(0.0f, 0.0f, -102.0f), 1.0f)), "Sphere after far plane.");
+        TEST_ASSERT(!is_visible(frustum, Spheref(Vector3f(50.0f, 0.0f, -10.0f), 1.0f)), "Sphere to the right.");
+
+        TEST_ASSERT(is_visible(frustum, Aabbf(Vector3f(-1.0f, -1.0f, -11.0f), Vector3f(1.0f, 1.0f, -9.0f))),
+                    "Box in front expected.");
+        TEST_ASSERT(is_visible(frustum, Aabbf(Vector3f(-100.0f, -100.0f, -50.0f), Vector3f(100.0f, 100.0f, -40.0f))),
+                    "Box around the frustum expected.");
+        TEST_ASSERT(!is_visible(frustum, Aabbf(Vector3f(-1.0f, -1.0f, 9.0f), Vector3f(1.0f, 1.0f, 11.0f))),
+                    "Box behind expected.");
+        TEST_ASSERT(!is_visible(frustum, Aabbf(Vector3f(-1.0f, 20.0f, -11.0f), Vector3f(1.0f, 22.0f, -9.0f))),
+                    "Box above expected.");
+    }
+
+    void ray_intersections()
+    {
+        const Rayf ray(Vector3f(0.0f, 0.0f, 5.0f), Vector3f(0.0f, 0.0f, -2.0f));
+
+        float distance = -1.0f;
+        TEST_ASSERT(intersect(ray, Aabbf(Vector3f(-1.0f), Vector3f(1.0f)), distance) && is_close(distance, 2.0f),
+                    "Ray and box intersection failed.");
+        TEST_ASSERT(!intersect(ray, Aabbf(Vector3f(1.5f, -1.0f, -1.0f), Vector3f(3.0f, 1.0f, 1.0f)), distance),
+                    "Ray should miss the box.");
+        TEST_ASSERT(!intersect(ray, Aabbf(Vector3f(-1.0f, -1.0f, 6.0f), Vector3f(1.0f, 1.0f, 7.0f)), distance),
+                    "Box behind the ray should be missed.");
+        TEST_ASSERT(intersect(ray, Aabbf(Vector3f(-1.0f), Vector3f(6.0f)), distance) && distance == 0.0f,
+                    "Ray inside the box failed.");
+
+        // Rays lying in the faces of the box, the zero direction components give NaN slab bounds.
+        TEST_ASSERT(intersect(ray, Aabbf(Vector3f(0.0f, -1.0f, -1.0f), Vector3f(1.0f)), distance) &&
+                        is_close(distance, 2.0f),
+                    "Ray in the min face of the box failed.");
+        TEST_ASSERT(intersect(ray, Aabbf(Vector3f(-1.0f), Vector3f(0.0f, 0.0f, 1.0f)), distance) &&
+                        is_close(distance, 2.0f),
+                    "Ray in the max face of the box failed.");
+        TEST_ASSERT(intersect(Rayf(ray.origin, Vector3f(-0.0f, 0.0f, -1.0f)),
+                              Aabbf(Vector3f(0.0f, 0.0f, -1.0f), Vector3f(0.0f, 1.0f, 1.0f)),
+                              distance) &&
+                        is_close(distance, 4.0f),
+                    "Ray in the flat box failed.");
+        TEST_ASSERT(!intersect(ray, Aabbf(Vector3f(0.0f, 0.5f, -1.0f), Vector3f(1.0f)), distance),
+                    "Ray parallel to the box faces should miss it.");
+
+        TEST_ASSERT(intersect(ray, Spheref(Vector3f(0.0f, 0.5f, 0.0f), 1.0f), distance) &&
+                        is_close(distance, (5.0f - std::sqrt(0.75f)) / 2.0f),
+                    "Ray and sphere intersection failed.");
+        TEST_ASSERT(!intersect(ray, Spheref(Vector3f(0.0f, 2.0f, 0.0f), 1.0f), distance), "Ray should miss sphere.");
+        TEST_ASSERT(!intersect(ray, Spheref(Vector3f(0.0f, 0.0f, 10.0f), 1.0f), distance),
+                    "Sphere behind the ray should be missed.");
+        TEST_ASSERT(intersect(ray, Spheref(Vector3f(0.0f, 0.0f, 4.0f), 2.0f), distance) && distance == 0.0f,
+                    "Ray inside the sphere failed.");
+
+        const Planef plane(Vector3f(0.0f, 0.0f, 1.0f), Vector3f(0.0f, 0.0f, -1.0f));
+        TEST_ASSERT(intersect(ray, plane, distance) && is_close(distance, 3.0f), "Ray and plane intersection failed.");
+        TEST_ASSERT(!intersect(Rayf(ray.origin, Vector3f(1.0f, 0.0f, 0.0f)), plane, distance),
+                    "Parallel ray should miss the plane.");
+        TEST_ASSERT(!intersect(Rayf(ray.origin, -ray.direction), plane, distance), "Plane behind should be missed.");
+    }
+
+    void ray_triangle_intersection()
+    {
+        const Vector3f v1(0.0f, 0.0f, 0.0f);
+        const Vector3f v2(4.0f, 0.0f, 0.0f);
+        const Vector3f v3(0.0f, 4.0f, 0.0f);
+
+        RayHit<float> hit;
+        TEST_ASSERT(intersect(Rayf(Vector3f(1.0f, 2.0f, 3.0f), Vector3f(0.0f, 0.0f, -1.0f)), v1, v2, v3, hit),
+                    "Ray should hit the triangle.");
+        TEST_ASSERT(is_close(hit.distance, 3.0f) && is_close(hit.u, 0.25f) && is_close(hit.v, 0.5f),
+                    "Wrong triangle hit.");
+
+        TEST_ASSERT(intersect(Rayf(Vector3f(1.0f, 1.0f, -3.0f), Vector3f(0.0f, 0.0f, 1.0f)), v1, v2, v3, hit),
+                    "Ray should hit the back side of the triangle.");
+        TEST_ASSERT(!intersect(Rayf(Vector3f(3.0f, 3.0f, 3.0f), Vector3f(0.0f, 0.0f, -1.0f)), v1, v2, v3, hit),
+                    "Ray should miss the triangle.");
+        TEST_ASSERT(!intersect(Rayf(Vector3f(1.0f, 1.0f, 3.0f), Vector3f(0.0f, 0.0f, 1.0f)), v1, v2, v3, hit),
+                    "Triangle behind the ray should be missed.");
+        TEST_ASSERT(!intersect(Rayf(Vector3f(-1.0f, 1.0f, 0.0f), Vector3f(1.0f, 0.0f, 0.0f)), v1, v2, v3, hit),
+                    "Ray in the triangle plane should miss it.");
+    }
+
+    void batch_frustum_visibility()
+    {
+        for (const std::size_t size : sizes) {
+            const SoaBoxes soa(size);
+
+            std::vector<std::uint8_t> result(size, 2);
+            is_visible(frustum, soa.span(), result);
+
+            std::vector<float> radii;
+            for (std::size_t i = 0; i < size; ++i) {
+                radii.push_back(soa.boxes[i].size().x);
+            }
+
+            std::vector<std::uint8_t> sphere_result(size, 2);
+            is_visible(frustum, soa.span().min_points, radii, sphere_result);
+
+            bool same = true;
+            for (std::size_t i = 0; i < size; ++i) {
+                const Spheref sphere(soa.boxes[i].min_point, radii[i]);
+
+                same = same && result[i] == (is_visible(frustum, soa.boxes[i]) ? 1 : 0);
+                same = same && sphere_result[i] == (is_visible(frustum, sphere) ? 1 : 0);
+            }
+
+            TEST_ASSERT(same, "Batch frustum visibility failed.");
+        }
+    }
+
+    void batch_aabb_functions()
+    {
+        const Aabbf box(Vector3f(-10.0f, -5.0f, -40.0f), Vector3f(10.0f, 5.0f, -20.0f));
+
+        for (const std::size_t size : sizes) {
+            const SoaBoxes soa(size);
+
+            std::vector<std::uint8_t> result(size, 2);
+            overlaps(box, soa.span(), result);
+
+            Aabbf expected;
+            bool same = true;
+            for (std::size_t i = 0; i < size; ++i) {
+                same     = same && result[i] == (overlaps(box, soa.boxes[i]) ? 1 : 0);
+                expected = merge(expected, soa.boxes[i]);
+            }
+
+            TEST_ASSERT(same, "Batch overlaps failed.");
+
+            const Aabbf merged = merge(soa.span());
+            TEST_ASSERT(merged.min_point == expected.min_point && merged.max_point == expected.max_point,
+                        "Batch merge failed.");
+        }
+    }
+
+    template <std::size_t N>
+    void check_ray_packet()
+    {
+        const std::array<Vector3f, 9> vertices = {Vector3f(-2.0f, -2.0f, -5.0f),
+                                                  Vector3f(2.0f, -2.0f, -5.0f),
+                                                  Vector3f(0.0f, 2.0f, -5.0f),
+                                                  Vector3f(-1.0f, -1.0f, -3.0f),
+                                                  Vector3f(1.0f, -1.0f, -4.0f),
+                                                  Vector3f(0.0f, 1.0f, -3.5f),
+                                                  Vector3f(-0.5f, -0.5f, -2.0f),
+                                                  Vector3f(0.5f, -0.5f, -2.0f),
+                                                  Vector3f(0.0f, 0.5f, 2.0f)};
+
+        for (std::size_t packet_index = 0; packet_index < 16; ++packet_index) {
+            RayPacket<N> packet;
+            std::array<Rayf, N> rays;
+
+            for (std::size_t i = 0; i < N; ++i) {
+                const auto value = static_cast<float>(packet_index * N + i);
+
+                rays[i] = Rayf(Vector3f(std::sin(value) * 0.3f, std::cos(value) * 0.3f, 0.0f),
+                               Vector3f(std::sin(value * 1.7f) * 0.4f, std::cos(value * 2.3f) * 0.4f, -1.0f));
+
+                packet.origin_x[i]    = rays[i].origin.x;
+                packet.origin_y[i]    = rays[i].origin.y;
+                packet.origin_z[i]    = rays[i].origin.z;
+                packet.direction_x[i] = rays[i].direction.x;
+                packet.direction_y[i] = rays[i].direction.y;
+                packet.direction_z[i] = rays[i].direction.z;
+            }
+
+            std::array<float, N> distances;
+            std::array<float, N> expected;
+            distances.fill(infinity);
+            expected.fill(infinity);
+
+            bool same = true;
+            for (std::size_t t = 0; t < vertices.size(); t += 3) {
+                const std::uint32_t mask = intersect(packet, vertices[t], vertices[t + 1], vertices[t + 2], distances);
+
+                std::uint32_t expected_mask = 0;
+                for (std::size_t i = 0; i < N; ++i) {
+                    RayHit<float> hit;
+                    if (intersect(rays[i], vertices[t], vertices[t + 1], vertices[t + 2], hit) &&
+                        hit.distance < expected[i]) {
+                        expected[i] = hit.distance;
+                        expected_mask |= std::uint32_t{1} << i;
+                    }
+                }
+
+                same = same && mask == expected_mask;
+            }
+
+            for (std::size_t i = 0; i < N; ++i) {
+                same = same && (distances[i] == expected[i] || is_close(distances[i], expected[i]));
+            }
+
+            TEST_ASSERT(same, "Ray packet intersection failed.");
+        }
+    }
+
+    void ray_packet_intersection()
+    {
+        check_ray_packet<4>();
+        check_ray_packet<8>();
+    }
+};
+
+int main()
+{
+    return run_tests(IntersectionFunctionsTest());
+}
@@ -1,3 +1,7 @@
+#include <cstdint>
+#include <set>
+#include <vector>
+
 #include <math/math.hpp>
 #include <unit_test/suite.hpp>
 
@@ -9,6 +13,8 @@ public:
     {
         add_test([this]() { vector_hash_function(); }, "vector_hash_function");
         add_test([this]() { matrix_hash_function(); }, "matrix_hash_function");
+        add_test([this]() { bytes_hash_function(); }, "bytes_hash_function");
+        add_test([this]() { array_hash_function(); }, "array_hash_function");
     }
 
 private:
@@ -97,6 +103,74 @@ private:
             TEST_ASSERT(h1 != h3, "Hash function not working");
         }
     }
+
+    void bytes_hash_function()
+    {
+        using framework::math::hash_bytes;
+
+        std::vector<std::uint8_t> bytes(2000);
+        for (std::size_t i = 0; i < bytes.size(); ++i) {
+            bytes[i] = static_cast<std::uint8_t>(i * 7 + 3);
+        }
+
+        TEST_ASSERT(hash_bytes(nullptr, 0) == hash_bytes(bytes.data(), 0), "Hash of empty data not working");
+        TEST_ASSERT(hash_bytes(bytes.data(), 0) != hash_bytes(bytes.data(), 0, 1), "Hash seed not working");
+
+        // Each size is processed by one of the short or long paths, all prefixes should be different.
+        std::set<std::uint64_t> hashes;
+        for (std::size_t size = 0; size <= bytes.size(); ++size) {
+            hashes.insert(hash_bytes(bytes.data(), size));
+            hashes.insert(hash_bytes(bytes.data(), size, 42));
+        }
+
+        TEST_ASSERT(hashes.size() == (bytes.size() + 1) * 2, "Hash of prefixes has collisions");
+
+        // Change of any bit changes the hash.
+        for (const std::size_t size : {1, 3, 8, 15, 16, 33, 64, 65, 200, 1100}) {
+            std::vector<std::uint8_t> data(bytes.begin(), bytes.begin() + static_cast<std::ptrdiff_t>(size));
+
+            const std::uint64_t hash = hash_bytes(data.data(), size);
+            TEST_ASSERT(hash == hash_bytes(bytes.data(), size), "Hash function not working");
+
+            std::set<std::uint64_t> flipped = {hash};
+            for (std::size_t bit = 0; bit < size * 8; ++bit) {
+                data[bit / 8] ^= static_cast<std::uint8_t>(1 << (bit % 8));
+                flipped.insert(hash_bytes(data.data(), size));
+                data[bit / 8] ^= static_cast<std::uint8_t>(1 << (bit % 8));
+            }
+
+            TEST_ASSERT(flipped.size() == size * 8 + 1, "Hash of flipped bits has collisions");
+        }
+    }
+
+    void array_hash_function()
+    {
+        using framework::Span;
+        using framework::math::hash_array;
+        using framework::math::hash_bytes;
+        using framework::math::Matrix4f;
+        using framework::math::Vector3f;
+
+        std::vector<Vector3f> points;
+        for (int i = 0; i < 1000; ++i) {
+            points.emplace_back(i, i * 2, -i);
+        }
+
+        const std::uint64_t hash = hash_array(Span<const Vector3f>(points));
+
+        TEST_ASSERT(hash == hash_bytes(points.data(), points.size() * sizeof(Vector3f)), "Hash of array not working");
+        TEST_ASSERT(hash == hash_array(Span<const Vector3f>(std::vector<Vector3f>(points))),
+                    "Hash of array not working");
+
+        points[500].y += 1.0f;
+        TEST_ASSERT(hash != hash_array(Span<const Vector3f>(points)), "Hash of array not working");
+
+        const std::vector<Matrix4f> matrices = {Matrix4f(), Matrix4f(2.0f)};
+        const std::vector<Matrix4f> swapped  = {Matrix4f(2.0f), Matrix4f()};
+
+        TEST_ASSERT(hash_array(Span<const Matrix4f>(matrices)) != hash_array(Span<const Matrix4f>(swapped)),
+                    "Hash of matrices not working");
+    }
 };
 
 int main()
@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cmath>
+
 #include <math/math.hpp>
 #include <unit_test/suite.hpp>
 
@@ -9,6 +12,7 @@ using framework::math::Matrix3x3f;
 using framework::math::Matrix3x4f;
 using framework::math::Matrix4x2f;
 using framework::math::Matrix4x3f;
+using framework::math::Matrix4x4d;
 using framework::math::Matrix4x4f;
 
 using framework::math::Matrix4f;
@@ -178,6 +182,20 @@ private:
                     "Determinant of inverse Matrix3x3f is wrong.");
         TEST_ASSERT(almost_equal(determinant(inverse(test4)), 1.0f / determinant(test4)),
                     "Determinant of inverse Matrix4x4f is wrong.");
+
+        // Matrix4x4f is inverted with SIMD instructions, the result is compared with the generic one for doubles.
+        const Matrix4x4f test = {2, 1, 0, 0.5f, -1, 3, 1, 0, 0.5f, 0, 4, 1, 1, -2, 0.25f, 1};
+        const Matrix4x4d expected = inverse(Matrix4x4d(test[0], test[1], test[2], test[3]));
+        const Matrix4x4f result   = inverse(test);
+
+        float max_difference = 0.0f;
+        for (std::size_t c = 0; c < 4; ++c) {
+            for (std::size_t r = 0; r < 4; ++r) {
+                max_difference = std::max(max_difference, std::abs(result[c][r] - static_cast<float>(expected[c][r])));
+            }
+        }
+
+        TEST_ASSERT(max_difference < 1e-6f, "Inverse function for Matrix4x4f is not precise.");
     }
 
     void affine_inverse_function()
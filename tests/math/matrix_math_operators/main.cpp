@@ -9,10 +9,12 @@ using framework::math::Matrix3x3f;
 using framework::math::Matrix3x4f;
 using framework::math::Matrix4x2f;
 using framework::math::Matrix4x3f;
+using framework::math::Matrix4x4d;
 using framework::math::Matrix4x4f;
 
 using framework::math::Vector2f;
 using framework::math::Vector3f;
+using framework::math::Vector4d;
 using framework::math::Vector4f;
 
 class MatrixOperatorsTest : public framework::unit_test::Suite
@@ -33,6 +35,7 @@ public:
         add_test([this]() { multiply_with_vector_operator(); }, "multiply_with_vector_operator");
         add_test([this]() { multiply_with_matrix_operator(); }, "multiply_with_matrix_operator");
         add_test([this]() { divide_operator(); }, "divide_operator");
+        add_test([this]() { matrix4f_multiply_operators(); }, "matrix4f_multiply_operators");
     }
 
 private:
@@ -600,6 +603,32 @@ private:
         TEST_ASSERT(50.0f / temp22 == result22, "Matrix2x2 divide operator failed.");
     }
 
+    void matrix4f_multiply_operators()
+    {
+        // Matrix4f operators use SIMD instructions, results are compared with the generic implementation for doubles.
+        // Values are exactly representable, so there is no rounding in both of them.
+        const Matrix4x4f lhs = {0.5f, -1.25f, 3, 0.75f, 2.5f, 1, -0.5f, 4, -2, 0.25f, 1.5f, -3.5f, 1, 2, -1, 0.5f};
+        const Matrix4x4f rhs = {1, 0.5f, -2, 3, -0.75f, 2, 1.25f, -1, 4, -3, 0.5f, 2, 0.25f, 1, -1.5f, 1};
+        const Vector4f vector = {1.5f, -2, 0.25f, 1};
+
+        const Matrix4x4d lhs_double(lhs[0], lhs[1], lhs[2], lhs[3]);
+        const Matrix4x4d rhs_double(rhs[0], rhs[1], rhs[2], rhs[3]);
+
+        const Matrix4x4d product = lhs_double * rhs_double;
+        const Matrix4x4f result(product[0], product[1], product[2], product[3]);
+
+        Matrix4x4f temp = lhs;
+        temp *= rhs;
+
+        TEST_ASSERT(alignof(Vector4f) == 16 && alignof(Matrix4x4f) == 16, "Matrix4x4f alignment failed.");
+        TEST_ASSERT(lhs * rhs == result, "Matrix4x4 multiply with matrix operator failed.");
+        TEST_ASSERT(temp == result, "Matrix4x4 multiply assign operator failed.");
+        TEST_ASSERT(lhs * vector == Vector4f(lhs_double * Vector4d(vector)),
+                    "Matrix4x4 multiply with vector operator failed.");
+        TEST_ASSERT(vector * lhs == Vector4f(Vector4d(vector) * lhs_double),
+                    "Vector4 multiply with matrix operator failed.");
+    }
+
     const Matrix4x4f Matrix44;
     const Matrix4x3f Matrix43;
     const Matrix4x2f Matrix42;
@@ -0,0 +1,167 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <tuple>
+
+#include <math/math.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::math::PointMap;
+using framework::math::Vector3f;
+
+class PointMapTypeTest : public framework::unit_test::Suite
+{
+public:
+    PointMapTypeTest()
+        : Suite("PointMapTypeTest")
+    {
+        add_test([this]() { empty_map(); }, "empty_map");
+        add_test([this]() { insert_and_find(); }, "insert_and_find");
+        add_test([this]() { quantized_keys(); }, "quantized_keys");
+        add_test([this]() { erase(); }, "erase");
+        add_test([this]() { weld_vertices(); }, "weld_vertices");
+    }
+
+private:
+    void empty_map()
+    {
+        PointMap<int> map;
+
+        TEST_ASSERT(map.empty() && map.size() == 0 && map.keys().empty() && map.values().empty(),
+                    "Map expected to be empty.");
+        TEST_ASSERT(map.find(Vector3f()) == nullptr && !map.contains(Vector3f()) && !map.erase(Vector3f()),
+                    "Empty map has no keys.");
+    }
+
+    void insert_and_find()
+    {
+        PointMap<std::string> map(0.5f);
+
+        TEST_ASSERT(map.precision() == 0.5f, "Wrong precision.");
+
+        const auto [first, first_inserted]   = map.insert(Vector3f(1.0f, 2.0f, 3.0f), "first");
+        const auto [second, second_inserted] = map.insert(Vector3f(-1.0f, 2.0f, 3.0f), "second");
+        const auto [same, same_inserted]     = map.insert(Vector3f(1.0f, 2.0f, 3.0f), "same");
+
+        TEST_ASSERT(first == 0 && second == 1 && same == 0, "Wrong indices of entries.");
+        TEST_ASSERT(first_inserted && second_inserted && !same_inserted, "Equal keys are inserted.");
+        TEST_ASSERT(map.size() == 2 && *map.find(Vector3f(1.0f, 2.0f, 3.0f)) == "first", "Value is replaced.");
+
+        map[Vector3f(0.0f)] = "third";
+        map[Vector3f(-1.0f, 2.0f, 3.0f)] += "!";
+
+        TEST_ASSERT(map.size() == 3 && map.values()[1] == "second!" && map.values()[2] == "third",
+                    "Access operator failed.");
+        TEST_ASSERT(map.keys()[2] == Vector3f(0.0f), "Wrong keys.");
+
+        // Many keys with rehashing, compared to the standard map.
+        PointMap<int> grid(1.0f);
+        std::map<std::tuple<int, int, int>, int> expected;
+        for (int i = 0; i < 20000; ++i) {
+            const int x = (i * 7919) % 101 - 50;
+            const int y = (i * 104729) % 37 - 18;
+            const int z = i % 13;
+
+            grid[Vector3f(x, y, z)] += i;
+            expected[{x, y, z}] += i;
+        }
+
+        bool same_values = grid.size() == expected.size();
+        for (const auto& [key, value] : expected) {
+            const int* found = grid.find(Vector3f(std::get<0>(key), std::get<1>(key), std::get<2>(key)));
+            same_values      = same_values && found != nullptr && *found == value;
+        }
+
+        TEST_ASSERT(same_values, "Values differ from the standard map.");
+        TEST_ASSERT(!grid.contains(Vector3f(1000.0f)), "Unexpected key.");
+    }
+
+    void quantized_keys()
+    {
+        PointMap<int> map(0.01f);
+
+        map.insert(Vector3f(1.0f, 1.0f, 1.0f), 1);
+
+        TEST_ASSERT(map.contains(Vector3f(1.004f, 0.996f, 1.001f)), "Close point is not found.");
+        TEST_ASSERT(!map.contains(Vector3f(1.006f, 1.0f, 1.0f)), "Distant point is found.");
+        TEST_ASSERT(!map.contains(Vector3f(-1.0f, 1.0f, 1.0f)), "Distant point is found.");
+
+        // Negative zero is rounded as zero.
+        map.insert(Vector3f(0.0f), 2);
+        TEST_ASSERT(*map.find(Vector3f(-0.0f, 0.0f, -0.001f)) == 2, "Negative zero is not equal to zero.");
+
+        map.insert(Vector3f(-2.5f, -0.014f, 3.0f), 3);
+        TEST_ASSERT(*map.find(Vector3f(-2.501f, -0.0149f, 2.999f)) == 3, "Negative coordinates rounding failed.");
+    }
+
+    void erase()
+    {
+        PointMap<int> map(1.0f);
+        for (int i = 0; i < 1000; ++i) {
+            map.insert(Vector3f(i % 10, i / 10 % 10, i / 100), i);
+        }
+
+        bool erased = true;
+        for (int i = 0; i < 1000; i += 3) {
+            erased = erased && map.erase(Vector3f(i % 10, i / 10 % 10, i / 100));
+        }
+
+        TEST_ASSERT(erased && map.size() == 666, "Erase failed.");
+        TEST_ASSERT(!map.erase(Vector3f(0.0f)), "Erased key is found.");
+
+        bool same = true;
+        for (int i = 0; i < 1000; ++i) {
+            const int* found = map.find(Vector3f(i % 10, i / 10 % 10, i / 100));
+            same             = same && (i % 3 == 0 ? found == nullptr : found != nullptr && *found == i);
+        }
+
+        // Keys and values stay in the same order after erase.
+        for (std::size_t i = 0; i < map.size(); ++i) {
+            same = same && *map.find(map.keys()[i]) == map.values()[i];
+        }
+
+        TEST_ASSERT(same, "Wrong values after erase.");
+
+        map.clear();
+        TEST_ASSERT(map.empty() && !map.contains(Vector3f(1.0f)), "Clear failed.");
+    }
+
+    void weld_vertices()
+    {
+        // Grid of quads, each one has its own copy of the corners with a small error.
+        constexpr int size = 50;
+
+        std::vector<Vector3f> vertices;
+        for (int z = 0; z < size; ++z) {
+            for (int x = 0; x < size; ++x) {
+                const float error = static_cast<float>((x * 31 + z * 17) % 7) * 1e-5f;
+                for (const auto& [dx, dz] : {std::pair(0, 0), std::pair(1, 0), std::pair(1, 1), std::pair(0, 1)}) {
+                    vertices.emplace_back(static_cast<float>(x + dx) + error, 0.0f, static_cast<float>(z + dz) - error);
+                }
+            }
+        }
+
+        PointMap<std::uint32_t> map(1e-3f);
+        map.reserve(vertices.size());
+
+        std::vector<std::uint32_t> indices;
+        for (const Vector3f& vertex : vertices) {
+            const auto [index, inserted] = map.insert(vertex, static_cast<std::uint32_t>(map.size()));
+            indices.push_back(static_cast<std::uint32_t>(index));
+        }
+
+        bool valid = map.size() == (size + 1) * (size + 1);
+        for (std::size_t i = 0; i < indices.size(); ++i) {
+            valid = valid && indices[i] == map.values()[indices[i]];
+            valid = valid && distance(map.keys()[indices[i]], vertices[i]) < 1e-3f;
+        }
+
+        TEST_ASSERT(valid, "Vertex welding failed.");
+    }
+};
+
+int main()
+{
+    return run_tests(PointMapTypeTest());
+}
@@ -1,5 +1,8 @@
 #include <algorithm>
+#include <cmath>
 #include <iterator>
+#include <map>
+#include <utility>
 
 #include <math/math.hpp>
 #include <unit_test/suite.hpp>
@@ -7,6 +10,103 @@
 using framework::math::Polygon;
 using framework::math::Vector2f;
 
+namespace
+{
+
+// Triangles must be counterclockwise and cover the polygon area without holes.
+bool is_valid_triangulation(const std::vector<std::uint32_t>& triangles,
+                            const Polygon& points,
+                            std::size_t triangles_count,
+                            float area)
+{
+    if (triangles.size() != triangles_count * 3) {
+        return false;
+    }
+
+    float triangles_area = 0.0f;
+    for (std::size_t i = 0; i < triangles.size(); i += 3) {
+        if (triangles[i] >= points.size() || triangles[i + 1] >= points.size() || triangles[i + 2] >= points.size()) {
+            return false;
+        }
+
+        const Vector2f& a = points[triangles[i]];
+        const Vector2f& b = points[triangles[i + 1]];
+        const Vector2f& c = points[triangles[i + 2]];
+
+        const float doubled_area = cross(b - a, c - a);
+        if (doubled_area < 0.0f) {
+            return false;
+        }
+
+        triangles_area += doubled_area / 2.0f;
+    }
+
+    return std::abs(triangles_area - area) <= area * 1e-4f;
+}
+
+// Opposite points of the triangles with the common edge must be outside of the triangles circumcircles,
+// except the polygon edges.
+bool is_delaunay_triangulation(const std::vector<std::uint32_t>& triangles, const Polygon& points)
+{
+    std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> opposite;
+    for (std::size_t i = 0; i < triangles.size(); i += 3) {
+        for (std::size_t j = 0; j < 3; ++j) {
+            const std::uint32_t a = triangles[i + j];
+            const std::uint32_t b = triangles[i + (j + 1) % 3];
+            const std::uint32_t c = triangles[i + (j + 2) % 3];
+
+            opposite[{a, b}] = c;
+        }
+    }
+
+    for (const auto& [edge, c] : opposite) {
+        const auto it = opposite.find({edge.second, edge.first});
+        if (it == opposite.end()) {
+            continue;
+        }
+
+        const Vector2f& a = points[edge.first];
+        const Vector2f& b = points[edge.second];
+        const Vector2f& d = points[it->second];
+
+        // Circumcircle of the abc triangle.
+        const Vector2f& pc = points[c];
+        const double ax = a.x, ay = a.y, bx = b.x, by = b.y, cx = pc.x, cy = pc.y;
+        const double det = 2.0 * (ax * (by - cy) + bx * (cy - ay) + cx * (ay - by));
+        if (std::abs(det) < 1e-12) {
+            continue;
+        }
+
+        const double a2 = ax * ax + ay * ay;
+        const double b2 = bx * bx + by * by;
+        const double c2 = cx * cx + cy * cy;
+        const double ux = (a2 * (by - cy) + b2 * (cy - ay) + c2 * (ay - by)) / det;
+        const double uy = (a2 * (cx - bx) + b2 * (ax - cx) + c2 * (bx - ax)) / det;
+
+        const double radius   = std::hypot(ax - ux, ay - uy);
+        const double distance = std::hypot(d.x - ux, d.y - uy);
+        if (distance < radius * (1.0 - 1e-5)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+Polygon star(std::size_t rays, float inner_radius, float outer_radius)
+{
+    Polygon polygon;
+    for (std::size_t i = 0; i < rays * 2; ++i) {
+        const float angle  = static_cast<float>(i) * 3.14159265f / static_cast<float>(rays);
+        const float radius = i % 2 == 0 ? outer_radius : inner_radius;
+        polygon.emplace_back(radius * std::cos(angle), radius * std::sin(angle));
+    }
+
+    return polygon;
+}
+
+} // namespace
+
 class PolygonFunctionsTest : public framework::unit_test::Suite
 {
 public:
@@ -16,6 +116,15 @@ public:
         add_test([this]() { polygon_area_function(); }, "polygon_area_function");
         add_test([this]() { is_point_in_polygon_function(); }, "is_point_in_polygon_function");
         add_test([this]() { generate_ear_cut_triangulation_function(); }, "generate_ear_cut_triangulation_function");
+        add_test([this]() { generate_ear_cut_triangulation_with_holes_function(); },
+                 "generate_ear_cut_triangulation_with_holes_function");
+        add_test([this]() { generate_ear_cut_triangulation_big_polygon_function(); },
+                 "generate_ear_cut_triangulation_big_polygon_function");
+        add_test([this]() { generate_delaunay_triangulation_function(); }, "generate_delaunay_triangulation_function");
+        add_test([this]() { generate_delaunay_triangulation_with_holes_function(); },
+                 "generate_delaunay_triangulation_with_holes_function");
+        add_test([this]() { generate_delaunay_triangulation_with_points_function(); },
+                 "generate_delaunay_triangulation_with_points_function");
     }
 
 private:
@@ -91,14 +200,149 @@ private:
         const Polygon p1{{-2, 5}, {-2, 1}, {4, 1}, {-1, 2}};
         const Polygon p2{{-1, 2}, {4, 1}, {-2, 1}, {-2, 5}};
 
-        const std::vector<std::uint32_t> t1_test = {2, 3, 1, 0, 1, 3};
-        const std::vector<std::uint32_t> t2_test = {1, 0, 2, 0, 3, 2};
+        TEST_ASSERT(is_valid_triangulation(generate_ear_cut_triangulation(p1), p1, 2, 5.0f),
+                    "Wrong triangulation result");
+        TEST_ASSERT(is_valid_triangulation(generate_ear_cut_triangulation(p2), p2, 2, 5.0f),
+                    "Wrong triangulation result");
+
+        const Polygon p3{{1, 1}, {1, -1}, {2, 2}, {-1, 2}, {-3, 1}, {2, -3}, {-1, 1}};
+        TEST_ASSERT(is_valid_triangulation(generate_ear_cut_triangulation(p3), p3, 5, 8.5f),
+                    "Wrong triangulation result");
+
+        const Polygon line{{0, 0}, {1, 1}};
+        TEST_ASSERT(generate_ear_cut_triangulation(line).empty(), "Degenerate polygon has no triangles.");
+    }
+
+    void generate_ear_cut_triangulation_with_holes_function()
+    {
+        const Polygon polygon{{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+        const std::vector<Polygon> holes{
+            {{2, 2}, {2, 4}, {4, 4}, {4, 2}},
+            {{6, 6}, {8, 6}, {7, 8}},
+        };
+
+        Polygon points = polygon;
+        for (const auto& hole : holes) {
+            points.insert(points.end(), hole.begin(), hole.end());
+        }
+
+        // Each hole adds two points of the bridge.
+        const auto triangles = generate_ear_cut_triangulation(polygon, holes);
+        TEST_ASSERT(is_valid_triangulation(triangles, points, points.size() + holes.size() * 2 - 2, 94.0f),
+                    "Wrong triangulation result");
+
+        // Winding order of the polygon doesn't matter.
+        Polygon reversed;
+        std::reverse_copy(polygon.begin(), polygon.end(), std::back_inserter(reversed));
+        std::copy(points.begin() + 4, points.end(), std::back_inserter(reversed));
+
+        TEST_ASSERT(is_valid_triangulation(generate_ear_cut_triangulation(Polygon(reversed.begin(),
+                                                                                  reversed.begin() + 4),
+                                                                          holes),
+                                           reversed,
+                                           points.size() + holes.size() * 2 - 2,
+                                           94.0f),
+                    "Wrong triangulation result");
+    }
+
+    void generate_ear_cut_triangulation_big_polygon_function()
+    {
+        // Big polygons use z-order hashing.
+        const Polygon polygon = star(5000, 90.0f, 100.0f);
+        const float area      = std::abs(polygon_area(polygon));
+
+        TEST_ASSERT(is_valid_triangulation(generate_ear_cut_triangulation(polygon), polygon, polygon.size() - 2, area),
+                    "Wrong triangulation result");
+
+        const std::vector<Polygon> holes{star(500, 20.0f, 30.0f)};
+        Polygon points = polygon;
+        points.insert(points.end(), holes[0].begin(), holes[0].end());
+
+        const float holes_area = area - std::abs(polygon_area(holes[0]));
+        TEST_ASSERT(is_valid_triangulation(generate_ear_cut_triangulation(polygon, holes),
+                                           points,
+                                           points.size(),
+                                           holes_area),
+                    "Wrong triangulation result");
+    }
+
+    void generate_delaunay_triangulation_function()
+    {
+        const Polygon p1{{-2, 5}, {-2, 1}, {4, 1}, {-1, 2}};
+        const auto t1 = generate_delaunay_triangulation(p1);
+        TEST_ASSERT(is_valid_triangulation(t1, p1, 2, 5.0f), "Wrong triangulation result");
+
+        const Polygon p2 = star(64, 99.0f, 100.0f);
+        const auto t2    = generate_delaunay_triangulation(p2);
+        TEST_ASSERT(is_valid_triangulation(t2, p2, p2.size() - 2, std::abs(polygon_area(p2))),
+                    "Wrong triangulation result");
+        TEST_ASSERT(is_delaunay_triangulation(t2, p2), "Triangulation is not Delaunay.");
+
+        const Polygon p3 = star(2000, 50.0f, 100.0f);
+        const auto t3    = generate_delaunay_triangulation(p3);
+        TEST_ASSERT(is_valid_triangulation(t3, p3, p3.size() - 2, std::abs(polygon_area(p3))),
+                    "Wrong triangulation result");
+        TEST_ASSERT(is_delaunay_triangulation(t3, p3), "Triangulation is not Delaunay.");
+    }
+
+    void generate_delaunay_triangulation_with_holes_function()
+    {
+        const Polygon polygon{{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+        const std::vector<Polygon> holes{
+            {{2, 2}, {2, 4}, {4, 4}, {4, 2}},
+            {{6, 6}, {8, 6}, {7, 8}},
+        };
+
+        Polygon points = polygon;
+        for (const auto& hole : holes) {
+            points.insert(points.end(), hole.begin(), hole.end());
+        }
+
+        const auto triangles = generate_delaunay_triangulation(polygon, holes);
+        TEST_ASSERT(is_valid_triangulation(triangles, points, points.size() + holes.size() * 2 - 2, 94.0f),
+                    "Wrong triangulation result");
+        TEST_ASSERT(is_delaunay_triangulation(triangles, points), "Triangulation is not Delaunay.");
+    }
+
+    void generate_delaunay_triangulation_with_points_function()
+    {
+        const Polygon polygon{{0, 0}, {10, 0}, {10, 10}, {0, 10}};
+        const std::vector<Polygon> holes{{{2, 2}, {2, 4}, {4, 4}, {4, 2}}};
+
+        // Grid points, some of them are on the edges, inside the hole or outside of the polygon.
+        Polygon steiner_points;
+        for (int x = 1; x < 12; ++x) {
+            for (int y = 0; y < 10; ++y) {
+                steiner_points.emplace_back(static_cast<float>(x), static_cast<float>(y) + 0.5f);
+            }
+        }
+
+        Polygon points = polygon;
+        points.insert(points.end(), holes[0].begin(), holes[0].end());
+        const std::size_t first_steiner_point = points.size();
+        points.insert(points.end(), steiner_points.begin(), steiner_points.end());
+
+        const auto triangles = generate_delaunay_triangulation(polygon, holes, steiner_points);
+        TEST_ASSERT(is_valid_triangulation(triangles, points, triangles.size() / 3, 96.0f),
+                    "Wrong triangulation result");
+        TEST_ASSERT(is_delaunay_triangulation(triangles, points), "Triangulation is not Delaunay.");
+
+        const auto is_used = [&triangles](std::size_t index) {
+            return std::find(triangles.begin(), triangles.end(), index) != triangles.end();
+        };
 
-        const auto t1 = generate_ear_cut_triangulation(p1);
-        const auto t2 = generate_ear_cut_triangulation(p2);
+        for (std::size_t i = 0; i < steiner_points.size(); ++i) {
+            const Vector2f& p    = steiner_points[i];
+            const bool in_hole   = p.x > 2 && p.x < 4 && p.y > 2 && p.y < 4;
+            const bool outside   = p.x > 10;
+            const bool on_border = p.x == 10;
 
-        TEST_ASSERT(t1 == t1_test, "Wrong triangulation result");
-        TEST_ASSERT(t2 == t2_test, "Wrong triangulation result");
+            if (in_hole || outside) {
+                TEST_ASSERT(!is_used(first_steiner_point + i), "Point outside of the polygon is used.");
+            } else if (!on_border) {
+                TEST_ASSERT(is_used(first_steiner_point + i), "Steiner point is not used.");
+            }
+        }
     }
 };
 
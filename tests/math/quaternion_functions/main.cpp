@@ -0,0 +1,202 @@
+#include <math/math.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::math::Matrix3f;
+using framework::math::Matrix4f;
+using framework::math::Quaternionf;
+using framework::math::Vector3f;
+using framework::math::Vector4f;
+
+using framework::math::almost_equal;
+using framework::math::angle_axis;
+using framework::math::conjugate;
+using framework::math::half_pi;
+using framework::math::inverse;
+using framework::math::length;
+using framework::math::nlerp;
+using framework::math::normalize;
+using framework::math::pi;
+using framework::math::rotate;
+using framework::math::slerp;
+using framework::math::to_matrix;
+using framework::math::to_quaternion;
+
+namespace
+{
+
+bool same_rotation(const Quaternionf& a, const Quaternionf& b)
+{
+    // Quaternions q and -q represent the same rotation.
+    const Vector4f va(a.x, a.y, a.z, a.w);
+    const Vector4f vb(b.x, b.y, b.z, b.w);
+    return almost_equal(va, vb, 8) || almost_equal(va, -vb, 8);
+}
+
+} // namespace
+
+class QuaternionOperatorsTest : public framework::unit_test::Suite
+{
+public:
+    QuaternionOperatorsTest()
+        : Suite("QuaternionOperatorsTest")
+    {
+        add_test([this]() { default_constructor(); }, "default_constructor");
+        add_test([this]() { multiplication(); }, "multiplication");
+        add_test([this]() { vector_rotation(); }, "vector_rotation");
+    }
+
+private:
+    void default_constructor()
+    {
+        const Quaternionf q;
+        const Vector3f v(1, 2, 3);
+
+        TEST_ASSERT(q == Quaternionf(0, 0, 0, 1), "Default quaternion is not identity.");
+        TEST_ASSERT(q * v == v, "Identity rotation changed the vector.");
+        TEST_ASSERT(alignof(Quaternionf) == 16, "Wrong alignment.");
+    }
+
+    void multiplication()
+    {
+        const Quaternionf i(1, 0, 0, 0);
+        const Quaternionf j(0, 1, 0, 0);
+        const Quaternionf k(0, 0, 1, 0);
+
+        TEST_ASSERT(i * j == k, "i * j != k.");
+        TEST_ASSERT(j * k == i, "j * k != i.");
+        TEST_ASSERT(k * i == j, "k * i != j.");
+        TEST_ASSERT(j * i == -k, "j * i != -k.");
+        TEST_ASSERT(i * i == Quaternionf(0, 0, 0, -1), "i * i != -1.");
+
+        const Quaternionf a = angle_axis(0.5f, normalize(Vector3f(1, 2, 3)));
+        const Quaternionf b = angle_axis(-1.2f, normalize(Vector3f(-3, 1, 2)));
+        const Vector3f v(4, -5, 6);
+
+        TEST_ASSERT(almost_equal((a * b) * v, a * (b * v), 32), "Product of rotations is wrong.");
+
+        Quaternionf c = a;
+        c *= b;
+        TEST_ASSERT(c == a * b, "Multiplication assignment failed.");
+    }
+
+    void vector_rotation()
+    {
+        const Quaternionf q = angle_axis(half_pi<float>, Vector3f(0, 0, 1));
+
+        TEST_ASSERT(almost_equal(q * Vector3f(1, 0, 0), Vector3f(0, 1, 0), 2), "Rotation around z failed.");
+        TEST_ASSERT(almost_equal(q * Vector3f(0, 0, 1), Vector3f(0, 0, 1), 2), "Rotation axis changed.");
+
+        for (float angle = -pi<float>; angle < pi<float>; angle += 0.3f) {
+            const Vector3f axis = normalize(Vector3f(angle, 1, -2));
+            const Vector3f v(1, -2, 3);
+
+            const Vector4f expected = rotate(Matrix4f(), axis, angle) * Vector4f(v, 0);
+
+            TEST_ASSERT(almost_equal(angle_axis(angle, axis) * v, Vector3f(expected), 8),
+                        "Rotation differs from the matrix one.");
+        }
+    }
+};
+
+class QuaternionFunctionsTest : public framework::unit_test::Suite
+{
+public:
+    QuaternionFunctionsTest()
+        : Suite("QuaternionFunctionsTest")
+    {
+        add_test([this]() { length_function(); }, "length_function");
+        add_test([this]() { inverse_function(); }, "inverse_function");
+        add_test([this]() { to_matrix_function(); }, "to_matrix_function");
+        add_test([this]() { to_quaternion_function(); }, "to_quaternion_function");
+        add_test([this]() { nlerp_function(); }, "nlerp_function");
+        add_test([this]() { slerp_function(); }, "slerp_function");
+    }
+
+private:
+    void length_function()
+    {
+        const Quaternionf q(1, 2, 2, 4);
+
+        TEST_ASSERT(almost_equal(length(q), 5.0f, 2), "Length is wrong.");
+        TEST_ASSERT(almost_equal(length(normalize(q)), 1.0f, 2), "Normalized length is not one.");
+        TEST_ASSERT(almost_equal(length(angle_axis(1.0f, Vector3f(0, 1, 0))), 1.0f, 2), "Rotation is not unit.");
+    }
+
+    void inverse_function()
+    {
+        const Quaternionf q(1, 2, 3, 4);
+        const Quaternionf r = angle_axis(0.7f, normalize(Vector3f(1, 1, 0)));
+
+        TEST_ASSERT(same_rotation(q * inverse(q), Quaternionf()), "Inverse is wrong.");
+        TEST_ASSERT(same_rotation(r * conjugate(r), Quaternionf()), "Conjugate of rotation is not inverse.");
+        TEST_ASSERT(almost_equal(conjugate(r) * (r * Vector3f(1, 2, 3)), Vector3f(1, 2, 3), 8),
+                    "Conjugate doesn't revert rotation.");
+    }
+
+    void to_matrix_function()
+    {
+        for (float angle = -pi<float>; angle < pi<float>; angle += 0.3f) {
+            const Vector3f axis = normalize(Vector3f(2, -angle, 1));
+
+            TEST_ASSERT(almost_equal(to_matrix(angle_axis(angle, axis)), rotate(Matrix4f(), axis, angle), 8),
+                        "Rotation matrix is wrong.");
+
+            const Matrix4f m(1, 2, 3, 0, 4, 5, 6, 0, 7, 8, 9, 0, 10, 11, 12, 1);
+            TEST_ASSERT(almost_equal(rotate(m, angle_axis(angle, axis)), rotate(m, axis, angle), 32),
+                        "Rotate with quaternion failed.");
+        }
+    }
+
+    void to_quaternion_function()
+    {
+        // Angles near pi check the branches for the non positive trace.
+        const Vector3f axes[] = {{1, 0, 0}, {0, 1, 0}, {0, 0, 1}, normalize(Vector3f(1, 2, 3))};
+        const float angles[]  = {0.0f, 0.5f, -1.5f, 3.0f, 3.1f};
+
+        for (const Vector3f& axis : axes) {
+            for (const float angle : angles) {
+                const Quaternionf q = angle_axis(angle, axis);
+
+                TEST_ASSERT(same_rotation(to_quaternion(to_matrix(q)), q), "Round trip to 4x4 Matrix failed.");
+                TEST_ASSERT(same_rotation(to_quaternion(Matrix3f(to_matrix(q))), q),
+                            "Round trip to 3x3 Matrix failed.");
+            }
+        }
+    }
+
+    void nlerp_function()
+    {
+        const Quaternionf a = angle_axis(0.2f, Vector3f(0, 1, 0));
+        const Quaternionf b = angle_axis(0.4f, Vector3f(0, 1, 0));
+
+        TEST_ASSERT(same_rotation(nlerp(a, b, 0.0f), a), "Nlerp start is wrong.");
+        TEST_ASSERT(same_rotation(nlerp(a, b, 1.0f), b), "Nlerp end is wrong.");
+        TEST_ASSERT(same_rotation(nlerp(a, b, 0.5f), angle_axis(0.3f, Vector3f(0, 1, 0))), "Nlerp middle is wrong.");
+        TEST_ASSERT(same_rotation(nlerp(a, -b, 1.0f), b), "Nlerp doesn't take the shortest path.");
+    }
+
+    void slerp_function()
+    {
+        const Quaternionf a = angle_axis(0.0f, Vector3f(1, 0, 0));
+        const Quaternionf b = angle_axis(2.0f, Vector3f(1, 0, 0));
+
+        TEST_ASSERT(same_rotation(slerp(a, b, 0.0f), a), "Slerp start is wrong.");
+        TEST_ASSERT(same_rotation(slerp(a, b, 1.0f), b), "Slerp end is wrong.");
+
+        for (float t = 0.0f; t <= 1.0f; t += 0.125f) {
+            TEST_ASSERT(same_rotation(slerp(a, b, t), angle_axis(2.0f * t, Vector3f(1, 0, 0))),
+                        "Slerp angular speed is not constant.");
+            TEST_ASSERT(same_rotation(slerp(a, -b, t), angle_axis(2.0f * t, Vector3f(1, 0, 0))),
+                        "Slerp doesn't take the shortest path.");
+        }
+
+        const Quaternionf c = angle_axis(0.0001f, Vector3f(1, 0, 0));
+        TEST_ASSERT(same_rotation(slerp(a, c, 0.5f), angle_axis(0.00005f, Vector3f(1, 0, 0))),
+                    "Slerp of close rotations failed.");
+    }
+};
+
+int main()
+{
+    return run_tests(QuaternionOperatorsTest(), QuaternionFunctionsTest());
+}
@@ -0,0 +1,109 @@
+#include <math/math.hpp>
+#include <unit_test/suite.hpp>
+
+using framework::math::Matrix4f;
+using framework::math::Quaternionf;
+using framework::math::Transformf;
+using framework::math::Vector3f;
+using framework::math::Vector4f;
+
+using framework::math::almost_equal;
+using framework::math::angle_axis;
+using framework::math::inverse;
+using framework::math::normalize;
+using framework::math::rotate;
+using framework::math::scale;
+using framework::math::to_matrix;
+using framework::math::translate;
+
+namespace
+{
+
+const Transformf parent(Vector3f(1, -2, 3), angle_axis(0.8f, normalize(Vector3f(1, 1, 0))), Vector3f(2));
+const Transformf child(Vector3f(-4, 0.5f, 2), angle_axis(-1.3f, normalize(Vector3f(0, 2, 1))), Vector3f(0.5f));
+
+const Vector3f points[] = {{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {3, -7, 5}};
+
+Vector3f transform_point(const Matrix4f& m, const Vector3f& point)
+{
+    return Vector3f(m * Vector4f(point, 1));
+}
+
+} // namespace
+
+class TransformTest : public framework::unit_test::Suite
+{
+public:
+    TransformTest()
+        : Suite("TransformTest")
+    {
+        add_test([this]() { default_constructor(); }, "default_constructor");
+        add_test([this]() { to_matrix_function(); }, "to_matrix_function");
+        add_test([this]() { point_transformation(); }, "point_transformation");
+        add_test([this]() { composition(); }, "composition");
+        add_test([this]() { inverse_function(); }, "inverse_function");
+    }
+
+private:
+    void default_constructor()
+    {
+        const Transformf identity;
+
+        TEST_ASSERT(to_matrix(identity) == Matrix4f(), "Default transformation is not identity.");
+        TEST_ASSERT(identity * Vector3f(1, 2, 3) == Vector3f(1, 2, 3), "Identity changed the point.");
+    }
+
+    void to_matrix_function()
+    {
+        const Vector3f axis = normalize(Vector3f(1, 2, 3));
+        const Transformf t(Vector3f(5, 6, 7), angle_axis(0.6f, axis), Vector3f(1, 2, 3));
+
+        const Matrix4f expected = rotate(translate(Matrix4f(), Vector3f(5, 6, 7)), axis, 0.6f) *
+                                  scale(Matrix4f(), Vector3f(1, 2, 3));
+
+        TEST_ASSERT(almost_equal(to_matrix(t), expected, 16), "Transformation matrix is wrong.");
+    }
+
+    void point_transformation()
+    {
+        const Transformf t(Vector3f(5, 6, 7), angle_axis(0.6f, normalize(Vector3f(1, 2, 3))), Vector3f(1, 2, 3));
+
+        for (const Vector3f& point : points) {
+            TEST_ASSERT(almost_equal(t * point, transform_point(to_matrix(t), point), 32),
+                        "Point transformation differs from the matrix one.");
+        }
+    }
+
+    void composition()
+    {
+        const Transformf composed = parent * child;
+        const Matrix4f expected   = to_matrix(parent) * to_matrix(child);
+
+        TEST_ASSERT(almost_equal(to_matrix(composed), expected, 32), "Composed matrix is wrong.");
+
+        for (const Vector3f& point : points) {
+            TEST_ASSERT(almost_equal(composed * point, parent * (child * point), 32), "Composition is wrong.");
+        }
+
+        Transformf t = parent;
+        t *= child;
+        TEST_ASSERT(almost_equal(to_matrix(t), expected, 32), "Multiplication assignment failed.");
+    }
+
+    void inverse_function()
+    {
+        const Transformf inverted = inverse(parent);
+
+        TEST_ASSERT(almost_equal(to_matrix(inverted), inverse(to_matrix(parent)), 16), "Inverse matrix is wrong.");
+        TEST_ASSERT(almost_equal(to_matrix(inverted * parent), Matrix4f(), 16), "Inverse composition is not identity.");
+
+        for (const Vector3f& point : points) {
+            TEST_ASSERT(almost_equal(inverted * (parent * point), point, 32), "Inverse doesn't revert the point.");
+        }
+    }
+};
+
+int main()
+{
+    return run_tests(TransformTest());
+}